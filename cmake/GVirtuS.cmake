@@ -107,4 +107,60 @@ function(maybe_add_cuda_plugin libname subdir)
     else()
         message(WARNING "CUDA library ${libname} not found, skipping ${subdir}")
     endif()
-endfunction()
\ No newline at end of file
+endfunction()
+
+# Writes to <output> a table of the names of the constants of an enum, for the
+# frontends to answer *GetErrorName and the like without a round trip (see
+# include/gvirtus/frontend/LocalTier.h). The constants are the "NAME = value"
+# lines of the headers, found in the directories, whose NAME matches pattern;
+# missing headers are skipped, so one call covers several library versions.
+#
+#   gvirtus_generate_enum_names(OUTPUT file TABLE name PATTERN regex
+#                               HEADERS header... DIRECTORIES dir...)
+function(gvirtus_generate_enum_names)
+    cmake_parse_arguments(ENUM "" "OUTPUT;TABLE;PATTERN" "HEADERS;DIRECTORIES" ${ARGN})
+    if(NOT ENUM_OUTPUT OR NOT ENUM_TABLE OR NOT ENUM_PATTERN OR NOT ENUM_HEADERS)
+        message(FATAL_ERROR "Usage: gvirtus_generate_enum_names(OUTPUT file TABLE name "
+                "PATTERN regex HEADERS header... DIRECTORIES dir...)")
+    endif()
+    set(line_regex "^[ \t]*(${ENUM_PATTERN})[ \t]*=[ \t]*(-?[0-9][0-9a-fA-FxX]*)")
+    set(entries "")
+    set(names "")
+    set(sources "")
+    foreach(header ${ENUM_HEADERS})
+        set(path "")
+        foreach(directory ${ENUM_DIRECTORIES})
+            if(NOT path AND EXISTS ${directory}/${header})
+                set(path ${directory}/${header})
+            endif()
+        endforeach()
+        if(NOT path)
+            continue()
+        endif()
+        list(APPEND sources ${path})
+        file(STRINGS ${path} lines REGEX "${line_regex}")
+        foreach(line ${lines})
+            string(REGEX MATCH "${line_regex}" match "${line}")
+            set(name ${CMAKE_MATCH_1})
+            set(value ${CMAKE_MATCH_2})
+            if(NOT name IN_LIST names)
+                list(APPEND names ${name})
+                string(APPEND entries "    {${value}, \"${name}\"},\n")
+            endif()
+        endforeach()
+    endforeach()
+    if(NOT names)
+        message(WARNING "No ${ENUM_PATTERN} in ${ENUM_HEADERS}: ${ENUM_TABLE} is empty")
+        string(APPEND entries "    {0, nullptr},\n")
+    endif()
+    list(LENGTH names count)
+    message(STATUS "${ENUM_TABLE}: ${count} names from ${sources}")
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${sources})
+    # configure_file leaves the output alone, and what includes it unbuilt, when
+    # the table did not change
+    file(WRITE ${ENUM_OUTPUT}.in
+         "/* Generated by gvirtus_generate_enum_names from ${sources}. Do not edit. */\n\n"
+         "#pragma once\n\n#include <gvirtus/frontend/LocalTier.h>\n\n"
+         "static const gvirtus::frontend::EnumName ${ENUM_TABLE}[] = {\n${entries}};\n")
+    configure_file(${ENUM_OUTPUT}.in ${ENUM_OUTPUT} COPYONLY)
+endfunction()
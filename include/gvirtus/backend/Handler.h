@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <gvirtus/communicators/LoadReport.h>
 #include <gvirtus/communicators/Result.h>
 
 #include <memory>
@@ -53,6 +54,16 @@ class Handler {
     virtual std::shared_ptr<communicators::Result> Execute(
         std::string routine, std::shared_ptr<communicators::Buffer> input_buffer) = 0;
 
+    /* Adds what the plugin knows of the load of the backend to report. */
+    virtual void Load(communicators::LoadReport *report) {}
+
+    /*
+     * Called on the thread of a session when its scheduler class changes: the
+     * streams it creates next should get the highest priority (1), the lowest
+     * (-1) or the default (0).
+     */
+    virtual void StreamPriority(int rank) {}
+
    private:
     log4cplus::Logger logger;
 };
@@ -0,0 +1,78 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   Macros.h
+ *
+ * @brief  The macros a frontend defined on its connection: call sequences
+ * recorded once, which the frontend later replays by id, sending only how
+ * the inputs of the calls changed.
+ */
+
+#pragma once
+
+#include <gvirtus/communicators/Result.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "log4cplus/logger.h"
+
+namespace gvirtus::backend {
+class Macros {
+   public:
+    /* Runs a routine of the plugins, as Process does for a call of the frontend. */
+    using Dispatch = std::function<std::shared_ptr<communicators::Result>(
+        const std::string &routine, std::shared_ptr<communicators::Buffer> input_buffer)>;
+
+    Macros();
+
+    /* Whether routine defines, replays or forgets a macro, rather than being a plugin's. */
+    static bool Handles(const std::string &routine);
+
+    std::shared_ptr<communicators::Result> Execute(
+        const std::string &routine, std::shared_ptr<communicators::Buffer> input_buffer,
+        const Dispatch &dispatch);
+
+   private:
+    struct Call {
+        std::string routine;
+        std::vector<char> input;
+    };
+
+    std::shared_ptr<communicators::Result> Define(communicators::Buffer *in);
+    /*
+     * Runs the calls of a range of a macro, with their deltas applied, until
+     * one fails. The output is the index of the call that failed, or of the
+     * end of the range.
+     */
+    std::shared_ptr<communicators::Result> Replay(communicators::Buffer *in,
+                                                  const Dispatch &dispatch);
+
+    std::map<uint64_t, std::vector<Call>> mMacros;
+    log4cplus::Logger logger;
+};
+}  // namespace gvirtus::backend
@@ -4,10 +4,13 @@
 #include <gvirtus/common/Observable.h>
 #include <gvirtus/communicators/Communicator.h>
 
+#include <atomic>
 #include <string>
 #include <vector>
 
 #include "Handler.h"
+#include "Scheduler.h"
+#include "Shards.h"
 #include "log4cplus/configurator.h"
 #include "log4cplus/logger.h"
 #include "log4cplus/loggingmacros.h"
@@ -22,17 +25,33 @@ class Process : public common::Observable {
     Process(std::shared_ptr<common::LD_Lib<communicators::Communicator,
                                            std::shared_ptr<communicators::Endpoint>>>
                 communicator,
-            std::vector<std::string> &plugins);
+            std::vector<std::string> &plugins, const nlohmann::json &scheduler,
+            const nlohmann::json &shards, const nlohmann::json &placement);
     ~Process() override;
     void Start();
 
    private:
+    /* Accepts the connections and hands them over to the workers (see Shards.h). */
+    void Accept();
+
+    /* The answer of gvirtusLoad (see LoadReport.h). */
+    std::shared_ptr<communicators::Result> Load();
+    /* The answer of gvirtusSessionClass: puts session in a class of the scheduler. */
+    std::shared_ptr<communicators::Result> SessionClass(Scheduler::Session *session,
+                                                        std::shared_ptr<communicators::Buffer> in);
+
     std::shared_ptr<
         common::LD_Lib<communicators::Communicator, std::shared_ptr<communicators::Endpoint>>>
         _communicator;
     std::vector<std::shared_ptr<common::LD_Lib<Handler>>> _handlers;
 
     std::vector<std::string> mPlugins;
+    /* the connected frontends and the calls running for them */
+    std::atomic<uint32_t> mSessions{0};
+    std::atomic<uint32_t> mRunning{0};
+    Scheduler mScheduler;
+    Shards mShards;
+    nlohmann::json mPlacement;
     log4cplus::Logger logger;
 };
 }  // namespace gvirtus::backend
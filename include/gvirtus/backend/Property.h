@@ -47,10 +47,37 @@ class Property {
 
     inline bool &secure() { return _secure; }
 
+    /**
+     * The "scheduler" object of the configuration, null when it has none
+     * (see Scheduler.h).
+     */
+    Property &scheduler(const nlohmann::json &scheduler);
+
+    inline const nlohmann::json &scheduler() const { return _scheduler; }
+
+    /**
+     * The "shards" object of the configuration, null when it has none
+     * (see Shards.h).
+     */
+    Property &shards(const nlohmann::json &shards);
+
+    inline const nlohmann::json &shards() const { return _shards; }
+
+    /**
+     * The "placement" object of the configuration, null when it has none
+     * (see common/Placement.h).
+     */
+    Property &placement(const nlohmann::json &placement);
+
+    inline const nlohmann::json &placement() const { return _placement; }
+
    private:
     std::vector<std::vector<std::string>> _plugins;
     int _endpoints;
     bool _secure;
+    nlohmann::json _scheduler;
+    nlohmann::json _shards;
+    nlohmann::json _placement;
 };
 
 /**
@@ -69,5 +96,8 @@ inline void from_json(const nlohmann::json &j, Property &p) {
 
     p.endpoints(ends);
     p.secure(j["secure_application"].get<bool>());
+    if (j.contains("scheduler")) p.scheduler(j["scheduler"]);
+    if (j.contains("shards")) p.shards(j["shards"]);
+    if (j.contains("placement")) p.placement(j["placement"]);
 }
 }  // namespace gvirtus::backend
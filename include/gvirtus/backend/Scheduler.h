@@ -0,0 +1,165 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   Scheduler.h
+ *
+ * @brief  The order in which the calls of the sessions of an endpoint run.
+ *
+ * Without a "scheduler" object in the configuration, every session calls
+ * into the plugins as soon as its request is read. With one, a call waits
+ * for one of "slots" turns (1 by default) and the turns go:
+ *
+ * - to the waiting call of the class with the highest priority; a call of a
+ *   latency class overtakes the calls of lower classes that are waiting, but
+ *   never interrupts one that runs;
+ * - within a priority, by start-time fair queuing: a session is charged the
+ *   time its calls ran, divided by the weight of its class, and the session
+ *   charged least goes first. A session has one call at a time, so it
+ *   counts as queued while its next call comes within "idle_us" (2000) of
+ *   the last one; after longer, it starts over at the virtual time and
+ *   does not bank credit for the time it was idle.
+ *
+ *   "scheduler": {
+ *       "slots": 1,
+ *       "idle_us": 2000,
+ *       "default_class": "batch",
+ *       "classes": [
+ *           { "name": "inference", "priority": 1, "weight": 4, "stream_priority": "high" },
+ *           { "name": "batch", "weight": 1 }
+ *       ]
+ *   }
+ *
+ * A frontend puts its sessions in a class with gvirtusSessionClass (the
+ * GVIRTUS_SCHEDULER_CLASS variable). stream_priority ("high" or "low") asks
+ * the plugins to create the streams of the class with that priority
+ * (Handler::StreamPriority).
+ *
+ * Routines that only wait for the device (*Synchronize, the notification
+ * long poll) take no turn, or a session waiting for its own work would hold
+ * a turn the others need; they are charged all the same.
+ */
+
+#pragma once
+
+#include <gvirtus/communicators/Buffer.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "log4cplus/logger.h"
+
+namespace gvirtus::backend {
+class Scheduler {
+   public:
+    struct Class {
+        std::string name;
+        double weight = 1;
+        int priority = 0;
+        /* 1 for streams of the highest priority, -1 of the lowest, 0 the default */
+        int streamPriority = 0;
+
+        /* how long the calls of the class waited for their turn */
+        uint64_t calls = 0;
+        uint64_t waitUs = 0;
+        uint64_t maxWaitUs = 0;
+    };
+
+    /* The scheduling state of a connection of a frontend. */
+    struct Session {
+        Class *cls = nullptr;
+        /* virtual start and finish times of its last call */
+        double start = 0;
+        double finish = 0;
+        bool waiting = false;
+        bool granted = false;
+        std::chrono::steady_clock::time_point enqueued;
+        /* when its last call ended */
+        std::chrono::steady_clock::time_point ended;
+        std::condition_variable granting;
+    };
+
+    /* The turn of a call: waits for it when constructed, ends it when destroyed. */
+    class Turn {
+       public:
+        Turn(Scheduler *scheduler, Session *session, const std::string &routine);
+        ~Turn();
+
+       private:
+        Scheduler *mpScheduler;
+        Session *mpSession;
+        bool mSlot;
+        std::chrono::steady_clock::time_point mStart;
+    };
+
+    /* A scheduler configured by the "scheduler" object of the configuration, or none. */
+    explicit Scheduler(const nlohmann::json &config);
+
+    bool Enabled() const { return mEnabled; }
+
+    void Open(Session *session);
+    void Close(Session *session);
+
+    /* Moves session to the class name; NULL if there is none. */
+    const Class *Classify(Session *session, const std::string &name);
+
+    /* The calls waiting for a turn. */
+    uint32_t Waiting();
+
+    /*
+     * Adds to out the waits of every class: uint32_t count, then for each
+     * class its name, uint64_t calls, waitUs, maxWaitUs and uint32_t waiting.
+     */
+    void Stats(communicators::Buffer *out);
+
+   private:
+    /* Whether routine only waits for the device (see above). */
+    static bool Waits(const std::string &routine);
+
+    /* The virtual start time of a call of session that comes at now. */
+    double Start(const Session *session, std::chrono::steady_clock::time_point now) const;
+    void Acquire(Session *session);
+    void Release(Session *session, double seconds, bool slot);
+    /* Gives the free turns to the calls that come next; mMutex is held. */
+    void Grant();
+
+    bool mEnabled = false;
+    unsigned mSlots = 1;
+    unsigned mRunning = 0;
+    /* how long a session may leave between its calls and still be queued */
+    std::chrono::microseconds mIdle;
+    /* the virtual time: the start time of the last call given a turn */
+    double mVirtual = 0;
+    std::vector<std::unique_ptr<Class>> mClasses;
+    Class *mpDefault = nullptr;
+    std::list<Session *> mSessions;
+    std::mutex mMutex;
+    log4cplus::Logger logger;
+};
+}  // namespace gvirtus::backend
@@ -0,0 +1,125 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   Shards.h
+ *
+ * @brief  Worker processes that share the connections of an endpoint.
+ *
+ * Without a "shards" object in the configuration, the process of an endpoint
+ * loads the plugins and serves every connection with a thread of its own:
+ * all the tenants share its CUDA contexts, its malloc arenas and its locks.
+ * With one, that process only accepts the connections. It hands each one
+ * over (SCM_RIGHTS on an AF_UNIX socket pair) to one of its workers, which
+ * share nothing:
+ *
+ *   "shards": { "per": "gpu" }
+ *   "shards": { "per": "numa" }
+ *   "shards": { "workers": [ { "devices": "0", "numa": 0 },
+ *                            { "devices": "1,2", "cpus": "16-31" } ] }
+ *
+ * "per": "gpu" makes a worker for every NVIDIA GPU and "per": "numa" one
+ * for every NUMA node with its GPUs. In both, a worker runs on the CPUs of
+ * the node of its GPUs. A worker sets CUDA_VISIBLE_DEVICES to its "devices"
+ * (with CUDA_DEVICE_ORDER=PCI_BUS_ID) and pins itself to its "cpus", or to
+ * the CPUs of NUMA node "numa", before it loads the plugins. The GPUs and
+ * the nodes are those of common/Topology.h.
+ *
+ * The connections of one client go to the same worker, because the threads
+ * of a frontend share their device memory. A client is the process that a
+ * frontend announces with gvirtusSessionProcess, the first call of each of
+ * its connections. Without it, a client is the peer process of an AF_UNIX
+ * connection and the peer address of a TCP one. A new client goes to the
+ * worker with the fewest clients.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "log4cplus/logger.h"
+
+namespace gvirtus::backend {
+class Shards {
+   public:
+    struct Worker {
+        /* CUDA_VISIBLE_DEVICES, all of them if empty */
+        std::string devices;
+        /* the CPUs it runs on, all of them if empty */
+        std::vector<int> cpus;
+
+        /* acceptor: its end of the socket pair, its pid and its clients */
+        int fd = -1;
+        pid_t pid = 0;
+        size_t clients = 0;
+    };
+
+    /* The workers configured by the "shards" object of the configuration, or none. */
+    explicit Shards(const nlohmann::json &config);
+    ~Shards();
+
+    bool Enabled() const { return !mWorkers.empty(); }
+
+    /*
+     * Forks the workers. Returns the index of the worker in the worker, once
+     * it is pinned, and -1 in the acceptor.
+     */
+    int Fork();
+
+    /*
+     * Acceptor: hands the connection fd over to the worker of its client and
+     * closes it. It waits for the first call of the connection, so it runs
+     * on a thread of its own.
+     */
+    void Route(int fd);
+
+    /* Worker: the next connection handed over, or -1 when the acceptor is gone. */
+    int Receive(uint64_t *client);
+
+    /* Worker: tells the acceptor that a connection of client has ended. */
+    void Ended(uint64_t client);
+
+   private:
+    /* The client of the connection fd (see above). */
+    static uint64_t Client(int fd);
+    /* Peeks at the gvirtusSessionProcess call that opens fd, if any, for its key. */
+    static bool Announced(int fd, uint64_t *key);
+    /* Acceptor: reads the ends of the connections, and the end of the workers. */
+    void Watch();
+    void Pin(const Worker &worker);
+
+    std::vector<Worker> mWorkers;
+    /* worker: its end of the socket pair */
+    int mFd = -1;
+    /* acceptor: the worker and the connections of every client */
+    std::map<uint64_t, std::pair<size_t, size_t>> mClients;
+    std::mutex mMutex;
+    log4cplus::Logger logger;
+};
+}  // namespace gvirtus::backend
@@ -0,0 +1,48 @@
+/**
+ * @file   Base64.h
+ *
+ * @brief  Base64 (RFC 4648) of whole buffers, with SSE4.1 and AVX2 kernels
+ * chosen at run time and a scalar fallback. Binary payloads travel as raw
+ * bytes in a Buffer; this is for text that must stay text.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace gvirtus::common {
+class Base64 {
+   public:
+    enum Implementation { SCALAR, SSE41, AVX2 };
+
+    /* The fastest implementation this CPU runs. */
+    static Implementation Best();
+
+    static bool Supported(Implementation implementation);
+
+    static const char *Name(Implementation implementation);
+
+    /* The length of the padded encoding of size bytes. */
+    static size_t EncodedSize(size_t size) { return (size + 2) / 3 * 4; }
+
+    /* The most bytes size characters decode to. */
+    static size_t DecodedSize(size_t size) { return size / 4 * 3 + (size % 4) * 3 / 4; }
+
+    /* Writes the EncodedSize(size) characters encoding data to out. */
+    static void Encode(const void *data, size_t size, char *out,
+                       Implementation implementation = Best());
+
+    static std::string Encode(const void *data, size_t size);
+
+    /*
+     * Decodes size characters, padded or not, into at most DecodedSize(size)
+     * bytes of out. Returns the bytes written, or -1 if the characters are
+     * not base64 (whitespace included).
+     */
+    static ptrdiff_t Decode(const char *text, size_t size, void *out,
+                            Implementation implementation = Best());
+
+    static bool Decode(const std::string &text, std::string *out);
+};
+}  // namespace gvirtus::common
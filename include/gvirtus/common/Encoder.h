@@ -33,7 +33,6 @@ class Encoder {
    private:
     int CHARS_PER_LINE;
 
-    int _buffersize;
     EncodeStep step;
     char result;
     int stepcount;
@@ -0,0 +1,89 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   Placement.h
+ *
+ * @brief  Runs a session of the backend near the GPU it uses.
+ *
+ * On a machine with several NUMA nodes, the thread serving a session runs
+ * on the CPUs of the node of its current GPU, and the memory it allocates
+ * from then on (the buffers of the calls, the staging of the copies) is
+ * taken from that node. The "placement" object of the backend
+ * configuration changes the policy:
+ *
+ *   "placement": { "policy": "device", "devices": { "0000:3b:00.0": 1 } }
+ *
+ * "policy" is "device" (the default) or "none"; "devices" gives the node
+ * of a GPU by its PCI bus id, over what sysfs tells.
+ */
+
+#pragma once
+
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "Topology.h"
+#include "log4cplus/logger.h"
+
+namespace gvirtus::common {
+class Placement {
+   public:
+    Placement(const nlohmann::json &config, const Topology &topology);
+
+    /* The placement of the backend, set by Configure(); none until then. */
+    static Placement &GetInstance();
+
+    /* Configures GetInstance() with the topology of this machine. */
+    static void Configure(const nlohmann::json &config);
+
+    bool Enabled() const { return mEnabled; }
+
+    /* The node the sessions using the GPU bus run on, -1 to leave them alone. */
+    int Node(const std::string &bus) const;
+
+    /*
+     * The CPUs of node the process may run on; empty if none, and then the
+     * thread is not pinned.
+     */
+    std::vector<int> Cpus(int node) const;
+
+    /*
+     * Moves the calling thread, and the memory it allocates from now on, to
+     * the node of the GPU bus. Does nothing if it is there already.
+     */
+    void Bind(const std::string &bus);
+
+    /* The node the calling thread was bound to, -1 if none. */
+    static int Bound();
+
+   private:
+    bool mEnabled = false;
+    Topology mTopology;
+    std::map<std::string, int> mOverrides;
+    /* the CPUs the process may run on, when it was configured */
+    std::vector<int> mAllowed;
+    log4cplus::Logger logger;
+};
+}  // namespace gvirtus::common
@@ -0,0 +1,40 @@
+/**
+ * @file   Sha256.h
+ *
+ * @brief  SHA-256 (FIPS 180-4), to name contents shared by the clients of a
+ * backend: unlike a plain hash, a client cannot forge the name of someone
+ * else's contents.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace gvirtus::common {
+class Sha256 {
+   public:
+    typedef std::array<uint8_t, 32> Digest;
+
+    Sha256();
+
+    void Update(const void *data, size_t size);
+
+    /* The digest of everything updated so far; the object must not be updated after. */
+    Digest Final();
+
+    static Digest Of(const void *data, size_t size);
+
+    static std::string ToString(const Digest &digest);
+
+   private:
+    void Transform(const uint8_t *block);
+
+    uint32_t mState[8];
+    uint64_t mLength;
+    uint8_t mBlock[64];
+    size_t mBlockSize;
+};
+}  // namespace gvirtus::common
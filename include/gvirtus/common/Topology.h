@@ -0,0 +1,69 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   Topology.h
+ *
+ * @brief  The NUMA nodes and the NVIDIA GPUs of the machine, from sysfs.
+ *
+ * The root of sysfs is a parameter, so a test can describe a machine with
+ * a directory tree:
+ *
+ *   <root>/devices/system/node/node<N>/cpulist         "0-15,32-47"
+ *   <root>/bus/pci/devices/<bus id>/vendor             "0x10de"
+ *   <root>/bus/pci/devices/<bus id>/class              "0x030200"
+ *   <root>/bus/pci/devices/<bus id>/numa_node          "1", or "-1"
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace gvirtus::common {
+class Topology {
+   public:
+    explicit Topology(const std::filesystem::path &sysfs = "/sys");
+
+    /* The NUMA nodes, in ascending order; empty without NUMA support. */
+    std::vector<int> Nodes() const;
+
+    /* The CPUs of node, none if it has none or does not exist. */
+    const std::vector<int> &Cpus(int node) const;
+
+    /* The PCI bus ids of the GPUs, in ascending order, lower case. */
+    const std::vector<std::string> &Gpus() const { return mGpus; }
+
+    /* The NUMA node of the PCI device bus (any case), -1 if unknown. */
+    int Node(const std::string &bus) const;
+
+    /* The CPUs of a list like "0-3,8,10-11". */
+    static std::vector<int> ParseCpus(const std::string &list);
+
+   private:
+    std::map<int, std::vector<int>> mCpus;
+    std::vector<std::string> mGpus;
+    std::map<std::string, int> mGpuNodes;
+};
+}  // namespace gvirtus::common
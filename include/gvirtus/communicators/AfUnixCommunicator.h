@@ -33,10 +33,9 @@
  *
  */
 
-#ifndef _AFUNIXCOMMUNICATOR_H
-#define _AFUNIXCOMMUNICATOR_H
+#pragma once
 
-#ifndef __WIN32
+#ifndef _WIN32
 
 #include <fcntl.h>
 #include <sys/mman.h>
@@ -46,7 +45,7 @@
 
 #include "Communicator.h"
 
-namespace gvirtus {
+namespace gvirtus::communicators {
 
 /**
  * AfUnixCommunicator implements a Communicator for the AF_UNIX socket in the unix domain.
@@ -85,12 +84,16 @@ class AfUnixCommunicator : public Communicator {
     virtual ~AfUnixCommunicator();
     void Serve();
     const Communicator *const Accept() const;
+    int AcceptSocket() const override;
+    const Communicator *const Adopt(int fd) const override;
     void Connect();
     size_t Read(char *buffer, size_t size);
     size_t Write(const char *buffer, size_t size);
     void Sync();
     void Close();
 
+    std::string to_string() override { return "afunixcommunicator"; }
+
    private:
     /**
      * Initializes the input and output streams.
@@ -99,14 +102,12 @@ class AfUnixCommunicator : public Communicator {
     std::istream *mpInput;  /**< the input stream for sending */
     std::ostream *mpOutput; /**< the output stream for receiving data */
     std::string mPath;      /**< the path of the AF_UNIX socket */
-    int mSocketFd;          /**< the file descriptor of the connected socket */
+    int mSocketFd = -1;     /**< the file descriptor of the connected socket */
     __gnu_cxx::stdio_filebuf<char> *mpInputBuf;
     __gnu_cxx::stdio_filebuf<char> *mpOutputBuf;
     mode_t mMode;
 };
 
-}  // namespace gvirtus
+}  // namespace gvirtus::communicators
 
 #endif
-
-#endif /* _AFUNIXCOMMUNICATOR_H */
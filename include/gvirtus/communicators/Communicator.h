@@ -44,6 +44,23 @@ class Communicator {
      */
     virtual const Communicator *const Accept() const = 0;
 
+    /**
+     * Accepts a new connection and returns its socket, for a process that
+     * hands it over to another one (see Adopt()).
+     *
+     * @return the socket of the connection, or -1 if this communicator
+     * cannot hand its connections over.
+     */
+    virtual int AcceptSocket() const { return -1; }
+
+    /**
+     * Wraps a socket returned by AcceptSocket(), in this or another process,
+     * as Accept() would have.
+     *
+     * @return a Communicator to the connected peer, or NULL.
+     */
+    virtual const Communicator *const Adopt(int fd) const { return nullptr; }
+
     /**
      * Sets the communicator as a client and connects it to the end point
      * specified in the ConfigFile::Element used to build this Communicator.
@@ -33,10 +33,12 @@ class CommunicatorFactory {
         std::cout << "CommunicatorFactory::get_communicator(): found gvirtus home: " << gvirtus_home
                   << std::endl;
 #endif
+#ifdef DEBUG
         std::cout << "DEBUG: protocol string is [" << end->protocol() << "]" << std::endl;
+#endif
         // Supported unsecure communicators
         std::vector<std::string> unsecureMatches = {
-            "tcp", "http", "oldtcp", "ws", "ib", "hybrid",
+            "tcp", "http", "oldtcp", "ws", "ib", "hybrid", "unix", "shm",
 
         };
 
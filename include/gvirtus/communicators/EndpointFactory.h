@@ -6,11 +6,14 @@
 
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
 
 #include "Endpoint.h"
+#include "Endpoint_AfUnix.h"
 #include "Endpoint_Hybrid.h"
 #include "Endpoint_Rdma.h"
+#include "Endpoint_Shm.h"
 #include "Endpoint_Tcp.h"
 
 // #define DEBUG
@@ -20,6 +23,43 @@ namespace gvirtus::communicators {
 class EndpointFactory {
    public:
     static std::shared_ptr<Endpoint> get_endpoint(const fs::path &json_path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto ptr = parse(json_path);
+
+        // The backend walks the communicator array once per Process.
+        ind_endpoint = (ind_endpoint + 1) % count(json_path);
+        return ptr;
+    }
+
+    /*
+     * The endpoint of the entry index of the communicator array. A frontend
+     * whose configuration lists several backends connects to each of them.
+     */
+    static std::shared_ptr<Endpoint> get_endpoint(const fs::path &json_path, int index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ind_endpoint = index;
+        return parse(json_path);
+    }
+
+    /* The number of entries of the communicator array. */
+    static size_t count(const fs::path &json_path) {
+        std::ifstream ifs(json_path);
+        if (!ifs.is_open()) {
+            throw std::runtime_error("Cannot open configuration file: " + json_path.string());
+        }
+        nlohmann::json j;
+        ifs >> j;
+        if (!j.contains("communicator") || !j["communicator"].is_array() ||
+            j["communicator"].empty()) {
+            throw std::runtime_error("Invalid or missing 'communicator' array in configuration.");
+        }
+        return j["communicator"].size();
+    }
+
+    static int index() { return ind_endpoint; }
+
+   private:
+    static std::shared_ptr<Endpoint> parse(const fs::path &json_path) {
 #ifdef DEBUG
         std::cout << "EndpointFactory::get_endpoint() called" << std::endl;
 #endif
@@ -43,7 +83,12 @@ class EndpointFactory {
             throw std::runtime_error("Invalid or missing 'communicator' array in configuration.");
         }
 
-        const auto &endpoint_obj = j["communicator"][0]["endpoint"];
+        if (ind_endpoint < 0 || ind_endpoint >= (int)j["communicator"].size()) {
+            throw std::runtime_error("No entry " + std::to_string(ind_endpoint) +
+                                     " in the 'communicator' array of the configuration.");
+        }
+
+        const auto &endpoint_obj = j["communicator"][ind_endpoint]["endpoint"];
         if (!endpoint_obj.contains("suite") || endpoint_obj["suite"].is_null()) {
             throw std::runtime_error("Missing or null 'suite' in endpoint configuration.");
         }
@@ -77,13 +122,19 @@ class EndpointFactory {
 #endif
             auto end = common::JSON<Endpoint_Hybrid>(json_path).parser();
             ptr = std::make_shared<Endpoint_Hybrid>(end);
+        } else if (suite == "unix") {
+            LOG4CPLUS_INFO(logger, "Initializing AF_UNIX Endpoint");
+            auto end = common::JSON<Endpoint_AfUnix>(json_path).parser();
+            ptr = std::make_shared<Endpoint_AfUnix>(end);
+        } else if (suite == "shm") {
+            LOG4CPLUS_INFO(logger, "Initializing shared memory Endpoint");
+            auto end = common::JSON<Endpoint_Shm>(json_path).parser();
+            ptr = std::make_shared<Endpoint_Shm>(end);
         } else {
             throw std::runtime_error(
                 "EndpointFactory::get_endpoint(): Your suite is not compatible!");
         }
 
-        ind_endpoint++;
-
         j.clear();
         ifs.close();
 
@@ -95,9 +146,8 @@ class EndpointFactory {
         return ptr;
     }
 
-    static int index() { return ind_endpoint; }
-
-   private:
     static int ind_endpoint;
+    /* the endpoints read ind_endpoint while they parse */
+    static std::mutex mutex;
 };
 }  // namespace gvirtus::communicators
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <nlohmann/json.hpp>
+
+#include "Endpoint.h"
+
+namespace gvirtus::communicators {
+/**
+ * Endpoint_AfUnix class.
+ * This class is a model to represent an AF_UNIX socket endpoint, used when
+ * the frontend and the backend live on the same host.
+ */
+class Endpoint_AfUnix : public Endpoint {
+   public:
+    Endpoint_AfUnix() = default;
+
+    explicit Endpoint_AfUnix(const std::string &endp_suite, const std::string &endp_protocol,
+                             const std::string &endp_path, const std::string &endp_mode);
+
+    explicit Endpoint_AfUnix(const std::string &endp_suite)
+        : Endpoint_AfUnix(endp_suite, "unix", "/tmp/gvirtus.sock", "0660") {}
+
+    Endpoint &suite(const std::string &suite) override;
+
+    Endpoint &protocol(const std::string &protocol) override;
+
+    /**
+     * This method is a setter for the class member _path
+     * @param path: string containing the filesystem path of the socket
+     * @return reference to itself (Fluent Interface API)
+     */
+    Endpoint_AfUnix &path(const std::string &path);
+
+    /**
+     * This method is a setter for the class member _mode
+     * @param mode: string containing the octal permissions of the socket
+     * @return reference to itself (Fluent Interface API)
+     */
+    Endpoint_AfUnix &mode(const std::string &mode);
+
+    /**
+     * This method is a getter for the class member _path
+     * @return reference to class member _path
+     */
+    inline const std::string &path() const { return _path; }
+
+    /**
+     * This method is a getter for the class member _mode
+     * @return reference to class member _mode
+     */
+    inline const mode_t &mode() const { return _mode; }
+
+    /**
+     * This method return an object description
+     * @return string that represents the concatenation between class member
+     */
+    virtual inline const std::string to_string() const override {
+        return _suite + ":" + _protocol + "://" + _path;
+    }
+
+   private:
+    std::string _path;
+    mode_t _mode = 0660;
+};
+
+/**
+ * This function will be used by nlohmann::json object when we call
+ * j.get&lt;Property&lt;(). Without this function the program doesn't know how
+ * to build a property object from json object.
+ * @param j: reference to json object which contains the data
+ * @param p: reference to endpoint object to be created
+ */
+void from_json(const nlohmann::json &j, Endpoint_AfUnix &end);
+}  // namespace gvirtus::communicators
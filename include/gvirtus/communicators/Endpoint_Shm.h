@@ -0,0 +1,63 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include "Endpoint.h"
+
+namespace gvirtus::communicators {
+/**
+ * Endpoint_Shm class.
+ * This class is a model to represent a shared memory endpoint. The address
+ * and port are only used for the UDP rendezvous that hands the name of the
+ * POSIX shared memory segment to the frontend.
+ */
+class Endpoint_Shm : public Endpoint {
+   public:
+    Endpoint_Shm() = default;
+
+    explicit Endpoint_Shm(const std::string &endp_suite, const std::string &endp_protocol,
+                          const std::string &endp_address, const std::string &endp_port);
+
+    explicit Endpoint_Shm(const std::string &endp_suite)
+        : Endpoint_Shm(endp_suite, "shm", "127.0.0.1", "6666") {}
+
+    Endpoint &suite(const std::string &suite) override;
+
+    Endpoint &protocol(const std::string &protocol) override;
+
+    /**
+     * This method is a setter for the class member _address
+     * @param address: string containing the rendezvous address
+     * @return reference to itself (Fluent Interface API)
+     */
+    Endpoint_Shm &address(const std::string &address);
+
+    /**
+     * This method is a setter for the class member _port
+     * @param port: string containing the rendezvous port
+     * @return reference to itself (Fluent Interface API)
+     */
+    Endpoint_Shm &port(const std::string &port);
+
+    inline const std::string &address() const { return _address; }
+
+    inline const std::uint16_t &port() const { return _port; }
+
+    virtual inline const std::string to_string() const override {
+        return _suite + ":" + _protocol + "://" + _address + ":" + std::to_string(_port);
+    }
+
+   private:
+    std::string _address;
+    std::uint16_t _port = 6666;
+};
+
+/**
+ * This function will be used by nlohmann::json object when we call
+ * j.get&lt;Property&lt;(). Without this function the program doesn't know how
+ * to build a property object from json object.
+ * @param j: reference to json object which contains the data
+ * @param p: reference to endpoint object to be created
+ */
+void from_json(const nlohmann::json &j, Endpoint_Shm &end);
+}  // namespace gvirtus::communicators
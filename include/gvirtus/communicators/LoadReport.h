@@ -0,0 +1,53 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   LoadReport.h
+ *
+ * @brief  The load of a backend endpoint, the answer of gvirtusLoad.
+ *
+ * The frontend of an endpoint group asks every backend of the group for it
+ * when a process starts, and connects to the least loaded one (see
+ * gvirtus::frontend::EndpointGroup).
+ *
+ *   in:  nothing
+ *   out: LoadReport
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace gvirtus::communicators {
+
+struct LoadReport {
+    /* frontends connected to the endpoint, the asking one excluded */
+    uint32_t sessions;
+    /* calls being executed for them */
+    uint32_t running;
+    /* calls waiting for a turn of the scheduler (see backend/Scheduler.h) */
+    uint32_t waiting;
+    /* bytes of device memory free and in all, over every device; 0 if unknown */
+    uint64_t memoryFree;
+    uint64_t memoryTotal;
+};
+}  // namespace gvirtus::communicators
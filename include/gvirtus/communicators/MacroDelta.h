@@ -0,0 +1,57 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   MacroDelta.h
+ *
+ * @brief  The encoding of how the input of a call differs from the input it
+ * had when its macro was recorded, as runs of changed bytes.
+ *
+ * A replay of a macro carries the deltas of the calls whose inputs changed:
+ * in a training loop, a few pointers and scalars out of the hundreds of
+ * calls of an iteration.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Buffer.h"
+
+namespace gvirtus::communicators {
+
+class MacroDelta {
+   public:
+    /* Appends to out the delta turning recorded into the size bytes of current. */
+    static void Encode(const std::vector<char> &recorded, const char *current, size_t size,
+                       Buffer *out);
+
+    /* Reads a delta from in and applies it to input, a copy of the recorded input. */
+    static void Apply(Buffer *in, std::vector<char> *input);
+
+   private:
+    /* Runs of changed bytes closer than this are sent as one. */
+    static constexpr size_t MERGE_GAP = 16;
+};
+}  // namespace gvirtus::communicators
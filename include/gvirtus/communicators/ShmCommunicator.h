@@ -33,21 +33,22 @@
  *
  */
 
-#ifndef SHMCOMMUNICATOR_H
-#define SHMCOMMUNICATOR_H
+#pragma once
 
 #include <semaphore.h>
 
+#include <cstdint>
 #include <string>
 
 #include "Communicator.h"
 
-namespace gvirtus {
+namespace gvirtus::communicators {
 
 class ShmCommunicator : public Communicator {
    public:
     ShmCommunicator(const std::string &communicator);
     ShmCommunicator();
+    ShmCommunicator(const std::string &address, uint16_t port);
     virtual ~ShmCommunicator();
     void Serve();
     const Communicator *const Accept() const;
@@ -57,9 +58,13 @@ class ShmCommunicator : public Communicator {
     void Sync();
     void Close();
 
+    std::string to_string() override { return "shmcommunicator"; }
+
    private:
     ShmCommunicator(const char *name);
     size_t ReadPacket(char *buffer);
+    std::string mAddress;
+    uint16_t mPort = 6666;
     int mSocketFd;
     int mFd;
     char *mpShm;
@@ -80,5 +85,4 @@ class ShmCommunicator : public Communicator {
     size_t mLocalOutSize;
     size_t mLocalOutOffset;
 };
-}  // namespace gvirtus
-#endif /* SHMCOMMUNICATOR_H */
+}  // namespace gvirtus::communicators
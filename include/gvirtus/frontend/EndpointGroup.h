@@ -0,0 +1,97 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   EndpointGroup.h
+ *
+ * @brief  The backends of a configuration as replicas of one another.
+ *
+ * A configuration with a "group" object lists interchangeable backends in
+ * its communicator array:
+ *
+ *   "group": { "policy": "least-loaded" }
+ *
+ * A process uses one backend of the group. With "least-loaded" it asks every
+ * backend for its load (LoadReport.h) the first time a thread connects, and
+ * ranks them by sessions and running calls, then free device memory, then
+ * round trip time. With "hash" it ranks them by rendezvous hashing of
+ * GVIRTUS_AFFINITY (the host name if unset), so the processes with the same
+ * key share a backend, and only the keys of a backend that goes away move.
+ *
+ * The threads of a process connect to its backend. When it cannot be
+ * reached before the first thread connected, the next one of the ranking
+ * takes its place. Once a thread connected, the sessions of the process hold
+ * state on its backend, so a thread that cannot reach it fails instead.
+ */
+
+#pragma once
+
+#include <gvirtus/common/LD_Lib.h>
+#include <gvirtus/communicators/Communicator.h>
+#include <gvirtus/communicators/Endpoint.h>
+#include <gvirtus/communicators/LoadReport.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "log4cplus/logger.h"
+
+namespace gvirtus::frontend {
+
+class EndpointGroup {
+   public:
+    using Connection = std::shared_ptr<
+        common::LD_Lib<communicators::Communicator, std::shared_ptr<communicators::Endpoint>>>;
+
+    /* The group of the configuration at path, NULL if it has none. */
+    static EndpointGroup *GetInstance(const std::string &path);
+
+    /*
+     * Connects to the backend of the process. Before the first connection,
+     * tries the next ones of the ranking in turn. Throws if none can be
+     * reached, or if the backend of the process cannot be after it.
+     */
+    Connection Connect(std::shared_ptr<communicators::Endpoint> *endpoint);
+
+   private:
+    enum class Policy { LeastLoaded, Hash };
+
+    EndpointGroup(const std::string &path, Policy policy);
+
+    void Rank();
+    /* Asks backend for its load; false if it cannot be reached. */
+    bool Probe(size_t backend, communicators::LoadReport *load, bool *reported,
+               double *rtt);
+
+    Policy mPolicy;
+    std::vector<std::shared_ptr<communicators::Endpoint>> mEndpoints;
+    /* the backends from the best, and the one of the process */
+    std::vector<size_t> mRanking;
+    size_t mCurrent = 0;
+    /* set once a thread connected: the process stays on mCurrent */
+    bool mConnected = false;
+    std::mutex mMutex;
+    log4cplus::Logger logger;
+};
+}  // namespace gvirtus::frontend
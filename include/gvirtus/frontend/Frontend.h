@@ -40,18 +40,23 @@
 #include <gvirtus/communicators/Communicator.h>
 
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace gvirtus::frontend {
+class Macros;
+
 /**
  * Frontend is the object used by every cuda routine wrapper for requesting the
  * execution to the backend.
  *
- * Frontend is a singleton, the single instance can be retrived through the
- * static member getInstance().
+ * Every thread has a Frontend of its own, with its own connections to the
+ * backends: GetFrontend() returns the one of the calling thread, which it
+ * keeps in a thread_local context and creates on the first call.
  *
  * For requesting the execution of a cuda routine to the backend the wrapper has
  * to:
- * -# retrieve the Frontend instance.
+ * -# retrieve the Frontend of the thread.
  * -# prepare the execution using the Prepare() method.
  * -# add the input parameters in the correct order with the Add...() methods.
  * -# requests the execution of a named routine with Execute() method.
@@ -67,7 +72,9 @@ class Frontend {
     virtual ~Frontend();
 
     /**
-     * Retrieves the single instance of the Frontend class.
+     * Retrieves the Frontend of the calling thread, connecting it on the first
+     * call. Later calls only read a thread_local pointer; the Frontend is
+     * released when the thread exits.
      *
      * @param register_var
      *
@@ -86,6 +93,65 @@ class Frontend {
      */
     void Execute(const char *routine, const communicators::Buffer *input_buffer = NULL);
 
+    /**
+     * Returns the number of backends listed in the configuration file, or 1
+     * when they form a group of replicas (see EndpointGroup.h).
+     */
+    size_t GetBackendCount() const { return mCommunicators.size(); }
+
+    /**
+     * Returns the backend the calls of this thread are sent to, an index of
+     * the communicator array of the configuration file.
+     */
+    size_t GetBackend() const { return mBackend; }
+
+    /**
+     * Sends the next calls of this thread to backend, connecting to it the
+     * first time.
+     *
+     * @return false if backend does not exist or cannot be reached; the calls
+     * keep going to the previous one.
+     */
+    bool SetBackend(size_t backend);
+
+    /**
+     * Adds a function that a thread calls each time it connects to a backend,
+     * its first one included, with that backend selected. Plugins send there
+     * what the process set up on the other backends, such as the
+     * registrations of its kernels, or what every session of the process
+     * must hold.
+     */
+    static void AddConnectHook(void (*hook)(size_t backend));
+
+    /**
+     * Returns the device the calls of this thread run on, as the runtime
+     * plugin last recorded it with SetDevice(): 0 until then, as in CUDA.
+     * Plugins key what they cache per device on it without a round trip.
+     */
+    int GetDevice() const { return mDevice; }
+    void SetDevice(int device) { mDevice = device; }
+
+    /**
+     * Starts a region of calls to record as a macro, or to replay if a region
+     * with this name was recorded already (see Macros.h).
+     *
+     * @return 0, or -1 if a region is already open or the backend has no macros.
+     */
+    int BeginMacro(const char *name);
+
+    /**
+     * Ends the region started by BeginMacro().
+     *
+     * @return the first error of the calls deferred in the region, 0 if none,
+     * or -1 if no region is open.
+     */
+    int EndMacro();
+
+    /**
+     * @return the number of calls of this thread deferred into macro replays.
+     */
+    uint64_t MacroCallsDeferred() const;
+
     /**
      * Prepares the Frontend for the execution. This method _must_ be called
      * before any requests of execution or any method for adding parameters for
@@ -214,6 +280,20 @@ class Frontend {
 #endif
 
    private:
+    friend struct ThreadContext;
+    friend class Macros;
+
+    /* Sends routine to the backend and reads its answer, as Execute() does. */
+    void Send(const char *routine, const communicators::Buffer *input_buffer);
+    /* SetBackend() without telling the macros. */
+    bool SelectBackend(size_t backend);
+    /* Tells the current backend the process of the session (see backend/Shards.h). */
+    void SendSessionProcess();
+    /* Puts the session on the current backend in the class GVIRTUS_SCHEDULER_CLASS, if set. */
+    void SendSessionClass();
+    /* Sets up the session just opened on the current backend, then runs the connect hooks. */
+    void Connected();
+
     /**
      * Constructs a new Frontend. It creates and sets also the Communicator to
      * use obtaining the information from the configuration file which path is
@@ -223,6 +303,13 @@ class Frontend {
     std::shared_ptr<
         common::LD_Lib<communicators::Communicator, std::shared_ptr<communicators::Endpoint>>>
         _communicator;
+    /* by backend; a communicator is null until the thread first selects it */
+    std::vector<std::shared_ptr<communicators::Endpoint>> mEndpoints;
+    std::vector<std::shared_ptr<
+        common::LD_Lib<communicators::Communicator, std::shared_ptr<communicators::Endpoint>>>>
+        mCommunicators;
+    size_t mBackend = 0;
+    int mDevice = 0;
     std::shared_ptr<communicators::Buffer> mpInputBuffer;
     std::shared_ptr<communicators::Buffer> mpOutputBuffer;
     std::shared_ptr<communicators::Buffer> mpLaunchBuffer;
@@ -230,6 +317,8 @@ class Frontend {
     int mExitCode;
     static std::map<pthread_t, Frontend *> *mpFrontends;
     bool mpInitialized;
+    /* created by the first BeginMacro() */
+    std::unique_ptr<Macros> mpMacros;
 
     uint64_t mRoutinesExecuted = 0;
     uint64_t mDataSent = 0;
@@ -0,0 +1,85 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   LocalTier.h
+ *
+ * @brief  Answers of routines that need no round trip to the backend.
+ *
+ * Routines in the local tier are pure functions of their arguments that the
+ * frontend computes by itself: the names of the constants of an enum come
+ * from tables that gvirtus_generate_enum_names (cmake/GVirtuS.cmake) writes
+ * from the library headers at configure time. Routines in the cacheable tier
+ * ask the backend once per argument, since the answer belongs to its library
+ * (an error description, a version), and the answer is kept for the life of
+ * the process. See docs/api-tiers.md for the routines in each tier.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace gvirtus::frontend {
+
+/* A constant of an enum and its name, an entry of a generated table. */
+struct EnumName {
+    long long value;
+    const char *name;
+};
+
+/* The name of value in a generated table, NULL if the table lacks it. */
+template <size_t N>
+inline const char *FindEnumName(const EnumName (&names)[N], long long value) {
+    for (auto &name : names)
+        if (name.value == value) return name.name;
+    return nullptr;
+}
+
+/*
+ * The answers of a cacheable routine, by argument. Answers are never evicted,
+ * so pointers into them (the c_str() of an error string) stay valid.
+ */
+template <typename Key, typename Value>
+class LocalCache {
+   public:
+    /*
+     * The answer for key, asking fetch(Value *) for it the first time; fetch
+     * returns false when the backend failed, and the failure is not cached.
+     */
+    template <typename Fetch>
+    const Value *Get(const Key &key, Fetch fetch) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mValues.find(key);
+        if (it != mValues.end()) return &it->second;
+        Value value;
+        if (!fetch(&value)) return nullptr;
+        return &mValues.emplace(key, std::move(value)).first->second;
+    }
+
+   private:
+    std::mutex mMutex;
+    std::map<Key, Value> mValues;
+};
+}  // namespace gvirtus::frontend
@@ -0,0 +1,149 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   Macros.h
+ *
+ * @brief  Call sequences recorded once and replayed by id.
+ *
+ * A training loop issues the same calls every iteration, with the same
+ * handles, and only a few pointers and scalars change. The application marks
+ * such a region with gvirtusMacroBegin(name) and gvirtusMacroEnd(). The
+ * first time, the calls run as usual and are recorded. At the end the
+ * frontend defines them on the backend as a macro. From then on, each call
+ * of the region to a routine that only enqueues work, which its plugin lists
+ * with AllowDeferring(), is not sent if it succeeded with no output when
+ * recorded. It returns success at once, and the frontend sends only how its
+ * input changed. Calls that synchronize, query or return errors are never
+ * listed, and always run. The backend runs the deferred calls when a call that needs an
+ * answer comes, or at the end of the region, with one gvirtusMacroReplay.
+ *
+ * An error of a deferred call is returned by the replay, so it surfaces in
+ * gvirtusMacroEnd, as an error of an asynchronous launch does in a later
+ * call. A region whose calls differ from the recording runs as usual from
+ * the first difference on, and is recorded again the next time.
+ */
+
+#pragma once
+
+#include <gvirtus/communicators/Buffer.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "log4cplus/logger.h"
+
+namespace gvirtus::frontend {
+class Frontend;
+
+/* The macros of a Frontend, which are defined on its connection. */
+class Macros {
+   public:
+    explicit Macros(Frontend *frontend);
+
+    int Begin(const std::string &name);
+    int End();
+
+    /*
+     * Adds routines that only enqueue work, the only ones a macro defers. A
+     * plugin frontend lists its own as it loads; returns true, to initialize
+     * a static with.
+     */
+    static bool AllowDeferring(std::initializer_list<const char *> routines);
+
+    /* The number of calls deferred into replays so far. */
+    uint64_t Deferred() const { return mDeferred; }
+
+    /*
+     * Called by Frontend::Execute before sending routine: whether the call is
+     * deferred into a replay.
+     */
+    bool Defer(const char *routine, const communicators::Buffer *input_buffer);
+
+    /* Called by Frontend::Execute after sending routine. */
+    void Executed(const char *routine, const communicators::Buffer *input_buffer, int exit_code,
+                  size_t output_size);
+
+    /*
+     * Called by Frontend::SetBackend before the calls go to another backend:
+     * the region runs as usual from then on.
+     */
+    void Switching();
+
+   private:
+    struct Call {
+        std::string routine;
+        std::vector<char> input;
+        /* enqueues work, and succeeded with no output when recorded */
+        bool deferrable;
+    };
+
+    struct Macro {
+        uint64_t id;
+        /* the backend it is defined on */
+        size_t backend;
+        std::vector<Call> calls;
+    };
+
+    enum class Mode { Idle, Recording, Replaying, Diverged };
+
+    void Define();
+    /* Sends the calls deferred since the last replay. */
+    void Flush();
+    void Forget();
+
+    Frontend *mpFrontend;
+    std::map<std::string, Macro> mMacros;
+    uint64_t mNextId = 1;
+    /* set when the backend has no macros */
+    bool mDisabled = false;
+
+    Mode mMode = Mode::Idle;
+    std::string mName;
+    Macro *mpMacro = nullptr;
+    /* the next call of the macro, and the first not replayed yet */
+    size_t mPosition = 0;
+    size_t mFirst = 0;
+    communicators::Buffer mDeltas;
+    uint32_t mChanged = 0;
+    /* the first error of a replay in the region */
+    int mError = 0;
+    uint64_t mDeferred = 0;
+
+    log4cplus::Logger logger;
+};
+}  // namespace gvirtus::frontend
+
+extern "C" {
+/*
+ * Starts the region named name. Returns 0, or -1 if a region is already open
+ * or the backend has no macros.
+ */
+int gvirtusMacroBegin(const char *name);
+/* Ends the region, returning the first error of its deferred calls, or 0. */
+int gvirtusMacroEnd(void);
+/* The number of calls of the thread deferred into replays so far. */
+uint64_t gvirtusMacroDeferred(void);
+}
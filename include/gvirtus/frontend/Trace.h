@@ -0,0 +1,162 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   Trace.h
+ *
+ * @brief  Binary trace of the routines executed by a frontend.
+ *
+ * A trace is an append-only, memory-mapped file. It starts with a
+ * TraceHeader and continues with a sequence of records, each introduced by a
+ * TraceRecordHeader. Routine names are interned: the first time a routine is
+ * seen a RoutineName record assigns it an id, every Call record refers to it
+ * by that id. A record with a zero size marks the end of the trace, so a
+ * trace cut short by a crash is still readable up to the last full record.
+ * Records are padded to 8 bytes.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace gvirtus::frontend {
+
+static constexpr char TRACE_MAGIC[8] = {'G', 'V', 'T', 'R', 'A', 'C', 'E', '\0'};
+static constexpr uint32_t TRACE_VERSION = 1;
+
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+enum class TraceRecordType : uint32_t { RoutineName = 1, Call = 2 };
+
+struct TraceRecordHeader {
+    uint64_t size; /**< size of the record, header and padding included */
+    TraceRecordType type;
+    uint32_t reserved;
+};
+
+/** Payload of a RoutineName record, followed by name_length chars. */
+struct TraceRoutineName {
+    uint32_t id;
+    uint32_t name_length;
+};
+
+/** Payload of a Call record, followed by input_size and output_size bytes. */
+struct TraceCall {
+    uint32_t routine_id;
+    uint32_t tid;
+    uint64_t start_ns; /**< since the trace was opened */
+    uint64_t duration_ns;
+    uint64_t input_size;
+    uint64_t output_size;
+    int32_t exit_code;
+    uint32_t reserved;
+};
+
+/**
+ * TraceWriter appends the routines executed by every frontend thread of the
+ * process to a trace file. The file grows by doubling its mapping.
+ */
+class TraceWriter {
+   public:
+    explicit TraceWriter(const std::string &path, size_t initial_capacity = 64 << 20);
+    virtual ~TraceWriter();
+
+    /**
+     * Returns the process wide writer, or nullptr when tracing is disabled.
+     * Tracing is enabled by setting GVIRTUS_TRACE to the path of the file to
+     * write.
+     */
+    static TraceWriter *GetInstance();
+
+    uint64_t Now() const;
+
+    /* Records a call. If the file cannot grow, tracing stops with a warning. */
+    void Call(const char *routine, uint32_t tid, uint64_t start_ns, uint64_t duration_ns,
+              const char *input, uint64_t input_size, int32_t exit_code, const char *output,
+              uint64_t output_size);
+
+    /**
+     * Truncates the file to the recorded length and unmaps it. Calls made
+     * after Close() are not recorded. Runs automatically at exit.
+     */
+    void Close();
+
+   private:
+    /* Call() with the mutex held; throws if the file cannot grow. */
+    void Record(const char *routine, uint32_t tid, uint64_t start_ns, uint64_t duration_ns,
+                const char *input, uint64_t input_size, int32_t exit_code, const char *output,
+                uint64_t output_size);
+    char *Reserve(size_t size);
+    void Remap(size_t capacity);
+
+    std::mutex mMutex;
+    std::map<std::string, uint32_t> mRoutines;
+    int mFd;
+    char *mpMap;
+    size_t mCapacity;
+    size_t mLength;
+    uint64_t mOrigin;
+};
+
+/**
+ * A call read back from a trace. The pointers refer to the mapped file and
+ * stay valid as long as the TraceReader that produced them.
+ */
+struct TracedCall {
+    const std::string *routine;
+    uint32_t tid;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    const char *input;
+    uint64_t input_size;
+    int32_t exit_code;
+    const char *output;
+    uint64_t output_size;
+};
+
+/**
+ * TraceReader maps a trace read-only and decodes its calls in order.
+ */
+class TraceReader {
+   public:
+    explicit TraceReader(const std::string &path);
+    virtual ~TraceReader();
+
+    inline const std::vector<TracedCall> &Calls() const { return mCalls; }
+
+   private:
+    int mFd;
+    char *mpMap;
+    size_t mLength;
+    std::map<uint32_t, std::string> mRoutines;
+    std::vector<TracedCall> mCalls;
+};
+}  // namespace gvirtus::frontend
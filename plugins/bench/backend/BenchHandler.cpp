@@ -0,0 +1,115 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "BenchHandler.h"
+
+#include <chrono>
+
+std::map<string, BenchHandler::BenchRoutineHandler> *BenchHandler::mspHandlers = NULL;
+
+extern "C" std::shared_ptr<BenchHandler> create_t() { return std::make_shared<BenchHandler>(); }
+
+extern "C" int HandlerInit() { return 0; }
+
+BenchHandler::BenchHandler() {
+    logger = Logger::getInstance(LOG4CPLUS_TEXT("BenchHandler"));
+    Initialize();
+}
+
+BenchHandler::~BenchHandler() {}
+
+bool BenchHandler::CanExecute(std::string routine) {
+    return mspHandlers->find(routine) != mspHandlers->end();
+}
+
+std::shared_ptr<Result> BenchHandler::Execute(std::string routine,
+                                              std::shared_ptr<Buffer> input_buffer) {
+    LOG4CPLUS_DEBUG(logger, "Called " << routine);
+    auto it = mspHandlers->find(routine);
+    if (it == mspHandlers->end()) throw runtime_error("No handler for '" + routine + "' found!");
+    try {
+        return it->second(this, input_buffer);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(logger, LOG4CPLUS_TEXT("Exception: ") << e.what());
+    }
+    return std::make_shared<Result>(-1);
+}
+
+void BenchHandler::Initialize() {
+    if (mspHandlers != NULL) return;
+    mspHandlers = new map<string, BenchHandler::BenchRoutineHandler>();
+
+    mspHandlers->insert(BENCH_ROUTINE_HANDLER_PAIR(Null));
+    mspHandlers->insert(BENCH_ROUTINE_HANDLER_PAIR(Sink));
+    mspHandlers->insert(BENCH_ROUTINE_HANDLER_PAIR(Source));
+    mspHandlers->insert(BENCH_ROUTINE_HANDLER_PAIR(Echo));
+    mspHandlers->insert(BENCH_ROUTINE_HANDLER_PAIR(Spin));
+    mspHandlers->insert(BENCH_ROUTINE_HANDLER_PAIR(Replay));
+}
+
+BENCH_ROUTINE_HANDLER(Null) { return std::make_shared<Result>(0); }
+
+BENCH_ROUTINE_HANDLER(Sink) {
+    size_t size = in->Get<size_t>();
+    in->Assign<char>(size);
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    out->Add<size_t>(size);
+    return std::make_shared<Result>(0, out);
+}
+
+BENCH_ROUTINE_HANDLER(Source) {
+    size_t size = in->Get<size_t>();
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>(size + sizeof(size_t));
+    // The content is irrelevant for the measurement, so the bytes are left
+    // uninitialized instead of paying for a memset on the backend side.
+    out->Delegate<char>(size);
+    return std::make_shared<Result>(0, out);
+}
+
+BENCH_ROUTINE_HANDLER(Echo) {
+    size_t size = in->Get<size_t>();
+    char *data = in->Assign<char>(size);
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>(size + sizeof(size_t));
+    out->Add(data, size);
+    return std::make_shared<Result>(0, out);
+}
+
+BENCH_ROUTINE_HANDLER(Spin) {
+    auto usec = std::chrono::microseconds(in->Get<uint64_t>());
+    auto until = std::chrono::steady_clock::now() + usec;
+    while (std::chrono::steady_clock::now() < until) {
+    }
+    return std::make_shared<Result>(0);
+}
+
+BENCH_ROUTINE_HANDLER(Replay) {
+    uint64_t output_size = in->Get<uint64_t>();
+    in->AssignAll<char>();
+    if (output_size == 0) return std::make_shared<Result>(0);
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>(output_size + sizeof(size_t));
+    // the size that Delegate writes first is part of the answer
+    if (output_size >= sizeof(size_t))
+        out->Delegate<char>(output_size - sizeof(size_t));
+    else
+        for (uint64_t i = 0; i < output_size; i++) out->Add('\0');
+    return std::make_shared<Result>(0, out);
+}
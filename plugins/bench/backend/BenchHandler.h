@@ -0,0 +1,82 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef BENCHHANDLER_H
+#define BENCHHANDLER_H
+
+#include <gvirtus/backend/Handler.h>
+#include <gvirtus/communicators/Result.h>
+
+#include <map>
+#include <string>
+
+#include "log4cplus/configurator.h"
+#include "log4cplus/logger.h"
+#include "log4cplus/loggingmacros.h"
+
+using namespace std;
+using namespace log4cplus;
+
+using gvirtus::communicators::Buffer;
+using gvirtus::communicators::Result;
+
+/**
+ * BenchHandler is a synthetic plugin that does not wrap any library. Its
+ * routines only move bytes (or burn a requested amount of time) so that the
+ * cost of the frontend, the communicators and the backend dispatch can be
+ * measured on machines without CUDA or a GPU.
+ */
+class BenchHandler : public gvirtus::backend::Handler {
+   public:
+    BenchHandler();
+    virtual ~BenchHandler();
+    bool CanExecute(std::string routine);
+    std::shared_ptr<Result> Execute(std::string routine, std::shared_ptr<Buffer> input_buffer);
+    log4cplus::Logger &GetLogger() { return logger; }
+
+   private:
+    log4cplus::Logger logger;
+    void Initialize();
+    typedef std::shared_ptr<Result> (*BenchRoutineHandler)(BenchHandler *,
+                                                           std::shared_ptr<Buffer>);
+    static std::map<std::string, BenchRoutineHandler> *mspHandlers;
+};
+
+#define BENCH_ROUTINE_HANDLER(name) \
+    std::shared_ptr<Result> handle##name(BenchHandler *pThis, std::shared_ptr<Buffer> in)
+#define BENCH_ROUTINE_HANDLER_PAIR(name) make_pair("bench" #name, handle##name)
+
+/* Empty round trip: no input, no output. */
+BENCH_ROUTINE_HANDLER(Null);
+/* Upload: consumes a byte array, answers with the number of bytes received. */
+BENCH_ROUTINE_HANDLER(Sink);
+/* Download: answers with the requested number of bytes. */
+BENCH_ROUTINE_HANDLER(Source);
+/* Upload and download: sends back the byte array it received. */
+BENCH_ROUTINE_HANDLER(Echo);
+/* Artificial handler cost: busy waits for the requested microseconds. */
+BENCH_ROUTINE_HANDLER(Spin);
+/* Stand-in for a traced call: consumes its input, answers with as many bytes
+ * as the original routine returned. Used by gvirtus-replay --synthetic. */
+BENCH_ROUTINE_HANDLER(Replay);
+
+#endif /* BENCHHANDLER_H */
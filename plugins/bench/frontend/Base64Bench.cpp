@@ -0,0 +1,150 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * gvirtus-base64-bench reports the encoding and decoding throughput of every
+ * base64 implementation this CPU runs, for payloads from 64 B up to 64 MiB,
+ * after checking that each one agrees with the scalar one.
+ */
+
+#include <gvirtus/common/Base64.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+using gvirtus::common::Base64;
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+namespace {
+
+struct Options {
+    size_t min_size = 64;
+    size_t max_size = size_t(64) << 20;
+    size_t bytes_budget = size_t(1) << 30;
+    std::string output;
+};
+
+void Usage(const char *argv0) {
+    std::cerr << "Usage: " << argv0 << " [options]\n"
+              << "  --min-size BYTES   smallest payload (64)\n"
+              << "  --max-size BYTES   largest payload (67108864)\n"
+              << "  --budget BYTES     bytes encoded per point (1073741824)\n"
+              << "  --output FILE      write the JSON report to FILE (stdout)\n";
+}
+
+/* MiB of payload per second of calls to run, repeated to cover the budget. */
+template <typename F>
+double Throughput(size_t size, size_t budget, F run) {
+    size_t repeats = std::max<size_t>(budget / size, 1);
+    run();
+    auto start = steady_clock::now();
+    for (size_t i = 0; i < repeats; i++) run();
+    double seconds = duration<double>(steady_clock::now() - start).count();
+    return size * repeats / seconds / (1 << 20);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options opts;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                Usage(argv[0]);
+                exit(EXIT_FAILURE);
+            }
+            return argv[++i];
+        };
+        if (arg == "--min-size")
+            opts.min_size = std::max<size_t>(std::stoull(value()), 1);
+        else if (arg == "--max-size")
+            opts.max_size = std::stoull(value());
+        else if (arg == "--budget")
+            opts.bytes_budget = std::stoull(value());
+        else if (arg == "--output")
+            opts.output = value();
+        else {
+            Usage(argv[0]);
+            return arg == "-h" || arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    std::vector<Base64::Implementation> implementations;
+    for (auto implementation : {Base64::SCALAR, Base64::SSE41, Base64::AVX2})
+        if (Base64::Supported(implementation)) implementations.push_back(implementation);
+
+    std::vector<char> data(opts.max_size);
+    std::mt19937_64 random(42);
+    for (auto &byte : data) byte = (char)random();
+    std::string expected(Base64::EncodedSize(data.size()), '\0');
+    Base64::Encode(data.data(), data.size(), expected.data(), Base64::SCALAR);
+
+    nlohmann::json results;
+    results["best"] = Base64::Name(Base64::Best());
+    results["runs"] = nlohmann::json::array();
+    bool ok = true;
+    for (auto implementation : implementations) {
+        nlohmann::json run;
+        run["implementation"] = Base64::Name(implementation);
+        std::string text(expected.size(), '\0');
+        std::vector<char> decoded(Base64::DecodedSize(text.size()));
+        Base64::Encode(data.data(), data.size(), text.data(), implementation);
+        ptrdiff_t size = Base64::Decode(text.data(), text.size(), decoded.data(), implementation);
+        if (text != expected || size != (ptrdiff_t)data.size() ||
+            !std::equal(data.begin(), data.end(), decoded.begin())) {
+            run["error"] = "does not round trip like the scalar implementation";
+            ok = false;
+            results["runs"].push_back(run);
+            continue;
+        }
+        run["points"] = nlohmann::json::array();
+        for (size_t size = opts.min_size; size <= opts.max_size; size *= 4) {
+            size_t encoded = Base64::EncodedSize(size);
+            nlohmann::json point;
+            point["size"] = size;
+            point["encode_MiB_per_sec"] = Throughput(size, opts.bytes_budget, [&] {
+                Base64::Encode(data.data(), size, text.data(), implementation);
+            });
+            point["decode_MiB_per_sec"] = Throughput(size, opts.bytes_budget, [&] {
+                Base64::Decode(expected.data(), encoded, decoded.data(), implementation);
+            });
+            run["points"].push_back(point);
+        }
+        results["runs"].push_back(run);
+    }
+
+    if (opts.output.empty()) {
+        std::cout << results.dump(4) << std::endl;
+    } else {
+        std::ofstream(opts.output) << results.dump(4) << std::endl;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
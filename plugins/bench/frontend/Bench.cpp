@@ -0,0 +1,379 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * gvirtus-bench drives the synthetic bench plugin through the regular
+ * frontend and reports, for every configuration file given on the command
+ * line, the round trip latency distribution, the payload throughput from
+ * 8 B up to 1 GiB and the multi-thread scaling of the RPC path.
+ *
+ * Every configuration runs in its own child process: frontends are cached
+ * per thread for the whole lifetime of a process, so that is the only way to
+ * point the same binary at a tcp, an AF_UNIX and a shm backend in one run.
+ */
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <latch>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchFrontend.h"
+
+using std::chrono::duration_cast;
+using std::chrono::nanoseconds;
+using std::chrono::steady_clock;
+
+namespace {
+
+struct Options {
+    std::vector<std::string> configs;
+    size_t iterations = 10000;
+    size_t warmup = 100;
+    size_t min_size = 8;
+    size_t max_size = size_t(1) << 30;
+    size_t bytes_budget = size_t(1) << 30;
+    size_t scaling_size = 0;
+    std::vector<int> threads = {1, 2, 4, 8};
+    std::string output;
+};
+
+void Usage(const char *argv0) {
+    std::cerr << "Usage: " << argv0 << " [options] properties.json [properties.json ...]\n"
+              << "  --iterations N     calls per latency/scaling measurement (10000)\n"
+              << "  --warmup N         calls discarded before measuring (100)\n"
+              << "  --min-size BYTES   smallest throughput payload (8)\n"
+              << "  --max-size BYTES   largest throughput payload (1073741824)\n"
+              << "  --budget BYTES     bytes moved per throughput point (1073741824)\n"
+              << "  --threads LIST     comma separated thread counts (1,2,4,8)\n"
+              << "  --scaling-size N   payload of every scaling call (0)\n"
+              << "  --output FILE      write the JSON report to FILE instead of stdout\n";
+}
+
+std::vector<int> ParseList(const std::string &s) {
+    std::vector<int> values;
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t end = s.find(',', start);
+        if (end == std::string::npos) end = s.size();
+        if (end > start) values.push_back(std::stoi(s.substr(start, end - start)));
+        start = end + 1;
+    }
+    return values;
+}
+
+nlohmann::json Summarize(std::vector<double> &samples_ns, double wall_sec) {
+    nlohmann::json j;
+    if (samples_ns.empty()) return j;
+    std::sort(samples_ns.begin(), samples_ns.end());
+    auto percentile = [&samples_ns](double p) {
+        size_t rank = static_cast<size_t>(p / 100.0 * (samples_ns.size() - 1) + 0.5);
+        return samples_ns[rank] / 1000.0;
+    };
+    double sum = 0;
+    for (double s : samples_ns) sum += s;
+    j["calls"] = samples_ns.size();
+    j["min_us"] = samples_ns.front() / 1000.0;
+    j["mean_us"] = sum / samples_ns.size() / 1000.0;
+    j["p50_us"] = percentile(50);
+    j["p90_us"] = percentile(90);
+    j["p99_us"] = percentile(99);
+    j["p999_us"] = percentile(99.9);
+    j["max_us"] = samples_ns.back() / 1000.0;
+    j["calls_per_sec"] = wall_sec > 0 ? samples_ns.size() / wall_sec : 0;
+    return j;
+}
+
+void Null() {
+    BenchFrontend::Prepare();
+    BenchFrontend::Execute("benchNull");
+}
+
+void Sink(const char *payload, size_t size) {
+    BenchFrontend::Prepare();
+    BenchFrontend::AddVariableForArguments<size_t>(size);
+    BenchFrontend::AddHostPointerForArguments(payload, size);
+    BenchFrontend::Execute("benchSink");
+    if (!BenchFrontend::Success() || BenchFrontend::GetOutputVariable<size_t>() != size)
+        throw std::runtime_error("benchSink: backend did not receive the whole payload");
+}
+
+void Source(size_t size) {
+    BenchFrontend::Prepare();
+    BenchFrontend::AddVariableForArguments<size_t>(size);
+    BenchFrontend::Execute("benchSource");
+    if (!BenchFrontend::Success()) throw std::runtime_error("benchSource failed");
+    BenchFrontend::GetOutputHostPointer<char>(size);
+}
+
+void Echo(const char *payload, size_t size) {
+    BenchFrontend::Prepare();
+    BenchFrontend::AddVariableForArguments<size_t>(size);
+    BenchFrontend::AddHostPointerForArguments(payload, size);
+    BenchFrontend::Execute("benchEcho");
+    if (!BenchFrontend::Success()) throw std::runtime_error("benchEcho failed");
+    BenchFrontend::GetOutputHostPointer<char>(size);
+}
+
+nlohmann::json RunLatency(const Options &opts) {
+    for (size_t i = 0; i < opts.warmup; i++) Null();
+
+    std::vector<double> samples;
+    samples.reserve(opts.iterations);
+    auto begin = steady_clock::now();
+    for (size_t i = 0; i < opts.iterations; i++) {
+        auto start = steady_clock::now();
+        Null();
+        samples.push_back(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+    }
+    double wall = duration_cast<nanoseconds>(steady_clock::now() - begin).count() / 1e9;
+    return Summarize(samples, wall);
+}
+
+nlohmann::json RunThroughput(const Options &opts) {
+    nlohmann::json points = nlohmann::json::array();
+    std::vector<char> payload(opts.max_size);
+    for (size_t i = 0; i < payload.size(); i += 4096) payload[i] = static_cast<char>(i);
+
+    struct Direction {
+        const char *name;
+        size_t factor;  // payload copies crossing the wire per call
+        std::function<void(size_t)> call;
+    };
+    std::vector<Direction> directions = {
+        {"upload", 1, [&payload](size_t n) { Sink(payload.data(), n); }},
+        {"download", 1, [](size_t n) { Source(n); }},
+        {"echo", 2, [&payload](size_t n) { Echo(payload.data(), n); }},
+    };
+
+    for (size_t size = opts.min_size; size <= opts.max_size; size *= 8) {
+        size_t calls = std::clamp<size_t>(opts.bytes_budget / size, 3, opts.iterations);
+        for (auto &direction : directions) {
+            direction.call(size);
+            std::vector<double> samples;
+            samples.reserve(calls);
+            auto begin = steady_clock::now();
+            for (size_t i = 0; i < calls; i++) {
+                auto start = steady_clock::now();
+                direction.call(size);
+                samples.push_back(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+            }
+            double wall = duration_cast<nanoseconds>(steady_clock::now() - begin).count() / 1e9;
+            nlohmann::json point = Summarize(samples, wall);
+            point["direction"] = direction.name;
+            point["bytes"] = size;
+            point["MiB_per_sec"] = size * direction.factor * calls / wall / (1024.0 * 1024.0);
+            points.push_back(point);
+        }
+    }
+    return points;
+}
+
+nlohmann::json RunScaling(const Options &opts) {
+    nlohmann::json points = nlohmann::json::array();
+    std::vector<char> payload(std::max<size_t>(opts.scaling_size, 1));
+
+    for (int nthreads : opts.threads) {
+        std::vector<std::vector<double>> samples(nthreads);
+        std::vector<std::thread> workers;
+        std::latch ready(nthreads + 1);
+        std::latch go(1);
+        std::atomic<bool> failed = false;
+
+        for (int t = 0; t < nthreads; t++) {
+            workers.emplace_back([&, t]() {
+                try {
+                    // The first call connects this thread's own frontend.
+                    for (size_t i = 0; i < opts.warmup + 1; i++) Sink(payload.data(), 0);
+                } catch (const std::exception &e) {
+                    failed = true;
+                }
+                ready.count_down();
+                go.wait();
+                samples[t].reserve(opts.iterations);
+                try {
+                    for (size_t i = 0; i < opts.iterations && !failed; i++) {
+                        auto start = steady_clock::now();
+                        if (opts.scaling_size == 0)
+                            Null();
+                        else
+                            Sink(payload.data(), opts.scaling_size);
+                        samples[t].push_back(
+                            duration_cast<nanoseconds>(steady_clock::now() - start).count());
+                    }
+                } catch (const std::exception &e) {
+                    failed = true;
+                }
+            });
+        }
+
+        ready.arrive_and_wait();
+        auto begin = steady_clock::now();
+        go.count_down();
+        for (auto &worker : workers) worker.join();
+        double wall = duration_cast<nanoseconds>(steady_clock::now() - begin).count() / 1e9;
+
+        if (failed) throw std::runtime_error("scaling run with " + std::to_string(nthreads) +
+                                             " thread(s) failed");
+
+        std::vector<double> all;
+        for (auto &s : samples) all.insert(all.end(), s.begin(), s.end());
+        nlohmann::json point = Summarize(all, wall);
+        point["threads"] = nthreads;
+        point["bytes"] = opts.scaling_size;
+        points.push_back(point);
+    }
+    return points;
+}
+
+nlohmann::json RunSuite(const Options &opts, const std::string &config) {
+    nlohmann::json report;
+    report["config"] = config;
+    try {
+        std::ifstream ifs(config);
+        auto properties = nlohmann::json::parse(ifs);
+        report["communicator"] = properties["communicator"][0]["endpoint"]["suite"];
+    } catch (const std::exception &e) {
+        report["error"] = std::string("cannot parse configuration: ") + e.what();
+        return report;
+    }
+
+    setenv("GVIRTUS_CONFIG", config.c_str(), 1);
+    try {
+        report["latency"] = RunLatency(opts);
+        report["throughput"] = RunThroughput(opts);
+        report["scaling"] = RunScaling(opts);
+    } catch (const std::exception &e) {
+        report["error"] = e.what();
+    }
+    return report;
+}
+
+nlohmann::json RunIsolated(const Options &opts, const std::string &config) {
+    int fds[2];
+    if (pipe(fds) != 0) throw std::runtime_error(std::string("pipe: ") + strerror(errno));
+
+    pid_t pid = fork();
+    if (pid < 0) throw std::runtime_error(std::string("fork: ") + strerror(errno));
+    if (pid == 0) {
+        close(fds[0]);
+        std::string report = RunSuite(opts, config).dump();
+        for (size_t written = 0; written < report.size();) {
+            ssize_t n = write(fds[1], report.data() + written, report.size() - written);
+            if (n <= 0) break;
+            written += n;
+        }
+        close(fds[1]);
+        // Skip the static destructors: the frontends of the worker threads
+        // are still registered and their connections die with the process.
+        _exit(EXIT_SUCCESS);
+    }
+
+    close(fds[1]);
+    std::string report;
+    char chunk[4096];
+    ssize_t n;
+    while ((n = read(fds[0], chunk, sizeof(chunk))) > 0) report.append(chunk, n);
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (report.empty()) {
+        nlohmann::json failed;
+        failed["config"] = config;
+        failed["error"] = "benchmark process exited with status " +
+                          std::to_string(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+        return failed;
+    }
+    return nlohmann::json::parse(report);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options opts;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                Usage(argv[0]);
+                exit(EXIT_FAILURE);
+            }
+            return argv[++i];
+        };
+        if (arg == "--iterations")
+            opts.iterations = std::stoull(value());
+        else if (arg == "--warmup")
+            opts.warmup = std::stoull(value());
+        else if (arg == "--min-size")
+            opts.min_size = std::max<size_t>(std::stoull(value()), 1);
+        else if (arg == "--max-size")
+            opts.max_size = std::stoull(value());
+        else if (arg == "--budget")
+            opts.bytes_budget = std::stoull(value());
+        else if (arg == "--threads")
+            opts.threads = ParseList(value());
+        else if (arg == "--scaling-size")
+            opts.scaling_size = std::stoull(value());
+        else if (arg == "--output")
+            opts.output = value();
+        else if (arg == "-h" || arg == "--help") {
+            Usage(argv[0]);
+            return EXIT_SUCCESS;
+        } else
+            opts.configs.push_back(arg);
+    }
+
+    if (opts.configs.empty()) {
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    nlohmann::json results;
+    results["iterations"] = opts.iterations;
+    results["runs"] = nlohmann::json::array();
+    bool ok = true;
+    for (auto &config : opts.configs) {
+        nlohmann::json run = RunIsolated(opts, config);
+        ok = ok && !run.contains("error");
+        results["runs"].push_back(run);
+    }
+
+    if (opts.output.empty()) {
+        std::cout << results.dump(4) << std::endl;
+    } else {
+        std::ofstream(opts.output) << results.dump(4) << std::endl;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
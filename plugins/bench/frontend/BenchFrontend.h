@@ -0,0 +1,68 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef BENCHFRONTEND_H
+#define BENCHFRONTEND_H
+
+#include <gvirtus/frontend/Frontend.h>
+
+using gvirtus::communicators::Buffer;
+using gvirtus::frontend::Frontend;
+
+/**
+ * BenchFrontend mirrors the static wrappers every plugin frontend uses, so
+ * that the benchmark exercises exactly the same marshalling path as a real
+ * intercepted library call.
+ */
+class BenchFrontend {
+   public:
+    static inline void Execute(const char *routine, const Buffer *input_buffer = NULL) {
+        Frontend::GetFrontend()->Execute(routine, input_buffer);
+    }
+
+    static inline void Prepare() { Frontend::GetFrontend()->Prepare(); }
+
+    template <class T>
+    static inline void AddVariableForArguments(T var) {
+        Frontend::GetFrontend()->GetInputBuffer()->Add(var);
+    }
+
+    template <class T>
+    static inline void AddHostPointerForArguments(T *ptr, size_t n = 1) {
+        Frontend::GetFrontend()->GetInputBuffer()->Add(ptr, n);
+    }
+
+    static inline int GetExitCode() { return Frontend::GetFrontend()->GetExitCode(); }
+
+    static inline bool Success() { return Frontend::GetFrontend()->Success(0); }
+
+    template <class T>
+    static inline T GetOutputVariable() {
+        return Frontend::GetFrontend()->GetOutputBuffer()->Get<T>();
+    }
+
+    template <class T>
+    static inline T *GetOutputHostPointer(size_t n = 1) {
+        return Frontend::GetFrontend()->GetOutputBuffer()->Assign<T>(n);
+    }
+};
+#endif /* BENCHFRONTEND_H */
@@ -0,0 +1,271 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * gvirtus-fairshare measures how the scheduler of a backend (see
+ * backend/Scheduler.h) shares it between tenants. Every tenant is a child
+ * process in its own scheduler class, whose threads call benchSpin for as
+ * long as the run lasts. The report gives, for every tenant, the calls it
+ * completed, its share of the backend time and its latency distribution,
+ * then the queue waits the backend measured for every class.
+ *
+ *   gvirtus-fairshare --tenant inference:1:200 --tenant batch:4:2000 properties.json
+ */
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchFrontend.h"
+
+using std::chrono::duration_cast;
+using std::chrono::nanoseconds;
+using std::chrono::steady_clock;
+
+namespace {
+
+struct Tenant {
+    std::string cls;
+    int threads = 1;
+    uint64_t spin_us = 1000;
+};
+
+struct Options {
+    std::string config;
+    std::vector<Tenant> tenants;
+    double seconds = 5;
+    std::string output;
+};
+
+void Usage(const char *argv0) {
+    std::cerr << "Usage: " << argv0 << " [options] properties.json\n"
+              << "  --tenant CLASS:THREADS:SPIN_US  a tenant of the class CLASS whose THREADS\n"
+              << "                                  threads call benchSpin(SPIN_US) (repeatable)\n"
+              << "  --seconds S                     length of the run (5)\n"
+              << "  --output FILE                   write the JSON report to FILE (stdout)\n";
+}
+
+Tenant ParseTenant(const std::string &s) {
+    Tenant tenant;
+    size_t first = s.find(':');
+    size_t second = first == std::string::npos ? first : s.find(':', first + 1);
+    if (second == std::string::npos) throw std::invalid_argument("bad tenant " + s);
+    tenant.cls = s.substr(0, first);
+    tenant.threads = std::max(std::stoi(s.substr(first + 1, second - first - 1)), 1);
+    tenant.spin_us = std::stoull(s.substr(second + 1));
+    return tenant;
+}
+
+void Spin(uint64_t usec) {
+    BenchFrontend::Prepare();
+    BenchFrontend::AddVariableForArguments<uint64_t>(usec);
+    BenchFrontend::Execute("benchSpin");
+    if (!BenchFrontend::Success()) throw std::runtime_error("benchSpin failed");
+}
+
+nlohmann::json RunTenant(const Options &opts, const Tenant &tenant) {
+    // read by the frontend of every thread when it connects
+    setenv("GVIRTUS_SCHEDULER_CLASS", tenant.cls.c_str(), 1);
+
+    std::vector<std::vector<double>> samples(tenant.threads);
+    std::vector<std::thread> workers;
+    std::atomic<bool> failed = false;
+    auto until = steady_clock::now() + std::chrono::duration<double>(opts.seconds);
+    for (int t = 0; t < tenant.threads; t++) {
+        workers.emplace_back([&, t]() {
+            try {
+                while (steady_clock::now() < until) {
+                    auto start = steady_clock::now();
+                    Spin(tenant.spin_us);
+                    samples[t].push_back(
+                        duration_cast<nanoseconds>(steady_clock::now() - start).count());
+                }
+            } catch (const std::exception &e) {
+                failed = true;
+            }
+        });
+    }
+    for (auto &worker : workers) worker.join();
+
+    nlohmann::json report;
+    report["class"] = tenant.cls;
+    report["threads"] = tenant.threads;
+    report["spin_us"] = tenant.spin_us;
+    if (failed) report["error"] = "a call failed";
+
+    std::vector<double> all;
+    for (auto &s : samples) all.insert(all.end(), s.begin(), s.end());
+    std::sort(all.begin(), all.end());
+    report["calls"] = all.size();
+    report["busy_sec"] = all.size() * tenant.spin_us / 1e6;
+    if (!all.empty()) {
+        auto percentile = [&all](double p) {
+            return all[static_cast<size_t>(p / 100.0 * (all.size() - 1) + 0.5)] / 1000.0;
+        };
+        report["p50_us"] = percentile(50);
+        report["p99_us"] = percentile(99);
+        report["max_us"] = all.back() / 1000.0;
+    }
+    return report;
+}
+
+pid_t Fork(const Options &opts, const Tenant &tenant, int *fd) {
+    int fds[2];
+    if (pipe(fds) != 0) throw std::runtime_error(std::string("pipe: ") + strerror(errno));
+
+    pid_t pid = fork();
+    if (pid < 0) throw std::runtime_error(std::string("fork: ") + strerror(errno));
+    if (pid == 0) {
+        close(fds[0]);
+        std::string report = RunTenant(opts, tenant).dump();
+        for (size_t written = 0; written < report.size();) {
+            ssize_t n = write(fds[1], report.data() + written, report.size() - written);
+            if (n <= 0) break;
+            written += n;
+        }
+        close(fds[1]);
+        _exit(EXIT_SUCCESS);
+    }
+    close(fds[1]);
+    *fd = fds[0];
+    return pid;
+}
+
+nlohmann::json Collect(pid_t pid, int fd, const Tenant &tenant) {
+    std::string report;
+    char chunk[4096];
+    ssize_t n;
+    while ((n = read(fd, chunk, sizeof(chunk))) > 0) report.append(chunk, n);
+    close(fd);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (report.empty()) {
+        nlohmann::json failed;
+        failed["class"] = tenant.cls;
+        failed["error"] = "tenant process exited with status " +
+                          std::to_string(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+        return failed;
+    }
+    return nlohmann::json::parse(report);
+}
+
+/* The queue waits of every class, from gvirtusSchedulerStats. */
+nlohmann::json SchedulerStats() {
+    BenchFrontend::Prepare();
+    BenchFrontend::Execute("gvirtusSchedulerStats");
+    if (!BenchFrontend::Success()) return "the backend has no scheduler";
+
+    nlohmann::json classes = nlohmann::json::array();
+    auto *out = Frontend::GetFrontend()->GetOutputBuffer();
+    for (uint32_t n = out->Get<uint32_t>(); n > 0; n--) {
+        nlohmann::json cls;
+        cls["class"] = out->AssignString();
+        uint64_t calls = out->Get<uint64_t>();
+        uint64_t wait_us = out->Get<uint64_t>();
+        cls["calls"] = calls;
+        cls["mean_wait_us"] = calls > 0 ? double(wait_us) / calls : 0;
+        cls["max_wait_us"] = out->Get<uint64_t>();
+        cls["waiting"] = out->Get<uint32_t>();
+        classes.push_back(cls);
+    }
+    return classes;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options opts;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    Usage(argv[0]);
+                    exit(EXIT_FAILURE);
+                }
+                return argv[++i];
+            };
+            if (arg == "--tenant")
+                opts.tenants.push_back(ParseTenant(value()));
+            else if (arg == "--seconds")
+                opts.seconds = std::stod(value());
+            else if (arg == "--output")
+                opts.output = value();
+            else if (arg == "-h" || arg == "--help") {
+                Usage(argv[0]);
+                return EXIT_SUCCESS;
+            } else
+                opts.config = arg;
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (opts.config.empty() || opts.tenants.empty()) {
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    setenv("GVIRTUS_CONFIG", opts.config.c_str(), 1);
+
+    // the tenants are forked before this process connects
+    std::vector<pid_t> pids(opts.tenants.size());
+    std::vector<int> fds(opts.tenants.size());
+    for (size_t i = 0; i < opts.tenants.size(); i++)
+        pids[i] = Fork(opts, opts.tenants[i], &fds[i]);
+
+    nlohmann::json results;
+    results["config"] = opts.config;
+    results["seconds"] = opts.seconds;
+    results["tenants"] = nlohmann::json::array();
+    bool ok = true;
+    double busy = 0;
+    for (size_t i = 0; i < opts.tenants.size(); i++) {
+        nlohmann::json tenant = Collect(pids[i], fds[i], opts.tenants[i]);
+        ok = ok && !tenant.contains("error");
+        busy += tenant.value("busy_sec", 0.0);
+        results["tenants"].push_back(tenant);
+    }
+    for (auto &tenant : results["tenants"])
+        tenant["share"] = busy > 0 ? tenant.value("busy_sec", 0.0) / busy : 0;
+    results["scheduler"] = SchedulerStats();
+
+    if (opts.output.empty()) {
+        std::cout << results.dump(4) << std::endl;
+    } else {
+        std::ofstream(opts.output) << results.dump(4) << std::endl;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,63 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+/**
+ * gvirtus-group-failover drives the failover of an endpoint group (see
+ * frontend/EndpointGroup.h) for group_failover.sh. The main thread connects
+ * and calls benchNull, then waits for a line on stdin before a second thread
+ * connects and calls benchNull too. Once the first thread connected, the
+ * second one must not move to another backend of the group: when the backend
+ * of the process is gone, the frontend exits with a failure instead.
+ *
+ *   GVIRTUS_CONFIG=properties_group.json gvirtus-group-failover
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "BenchFrontend.h"
+
+namespace {
+
+bool Null() {
+    BenchFrontend::Prepare();
+    BenchFrontend::Execute("benchNull");
+    return BenchFrontend::Success();
+}
+
+}  // namespace
+
+int main() {
+    if (!Null()) {
+        std::cerr << "benchNull failed on the first thread" << std::endl;
+        return 1;
+    }
+    std::cout << "connected" << std::endl;
+
+    std::string line;
+    std::getline(std::cin, line);
+
+    bool reached = false;
+    std::thread([&reached] { reached = Null(); }).join();
+    std::cout << (reached ? "reached" : "failed") << std::endl;
+    return reached ? 0 : 1;
+}
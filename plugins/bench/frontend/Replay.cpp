@@ -0,0 +1,217 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * gvirtus-replay pushes a trace recorded with GVIRTUS_TRACE against a
+ * backend. Every thread of the recorded application is replayed by its own
+ * thread, in the recorded order, either as fast as possible or honouring the
+ * recorded start times.
+ *
+ * By default every call is sent to the routine that was recorded, with the
+ * recorded input bytes: this only makes sense against a backend able to
+ * execute the same routines. With --synthetic every call becomes a
+ * benchReplay carrying the same input bytes and asking for an answer of the
+ * recorded size, so the traffic of a CUDA workload can be reproduced against
+ * the bench plugin on a machine without CUDA or a GPU.
+ */
+
+#include <gvirtus/frontend/Trace.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchFrontend.h"
+
+using gvirtus::frontend::TracedCall;
+using gvirtus::frontend::TraceReader;
+using std::chrono::duration_cast;
+using std::chrono::nanoseconds;
+using std::chrono::steady_clock;
+
+namespace {
+
+struct Options {
+    std::string trace;
+    std::string output;
+    bool original_speed = false;
+    bool synthetic = false;
+};
+
+struct RoutineStats {
+    uint64_t calls = 0;
+    uint64_t recorded_ns = 0;
+    uint64_t replayed_ns = 0;
+    uint64_t bytes_in = 0;
+    uint64_t bytes_out = 0;
+    uint64_t mismatches = 0;
+};
+
+void Usage(const char *argv0) {
+    std::cerr << "Usage: " << argv0 << " [options] trace\n"
+              << "  --config FILE      properties.json of the backend (GVIRTUS_CONFIG)\n"
+              << "  --speed original   honour the recorded start time of every call\n"
+              << "  --speed max        send every call as soon as the previous returned (default)\n"
+              << "  --synthetic        replay every call as benchReplay on the bench plugin\n"
+              << "  --output FILE      write the JSON report to FILE instead of stdout\n";
+}
+
+void ReplayThread(const Options &opts, const std::vector<const TracedCall *> &calls,
+                  steady_clock::time_point origin, std::map<std::string, RoutineStats> &stats) {
+    for (auto call : calls) {
+        if (opts.original_speed) std::this_thread::sleep_until(origin + nanoseconds(call->start_ns));
+
+        auto start = steady_clock::now();
+        int exit_code;
+        if (opts.synthetic) {
+            BenchFrontend::Prepare();
+            BenchFrontend::AddVariableForArguments<uint64_t>(call->output_size);
+            BenchFrontend::AddHostPointerForArguments(call->input, call->input_size);
+            BenchFrontend::Execute("benchReplay");
+            exit_code = BenchFrontend::GetExitCode() == 0 ? call->exit_code : -1;
+        } else {
+            // The recorded bytes are sent untouched, without copying them out
+            // of the mapped trace.
+            Buffer input(const_cast<char *>(call->input), call->input_size);
+            BenchFrontend::Execute(call->routine->c_str(), &input);
+            exit_code = BenchFrontend::GetExitCode();
+        }
+        uint64_t elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+
+        auto &s = stats[*call->routine];
+        s.calls++;
+        s.recorded_ns += call->duration_ns;
+        s.replayed_ns += elapsed;
+        s.bytes_in += call->input_size;
+        s.bytes_out += call->output_size;
+        if (exit_code != call->exit_code) s.mismatches++;
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options opts;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                Usage(argv[0]);
+                exit(EXIT_FAILURE);
+            }
+            return argv[++i];
+        };
+        if (arg == "--config")
+            setenv("GVIRTUS_CONFIG", value().c_str(), 1);
+        else if (arg == "--speed") {
+            std::string speed = value();
+            if (speed != "original" && speed != "max") {
+                Usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            opts.original_speed = speed == "original";
+        } else if (arg == "--synthetic")
+            opts.synthetic = true;
+        else if (arg == "--output")
+            opts.output = value();
+        else if (arg == "-h" || arg == "--help") {
+            Usage(argv[0]);
+            return EXIT_SUCCESS;
+        } else
+            opts.trace = arg;
+    }
+    if (opts.trace.empty()) {
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    TraceReader reader(opts.trace);
+
+    std::map<uint32_t, std::vector<const TracedCall *>> streams;
+    uint64_t recorded_span = 0;
+    for (auto &call : reader.Calls()) {
+        streams[call.tid].push_back(&call);
+        recorded_span = std::max(recorded_span, call.start_ns + call.duration_ns);
+    }
+
+    std::vector<std::map<std::string, RoutineStats>> stats(streams.size());
+    std::vector<std::thread> workers;
+    auto origin = steady_clock::now();
+    size_t index = 0;
+    for (auto &stream : streams) {
+        workers.emplace_back(ReplayThread, std::cref(opts), std::cref(stream.second), origin,
+                             std::ref(stats[index++]));
+    }
+    for (auto &worker : workers) worker.join();
+    double wall = duration_cast<nanoseconds>(steady_clock::now() - origin).count() / 1e9;
+
+    std::map<std::string, RoutineStats> total;
+    for (auto &thread_stats : stats) {
+        for (auto &[routine, s] : thread_stats) {
+            auto &t = total[routine];
+            t.calls += s.calls;
+            t.recorded_ns += s.recorded_ns;
+            t.replayed_ns += s.replayed_ns;
+            t.bytes_in += s.bytes_in;
+            t.bytes_out += s.bytes_out;
+            t.mismatches += s.mismatches;
+        }
+    }
+
+    nlohmann::json report;
+    report["trace"] = opts.trace;
+    report["speed"] = opts.original_speed ? "original" : "max";
+    report["synthetic"] = opts.synthetic;
+    report["threads"] = streams.size();
+    report["calls"] = reader.Calls().size();
+    report["recorded_sec"] = recorded_span / 1e9;
+    report["replayed_sec"] = wall;
+    uint64_t mismatches = 0;
+    for (auto &[routine, t] : total) {
+        nlohmann::json r;
+        r["calls"] = t.calls;
+        r["recorded_mean_us"] = t.recorded_ns / 1000.0 / t.calls;
+        r["replayed_mean_us"] = t.replayed_ns / 1000.0 / t.calls;
+        r["bytes_in"] = t.bytes_in;
+        r["bytes_out"] = t.bytes_out;
+        r["exit_code_mismatches"] = t.mismatches;
+        report["routines"][routine] = r;
+        mismatches += t.mismatches;
+    }
+    report["exit_code_mismatches"] = mismatches;
+
+    if (opts.output.empty()) {
+        std::cout << report.dump(4) << std::endl;
+    } else {
+        std::ofstream(opts.output) << report.dump(4) << std::endl;
+    }
+    // The frontends of the replay threads are still registered: skip the
+    // static destructors, the connections die with the process.
+    std::cout.flush();
+    _exit(mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,91 @@
+#!/bin/bash
+# Checks the failover of an endpoint group against the two bench backends of
+# etc/properties_group.json (127.0.0.1:9999 and 127.0.0.1:9998).
+#
+# Only 9998 runs when gvirtus-group-failover starts, so its first thread has
+# to move past 9999. Then 9999 starts and 9998 goes away: the second thread
+# must fail instead of moving to 9999, where the process has no state.
+#
+#   GVIRTUS_HOME=/opt/GVirtuS plugins/bench/group_failover.sh
+set -e
+
+export GVIRTUS_HOME=${GVIRTUS_HOME:-/opt/GVirtuS}
+export LD_LIBRARY_PATH=${GVIRTUS_HOME}/lib:${LD_LIBRARY_PATH}
+export GVIRTUS_CONFIG=$(cd "$(dirname "$0")/../../etc" && pwd)/properties_group.json
+
+WORK=$(mktemp -d)
+BACKENDS=()
+
+# the backend forks a listener per endpoint, which outlives it
+stop() {
+    pkill -P "$1" 2>/dev/null || true
+    kill "$1" 2>/dev/null || true
+}
+cleanup() {
+    exec 3>&- || true
+    for pid in "${BACKENDS[@]}"; do stop "$pid"; done
+    rm -rf "$WORK"
+}
+trap cleanup EXIT
+
+backend() {
+    cat > "$WORK/backend_$1.json" <<EOF
+{
+    "communicator": [
+        {
+            "endpoint": {
+                "suite": "tcp/ip",
+                "protocol": "tcp",
+                "server_address": "127.0.0.1",
+                "port": "$1"
+            },
+            "plugins": [
+                "bench"
+            ]
+        }
+    ],
+    "secure_application": false
+}
+EOF
+    ${GVIRTUS_HOME}/bin/gvirtus-backend "$WORK/backend_$1.json" > "$WORK/backend_$1.log" 2>&1 &
+    BACKENDS+=($!)
+    for _ in $(seq 50); do
+        ss -ltn | grep -q ":$1 " && return
+        sleep 0.1
+    done
+    cat "$WORK/backend_$1.log"
+    echo "FAIL: the backend on port $1 did not start"
+    exit 1
+}
+
+backend 9998
+BACKEND_9998=$!
+
+mkfifo "$WORK/input"
+${GVIRTUS_HOME}/bin/gvirtus-group-failover < "$WORK/input" > "$WORK/frontend.log" 2>&1 &
+FRONTEND=$!
+exec 3> "$WORK/input"
+
+for _ in $(seq 50); do
+    grep -q '^connected' "$WORK/frontend.log" && break
+    kill -0 "$FRONTEND" 2>/dev/null || break
+    sleep 0.1
+done
+if ! grep -q '^connected' "$WORK/frontend.log"; then
+    cat "$WORK/frontend.log"
+    echo "FAIL: the first thread did not move past the unreachable backend"
+    exit 1
+fi
+
+backend 9999
+stop "$BACKEND_9998"
+wait "$BACKEND_9998" 2>/dev/null || true
+sleep 1
+
+echo >&3
+if wait "$FRONTEND"; then
+    cat "$WORK/frontend.log"
+    echo "FAIL: the second thread moved to another backend of the group"
+    exit 1
+fi
+echo "OK: the process failed over before its first session only"
@@ -65,6 +65,7 @@ void CublasHandler::Initialize() {
 
     /* CublasHandler Helper functions */
     mspHandlers->insert(CUBLAS_ROUTINE_HANDLER_PAIR(GetVersion_v2));
+    mspHandlers->insert(CUBLAS_ROUTINE_HANDLER_PAIR(GetStatusString));
     mspHandlers->insert(CUBLAS_ROUTINE_HANDLER_PAIR(Create_v2));
     mspHandlers->insert(CUBLAS_ROUTINE_HANDLER_PAIR(Destroy_v2));
     mspHandlers->insert(CUBLAS_ROUTINE_HANDLER_PAIR(SetVector));
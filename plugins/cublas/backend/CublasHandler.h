@@ -72,8 +72,30 @@ class CublasHandler : public gvirtus::backend::Handler {
         CublasHandler *pThis, std::shared_ptr<gvirtus::communicators::Buffer> in)
 #define CUBLAS_ROUTINE_HANDLER_PAIR(name) make_pair("cublas" #name, handle##name)
 
+/*
+ * Reads a scalar, or the array of them, that the frontend added with
+ * AddScalarForArguments: it points into the input buffer in host pointer
+ * mode, to the device otherwise.
+ */
+template <class T>
+inline const T *GetScalar(std::shared_ptr<gvirtus::communicators::Buffer> in) {
+    if (in->Get<bool>()) return reinterpret_cast<const T *>(in->Get<uint64_t>());
+    return in->Assign<T>();
+}
+
+/*
+ * Where a reduction writes its result: the device address the frontend added
+ * with AddResultForArguments in device pointer mode, local otherwise.
+ */
+template <class T>
+inline T *GetResult(std::shared_ptr<gvirtus::communicators::Buffer> in, T *local) {
+    if (in->Get<bool>()) return reinterpret_cast<T *>(in->Get<uint64_t>());
+    return local;
+}
+
 /* CublasHandler_Helper */
 CUBLAS_ROUTINE_HANDLER(GetVersion_v2);
+CUBLAS_ROUTINE_HANDLER(GetStatusString);
 CUBLAS_ROUTINE_HANDLER(Create_v2);
 CUBLAS_ROUTINE_HANDLER(Destroy_v2);
 CUBLAS_ROUTINE_HANDLER(SetVector);
@@ -15,14 +15,14 @@ CUBLAS_ROUTINE_HANDLER(GemmEx) {
     int m = in->Get<int>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const void *alpha = in->Assign<const float>();
+    const void *alpha = GetScalar<float>(in);
     const void *A = in->GetFromMarshal<const void *>();
     cudaDataType_t Atype = in->Get<cudaDataType_t>();
     int lda = in->Get<int>();
     const void *B = in->GetFromMarshal<const void *>();
     cudaDataType_t Btype = in->Get<cudaDataType_t>();
     int ldb = in->Get<int>();
-    const void *beta = in->Assign<const float>();
+    const void *beta = GetScalar<float>(in);
     void *C = in->GetFromMarshal<void *>();
     cudaDataType_t Ctype = in->Get<cudaDataType_t>();
     int ldc = in->Get<int>();
@@ -36,8 +36,7 @@ CUBLAS_ROUTINE_HANDLER(GemmEx) {
     return std::make_shared<Result>(cs);
 }
 
-// TODO: this only supports the version where alpha, beta are float32 host
-// pointers
+// TODO: this only supports alpha, beta of type float32
 CUBLAS_ROUTINE_HANDLER(GemmStridedBatchedEx) {
     cublasHandle_t handle = in->Get<cublasHandle_t>();
     cublasOperation_t transa = in->Get<cublasOperation_t>();
@@ -45,7 +44,7 @@ CUBLAS_ROUTINE_HANDLER(GemmStridedBatchedEx) {
     int m = in->Get<int>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const void *alpha = in->Assign<const float>();
+    const void *alpha = GetScalar<float>(in);
     const void *A = in->GetFromMarshal<const void *>();
     cudaDataType_t Atype = in->Get<cudaDataType_t>();
     int lda = in->Get<int>();
@@ -54,7 +53,7 @@ CUBLAS_ROUTINE_HANDLER(GemmStridedBatchedEx) {
     cudaDataType_t Btype = in->Get<cudaDataType_t>();
     int ldb = in->Get<int>();
     long long int strideB = in->Get<long long int>();
-    const void *beta = in->Assign<const float>();
+    const void *beta = GetScalar<float>(in);
     void *C = in->GetFromMarshal<void *>();
     cudaDataType_t Ctype = in->Get<cudaDataType_t>();
     int ldc = in->Get<int>();
@@ -25,6 +25,8 @@
  *             School of Computer Science, University College Dublin
  */
 
+#include <algorithm>
+
 #include "CublasHandler.h"
 
 using gvirtus::communicators::Buffer;
@@ -70,6 +72,14 @@ CUBLAS_ROUTINE_HANDLER(GetVersion_v2) {
     return std::make_shared<Result>(cs, out);
 }
 
+CUBLAS_ROUTINE_HANDLER(GetStatusString) {
+    cublasStatus_t status = in->Get<cublasStatus_t>();
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    out->AddString(cublasGetStatusString(status));
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasGetStatusString executed");
+    return std::make_shared<Result>(CUBLAS_STATUS_SUCCESS, out);
+}
+
 CUBLAS_ROUTINE_HANDLER(Destroy_v2) {
     cublasHandle_t handle = in->Get<cublasHandle_t>();  // here, we read the buffer which contains
                                                         // the cublasHandle_t as a memory address
@@ -82,16 +92,18 @@ CUBLAS_ROUTINE_HANDLER(Destroy_v2) {
     return std::make_shared<Result>(cs);
 }
 
+// The host operands of SetVector, SetMatrix, GetVector and GetMatrix travel
+// packed by the frontend: unit stride, leading dimension equal to rows.
+
 CUBLAS_ROUTINE_HANDLER(SetVector) {
     int n = in->Get<int>();
     int elemSize = in->Get<int>();
-    int incx = in->Get<int>();
     int incy = in->Get<int>();
 
     void* y = in->GetFromMarshal<void*>();
     const void* x = in->AssignAll<char>();
 
-    cublasStatus_t cs = cublasSetVector(n, elemSize, x, incx, y, incy);
+    cublasStatus_t cs = cublasSetVector(n, elemSize, x, 1, y, incy);
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasSetVector executed");
     return std::make_shared<Result>(cs);
 }
@@ -102,10 +114,9 @@ CUBLAS_ROUTINE_HANDLER(SetMatrix) {
     int elemSize = in->Get<int>();
     void* B = in->GetFromMarshal<void*>();
     int ldb = in->Get<int>();
-    int lda = in->Get<int>();
 
     void* A = in->AssignAll<char>();
-    cublasStatus_t cs = cublasSetMatrix(rows, cols, elemSize, A, lda, B, ldb);
+    cublasStatus_t cs = cublasSetMatrix(rows, cols, elemSize, A, std::max(rows, 1), B, ldb);
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasSetMatrix executed");
     return std::make_shared<Result>(cs);
 }
@@ -114,22 +125,20 @@ CUBLAS_ROUTINE_HANDLER(GetVector) {
     int n = in->Get<int>();
     int elemSize = in->Get<int>();
     int incx = in->Get<int>();
-    int incy = in->Get<int>();
 
     void* x = in->GetFromMarshal<void*>();
-    void* y = in->Assign<void>();
 
     cublasStatus_t cs;
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
 
     try {
-        cs = cublasGetVector(n, elemSize, x, incx, y, incy);
+        char* y = out->Delegate<char>((size_t)std::max(n, 0) * elemSize);
+        cs = cublasGetVector(n, elemSize, x, incx, y, 1);
     } catch (const std::exception& e) {
         LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
         return std::make_shared<Result>(cudaErrorMemoryAllocation);
     }
 
-    out->Add<char>((char*)y, n * elemSize);
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasGetVector executed");
     return std::make_shared<Result>(cs, out);
 }
@@ -140,19 +149,17 @@ CUBLAS_ROUTINE_HANDLER(GetMatrix) {
     int elemSize = in->Get<int>();
     void* A = in->GetFromMarshal<void*>();
     int lda = in->Get<int>();
-    void* B = in->Assign<void>();
-    int ldb = in->Get<int>();
 
     cublasStatus_t cs;
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
 
     try {
-        cs = cublasGetMatrix(rows, cols, elemSize, A, lda, B, ldb);
+        char* B = out->Delegate<char>((size_t)rows * cols * elemSize);
+        cs = cublasGetMatrix(rows, cols, elemSize, A, lda, B, std::max(rows, 1));
     } catch (const std::exception& e) {
         LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
         return std::make_shared<Result>(cudaErrorMemoryAllocation);
     }
-    out->Add<char>((char*)B, rows * cols * elemSize);
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasGetMatrix executed");
     return std::make_shared<Result>(cs, out);
 }
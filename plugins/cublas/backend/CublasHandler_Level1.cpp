@@ -38,15 +38,16 @@ CUBLAS_ROUTINE_HANDLER(Sdot_v2) {
     float *y = in->GetFromMarshal<float *>();
     int incy = in->Get<int>();
     float result;
+    float *target = GetResult<float>(in, &result);
 
-    cublasStatus_t cs = cublasSdot_v2(handle, n, x, incx, y, incy, &result);
+    cublasStatus_t cs = cublasSdot_v2(handle, n, x, incx, y, incy, target);
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasSdot_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     try {
-        out->Add<float>(result);
+        if (target == &result) out->Add<float>(result);
     } catch (const std::exception &e) {
-        LOG4CPLUS_ERROR(pThis->GetLogger(), "Error assigning result: " << e.what());
-        return std::make_shared<Result>(CUBLAS_STATUS_EXECUTION_FAILED);
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
     }
     return std::make_shared<Result>(cs, out);
 }
@@ -59,83 +60,112 @@ CUBLAS_ROUTINE_HANDLER(Ddot_v2) {
     double *y = in->GetFromMarshal<double *>();
     int incy = in->Get<int>();
     double result;
+    double *target = GetResult<double>(in, &result);
 
-    cublasStatus_t cs = cublasDdot_v2(handle, n, x, incx, y, incy, &result);
+    cublasStatus_t cs = cublasDdot_v2(handle, n, x, incx, y, incy, target);
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasDdot_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     try {
-        out->Add<double>(result);
+        if (target == &result) out->Add<double>(result);
     } catch (const std::exception &e) {
-        LOG4CPLUS_ERROR(pThis->GetLogger(), "Error assigning result: " << e.what());
-        return std::make_shared<Result>(CUBLAS_STATUS_EXECUTION_FAILED);
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
     }
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Cdotu_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     cuComplex *x = in->GetFromMarshal<cuComplex *>();
     int incx = in->Get<int>();
     cuComplex *y = in->GetFromMarshal<cuComplex *>();
     int incy = in->Get<int>();
-    cuComplex *result = in->Assign<cuComplex>();
-
-    cublasStatus_t cs = cublasCdotu_v2(handle, n, x, incx, y, incy, result);
+    cuComplex result;
+    cuComplex *target = GetResult<cuComplex>(in, &result);
 
+    cublasStatus_t cs = cublasCdotu_v2(handle, n, x, incx, y, incy, target);
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasCdotu_v2 Executed");
-    return std::make_shared<Result>(cs);
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    try {
+        if (target == &result) out->Add<cuComplex>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
+    return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Cdotc_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     cuComplex *x = in->GetFromMarshal<cuComplex *>();
     int incx = in->Get<int>();
     cuComplex *y = in->GetFromMarshal<cuComplex *>();
     int incy = in->Get<int>();
-    cuComplex *result = in->Assign<cuComplex>();
-
-    cublasStatus_t cs = cublasCdotc_v2(handle, n, x, incx, y, incy, result);
+    cuComplex result;
+    cuComplex *target = GetResult<cuComplex>(in, &result);
 
+    cublasStatus_t cs = cublasCdotc_v2(handle, n, x, incx, y, incy, target);
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasCdotc_v2 Executed");
-    return std::make_shared<Result>(cs);
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    try {
+        if (target == &result) out->Add<cuComplex>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
+    return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Zdotu_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     cuDoubleComplex *x = in->GetFromMarshal<cuDoubleComplex *>();
     int incx = in->Get<int>();
     cuDoubleComplex *y = in->GetFromMarshal<cuDoubleComplex *>();
     int incy = in->Get<int>();
-    cuDoubleComplex *result = in->Assign<cuDoubleComplex>();
-
-    cublasStatus_t cs = cublasZdotu_v2(handle, n, x, incx, y, incy, result);
+    cuDoubleComplex result;
+    cuDoubleComplex *target = GetResult<cuDoubleComplex>(in, &result);
 
+    cublasStatus_t cs = cublasZdotu_v2(handle, n, x, incx, y, incy, target);
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasZdotu_v2 Executed");
-    return std::make_shared<Result>(cs);
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    try {
+        if (target == &result) out->Add<cuDoubleComplex>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
+    return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Zdotc_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     cuDoubleComplex *x = in->GetFromMarshal<cuDoubleComplex *>();
     int incx = in->Get<int>();
     cuDoubleComplex *y = in->GetFromMarshal<cuDoubleComplex *>();
     int incy = in->Get<int>();
-    cuDoubleComplex *result = in->Assign<cuDoubleComplex>();
-
-    cublasStatus_t cs = cublasZdotc_v2(handle, n, x, incx, y, incy, result);
+    cuDoubleComplex result;
+    cuDoubleComplex *target = GetResult<cuDoubleComplex>(in, &result);
 
+    cublasStatus_t cs = cublasZdotc_v2(handle, n, x, incx, y, incy, target);
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasZdotc_v2 Executed");
-    return std::make_shared<Result>(cs);
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    try {
+        if (target == &result) out->Add<cuDoubleComplex>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
+    return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Sscal_v2) {
     cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
     int n = in->Get<int>();
-    float *alpha = in->Assign<float>();
+    const float *alpha = GetScalar<float>(in);
     float *x = in->GetFromMarshal<float *>();
     int incx = in->Get<int>();
     cublasStatus_t cublas_status = cublasSscal(handle, n, alpha, x, incx);
@@ -145,7 +175,7 @@ CUBLAS_ROUTINE_HANDLER(Sscal_v2) {
 CUBLAS_ROUTINE_HANDLER(Dscal_v2) {
     cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
     int n = in->Get<int>();
-    double *alpha = in->Assign<double>();
+    const double *alpha = GetScalar<double>(in);
     double *x = in->GetFromMarshal<double *>();
     int incx = in->Get<int>();
     cublasStatus_t cublas_status = cublasDscal(handle, n, alpha, x, incx);
@@ -155,7 +185,7 @@ CUBLAS_ROUTINE_HANDLER(Dscal_v2) {
 CUBLAS_ROUTINE_HANDLER(Cscal_v2) {
     cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
     int n = in->Get<int>();
-    cuComplex *alpha = in->Assign<cuComplex>();
+    const cuComplex *alpha = GetScalar<cuComplex>(in);
     cuComplex *x = in->GetFromMarshal<cuComplex *>();
     int incx = in->Get<int>();
     cublasStatus_t cublas_status = cublasCscal(handle, n, alpha, x, incx);
@@ -165,7 +195,7 @@ CUBLAS_ROUTINE_HANDLER(Cscal_v2) {
 CUBLAS_ROUTINE_HANDLER(Csscal_v2) {
     cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
     int n = in->Get<int>();
-    float *alpha = in->Assign<float>();
+    const float *alpha = GetScalar<float>(in);
     cuComplex *x = in->GetFromMarshal<cuComplex *>();
     int incx = in->Get<int>();
     cublasStatus_t cublas_status = cublasCsscal(handle, n, alpha, x, incx);
@@ -175,7 +205,7 @@ CUBLAS_ROUTINE_HANDLER(Csscal_v2) {
 CUBLAS_ROUTINE_HANDLER(Zscal_v2) {
     cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
     int n = in->Get<int>();
-    cuDoubleComplex *alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex *x = in->GetFromMarshal<cuDoubleComplex *>();
     int incx = in->Get<int>();
     cublasStatus_t cublas_status = cublasZscal(handle, n, alpha, x, incx);
@@ -185,7 +215,7 @@ CUBLAS_ROUTINE_HANDLER(Zscal_v2) {
 CUBLAS_ROUTINE_HANDLER(Zdscal_v2) {
     cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
     int n = in->Get<int>();
-    double *alpha = in->Assign<double>();
+    const double *alpha = GetScalar<double>(in);
     cuDoubleComplex *x = in->GetFromMarshal<cuDoubleComplex *>();
     int incx = in->Get<int>();
     cublasStatus_t cublas_status = cublasZdscal(handle, n, alpha, x, incx);
@@ -195,7 +225,7 @@ CUBLAS_ROUTINE_HANDLER(Zdscal_v2) {
 CUBLAS_ROUTINE_HANDLER(Saxpy_v2) {
     cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
-    float *alpha = in->Assign<float>();
+    const float *alpha = GetScalar<float>(in);
     float *x = in->GetFromMarshal<float *>();
     int incx = in->Get<int>();
     float *y = in->GetFromMarshal<float *>();
@@ -207,7 +237,7 @@ CUBLAS_ROUTINE_HANDLER(Saxpy_v2) {
 CUBLAS_ROUTINE_HANDLER(Daxpy_v2) {
     cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
     int n = in->Get<int>();
-    double *alpha = in->Assign<double>();
+    const double *alpha = GetScalar<double>(in);
     double *x = in->GetFromMarshal<double *>();
     int incx = in->Get<int>();
     double *y = in->GetFromMarshal<double *>();
@@ -219,7 +249,7 @@ CUBLAS_ROUTINE_HANDLER(Daxpy_v2) {
 CUBLAS_ROUTINE_HANDLER(Caxpy_v2) {
     cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
     int n = in->Get<int>();
-    cuComplex *alpha = in->Assign<cuComplex>();
+    const cuComplex *alpha = GetScalar<cuComplex>(in);
     cuComplex *x = in->GetFromMarshal<cuComplex *>();
     int incx = in->Get<int>();
     cuComplex *y = in->GetFromMarshal<cuComplex *>();
@@ -231,7 +261,7 @@ CUBLAS_ROUTINE_HANDLER(Caxpy_v2) {
 CUBLAS_ROUTINE_HANDLER(Zaxpy_v2) {
     cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
     int n = in->Get<int>();
-    cuDoubleComplex *alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex *x = in->GetFromMarshal<cuDoubleComplex *>();
     int incx = in->Get<int>();
     cuDoubleComplex *y = in->GetFromMarshal<cuDoubleComplex *>();
@@ -329,170 +359,242 @@ CUBLAS_ROUTINE_HANDLER(Zswap_v2) {
 }
 
 CUBLAS_ROUTINE_HANDLER(Isamax_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     float *x = in->GetFromMarshal<float *>();
     int incx = in->Get<int>();
-    int *result = in->Assign<int>();
+    int result;
+    int *target = GetResult<int>(in, &result);
 
-    cublasStatus_t cs = cublasIsamax_v2(handle, n, x, incx, result);
+    cublasStatus_t cs = cublasIsamax_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasIsamax_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
-    out->Add(result);
+    try {
+        if (target == &result) out->Add<int>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Idamax_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     double *x = in->GetFromMarshal<double *>();
     int incx = in->Get<int>();
-    int *result = in->Assign<int>();
+    int result;
+    int *target = GetResult<int>(in, &result);
 
-    cublasStatus_t cs = cublasIdamax_v2(handle, n, x, incx, result);
+    cublasStatus_t cs = cublasIdamax_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasIdamax_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
-    out->Add(result);
+    try {
+        if (target == &result) out->Add<int>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Icamax_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     cuComplex *x = in->GetFromMarshal<cuComplex *>();
     int incx = in->Get<int>();
-    int *result = in->Assign<int>();
+    int result;
+    int *target = GetResult<int>(in, &result);
 
-    cublasStatus_t cs = cublasIcamax_v2(handle, n, x, incx, result);
+    cublasStatus_t cs = cublasIcamax_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasIcamax_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
-    out->Add(result);
+    try {
+        if (target == &result) out->Add<int>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Izamax_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     cuDoubleComplex *x = in->GetFromMarshal<cuDoubleComplex *>();
     int incx = in->Get<int>();
-    int *result = in->Assign<int>();
+    int result;
+    int *target = GetResult<int>(in, &result);
 
-    cublasStatus_t cs = cublasIzamax_v2(handle, n, x, incx, result);
+    cublasStatus_t cs = cublasIzamax_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasIzamax_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
-    out->Add(result);
+    try {
+        if (target == &result) out->Add<int>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Isamin_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     float *x = in->GetFromMarshal<float *>();
     int incx = in->Get<int>();
-    int *result = in->Assign<int>();
+    int result;
+    int *target = GetResult<int>(in, &result);
 
-    cublasStatus_t cs = cublasIsamin_v2(handle, n, x, incx, result);
+    cublasStatus_t cs = cublasIsamin_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasIsamin_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
-    out->Add(result);
+    try {
+        if (target == &result) out->Add<int>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Idamin_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     double *x = in->GetFromMarshal<double *>();
     int incx = in->Get<int>();
-    int *result = in->Assign<int>();
+    int result;
+    int *target = GetResult<int>(in, &result);
 
-    cublasStatus_t cs = cublasIdamin_v2(handle, n, x, incx, result);
+    cublasStatus_t cs = cublasIdamin_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasIdamin_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
-    out->Add(result);
+    try {
+        if (target == &result) out->Add<int>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Icamin_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     cuComplex *x = in->GetFromMarshal<cuComplex *>();
     int incx = in->Get<int>();
-    int *result = in->Assign<int>();
+    int result;
+    int *target = GetResult<int>(in, &result);
 
-    cublasStatus_t cs = cublasIcamin_v2(handle, n, x, incx, result);
+    cublasStatus_t cs = cublasIcamin_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasIcamin_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
-    out->Add(result);
+    try {
+        if (target == &result) out->Add<int>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Izamin_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     cuDoubleComplex *x = in->GetFromMarshal<cuDoubleComplex *>();
     int incx = in->Get<int>();
-    int *result = in->Assign<int>();
+    int result;
+    int *target = GetResult<int>(in, &result);
 
-    cublasStatus_t cs = cublasIzamin_v2(handle, n, x, incx, result);
+    cublasStatus_t cs = cublasIzamin_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasIzamin_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
-    out->Add(result);
+    try {
+        if (target == &result) out->Add<int>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Sasum_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     float *x = in->GetFromMarshal<float *>();
     int incx = in->Get<int>();
-    float *result = in->Assign<float>();
+    float result;
+    float *target = GetResult<float>(in, &result);
 
-    cublasStatus_t cs = cublasSasum_v2(handle, n, x, incx, result);
+    cublasStatus_t cs = cublasSasum_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasSasum_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
-    out->Add(result);
+    try {
+        if (target == &result) out->Add<float>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Dasum_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     double *x = in->GetFromMarshal<double *>();
     int incx = in->Get<int>();
-    double *result = in->Assign<double>();
+    double result;
+    double *target = GetResult<double>(in, &result);
 
-    cublasStatus_t cs = cublasDasum_v2(handle, n, x, incx, result);
+    cublasStatus_t cs = cublasDasum_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasDasum_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
-    out->Add(result);
+    try {
+        if (target == &result) out->Add<double>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Scasum_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     cuComplex *x = in->GetFromMarshal<cuComplex *>();
     int incx = in->Get<int>();
-    float *result = in->Assign<float>();
+    float result;
+    float *target = GetResult<float>(in, &result);
 
-    cublasStatus_t cs = cublasScasum_v2(handle, n, x, incx, result);
+    cublasStatus_t cs = cublasScasum_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasScasum_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
-    out->Add(result);
+    try {
+        if (target == &result) out->Add<float>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Dzasum_v2) {
-    cublasHandle_t handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     cuDoubleComplex *x = in->GetFromMarshal<cuDoubleComplex *>();
     int incx = in->Get<int>();
-    double *result = in->Assign<double>();
+    double result;
+    double *target = GetResult<double>(in, &result);
 
-    cublasStatus_t cs = cublasDzasum_v2(handle, n, x, incx, result);
+    cublasStatus_t cs = cublasDzasum_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasDzasum_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
-    out->Add(result);
+    try {
+        if (target == &result) out->Add<double>(result);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
     return std::make_shared<Result>(cs, out);
 }
 
@@ -503,8 +605,8 @@ CUBLAS_ROUTINE_HANDLER(Srot_v2) {
     int incx = in->Get<int>();
     float *y = in->GetFromMarshal<float *>();
     int incy = in->Get<int>();
-    float *c = in->Assign<float>();
-    float *s = in->Assign<float>();
+    const float *c = GetScalar<float>(in);
+    const float *s = GetScalar<float>(in);
 
     cublasStatus_t cs = cublasSrot_v2(handle, n, x, incx, y, incy, c, s);
     return std::make_shared<Result>(cs);
@@ -517,8 +619,8 @@ CUBLAS_ROUTINE_HANDLER(Drot_v2) {
     int incx = in->Get<int>();
     double *y = in->GetFromMarshal<double *>();
     int incy = in->Get<int>();
-    double *c = in->Assign<double>();
-    double *s = in->Assign<double>();
+    const double *c = GetScalar<double>(in);
+    const double *s = GetScalar<double>(in);
 
     cublasStatus_t cs = cublasDrot_v2(handle, n, x, incx, y, incy, c, s);
     return std::make_shared<Result>(cs);
@@ -531,8 +633,8 @@ CUBLAS_ROUTINE_HANDLER(Crot_v2) {
     int incx = in->Get<int>();
     cuComplex *y = in->GetFromMarshal<cuComplex *>();
     int incy = in->Get<int>();
-    float *c = in->Assign<float>();
-    cuComplex *s = in->Assign<cuComplex>();
+    const float *c = GetScalar<float>(in);
+    const cuComplex *s = GetScalar<cuComplex>(in);
 
     cublasStatus_t cs = cublasCrot_v2(handle, n, x, incx, y, incy, c, s);
     return std::make_shared<Result>(cs);
@@ -545,8 +647,8 @@ CUBLAS_ROUTINE_HANDLER(Csrot_v2) {
     int incx = in->Get<int>();
     cuComplex *y = in->GetFromMarshal<cuComplex *>();
     int incy = in->Get<int>();
-    float *c = in->Assign<float>();
-    float *s = in->Assign<float>();
+    const float *c = GetScalar<float>(in);
+    const float *s = GetScalar<float>(in);
 
     cublasStatus_t cs = cublasCsrot_v2(handle, n, x, incx, y, incy, c, s);
     return std::make_shared<Result>(cs);
@@ -559,8 +661,8 @@ CUBLAS_ROUTINE_HANDLER(Zrot_v2) {
     int incx = in->Get<int>();
     cuDoubleComplex *y = in->GetFromMarshal<cuDoubleComplex *>();
     int incy = in->Get<int>();
-    double *c = in->Assign<double>();
-    cuDoubleComplex *s = in->Assign<cuDoubleComplex>();
+    const double *c = GetScalar<double>(in);
+    const cuDoubleComplex *s = GetScalar<cuDoubleComplex>(in);
 
     cublasStatus_t cs = cublasZrot_v2(handle, n, x, incx, y, incy, c, s);
     return std::make_shared<Result>(cs);
@@ -573,8 +675,8 @@ CUBLAS_ROUTINE_HANDLER(Zdrot_v2) {
     int incx = in->Get<int>();
     cuDoubleComplex *y = in->GetFromMarshal<cuDoubleComplex *>();
     int incy = in->Get<int>();
-    double *c = in->Assign<double>();
-    double *s = in->Assign<double>();
+    const double *c = GetScalar<double>(in);
+    const double *s = GetScalar<double>(in);
 
     cublasStatus_t cs = cublasZdrot_v2(handle, n, x, incx, y, incy, c, s);
     return std::make_shared<Result>(cs);
@@ -631,7 +733,7 @@ CUBLAS_ROUTINE_HANDLER(Srotm_v2) {
     int incx = in->Get<int>();
     float *y = in->GetFromMarshal<float *>();
     int incy = in->Get<int>();
-    float *param = in->Assign<float>();
+    const float *param = GetScalar<float>(in);
 
     cublasStatus_t cs = cublasSrotm_v2(handle, n, x, incx, y, incy, param);
     return std::make_shared<Result>(cs);
@@ -644,7 +746,7 @@ CUBLAS_ROUTINE_HANDLER(Drotm_v2) {
     int incx = in->Get<int>();
     double *y = in->GetFromMarshal<double *>();
     int incy = in->Get<int>();
-    double *param = in->Assign<double>();
+    const double *param = GetScalar<double>(in);
 
     cublasStatus_t cs = cublasDrotm_v2(handle, n, x, incx, y, incy, param);
     return std::make_shared<Result>(cs);
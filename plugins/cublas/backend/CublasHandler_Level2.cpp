@@ -36,13 +36,13 @@ CUBLAS_ROUTINE_HANDLER(Sgemv_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int m = in->Get<int>();
     int n = in->Get<int>();
-    const float* alpha = in->Assign<float>();
+    const float* alpha = GetScalar<float>(in);
     float* A = in->GetFromMarshal<float*>();
     int lda = in->Get<int>();
     float* x = in->GetFromMarshal<float*>();
     int incx = in->Get<int>();
 
-    const float* beta = in->Assign<float>();
+    const float* beta = GetScalar<float>(in);
     float* y = in->GetFromMarshal<float*>();
     int incy = in->Get<int>();
 
@@ -57,13 +57,13 @@ CUBLAS_ROUTINE_HANDLER(Dgemv_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int m = in->Get<int>();
     int n = in->Get<int>();
-    const double* alpha = in->Assign<double>();
+    const double* alpha = GetScalar<double>(in);
     double* A = in->GetFromMarshal<double*>();
     int lda = in->Get<int>();
     double* x = in->GetFromMarshal<double*>();
     int incx = in->Get<int>();
 
-    const double* beta = in->Assign<double>();
+    const double* beta = GetScalar<double>(in);
     double* y = in->GetFromMarshal<double*>();
     int incy = in->Get<int>();
 
@@ -78,13 +78,13 @@ CUBLAS_ROUTINE_HANDLER(Cgemv_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int m = in->Get<int>();
     int n = in->Get<int>();
-    const cuComplex* alpha = in->Assign<cuComplex>();
+    const cuComplex* alpha = GetScalar<cuComplex>(in);
     cuComplex* A = in->GetFromMarshal<cuComplex*>();
     int lda = in->Get<int>();
     cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
 
-    const cuComplex* beta = in->Assign<cuComplex>();
+    const cuComplex* beta = GetScalar<cuComplex>(in);
     cuComplex* y = in->GetFromMarshal<cuComplex*>();
     int incy = in->Get<int>();
     cublasStatus_t cs;
@@ -107,13 +107,13 @@ CUBLAS_ROUTINE_HANDLER(Zgemv_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int m = in->Get<int>();
     int n = in->Get<int>();
-    const cuDoubleComplex* alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* A = in->GetFromMarshal<cuDoubleComplex*>();
     int lda = in->Get<int>();
     cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
 
-    const cuDoubleComplex* beta = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* beta = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* y = in->GetFromMarshal<cuDoubleComplex*>();
     int incy = in->Get<int>();
     cublasStatus_t cs;
@@ -138,12 +138,12 @@ CUBLAS_ROUTINE_HANDLER(Sgbmv_v2) {
     int n = in->Get<int>();
     int kl = in->Get<int>();
     int ku = in->Get<int>();
-    const float* alpha = in->Assign<float>();
+    const float* alpha = GetScalar<float>(in);
     float* A = in->GetFromMarshal<float*>();
     int lda = in->Get<int>();
     const float* x = in->GetFromMarshal<float*>();
     int incx = in->Get<int>();
-    const float* beta = in->Assign<float>();
+    const float* beta = GetScalar<float>(in);
     float* y = in->GetFromMarshal<float*>();
     int incy = in->Get<int>();
 
@@ -160,12 +160,12 @@ CUBLAS_ROUTINE_HANDLER(Dgbmv_v2) {
     int n = in->Get<int>();
     int kl = in->Get<int>();
     int ku = in->Get<int>();
-    const double* alpha = in->Assign<double>();
+    const double* alpha = GetScalar<double>(in);
     double* A = in->GetFromMarshal<double*>();
     int lda = in->Get<int>();
     const double* x = in->GetFromMarshal<double*>();
     int incx = in->Get<int>();
-    const double* beta = in->Assign<double>();
+    const double* beta = GetScalar<double>(in);
     double* y = in->GetFromMarshal<double*>();
     int incy = in->Get<int>();
 
@@ -182,12 +182,12 @@ CUBLAS_ROUTINE_HANDLER(Cgbmv_v2) {
     int n = in->Get<int>();
     int kl = in->Get<int>();
     int ku = in->Get<int>();
-    const cuComplex* alpha = in->Assign<cuComplex>();
+    const cuComplex* alpha = GetScalar<cuComplex>(in);
     cuComplex* A = in->GetFromMarshal<cuComplex*>();
     int lda = in->Get<int>();
     const cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
-    const cuComplex* beta = in->Assign<cuComplex>();
+    const cuComplex* beta = GetScalar<cuComplex>(in);
     cuComplex* y = in->GetFromMarshal<cuComplex*>();
     int incy = in->Get<int>();
 
@@ -204,12 +204,12 @@ CUBLAS_ROUTINE_HANDLER(Zgbmv_v2) {
     int n = in->Get<int>();
     int kl = in->Get<int>();
     int ku = in->Get<int>();
-    const cuDoubleComplex* alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* A = in->GetFromMarshal<cuDoubleComplex*>();
     int lda = in->Get<int>();
     const cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
-    const cuDoubleComplex* beta = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* beta = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* y = in->GetFromMarshal<cuDoubleComplex*>();
     int incy = in->Get<int>();
 
@@ -607,13 +607,13 @@ CUBLAS_ROUTINE_HANDLER(Ssymv_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const float* alpha = in->Assign<float>();
+    const float* alpha = GetScalar<float>(in);
     float* A = in->GetFromMarshal<float*>();
     int lda = in->Get<int>();
     float* x = in->GetFromMarshal<float*>();
     int incx = in->Get<int>();
 
-    const float* beta = in->Assign<float>();
+    const float* beta = GetScalar<float>(in);
     float* y = in->GetFromMarshal<float*>();
     int incy = in->Get<int>();
 
@@ -626,13 +626,13 @@ CUBLAS_ROUTINE_HANDLER(Dsymv_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const double* alpha = in->Assign<double>();
+    const double* alpha = GetScalar<double>(in);
     double* A = in->GetFromMarshal<double*>();
     int lda = in->Get<int>();
     double* x = in->GetFromMarshal<double*>();
     int incx = in->Get<int>();
 
-    const double* beta = in->Assign<double>();
+    const double* beta = GetScalar<double>(in);
     double* y = in->GetFromMarshal<double*>();
     int incy = in->Get<int>();
 
@@ -645,13 +645,13 @@ CUBLAS_ROUTINE_HANDLER(Csymv_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuComplex* alpha = in->Assign<cuComplex>();
+    const cuComplex* alpha = GetScalar<cuComplex>(in);
     cuComplex* A = in->GetFromMarshal<cuComplex*>();
     int lda = in->Get<int>();
     cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
 
-    const cuComplex* beta = in->Assign<cuComplex>();
+    const cuComplex* beta = GetScalar<cuComplex>(in);
     cuComplex* y = in->GetFromMarshal<cuComplex*>();
     int incy = in->Get<int>();
 
@@ -664,13 +664,13 @@ CUBLAS_ROUTINE_HANDLER(Zsymv_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuDoubleComplex* alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* A = in->GetFromMarshal<cuDoubleComplex*>();
     int lda = in->Get<int>();
     cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
 
-    const cuDoubleComplex* beta = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* beta = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* y = in->GetFromMarshal<cuDoubleComplex*>();
     int incy = in->Get<int>();
 
@@ -683,13 +683,13 @@ CUBLAS_ROUTINE_HANDLER(Chemv_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuComplex* alpha = in->Assign<cuComplex>();
+    const cuComplex* alpha = GetScalar<cuComplex>(in);
     cuComplex* A = in->GetFromMarshal<cuComplex*>();
     int lda = in->Get<int>();
     cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
 
-    const cuComplex* beta = in->Assign<cuComplex>();
+    const cuComplex* beta = GetScalar<cuComplex>(in);
     cuComplex* y = in->GetFromMarshal<cuComplex*>();
     int incy = in->Get<int>();
 
@@ -702,13 +702,13 @@ CUBLAS_ROUTINE_HANDLER(Zhemv_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuDoubleComplex* alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* A = in->GetFromMarshal<cuDoubleComplex*>();
     int lda = in->Get<int>();
     cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
 
-    const cuDoubleComplex* beta = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* beta = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* y = in->GetFromMarshal<cuDoubleComplex*>();
     int incy = in->Get<int>();
 
@@ -722,13 +722,13 @@ CUBLAS_ROUTINE_HANDLER(Ssbmv_v2) {
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const float* alpha = in->Assign<float>();
+    const float* alpha = GetScalar<float>(in);
     float* A = in->GetFromMarshal<float*>();
     int lda = in->Get<int>();
     float* x = in->GetFromMarshal<float*>();
     int incx = in->Get<int>();
 
-    const float* beta = in->Assign<float>();
+    const float* beta = GetScalar<float>(in);
     float* y = in->GetFromMarshal<float*>();
     int incy = in->Get<int>();
 
@@ -742,13 +742,13 @@ CUBLAS_ROUTINE_HANDLER(Dsbmv_v2) {
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const double* alpha = in->Assign<double>();
+    const double* alpha = GetScalar<double>(in);
     double* A = in->GetFromMarshal<double*>();
     int lda = in->Get<int>();
     double* x = in->GetFromMarshal<double*>();
     int incx = in->Get<int>();
 
-    const double* beta = in->Assign<double>();
+    const double* beta = GetScalar<double>(in);
     double* y = in->GetFromMarshal<double*>();
     int incy = in->Get<int>();
 
@@ -762,13 +762,13 @@ CUBLAS_ROUTINE_HANDLER(Chbmv_v2) {
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const cuComplex* alpha = in->Assign<cuComplex>();
+    const cuComplex* alpha = GetScalar<cuComplex>(in);
     cuComplex* A = in->GetFromMarshal<cuComplex*>();
     int lda = in->Get<int>();
     cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
 
-    const cuComplex* beta = in->Assign<cuComplex>();
+    const cuComplex* beta = GetScalar<cuComplex>(in);
     cuComplex* y = in->GetFromMarshal<cuComplex*>();
     int incy = in->Get<int>();
 
@@ -782,13 +782,13 @@ CUBLAS_ROUTINE_HANDLER(Zhbmv_v2) {
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const cuDoubleComplex* alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* A = in->GetFromMarshal<cuDoubleComplex*>();
     int lda = in->Get<int>();
     cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
 
-    const cuDoubleComplex* beta = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* beta = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* y = in->GetFromMarshal<cuDoubleComplex*>();
     int incy = in->Get<int>();
 
@@ -801,12 +801,12 @@ CUBLAS_ROUTINE_HANDLER(Sspmv_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const float* alpha = in->Assign<float>();
+    const float* alpha = GetScalar<float>(in);
     float* AP = in->GetFromMarshal<float*>();
     float* x = in->GetFromMarshal<float*>();
     int incx = in->Get<int>();
 
-    const float* beta = in->Assign<float>();
+    const float* beta = GetScalar<float>(in);
     float* y = in->GetFromMarshal<float*>();
     int incy = in->Get<int>();
 
@@ -819,12 +819,12 @@ CUBLAS_ROUTINE_HANDLER(Dspmv_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const double* alpha = in->Assign<double>();
+    const double* alpha = GetScalar<double>(in);
     double* AP = in->GetFromMarshal<double*>();
     double* x = in->GetFromMarshal<double*>();
     int incx = in->Get<int>();
 
-    const double* beta = in->Assign<double>();
+    const double* beta = GetScalar<double>(in);
     double* y = in->GetFromMarshal<double*>();
     int incy = in->Get<int>();
 
@@ -837,12 +837,12 @@ CUBLAS_ROUTINE_HANDLER(Chpmv_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuComplex* alpha = in->Assign<cuComplex>();
+    const cuComplex* alpha = GetScalar<cuComplex>(in);
     cuComplex* AP = in->GetFromMarshal<cuComplex*>();
     cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
 
-    const cuComplex* beta = in->Assign<cuComplex>();
+    const cuComplex* beta = GetScalar<cuComplex>(in);
     cuComplex* y = in->GetFromMarshal<cuComplex*>();
     int incy = in->Get<int>();
 
@@ -855,12 +855,12 @@ CUBLAS_ROUTINE_HANDLER(Zhpmv_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuDoubleComplex* alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* AP = in->GetFromMarshal<cuDoubleComplex*>();
     cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
 
-    const cuDoubleComplex* beta = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* beta = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* y = in->GetFromMarshal<cuDoubleComplex*>();
     int incy = in->Get<int>();
 
@@ -873,7 +873,7 @@ CUBLAS_ROUTINE_HANDLER(Sger_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     int m = in->Get<int>();
     int n = in->Get<int>();
-    const float* alpha = in->Assign<float>();
+    const float* alpha = GetScalar<float>(in);
     float* x = in->GetFromMarshal<float*>();
     int incx = in->Get<int>();
     float* y = in->GetFromMarshal<float*>();
@@ -890,7 +890,7 @@ CUBLAS_ROUTINE_HANDLER(Dger_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     int m = in->Get<int>();
     int n = in->Get<int>();
-    const double* alpha = in->Assign<double>();
+    const double* alpha = GetScalar<double>(in);
     double* x = in->GetFromMarshal<double*>();
     int incx = in->Get<int>();
     double* y = in->GetFromMarshal<double*>();
@@ -907,7 +907,7 @@ CUBLAS_ROUTINE_HANDLER(Cgeru_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     int m = in->Get<int>();
     int n = in->Get<int>();
-    const cuComplex* alpha = in->Assign<cuComplex>();
+    const cuComplex* alpha = GetScalar<cuComplex>(in);
     cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
     cuComplex* y = in->GetFromMarshal<cuComplex*>();
@@ -924,7 +924,7 @@ CUBLAS_ROUTINE_HANDLER(Cgerc_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     int m = in->Get<int>();
     int n = in->Get<int>();
-    const cuComplex* alpha = in->Assign<cuComplex>();
+    const cuComplex* alpha = GetScalar<cuComplex>(in);
     cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
     cuComplex* y = in->GetFromMarshal<cuComplex*>();
@@ -941,7 +941,7 @@ CUBLAS_ROUTINE_HANDLER(Zgeru_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     int m = in->Get<int>();
     int n = in->Get<int>();
-    const cuDoubleComplex* alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
     cuDoubleComplex* y = in->GetFromMarshal<cuDoubleComplex*>();
@@ -958,7 +958,7 @@ CUBLAS_ROUTINE_HANDLER(Zgerc_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     int m = in->Get<int>();
     int n = in->Get<int>();
-    const cuDoubleComplex* alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
     cuDoubleComplex* y = in->GetFromMarshal<cuDoubleComplex*>();
@@ -975,7 +975,7 @@ CUBLAS_ROUTINE_HANDLER(Ssyr_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const float* alpha = in->Assign<float>();
+    const float* alpha = GetScalar<float>(in);
     float* x = in->GetFromMarshal<float*>();
     int incx = in->Get<int>();
     float* A = in->GetFromMarshal<float*>();
@@ -990,7 +990,7 @@ CUBLAS_ROUTINE_HANDLER(Dsyr_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const double* alpha = in->Assign<double>();
+    const double* alpha = GetScalar<double>(in);
     double* x = in->GetFromMarshal<double*>();
     int incx = in->Get<int>();
     double* A = in->GetFromMarshal<double*>();
@@ -1005,7 +1005,7 @@ CUBLAS_ROUTINE_HANDLER(Csyr_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuComplex* alpha = in->Assign<cuComplex>();
+    const cuComplex* alpha = GetScalar<cuComplex>(in);
     cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
     cuComplex* A = in->GetFromMarshal<cuComplex*>();
@@ -1020,7 +1020,7 @@ CUBLAS_ROUTINE_HANDLER(Zsyr_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuDoubleComplex* alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
     cuDoubleComplex* A = in->GetFromMarshal<cuDoubleComplex*>();
@@ -1035,7 +1035,7 @@ CUBLAS_ROUTINE_HANDLER(Cher_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const float* alpha = in->Assign<float>();
+    const float* alpha = GetScalar<float>(in);
     cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
     cuComplex* A = in->GetFromMarshal<cuComplex*>();
@@ -1050,7 +1050,7 @@ CUBLAS_ROUTINE_HANDLER(Zher_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const double* alpha = in->Assign<double>();
+    const double* alpha = GetScalar<double>(in);
     cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
     cuDoubleComplex* A = in->GetFromMarshal<cuDoubleComplex*>();
@@ -1065,7 +1065,7 @@ CUBLAS_ROUTINE_HANDLER(Sspr_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const float* alpha = in->Assign<float>();
+    const float* alpha = GetScalar<float>(in);
     float* x = in->GetFromMarshal<float*>();
     int incx = in->Get<int>();
     float* AP = in->GetFromMarshal<float*>();
@@ -1079,7 +1079,7 @@ CUBLAS_ROUTINE_HANDLER(Dspr_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const double* alpha = in->Assign<double>();
+    const double* alpha = GetScalar<double>(in);
     double* x = in->GetFromMarshal<double*>();
     int incx = in->Get<int>();
     double* AP = in->GetFromMarshal<double*>();
@@ -1093,7 +1093,7 @@ CUBLAS_ROUTINE_HANDLER(Chpr_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const float* alpha = in->Assign<float>();
+    const float* alpha = GetScalar<float>(in);
     cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
     cuComplex* AP = in->GetFromMarshal<cuComplex*>();
@@ -1107,7 +1107,7 @@ CUBLAS_ROUTINE_HANDLER(Zhpr_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const double* alpha = in->Assign<double>();
+    const double* alpha = GetScalar<double>(in);
     cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
     cuDoubleComplex* AP = in->GetFromMarshal<cuDoubleComplex*>();
@@ -1121,7 +1121,7 @@ CUBLAS_ROUTINE_HANDLER(Ssyr2_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const float* alpha = in->Assign<float>();
+    const float* alpha = GetScalar<float>(in);
     float* x = in->GetFromMarshal<float*>();
     int incx = in->Get<int>();
     float* y = in->GetFromMarshal<float*>();
@@ -1138,7 +1138,7 @@ CUBLAS_ROUTINE_HANDLER(Dsyr2_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const double* alpha = in->Assign<double>();
+    const double* alpha = GetScalar<double>(in);
     double* x = in->GetFromMarshal<double*>();
     int incx = in->Get<int>();
     double* y = in->GetFromMarshal<double*>();
@@ -1155,7 +1155,7 @@ CUBLAS_ROUTINE_HANDLER(Csyr2_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuComplex* alpha = in->Assign<cuComplex>();
+    const cuComplex* alpha = GetScalar<cuComplex>(in);
     cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
     cuComplex* y = in->GetFromMarshal<cuComplex*>();
@@ -1172,7 +1172,7 @@ CUBLAS_ROUTINE_HANDLER(Zsyr2_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuDoubleComplex* alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
     cuDoubleComplex* y = in->GetFromMarshal<cuDoubleComplex*>();
@@ -1189,7 +1189,7 @@ CUBLAS_ROUTINE_HANDLER(Cher2_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuComplex* alpha = in->Assign<cuComplex>();
+    const cuComplex* alpha = GetScalar<cuComplex>(in);
     cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
     cuComplex* y = in->GetFromMarshal<cuComplex*>();
@@ -1206,7 +1206,7 @@ CUBLAS_ROUTINE_HANDLER(Zher2_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuDoubleComplex* alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
     cuDoubleComplex* y = in->GetFromMarshal<cuDoubleComplex*>();
@@ -1223,7 +1223,7 @@ CUBLAS_ROUTINE_HANDLER(Sspr2_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const float* alpha = in->Assign<float>();
+    const float* alpha = GetScalar<float>(in);
     float* x = in->GetFromMarshal<float*>();
     int incx = in->Get<int>();
     float* y = in->GetFromMarshal<float*>();
@@ -1239,7 +1239,7 @@ CUBLAS_ROUTINE_HANDLER(Dspr2_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const double* alpha = in->Assign<double>();
+    const double* alpha = GetScalar<double>(in);
     double* x = in->GetFromMarshal<double*>();
     int incx = in->Get<int>();
     double* y = in->GetFromMarshal<double*>();
@@ -1255,7 +1255,7 @@ CUBLAS_ROUTINE_HANDLER(Chpr2_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuComplex* alpha = in->Assign<cuComplex>();
+    const cuComplex* alpha = GetScalar<cuComplex>(in);
     cuComplex* x = in->GetFromMarshal<cuComplex*>();
     int incx = in->Get<int>();
     cuComplex* y = in->GetFromMarshal<cuComplex*>();
@@ -1271,7 +1271,7 @@ CUBLAS_ROUTINE_HANDLER(Zhpr2_v2) {
     handle = (cublasHandle_t)in->Get<long long int>();
     cublasFillMode_t uplo = in->Get<cublasFillMode_t>();
     int n = in->Get<int>();
-    const cuDoubleComplex* alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex* alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex* x = in->GetFromMarshal<cuDoubleComplex*>();
     int incx = in->Get<int>();
     cuDoubleComplex* y = in->GetFromMarshal<cuDoubleComplex*>();
@@ -31,25 +31,18 @@ using gvirtus::communicators::Buffer;
 using gvirtus::communicators::Result;
 
 CUBLAS_ROUTINE_HANDLER(Sgemm_v2) {
-    // TODO: For now, it only works if alpha, beta are host pointers.
-    // If they are device pointers, we need to add a check in the backend to
-    // handle them correctly. If the function cublasSetPointerMode is called
-    // with CUBLAS_POINTER_MODE_DEVICE, then alpha and beta should be device
-    // pointers, otherwise they should be host pointers. We need to keep track
-    // of the pointer mode in the backend and handle it accordingly.
-
     cublasHandle_t handle = in->Get<cublasHandle_t>();
     cublasOperation_t transa = in->Get<cublasOperation_t>();
     cublasOperation_t transb = in->Get<cublasOperation_t>();
     int m = in->Get<int>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const float *alpha = in->Assign<float>();
+    const float *alpha = GetScalar<float>(in);
     float *A = in->GetFromMarshal<float *>();
     int lda = in->Get<int>();
     float *B = in->GetFromMarshal<float *>();
     int ldb = in->Get<int>();
-    const float *beta = in->Assign<float>();
+    const float *beta = GetScalar<float>(in);
     float *C = in->GetFromMarshal<float *>();
     int ldc = in->Get<int>();
     cublasStatus_t cs =
@@ -67,13 +60,13 @@ CUBLAS_ROUTINE_HANDLER(SgemmBatched_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const float *alpha = in->Assign<float>();
+    const float *alpha = GetScalar<float>(in);
 
     const float **A = (const float **)in->GetFromMarshal<float **>();
     int lda = in->Get<int>();
     const float **B = (const float **)in->GetFromMarshal<float **>();
     int ldb = in->Get<int>();
-    const float *beta = in->Assign<float>();
+    const float *beta = GetScalar<float>(in);
     float **C = in->GetFromMarshal<float **>();
     int ldc = in->Get<int>();
     int batchSize = in->Get<int>();
@@ -102,12 +95,12 @@ CUBLAS_ROUTINE_HANDLER(Dgemm_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const double *alpha = in->Assign<double>();
+    const double *alpha = GetScalar<double>(in);
     double *A = in->GetFromMarshal<double *>();
     int lda = in->Get<int>();
     double *B = in->GetFromMarshal<double *>();
     int ldb = in->Get<int>();
-    const double *beta = in->Assign<double>();
+    const double *beta = GetScalar<double>(in);
     double *C = in->GetFromMarshal<double *>();
     int ldc = in->Get<int>();
     cublasStatus_t cs =
@@ -125,13 +118,13 @@ CUBLAS_ROUTINE_HANDLER(DgemmBatched_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const double *alpha = in->Assign<double>();
+    const double *alpha = GetScalar<double>(in);
 
     const double **A = (const double **)in->GetFromMarshal<double **>();
     int lda = in->Get<int>();
     const double **B = (const double **)in->GetFromMarshal<double **>();
     int ldb = in->Get<int>();
-    const double *beta = in->Assign<double>();
+    const double *beta = GetScalar<double>(in);
     double **C = in->GetFromMarshal<double **>();
     int ldc = in->Get<int>();
     int batchSize = in->Get<int>();
@@ -160,13 +153,13 @@ CUBLAS_ROUTINE_HANDLER(Cgemm_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const cuComplex *alpha = in->Assign<cuComplex>();
+    const cuComplex *alpha = GetScalar<cuComplex>(in);
 
     cuComplex *A = in->GetFromMarshal<cuComplex *>();
     int lda = in->Get<int>();
     cuComplex *B = in->GetFromMarshal<cuComplex *>();
     int ldb = in->Get<int>();
-    const cuComplex *beta = in->Assign<cuComplex>();
+    const cuComplex *beta = GetScalar<cuComplex>(in);
     cuComplex *C = in->GetFromMarshal<cuComplex *>();
     int ldc = in->Get<int>();
     cublasStatus_t cs;
@@ -192,13 +185,13 @@ CUBLAS_ROUTINE_HANDLER(CgemmBatched_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const cuComplex *alpha = in->Assign<cuComplex>();
+    const cuComplex *alpha = GetScalar<cuComplex>(in);
 
     const cuComplex **A = (const cuComplex **)in->GetFromMarshal<cuComplex **>();
     int lda = in->Get<int>();
     const cuComplex **B = (const cuComplex **)in->GetFromMarshal<cuComplex **>();
     int ldb = in->Get<int>();
-    const cuComplex *beta = in->Assign<cuComplex>();
+    const cuComplex *beta = GetScalar<cuComplex>(in);
     cuComplex **C = in->GetFromMarshal<cuComplex **>();
     int ldc = in->Get<int>();
     int batchSize = in->Get<int>();
@@ -227,13 +220,13 @@ CUBLAS_ROUTINE_HANDLER(Zgemm_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const cuDoubleComplex *alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *alpha = GetScalar<cuDoubleComplex>(in);
 
     cuDoubleComplex *A = in->GetFromMarshal<cuDoubleComplex *>();
     int lda = in->Get<int>();
     cuDoubleComplex *B = in->GetFromMarshal<cuDoubleComplex *>();
     int ldb = in->Get<int>();
-    const cuDoubleComplex *beta = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *beta = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex *C = in->GetFromMarshal<cuDoubleComplex *>();
     int ldc = in->Get<int>();
     cublasStatus_t cs;
@@ -259,13 +252,13 @@ CUBLAS_ROUTINE_HANDLER(ZgemmBatched_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const cuDoubleComplex *alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *alpha = GetScalar<cuDoubleComplex>(in);
 
     const cuDoubleComplex **A = (const cuDoubleComplex **)in->GetFromMarshal<cuDoubleComplex **>();
     int lda = in->Get<int>();
     const cuDoubleComplex **B = (const cuDoubleComplex **)in->GetFromMarshal<cuDoubleComplex **>();
     int ldb = in->Get<int>();
-    const cuDoubleComplex *beta = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *beta = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex **C = in->GetFromMarshal<cuDoubleComplex **>();
     int ldc = in->Get<int>();
     int batchSize = in->Get<int>();
@@ -288,83 +281,80 @@ CUBLAS_ROUTINE_HANDLER(ZgemmBatched_v2) {
 CUBLAS_ROUTINE_HANDLER(Snrm2_v2) {
     cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
-    const float *x = in->GetFromMarshal<float *>();
+    float *x = in->GetFromMarshal<float *>();
     int incx = in->Get<int>();
     float result;
+    float *target = GetResult<float>(in, &result);
 
-    cublasStatus_t cs = cublasSnrm2_v2(handle, n, x, incx, &result);
+    cublasStatus_t cs = cublasSnrm2_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasSnrm2_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
     try {
-        out->Add<float>(result);
+        if (target == &result) out->Add<float>(result);
     } catch (const std::exception &e) {
         LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
         return std::make_shared<Result>(cudaErrorMemoryAllocation);
     }
-    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasSnrm2_v2 Executed");
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Dnrm2_v2) {
-    cublasHandle_t handle;
-    handle = in->Get<cublasHandle_t>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     double *x = in->GetFromMarshal<double *>();
     int incx = in->Get<int>();
     double result;
+    double *target = GetResult<double>(in, &result);
 
-    cublasStatus_t cs = cublasDnrm2_v2(handle, n, x, incx, &result);
+    cublasStatus_t cs = cublasDnrm2_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasDnrm2_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
     try {
-        out->Add<double>(result);
+        if (target == &result) out->Add<double>(result);
     } catch (const std::exception &e) {
         LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
         return std::make_shared<Result>(cudaErrorMemoryAllocation);
     }
-    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasDnrm2_v2 Executed");
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Scnrm2_v2) {
-    cublasHandle_t handle;
-    handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     cuComplex *x = in->GetFromMarshal<cuComplex *>();
     int incx = in->Get<int>();
     float result;
+    float *target = GetResult<float>(in, &result);
 
-    cublasStatus_t cs = cublasScnrm2_v2(handle, n, x, incx, &result);
+    cublasStatus_t cs = cublasScnrm2_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasScnrm2_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
     try {
-        out->Add<float>(result);
+        if (target == &result) out->Add<float>(result);
     } catch (const std::exception &e) {
         LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
         return std::make_shared<Result>(cudaErrorMemoryAllocation);
     }
-    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasScnrm2_v2 Executed");
     return std::make_shared<Result>(cs, out);
 }
 
 CUBLAS_ROUTINE_HANDLER(Dznrm2_v2) {
-    cublasHandle_t handle;
-    handle = (cublasHandle_t)in->Get<long long int>();
+    cublasHandle_t handle = in->Get<cublasHandle_t>();
     int n = in->Get<int>();
     cuDoubleComplex *x = in->GetFromMarshal<cuDoubleComplex *>();
     int incx = in->Get<int>();
     double result;
+    double *target = GetResult<double>(in, &result);
 
-    cublasStatus_t cs = cublasDznrm2_v2(handle, n, x, incx, &result);
+    cublasStatus_t cs = cublasDznrm2_v2(handle, n, x, incx, target);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasDznrm2_v2 Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-
     try {
-        out->Add<double>(result);
+        if (target == &result) out->Add<double>(result);
     } catch (const std::exception &e) {
         LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
         return std::make_shared<Result>(cudaErrorMemoryAllocation);
     }
-    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cublasDznrm2_v2 Executed");
     return std::make_shared<Result>(cs, out);
 }
 
@@ -375,10 +365,10 @@ CUBLAS_ROUTINE_HANDLER(Ssyrk_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const float *alpha = in->Assign<float>();
+    const float *alpha = GetScalar<float>(in);
     float *A = in->GetFromMarshal<float *>();
     int lda = in->Get<int>();
-    const float *beta = in->Assign<float>();
+    const float *beta = GetScalar<float>(in);
     float *C = in->GetFromMarshal<float *>();
     int ldc = in->Get<int>();
 
@@ -393,10 +383,10 @@ CUBLAS_ROUTINE_HANDLER(Dsyrk_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const double *alpha = in->Assign<double>();
+    const double *alpha = GetScalar<double>(in);
     double *A = in->GetFromMarshal<double *>();
     int lda = in->Get<int>();
-    const double *beta = in->Assign<double>();
+    const double *beta = GetScalar<double>(in);
     double *C = in->GetFromMarshal<double *>();
     int ldc = in->Get<int>();
 
@@ -411,10 +401,10 @@ CUBLAS_ROUTINE_HANDLER(Csyrk_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const cuComplex *alpha = in->Assign<cuComplex>();
+    const cuComplex *alpha = GetScalar<cuComplex>(in);
     cuComplex *A = in->GetFromMarshal<cuComplex *>();
     int lda = in->Get<int>();
-    const cuComplex *beta = in->Assign<cuComplex>();
+    const cuComplex *beta = GetScalar<cuComplex>(in);
     cuComplex *C = in->GetFromMarshal<cuComplex *>();
     int ldc = in->Get<int>();
 
@@ -429,10 +419,10 @@ CUBLAS_ROUTINE_HANDLER(Zsyrk_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const cuDoubleComplex *alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex *A = in->GetFromMarshal<cuDoubleComplex *>();
     int lda = in->Get<int>();
-    const cuDoubleComplex *beta = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *beta = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex *C = in->GetFromMarshal<cuDoubleComplex *>();
     int ldc = in->Get<int>();
 
@@ -447,10 +437,10 @@ CUBLAS_ROUTINE_HANDLER(Cherk_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const float *alpha = in->Assign<float>();
+    const float *alpha = GetScalar<float>(in);
     cuComplex *A = in->GetFromMarshal<cuComplex *>();
     int lda = in->Get<int>();
-    const float *beta = in->Assign<float>();
+    const float *beta = GetScalar<float>(in);
     cuComplex *C = in->GetFromMarshal<cuComplex *>();
     int ldc = in->Get<int>();
 
@@ -465,10 +455,10 @@ CUBLAS_ROUTINE_HANDLER(Zherk_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const double *alpha = in->Assign<double>();
+    const double *alpha = GetScalar<double>(in);
     cuDoubleComplex *A = in->GetFromMarshal<cuDoubleComplex *>();
     int lda = in->Get<int>();
-    const double *beta = in->Assign<double>();
+    const double *beta = GetScalar<double>(in);
     cuDoubleComplex *C = in->GetFromMarshal<cuDoubleComplex *>();
     int ldc = in->Get<int>();
 
@@ -483,14 +473,14 @@ CUBLAS_ROUTINE_HANDLER(Ssyr2k_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const float *alpha = in->Assign<float>();
+    const float *alpha = GetScalar<float>(in);
     float *A = in->GetFromMarshal<float *>();
     int lda = in->Get<int>();
 
     float *B = in->GetFromMarshal<float *>();
     int ldb = in->Get<int>();
 
-    const float *beta = in->Assign<float>();
+    const float *beta = GetScalar<float>(in);
 
     float *C = in->GetFromMarshal<float *>();
     int ldc = in->Get<int>();
@@ -507,14 +497,14 @@ CUBLAS_ROUTINE_HANDLER(Dsyr2k_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const double *alpha = in->Assign<double>();
+    const double *alpha = GetScalar<double>(in);
     double *A = in->GetFromMarshal<double *>();
     int lda = in->Get<int>();
 
     double *B = in->GetFromMarshal<double *>();
     int ldb = in->Get<int>();
 
-    const double *beta = in->Assign<double>();
+    const double *beta = GetScalar<double>(in);
 
     double *C = in->GetFromMarshal<double *>();
     int ldc = in->Get<int>();
@@ -531,14 +521,14 @@ CUBLAS_ROUTINE_HANDLER(Csyr2k_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const cuComplex *alpha = in->Assign<cuComplex>();
+    const cuComplex *alpha = GetScalar<cuComplex>(in);
     cuComplex *A = in->GetFromMarshal<cuComplex *>();
     int lda = in->Get<int>();
 
     cuComplex *B = in->GetFromMarshal<cuComplex *>();
     int ldb = in->Get<int>();
 
-    const cuComplex *beta = in->Assign<cuComplex>();
+    const cuComplex *beta = GetScalar<cuComplex>(in);
 
     cuComplex *C = in->GetFromMarshal<cuComplex *>();
     int ldc = in->Get<int>();
@@ -555,14 +545,14 @@ CUBLAS_ROUTINE_HANDLER(Zsyr2k_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const cuDoubleComplex *alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex *A = in->GetFromMarshal<cuDoubleComplex *>();
     int lda = in->Get<int>();
 
     cuDoubleComplex *B = in->GetFromMarshal<cuDoubleComplex *>();
     int ldb = in->Get<int>();
 
-    const cuDoubleComplex *beta = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *beta = GetScalar<cuDoubleComplex>(in);
 
     cuDoubleComplex *C = in->GetFromMarshal<cuDoubleComplex *>();
     int ldc = in->Get<int>();
@@ -579,14 +569,14 @@ CUBLAS_ROUTINE_HANDLER(Cher2k_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const cuComplex *alpha = in->Assign<cuComplex>();
+    const cuComplex *alpha = GetScalar<cuComplex>(in);
     cuComplex *A = in->GetFromMarshal<cuComplex *>();
     int lda = in->Get<int>();
 
     cuComplex *B = in->GetFromMarshal<cuComplex *>();
     int ldb = in->Get<int>();
 
-    const float *beta = in->Assign<float>();
+    const float *beta = GetScalar<float>(in);
 
     cuComplex *C = in->GetFromMarshal<cuComplex *>();
     int ldc = in->Get<int>();
@@ -603,14 +593,14 @@ CUBLAS_ROUTINE_HANDLER(Zher2k_v2) {
     cublasOperation_t trans = in->Get<cublasOperation_t>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const cuDoubleComplex *alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex *A = in->GetFromMarshal<cuDoubleComplex *>();
     int lda = in->Get<int>();
 
     cuDoubleComplex *B = in->GetFromMarshal<cuDoubleComplex *>();
     int ldb = in->Get<int>();
 
-    const double *beta = in->Assign<double>();
+    const double *beta = GetScalar<double>(in);
 
     cuDoubleComplex *C = in->GetFromMarshal<cuDoubleComplex *>();
     int ldc = in->Get<int>();
@@ -628,14 +618,14 @@ CUBLAS_ROUTINE_HANDLER(Ssymm_v2) {
     int n = in->Get<int>();
     int k = in->Get<int>();
 
-    const float *alpha = in->Assign<float>();
+    const float *alpha = GetScalar<float>(in);
     float *A = in->GetFromMarshal<float *>();
     int lda = in->Get<int>();
 
     float *B = in->GetFromMarshal<float *>();
     int ldb = in->Get<int>();
 
-    const float *beta = in->Assign<float>();
+    const float *beta = GetScalar<float>(in);
 
     float *C = in->GetFromMarshal<float *>();
     int ldc = in->Get<int>();
@@ -653,14 +643,14 @@ CUBLAS_ROUTINE_HANDLER(Dsymm_v2) {
     int n = in->Get<int>();
     int k = in->Get<int>();
 
-    const double *alpha = in->Assign<double>();
+    const double *alpha = GetScalar<double>(in);
     double *A = in->GetFromMarshal<double *>();
     int lda = in->Get<int>();
 
     double *B = in->GetFromMarshal<double *>();
     int ldb = in->Get<int>();
 
-    const double *beta = in->Assign<double>();
+    const double *beta = GetScalar<double>(in);
 
     double *C = in->GetFromMarshal<double *>();
     int ldc = in->Get<int>();
@@ -678,14 +668,14 @@ CUBLAS_ROUTINE_HANDLER(Csymm_v2) {
     int n = in->Get<int>();
     int k = in->Get<int>();
 
-    const cuComplex *alpha = in->Assign<cuComplex>();
+    const cuComplex *alpha = GetScalar<cuComplex>(in);
     cuComplex *A = in->GetFromMarshal<cuComplex *>();
     int lda = in->Get<int>();
 
     cuComplex *B = in->GetFromMarshal<cuComplex *>();
     int ldb = in->Get<int>();
 
-    const cuComplex *beta = in->Assign<cuComplex>();
+    const cuComplex *beta = GetScalar<cuComplex>(in);
 
     cuComplex *C = in->GetFromMarshal<cuComplex *>();
     int ldc = in->Get<int>();
@@ -703,14 +693,14 @@ CUBLAS_ROUTINE_HANDLER(Zsymm_v2) {
     int n = in->Get<int>();
     int k = in->Get<int>();
 
-    const cuDoubleComplex *alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex *A = in->GetFromMarshal<cuDoubleComplex *>();
     int lda = in->Get<int>();
 
     cuDoubleComplex *B = in->GetFromMarshal<cuDoubleComplex *>();
     int ldb = in->Get<int>();
 
-    const cuDoubleComplex *beta = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *beta = GetScalar<cuDoubleComplex>(in);
 
     cuDoubleComplex *C = in->GetFromMarshal<cuDoubleComplex *>();
     int ldc = in->Get<int>();
@@ -728,14 +718,14 @@ CUBLAS_ROUTINE_HANDLER(Chemm_v2) {
     int n = in->Get<int>();
     int k = in->Get<int>();
 
-    const cuComplex *alpha = in->Assign<cuComplex>();
+    const cuComplex *alpha = GetScalar<cuComplex>(in);
     cuComplex *A = in->GetFromMarshal<cuComplex *>();
     int lda = in->Get<int>();
 
     cuComplex *B = in->GetFromMarshal<cuComplex *>();
     int ldb = in->Get<int>();
 
-    const cuComplex *beta = in->Assign<cuComplex>();
+    const cuComplex *beta = GetScalar<cuComplex>(in);
 
     cuComplex *C = in->GetFromMarshal<cuComplex *>();
     int ldc = in->Get<int>();
@@ -753,14 +743,14 @@ CUBLAS_ROUTINE_HANDLER(Zhemm_v2) {
     int n = in->Get<int>();
     int k = in->Get<int>();
 
-    const cuDoubleComplex *alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex *A = in->GetFromMarshal<cuDoubleComplex *>();
     int lda = in->Get<int>();
 
     cuDoubleComplex *B = in->GetFromMarshal<cuDoubleComplex *>();
     int ldb = in->Get<int>();
 
-    const cuDoubleComplex *beta = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *beta = GetScalar<cuDoubleComplex>(in);
 
     cuDoubleComplex *C = in->GetFromMarshal<cuDoubleComplex *>();
     int ldc = in->Get<int>();
@@ -780,7 +770,7 @@ CUBLAS_ROUTINE_HANDLER(Strsm_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
 
-    const float *alpha = in->Assign<float>();
+    const float *alpha = GetScalar<float>(in);
     float *A = in->GetFromMarshal<float *>();
     int lda = in->Get<int>();
 
@@ -802,7 +792,7 @@ CUBLAS_ROUTINE_HANDLER(Dtrsm_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
 
-    const double *alpha = in->Assign<double>();
+    const double *alpha = GetScalar<double>(in);
     double *A = in->GetFromMarshal<double *>();
     int lda = in->Get<int>();
 
@@ -824,7 +814,7 @@ CUBLAS_ROUTINE_HANDLER(Ctrsm_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
 
-    const cuComplex *alpha = in->Assign<cuComplex>();
+    const cuComplex *alpha = GetScalar<cuComplex>(in);
     cuComplex *A = in->GetFromMarshal<cuComplex *>();
     int lda = in->Get<int>();
 
@@ -846,7 +836,7 @@ CUBLAS_ROUTINE_HANDLER(Ztrsm_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
 
-    const cuDoubleComplex *alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex *A = in->GetFromMarshal<cuDoubleComplex *>();
     int lda = in->Get<int>();
 
@@ -868,7 +858,7 @@ CUBLAS_ROUTINE_HANDLER(Strmm_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
 
-    const float *alpha = in->Assign<float>();
+    const float *alpha = GetScalar<float>(in);
     float *A = in->GetFromMarshal<float *>();
     int lda = in->Get<int>();
 
@@ -893,7 +883,7 @@ CUBLAS_ROUTINE_HANDLER(Dtrmm_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
 
-    const double *alpha = in->Assign<double>();
+    const double *alpha = GetScalar<double>(in);
     double *A = in->GetFromMarshal<double *>();
     int lda = in->Get<int>();
 
@@ -918,7 +908,7 @@ CUBLAS_ROUTINE_HANDLER(Ctrmm_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
 
-    const cuComplex *alpha = in->Assign<cuComplex>();
+    const cuComplex *alpha = GetScalar<cuComplex>(in);
     cuComplex *A = in->GetFromMarshal<cuComplex *>();
     int lda = in->Get<int>();
 
@@ -943,7 +933,7 @@ CUBLAS_ROUTINE_HANDLER(Ztrmm_v2) {
     int m = in->Get<int>();
     int n = in->Get<int>();
 
-    const cuDoubleComplex *alpha = in->Assign<cuDoubleComplex>();
+    const cuDoubleComplex *alpha = GetScalar<cuDoubleComplex>(in);
     cuDoubleComplex *A = in->GetFromMarshal<cuDoubleComplex *>();
     int lda = in->Get<int>();
 
@@ -965,14 +955,14 @@ CUBLAS_ROUTINE_HANDLER(SgemmStridedBatched) {
     int m = in->Get<int>();
     int n = in->Get<int>();
     int k = in->Get<int>();
-    const float *alpha = in->Assign<float>();
+    const float *alpha = GetScalar<float>(in);
     const float *A = in->GetFromMarshal<float *>();
     int lda = in->Get<int>();
     long long int strideA = in->Get<long long int>();
     const float *B = in->GetFromMarshal<float *>();
     int ldb = in->Get<int>();
     long long int strideB = in->Get<long long int>();
-    const float *beta = in->Assign<float>();
+    const float *beta = GetScalar<float>(in);
     float *C = in->GetFromMarshal<float *>();
     int ldc = in->Get<int>();
     long long int strideC = in->Get<long long int>();
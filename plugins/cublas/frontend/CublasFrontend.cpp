@@ -25,9 +25,31 @@
 
 #include "CublasFrontend.h"
 
+#include <mutex>
+#include <unordered_map>
+
 CublasFrontend msInstance __attribute_used__;
 void* CublasFrontend::handler = NULL;
 
 using gvirtus::frontend::Frontend;
 
 CublasFrontend::CublasFrontend() { Frontend::GetFrontend(); }
+
+static std::mutex handle_states_mutex;
+static std::unordered_map<cublasHandle_t, CublasHandleState> handle_states;
+
+CublasHandleState *CublasFrontend::GetHandleState(cublasHandle_t handle) {
+    std::lock_guard<std::mutex> lock(handle_states_mutex);
+    auto it = handle_states.find(handle);
+    return it != handle_states.end() ? &it->second : nullptr;
+}
+
+void CublasFrontend::AddHandleState(cublasHandle_t handle) {
+    std::lock_guard<std::mutex> lock(handle_states_mutex);
+    handle_states[handle] = CublasHandleState();
+}
+
+void CublasFrontend::ForgetHandleState(cublasHandle_t handle) {
+    std::lock_guard<std::mutex> lock(handle_states_mutex);
+    handle_states.erase(handle);
+}
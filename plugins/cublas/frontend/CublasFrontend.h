@@ -39,6 +39,20 @@
 #include <cublas_v2.h>
 #include <gvirtus/frontend/Frontend.h>
 
+/*
+ * The state of a cuBLAS handle as the frontend last set it. Getters and the
+ * setters that would not change it need no round trip, and the pointer mode
+ * tells how the scalars of the routines travel (see AddScalarForArguments).
+ */
+struct CublasHandleState {
+    cublasPointerMode_t pointerMode = CUBLAS_POINTER_MODE_HOST;
+    cublasMath_t mathMode = CUBLAS_DEFAULT_MATH;
+    cudaStream_t stream = NULL;
+    void *workspace = NULL;
+    size_t workspaceSize = 0;
+    bool workspaceSet = false;  // cublasSetStream resets it to the default pool
+};
+
 class CublasFrontend {
    public:
     static inline void Execute(const char *routine,
@@ -92,6 +106,19 @@ class CublasFrontend {
         gvirtus::frontend::Frontend::GetFrontend()->GetInputBuffer()->Add(ptr, n);
     }
 
+    /**
+     * Reserves room for an host array of n elements among the input parameters
+     * of the next execution request, for the caller to fill in place.
+     *
+     * @param n the length of the array in terms of elements.
+     *
+     * @return the address of the reserved room.
+     */
+    template <class T>
+    static inline T *DelegateHostPointerForArguments(size_t n) {
+        return gvirtus::frontend::Frontend::GetFrontend()->GetInputBuffer()->Delegate<T>(n);
+    }
+
     /**
      * Adds a device pointer as an input parameter for the next execution
      * request.
@@ -102,6 +129,48 @@ class CublasFrontend {
         gvirtus::frontend::Frontend::GetFrontend()->GetInputBuffer()->Add((uint64_t)ptr);
     }
 
+    /**
+     * Adds a scalar of a cuBLAS routine (alpha, beta, ...) as an input
+     * parameter for the next execution request: by value when the handle is in
+     * host pointer mode, as a device address when it is in device pointer mode.
+     *
+     * @param handle the cuBLAS handle of the routine.
+     * @param scalar the host or device pointer to the scalar.
+     * @param n the number of scalars, such as the 5 of the param of rotm.
+     */
+    template <class T>
+    static inline void AddScalarForArguments(cublasHandle_t handle, const T *scalar,
+                                             size_t n = 1) {
+        gvirtus::communicators::Buffer *in =
+            gvirtus::frontend::Frontend::GetFrontend()->GetInputBuffer();
+        CublasHandleState *state = GetHandleState(handle);
+        bool device = state != nullptr && state->pointerMode == CUBLAS_POINTER_MODE_DEVICE;
+        in->Add<bool>(device);
+        if (device)
+            in->Add((uint64_t)scalar);
+        else
+            in->Add(scalar, n);
+    }
+
+    /**
+     * Adds the result of a cuBLAS reduction as an input parameter for the next
+     * execution request. In device pointer mode the backend writes it in place.
+     *
+     * @param handle the cuBLAS handle of the routine.
+     * @param result the host or device pointer to the result.
+     *
+     * @return true if the result comes back among the output parameters.
+     */
+    static inline bool AddResultForArguments(cublasHandle_t handle, const void *result) {
+        gvirtus::communicators::Buffer *in =
+            gvirtus::frontend::Frontend::GetFrontend()->GetInputBuffer();
+        CublasHandleState *state = GetHandleState(handle);
+        bool device = state != nullptr && state->pointerMode == CUBLAS_POINTER_MODE_DEVICE;
+        in->Add<bool>(device);
+        if (device) in->Add((uint64_t)result);
+        return !device;
+    }
+
     /**
      * Adds a symbol, a named variable, as an input parameter for the next
      * execution request.
@@ -164,6 +233,11 @@ class CublasFrontend {
     static inline char *GetOutputString() {
         return gvirtus::frontend::Frontend::GetFrontend()->GetOutputBuffer()->AssignString();
     }
+    /* The state of handle, nullptr for a handle cublasCreate did not return. */
+    static CublasHandleState *GetHandleState(cublasHandle_t handle);
+    static void AddHandleState(cublasHandle_t handle);
+    static void ForgetHandleState(cublasHandle_t handle);
+
     CublasFrontend();
     static void *handler;
 };
@@ -0,0 +1,130 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CUBLASPACKING_H
+#define CUBLASPACKING_H
+
+#include <cstddef>
+#include <cstring>
+
+/*
+ * Packing of the strided host operands of cublasSetVector/GetVector and
+ * cublasSetMatrix/GetMatrix, so that only their logical elements travel to
+ * the backend, which then always sees unit strides and leading dimensions
+ * equal to the number of rows on the host side.
+ *
+ * Elements of the common sizes are moved with a copy of constant size, which
+ * the compiler turns into plain (and, for small strides, vectorized) loads and
+ * stores; matrices are moved one column at a time, or in one go when the
+ * leading dimension equals the number of rows.
+ */
+namespace cublas_packing {
+
+template <size_t S>
+inline void Gather(char *dst, const char *src, size_t n, size_t inc) {
+    for (size_t i = 0; i < n; i++) memcpy(dst + i * S, src + i * inc * S, S);
+}
+
+template <size_t S>
+inline void Scatter(char *dst, const char *src, size_t n, size_t inc) {
+    for (size_t i = 0; i < n; i++) memcpy(dst + i * inc * S, src + i * S, S);
+}
+
+/* Packs n elements of elemSize bytes, inc elements apart in src, into dst. */
+inline void GatherVector(void *dst, const void *src, size_t n, size_t elemSize, size_t inc) {
+    char *d = static_cast<char *>(dst);
+    const char *s = static_cast<const char *>(src);
+    if (inc == 1) {
+        memcpy(d, s, n * elemSize);
+        return;
+    }
+    switch (elemSize) {
+        case 2:
+            Gather<2>(d, s, n, inc);
+            break;
+        case 4:
+            Gather<4>(d, s, n, inc);
+            break;
+        case 8:
+            Gather<8>(d, s, n, inc);
+            break;
+        case 16:
+            Gather<16>(d, s, n, inc);
+            break;
+        default:
+            for (size_t i = 0; i < n; i++)
+                memcpy(d + i * elemSize, s + i * inc * elemSize, elemSize);
+    }
+}
+
+/* Unpacks the n contiguous elements of src into dst, inc elements apart. */
+inline void ScatterVector(void *dst, const void *src, size_t n, size_t elemSize, size_t inc) {
+    char *d = static_cast<char *>(dst);
+    const char *s = static_cast<const char *>(src);
+    if (inc == 1) {
+        memcpy(d, s, n * elemSize);
+        return;
+    }
+    switch (elemSize) {
+        case 2:
+            Scatter<2>(d, s, n, inc);
+            break;
+        case 4:
+            Scatter<4>(d, s, n, inc);
+            break;
+        case 8:
+            Scatter<8>(d, s, n, inc);
+            break;
+        case 16:
+            Scatter<16>(d, s, n, inc);
+            break;
+        default:
+            for (size_t i = 0; i < n; i++)
+                memcpy(d + i * inc * elemSize, s + i * elemSize, elemSize);
+    }
+}
+
+/* Packs the rows x cols column-major matrix src, of leading dimension ld. */
+inline void GatherMatrix(void *dst, const void *src, size_t rows, size_t cols, size_t elemSize,
+                         size_t ld) {
+    if (rows == 1) return GatherVector(dst, src, cols, elemSize, ld);
+    if (ld == rows) return GatherVector(dst, src, rows * cols, elemSize, 1);
+    size_t column = rows * elemSize;
+    for (size_t j = 0; j < cols; j++)
+        memcpy(static_cast<char *>(dst) + j * column,
+               static_cast<const char *>(src) + j * ld * elemSize, column);
+}
+
+/* Unpacks the packed rows x cols matrix src into dst, of leading dimension ld. */
+inline void ScatterMatrix(void *dst, const void *src, size_t rows, size_t cols, size_t elemSize,
+                          size_t ld) {
+    if (rows == 1) return ScatterVector(dst, src, cols, elemSize, ld);
+    if (ld == rows) return ScatterVector(dst, src, rows * cols, elemSize, 1);
+    size_t column = rows * elemSize;
+    for (size_t j = 0; j < cols; j++)
+        memcpy(static_cast<char *>(dst) + j * ld * elemSize,
+               static_cast<const char *>(src) + j * column, column);
+}
+
+}  // namespace cublas_packing
+
+#endif /* CUBLASPACKING_H */
@@ -8,8 +8,7 @@
 
 using namespace std;
 
-// TODO: this only suppors the version where alpha, beta are float32 host
-// pointers
+// TODO: this only supports alpha, beta of type float32
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasGemmEx(
     cublasHandle_t handle, cublasOperation_t transa, cublasOperation_t transb, int m, int n, int k,
     const void *alpha, const void *A, cudaDataType_t Atype, int lda, const void *B,
@@ -22,14 +21,14 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasGemmEx(
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    CublasFrontend::AddHostPointerForArguments<const float>((float *)alpha);
+    CublasFrontend::AddScalarForArguments(handle, (const float *)alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<cudaDataType_t>(Atype);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<cudaDataType_t>(Btype);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-    CublasFrontend::AddHostPointerForArguments<const float>((float *)beta);
+    CublasFrontend::AddScalarForArguments(handle, (const float *)beta);
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<cudaDataType_t>(Ctype);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -52,7 +51,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasGemmStridedBatchedEx(
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    CublasFrontend::AddHostPointerForArguments<const float>((float *)alpha);
+    CublasFrontend::AddScalarForArguments(handle, (const float *)alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<cudaDataType_t>(Atype);
     CublasFrontend::AddVariableForArguments<int>(lda);
@@ -61,7 +60,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasGemmStridedBatchedEx(
     CublasFrontend::AddVariableForArguments<cudaDataType_t>(Btype);
     CublasFrontend::AddVariableForArguments<int>(ldb);
     CublasFrontend::AddVariableForArguments<long long int>(strideB);
-    CublasFrontend::AddHostPointerForArguments<const float>((float *)beta);
+    CublasFrontend::AddScalarForArguments(handle, (const float *)beta);
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<cudaDataType_t>(Ctype);
     CublasFrontend::AddVariableForArguments<int>(ldc);
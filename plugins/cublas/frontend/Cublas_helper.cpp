@@ -28,14 +28,27 @@
  *             School of Computer Science, University College Dublin
  */
 
+#include <gvirtus/frontend/LocalTier.h>
+
+#include <algorithm>
+#include <string>
+
 #include "CublasFrontend.h"
+#include "CublasPacking.h"
+#include "CublasStatusNames.h"
 
 using namespace std;
 
+using gvirtus::frontend::FindEnumName;
+using gvirtus::frontend::LocalCache;
+
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCreate_v2(cublasHandle_t *handle) {
     CublasFrontend::Prepare();
     CublasFrontend::Execute("cublasCreate_v2");
-    if (CublasFrontend::Success()) *handle = CublasFrontend::GetOutputVariable<cublasHandle_t>();
+    if (CublasFrontend::Success()) {
+        *handle = CublasFrontend::GetOutputVariable<cublasHandle_t>();
+        CublasFrontend::AddHandleState(*handle);
+    }
     // *handle =
     // reinterpret_cast<cublasHandle_t>(CublasFrontend::GetOutputDevicePointer());
     // // equivalent *handle =
@@ -45,18 +58,21 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCreate_v2(cublasHandle_t
     return CublasFrontend::GetExitCode();
 }
 
+/* The host operands of the four routines below travel packed: only their
+ * logical elements are sent, and the strides on the host side are resolved
+ * here (see CublasPacking.h).
+ */
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSetVector(int n, int elemSize, const void *x,
                                                                  int incx, void *y, int incy) {
+    if (elemSize <= 0 || incx <= 0 || incy <= 0) return CUBLAS_STATUS_INVALID_VALUE;
+    size_t count = n > 0 ? n : 0;
     CublasFrontend::Prepare();
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(elemSize);
-    // CublasFrontend::AddHostPointerForArguments(x,sizeof(x));
-
-    CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddVariableForArguments<int>(incy);
     CublasFrontend::AddDevicePointerForArguments(y);
-    CublasFrontend::AddHostPointerForArguments<char>(static_cast<char *>(const_cast<void *>(x)),
-                                                     n * elemSize);
+    char *packed = CublasFrontend::DelegateHostPointerForArguments<char>(count * elemSize);
+    cublas_packing::GatherVector(packed, x, count, elemSize, incx);
     CublasFrontend::Execute("cublasSetVector");
     return CublasFrontend::GetExitCode();
 }
@@ -64,6 +80,9 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSetVector(int n, int elem
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSetMatrix(int rows, int cols, int elemSize,
                                                                  const void *A, int lda, void *B,
                                                                  int ldb) {
+    if (rows < 0 || cols < 0 || elemSize <= 0 || lda < std::max(1, rows) ||
+        ldb < std::max(1, rows))
+        return CUBLAS_STATUS_INVALID_VALUE;
     CublasFrontend::Prepare();
 
     CublasFrontend::AddVariableForArguments<int>(rows);
@@ -71,9 +90,9 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSetMatrix(int rows, int c
     CublasFrontend::AddVariableForArguments<int>(elemSize);
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-    CublasFrontend::AddVariableForArguments<int>(lda);
-    CublasFrontend::AddHostPointerForArguments<char>(static_cast<char *>(const_cast<void *>(A)),
-                                                     rows * cols * elemSize);
+    char *packed =
+        CublasFrontend::DelegateHostPointerForArguments<char>((size_t)rows * cols * elemSize);
+    cublas_packing::GatherMatrix(packed, A, rows, cols, elemSize, lda);
     CublasFrontend::Execute("cublasSetMatrix");
     return CublasFrontend::GetExitCode();
 }
@@ -85,21 +104,20 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSetMatrix(int rows, int c
  */
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasGetVector(int n, int elemSize, const void *x,
                                                                  int incx, void *y, int incy) {
+    if (elemSize <= 0 || incx <= 0 || incy <= 0) return CUBLAS_STATUS_INVALID_VALUE;
+    size_t count = n > 0 ? n : 0;
     CublasFrontend::Prepare();
 
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(elemSize);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddVariableForArguments<int>(incy);
-
-    // void * _x = const_cast<void *>(x);
     CublasFrontend::AddDevicePointerForArguments(x);
-    CublasFrontend::AddHostPointerForArguments<void>(y);
 
     CublasFrontend::Execute("cublasGetVector");
 
-    if (CublasFrontend::Success()) {
-        memmove(y, CublasFrontend::GetOutputHostPointer<char>(n * elemSize), n * elemSize);
+    if (CublasFrontend::Success() && count > 0) {
+        const char *packed = CublasFrontend::GetOutputHostPointer<char>(count * elemSize);
+        cublas_packing::ScatterVector(y, packed, count, elemSize, incy);
     }
     return CublasFrontend::GetExitCode();
 }
@@ -107,6 +125,10 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasGetVector(int n, int elem
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasGetMatrix(int rows, int cols, int elemSize,
                                                                  const void *A, int lda, void *B,
                                                                  int ldb) {
+    if (rows < 0 || cols < 0 || elemSize <= 0 || lda < std::max(1, rows) ||
+        ldb < std::max(1, rows))
+        return CUBLAS_STATUS_INVALID_VALUE;
+    size_t size = (size_t)rows * cols * elemSize;
     CublasFrontend::Prepare();
 
     CublasFrontend::AddVariableForArguments<int>(rows);
@@ -114,14 +136,12 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasGetMatrix(int rows, int c
     CublasFrontend::AddVariableForArguments<int>(elemSize);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
-    CublasFrontend::AddHostPointerForArguments<void>(B);
-    CublasFrontend::AddVariableForArguments<int>(ldb);
 
     CublasFrontend::Execute("cublasGetMatrix");
 
-    if (CublasFrontend::Success()) {
-        memmove(B, CublasFrontend::GetOutputHostPointer<char>(rows * cols * elemSize),
-                rows * cols * elemSize);
+    if (CublasFrontend::Success() && size > 0) {
+        const char *packed = CublasFrontend::GetOutputHostPointer<char>(size);
+        cublas_packing::ScatterMatrix(B, packed, rows, cols, elemSize, ldb);
     }
     return CublasFrontend::GetExitCode();
 }
@@ -138,55 +158,91 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDestroy_v2(cublasHandle_t
     // does not work as it tries to do sizeof cublasHandle_t which is an
     // incomplete type (opaque struct)
     CublasFrontend::Execute("cublasDestroy_v2");
+    if (CublasFrontend::Success()) CublasFrontend::ForgetHandleState(handle);
     return CublasFrontend::GetExitCode();
 }
 
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasGetVersion_v2(cublasHandle_t handle,
                                                                      int *version) {
-    CublasFrontend::Prepare();
-    CublasFrontend::Execute("cublasGetVersion_v2");
-    if (CublasFrontend::Success()) *version = CublasFrontend::GetOutputVariable<int>();
-    return CublasFrontend::GetExitCode();
+    // the version of the backend's cuBLAS, asked once per process
+    static LocalCache<int, int> versions;
+    cublasStatus_t exit_code = CUBLAS_STATUS_SUCCESS;
+    const int *cached = versions.Get(0, [&](int *value) {
+        CublasFrontend::Prepare();
+        CublasFrontend::Execute("cublasGetVersion_v2");
+        exit_code = CublasFrontend::GetExitCode();
+        if (!CublasFrontend::Success()) return false;
+        *value = CublasFrontend::GetOutputVariable<int>();
+        return true;
+    });
+    if (cached != nullptr) *version = *cached;
+    return exit_code;
+}
+
+extern "C" CUBLASAPI const char *CUBLASWINAPI cublasGetStatusName(cublasStatus_t status) {
+    const char *name = FindEnumName(CUBLAS_STATUS_NAMES, status);
+    return name != nullptr ? name : "CUBLAS_STATUS_UNKNOWN";
+}
+
+extern "C" CUBLASAPI const char *CUBLASWINAPI cublasGetStatusString(cublasStatus_t status) {
+    static LocalCache<int, string> strings;
+    const string *s = strings.Get(status, [status](string *value) {
+        CublasFrontend::Prepare();
+        CublasFrontend::AddVariableForArguments<cublasStatus_t>(status);
+        CublasFrontend::Execute("cublasGetStatusString");
+        if (!CublasFrontend::Success()) return false;
+        *value = CublasFrontend::GetOutputString();
+        return true;
+    });
+    return s != nullptr ? s->c_str() : "unknown error";
 }
 
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSetStream_v2(cublasHandle_t handle,
                                                                     cudaStream_t streamId) {
+    // Setting the stream also resets the workspace, so it is only a no-op
+    // while no workspace has been set
+    CublasHandleState *state = CublasFrontend::GetHandleState(handle);
+    if (state == nullptr) return CUBLAS_STATUS_NOT_INITIALIZED;
+    if (state->stream == streamId && !state->workspaceSet) return CUBLAS_STATUS_SUCCESS;
     CublasFrontend::Prepare();
 
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<long long int>((long long int)streamId);
     CublasFrontend::Execute("cublasSetStream_v2");
+    if (CublasFrontend::Success()) {
+        state->stream = streamId;
+        state->workspaceSet = false;
+    }
     return CublasFrontend::GetExitCode();
 }
 
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasGetStream_v2(cublasHandle_t handle,
                                                                     cudaStream_t *streamId) {
-    CublasFrontend::Prepare();
-
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
-    CublasFrontend::Execute("cublasGetStream_v2");
-    if (CublasFrontend::Success())
-        *streamId = (cudaStream_t)CublasFrontend::GetOutputVariable<long long int>();
-    return CublasFrontend::GetExitCode();
+    CublasHandleState *state = CublasFrontend::GetHandleState(handle);
+    if (state == nullptr) return CUBLAS_STATUS_NOT_INITIALIZED;
+    *streamId = state->stream;
+    return CUBLAS_STATUS_SUCCESS;
 }
 
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI
 cublasGetPointerMode_v2(cublasHandle_t handle, cublasPointerMode_t *mode) {
-    CublasFrontend::Prepare();
-
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
-    CublasFrontend::Execute("cublasGetPointerMode_v2");
-    if (CublasFrontend::Success()) *mode = CublasFrontend::GetOutputVariable<cublasPointerMode_t>();
-    return CublasFrontend::GetExitCode();
+    CublasHandleState *state = CublasFrontend::GetHandleState(handle);
+    if (state == nullptr) return CUBLAS_STATUS_NOT_INITIALIZED;
+    *mode = state->pointerMode;
+    return CUBLAS_STATUS_SUCCESS;
 }
 
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSetPointerMode_v2(cublasHandle_t handle,
                                                                          cublasPointerMode_t mode) {
+    CublasHandleState *state = CublasFrontend::GetHandleState(handle);
+    if (state == nullptr) return CUBLAS_STATUS_NOT_INITIALIZED;
+    if (state->pointerMode == mode) return CUBLAS_STATUS_SUCCESS;
     CublasFrontend::Prepare();
 
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasPointerMode_t>(mode);
     CublasFrontend::Execute("cublasSetPointerMode_v2");
+    if (CublasFrontend::Success()) state->pointerMode = mode;
     return CublasFrontend::GetExitCode();
 }
 
@@ -201,20 +257,23 @@ cublasStrsmBatched(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_
 
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSetMathMode(cublasHandle_t handle,
                                                                    cublasMath_t mode) {
+    CublasHandleState *state = CublasFrontend::GetHandleState(handle);
+    if (state == nullptr) return CUBLAS_STATUS_NOT_INITIALIZED;
+    if (state->mathMode == mode) return CUBLAS_STATUS_SUCCESS;
     CublasFrontend::Prepare();
     CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<cublasMath_t>(mode);
     CublasFrontend::Execute("cublasSetMathMode");
+    if (CublasFrontend::Success()) state->mathMode = mode;
     return CublasFrontend::GetExitCode();
 }
 
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasGetMathMode(cublasHandle_t handle,
                                                                    cublasMath_t *mode) {
-    CublasFrontend::Prepare();
-    CublasFrontend::AddDevicePointerForArguments(handle);
-    CublasFrontend::Execute("cublasGetMathMode");
-    if (CublasFrontend::Success()) *mode = CublasFrontend::GetOutputVariable<cublasMath_t>();
-    return CublasFrontend::GetExitCode();
+    CublasHandleState *state = CublasFrontend::GetHandleState(handle);
+    if (state == nullptr) return CUBLAS_STATUS_NOT_INITIALIZED;
+    *mode = state->mathMode;
+    return CUBLAS_STATUS_SUCCESS;
 }
 
 // TODO:
@@ -272,14 +331,14 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCgemmStridedBatched(
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    CublasFrontend::AddHostPointerForArguments<const cuComplex>(alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddHostPointerForArguments<const cuComplex>(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddVariableForArguments<long long int>(strideA);
     CublasFrontend::AddHostPointerForArguments<const cuComplex>(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
     CublasFrontend::AddVariableForArguments<long long int>(strideB);
-    CublasFrontend::AddHostPointerForArguments<const cuComplex>(beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddHostPointerForArguments<cuComplex>(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
     CublasFrontend::AddVariableForArguments<long long int>(strideC);
@@ -350,7 +409,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDtrsmBatched(
     CublasFrontend::AddVariableForArguments<cublasDiagType_t>(diag);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<const double>(alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);  // Array of pointers to matrices A
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(B);  // Array of pointers to matrices B
@@ -388,11 +447,21 @@ cublasCgelsBatched(cublasHandle_t handle, cublasOperation_t trans, int m, int n,
 
 extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI
 cublasSetWorkspace_v2(cublasHandle_t handle, void *workspace, size_t workspaceSizeInBytes) {
+    CublasHandleState *state = CublasFrontend::GetHandleState(handle);
+    if (state == nullptr) return CUBLAS_STATUS_NOT_INITIALIZED;
+    if (state->workspaceSet && state->workspace == workspace &&
+        state->workspaceSize == workspaceSizeInBytes)
+        return CUBLAS_STATUS_SUCCESS;
     CublasFrontend::Prepare();
     CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddDevicePointerForArguments(workspace);
     CublasFrontend::AddVariableForArguments<size_t>(workspaceSizeInBytes);
     CublasFrontend::Execute("cublasSetWorkspace_v2");
+    if (CublasFrontend::Success()) {
+        state->workspace = workspace;
+        state->workspaceSize = workspaceSizeInBytes;
+        state->workspaceSet = true;
+    }
     return CublasFrontend::GetExitCode();
 }
 
@@ -472,7 +541,7 @@ cublasZtrsmBatched(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_
     CublasFrontend::AddVariableForArguments<cublasDiagType_t>(diag);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<const cuDoubleComplex>(alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);  // Array of pointers to matrices A
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(B);  // Array of pointers to matrices B
@@ -516,14 +585,14 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDgemmStridedBatched(
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    CublasFrontend::AddHostPointerForArguments<const double>(alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddHostPointerForArguments<const double>(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddVariableForArguments<long long int>(strideA);
     CublasFrontend::AddHostPointerForArguments<const double>(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
     CublasFrontend::AddVariableForArguments<long long int>(strideB);
-    CublasFrontend::AddHostPointerForArguments<const double>(beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddHostPointerForArguments<double>(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
     CublasFrontend::AddVariableForArguments<long long int>(strideC);
@@ -600,14 +669,14 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSgemmEx(
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    CublasFrontend::AddHostPointerForArguments<const float>(alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<cudaDataType_t>(Atype);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<cudaDataType_t>(Btype);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-    CublasFrontend::AddHostPointerForArguments<const float>(beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<cudaDataType_t>(Ctype);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -629,14 +698,14 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZgemmStridedBatched(
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    CublasFrontend::AddHostPointerForArguments<const cuDoubleComplex>(alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddHostPointerForArguments<const cuDoubleComplex>(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddVariableForArguments<long long int>(strideA);
     CublasFrontend::AddHostPointerForArguments<const cuDoubleComplex>(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
     CublasFrontend::AddVariableForArguments<long long int>(strideB);
-    CublasFrontend::AddHostPointerForArguments<const cuDoubleComplex>(beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddHostPointerForArguments<cuDoubleComplex>(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
     CublasFrontend::AddVariableForArguments<long long int>(strideC);
@@ -698,7 +767,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCtrsmBatched(
     CublasFrontend::AddVariableForArguments<cublasDiagType_t>(diag);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<const cuComplex>(alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);  // Array of pointers to matrices A
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(B);  // Array of pointers to matrices B
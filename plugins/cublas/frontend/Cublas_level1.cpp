@@ -41,9 +41,11 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSdot_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
-    CublasFrontend::Execute("cublasSdot_v2");
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
-    if (CublasFrontend::Success) *result = CublasFrontend::GetOutputVariable<float>();
+    CublasFrontend::Execute("cublasSdot_v2");
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<float>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -59,10 +61,11 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDdot_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasDdot_v2");
-    if (CublasFrontend::Success) *result = CublasFrontend::GetOutputVariable<double>();
-
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<double>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -72,16 +75,17 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCdotu_v2(cublasHandle_t h
                                                                 cuComplex *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
-    CublasFrontend::AddHostPointerForArguments<cuComplex>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasCdotu_v2");
-
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<cuComplex>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -91,16 +95,17 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCdotc_v2(cublasHandle_t h
                                                                 cuComplex *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
-    CublasFrontend::AddHostPointerForArguments<cuComplex>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasCdotc_v2");
-
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<cuComplex>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -110,16 +115,17 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZdotu_v2(cublasHandle_t h
                                                                 cuDoubleComplex *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
-    CublasFrontend::AddHostPointerForArguments<cuDoubleComplex>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasZdotu_v2");
-
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<cuDoubleComplex>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -129,16 +135,17 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZdotc_v2(cublasHandle_t h
                                                                 cuDoubleComplex *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
-    CublasFrontend::AddHostPointerForArguments<cuDoubleComplex>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasZdotc_v2");
-
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<cuDoubleComplex>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -148,7 +155,7 @@ cublasSscal_v2(cublasHandle_t handle, int n, const float *alpha, /* host or devi
     CublasFrontend::Prepare();
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<float>((float *)alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     // CublasFrontend::AddDevicePointerForArguments(alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments(incx);
@@ -162,7 +169,7 @@ cublasDscal_v2(cublasHandle_t handle, int n, const double *alpha, /* host or dev
     CublasFrontend::Prepare();
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<double>((double *)alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     // CublasFrontend::AddDevicePointerForArguments(alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments(incx);
@@ -176,7 +183,7 @@ cublasCscal_v2(cublasHandle_t handle, int n, const cuComplex *alpha, /* host or
     CublasFrontend::Prepare();
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<cuComplex>((cuComplex *)alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     // CublasFrontend::AddDevicePointerForArguments(alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments(incx);
@@ -190,7 +197,7 @@ cublasCsscal_v2(cublasHandle_t handle, int n, const float *alpha, /* host or dev
     CublasFrontend::Prepare();
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<float>((float *)alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     // CublasFrontend::AddDevicePointerForArguments(alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments(incx);
@@ -204,7 +211,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZscal_v2(
     CublasFrontend::Prepare();
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<cuDoubleComplex>((cuDoubleComplex *)alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     // CublasFrontend::AddDevicePointerForArguments(alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments(incx);
@@ -218,7 +225,7 @@ cublasZdscal_v2(cublasHandle_t handle, int n, const double *alpha, /* host or de
     CublasFrontend::Prepare();
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<double>((double *)alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     // CublasFrontend::AddDevicePointerForArguments(alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments(incx);
@@ -232,7 +239,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSaxpy_v2(cublasHandle_t h
     CublasFrontend::Prepare();
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<float>((float *)alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -250,7 +257,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDaxpy_v2(cublasHandle_t h
     CublasFrontend::Prepare();
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<double>((double *)alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -268,7 +275,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCaxpy_v2(cublasHandle_t h
     CublasFrontend::Prepare();
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<cuComplex>((cuComplex *)alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -286,7 +293,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZaxpy_v2(cublasHandle_t h
     CublasFrontend::Prepare();
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<cuDoubleComplex>((cuDoubleComplex *)alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -422,14 +429,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasIsamax_v2(cublasHandle_t
                                                                  int *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<int>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasIsamax_v2");
-    if (CublasFrontend::Success()) result = CublasFrontend::GetOutputHostPointer<int>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<int>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -438,14 +446,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasIdamax_v2(cublasHandle_t
                                                                  int *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<int>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasIdamax_v2");
-    if (CublasFrontend::Success()) result = CublasFrontend::GetOutputHostPointer<int>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<int>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -454,14 +463,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasIcamax_v2(cublasHandle_t
                                                                  int *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<int>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasIcamax_v2");
-    if (CublasFrontend::Success()) result = CublasFrontend::GetOutputHostPointer<int>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<int>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -470,14 +480,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasIzamax_v2(cublasHandle_t
                                                                  int *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<int>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasIzamax_v2");
-    if (CublasFrontend::Success()) result = CublasFrontend::GetOutputHostPointer<int>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<int>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -486,14 +497,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasIsamin_v2(cublasHandle_t
                                                                  int *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<int>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasIsamin_v2");
-    if (CublasFrontend::Success()) result = CublasFrontend::GetOutputHostPointer<int>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<int>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -502,14 +514,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasIdamin_v2(cublasHandle_t
                                                                  int *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<int>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasIdamin_v2");
-    if (CublasFrontend::Success()) result = CublasFrontend::GetOutputHostPointer<int>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<int>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -518,14 +531,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasIcamin_v2(cublasHandle_t
                                                                  int *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<int>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasIcamin_v2");
-    if (CublasFrontend::Success()) result = CublasFrontend::GetOutputHostPointer<int>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<int>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -534,14 +548,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasIzamin_v2(cublasHandle_t
                                                                  int *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<int>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasIzamin_v2");
-    if (CublasFrontend::Success()) result = CublasFrontend::GetOutputHostPointer<int>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<int>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -550,14 +565,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSasum_v2(cublasHandle_t h
                                                                 float *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<float>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasSasum_v2");
-    if (CublasFrontend::Success()) result = CublasFrontend::GetOutputHostPointer<float>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<float>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -566,14 +582,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDasum_v2(cublasHandle_t h
                                                                 double *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<double>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasDasum_v2");
-    if (CublasFrontend::Success()) result = CublasFrontend::GetOutputHostPointer<double>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<double>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -582,14 +599,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasScasum_v2(cublasHandle_t
                                                                  float *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<float>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasScasum_v2");
-    if (CublasFrontend::Success()) result = CublasFrontend::GetOutputHostPointer<float>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<float>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -598,14 +616,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDzasum_v2(cublasHandle_t
                                                                  double *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<double>(result);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasDzasum_v2");
-    if (CublasFrontend::Success()) result = CublasFrontend::GetOutputHostPointer<double>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<double>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -621,8 +640,8 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSrot_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
-    CublasFrontend::AddHostPointerForArguments<float>((float *)c);
-    CublasFrontend::AddHostPointerForArguments<float>((float *)s);
+    CublasFrontend::AddScalarForArguments(handle, c);
+    CublasFrontend::AddScalarForArguments(handle, s);
 
     CublasFrontend::Execute("cublasSrot_v2");
     return CublasFrontend::GetExitCode();
@@ -640,8 +659,8 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDrot_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
-    CublasFrontend::AddHostPointerForArguments<double>((double *)c);
-    CublasFrontend::AddHostPointerForArguments<double>((double *)s);
+    CublasFrontend::AddScalarForArguments(handle, c);
+    CublasFrontend::AddScalarForArguments(handle, s);
 
     CublasFrontend::Execute("cublasDrot_v2");
     return CublasFrontend::GetExitCode();
@@ -659,8 +678,8 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCrot_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
-    CublasFrontend::AddHostPointerForArguments<float>((float *)c);
-    CublasFrontend::AddHostPointerForArguments<cuComplex>((cuComplex *)s);
+    CublasFrontend::AddScalarForArguments(handle, c);
+    CublasFrontend::AddScalarForArguments(handle, s);
 
     CublasFrontend::Execute("cublasCrot_v2");
     return CublasFrontend::GetExitCode();
@@ -678,8 +697,8 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCsrot_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
-    CublasFrontend::AddHostPointerForArguments<float>((float *)c);
-    CublasFrontend::AddHostPointerForArguments<float>((float *)s);
+    CublasFrontend::AddScalarForArguments(handle, c);
+    CublasFrontend::AddScalarForArguments(handle, s);
 
     CublasFrontend::Execute("cublasCsrot_v2");
     return CublasFrontend::GetExitCode();
@@ -698,8 +717,8 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZrot_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
-    CublasFrontend::AddHostPointerForArguments<double>((double *)c);
-    CublasFrontend::AddHostPointerForArguments<cuDoubleComplex>((cuDoubleComplex *)s);
+    CublasFrontend::AddScalarForArguments(handle, c);
+    CublasFrontend::AddScalarForArguments(handle, s);
 
     CublasFrontend::Execute("cublasZrot_v2");
     return CublasFrontend::GetExitCode();
@@ -717,8 +736,8 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZdrot_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
-    CublasFrontend::AddHostPointerForArguments<double>((double *)c);
-    CublasFrontend::AddHostPointerForArguments<double>((double *)s);
+    CublasFrontend::AddScalarForArguments(handle, c);
+    CublasFrontend::AddScalarForArguments(handle, s);
 
     CublasFrontend::Execute("cublasZdrot_v2");
     return CublasFrontend::GetExitCode();
@@ -794,7 +813,8 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSrotm_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
-    CublasFrontend::AddHostPointerForArguments<float>((float *)param);
+    // the flag and the four entries of H
+    CublasFrontend::AddScalarForArguments(handle, param, 5);
 
     CublasFrontend::Execute("cublasSrotm_v2");
     return CublasFrontend::GetExitCode();
@@ -811,7 +831,8 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDrotm_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
-    CublasFrontend::AddHostPointerForArguments<double>((double *)param);
+    // the flag and the four entries of H
+    CublasFrontend::AddScalarForArguments(handle, param, 5);
 
     CublasFrontend::Execute("cublasDrotm_v2");
     return CublasFrontend::GetExitCode();
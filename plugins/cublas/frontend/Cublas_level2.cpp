@@ -35,12 +35,12 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSgemv_v2(
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<const float>(alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<const float>(beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
     CublasFrontend::Execute("cublasSgemv_v2");
@@ -55,12 +55,12 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDgemv_v2(
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-    CublasFrontend::AddHostPointerForArguments<const double>(alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    CublasFrontend::AddHostPointerForArguments<const double>(beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
     CublasFrontend::Execute("cublasDgemv_v2");
@@ -76,15 +76,12 @@ cublasCgemv_v2(cublasHandle_t handle, cublasOperation_t trans, int m, int n, con
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-
-    cuComplex *_beta = const_cast<cuComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
     CublasFrontend::Execute("cublasCgemv_v2");
@@ -101,15 +98,12 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZgemv_v2(
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-
-    cuDoubleComplex *_beta = const_cast<cuDoubleComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
     CublasFrontend::Execute("cublasZgemv_v2");
@@ -129,14 +123,12 @@ cublasSgbmv_v2(cublasHandle_t handle, cublasOperation_t trans, int m, int n, int
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(kl);
     CublasFrontend::AddVariableForArguments<int>(ku);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    float *_beta = const_cast<float *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -156,14 +148,12 @@ cublasDgbmv_v2(cublasHandle_t handle, cublasOperation_t trans, int m, int n, int
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(kl);
     CublasFrontend::AddVariableForArguments<int>(ku);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    double *_beta = const_cast<double *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -183,14 +173,12 @@ cublasCgbmv_v2(cublasHandle_t handle, cublasOperation_t trans, int m, int n, int
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(kl);
     CublasFrontend::AddVariableForArguments<int>(ku);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    cuComplex *_beta = const_cast<cuComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -210,14 +198,12 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZgbmv_v2(
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(kl);
     CublasFrontend::AddVariableForArguments<int>(ku);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    cuDoubleComplex *_beta = const_cast<cuDoubleComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -689,14 +675,12 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSsymv_v2(
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    float *_beta = const_cast<float *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -712,14 +696,12 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDsymv_v2(
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    double *_beta = const_cast<double *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -735,14 +717,12 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCsymv_v2(
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    cuComplex *_beta = const_cast<cuComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -759,14 +739,12 @@ cublasZsymv_v2(cublasHandle_t handle, cublasFillMode_t uplo, int n, const cuDoub
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    cuDoubleComplex *_beta = const_cast<cuDoubleComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -782,14 +760,12 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasChemv_v2(
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    cuComplex *_beta = const_cast<cuComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -806,14 +782,12 @@ cublasZhemv_v2(cublasHandle_t handle, cublasFillMode_t uplo, int n, const cuDoub
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    cuDoubleComplex *_beta = const_cast<cuDoubleComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -830,14 +804,12 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSsbmv_v2(
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    float *_beta = const_cast<float *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -854,14 +826,12 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDsbmv_v2(
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    double *_beta = const_cast<double *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -879,14 +849,12 @@ cublasChbmv_v2(cublasHandle_t handle, cublasFillMode_t uplo, int n, int k, const
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    cuComplex *_beta = const_cast<cuComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -904,14 +872,12 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZhbmv_v2(
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-    cuDoubleComplex *_beta = const_cast<cuDoubleComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -927,15 +893,12 @@ cublasSspmv_v2(cublasHandle_t handle, cublasFillMode_t uplo, int n, const float
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
 
     CublasFrontend::AddDevicePointerForArguments(AP);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-
-    float *_beta = const_cast<float *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -951,15 +914,12 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDspmv_v2(
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
 
     CublasFrontend::AddDevicePointerForArguments(AP);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-
-    double *_beta = const_cast<double *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -976,15 +936,12 @@ cublasChpmv_v2(cublasHandle_t handle, cublasFillMode_t uplo, int n, const cuComp
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
 
     CublasFrontend::AddDevicePointerForArguments(AP);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-
-    cuComplex *_beta = const_cast<cuComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -1001,15 +958,12 @@ cublasZhpmv_v2(cublasHandle_t handle, cublasFillMode_t uplo, int n, const cuDoub
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
 
     CublasFrontend::AddDevicePointerForArguments(AP);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
-
-    cuDoubleComplex *_beta = const_cast<cuDoubleComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(y);
     CublasFrontend::AddVariableForArguments<int>(incy);
 
@@ -1025,8 +979,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSger_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1046,8 +999,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDger_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1068,8 +1020,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCgeru_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1090,8 +1041,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCgerc_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1112,8 +1062,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZgeru_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1134,8 +1083,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZgerc_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1156,8 +1104,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSsyr_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(A);
@@ -1176,8 +1123,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDsyr_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(A);
@@ -1197,8 +1143,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCsyr_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(A);
@@ -1218,8 +1163,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZsyr_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(A);
@@ -1239,8 +1183,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCher_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(A);
@@ -1260,8 +1203,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZher_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(A);
@@ -1280,8 +1222,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSspr_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(AP);
@@ -1299,8 +1240,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDspr_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(AP);
@@ -1319,8 +1259,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasChpr_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(AP);
@@ -1339,8 +1278,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZhpr_v2(cublasHandle_t ha
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(AP);
@@ -1359,8 +1297,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSsyr2_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1380,8 +1317,7 @@ cublasDsyr2_v2(cublasHandle_t handle, cublasFillMode_t uplo, int n, const double
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1401,8 +1337,7 @@ cublasCsyr2_v2(cublasHandle_t handle, cublasFillMode_t uplo, int n, const cuComp
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1425,8 +1360,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZsyr2_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1446,8 +1380,7 @@ cublasCher2_v2(cublasHandle_t handle, cublasFillMode_t uplo, int n, const cuComp
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1470,8 +1403,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZher2_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1493,8 +1425,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSspr2_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1513,8 +1444,7 @@ cublasDspr2_v2(cublasHandle_t handle, cublasFillMode_t uplo, int n, const double
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1533,8 +1463,7 @@ cublasChpr2_v2(cublasHandle_t handle, cublasFillMode_t uplo, int n, const cuComp
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
@@ -1553,8 +1482,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZhpr2_v2(
     CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(n);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
     CublasFrontend::AddDevicePointerForArguments(y);
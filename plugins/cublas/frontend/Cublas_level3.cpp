@@ -36,11 +36,6 @@ cublasSgemm_v2(cublasHandle_t handle, cublasOperation_t transa, cublasOperation_
                const float *A, int lda, const float *B, int ldb,
                const float *beta, /* host or device pointer */
                float *C, int ldc) {
-    // TODO: For now, it only works if alpha, beta are host pointers.
-    // If they are device pointers, we need to add a check in the frontend to handle them correctly.
-    // If the function cublasSetPointerMode is called with CUBLAS_POINTER_MODE_DEVICE,
-    // then alpha and beta should be device pointers, otherwise they should be host pointers.
-    // We need to keep track of the pointer mode in the frontend and handle it accordingly.
     CublasFrontend::Prepare();
     CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(transa);
@@ -48,12 +43,12 @@ cublasSgemm_v2(cublasHandle_t handle, cublasOperation_t transa, cublasOperation_
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    CublasFrontend::AddHostPointerForArguments<const float>(alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-    CublasFrontend::AddHostPointerForArguments<const float>(beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
     CublasFrontend::Execute("cublasSgemm_v2");
@@ -71,16 +66,13 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSgemmBatched(
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
 
     CublasFrontend::AddDevicePointerForArguments(Aarray);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(Barray);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    float *_beta = const_cast<float *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(Carray);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -104,12 +96,12 @@ cublasDgemm_v2(cublasHandle_t handle, cublasOperation_t transa, cublasOperation_
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    CublasFrontend::AddHostPointerForArguments<const double>(alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-    CublasFrontend::AddHostPointerForArguments<const double>(beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
 
@@ -128,16 +120,13 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDgemmBatched(
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
 
     CublasFrontend::AddDevicePointerForArguments(Aarray);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(Barray);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    double *_beta = const_cast<double *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(Carray);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -160,15 +149,13 @@ cublasCgemm_v2(cublasHandle_t handle, cublasOperation_t transa, cublasOperation_
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
 
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-    cuComplex *_beta = const_cast<cuComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -190,16 +177,13 @@ cublasCgemmBatched(cublasHandle_t handle, cublasOperation_t transa, cublasOperat
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
 
     CublasFrontend::AddDevicePointerForArguments(Aarray);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(Barray);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    cuComplex *_beta = const_cast<cuComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(Carray);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -222,15 +206,13 @@ cublasZgemm_v2(cublasHandle_t handle, cublasOperation_t transa, cublasOperation_
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
 
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-    cuDoubleComplex *_beta = const_cast<cuDoubleComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -252,16 +234,13 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZgemmBatched(
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
 
     CublasFrontend::AddDevicePointerForArguments(Aarray);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddDevicePointerForArguments(Barray);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    cuDoubleComplex *_beta = const_cast<cuDoubleComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(Carray);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -281,9 +260,11 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSnrm2_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasSnrm2_v2");
-    if (CublasFrontend::Success()) *result = CublasFrontend::GetOutputVariable<float>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<float>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -296,9 +277,11 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDnrm2_v2(cublasHandle_t h
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasDnrm2_v2");
-    if (CublasFrontend::Success()) *result = CublasFrontend::GetOutputVariable<double>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<double>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -307,13 +290,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasScnrm2_v2(cublasHandle_t
                                                                  float *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasScnrm2_v2");
-    if (CublasFrontend::Success()) *result = CublasFrontend::GetOutputVariable<float>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<float>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -322,13 +307,15 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDznrm2_v2(cublasHandle_t
                                                                  double *result) {
     CublasFrontend::Prepare();
 
-    CublasFrontend::AddVariableForArguments<long long int>((long long int)handle);
+    CublasFrontend::AddDevicePointerForArguments(handle);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddDevicePointerForArguments(x);
     CublasFrontend::AddVariableForArguments<int>(incx);
+    bool host_result = CublasFrontend::AddResultForArguments(handle, result);
 
     CublasFrontend::Execute("cublasDznrm2_v2");
-    if (CublasFrontend::Success()) *result = CublasFrontend::GetOutputVariable<double>();
+    if (host_result && CublasFrontend::Success())
+        *result = CublasFrontend::GetOutputVariable<double>();
     return CublasFrontend::GetExitCode();
 }
 
@@ -342,12 +329,10 @@ cublasSsyrk_v2(cublasHandle_t handle, cublasFillMode_t uplo, cublasOperation_t t
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
-    float *_beta = const_cast<float *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
 
@@ -365,12 +350,10 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasDsyrk_v2(
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
-    double *_beta = const_cast<double *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
 
@@ -389,12 +372,10 @@ cublasCsyrk_v2(cublasHandle_t handle, cublasFillMode_t uplo, cublasOperation_t t
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
-    cuComplex *_beta = const_cast<cuComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
 
@@ -413,12 +394,10 @@ cublasZsyrk_v2(cublasHandle_t handle, cublasFillMode_t uplo, cublasOperation_t t
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
-    cuDoubleComplex *_beta = const_cast<cuDoubleComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
 
@@ -436,12 +415,10 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasCherk_v2(
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
-    float *_beta = const_cast<float *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
 
@@ -460,12 +437,10 @@ cublasZherk_v2(cublasHandle_t handle, cublasFillMode_t uplo, cublasOperation_t t
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
-    double *_beta = const_cast<double *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
 
@@ -484,17 +459,13 @@ cublasSsyr2k_v2(cublasHandle_t handle, cublasFillMode_t uplo, cublasOperation_t
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    float *_beta = const_cast<float *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -514,17 +485,13 @@ cublasDsyr2k_v2(cublasHandle_t handle, cublasFillMode_t uplo, cublasOperation_t
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    double *_beta = const_cast<double *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -544,17 +511,13 @@ cublasCsyr2k_v2(cublasHandle_t handle, cublasFillMode_t uplo, cublasOperation_t
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    cuComplex *_beta = const_cast<cuComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -574,17 +537,13 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZsyr2k_v2(
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    cuDoubleComplex *_beta = const_cast<cuDoubleComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -604,17 +563,13 @@ cublasCher2k_v2(cublasHandle_t handle, cublasFillMode_t uplo, cublasOperation_t
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    float *_beta = const_cast<float *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -634,17 +589,13 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZher2k_v2(
     CublasFrontend::AddVariableForArguments<cublasOperation_t>(trans);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    double *_beta = const_cast<double *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -664,17 +615,13 @@ cublasSsymm_v2(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t up
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    float *_beta = const_cast<float *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -694,17 +641,13 @@ cublasDsymm_v2(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t up
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    double *_beta = const_cast<double *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -724,17 +667,13 @@ cublasCsymm_v2(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t up
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    cuComplex *_beta = const_cast<cuComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -754,17 +693,13 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZsymm_v2(
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    cuDoubleComplex *_beta = const_cast<cuDoubleComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -784,17 +719,13 @@ cublasChemm_v2(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t up
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    cuComplex *_beta = const_cast<cuComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -814,17 +745,13 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZhemm_v2(
     CublasFrontend::AddVariableForArguments<cublasFillMode_t>(uplo);
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
-
-    cuDoubleComplex *_beta = const_cast<cuDoubleComplex *>(beta);
-    CublasFrontend::AddHostPointerForArguments(_beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
 
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
@@ -847,9 +774,7 @@ cublasStrsm_v2(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t up
 
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
@@ -874,9 +799,7 @@ cublasDtrsm_v2(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t up
 
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
@@ -901,9 +824,7 @@ cublasCtrsm_v2(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t up
 
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
@@ -928,9 +849,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZtrsm_v2(
 
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
@@ -955,9 +874,7 @@ cublasStrmm_v2(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t up
 
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    float *_alpha = const_cast<float *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
@@ -985,9 +902,7 @@ cublasDtrmm_v2(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t up
 
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    double *_alpha = const_cast<double *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
@@ -1015,9 +930,7 @@ cublasCtrmm_v2(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t up
 
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    cuComplex *_alpha = const_cast<cuComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
@@ -1045,9 +958,7 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasZtrmm_v2(
 
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
-
-    cuDoubleComplex *_alpha = const_cast<cuDoubleComplex *>(alpha);
-    CublasFrontend::AddHostPointerForArguments(_alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
 
@@ -1104,14 +1015,14 @@ extern "C" CUBLASAPI cublasStatus_t CUBLASWINAPI cublasSgemmStridedBatched(
     CublasFrontend::AddVariableForArguments<int>(m);
     CublasFrontend::AddVariableForArguments<int>(n);
     CublasFrontend::AddVariableForArguments<int>(k);
-    CublasFrontend::AddHostPointerForArguments<const float>(alpha);
+    CublasFrontend::AddScalarForArguments(handle, alpha);
     CublasFrontend::AddDevicePointerForArguments(A);
     CublasFrontend::AddVariableForArguments<int>(lda);
     CublasFrontend::AddVariableForArguments<long long int>(strideA);
     CublasFrontend::AddDevicePointerForArguments(B);
     CublasFrontend::AddVariableForArguments<int>(ldb);
     CublasFrontend::AddVariableForArguments<long long int>(strideB);
-    CublasFrontend::AddHostPointerForArguments<const float>(beta);
+    CublasFrontend::AddScalarForArguments(handle, beta);
     CublasFrontend::AddDevicePointerForArguments(C);
     CublasFrontend::AddVariableForArguments<int>(ldc);
     CublasFrontend::AddVariableForArguments<long long int>(strideC);
@@ -201,6 +201,10 @@ void CudaDrHandler::Initialize() {
     /*CudaDrHAndler_initialization*/
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(Init));
 
+    /*CudaDrHandler_error*/
+    mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(GetErrorString));
+    mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(GetErrorName));
+
     /*CudaDrHandler_context*/
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(CtxCreate));
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(CtxAttach));
@@ -248,6 +252,7 @@ void CudaDrHandler::Initialize() {
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(LaunchGridAsync));
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(FuncSetCacheConfig));
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(LaunchKernel));
+    mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(LaunchKernelEx));
 
     /*CudaDrHandler_memory*/
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(MemFree));
@@ -281,10 +286,10 @@ void CudaDrHandler::Initialize() {
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(ModuleGetFunction));
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(ModuleGetGlobal));
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(ModuleLoadDataEx));
-    mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(ModuleLoad));
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(ModuleLoadFatBinary));
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(ModuleUnload));
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(ModuleGetTexRef));
+    mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(ModuleImageChunk));
 
     /*CudaDrHandler_version*/
     mspHandlers->insert(CUDA_DRIVER_HANDLER_PAIR(DriverGetVersion));
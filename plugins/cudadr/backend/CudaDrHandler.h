@@ -138,6 +138,10 @@ class CudaDrHandler : public gvirtus::backend::Handler {
 /*CudaDrHandler_initialization*/
 CUDA_DRIVER_HANDLER(Init);
 
+/*CudaDrHandler_error*/
+CUDA_DRIVER_HANDLER(GetErrorString);
+CUDA_DRIVER_HANDLER(GetErrorName);
+
 /*CudaDrHandler_context*/
 CUDA_DRIVER_HANDLER(CtxCreate);
 CUDA_DRIVER_HANDLER(CtxDestroy);
@@ -181,6 +185,7 @@ CUDA_DRIVER_HANDLER(ParamSetTexRef);
 CUDA_DRIVER_HANDLER(LaunchGridAsync);
 CUDA_DRIVER_HANDLER(FuncSetCacheConfig);
 CUDA_DRIVER_HANDLER(LaunchKernel);
+CUDA_DRIVER_HANDLER(LaunchKernelEx);
 
 /*CudaDrHandler_memory*/
 CUDA_DRIVER_HANDLER(MemFree);
@@ -210,13 +215,13 @@ CUDA_DRIVER_HANDLER(MemUnmap);
 
 /*CudaDrHandler_module*/
 CUDA_DRIVER_HANDLER(ModuleLoadData);
-CUDA_DRIVER_HANDLER(ModuleLoad);
 CUDA_DRIVER_HANDLER(ModuleLoadFatBinary);
 CUDA_DRIVER_HANDLER(ModuleUnload);
 CUDA_DRIVER_HANDLER(ModuleGetFunction);
 CUDA_DRIVER_HANDLER(ModuleGetGlobal);
 CUDA_DRIVER_HANDLER(ModuleLoadDataEx);
 CUDA_DRIVER_HANDLER(ModuleGetTexRef);
+CUDA_DRIVER_HANDLER(ModuleImageChunk);
 
 /*CudaDrHandler_version*/
 CUDA_DRIVER_HANDLER(DriverGetVersion);
@@ -24,6 +24,7 @@
  */
 
 #include "CudaDrHandler.h"
+#include "CudaDrModuleCache.h"
 
 using namespace std;
 
@@ -55,6 +56,7 @@ CUDA_DRIVER_HANDLER(CtxAttach) {
 CUDA_DRIVER_HANDLER(CtxDestroy) {
     CUcontext ctx = input_buffer->Get<CUcontext>();
     CUresult exit_code = cuCtxDestroy(ctx);
+    if (exit_code == CUDA_SUCCESS) CudaDrModuleCache::GetInstance().ForgetContext(ctx);
     return std::make_shared<Result>((cudaError_t)exit_code);
 }
 
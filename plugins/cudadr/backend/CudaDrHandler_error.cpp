@@ -27,3 +27,21 @@
 
 using gvirtus::communicators::Buffer;
 using gvirtus::communicators::Result;
+
+CUDA_DRIVER_HANDLER(GetErrorString) {
+    CUresult error = input_buffer->Get<CUresult>();
+    const char *str = NULL;
+    CUresult exit_code = cuGetErrorString(error, &str);
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    if (exit_code == CUDA_SUCCESS) out->AddString(str);
+    return std::make_shared<Result>((cudaError_t)exit_code, out);
+}
+
+CUDA_DRIVER_HANDLER(GetErrorName) {
+    CUresult error = input_buffer->Get<CUresult>();
+    const char *str = NULL;
+    CUresult exit_code = cuGetErrorName(error, &str);
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    if (exit_code == CUDA_SUCCESS) out->AddString(str);
+    return std::make_shared<Result>((cudaError_t)exit_code, out);
+}
@@ -23,6 +23,8 @@
  *             Department of Applied Science
  */
 
+#include <functional>
+
 #include "CudaDrHandler.h"
 
 using gvirtus::communicators::Buffer;
@@ -151,6 +153,20 @@ CUDA_DRIVER_HANDLER(FuncSetCacheConfig) {
     return std::make_shared<Result>((cudaError_t)exit_code);
 }
 
+/*
+ * Launches with the arguments of the kernel packed by the frontend in one
+ * buffer, as laid out by cuFuncGetParamInfo or passed in extra.
+ */
+static CUresult LaunchWithArguments(Buffer *input_buffer,
+                                    const std::function<CUresult(void **)> &launch) {
+    size_t size = input_buffer->Get<size_t>();
+    void *arguments = input_buffer->Assign<char>(size);
+    if (arguments == NULL) return launch(NULL);
+    void *extra[] = {CU_LAUNCH_PARAM_BUFFER_POINTER, arguments, CU_LAUNCH_PARAM_BUFFER_SIZE,
+                     &size, CU_LAUNCH_PARAM_END};
+    return launch(extra);
+}
+
 // new functions CUDA 6.5
 CUDA_DRIVER_HANDLER(LaunchKernel) {
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "Start LaunchKernel");
@@ -163,13 +179,20 @@ CUDA_DRIVER_HANDLER(LaunchKernel) {
     unsigned int blockDimZ = input_buffer->Get<unsigned int>();
     unsigned int sharedMemBytes = input_buffer->Get<unsigned int>();
     CUstream hstream = input_buffer->Get<CUstream>();
-
-    void *kernelParams = input_buffer->Get<void *>();
-    void *extra = input_buffer->Get<void *>();
-    LOG4CPLUS_DEBUG(pThis->GetLogger(), "LaunchKernel: all parameters read");
-    CUresult exit_code =
-        cuLaunchKernel((CUfunction)f, gridDimX, gridDimY, gridDimZ, blockDimX, blockDimY, blockDimZ,
-                       sharedMemBytes, hstream, NULL, (void **)&extra);
+    CUresult exit_code = LaunchWithArguments(input_buffer.get(), [&](void **extra) {
+        return cuLaunchKernel(f, gridDimX, gridDimY, gridDimZ, blockDimX, blockDimY, blockDimZ,
+                              sharedMemBytes, hstream, NULL, extra);
+    });
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "End LaunchKernel");
     return std::make_shared<Result>((cudaError_t)exit_code);
 }
+
+CUDA_DRIVER_HANDLER(LaunchKernelEx) {
+    CUfunction f = input_buffer->Get<CUfunction>();
+    CUlaunchConfig config = input_buffer->Get<CUlaunchConfig>();
+    config.attrs = input_buffer->Assign<CUlaunchAttribute>(config.numAttrs);
+    CUresult exit_code = LaunchWithArguments(input_buffer.get(), [&](void **extra) {
+        return cuLaunchKernelEx(&config, f, NULL, extra);
+    });
+    return std::make_shared<Result>((cudaError_t)exit_code);
+}
@@ -23,23 +23,24 @@
  *             Department of Applied Science
  */
 
-#include <gvirtus/common/Decoder.h>
-
-#include <fstream>
+#include <vector>
 
 #include "CudaDrHandler.h"
+#include "CudaDrModuleCache.h"
 
 using namespace std;
 
-using gvirtus::common::Decoder;
 using gvirtus::communicators::Buffer;
 using gvirtus::communicators::Result;
 
 /*Load a module's data. */
 CUDA_DRIVER_HANDLER(ModuleLoadData) {
     CUmodule module = NULL;
-    char *image = input_buffer->AssignString();
-    CUresult exit_code = cuModuleLoadData(&module, image);
+    ModuleImageDigest digest = input_buffer->Get<ModuleImageDigest>();
+    CUresult exit_code = CudaDrModuleCache::GetInstance().Load(
+        digest, true, &module, [](CUmodule *m, const void *image) {
+            return cuModuleLoadData(m, image);
+        });
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     out->AddMarshal(module);
     return std::make_shared<Result>((cudaError_t)exit_code, out);
@@ -53,6 +54,23 @@ CUDA_DRIVER_HANDLER(ModuleGetFunction) {
     CUresult exit_code = cuModuleGetFunction(&hfunc, hmod, name);
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     out->AddMarshal(hfunc);
+    if (exit_code == CUDA_SUCCESS) {
+        /* The offset and size of each parameter, -1 parameters if unknown. */
+        vector<pair<size_t, size_t>> params;
+        CUresult result = CUDA_ERROR_NOT_SUPPORTED;
+#if CUDA_VERSION >= 12040
+        size_t offset, size;
+        while ((result = cuFuncGetParamInfo(hfunc, params.size(), &offset, &size)) ==
+               CUDA_SUCCESS)
+            params.emplace_back(offset, size);
+#endif
+        /* Asking past the last parameter is an invalid value. */
+        out->Add<int>(result == CUDA_ERROR_INVALID_VALUE ? (int)params.size() : -1);
+        for (auto &param : params) {
+            out->Add(param.first);
+            out->Add(param.second);
+        }
+    }
     return std::make_shared<Result>((cudaError_t)exit_code, out);
 }
 
@@ -74,7 +92,8 @@ CUDA_DRIVER_HANDLER(ModuleLoadDataEx) {
     CUmodule module;
     unsigned int numOptions = input_buffer->Get<unsigned int>();
     CUjit_option *options = input_buffer->AssignAll<CUjit_option>();
-    char *image = input_buffer->AssignString();
+    auto image = CudaDrModuleCache::GetInstance().FindImage(input_buffer->Get<ModuleImageDigest>());
+    if (image == NULL) return std::make_shared<Result>((cudaError_t)CUDA_ERROR_NOT_FOUND);
     void **optionValues = new void *[numOptions];
     int log_buffer_size_bytes = 1024;
     int error_log_buffer_size_bytes = 1024;
@@ -101,7 +120,8 @@ CUDA_DRIVER_HANDLER(ModuleLoadDataEx) {
                 optionValues[i] = &log_buffer_size_bytes;
         }
     }
-    CUresult exit_code = cuModuleLoadDataEx(&module, image, numOptions, options, optionValues);
+    CUresult exit_code =
+        cuModuleLoadDataEx(&module, image->bytes.data(), numOptions, options, optionValues);
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     out->AddMarshal(module);
     for (unsigned int i = 0; i < numOptions; i++) {
@@ -128,40 +148,35 @@ CUDA_DRIVER_HANDLER(ModuleGetTexRef) {
     return std::make_shared<Result>((cudaError_t)exit_code, out);
 }
 
-/*Load a module's data with options.*/
-CUDA_DRIVER_HANDLER(ModuleLoad) {
-    Decoder *decoder = new Decoder();
-    char *fname = input_buffer->AssignString();
-    LOG4CPLUS_DEBUG(pThis->GetLogger(), "Module name:" << fname);
-    char *moduleLoad = input_buffer->AssignString();
-    LOG4CPLUS_DEBUG(pThis->GetLogger(), "Calling decoder->Decode");
-    std::istringstream iss(moduleLoad);
-    fstream fout;
-    fout.open("/tmp/file.bin", ios::binary | ios::out);
-    decoder->Decode(iss, fout);
-    fout.close();
-    CUmodule module;
-    CUresult exit_code = cuModuleLoad(&module, "/tmp/file.bin");
-    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-    out->AddMarshal(module);
-    return std::make_shared<Result>((cudaError_t)exit_code, out);
-}
-
-/*Load a module's data with options.*/
+/*Load a fat binary.*/
 CUDA_DRIVER_HANDLER(ModuleLoadFatBinary) {
-    char *fname = input_buffer->AssignString();
-    LOG4CPLUS_DEBUG(pThis->GetLogger(), "Module name:" << fname);
-    CUmodule module;
-    CUresult exit_code = cuModuleLoadFatBinary(&module, fname);
+    CUmodule module = NULL;
+    ModuleImageDigest digest = input_buffer->Get<ModuleImageDigest>();
+    CUresult exit_code = CudaDrModuleCache::GetInstance().Load(
+        digest, true, &module, [](CUmodule *m, const void *image) {
+            return cuModuleLoadFatBinary(m, image);
+        });
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     out->AddMarshal(module);
     return std::make_shared<Result>((cudaError_t)exit_code, out);
 }
 
-/*Load a module's data with options.*/
+/*Unload a module.*/
 CUDA_DRIVER_HANDLER(ModuleUnload) {
     CUmodule module = input_buffer->Get<CUmodule>();
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
-    CUresult exit_code = cuModuleUnload(module);
+    CUresult exit_code = CudaDrModuleCache::GetInstance().Unload(module);
     return std::make_shared<Result>((cudaError_t)exit_code, out);
 }
+
+/*Receive a piece of a module image.*/
+CUDA_DRIVER_HANDLER(ModuleImageChunk) {
+    ModuleImageDigest digest = input_buffer->Get<ModuleImageDigest>();
+    uint64_t size = input_buffer->Get<uint64_t>();
+    uint64_t offset = input_buffer->Get<uint64_t>();
+    size_t n = input_buffer->Get<size_t>();
+    char *bytes = input_buffer->Assign<char>(n);
+    CUresult exit_code =
+        CudaDrModuleCache::GetInstance().AddChunk(digest, size, offset, bytes, n);
+    return std::make_shared<Result>((cudaError_t)exit_code);
+}
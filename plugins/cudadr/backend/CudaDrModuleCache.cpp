@@ -0,0 +1,214 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2011  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CudaDrModuleCache.h"
+
+#include <log4cplus/loggingmacros.h>
+
+#include <cstdlib>
+
+using namespace std;
+using namespace log4cplus;
+
+using gvirtus::common::Sha256;
+
+/* PTX declaring no variable in the .global or .const state spaces. */
+static bool PtxShareable(const char *text, size_t size) {
+    const char *end = text + size;
+    for (const char *line = text; line < end;) {
+        const char *next = (const char *)memchr(line, '\n', end - line);
+        next = next != NULL ? next + 1 : end;
+        string directive;
+        for (const char *p = line; p < next;) {
+            while (p < next && (*p == ' ' || *p == '\t')) p++;
+            const char *word = p;
+            while (p < next && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') p++;
+            directive.assign(word, p - word);
+            if (directive != ".visible" && directive != ".extern" && directive != ".weak" &&
+                directive != ".common")
+                break;
+        }
+        if (directive == ".global" || directive == ".const") return false;
+        line = next;
+    }
+    return true;
+}
+
+/* A cubin without data objects or global sections. */
+static bool ElfShareable(const char *data, size_t size) {
+    if (size < sizeof(Elf64_Ehdr) || data[EI_CLASS] != ELFCLASS64) return false;
+    auto eh = (const Elf64_Ehdr *)data;
+    if (eh->e_shentsize != sizeof(Elf64_Shdr) || eh->e_shstrndx >= eh->e_shnum ||
+        eh->e_shoff + eh->e_shnum * sizeof(Elf64_Shdr) > size)
+        return false;
+    auto sh = (const Elf64_Shdr *)(data + eh->e_shoff);
+    for (int i = 0; i < eh->e_shnum; i++)
+        if (sh[i].sh_offset + sh[i].sh_size > size && sh[i].sh_type != SHT_NOBITS) return false;
+    const char *names = data + sh[eh->e_shstrndx].sh_offset;
+    size_t namesSize = sh[eh->e_shstrndx].sh_size;
+    for (int i = 0; i < eh->e_shnum; i++) {
+        if (sh[i].sh_name >= namesSize) return false;
+        if (strncmp(names + sh[i].sh_name, ".nv.global", 10) == 0) return false;
+        if (sh[i].sh_type != SHT_SYMTAB || sh[i].sh_entsize != sizeof(Elf64_Sym)) continue;
+        auto symbols = (const Elf64_Sym *)(data + sh[i].sh_offset);
+        for (size_t j = 0; j < sh[i].sh_size / sizeof(Elf64_Sym); j++)
+            if (ELF64_ST_TYPE(symbols[j].st_info) == STT_OBJECT) return false;
+    }
+    return true;
+}
+
+static bool Shareable(const string &image) {
+    if (image.size() >= SELFMAG && memcmp(image.data(), ELFMAG, SELFMAG) == 0)
+        return ElfShareable(image.data(), image.size());
+    if (image.size() < sizeof(ModuleImageFatHeader) ||
+        *(const uint32_t *)image.data() != MODULE_IMAGE_FATBIN_MAGIC)
+        return PtxShareable(image.data(), image.size());
+    auto header = (const ModuleImageFatHeader *)image.data();
+    size_t offset = header->headerSize;
+    while (offset + sizeof(ModuleImageFatEntry) <= image.size()) {
+        auto entry = (const ModuleImageFatEntry *)(image.data() + offset);
+        const char *payload = image.data() + offset + entry->headerSize;
+        offset += entry->headerSize + (size_t)entry->paddedPayloadSize;
+        /* Compressed payloads are not looked into. */
+        if (offset > image.size() || entry->uncompressedPayload != 0) return false;
+        if (entry->kind == 1 && !PtxShareable(payload, entry->payloadSize)) return false;
+        if (entry->kind == 2 && !ElfShareable(payload, entry->payloadSize)) return false;
+        if (entry->kind != 1 && entry->kind != 2) return false;
+    }
+    return true;
+}
+
+CudaDrModuleCache &CudaDrModuleCache::GetInstance() {
+    static CudaDrModuleCache instance;
+    return instance;
+}
+
+CudaDrModuleCache::CudaDrModuleCache()
+    : logger(Logger::getInstance(LOG4CPLUS_TEXT("CudaDrModuleCache"))),
+      mCapacity(256 << 20),
+      mBytes(0) {
+    const char *env = getenv("GVIRTUS_CUDADR_IMAGE_CACHE_MB");
+    if (env != NULL && *env != '\0') mCapacity = strtoul(env, NULL, 10) << 20;
+}
+
+CUresult CudaDrModuleCache::AddChunk(const ModuleImageDigest &digest, uint64_t size,
+                                     uint64_t offset, const char *bytes, size_t n) {
+    string image;
+    {
+        lock_guard<mutex> lock(mMutex);
+        auto key = make_pair(this_thread::get_id(), digest);
+        if (offset == 0) mUploads[key] = Upload{size, string()};
+        auto upload = mUploads.find(key);
+        if (upload == mUploads.end() || upload->second.size != size ||
+            upload->second.bytes.size() != offset || n > size - offset) {
+            if (upload != mUploads.end()) mUploads.erase(upload);
+            return CUDA_ERROR_INVALID_VALUE;
+        }
+        upload->second.bytes.append(bytes, n);
+        if (upload->second.bytes.size() < size) return CUDA_SUCCESS;
+        image = std::move(upload->second.bytes);
+        mUploads.erase(upload);
+    }
+
+    if (Sha256::Of(image.data(), image.size()) != digest) {
+        LOG4CPLUS_WARN(logger,
+                       "Image " << Sha256::ToString(digest) << " does not match its digest");
+        return CUDA_ERROR_INVALID_IMAGE;
+    }
+    bool shareable = Shareable(image);
+    LOG4CPLUS_DEBUG(logger, "Received image " << Sha256::ToString(digest) << " of " << size
+                                              << " bytes" << (shareable ? ", shareable" : ""));
+    auto received = make_shared<const Image>(Image{std::move(image), shareable});
+
+    lock_guard<mutex> lock(mMutex);
+    if (mIndex.count(digest) > 0) return CUDA_SUCCESS;
+    mImages.emplace_front(digest, received);
+    mIndex[digest] = mImages.begin();
+    mBytes += received->bytes.size();
+    /* The newest image stays, whatever its size: its client is about to load it. */
+    while (mBytes > mCapacity && mImages.size() > 1) {
+        mBytes -= mImages.back().second->bytes.size();
+        mIndex.erase(mImages.back().first);
+        mImages.pop_back();
+    }
+    return CUDA_SUCCESS;
+}
+
+shared_ptr<const CudaDrModuleCache::Image> CudaDrModuleCache::FindImage(
+    const ModuleImageDigest &digest) {
+    lock_guard<mutex> lock(mMutex);
+    auto it = mIndex.find(digest);
+    if (it == mIndex.end()) return NULL;
+    mImages.splice(mImages.begin(), mImages, it->second);
+    return it->second->second;
+}
+
+CUresult CudaDrModuleCache::Load(const ModuleImageDigest &digest, bool share, CUmodule *module,
+                                 const Loader &load) {
+    auto image = FindImage(digest);
+    if (image == NULL) return CUDA_ERROR_NOT_FOUND;
+    CUcontext context = NULL;
+    share = share && image->shareable && cuCtxGetCurrent(&context) == CUDA_SUCCESS &&
+            context != NULL;
+    if (share) {
+        lock_guard<mutex> lock(mMutex);
+        auto shared = mShared.find(make_pair(context, digest));
+        if (shared != mShared.end()) {
+            mModules[shared->second].references++;
+            *module = shared->second;
+            return CUDA_SUCCESS;
+        }
+    }
+
+    CUresult result = load(module, image->bytes.data());
+    if (result != CUDA_SUCCESS || !share) return result;
+    lock_guard<mutex> lock(mMutex);
+    /* Another client may have loaded it meanwhile: this one is then its own. */
+    if (mShared.emplace(make_pair(context, digest), *module).second)
+        mModules[*module] = Module{context, digest, 1};
+    return result;
+}
+
+CUresult CudaDrModuleCache::Unload(CUmodule module) {
+    {
+        lock_guard<mutex> lock(mMutex);
+        auto it = mModules.find(module);
+        if (it != mModules.end()) {
+            if (--it->second.references > 0) return CUDA_SUCCESS;
+            mShared.erase(make_pair(it->second.context, it->second.digest));
+            mModules.erase(it);
+        }
+    }
+    return cuModuleUnload(module);
+}
+
+void CudaDrModuleCache::ForgetContext(CUcontext ctx) {
+    lock_guard<mutex> lock(mMutex);
+    for (auto it = mModules.begin(); it != mModules.end();) {
+        if (it->second.context != ctx) {
+            ++it;
+            continue;
+        }
+        mShared.erase(make_pair(ctx, it->second.digest));
+        it = mModules.erase(it);
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2011  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CUDADRMODULECACHE_H
+#define CUDADRMODULECACHE_H
+
+#include <cuda.h>
+#include <log4cplus/logger.h>
+
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "ModuleImage.h"
+
+/*
+ * CudaDrModuleCache keeps the module images sent by the clients (see
+ * ModuleImage.h), least recently used first out beyond
+ * GVIRTUS_CUDADR_IMAGE_CACHE_MB megabytes (default 256), so that an image
+ * crosses the wire once per backend.
+ *
+ * A module loaded from an image without variables (no __device__,
+ * __constant__ or __managed__ data a client could write) is shared by the
+ * clients loading the same image in the same context: it is loaded once and
+ * unloaded with its last reference. Modules with variables are loaded for
+ * each client, as their state is not to be shared.
+ */
+class CudaDrModuleCache {
+   public:
+    struct Image {
+        std::string bytes;
+        bool shareable;
+    };
+
+    typedef std::function<CUresult(CUmodule *, const void *)> Loader;
+
+    static CudaDrModuleCache &GetInstance();
+
+    /*
+     * Adds a piece of the image named digest sent by the calling client. An
+     * offset of 0 starts the image again; the last piece checks its digest.
+     */
+    CUresult AddChunk(const ModuleImageDigest &digest, uint64_t size, uint64_t offset,
+                      const char *bytes, size_t n);
+
+    /* The image named digest, NULL if it was never sent or was evicted. */
+    std::shared_ptr<const Image> FindImage(const ModuleImageDigest &digest);
+
+    /*
+     * Loads the image named digest in the current context with load, or
+     * takes a reference on the module already loaded from it when share.
+     */
+    CUresult Load(const ModuleImageDigest &digest, bool share, CUmodule *module,
+                  const Loader &load);
+
+    /* Drops a reference on module, unloaded when it was the last one. */
+    CUresult Unload(CUmodule module);
+
+    /* The modules of ctx died with it. */
+    void ForgetContext(CUcontext ctx);
+
+   private:
+    CudaDrModuleCache();
+
+    struct Module {
+        CUcontext context;
+        ModuleImageDigest digest;
+        int references;
+    };
+
+    struct Upload {
+        uint64_t size;
+        std::string bytes;
+    };
+
+    log4cplus::Logger logger;
+    std::mutex mMutex;
+    size_t mCapacity;
+    size_t mBytes;
+    /* The most recently used first. */
+    std::list<std::pair<ModuleImageDigest, std::shared_ptr<const Image>>> mImages;
+    std::map<ModuleImageDigest, decltype(mImages)::iterator> mIndex;
+    std::map<std::pair<std::thread::id, ModuleImageDigest>, Upload> mUploads;
+    std::map<CUmodule, Module> mModules;
+    std::map<std::pair<CUcontext, ModuleImageDigest>, CUmodule> mShared;
+};
+
+#endif /* CUDADRMODULECACHE_H */
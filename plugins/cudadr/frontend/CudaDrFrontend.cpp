@@ -25,8 +25,24 @@
 
 #include "CudaDrFrontend.h"
 
+#include <gvirtus/frontend/Macros.h>
+
 using namespace std;
 
 CudaDrFrontend msInstance __attribute_used__;
 
+/* The routines that only enqueue work, which a macro may defer. */
+static const bool deferrable = gvirtus::frontend::Macros::AllowDeferring({
+    "cuLaunchKernel",
+    "cuLaunchKernelEx",
+    "cuLaunchGridAsync",
+    "cuMemsetD32Async",
+    "cuEventRecord",
+    "cuStreamWriteValue32",
+});
+
+mutex CudaDrFrontend::mFunctionParamsMutex;
+map<CUfunction, CudaDrFunctionParams> CudaDrFrontend::mapFunction2Params;
+map<CUmodule, int> CudaDrFrontend::mapModuleReferences;
+
 CudaDrFrontend::CudaDrFrontend() { gvirtus::frontend::Frontend::GetFrontend(); }
\ No newline at end of file
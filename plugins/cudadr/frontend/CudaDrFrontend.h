@@ -32,6 +32,22 @@
 #include <cuda.h>
 #include <gvirtus/frontend/Frontend.h>
 
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/*
+ * The parameters of a kernel as cuFuncGetParamInfo reports them on the
+ * backend: their offset and size in the argument buffer of a launch.
+ */
+struct CudaDrFunctionParams {
+    CUmodule module;
+    /* false when the backend driver cannot tell. */
+    bool known;
+    std::vector<std::pair<size_t, size_t>> params;
+};
+
 class CudaDrFrontend {
    public:
     static inline void Execute(const char *routine,
@@ -155,7 +171,45 @@ class CudaDrFrontend {
     static inline char *GetOutputString() {
         return gvirtus::frontend::Frontend::GetFrontend()->GetOutputBuffer()->AssignString();
     }
+
+    static inline void addFunctionParams(CUfunction f, const CudaDrFunctionParams &params) {
+        std::lock_guard<std::mutex> lock(mFunctionParamsMutex);
+        mapFunction2Params[f] = params;
+    }
+
+    /* false if f was not returned by cuModuleGetFunction. */
+    static inline bool getFunctionParams(CUfunction f, CudaDrFunctionParams *params) {
+        std::lock_guard<std::mutex> lock(mFunctionParamsMutex);
+        auto it = mapFunction2Params.find(f);
+        if (it == mapFunction2Params.end()) return false;
+        *params = it->second;
+        return true;
+    }
+
+    /* Counts a load that returned module; the backend may share it between loads. */
+    static inline void addModuleReference(CUmodule module) {
+        std::lock_guard<std::mutex> lock(mFunctionParamsMutex);
+        mapModuleReferences[module]++;
+    }
+
+    /* Forgets the functions of module once every load of it is unloaded. */
+    static inline void removeModuleFunctions(CUmodule module) {
+        std::lock_guard<std::mutex> lock(mFunctionParamsMutex);
+        auto it = mapModuleReferences.find(module);
+        if (it != mapModuleReferences.end()) {
+            if (--it->second > 0) return;
+            mapModuleReferences.erase(it);
+        }
+        std::erase_if(mapFunction2Params,
+                      [module](const auto &item) { return item.second.module == module; });
+    }
+
     CudaDrFrontend();
+
+   private:
+    static std::mutex mFunctionParamsMutex;
+    static std::map<CUfunction, CudaDrFunctionParams> mapFunction2Params;
+    static std::map<CUmodule, int> mapModuleReferences;
 };
 
 #endif /* CUDADRFRONTEND_H */
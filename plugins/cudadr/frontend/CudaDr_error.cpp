@@ -23,26 +23,42 @@
  *             Department of Computer Science, University College Dublin
  */
 
+#include <gvirtus/frontend/LocalTier.h>
+
+#include <string>
+
 #include "CudaDr.h"
+#include "CudaDrErrorNames.h"
 
 using namespace std;
 
+using gvirtus::frontend::FindEnumName;
+using gvirtus::frontend::LocalCache;
+
+/* Asks the backend, once per error, what routine (a cuGetErrorString) says of it. */
+static CUresult RemoteErrorString(const char *routine, CUresult error, const char **pStr) {
+    static LocalCache<pair<string, int>, string> strings;
+    CUresult exit_code = CUDA_SUCCESS;
+    const string *s = strings.Get({routine, error}, [&](string *value) {
+        CudaDrFrontend::Prepare();
+        CudaDrFrontend::AddVariableForArguments(error);
+        CudaDrFrontend::Execute(routine);
+        exit_code = CudaDrFrontend::GetExitCode();
+        if (!CudaDrFrontend::Success()) return false;
+        *value = CudaDrFrontend::GetOutputString();
+        return true;
+    });
+    if (s != nullptr) *pStr = s->c_str();
+    return exit_code;
+}
+
 extern "C" CUresult cuGetErrorString(CUresult error, const char **pStr) {
-    CudaDrFrontend::Prepare();
-    CudaDrFrontend::AddVariableForArguments(error);
-    CudaDrFrontend::Execute("cuGetErrorString");
-    if (CudaDrFrontend::Success()) {
-        *pStr = CudaDrFrontend::GetOutputString();
-    }
-    return CudaDrFrontend::GetExitCode();
+    return RemoteErrorString("cuGetErrorString", error, pStr);
 }
 
 extern "C" CUresult cuGetErrorName(CUresult error, const char **pStr) {
-    CudaDrFrontend::Prepare();
-    CudaDrFrontend::AddVariableForArguments(error);
-    CudaDrFrontend::Execute("cuGetErrorName");
-    if (CudaDrFrontend::Success()) {
-        *pStr = CudaDrFrontend::GetOutputString();
-    }
-    return CudaDrFrontend::GetExitCode();
-}
\ No newline at end of file
+    const char *name = FindEnumName(CU_RESULT_NAMES, error);
+    if (name == nullptr) return RemoteErrorString("cuGetErrorName", error, pStr);
+    *pStr = name;
+    return CUDA_SUCCESS;
+}
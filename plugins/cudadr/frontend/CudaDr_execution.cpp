@@ -29,6 +29,9 @@
 #include <dirent.h>
 #include <errno.h>
 
+#include <cstring>
+#include <vector>
+
 #include "CudaDr.h"
 
 using namespace std;
@@ -167,6 +170,42 @@ extern "C" CUresult cuFuncSetCacheConfig(CUfunction hfunc, CUfunc_cache config)
     return CudaDrFrontend::GetExitCode();
 }
 
+/*
+ * Adds the arguments of a launch of f as one buffer: the kernelParams packed
+ * at the offsets cuModuleGetFunction learnt, or the buffer passed in extra.
+ */
+static CUresult AddLaunchArguments(CUfunction f, void** kernelParams, void** extra) {
+    if (extra != NULL) {
+        if (kernelParams != NULL) return CUDA_ERROR_INVALID_VALUE;
+        void* buffer = NULL;
+        size_t size = 0;
+        for (; *extra != CU_LAUNCH_PARAM_END; extra += 2) {
+            if (*extra == CU_LAUNCH_PARAM_BUFFER_POINTER)
+                buffer = extra[1];
+            else if (*extra == CU_LAUNCH_PARAM_BUFFER_SIZE)
+                size = *(size_t*)extra[1];
+            else
+                return CUDA_ERROR_INVALID_VALUE;
+        }
+        CudaDrFrontend::AddVariableForArguments(size);
+        CudaDrFrontend::AddHostPointerForArguments((char*)buffer, size);
+        return CUDA_SUCCESS;
+    }
+
+    CudaDrFunctionParams params;
+    if (!CudaDrFrontend::getFunctionParams(f, &params)) return CUDA_ERROR_INVALID_HANDLE;
+    if (!params.known) return CUDA_ERROR_NOT_SUPPORTED;
+    size_t size = 0;
+    for (auto& param : params.params) size = max(size, param.first + param.second);
+    if (size > 0 && kernelParams == NULL) return CUDA_ERROR_INVALID_VALUE;
+    vector<char> buffer(size);
+    for (size_t i = 0; i < params.params.size(); i++)
+        memcpy(buffer.data() + params.params[i].first, kernelParams[i], params.params[i].second);
+    CudaDrFrontend::AddVariableForArguments(size);
+    CudaDrFrontend::AddHostPointerForArguments(buffer.data(), size);
+    return CUDA_SUCCESS;
+}
+
 // new Cuda 4.0 functions
 extern "C" CUresult cuLaunchKernel(CUfunction f, unsigned int gridDimX, unsigned int gridDimY,
                                    unsigned int gridDimZ, unsigned int blockDimX,
@@ -183,19 +222,21 @@ extern "C" CUresult cuLaunchKernel(CUfunction f, unsigned int gridDimX, unsigned
     CudaDrFrontend::AddVariableForArguments(blockDimZ);
     CudaDrFrontend::AddVariableForArguments(sharedMemBytes);
     CudaDrFrontend::AddDevicePointerForArguments((void*)hstream);
-    CudaDrFrontend::AddDevicePointerForArguments(kernelParams);
-    CudaDrFrontend::AddHostPointerForArguments(&extra);
+    CUresult result = AddLaunchArguments(f, kernelParams, extra);
+    if (result != CUDA_SUCCESS) return result;
     CudaDrFrontend::Execute("cuLaunchKernel");
     return CudaDrFrontend::GetExitCode();
 }
 
 extern "C" CUresult cuLaunchKernelEx(const CUlaunchConfig* config, CUfunction f,
                                      void** kernelParams, void** extra) {
+    if (config == NULL) return CUDA_ERROR_INVALID_VALUE;
     CudaDrFrontend::Prepare();
     CudaDrFrontend::AddDevicePointerForArguments((void*)f);
-    CudaDrFrontend::AddHostPointerForArguments<const CUlaunchConfig>(config);
-    CudaDrFrontend::AddDevicePointerForArguments(kernelParams);
-    CudaDrFrontend::AddHostPointerForArguments(&extra);
+    CudaDrFrontend::AddVariableForArguments(*config);
+    CudaDrFrontend::AddHostPointerForArguments(config->attrs, config->numAttrs);
+    CUresult result = AddLaunchArguments(f, kernelParams, extra);
+    if (result != CUDA_SUCCESS) return result;
     CudaDrFrontend::Execute("cuLaunchKernelEx");
     return CudaDrFrontend::GetExitCode();
-}
\ No newline at end of file
+}
@@ -26,24 +26,60 @@
  *             Department of Computer Science, University College Dublin
  */
 
-#include <gvirtus/common/Encoder.h>
-
 #include <fstream>
-#include <sstream>
+#include <iterator>
+#include <string>
 
 #include "CudaDr.h"
+#include "ModuleImage.h"
 
 using namespace std;
 
-using gvirtus::common::Encoder;
+using gvirtus::common::Sha256;
+
+/* Sends the size bytes of data named digest in chunks of MODULE_IMAGE_CHUNK. */
+static CUresult SendModuleImage(const ModuleImageDigest &digest, const void *data, size_t size) {
+    for (uint64_t offset = 0; offset == 0 || offset < size; offset += MODULE_IMAGE_CHUNK) {
+        size_t n = min<uint64_t>(MODULE_IMAGE_CHUNK, size - offset);
+        CudaDrFrontend::Prepare();
+        CudaDrFrontend::AddVariableForArguments(digest);
+        CudaDrFrontend::AddVariableForArguments((uint64_t)size);
+        CudaDrFrontend::AddVariableForArguments(offset);
+        CudaDrFrontend::AddVariableForArguments(n);
+        CudaDrFrontend::AddHostPointerForArguments((const char *)data + offset, n);
+        CudaDrFrontend::Execute("cuModuleImageChunk");
+        if (!CudaDrFrontend::Success()) return CudaDrFrontend::GetExitCode();
+    }
+    return CUDA_SUCCESS;
+}
+
+/*
+ * Runs routine with the digest of image, sending image first when the
+ * backend does not hold it (see ModuleImage.h).
+ */
+static CUresult LoadModuleImage(CUmodule *module, const char *routine, const void *image) {
+    size_t size;
+    const void *data = ModuleImageData(image, &size);
+    ModuleImageDigest digest = Sha256::Of(data, size);
+    for (int sent = 0;; sent++) {
+        CudaDrFrontend::Prepare();
+        CudaDrFrontend::AddVariableForArguments(digest);
+        CudaDrFrontend::Execute(routine);
+        if (CudaDrFrontend::GetExitCode() != CUDA_ERROR_NOT_FOUND) break;
+        if (sent == MODULE_IMAGE_SENDS) break;
+        CUresult result = SendModuleImage(digest, data, size);
+        if (result != CUDA_SUCCESS) return result;
+    }
+    if (CudaDrFrontend::Success()) {
+        *module = (CUmodule)(CudaDrFrontend::GetOutputDevicePointer());
+        CudaDrFrontend::addModuleReference(*module);
+    }
+    return CudaDrFrontend::GetExitCode();
+}
 
 /*Load a module's data. */
 extern "C" CUresult cuModuleLoadData(CUmodule *module, const void *image) {
-    CudaDrFrontend::Prepare();
-    CudaDrFrontend::AddStringForArguments((char *)image);
-    CudaDrFrontend::Execute("cuModuleLoadData");
-    if (CudaDrFrontend::Success()) *module = (CUmodule)(CudaDrFrontend::GetOutputDevicePointer());
-    return CudaDrFrontend::GetExitCode();
+    return LoadModuleImage(module, "cuModuleLoadData", image);
 }
 
 /*Returns a function handle*/
@@ -56,6 +92,15 @@ extern "C" CUresult cuModuleGetFunction(CUfunction *hfunc, CUmodule hmod, const
     if (CudaDrFrontend::Success()) {
         tmp = (CUfunction)(CudaDrFrontend::GetOutputDevicePointer());
         *hfunc = (CUfunction)tmp;
+        /* The layout of the parameters, for cuLaunchKernel to pack them. */
+        CudaDrFunctionParams params{hmod, false, {}};
+        int count = CudaDrFrontend::GetOutputVariable<int>();
+        params.known = count >= 0;
+        for (int i = 0; i < count; i++) {
+            size_t offset = CudaDrFrontend::GetOutputVariable<size_t>();
+            params.params.emplace_back(offset, CudaDrFrontend::GetOutputVariable<size_t>());
+        }
+        CudaDrFrontend::addFunctionParams(*hfunc, params);
     }
     return CudaDrFrontend::GetExitCode();
 }
@@ -89,18 +134,28 @@ extern "C" CUresult cuModuleGetTexRef(CUtexref *pTexRef, CUmodule hmod, const ch
 /*Load a module's data with options.*/
 extern "C" CUresult cuModuleLoadDataEx(CUmodule *module, const void *image, unsigned int numOptions,
                                        CUjit_option *options, void **optionValues) {
-    CudaDrFrontend::Prepare();
     char *tmp;
     char *tmp2;
-    CudaDrFrontend::AddVariableForArguments(numOptions);
-    CudaDrFrontend::AddHostPointerForArguments(options, numOptions);
-    CudaDrFrontend::AddStringForArguments((char *)image);
-    for (unsigned int i = 0; i < numOptions; i++) {
-        CudaDrFrontend::AddHostPointerForArguments(&optionValues[i]);
+    size_t size;
+    const void *data = ModuleImageData(image, &size);
+    ModuleImageDigest digest = Sha256::Of(data, size);
+    for (int sent = 0;; sent++) {
+        CudaDrFrontend::Prepare();
+        CudaDrFrontend::AddVariableForArguments(numOptions);
+        CudaDrFrontend::AddHostPointerForArguments(options, numOptions);
+        CudaDrFrontend::AddVariableForArguments(digest);
+        for (unsigned int i = 0; i < numOptions; i++) {
+            CudaDrFrontend::AddHostPointerForArguments(&optionValues[i]);
+        }
+        CudaDrFrontend::Execute("cuModuleLoadDataEx");
+        if (CudaDrFrontend::GetExitCode() != CUDA_ERROR_NOT_FOUND) break;
+        if (sent == MODULE_IMAGE_SENDS) break;
+        CUresult result = SendModuleImage(digest, data, size);
+        if (result != CUDA_SUCCESS) return result;
     }
-    CudaDrFrontend::Execute("cuModuleLoadDataEx");
     if (CudaDrFrontend::Success()) {
         *module = (CUmodule)(CudaDrFrontend::GetOutputDevicePointer());
+        CudaDrFrontend::addModuleReference(*module);
         int len_str;
         for (unsigned int i = 0; i < numOptions - 1; i++) {
             switch (options[i]) {
@@ -125,33 +180,23 @@ extern "C" CUresult cuModuleLoadDataEx(CUmodule *module, const void *image, unsi
 }
 
 extern "C" CUresult cuModuleLoad(CUmodule *module, const char *fname) {
-    Encoder *encoder = new Encoder();
-    std::ostringstream res;
-    std::ifstream input("helloWorldDriverAPI.ptx", std::ios::binary);
-    encoder->Encode(input, res);
-
-    std::string moduleLoad = res.str();
-
-    CudaDrFrontend::Prepare();
-    CudaDrFrontend::AddStringForArguments((char *)fname);
-    CudaDrFrontend::AddStringForArguments(moduleLoad.c_str());
-    CudaDrFrontend::Execute("cuModuleLoad");
-    if (CudaDrFrontend::Success()) *module = (CUmodule)(CudaDrFrontend::GetOutputDevicePointer());
-    return CudaDrFrontend::GetExitCode();
+    ifstream input(fname, ios::binary);
+    if (!input) return CUDA_ERROR_FILE_NOT_FOUND;
+    string image((istreambuf_iterator<char>(input)), istreambuf_iterator<char>());
+    /* A PTX file ends where its NUL is added; a cubin or fat binary knows its size. */
+    image.push_back('\0');
+    return LoadModuleImage(module, "cuModuleLoadData", image.data());
 }
 
 extern "C" CUresult cuModuleLoadFatBinary(CUmodule *module, const void *fatCubin) {
-    CudaDrFrontend::Prepare();
-    CudaDrFrontend::AddStringForArguments((char *)fatCubin);
-    CudaDrFrontend::Execute("cuModuleLoadFatBinary");
-    if (CudaDrFrontend::Success()) *module = (CUmodule)(CudaDrFrontend::GetOutputDevicePointer());
-    return CudaDrFrontend::GetExitCode();
+    return LoadModuleImage(module, "cuModuleLoadFatBinary", fatCubin);
 }
 
 extern "C" CUresult cuModuleUnload(CUmodule hmod) {
     CudaDrFrontend::Prepare();
     CudaDrFrontend::AddDevicePointerForArguments((char *)hmod);
     CudaDrFrontend::Execute("cuModuleUnload");
+    if (CudaDrFrontend::Success()) CudaDrFrontend::removeModuleFunctions(hmod);
     return CudaDrFrontend::GetExitCode();
 }
 
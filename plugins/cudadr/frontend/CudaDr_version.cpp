@@ -26,14 +26,26 @@
  *             Department of Computer Science, University College Dublin
  */
 
+#include <gvirtus/frontend/LocalTier.h>
+
 #include "CudaDr.h"
 
 using namespace std;
 
-/*Return the Cuda Driver Version */
+using gvirtus::frontend::LocalCache;
+
+/*Return the Cuda Driver Version, asking the backend once per process */
 extern "C" CUresult cuDriverGetVersion(int *driverVersion) {
-    CudaDrFrontend::Prepare();
-    CudaDrFrontend::Execute("cuDriverGetVersion");
-    if (CudaDrFrontend::Success()) *driverVersion = CudaDrFrontend::GetOutputVariable<int>();
-    return CudaDrFrontend::GetExitCode();
+    static LocalCache<int, int> versions;
+    CUresult exit_code = CUDA_SUCCESS;
+    const int *version = versions.Get(0, [&](int *value) {
+        CudaDrFrontend::Prepare();
+        CudaDrFrontend::Execute("cuDriverGetVersion");
+        exit_code = CudaDrFrontend::GetExitCode();
+        if (!CudaDrFrontend::Success()) return false;
+        *value = CudaDrFrontend::GetOutputVariable<int>();
+        return true;
+    });
+    if (version != nullptr) *driverVersion = *version;
+    return exit_code;
 }
@@ -0,0 +1,122 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2011  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef MODULEIMAGE_H
+#define MODULEIMAGE_H
+
+#include <elf.h>
+#include <gvirtus/common/Sha256.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Module images (PTX, cubin or fat binary) travel by content: the frontend
+ * names an image by its SHA-256 digest, and sends its bytes only when the
+ * backend does not have them.
+ *
+ *   cuModuleLoadData, cuModuleLoadFatBinary
+ *       in:  ModuleImageDigest
+ *   cuModuleLoadDataEx
+ *       in:  unsigned int numOptions, CUjit_option[numOptions],
+ *            ModuleImageDigest, option values
+ *   cuModuleImageChunk
+ *       in:  ModuleImageDigest, uint64_t size, uint64_t offset, bytes
+ *
+ * The loads answer CUDA_ERROR_NOT_FOUND for an image the backend does not
+ * hold. The frontend then sends it in chunks of MODULE_IMAGE_CHUNK bytes and
+ * loads again, up to MODULE_IMAGE_SENDS times since other clients may evict
+ * it in between. The backend checks the digest of the bytes it received.
+ *
+ * Loads of the same image in the same context may return the same module, so
+ * the frontend counts the loads of each module before forgetting its
+ * functions.
+ */
+
+typedef gvirtus::common::Sha256::Digest ModuleImageDigest;
+
+static const size_t MODULE_IMAGE_CHUNK = 4 << 20;
+static const int MODULE_IMAGE_SENDS = 3;
+
+#define MODULE_IMAGE_WRAPPER_MAGIC 0x466243B1
+#define MODULE_IMAGE_FATBIN_MAGIC 0xBA55ED50
+
+/* __fatBinC_Wrapper_t */
+struct ModuleImageWrapper {
+    int magic;
+    int version;
+    const void *data;
+    void *filename_or_fatbins;
+};
+
+/* fatBinaryHeader, followed by fatSize bytes of entries. */
+struct ModuleImageFatHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    uint64_t fatSize;
+};
+
+/* An entry of a fat binary, followed by paddedPayloadSize bytes. */
+struct ModuleImageFatEntry {
+    uint16_t kind; /* 1: PTX, 2: ELF */
+    uint16_t version;
+    uint32_t headerSize;
+    uint32_t paddedPayloadSize;
+    uint32_t unknown0;
+    uint32_t payloadSize;
+    uint32_t unknown1;
+    uint32_t unknown2;
+    uint32_t smVersion;
+    uint32_t bitWidth;
+    uint32_t unknown3;
+    uint64_t unknown4;
+    uint64_t unknown5;
+    uint64_t uncompressedPayload; /* not 0 when the payload is compressed */
+};
+
+/*
+ * The bytes of image as the driver reads them: a fat binary without its
+ * wrapper, an ELF up to its last header or section, or PTX with its NUL.
+ */
+static inline const void *ModuleImageData(const void *image, size_t *size) {
+    if (*(const uint32_t *)image == MODULE_IMAGE_WRAPPER_MAGIC)
+        image = ((const ModuleImageWrapper *)image)->data;
+    if (*(const uint32_t *)image == MODULE_IMAGE_FATBIN_MAGIC) {
+        auto header = (const ModuleImageFatHeader *)image;
+        *size = header->headerSize + header->fatSize;
+    } else if (memcmp(image, ELFMAG, SELFMAG) == 0) {
+        auto eh = (const Elf64_Ehdr *)image;
+        auto sh = (const Elf64_Shdr *)((const char *)image + eh->e_shoff);
+        *size = std::max<size_t>(eh->e_shoff + eh->e_shnum * eh->e_shentsize,
+                                 eh->e_phoff + eh->e_phnum * eh->e_phentsize);
+        for (int i = 0; eh->e_shoff != 0 && i < eh->e_shnum; i++)
+            if (sh[i].sh_type != SHT_NOBITS)
+                *size = std::max<size_t>(*size, sh[i].sh_offset + sh[i].sh_size);
+    } else {
+        *size = strlen((const char *)image) + 1;
+    }
+    return image;
+}
+
+#endif /* MODULEIMAGE_H */
@@ -28,6 +28,8 @@
 
 #include "CudaRtHandler.h"
 
+#include <gvirtus/common/Placement.h>
+
 using namespace std;
 using namespace log4cplus;
 
@@ -57,15 +59,31 @@ bool CudaRtHandler::CanExecute(std::string routine) {
     return true;
 }
 
+/* the device the thread of this session was placed near, -1 if none yet */
+static thread_local int tsPlacedDevice = -1;
+
 std::shared_ptr<Result> CudaRtHandler::Execute(std::string routine,
                                                std::shared_ptr<Buffer> input_buffer) {
     map<string, CudaRtHandler::CudaRoutineHandler>::iterator it;
     it = mspHandlers->find(routine);
     LOG4CPLUS_DEBUG(logger, "Called: " << routine);
     if (it == mspHandlers->end()) throw runtime_error("No handler for '" + routine + "' found!");
+    if (tsPlacedDevice < 0 && gvirtus::common::Placement::GetInstance().Enabled()) {
+        int device;
+        if (cudaGetDevice(&device) == cudaSuccess) Place(device);
+    }
     return it->second(this, input_buffer);
 }
 
+void CudaRtHandler::Place(int device) {
+    auto &placement = gvirtus::common::Placement::GetInstance();
+    if (device == tsPlacedDevice || !placement.Enabled()) return;
+    char bus[32];
+    if (cudaDeviceGetPCIBusId(bus, sizeof(bus), device) != cudaSuccess) return;
+    placement.Bind(bus);
+    tsPlacedDevice = device;
+}
+
 void CudaRtHandler::RegisterFatBinary(std::string &handler, void **fatCubinHandle) {
     map<string, void **>::iterator it = mpFatBinary->find(handler);
     if (it != mpFatBinary->end()) {
@@ -260,6 +278,7 @@ void CudaRtHandler::Initialize() {
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(SetValidDevices));
     /* CudaRtHandler_error */
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(GetErrorString));
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(GetErrorName));
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(GetLastError));
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(PeekAtLastError));
 
@@ -272,6 +291,14 @@ void CudaRtHandler::Initialize() {
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(EventRecord));
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(EventSynchronize));
 
+    /* CudaRtHandler_notification */
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(EventRecordNotify));
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(StreamQueryNotify));
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(StreamAddCallback));
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(LaunchHostFunc));
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(NotificationsWait));
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(NotificationsClose));
+
     /* CudaRtHandler_execution */
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(ConfigureCall));
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(FuncGetAttributes));
@@ -315,9 +342,16 @@ void CudaRtHandler::Initialize() {
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(Memcpy2DFromArray));
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(Memcpy2DToArray));
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(Malloc3DArray));
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(MemcpyPeer));
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(MemcpyPeerAsync));
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(HostRegister));
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(HostUnregister));
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(HostAlloc));
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(FreeHost));
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(HostGetDevicePointer));
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(MemcpyPinned));
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(MemcpyPinnedAsync));
+    mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(PinnedAttach));
 
     /* CudaRtHandler_opengl */
     mspHandlers->insert(CUDA_ROUTINE_HANDLER_PAIR(GLSetGLDevice));  // deprecated
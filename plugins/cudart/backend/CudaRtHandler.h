@@ -72,6 +72,10 @@ class CudaRtHandler : public gvirtus::backend::Handler {
     virtual ~CudaRtHandler();
     bool CanExecute(std::string routine);
     std::shared_ptr<Result> Execute(std::string routine, std::shared_ptr<Buffer> input_buffer);
+    /* Sets the priority of the streams the session of this thread creates next. */
+    void StreamPriority(int rank);
+    /* Runs the session of this thread near device (see common/Placement.h). */
+    void Place(int device);
 
     void RegisterFatBinary(std::string &handler, void **fatCubinHandle);
     void RegisterFatBinary(const char *handler, void **fatCubinHandle);
@@ -184,6 +188,7 @@ CUDA_ROUTINE_HANDLER(DeviceGetStreamPriorityRange);
 
 /* CudaRtHandler_error */
 CUDA_ROUTINE_HANDLER(GetErrorString);
+CUDA_ROUTINE_HANDLER(GetErrorName);
 CUDA_ROUTINE_HANDLER(GetLastError);
 CUDA_ROUTINE_HANDLER(PeekAtLastError);
 
@@ -196,6 +201,14 @@ CUDA_ROUTINE_HANDLER(EventQuery);
 CUDA_ROUTINE_HANDLER(EventRecord);
 CUDA_ROUTINE_HANDLER(EventSynchronize);
 
+/* CudaRtHandler_notification */
+CUDA_ROUTINE_HANDLER(EventRecordNotify);
+CUDA_ROUTINE_HANDLER(StreamQueryNotify);
+CUDA_ROUTINE_HANDLER(StreamAddCallback);
+CUDA_ROUTINE_HANDLER(LaunchHostFunc);
+CUDA_ROUTINE_HANDLER(NotificationsWait);
+CUDA_ROUTINE_HANDLER(NotificationsClose);
+
 /* CudaRtHandler_execution */
 CUDA_ROUTINE_HANDLER(ConfigureCall);
 CUDA_ROUTINE_HANDLER(FuncGetAttributes);
@@ -243,9 +256,16 @@ CUDA_ROUTINE_HANDLER(MemcpyArrayToArray);
 CUDA_ROUTINE_HANDLER(Memcpy2DFromArray);
 CUDA_ROUTINE_HANDLER(Memcpy2DToArray);
 CUDA_ROUTINE_HANDLER(Malloc3DArray);
+CUDA_ROUTINE_HANDLER(MemcpyPeer);
 CUDA_ROUTINE_HANDLER(MemcpyPeerAsync);
 CUDA_ROUTINE_HANDLER(HostRegister);
 CUDA_ROUTINE_HANDLER(HostUnregister);
+CUDA_ROUTINE_HANDLER(HostAlloc);
+CUDA_ROUTINE_HANDLER(FreeHost);
+CUDA_ROUTINE_HANDLER(HostGetDevicePointer);
+CUDA_ROUTINE_HANDLER(MemcpyPinned);
+CUDA_ROUTINE_HANDLER(MemcpyPinnedAsync);
+CUDA_ROUTINE_HANDLER(PinnedAttach);
 
 /* CudaRtHandler_opengl */
 CUDA_ROUTINE_HANDLER(GLSetGLDevice);
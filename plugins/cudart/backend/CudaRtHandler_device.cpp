@@ -249,6 +249,7 @@ CUDA_ROUTINE_HANDLER(SetDevice) {
         int device = input_buffer->Get<int>();
         LOG4CPLUS_DEBUG(pThis->GetLogger(), "SetDevice: " << device);
         cudaError_t exit_code = cudaSetDevice(device);
+        if (exit_code == cudaSuccess) pThis->Place(device);
         return std::make_shared<Result>(exit_code);
     } catch (const std::exception& e) {
         LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
@@ -44,6 +44,21 @@ CUDA_ROUTINE_HANDLER(GetErrorString) {
     }
 }
 
+CUDA_ROUTINE_HANDLER(GetErrorName) {
+    /* const char* cudaGetErrorName(cudaError_t error) */
+
+    try {
+        cudaError_t error = input_buffer->Get<cudaError_t>();
+        std::shared_ptr<Buffer> output_buffer = std::make_shared<Buffer>();
+
+        output_buffer->AddString(cudaGetErrorName(error));
+        return std::make_shared<Result>(cudaSuccess, output_buffer);
+    } catch (const std::exception& e) {
+        cerr << e.what() << endl;
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
+}
+
 CUDA_ROUTINE_HANDLER(PeekAtLastError) {
     /* cudaError_t  cudaPeekAtLastError(void) */
     return std::make_shared<Result>(cudaPeekAtLastError());
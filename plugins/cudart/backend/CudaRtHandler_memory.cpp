@@ -26,6 +26,10 @@
  *             Department of Computer Science, University College Dublin
  */
 
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
 #include "CudaRtHandler.h"
 #include "CudaUtil.h"
 
@@ -39,6 +43,88 @@ using gvirtus::common::mappedPointer;
 // Value: Backend pinned pointer allocated via cudaHostRegister.
 unordered_map<void *, void *> hostRegisteredMap;
 
+namespace {
+
+// The host memory shared with a frontend on this host (see CudaRtPinned.h in
+// the frontend), mapped by the backend.
+struct Mirror {
+    size_t size;
+    bool registered;
+};
+
+/* Unregisters mirror if it was page-locked, then unmaps it. */
+cudaError_t Unmap(void *mirror, const Mirror &found) {
+    cudaError_t exit_code = found.registered ? cudaHostUnregister(mirror) : cudaSuccess;
+    munmap(mirror, found.size);
+    return exit_code;
+}
+
+// The mirrors of a frontend process, by the start of their mapping. Every
+// connection of the process holds them from its start (see PinnedAttach), so
+// those it did not free are released with the last of its connections.
+struct Mirrors {
+    std::mutex mutex;
+    map<uintptr_t, Mirror> mapped;
+
+    ~Mirrors() {
+        for (auto &it : mapped) Unmap((void *)it.first, it.second);
+    }
+
+    /* Whether count bytes from address lie in one mirror. */
+    bool Holds(const void *address, size_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = mapped.upper_bound((uintptr_t)address);
+        if (it == mapped.begin()) return false;
+        --it;
+        return (uintptr_t)address + count <= it->first + it->second.size;
+    }
+};
+
+std::mutex gMirrorsMutex;
+/* by the key the frontend process sends */
+map<uint64_t, std::weak_ptr<Mirrors>> gMirrors;
+
+// The mirrors held by the connection of this thread: every connection is
+// served by a thread of its own, which lets them go when it ends.
+thread_local map<uint64_t, std::shared_ptr<Mirrors>> tsMirrors;
+
+/* The mirrors of process, which the connection of this thread now holds. */
+std::shared_ptr<Mirrors> GetMirrors(uint64_t process) {
+    std::shared_ptr<Mirrors> &held = tsMirrors[process];
+    if (held != nullptr) return held;
+    std::lock_guard<std::mutex> lock(gMirrorsMutex);
+    held = gMirrors[process].lock();
+    if (held != nullptr) return held;
+    for (auto it = gMirrors.begin(); it != gMirrors.end();)
+        it = it->second.expired() ? gMirrors.erase(it) : std::next(it);
+    held = std::make_shared<Mirrors>();
+    gMirrors[process] = held;
+    return held;
+}
+
+std::shared_ptr<Result> MemcpyPinned(std::shared_ptr<Buffer> input_buffer, bool async) {
+    uint64_t process = input_buffer->Get<uint64_t>();
+    void *dst = input_buffer->GetFromMarshal<void *>();
+    void *src = input_buffer->GetFromMarshal<void *>();
+    size_t count = input_buffer->Get<size_t>();
+    cudaMemcpyKind kind = input_buffer->Get<cudaMemcpyKind>();
+    cudaStream_t stream = async ? input_buffer->GetFromMarshal<cudaStream_t>() : NULL;
+
+    // only between the device and a mirror, or a frontend could reach any memory of the backend
+    if (kind != cudaMemcpyHostToDevice && kind != cudaMemcpyDeviceToHost)
+        return std::make_shared<Result>(cudaErrorInvalidMemcpyDirection);
+    if (!GetMirrors(process)->Holds(kind == cudaMemcpyHostToDevice ? src : dst, count))
+        return std::make_shared<Result>(cudaErrorInvalidValue);
+
+    cudaError_t exit_code = async ? cudaMemcpyAsync(dst, src, count, kind, stream)
+                                  : cudaMemcpy(dst, src, count, kind);
+    // an output keeps the copy out of macro replays: the memory may change before one runs it
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    out->Add(count);
+    return std::make_shared<Result>(exit_code, out);
+}
+}  // namespace
+
 CUDA_ROUTINE_HANDLER(MemGetInfo) {
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     size_t *free = out->Delegate<size_t>();
@@ -111,6 +197,22 @@ CUDA_ROUTINE_HANDLER(MemcpyPeerAsync) {
     }
 }
 
+CUDA_ROUTINE_HANDLER(MemcpyPeer) {
+    try {
+        void *dst = input_buffer->GetFromMarshal<void *>();
+        int dstDevice = input_buffer->Get<int>();
+        void *src = input_buffer->GetFromMarshal<void *>();
+        int srcDevice = input_buffer->Get<int>();
+        size_t count = input_buffer->Get<size_t>();
+
+        cudaError_t exit_code = cudaMemcpyPeer(dst, dstDevice, src, srcDevice, count);
+        return std::make_shared<Result>(exit_code);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
+}
+
 CUDA_ROUTINE_HANDLER(MallocManaged) {
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "MallocManaged");
 
@@ -900,4 +1002,113 @@ CUDA_ROUTINE_HANDLER(HostUnregister) {
         cerr << e.what() << endl;
         return std::make_shared<Result>(cudaErrorHostMemoryNotRegistered);
     }
-}
\ No newline at end of file
+}
+
+CUDA_ROUTINE_HANDLER(HostAlloc) {
+    try {
+        uint64_t process = input_buffer->Get<uint64_t>();
+        string name = input_buffer->AssignString();
+        size_t size = input_buffer->Get<size_t>();
+        unsigned int flags = input_buffer->Get<unsigned int>();
+        uint64_t nonce = input_buffer->Get<uint64_t>();
+
+        // the frontend created the segment: a backend on another host has none of this name
+        int fd = shm_open(name.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+        if (fd == -1) return std::make_shared<Result>(cudaErrorNotSupported);
+        struct stat st;
+        if (fstat(fd, &st) == -1 || (size_t)st.st_size < size) {
+            close(fd);
+            return std::make_shared<Result>(cudaErrorNotSupported);
+        }
+        void *mirror = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mirror == MAP_FAILED) return std::make_shared<Result>(cudaErrorMemoryAllocation);
+        // in another mount namespace, the same name is another segment
+        if (memcmp(mirror, &nonce, sizeof(nonce)) != 0) {
+            munmap(mirror, size);
+            return std::make_shared<Result>(cudaErrorNotSupported);
+        }
+
+        // portable and mapped, as cudaHostAlloc() memory is with unified addressing
+        cudaError_t status =
+            cudaHostRegister(mirror, size, cudaHostRegisterPortable | cudaHostRegisterMapped);
+        if (status != cudaSuccess) {
+            // still shared: the copies only lose their DMA
+            cudaGetLastError();
+            LOG4CPLUS_WARN(pThis->GetLogger(), "Cannot page-lock " << size << " bytes of "
+                                                                   << name << ": "
+                                                                   << cudaGetErrorString(status));
+        }
+        LOG4CPLUS_DEBUG(pThis->GetLogger(), "Mapped " << name << " at " << mirror << ", flags "
+                                                      << flags);
+        {
+            std::shared_ptr<Mirrors> mirrors = GetMirrors(process);
+            std::lock_guard<std::mutex> lock(mirrors->mutex);
+            mirrors->mapped[(uintptr_t)mirror] = Mirror{size, status == cudaSuccess};
+        }
+
+        std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+        out->AddMarshal(mirror);
+        return std::make_shared<Result>(cudaSuccess, out);
+    } catch (const std::exception &e) {
+        cerr << e.what() << endl;
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
+}
+
+CUDA_ROUTINE_HANDLER(FreeHost) {
+    uint64_t process = input_buffer->Get<uint64_t>();
+    void *mirror = input_buffer->GetFromMarshal<void *>();
+    std::shared_ptr<Mirrors> mirrors = GetMirrors(process);
+    Mirror found;
+    {
+        std::lock_guard<std::mutex> lock(mirrors->mutex);
+        auto it = mirrors->mapped.find((uintptr_t)mirror);
+        if (it == mirrors->mapped.end()) return std::make_shared<Result>(cudaErrorInvalidValue);
+        found = it->second;
+        mirrors->mapped.erase(it);
+    }
+    return std::make_shared<Result>(Unmap(mirror, found));
+}
+
+CUDA_ROUTINE_HANDLER(HostGetDevicePointer) {
+    uint64_t process = input_buffer->Get<uint64_t>();
+    void *host = input_buffer->GetFromMarshal<void *>();
+    unsigned int flags = input_buffer->Get<unsigned int>();
+    if (!GetMirrors(process)->Holds(host, 1))
+        return std::make_shared<Result>(cudaErrorInvalidValue);
+
+    void *device = NULL;
+    cudaError_t exit_code = cudaHostGetDevicePointer(&device, host, flags);
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    out->AddMarshal(device);
+    return std::make_shared<Result>(exit_code, out);
+}
+
+CUDA_ROUTINE_HANDLER(MemcpyPinned) {
+    try {
+        return MemcpyPinned(input_buffer, false);
+    } catch (const std::exception &e) {
+        cerr << e.what() << endl;
+        return std::make_shared<Result>(cudaErrorInvalidValue);
+    }
+}
+
+CUDA_ROUTINE_HANDLER(MemcpyPinnedAsync) {
+    try {
+        return MemcpyPinned(input_buffer, true);
+    } catch (const std::exception &e) {
+        cerr << e.what() << endl;
+        return std::make_shared<Result>(cudaErrorInvalidValue);
+    }
+}
+
+CUDA_ROUTINE_HANDLER(PinnedAttach) {
+    try {
+        GetMirrors(input_buffer->Get<uint64_t>());
+        return std::make_shared<Result>(cudaSuccess);
+    } catch (const std::exception &e) {
+        cerr << e.what() << endl;
+        return std::make_shared<Result>(cudaErrorInvalidValue);
+    }
+}
@@ -0,0 +1,434 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/*
+ * The backend's end of the notification channel. A session is a frontend
+ * process. Nothing here blocks a stream on the frontend, nor runs long on
+ * the callback thread of the runtime, which all sessions share:
+ *
+ * - the completions of records and markers come from a thread that polls
+ *   events of its own, recorded after them, with cudaEventQuery;
+ * - a callback of the application is a host function that only pushes its
+ *   notification, followed by a wait of the stream on a pinned flag that the
+ *   ack of the frontend sets.
+ */
+
+#include <cuda.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CudaRtHandler.h"
+#include "CudaRtNotification.h"
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+using std::chrono::steady_clock;
+
+namespace {
+
+/*
+ * A session that has not polled for this long, with notifications it never
+ * took, belongs to a frontend that is gone.
+ */
+constexpr seconds STALE_AFTER(30);
+
+/* How often the poller queries the events it watches. */
+constexpr microseconds POLL_INTERVAL(100);
+
+/* How many flags a pinned allocation of FlagPool holds. */
+constexpr size_t FLAGS_PER_CHUNK = 1024;
+
+/*
+ * The pinned, mapped words the streams wait on until the frontend ran a
+ * callback: a stream waits for its flag to become 1.
+ */
+class FlagPool {
+   public:
+    /* nullptr if the pinned memory cannot be allocated. */
+    volatile uint32_t* Take() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mFree.empty()) {
+            void* chunk;
+            if (cudaHostAlloc(&chunk, FLAGS_PER_CHUNK * sizeof(uint32_t),
+                              cudaHostAllocPortable | cudaHostAllocMapped) != cudaSuccess)
+                return nullptr;
+            for (size_t i = 0; i < FLAGS_PER_CHUNK; i++)
+                mFree.push_back(static_cast<volatile uint32_t*>(chunk) + i);
+        }
+        volatile uint32_t* flag = mFree.back();
+        mFree.pop_back();
+        *flag = 0;
+        return flag;
+    }
+
+    /* Once the stream waiting on flag went past the wait. */
+    void Give(volatile uint32_t* flag) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFree.push_back(flag);
+    }
+
+   private:
+    std::mutex mMutex;
+    std::vector<volatile uint32_t*> mFree;
+};
+
+FlagPool gFlags;
+
+struct Session {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<CudaRtNotification> pending;
+    /* the flags of the callbacks the frontend has not run yet */
+    std::map<uint64_t, volatile uint32_t*> waiting;
+    bool polling = false;
+    bool closed = false;
+    steady_clock::time_point lastPoll = steady_clock::now();
+
+    /* Called with mutex held. */
+    bool Stale() const { return !polling && steady_clock::now() - lastPoll > STALE_AFTER; }
+
+    void Push(const CudaRtNotification& notification) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(notification);
+        changed.notify_all();
+    }
+
+    /* Called with mutex held: lets the stream of callback seq go on. */
+    void Release(uint64_t seq) {
+        auto it = waiting.find(seq);
+        if (it == waiting.end()) return;
+        *it->second = 1;
+        waiting.erase(it);
+    }
+
+    /* Called with mutex held, when the frontend is gone. */
+    void ReleaseAll() {
+        for (auto& flag : waiting) *flag.second = 1;
+        waiting.clear();
+    }
+};
+
+std::mutex gSessionsMutex;
+std::map<uint64_t, std::shared_ptr<Session>> gSessions;
+
+std::shared_ptr<Session> GetSession(uint64_t id) {
+    std::lock_guard<std::mutex> lock(gSessionsMutex);
+    auto& session = gSessions[id];
+    if (session == nullptr) session = std::make_shared<Session>();
+    return session;
+}
+
+/* Drops the sessions of the frontends that are gone, and lets their streams go on. */
+void DropStaleSessions() {
+    std::lock_guard<std::mutex> lock(gSessionsMutex);
+    for (auto it = gSessions.begin(); it != gSessions.end();) {
+        std::lock_guard<std::mutex> session_lock(it->second->mutex);
+        if (it->second->Stale() && (!it->second->pending.empty() || !it->second->waiting.empty())) {
+            it->second->ReleaseAll();
+            it = gSessions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/* An event of the backend, recorded after the work whose completion it pushes. */
+struct Watch {
+    std::shared_ptr<Session> session;
+    cudaEvent_t event;
+    CudaRtNotification notification;
+};
+
+/*
+ * The thread that queries the watched events, started by the first watch. It
+ * also drops stale sessions, whose streams may wait on flags.
+ */
+class Poller {
+   public:
+    void Add(const Watch& watch) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mWatches.push_back(watch);
+        StartLocked();
+        mChanged.notify_all();
+    }
+
+    /* Starts the thread without a watch, for the flags of stale sessions. */
+    void Start() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        StartLocked();
+    }
+
+   private:
+    /* Called with mMutex held. */
+    void StartLocked() {
+        if (mStarted) return;
+        std::thread(&Poller::Run, this).detach();
+        mStarted = true;
+    }
+
+    void Run() {
+        std::vector<Watch> watches;
+        steady_clock::time_point dropped = steady_clock::now();
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                if (watches.empty() && mWatches.empty())
+                    mChanged.wait_for(lock, seconds(1), [this] { return !mWatches.empty(); });
+                watches.insert(watches.end(), mWatches.begin(), mWatches.end());
+                mWatches.clear();
+            }
+            for (auto it = watches.begin(); it != watches.end();) {
+                cudaError_t status = cudaEventQuery(it->event);
+                if (status == cudaErrorNotReady) {
+                    ++it;
+                    continue;
+                }
+                it->notification.status = status;
+                it->session->Push(it->notification);
+                cudaEventDestroy(it->event);
+                it = watches.erase(it);
+            }
+            if (steady_clock::now() - dropped > seconds(1)) {
+                DropStaleSessions();
+                dropped = steady_clock::now();
+            }
+            if (!watches.empty()) std::this_thread::sleep_for(POLL_INTERVAL);
+        }
+    }
+
+    std::mutex mMutex;
+    std::condition_variable mChanged;
+    std::vector<Watch> mWatches;
+    bool mStarted = false;
+};
+
+/* Never freed: its thread outlives static destructors. */
+Poller& GetPoller() {
+    static Poller* poller = new Poller();
+    return *poller;
+}
+
+/*
+ * Whether work added to stream would be captured in a graph rather than run,
+ * so that work of the backend would run once per launch of the graph.
+ */
+bool Capturing(cudaStream_t stream) {
+    cudaStreamCaptureStatus status;
+    return cudaStreamIsCapturing(stream, &status) != cudaSuccess ||
+           status != cudaStreamCaptureStatusNone;
+}
+
+/* Pushes notification to session once the work on stream before it is done. */
+bool Notify(cudaStream_t stream, uint64_t session, CudaRtNotification notification) {
+    cudaEvent_t event;
+    if (cudaEventCreateWithFlags(&event, cudaEventDisableTiming) != cudaSuccess) return false;
+    if (cudaEventRecord(event, stream) != cudaSuccess) {
+        cudaEventDestroy(event);
+        return false;
+    }
+    GetPoller().Add({GetSession(session), event, notification});
+    return true;
+}
+
+/* What a host function of the backend pushes, and to whom. */
+struct Pending {
+    std::shared_ptr<Session> session;
+    CudaRtNotification notification;
+};
+
+void CUDART_CB PushCallback(cudaStream_t, cudaError_t status, void* data) {
+    std::unique_ptr<Pending> pending(static_cast<Pending*>(data));
+    pending->notification.status = status;
+    pending->session->Push(pending->notification);
+}
+
+void CUDART_CB PushHostFunc(void* data) { PushCallback(NULL, cudaSuccess, data); }
+
+void CUDART_CB GiveFlag(void* flag) { gFlags.Give(static_cast<volatile uint32_t*>(flag)); }
+
+/*
+ * Adds callback seq of session to stream: push enqueues the host function
+ * that pushes it, and the stream then waits for the ack of the frontend.
+ */
+cudaError_t Schedule(cudaStream_t stream, uint64_t id, uint64_t seq,
+                     const std::function<cudaError_t(Pending*)>& push) {
+    /* a captured callback would run at each launch of the graph */
+    if (Capturing(stream)) return cudaErrorStreamCaptureUnsupported;
+    volatile uint32_t* flag = gFlags.Take();
+    if (flag == nullptr) return cudaErrorMemoryAllocation;
+    auto session = GetSession(id);
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->waiting[seq] = flag;
+    }
+    GetPoller().Start();
+    auto pending = new Pending{session, {CudaRtNotification::CALLBACK, cudaSuccess, 0, seq}};
+    cudaError_t exit_code = push(pending);
+    if (exit_code != cudaSuccess) delete pending;
+    void* device;
+    if (exit_code == cudaSuccess &&
+        (cudaHostGetDevicePointer(&device, (void*)flag, 0) != cudaSuccess ||
+         cuStreamWaitValue32((CUstream)stream, (CUdeviceptr)device, 1, CU_STREAM_WAIT_VALUE_EQ) !=
+             CUDA_SUCCESS))
+        /* the frontend drops the callback on an error, so its push does no harm */
+        exit_code = cudaErrorNotSupported;
+    if (exit_code != cudaSuccess) {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->waiting.erase(seq);
+        gFlags.Give(flag);
+        return exit_code;
+    }
+    /* if this fails the flag is lost rather than reused while the stream waits on it */
+    cudaLaunchHostFunc(stream, GiveFlag, (void*)flag);
+    return cudaSuccess;
+}
+}  // namespace
+
+CUDA_ROUTINE_HANDLER(EventRecordNotify) {
+    try {
+        cudaEvent_t event = input_buffer->Get<cudaEvent_t>();
+        cudaStream_t stream = input_buffer->Get<cudaStream_t>();
+        unsigned int flags = input_buffer->Get<unsigned int>();
+        uint64_t session = input_buffer->Get<uint64_t>();
+        uint64_t seq = input_buffer->Get<uint64_t>();
+        bool capturing = Capturing(stream);
+        cudaError_t exit_code = cudaEventRecordWithFlags(event, stream, flags);
+        bool tracked = false;
+        if (exit_code == cudaSuccess && !capturing)
+            tracked = Notify(stream, session,
+                             {CudaRtNotification::EVENT, cudaSuccess, (uint64_t)event, seq});
+        std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+        out->Add<bool>(tracked);
+        return std::make_shared<Result>(exit_code, out);
+    } catch (const std::exception& e) {
+        cerr << e.what() << endl;
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
+}
+
+CUDA_ROUTINE_HANDLER(StreamQueryNotify) {
+    try {
+        cudaStream_t stream = input_buffer->Get<cudaStream_t>();
+        uint64_t session = input_buffer->Get<uint64_t>();
+        uint64_t seq = input_buffer->Get<uint64_t>();
+        cudaError_t exit_code = cudaStreamQuery(stream);
+        bool tracked = false;
+        if (exit_code == cudaErrorNotReady && !Capturing(stream))
+            tracked = Notify(stream, session,
+                             {CudaRtNotification::STREAM, cudaSuccess, (uint64_t)stream, seq});
+        std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+        out->Add<bool>(tracked);
+        return std::make_shared<Result>(exit_code, out);
+    } catch (const std::exception& e) {
+        cerr << e.what() << endl;
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
+}
+
+CUDA_ROUTINE_HANDLER(StreamAddCallback) {
+    try {
+        cudaStream_t stream = input_buffer->Get<cudaStream_t>();
+        uint64_t session = input_buffer->Get<uint64_t>();
+        uint64_t seq = input_buffer->Get<uint64_t>();
+        unsigned int flags = input_buffer->Get<unsigned int>();
+        cudaError_t exit_code = Schedule(stream, session, seq, [&](Pending* pending) {
+            return cudaStreamAddCallback(stream, PushCallback, pending, flags);
+        });
+        return std::make_shared<Result>(exit_code);
+    } catch (const std::exception& e) {
+        cerr << e.what() << endl;
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
+}
+
+CUDA_ROUTINE_HANDLER(LaunchHostFunc) {
+    try {
+        cudaStream_t stream = input_buffer->Get<cudaStream_t>();
+        uint64_t session = input_buffer->Get<uint64_t>();
+        uint64_t seq = input_buffer->Get<uint64_t>();
+        cudaError_t exit_code = Schedule(stream, session, seq, [&](Pending* pending) {
+            return cudaLaunchHostFunc(stream, PushHostFunc, pending);
+        });
+        return std::make_shared<Result>(exit_code);
+    } catch (const std::exception& e) {
+        cerr << e.what() << endl;
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
+}
+
+CUDA_ROUTINE_HANDLER(NotificationsWait) {
+    try {
+        auto session = GetSession(input_buffer->Get<uint64_t>());
+        auto timeout = milliseconds(input_buffer->Get<unsigned int>());
+        size_t acks = input_buffer->Get<size_t>();
+        uint64_t* ack = input_buffer->Assign<uint64_t>(acks);
+        std::vector<CudaRtNotification> notifications;
+        {
+            std::unique_lock<std::mutex> lock(session->mutex);
+            for (size_t i = 0; i < acks; i++) session->Release(ack[i]);
+            session->polling = true;
+            session->changed.wait_for(lock, timeout, [&session] {
+                return !session->pending.empty() || session->closed;
+            });
+            notifications.swap(session->pending);
+            session->polling = false;
+            session->lastPoll = steady_clock::now();
+        }
+        std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+        out->Add<size_t>(notifications.size());
+        out->Add(notifications.data(), notifications.size());
+        return std::make_shared<Result>(cudaSuccess, out);
+    } catch (const std::exception& e) {
+        cerr << e.what() << endl;
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
+}
+
+CUDA_ROUTINE_HANDLER(NotificationsClose) {
+    try {
+        uint64_t id = input_buffer->Get<uint64_t>();
+        std::shared_ptr<Session> session;
+        {
+            std::lock_guard<std::mutex> lock(gSessionsMutex);
+            auto it = gSessions.find(id);
+            if (it == gSessions.end()) return std::make_shared<Result>(cudaSuccess);
+            session = it->second;
+            gSessions.erase(it);
+        }
+        /* releases the streams still waiting for the callbacks of the session */
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->ReleaseAll();
+        session->closed = true;
+        session->changed.notify_all();
+        return std::make_shared<Result>(cudaSuccess);
+    } catch (const std::exception& e) {
+        cerr << e.what() << endl;
+        return std::make_shared<Result>(cudaErrorMemoryAllocation);
+    }
+}
@@ -28,11 +28,24 @@
 
 #include "CudaRtHandler.h"
 
+/* the stream priority of the scheduler class of the session served by this thread */
+static thread_local int tsStreamPriority = 0;
+
+void CudaRtHandler::StreamPriority(int rank) { tsStreamPriority = rank; }
+
+/* cudaStreamCreateWithFlags(), at the priority of the class of the session if it has one. */
+static cudaError_t CreateStream(cudaStream_t *pStream, unsigned int flags) {
+    int least, greatest;
+    if (tsStreamPriority == 0 || cudaDeviceGetStreamPriorityRange(&least, &greatest) != cudaSuccess)
+        return cudaStreamCreateWithFlags(pStream, flags);
+    return cudaStreamCreateWithPriority(pStream, flags, tsStreamPriority > 0 ? greatest : least);
+}
+
 CUDA_ROUTINE_HANDLER(StreamCreate) {
     try {
         std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
         cudaStream_t pStream;
-        cudaError_t exit_code = cudaStreamCreate(&pStream);
+        cudaError_t exit_code = CreateStream(&pStream, cudaStreamDefault);
         out->Add<cudaStream_t>(pStream);
         return std::make_shared<Result>(exit_code, out);
     } catch (const std::exception& e) {
@@ -62,7 +75,7 @@ CUDA_ROUTINE_HANDLER(StreamCreateWithFlags) {
         std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
         cudaStream_t pStream;
         unsigned int flags = input_buffer->Get<unsigned int>();
-        cudaError_t exit_code = cudaStreamCreateWithFlags(&pStream, flags);
+        cudaError_t exit_code = CreateStream(&pStream, flags);
         out->Add<cudaStream_t>(pStream);
         return std::make_shared<Result>(exit_code, out);
     } catch (const std::exception& e) {
@@ -247,17 +260,3 @@ CUDA_ROUTINE_HANDLER(StreamGetCaptureInfo) {
         return std::make_shared<Result>(cudaErrorMemoryAllocation);
     }
 }
-/*
-CUDA_ROUTINE_HANDLER(StreamAddCallback) {
-    try {
-        cudaStream_t stream = input_buffer->Get<cudaStream_t>();
-        cudaStreamCallback_t callback = input_buffer->Get<cudaStreamCallback_t>();
-        void* userData = input_buffer->GetFromMarshal<void*>();
-        unsigned int flags = input_buffer->Get<unsigned int>();
-        return std::make_shared<Result>(cudaStreamAddCallback(stream, callback, userData, flags));
-    } catch (const std::exception& e) {
-        cerr << e.what() << endl;
-        return std::make_shared<Result>(cudaErrorMemoryAllocation);
-    }
-}
-*/
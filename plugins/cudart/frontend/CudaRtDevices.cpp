@@ -0,0 +1,250 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CudaRtDevices.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CudaRt.h"
+
+using gvirtus::communicators::Buffer;
+using gvirtus::frontend::Frontend;
+using namespace std;
+
+namespace {
+
+struct State {
+    mutex stateMutex;
+    bool counted = false;
+    /* the backend of each device, and its number there */
+    vector<pair<size_t, int>> devices;
+    /* by backend: the end of each object and allocation it created, by its start */
+    vector<map<uintptr_t, uintptr_t>> owned;
+};
+
+/* Never freed: the exit handlers of the application may still free memory. */
+State &GetState() {
+    static State *state = new State();
+    return *state;
+}
+
+/*
+ * The registrations of the process, in order, and the backends that got all
+ * of them. The lock is recursive since Register() may connect to a backend,
+ * which replays them.
+ */
+struct Registrations {
+    recursive_mutex registrationsMutex;
+    vector<pair<string, shared_ptr<Buffer>>> calls;
+    set<size_t> reached;
+};
+
+Registrations &GetRegistrations() {
+    static Registrations *registrations = new Registrations();
+    return *registrations;
+}
+
+/* Called on a thread that connected to backend: replays the registrations there once. */
+void Replay(size_t backend) {
+    Registrations &registrations = GetRegistrations();
+    lock_guard<recursive_mutex> lock(registrations.registrationsMutex);
+    if (!registrations.reached.insert(backend).second) return;
+    for (auto &call : registrations.calls)
+        CudaRtFrontend::Execute(call.first.c_str(), call.second.get());
+}
+
+const bool replaying = (Frontend::AddConnectHook(Replay), true);
+
+/* Called with the lock of the state held. */
+bool Holds(const State &state, size_t backend, uintptr_t address) {
+    if (backend >= state.owned.size()) return false;
+    auto &owned = state.owned[backend];
+    auto it = owned.upper_bound(address);
+    return it != owned.begin() && address < prev(it)->second;
+}
+}  // namespace
+
+bool CudaRtDevices::Enabled() {
+    Frontend *frontend = Frontend::GetFrontend();
+    return frontend != nullptr && frontend->GetBackendCount() > 1;
+}
+
+size_t CudaRtDevices::Backend() { return Frontend::GetFrontend()->GetBackend(); }
+
+cudaError_t CudaRtDevices::Count(int *count) {
+    State &state = GetState();
+    lock_guard<mutex> lock(state.stateMutex);
+    if (!state.counted) {
+        size_t backends = Frontend::GetFrontend()->GetBackendCount();
+        for (size_t backend = 0; backend < backends; backend++) {
+            Route route(backend);
+            int devices = 0;
+            bool answered = false;
+            if (route) {
+                CudaRtFrontend::Prepare();
+                CudaRtFrontend::AddHostPointerForArguments(&devices);
+                CudaRtFrontend::Execute("cudaGetDeviceCount");
+                answered = CudaRtFrontend::Success();
+                if (answered) devices = *CudaRtFrontend::GetOutputHostPointer<int>();
+            }
+            if (!answered)
+                cerr << "[GVIRTUS WARNING] Backend " << backend
+                     << " cannot be reached: its devices are left out" << endl;
+            for (int local = 0; local < devices; local++)
+                state.devices.emplace_back(backend, local);
+        }
+        state.counted = true;
+    }
+    if (state.devices.empty()) return cudaErrorNoDevice;
+    *count = state.devices.size();
+    return cudaSuccess;
+}
+
+bool CudaRtDevices::Locate(int device, size_t *backend, int *local) {
+    if (!Enabled()) {
+        *backend = Backend();
+        *local = device;
+        return true;
+    }
+    int count = 0;
+    if (Count(&count) != cudaSuccess || device < 0 || device >= count) return false;
+    State &state = GetState();
+    lock_guard<mutex> lock(state.stateMutex);
+    *backend = state.devices[device].first;
+    *local = state.devices[device].second;
+    return true;
+}
+
+int CudaRtDevices::Global(size_t backend, int local) {
+    if (!Enabled()) return local;
+    int count = 0;
+    if (Count(&count) != cudaSuccess) return -1;
+    State &state = GetState();
+    lock_guard<mutex> lock(state.stateMutex);
+    auto it = find(state.devices.begin(), state.devices.end(), make_pair(backend, local));
+    return it != state.devices.end() ? it - state.devices.begin() : -1;
+}
+
+void CudaRtDevices::Own(const void *object, size_t size) {
+    if (object == nullptr || !Enabled()) return;
+    size_t backend = Backend();
+    State &state = GetState();
+    lock_guard<mutex> lock(state.stateMutex);
+    if (state.owned.size() <= backend) state.owned.resize(backend + 1);
+    state.owned[backend][(uintptr_t)object] = (uintptr_t)object + max<size_t>(size, 1);
+}
+
+void CudaRtDevices::Disown(const void *object) {
+    if (object == nullptr || !Enabled()) return;
+    size_t current = Backend();
+    State &state = GetState();
+    lock_guard<mutex> lock(state.stateMutex);
+    if (current < state.owned.size() && state.owned[current].erase((uintptr_t)object)) return;
+    for (auto &owned : state.owned)
+        if (owned.erase((uintptr_t)object)) return;
+}
+
+size_t CudaRtDevices::Owner(const void *object) {
+    size_t current = Backend();
+    if (object == nullptr || !Enabled()) return current;
+    State &state = GetState();
+    lock_guard<mutex> lock(state.stateMutex);
+    if (Holds(state, current, (uintptr_t)object)) return current;
+    for (size_t backend = 0; backend < state.owned.size(); backend++)
+        if (Holds(state, backend, (uintptr_t)object)) return backend;
+    return current;
+}
+
+bool CudaRtDevices::Ambiguous(const void *object) {
+    if (object == nullptr || !Enabled()) return false;
+    State &state = GetState();
+    lock_guard<mutex> lock(state.stateMutex);
+    int holders = 0;
+    for (size_t backend = 0; backend < state.owned.size(); backend++)
+        if (Holds(state, backend, (uintptr_t)object)) holders++;
+    return holders > 1;
+}
+
+void CudaRtDevices::Register(const char *routine, const Buffer *input) {
+    if (input == NULL) input = Frontend::GetFrontend()->GetInputBuffer();
+    if (!Enabled()) {
+        CudaRtFrontend::Execute(routine, input);
+        return;
+    }
+    Registrations &registrations = GetRegistrations();
+    lock_guard<recursive_mutex> lock(registrations.registrationsMutex);
+    registrations.calls.emplace_back(routine, make_shared<Buffer>(*input));
+    const Buffer *call = registrations.calls.back().second.get();
+    /* the current backend got the earlier ones, at connection or as the first */
+    size_t current = Backend();
+    registrations.reached.insert(current);
+    for (size_t backend : registrations.reached) {
+        if (backend == current) continue;
+        Route route(backend);
+        if (route) CudaRtFrontend::Execute(routine, call);
+    }
+    CudaRtFrontend::Execute(routine, call);
+}
+
+cudaError_t CudaRtDevices::Stage(void *dst, size_t dstBackend, const void *src, size_t srcBackend,
+                                 size_t count) {
+    vector<char> staging(min(count, STAGING_CHUNK));
+    for (size_t done = 0; done < count; done += staging.size()) {
+        size_t chunk = min(count - done, staging.size());
+        cudaError_t result;
+        {
+            Route route(srcBackend);
+            if (!route) return cudaErrorDevicesUnavailable;
+            result = cudaMemcpy(staging.data(), (const char *)src + done, chunk,
+                                cudaMemcpyDeviceToHost);
+        }
+        if (result != cudaSuccess) return result;
+        {
+            Route route(dstBackend);
+            if (!route) return cudaErrorDevicesUnavailable;
+            result = cudaMemcpy((char *)dst + done, staging.data(), chunk, cudaMemcpyHostToDevice);
+        }
+        if (result != cudaSuccess) return result;
+    }
+    return cudaSuccess;
+}
+
+CudaRtDevices::Route::Route(size_t backend) {
+    Frontend *frontend = Frontend::GetFrontend();
+    mPrevious = frontend->GetBackend();
+    if (backend == mPrevious) return;
+    mReached = frontend->SetBackend(backend);
+    mSwitched = mReached;
+}
+
+CudaRtDevices::Route::~Route() {
+    if (mSwitched) Frontend::GetFrontend()->SetBackend(mPrevious);
+}
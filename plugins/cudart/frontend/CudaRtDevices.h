@@ -0,0 +1,118 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   CudaRtDevices.h
+ *
+ * @brief  The devices of all the backends of the configuration, as one list.
+ *
+ * When properties.json lists several backends, the frontend numbers their
+ * devices one after the other: the devices of the first backend, then those
+ * of the second, and so on. cudaSetDevice() sends the calls of the thread to
+ * the backend of the device, where they run on its own number for it.
+ *
+ * Streams, events and device memory are recorded with the backend that
+ * created them, so that the calls on them go there whatever the current
+ * device. Addresses of different backends may overlap; an address is looked
+ * up on the current backend first. Copies between devices of different
+ * backends are staged through the frontend, and a copy between device
+ * memory at an address several backends hold fails rather than guess.
+ *
+ * The registrations of the kernels and variables of the application reach
+ * every backend: a backend the process connects to later gets all those
+ * made before.
+ *
+ * With a single backend nothing is recorded and device numbers pass through.
+ */
+
+#ifndef _CUDARTDEVICES_H
+#define _CUDARTDEVICES_H
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+
+namespace gvirtus::communicators {
+class Buffer;
+}
+
+class CudaRtDevices {
+   public:
+    /* Whether the configuration lists more than one backend. */
+    static bool Enabled();
+
+    /* The number of devices of all the backends, asked of each the first time. */
+    static cudaError_t Count(int *count);
+
+    /* The backend of device and the number the device has there. */
+    static bool Locate(int device, size_t *backend, int *local);
+
+    /* The device numbered local on backend, -1 if there is none. */
+    static int Global(size_t backend, int local);
+
+    /* The backend of the current device of the calling thread. */
+    static size_t Backend();
+
+    /* Records that the current backend created object, or size bytes from it. */
+    static void Own(const void *object, size_t size = 1);
+    static void Disown(const void *object);
+
+    /* The backend that created object or the memory at it; the current one if unknown. */
+    static size_t Owner(const void *object);
+
+    /* Whether more than one backend holds memory at object, so Owner() is a guess. */
+    static bool Ambiguous(const void *object);
+
+    /*
+     * Runs the registration routine, with input or else the prepared one, on
+     * the current backend, and on the others the process reached. The
+     * output is that of the current backend.
+     */
+    static void Register(const char *routine, const gvirtus::communicators::Buffer *input = NULL);
+
+    /*
+     * Copies count bytes between the memory of two backends through the
+     * frontend, in chunks of STAGING_CHUNK bytes.
+     */
+    static cudaError_t Stage(void *dst, size_t dstBackend, const void *src, size_t srcBackend,
+                             size_t count);
+
+    /* Sends the calls of its scope to backend, then back to the current one. */
+    class Route {
+       public:
+        explicit Route(size_t backend);
+        ~Route();
+
+        /* false if backend cannot be reached */
+        explicit operator bool() const { return mReached; }
+
+       private:
+        size_t mPrevious;
+        bool mSwitched = false;
+        bool mReached = true;
+    };
+
+   private:
+    static constexpr size_t STAGING_CHUNK = 64 << 20;
+};
+
+#endif /* _CUDARTDEVICES_H */
@@ -25,6 +25,8 @@
 
 #include "CudaRtFrontend.h"
 
+#include <gvirtus/frontend/Macros.h>
+
 using namespace std;
 
 using gvirtus::common::mappedPointer;
@@ -36,6 +38,25 @@ void __cudaInitModule() {}
 
 CudaRtFrontend msInstance __attribute_used__;
 
+/*
+ * The routines that only enqueue work, which a macro may defer: never the
+ * ones that synchronize, query, or return the errors of earlier work.
+ */
+static const bool deferrable = gvirtus::frontend::Macros::AllowDeferring({
+    "cudaLaunch",
+    "cudaLaunchKernel",
+    "cudaLaunchKernelExC",
+    "cudaPushCallConfiguration",
+    "cudaMemset",
+    "cudaMemset2D",
+    "cudaMemset2DAsync",
+    "cudaMemcpyAsync",
+    "cudaMemcpyPeerAsync",
+    "cudaEventRecord",
+    "cudaEventRecordWithFlags",
+    "cudaGraphLaunch",
+});
+
 map<const void*, mappedPointer>* CudaRtFrontend::mappedPointers = NULL;
 set<const void*>* CudaRtFrontend::devicePointers = NULL;
 map<pthread_t, stack<void*>*>* CudaRtFrontend::toManage = NULL;
@@ -43,6 +64,14 @@ map<pthread_t, stack<void*>*>* CudaRtFrontend::toManage = NULL;
 map<const void*, std::string>* CudaRtFrontend::mapHost2DeviceFunc = NULL;
 map<std::string, NvInfoFunction>* CudaRtFrontend::mapDeviceFunc2InfoFunc = NULL;
 
+std::mutex CudaRtFrontend::occupancyMutex;
+map<CudaRtFrontend::FuncAttributesKey, cudaFuncAttributes>* CudaRtFrontend::funcAttributes =
+    NULL;
+set<const void*>* CudaRtFrontend::cachePreferences = NULL;
+bool CudaRtFrontend::deviceCachePreference = false;
+vector<cudaDeviceProp>* CudaRtFrontend::deviceProperties = NULL;
+bool CudaRtFrontend::homogeneousDevices = false;
+
 CudaRtFrontend::CudaRtFrontend() {
     if (devicePointers == NULL) devicePointers = new set<const void*>();
     if (mappedPointers == NULL) mappedPointers = new map<const void*, mappedPointer>();
@@ -52,5 +81,87 @@ CudaRtFrontend::CudaRtFrontend() {
         mapDeviceFunc2InfoFunc = new map<std::string, NvInfoFunction>();
 
     if (toManage == NULL) toManage = new map<pthread_t, stack<void*>*>();
+    if (funcAttributes == NULL)
+        funcAttributes = new map<FuncAttributesKey, cudaFuncAttributes>();
+    if (cachePreferences == NULL) cachePreferences = new set<const void*>();
     gvirtus::frontend::Frontend::GetFrontend();
-}
\ No newline at end of file
+}
+
+cudaError_t CudaRtFrontend::getFuncAttributes(const void* func, cudaFuncAttributes* attr) {
+    auto frontend = gvirtus::frontend::Frontend::GetFrontend();
+    FuncAttributesKey key(frontend->GetBackend(), frontend->GetDevice(), func);
+    lock_guard<mutex> lock(occupancyMutex);
+    auto it = funcAttributes->find(key);
+    if (it != funcAttributes->end()) {
+        *attr = it->second;
+        return cudaSuccess;
+    }
+    Prepare();
+    AddHostPointerForArguments(attr);
+    AddVariableForArguments((pointer_t)func);
+    Execute("cudaFuncGetAttributes");
+    if (!Success()) return GetExitCode();
+    *attr = *GetOutputHostPointer<cudaFuncAttributes>();
+    funcAttributes->insert(make_pair(key, *attr));
+    return cudaSuccess;
+}
+
+void CudaRtFrontend::forgetFuncAttributes(const void* func) {
+    lock_guard<mutex> lock(occupancyMutex);
+    if (func == NULL) {
+        funcAttributes->clear();
+        cachePreferences->clear();
+    } else {
+        erase_if(*funcAttributes, [func](const auto& item) { return get<2>(item.first) == func; });
+    }
+}
+
+void CudaRtFrontend::setCachePreference(const void* func, bool preferred) {
+    lock_guard<mutex> lock(occupancyMutex);
+    if (func == NULL)
+        deviceCachePreference = preferred;
+    else if (preferred)
+        cachePreferences->insert(func);
+    else
+        cachePreferences->erase(func);
+}
+
+bool CudaRtFrontend::hasCachePreference(const void* func) {
+    lock_guard<mutex> lock(occupancyMutex);
+    return deviceCachePreference || cachePreferences->count(func) > 0;
+}
+
+/* Whether the occupancy calculator gives the same answers on a and b. */
+static bool SameOccupancy(const cudaDeviceProp& a, const cudaDeviceProp& b) {
+    return a.major == b.major && a.minor == b.minor && a.warpSize == b.warpSize &&
+           a.maxThreadsPerMultiProcessor == b.maxThreadsPerMultiProcessor &&
+           a.maxBlocksPerMultiProcessor == b.maxBlocksPerMultiProcessor &&
+           a.regsPerMultiprocessor == b.regsPerMultiprocessor && a.regsPerBlock == b.regsPerBlock &&
+           a.sharedMemPerMultiprocessor == b.sharedMemPerMultiprocessor &&
+           a.reservedSharedMemPerBlock == b.reservedSharedMemPerBlock;
+}
+
+bool CudaRtFrontend::getCurrentDeviceProperties(cudaDeviceProp* prop) {
+    lock_guard<mutex> lock(occupancyMutex);
+    if (deviceProperties == NULL) {
+        int count = 0;
+        if (cudaGetDeviceCount(&count) != cudaSuccess || count <= 0) return false;
+        auto properties = new vector<cudaDeviceProp>(count);
+        for (int device = 0; device < count; device++) {
+            if (cudaGetDeviceProperties(&(*properties)[device], device) != cudaSuccess) {
+                delete properties;
+                return false;
+            }
+        }
+        homogeneousDevices = true;
+        for (auto& other : *properties)
+            homogeneousDevices = homogeneousDevices && SameOccupancy(other, properties->front());
+        deviceProperties = properties;
+    }
+    int device = 0;
+    /* the current device matters only when the devices differ */
+    if (!homogeneousDevices && cudaGetDevice(&device) != cudaSuccess) return false;
+    if (device < 0 || device >= (int)deviceProperties->size()) return false;
+    *prop = (*deviceProperties)[device];
+    return true;
+}
@@ -35,8 +35,11 @@
 
 #include <list>
 #include <map>
+#include <mutex>
 #include <set>
 #include <stack>
+#include <tuple>
+#include <vector>
 
 using namespace std;
 
@@ -278,6 +281,30 @@ class CudaRtFrontend {
         return mapHost2DeviceFunc->find(hostFunc)->second;
     };
 
+    /*
+     * The attributes of func on the current backend and device, asked of the
+     * backend the first time: the occupancy calculator and
+     * cudaFuncGetAttributes read them from here.
+     */
+    static cudaError_t getFuncAttributes(const void* func, cudaFuncAttributes* attr);
+
+    /*
+     * After a call that changes them, of func on every device or, if NULL, of
+     * every function (their cache preferences with them).
+     */
+    static void forgetFuncAttributes(const void* func);
+
+    /*
+     * Records a cache preference of func, or of the device if func is NULL:
+     * it changes the shared memory carveout the backend picks, which the
+     * occupancy calculator does not model.
+     */
+    static void setCachePreference(const void* func, bool preferred);
+    static bool hasCachePreference(const void* func);
+
+    /* The properties of the current device, asked of the backend once per device. */
+    static bool getCurrentDeviceProperties(cudaDeviceProp* prop);
+
     CudaRtFrontend();
 
     static void hexdump(void* ptr, int buflen) {
@@ -306,6 +333,14 @@ class CudaRtFrontend {
     bool configured;
     static map<std::string, NvInfoFunction>* mapDeviceFunc2InfoFunc;
     static map<const void*, std::string>* mapHost2DeviceFunc;
+    static std::mutex occupancyMutex;
+    /* by backend, device and function */
+    typedef tuple<size_t, int, const void*> FuncAttributesKey;
+    static map<FuncAttributesKey, cudaFuncAttributes>* funcAttributes;
+    static set<const void*>* cachePreferences;
+    static bool deviceCachePreference;
+    static vector<cudaDeviceProp>* deviceProperties;
+    static bool homogeneousDevices;
 };
 
 #endif /* CUDARTFRONTEND_H */
@@ -0,0 +1,368 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CudaRtNotifications.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "CudaRt.h"
+#include "CudaRtDevices.h"
+#include "CudaRtNotification.h"
+
+using namespace std;
+
+namespace {
+
+/* The exit code of a routine the backend has no handler for. */
+constexpr int UNKNOWN_ROUTINE = -1;
+
+struct EventState {
+    /* the number of the last record, and whether it completed */
+    uint64_t recorded;
+    bool done;
+    cudaError_t status;
+};
+
+struct State {
+    mutex stateMutex;
+    condition_variable changed;
+    uint64_t session;
+    uint64_t seq = 0;
+    map<cudaEvent_t, EventState> events;
+    /* the marker still pending on a stream that the backend found busy */
+    map<cudaStream_t, uint64_t> markers;
+    /* markers whose cudaStreamQueryNotify has not returned yet */
+    set<uint64_t> inflight;
+    map<uint64_t, function<void(cudaError_t)>> callbacks;
+    thread poller;
+    bool stopping = false;
+    atomic<bool> disabled{false};
+
+    State() {
+        random_device random;
+        session = ((uint64_t)random() << 32 | random()) ^ (uint64_t)getpid();
+        const char *mode = getenv("GVIRTUS_CUDART_NOTIFICATIONS");
+        // the poller waits on a single backend
+        disabled = (mode != NULL && strcmp(mode, "off") == 0) || CudaRtDevices::Enabled();
+    }
+
+    /* Called with mutex held. */
+    bool Outstanding() const {
+        if (!markers.empty() || !inflight.empty() || !callbacks.empty()) return true;
+        for (auto &event : events)
+            if (!event.second.done) return true;
+        return false;
+    }
+
+    /* Called with mutex held: everything is asked of the backend from now on. */
+    void Disable() {
+        disabled = true;
+        events.clear();
+        markers.clear();
+        inflight.clear();
+        if (!callbacks.empty())
+            cerr << "[GVIRTUS WARNING] Dropping " << callbacks.size()
+                 << " stream callback(s): the notification channel failed" << endl;
+        callbacks.clear();
+        changed.notify_all();
+    }
+};
+
+/* Never freed: the poller and the exit handler may outlive static destructors. */
+State &GetState() {
+    static State *state = new State();
+    return *state;
+}
+
+bool Special(cudaStream_t stream) {
+    /* the per-thread stream of the backend depends on the connection */
+    return stream == NULL || stream == cudaStreamLegacy || stream == cudaStreamPerThread;
+}
+}  // namespace
+
+bool CudaRtNotifications::Enabled() { return !GetState().disabled; }
+
+void CudaRtNotifications::StartPolling() {
+    State &state = GetState();
+    if (!state.poller.joinable()) {
+        state.poller = thread(Poll);
+        atexit(Stop);
+    }
+    state.changed.notify_all();
+}
+
+bool CudaRtNotifications::RecordEvent(cudaEvent_t event, cudaStream_t stream, unsigned int flags,
+                                      cudaError_t *result) {
+    State &state = GetState();
+    if (state.disabled) return false;
+    uint64_t seq;
+    {
+        lock_guard<mutex> lock(state.stateMutex);
+        seq = ++state.seq;
+        state.events[event] = {seq, false, cudaSuccess};
+    }
+    CudaRtFrontend::Prepare();
+    CudaRtFrontend::AddDevicePointerForArguments(event);
+    CudaRtFrontend::AddDevicePointerForArguments(stream);
+    CudaRtFrontend::AddVariableForArguments(flags);
+    CudaRtFrontend::AddVariableForArguments(state.session);
+    CudaRtFrontend::AddVariableForArguments(seq);
+    CudaRtFrontend::Execute("cudaEventRecordNotify");
+    bool unknown = (int)CudaRtFrontend::GetExitCode() == UNKNOWN_ROUTINE;
+    bool tracked = CudaRtFrontend::Success() && CudaRtFrontend::GetOutputVariable<bool>();
+
+    lock_guard<mutex> lock(state.stateMutex);
+    if (unknown) {
+        state.Disable();
+        return false;
+    }
+    auto it = state.events.find(event);
+    if (it != state.events.end() && it->second.recorded == seq) {
+        /* recorded in a graph being captured, or not recorded at all */
+        if (!tracked) state.events.erase(it);
+        else if (!it->second.done) StartPolling();
+    }
+    *result = CudaRtFrontend::GetExitCode();
+    return true;
+}
+
+bool CudaRtNotifications::QueryEvent(cudaEvent_t event, cudaError_t *result) {
+    State &state = GetState();
+    if (state.disabled) return false;
+    lock_guard<mutex> lock(state.stateMutex);
+    auto it = state.events.find(event);
+    if (it == state.events.end()) return false;
+    *result = it->second.done ? it->second.status : cudaErrorNotReady;
+    return true;
+}
+
+bool CudaRtNotifications::SynchronizeEvent(cudaEvent_t event, cudaError_t *result) {
+    State &state = GetState();
+    if (state.disabled) return false;
+    unique_lock<mutex> lock(state.stateMutex);
+    auto it = state.events.end();
+    state.changed.wait(lock, [&] {
+        it = state.events.find(event);
+        return it == state.events.end() || it->second.done;
+    });
+    /* forgotten meanwhile, or the channel failed */
+    if (it == state.events.end()) return false;
+    *result = it->second.status;
+    return true;
+}
+
+bool CudaRtNotifications::QueryStream(cudaStream_t stream, cudaError_t *result) {
+    State &state = GetState();
+    if (state.disabled || Special(stream)) return false;
+    uint64_t seq;
+    {
+        lock_guard<mutex> lock(state.stateMutex);
+        if (state.markers.count(stream) > 0) {
+            *result = cudaErrorNotReady;
+            return true;
+        }
+        seq = ++state.seq;
+        state.inflight.insert(seq);
+    }
+    CudaRtFrontend::Prepare();
+    CudaRtFrontend::AddDevicePointerForArguments(stream);
+    CudaRtFrontend::AddVariableForArguments(state.session);
+    CudaRtFrontend::AddVariableForArguments(seq);
+    CudaRtFrontend::Execute("cudaStreamQueryNotify");
+    cudaError_t exit_code = CudaRtFrontend::GetExitCode();
+    bool tracked = exit_code == cudaErrorNotReady && CudaRtFrontend::GetOutputVariable<bool>();
+
+    lock_guard<mutex> lock(state.stateMutex);
+    if ((int)exit_code == UNKNOWN_ROUTINE) {
+        state.Disable();
+        return false;
+    }
+    /* not in inflight any more if the marker completed before the reply */
+    if (state.inflight.erase(seq) > 0 && tracked) {
+        state.markers[stream] = seq;
+        StartPolling();
+    }
+    *result = exit_code;
+    return true;
+}
+
+bool CudaRtNotifications::AddCallback(cudaStream_t stream, cudaStreamCallback_t callback,
+                                      void *userData, unsigned int flags, cudaError_t *result) {
+    return Schedule(
+        "cudaStreamAddCallback", stream, &flags,
+        [=](cudaError_t status) { callback(stream, status, userData); }, result);
+}
+
+bool CudaRtNotifications::LaunchHostFunc(cudaStream_t stream, cudaHostFn_t fn, void *userData,
+                                         cudaError_t *result) {
+    return Schedule(
+        "cudaLaunchHostFunc", stream, NULL, [=](cudaError_t) { fn(userData); }, result);
+}
+
+bool CudaRtNotifications::Schedule(const char *routine, cudaStream_t stream,
+                                   const unsigned int *flags,
+                                   function<void(cudaError_t)> callback, cudaError_t *result) {
+    State &state = GetState();
+    if (state.disabled) return false;
+    uint64_t seq;
+    {
+        lock_guard<mutex> lock(state.stateMutex);
+        seq = ++state.seq;
+        state.callbacks[seq] = callback;
+        StartPolling();
+    }
+    CudaRtFrontend::Prepare();
+    CudaRtFrontend::AddDevicePointerForArguments(stream);
+    CudaRtFrontend::AddVariableForArguments(state.session);
+    CudaRtFrontend::AddVariableForArguments(seq);
+    if (flags != NULL) CudaRtFrontend::AddVariableForArguments(*flags);
+    CudaRtFrontend::Execute(routine);
+
+    lock_guard<mutex> lock(state.stateMutex);
+    if ((int)CudaRtFrontend::GetExitCode() == UNKNOWN_ROUTINE) {
+        state.callbacks.erase(seq);
+        state.Disable();
+        return false;
+    }
+    if (!CudaRtFrontend::Success()) state.callbacks.erase(seq);
+    *result = CudaRtFrontend::GetExitCode();
+    return true;
+}
+
+void CudaRtNotifications::ForgetEvent(cudaEvent_t event) {
+    State &state = GetState();
+    lock_guard<mutex> lock(state.stateMutex);
+    if (state.events.erase(event) > 0) state.changed.notify_all();
+}
+
+void CudaRtNotifications::ForgetStream(cudaStream_t stream) {
+    State &state = GetState();
+    lock_guard<mutex> lock(state.stateMutex);
+    state.markers.erase(stream);
+}
+
+void CudaRtNotifications::Forget() {
+    State &state = GetState();
+    lock_guard<mutex> lock(state.stateMutex);
+    state.events.clear();
+    state.markers.clear();
+    state.changed.notify_all();
+}
+
+bool CudaRtNotifications::Deliver(const CudaRtNotification &notification) {
+    State &state = GetState();
+    function<void(cudaError_t)> callback;
+    {
+        lock_guard<mutex> lock(state.stateMutex);
+        switch (notification.kind) {
+            case CudaRtNotification::EVENT: {
+                auto it = state.events.find((cudaEvent_t)notification.handle);
+                /* a later record of the event supersedes this one */
+                if (it == state.events.end() || it->second.recorded > notification.seq) break;
+                it->second.done = true;
+                it->second.status = (cudaError_t)notification.status;
+                state.changed.notify_all();
+                break;
+            }
+            case CudaRtNotification::STREAM: {
+                if (state.inflight.erase(notification.seq) > 0) break;
+                auto it = state.markers.find((cudaStream_t)notification.handle);
+                if (it != state.markers.end() && it->second == notification.seq)
+                    state.markers.erase(it);
+                break;
+            }
+            case CudaRtNotification::CALLBACK: {
+                auto it = state.callbacks.find(notification.seq);
+                if (it == state.callbacks.end()) break;
+                callback = std::move(it->second);
+                state.callbacks.erase(it);
+                break;
+            }
+        }
+    }
+    if (notification.kind != CudaRtNotification::CALLBACK) return false;
+    /* the application's callback runs without the lock, and may call the runtime */
+    if (callback) callback((cudaError_t)notification.status);
+    return true;
+}
+
+void CudaRtNotifications::Poll() {
+    State &state = GetState();
+    vector<uint64_t> acks;
+    for (;;) {
+        {
+            unique_lock<mutex> lock(state.stateMutex);
+            state.changed.wait(lock, [&] {
+                return state.stopping || state.disabled || !acks.empty() || state.Outstanding();
+            });
+            if (state.stopping || state.disabled) return;
+        }
+        /* this thread has a connection of its own, so the poll blocks no call */
+        CudaRtFrontend::Prepare();
+        CudaRtFrontend::AddVariableForArguments(state.session);
+        CudaRtFrontend::AddVariableForArguments(POLL_TIMEOUT_MS);
+        CudaRtFrontend::AddVariableForArguments(acks.size());
+        CudaRtFrontend::AddHostPointerForArguments(acks.data(), acks.size());
+        CudaRtFrontend::Execute("cudaNotificationsWait");
+        acks.clear();
+        if (!CudaRtFrontend::Success()) {
+            lock_guard<mutex> lock(state.stateMutex);
+            state.Disable();
+            return;
+        }
+        size_t count = CudaRtFrontend::GetOutputVariable<size_t>();
+        auto received = CudaRtFrontend::GetOutputHostPointer<CudaRtNotification>(count);
+        /* a callback calling the runtime reuses the output buffer */
+        vector<CudaRtNotification> notifications(received, received + (received ? count : 0));
+        for (auto &notification : notifications)
+            if (Deliver(notification)) acks.push_back(notification.seq);
+    }
+}
+
+void CudaRtNotifications::Stop() {
+    State &state = GetState();
+    {
+        lock_guard<mutex> lock(state.stateMutex);
+        state.stopping = true;
+        state.changed.notify_all();
+    }
+    /* exit() called by a callback of the application */
+    if (state.poller.get_id() == this_thread::get_id())
+        state.poller.detach();
+    else
+        state.poller.join();
+    /* releases the streams of the backend waiting for callbacks that will not run */
+    CudaRtFrontend::Prepare();
+    CudaRtFrontend::AddVariableForArguments(state.session);
+    CudaRtFrontend::Execute("cudaNotificationsClose");
+}
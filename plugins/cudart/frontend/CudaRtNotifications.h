@@ -0,0 +1,95 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   CudaRtNotifications.h
+ *
+ * @brief  The frontend's end of the notification channel: the backend
+ * watches each event the application records, and pushes a notification
+ * when it completes, so that polling an event, and waiting for it, need no
+ * round trip. The callbacks the application adds to its streams
+ * reach it the same way, and run in the frontend.
+ *
+ * The notifications come from a long poll (cudaNotificationsWait) that a
+ * thread of the frontend runs while anything is outstanding. Set
+ * GVIRTUS_CUDART_NOTIFICATIONS=off to query the backend on every call.
+ */
+
+#ifndef _CUDARTNOTIFICATIONS_H
+#define _CUDARTNOTIFICATIONS_H
+
+#include <cuda_runtime_api.h>
+
+#include <cstdint>
+#include <functional>
+
+struct CudaRtNotification;
+
+class CudaRtNotifications {
+   public:
+    /*
+     * Whether the backend pushes notifications: not with
+     * GVIRTUS_CUDART_NOTIFICATIONS=off, with a backend without the channel,
+     * or after the channel failed.
+     */
+    static bool Enabled();
+
+    /*
+     * Each of these returns false when the caller must ask the backend
+     * instead, and otherwise sets result to what the runtime returned.
+     */
+    static bool RecordEvent(cudaEvent_t event, cudaStream_t stream, unsigned int flags,
+                            cudaError_t *result);
+    static bool QueryEvent(cudaEvent_t event, cudaError_t *result);
+    static bool SynchronizeEvent(cudaEvent_t event, cudaError_t *result);
+    static bool QueryStream(cudaStream_t stream, cudaError_t *result);
+
+    /* Runs callback in the frontend once the work on stream before it is done. */
+    static bool AddCallback(cudaStream_t stream, cudaStreamCallback_t callback, void *userData,
+                            unsigned int flags, cudaError_t *result);
+    static bool LaunchHostFunc(cudaStream_t stream, cudaHostFn_t fn, void *userData,
+                               cudaError_t *result);
+
+    /*
+     * After a call that destroys them: of event, of stream, or all of them.
+     * Also after a graph launch, whose event record nodes the frontend does
+     * not see.
+     */
+    static void ForgetEvent(cudaEvent_t event);
+    static void ForgetStream(cudaStream_t stream);
+    static void Forget();
+
+   private:
+    /* How long a poll waits on the backend, which bounds the wait at exit. */
+    static constexpr unsigned int POLL_TIMEOUT_MS = 250;
+
+    static bool Schedule(const char *routine, cudaStream_t stream, const unsigned int *flags,
+                         std::function<void(cudaError_t)> callback, cudaError_t *result);
+    /* Called with the lock of the state held, whenever something becomes outstanding. */
+    static void StartPolling();
+    static void Poll();
+    /* Returns whether the backend waits for an ack of notification. */
+    static bool Deliver(const CudaRtNotification &notification);
+    static void Stop();
+};
+
+#endif /* _CUDARTNOTIFICATIONS_H */
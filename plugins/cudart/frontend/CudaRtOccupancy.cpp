@@ -0,0 +1,64 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CudaRtOccupancy.h"
+
+#include <algorithm>
+
+static size_t RoundUp(size_t value, size_t unit) { return (value + unit - 1) / unit * unit; }
+
+bool CudaRtOccupancy::MaxActiveBlocksPerMultiprocessor(const cudaDeviceProp &prop,
+                                                       const cudaFuncAttributes &attr,
+                                                       int blockSize, size_t dynamicSMemSize,
+                                                       int *numBlocks) {
+    if (prop.major < 7 || prop.warpSize <= 0) return false;
+    if (blockSize <= 0 || blockSize > attr.maxThreadsPerBlock) return false;
+    if (dynamicSMemSize > (size_t)attr.maxDynamicSharedSizeBytes) return false;
+    /* a carveout changes the shared memory of the multiprocessor */
+    if (attr.preferredShmemCarveout != -1) return false;
+    if (attr.numRegs > MAX_REGISTERS_PER_THREAD) return false;
+
+    int warpsPerBlock = (blockSize + prop.warpSize - 1) / prop.warpSize;
+    int limit = std::min(prop.maxBlocksPerMultiProcessor,
+                         prop.maxThreadsPerMultiProcessor / prop.warpSize / warpsPerBlock);
+
+    if (attr.numRegs > 0) {
+        int regsPerWarp = RoundUp(attr.numRegs * prop.warpSize, REGISTER_ALLOCATION_UNIT);
+        if (regsPerWarp * warpsPerBlock > prop.regsPerBlock) {
+            *numBlocks = 0;
+            return true;
+        }
+        /* a warp takes its registers from one sub-partition */
+        int warpsPerSubPartition = prop.regsPerMultiprocessor / SUB_PARTITIONS / regsPerWarp;
+        limit = std::min(limit, warpsPerSubPartition * SUB_PARTITIONS / warpsPerBlock);
+    }
+
+    size_t sharedMemPerBlock =
+        attr.sharedSizeBytes + dynamicSMemSize + prop.reservedSharedMemPerBlock;
+    if (sharedMemPerBlock > 0) {
+        sharedMemPerBlock = RoundUp(sharedMemPerBlock, prop.major >= 8 ? 128 : 256);
+        limit = std::min<size_t>(limit, prop.sharedMemPerMultiprocessor / sharedMemPerBlock);
+    }
+
+    *numBlocks = limit;
+    return true;
+}
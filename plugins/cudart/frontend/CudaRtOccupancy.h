@@ -0,0 +1,63 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   CudaRtOccupancy.h
+ *
+ * @brief  The CUDA occupancy calculator, run by the frontend on the device
+ * properties and kernel attributes it fetched once, so that the occupancy
+ * queries libraries make before launches need no round trip.
+ */
+
+#ifndef _CUDARTOCCUPANCY_H
+#define _CUDARTOCCUPANCY_H
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+
+class CudaRtOccupancy {
+   public:
+    /*
+     * The blocks of blockSize threads, each with dynamicSMemSize bytes of
+     * dynamic shared memory, that fit at once on a multiprocessor of prop
+     * running the kernel of attr: the least of the limits set by warps,
+     * registers and shared memory, with the allocation granularities of the
+     * hardware and the default shared memory carveout.
+     *
+     * Returns false for inputs the calculator does not cover, which the
+     * backend answers instead: devices older than Volta, invalid or
+     * oversized blocks, kernels with a carveout preference.
+     */
+    static bool MaxActiveBlocksPerMultiprocessor(const cudaDeviceProp &prop,
+                                                 const cudaFuncAttributes &attr, int blockSize,
+                                                 size_t dynamicSMemSize, int *numBlocks);
+
+   private:
+    /* Registers are allocated to warps in units of 256. */
+    static constexpr int REGISTER_ALLOCATION_UNIT = 256;
+    /* From Volta on, each multiprocessor splits its register file in four. */
+    static constexpr int SUB_PARTITIONS = 4;
+    static constexpr int MAX_REGISTERS_PER_THREAD = 255;
+};
+
+#endif /* _CUDARTOCCUPANCY_H */
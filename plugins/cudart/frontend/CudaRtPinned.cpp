@@ -0,0 +1,267 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CudaRtPinned.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CudaRt.h"
+#include "CudaRtDevices.h"
+
+using gvirtus::frontend::Frontend;
+using namespace std;
+
+namespace {
+
+struct Region {
+    size_t size;
+    unsigned int flags;
+    size_t backend;
+    /* the address of the mapping of the backend */
+    uintptr_t mirror;
+};
+
+enum class Sharing { Unknown, Shared, Remote };
+
+struct State {
+    mutex stateMutex;
+    /* by their start in this process */
+    map<uintptr_t, Region> regions;
+    /* by backend: whether it maps the segments of this process */
+    vector<Sharing> backends;
+    uint64_t allocated = 0;
+    mt19937_64 nonces;
+    /* the key of this process, which each of its sessions holds on the backend */
+    uint64_t process;
+    bool disabled;
+
+    State() : nonces(random_device()()) {
+        process = nonces();
+        const char *mode = getenv("GVIRTUS_CUDART_PINNED");
+        disabled = mode != NULL && strcmp(mode, "off") == 0;
+    }
+
+    /* Called with mutex held. */
+    Sharing &Of(size_t backend) {
+        if (backend >= backends.size()) backends.resize(backend + 1, Sharing::Unknown);
+        return backends[backend];
+    }
+
+    /* Called with mutex held: the region holding count bytes from address. */
+    const Region *Find(uintptr_t address, size_t count, uintptr_t *start) const {
+        auto it = regions.upper_bound(address);
+        if (it == regions.begin()) return nullptr;
+        --it;
+        if (address + count > it->first + it->second.size) return nullptr;
+        *start = it->first;
+        return &it->second;
+    }
+};
+
+/* Never freed: the exit handlers of the application may still free memory. */
+State &GetState() {
+    static State *state = new State();
+    return *state;
+}
+
+/*
+ * Makes the session just opened on backend hold the mirrors of this process,
+ * so that they outlive the thread that allocated them.
+ */
+void Attach(size_t backend) {
+    State &state = GetState();
+    {
+        lock_guard<mutex> lock(state.stateMutex);
+        if (state.disabled || state.Of(backend) == Sharing::Remote) return;
+    }
+    CudaRtFrontend::Prepare();
+    CudaRtFrontend::AddVariableForArguments(state.process);
+    CudaRtFrontend::Execute("cudaPinnedAttach");
+}
+
+const bool attaching = (Frontend::AddConnectHook(Attach), true);
+
+bool Copy(const char *routine, void *dst, const void *src, size_t count, cudaMemcpyKind kind,
+          size_t backend, const cudaStream_t *stream, cudaError_t *result) {
+    if (kind != cudaMemcpyHostToDevice && kind != cudaMemcpyDeviceToHost) return false;
+    State &state = GetState();
+    uintptr_t host = (uintptr_t)(kind == cudaMemcpyHostToDevice ? src : dst), start, mirror;
+    {
+        lock_guard<mutex> lock(state.stateMutex);
+        const Region *region = state.Find(host, count, &start);
+        if (region == nullptr || region->backend != backend) return false;
+        mirror = region->mirror + (host - start);
+    }
+    if (kind == cudaMemcpyHostToDevice)
+        src = (const void *)mirror;
+    else
+        dst = (void *)mirror;
+
+    CudaRtFrontend::Prepare();
+    CudaRtFrontend::AddVariableForArguments(state.process);
+    CudaRtFrontend::AddDevicePointerForArguments(dst);
+    CudaRtFrontend::AddDevicePointerForArguments(src);
+    CudaRtFrontend::AddVariableForArguments(count);
+    CudaRtFrontend::AddVariableForArguments(kind);
+    if (stream != nullptr) CudaRtFrontend::AddDevicePointerForArguments(*stream);
+    CudaRtFrontend::Execute(routine);
+    // the count copied, which keeps the copy out of a macro replay
+    if (CudaRtFrontend::Success()) CudaRtFrontend::GetOutputVariable<size_t>();
+    *result = CudaRtFrontend::GetExitCode();
+    return true;
+}
+}  // namespace
+
+bool CudaRtPinned::Alloc(void **ptr, size_t size, unsigned int flags, cudaError_t *result) {
+    State &state = GetState();
+    // the backend checks the segment by its first bytes
+    if (state.disabled || size < sizeof(uint64_t)) return false;
+    size_t backend = CudaRtDevices::Backend();
+    string name;
+    uint64_t nonce;
+    {
+        lock_guard<mutex> lock(state.stateMutex);
+        if (state.Of(backend) == Sharing::Remote) return false;
+        name = "/gvirtus-host-" + to_string(getpid()) + "-" + to_string(state.allocated++);
+        nonce = state.nonces();
+    }
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd == -1) return false;
+    void *base = MAP_FAILED;
+    // reserved now, so that a full /dev/shm fails here rather than on first touch
+    if (ftruncate(fd, size) == 0 && posix_fallocate(fd, 0, size) == 0)
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        return false;
+    }
+    memcpy(base, &nonce, sizeof(nonce));
+
+    CudaRtFrontend::Prepare();
+    CudaRtFrontend::AddVariableForArguments(state.process);
+    CudaRtFrontend::AddStringForArguments(name.c_str());
+    CudaRtFrontend::AddVariableForArguments(size);
+    CudaRtFrontend::AddVariableForArguments(flags);
+    CudaRtFrontend::AddVariableForArguments(nonce);
+    CudaRtFrontend::Execute("cudaHostAlloc");
+    // both ends have it mapped, or will not map it
+    shm_unlink(name.c_str());
+
+    cudaError_t exit_code = CudaRtFrontend::GetExitCode();
+    lock_guard<mutex> lock(state.stateMutex);
+    if (exit_code != cudaSuccess) {
+        munmap(base, size);
+        // a backend on another host, or one that cannot open the segment
+        if (exit_code != cudaErrorMemoryAllocation) state.Of(backend) = Sharing::Remote;
+        return false;
+    }
+    Region region;
+    region.size = size;
+    region.flags = flags;
+    region.backend = backend;
+    region.mirror = (uintptr_t)CudaRtFrontend::GetOutputDevicePointer();
+    memset(base, 0, sizeof(nonce));
+    state.regions[(uintptr_t)base] = region;
+    state.Of(backend) = Sharing::Shared;
+    *ptr = base;
+    *result = cudaSuccess;
+    return true;
+}
+
+bool CudaRtPinned::Free(void *ptr, cudaError_t *result) {
+    State &state = GetState();
+    Region region;
+    {
+        lock_guard<mutex> lock(state.stateMutex);
+        auto it = state.regions.find((uintptr_t)ptr);
+        if (it == state.regions.end()) return false;
+        region = it->second;
+        state.regions.erase(it);
+    }
+
+    CudaRtDevices::Route route(region.backend);
+    CudaRtFrontend::Prepare();
+    CudaRtFrontend::AddVariableForArguments(state.process);
+    CudaRtFrontend::AddDevicePointerForArguments((void *)region.mirror);
+    CudaRtFrontend::Execute("cudaFreeHost");
+    munmap(ptr, region.size);
+    *result = CudaRtFrontend::GetExitCode();
+    return true;
+}
+
+bool CudaRtPinned::GetDevicePointer(void **pDevice, void *pHost, unsigned int flags,
+                                    cudaError_t *result) {
+    State &state = GetState();
+    uintptr_t start, mirror;
+    size_t backend;
+    {
+        lock_guard<mutex> lock(state.stateMutex);
+        const Region *region = state.Find((uintptr_t)pHost, 1, &start);
+        if (region == nullptr) return false;
+        mirror = region->mirror + ((uintptr_t)pHost - start);
+        backend = region->backend;
+    }
+
+    CudaRtDevices::Route route(backend);
+    CudaRtFrontend::Prepare();
+    CudaRtFrontend::AddVariableForArguments(state.process);
+    CudaRtFrontend::AddDevicePointerForArguments((void *)mirror);
+    CudaRtFrontend::AddVariableForArguments(flags);
+    CudaRtFrontend::Execute("cudaHostGetDevicePointer");
+    if (CudaRtFrontend::Success()) *pDevice = CudaRtFrontend::GetOutputDevicePointer();
+    *result = CudaRtFrontend::GetExitCode();
+    return true;
+}
+
+bool CudaRtPinned::GetFlags(unsigned int *pFlags, void *pHost) {
+    State &state = GetState();
+    uintptr_t start;
+    lock_guard<mutex> lock(state.stateMutex);
+    const Region *region = state.Find((uintptr_t)pHost, 1, &start);
+    if (region == nullptr) return false;
+    *pFlags = region->flags;
+    return true;
+}
+
+bool CudaRtPinned::Memcpy(void *dst, const void *src, size_t count, cudaMemcpyKind kind,
+                          size_t backend, cudaError_t *result) {
+    return Copy("cudaMemcpyPinned", dst, src, count, kind, backend, nullptr, result);
+}
+
+bool CudaRtPinned::MemcpyAsync(void *dst, const void *src, size_t count, cudaMemcpyKind kind,
+                               size_t backend, cudaStream_t stream, cudaError_t *result) {
+    return Copy("cudaMemcpyPinnedAsync", dst, src, count, kind, backend, &stream, result);
+}
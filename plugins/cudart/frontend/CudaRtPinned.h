@@ -0,0 +1,72 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   CudaRtPinned.h
+ *
+ * @brief  Page-locked host memory, shared with a backend on the same host.
+ *
+ * cudaHostAlloc() and cudaMallocHost() create a shared memory segment for
+ * each allocation. The backend maps it too, and registers its mapping with
+ * the CUDA runtime, so both processes see the same pages. A copy between
+ * such memory and the device then sends only the addresses: the backend
+ * copies from or into its mapping, asynchronously on the stream for
+ * cudaMemcpyAsync(). cudaHostGetDevicePointer() returns the address that
+ * kernels use to reach the memory.
+ *
+ * The backend opens the segment by name, so it has to run on the same host
+ * and as the same user. A backend that cannot open it is not asked again,
+ * and its allocations fall back to ordinary memory, copied as before. Set
+ * GVIRTUS_CUDART_PINNED=off to always fall back.
+ */
+
+#ifndef _CUDARTPINNED_H
+#define _CUDARTPINNED_H
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+
+class CudaRtPinned {
+   public:
+    /*
+     * Each of these returns false when the caller must fall back to ordinary
+     * memory, or to the usual copy, and otherwise sets result to what the
+     * runtime returned.
+     */
+    static bool Alloc(void **ptr, size_t size, unsigned int flags, cudaError_t *result);
+    static bool Free(void *ptr, cudaError_t *result);
+    static bool GetDevicePointer(void **pDevice, void *pHost, unsigned int flags,
+                                 cudaError_t *result);
+    static bool GetFlags(unsigned int *pFlags, void *pHost);
+
+    /*
+     * Copies between the device memory of backend and host memory that it
+     * shares, in the direction of kind.
+     */
+    static bool Memcpy(void *dst, const void *src, size_t count, cudaMemcpyKind kind,
+                       size_t backend, cudaError_t *result);
+    static bool MemcpyAsync(void *dst, const void *src, size_t count, cudaMemcpyKind kind,
+                            size_t backend, cudaStream_t stream, cudaError_t *result);
+};
+
+#endif /* _CUDARTPINNED_H */
@@ -32,5 +32,6 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaFuncSetAttribute(const void* func,
     CudaRtFrontend::AddVariableForArguments(attr);
     CudaRtFrontend::AddVariableForArguments(value);
     CudaRtFrontend::Execute("cudaFuncSetAttribute");
+    if (CudaRtFrontend::Success()) CudaRtFrontend::forgetFuncAttributes(func);
     return CudaRtFrontend::GetExitCode();
 }
\ No newline at end of file
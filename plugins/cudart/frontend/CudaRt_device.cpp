@@ -27,6 +27,8 @@
  */
 
 #include "CudaRt.h"
+#include "CudaRtDevices.h"
+#include "CudaRtNotifications.h"
 
 using namespace std;
 
@@ -34,6 +36,8 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaDeviceSetCacheConfig(cudaFuncCache
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddVariableForArguments(cacheConfig);
     CudaRtFrontend::Execute("cudaDeviceSetCacheConfig");
+    if (CudaRtFrontend::Success())
+        CudaRtFrontend::setCachePreference(NULL, cacheConfig != cudaFuncCachePreferNone);
 
     return CudaRtFrontend::GetExitCode();
 }
@@ -44,18 +48,23 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaChooseDevice(int *device,
     CudaRtFrontend::AddHostPointerForArguments(device);
     CudaRtFrontend::AddHostPointerForArguments(prop);
     CudaRtFrontend::Execute("cudaChooseDevice");
-    if (CudaRtFrontend::Success()) *device = *(CudaRtFrontend::GetOutputHostPointer<int>());
+    if (CudaRtFrontend::Success())
+        *device = CudaRtDevices::Global(CudaRtDevices::Backend(),
+                                        *(CudaRtFrontend::GetOutputHostPointer<int>()));
     return CudaRtFrontend::GetExitCode();
 }
 
 extern "C" __host__ __device__ cudaError_t CUDARTAPI cudaGetDevice(int *device) {
     CudaRtFrontend::Prepare();
     CudaRtFrontend::Execute("cudaGetDevice");
-    if (CudaRtFrontend::Success()) *device = CudaRtFrontend::GetOutputVariable<int>();
+    if (CudaRtFrontend::Success())
+        *device = CudaRtDevices::Global(CudaRtDevices::Backend(),
+                                        CudaRtFrontend::GetOutputVariable<int>());
     return CudaRtFrontend::GetExitCode();
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaGetDeviceCount(int *count) {
+    if (CudaRtDevices::Enabled()) return CudaRtDevices::Count(count);
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddHostPointerForArguments(count);
     CudaRtFrontend::Execute("cudaGetDeviceCount");
@@ -65,6 +74,9 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaGetDeviceCount(int *count) {
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaGetDeviceProperties(cudaDeviceProp *prop,
                                                                   int device) {
+    size_t backend;
+    if (!CudaRtDevices::Locate(device, &backend, &device)) return cudaErrorInvalidDevice;
+    CudaRtDevices::Route route(backend);
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddHostPointerForArguments(prop);
     CudaRtFrontend::AddVariableForArguments(device);
@@ -84,6 +96,9 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaGetDeviceProperties(cudaDeviceProp
 
 extern "C" __host__ cudaError_t cudaDeviceGetAttribute(int *value, cudaDeviceAttr attr,
                                                        int device) {
+    size_t backend;
+    if (!CudaRtDevices::Locate(device, &backend, &device)) return cudaErrorInvalidDevice;
+    CudaRtDevices::Route route(backend);
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddHostPointerForArguments(value);
     CudaRtFrontend::AddVariableForArguments(attr);
@@ -95,9 +110,21 @@ extern "C" __host__ cudaError_t cudaDeviceGetAttribute(int *value, cudaDeviceAtt
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaSetDevice(int device) {
+    // the calls of the thread go to the backend of the device from now on
+    size_t backend, previous = CudaRtDevices::Backend();
+    int global = device;
+    if (!CudaRtDevices::Locate(device, &backend, &device)) return cudaErrorInvalidDevice;
+    auto frontend = gvirtus::frontend::Frontend::GetFrontend();
+    if (!frontend->SetBackend(backend)) return cudaErrorDevicesUnavailable;
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddVariableForArguments(device);
     CudaRtFrontend::Execute("cudaSetDevice");
+    if (!CudaRtFrontend::Success()) {
+        cudaError_t result = CudaRtFrontend::GetExitCode();
+        frontend->SetBackend(previous);
+        return result;
+    }
+    frontend->SetDevice(global);
     return CudaRtFrontend::GetExitCode();
 }
 
@@ -111,6 +138,13 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaSetDeviceFlags(unsigned int flags)
 extern "C" __host__ cudaError_t CUDARTAPI cudaDeviceReset(void) {
     CudaRtFrontend::Prepare();
     CudaRtFrontend::Execute("cudaDeviceReset");
+    if (CudaRtFrontend::Success()) {
+        // the reset drops the attributes and preferences set on the device
+        CudaRtFrontend::forgetFuncAttributes(NULL);
+        CudaRtFrontend::setCachePreference(NULL, false);
+        // and its events and streams
+        CudaRtNotifications::Forget();
+    }
     return CudaRtFrontend::GetExitCode();
 }
 
@@ -185,6 +219,9 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaIpcOpenMemHandle(void **devPtr,
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaDeviceEnablePeerAccess(int peerDevice,
                                                                      unsigned int flags) {
+    size_t backend;
+    if (!CudaRtDevices::Locate(peerDevice, &backend, &peerDevice)) return cudaErrorInvalidDevice;
+    if (backend != CudaRtDevices::Backend()) return cudaErrorPeerAccessUnsupported;
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddVariableForArguments(peerDevice);
     CudaRtFrontend::AddVariableForArguments(flags);
@@ -194,6 +231,16 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaDeviceEnablePeerAccess(int peerDev
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaDeviceCanAccessPeer(int *canAccessPeer, int device,
                                                                   int peerDevice) {
+    size_t backend, peerBackend;
+    if (!CudaRtDevices::Locate(device, &backend, &device) ||
+        !CudaRtDevices::Locate(peerDevice, &peerBackend, &peerDevice))
+        return cudaErrorInvalidDevice;
+    // devices of different backends reach each other only through the frontend
+    if (backend != peerBackend) {
+        *canAccessPeer = 0;
+        return cudaSuccess;
+    }
+    CudaRtDevices::Route route(backend);
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddHostPointerForArguments(canAccessPeer);
     CudaRtFrontend::AddVariableForArguments(device);
@@ -216,6 +263,9 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaDeviceGetStreamPriorityRange(int *
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaDeviceDisablePeerAccess(int peerDevice) {
+    size_t backend;
+    if (!CudaRtDevices::Locate(peerDevice, &backend, &peerDevice)) return cudaErrorInvalidDevice;
+    if (backend != CudaRtDevices::Backend()) return cudaErrorPeerAccessNotEnabled;
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddVariableForArguments(peerDevice);
 
@@ -225,6 +275,9 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaDeviceDisablePeerAccess(int peerDe
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaDeviceGetDefaultMemPool(cudaMemPool_t *memPool,
                                                                       int device) {
+    size_t backend;
+    if (!CudaRtDevices::Locate(device, &backend, &device)) return cudaErrorInvalidDevice;
+    CudaRtDevices::Route route(backend);
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddVariableForArguments(device);
     CudaRtFrontend::Execute("cudaDeviceGetDefaultMemPool");
@@ -235,6 +288,9 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaDeviceGetDefaultMemPool(cudaMemPoo
 // TODO: needs testing
 extern "C" __host__ cudaError_t CUDARTAPI cudaDeviceGetPCIBusId(char *pciBusId, int len,
                                                                 int device) {
+    size_t backend;
+    if (!CudaRtDevices::Locate(device, &backend, &device)) return cudaErrorInvalidDevice;
+    CudaRtDevices::Route route(backend);
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddHostPointerForArguments(pciBusId, len);
     CudaRtFrontend::AddVariableForArguments(len);
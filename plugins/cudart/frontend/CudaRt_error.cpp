@@ -26,21 +26,36 @@
  *             Department of Computer Science, University College Dublin
  */
 
+#include <gvirtus/frontend/LocalTier.h>
+
+#include <string>
+
 #include "CudaRt.h"
+#include "CudaRtErrorNames.h"
 
 using namespace std;
 
+using gvirtus::frontend::FindEnumName;
+using gvirtus::frontend::LocalCache;
+
+/* Asks the backend, once per error, what routine (a cudaGetErrorString) says of it. */
+static const char* RemoteErrorString(const char* routine, cudaError_t error) {
+    static LocalCache<pair<string, int>, string> strings;
+    const string* s = strings.Get({routine, error}, [&](string* value) {
+        CudaRtFrontend::Prepare();
+        CudaRtFrontend::AddVariableForArguments(error);
+        CudaRtFrontend::Execute(routine);
+        if (!CudaRtFrontend::Success()) return false;
+        *value = CudaRtFrontend::GetOutputString();
+        return true;
+    });
+    return s != nullptr ? s->c_str() : "unrecognized error code";
+}
+
 extern "C" __host__ const char* CUDARTAPI cudaGetErrorString(cudaError_t error) {
-    CudaRtFrontend::Prepare();
-    CudaRtFrontend::AddVariableForArguments(error);
-    CudaRtFrontend::Execute("cudaGetErrorString");
-#ifdef _WIN32
-    char* error_string = _strdup(CudaRtFrontend::GetOutputString());
-#else
-    char* error_string = strdup(CudaRtFrontend::GetOutputString());
-#endif
-    return error_string;
+    return RemoteErrorString("cudaGetErrorString", error);
 }
+
 extern "C" __host__ cudaError_t CUDARTAPI cudaPeekAtLastError(void) {
     CudaRtFrontend::Prepare();
     CudaRtFrontend::Execute("cudaPeekAtLastError");
@@ -54,8 +69,6 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaGetLastError(void) {
 }
 
 extern "C" __host__ __device__ const char* CUDARTAPI cudaGetErrorName(cudaError_t error) {
-    CudaRtFrontend::Prepare();
-    CudaRtFrontend::AddVariableForArguments(error);
-    CudaRtFrontend::Execute("cudaGetErrorName");
-    return CudaRtFrontend::GetOutputString();
-}
\ No newline at end of file
+    const char* name = FindEnumName(CUDA_ERROR_NAMES, error);
+    return name != nullptr ? name : RemoteErrorString("cudaGetErrorName", error);
+}
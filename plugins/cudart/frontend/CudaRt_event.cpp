@@ -24,13 +24,18 @@
  */
 
 #include "CudaRt.h"
+#include "CudaRtDevices.h"
+#include "CudaRtNotifications.h"
 
 using namespace std;
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaEventCreate(cudaEvent_t *event) {
     CudaRtFrontend::Prepare();
     CudaRtFrontend::Execute("cudaEventCreate");
-    if (CudaRtFrontend::Success()) *event = (cudaEvent_t)CudaRtFrontend::GetOutputDevicePointer();
+    if (CudaRtFrontend::Success()) {
+        *event = (cudaEvent_t)CudaRtFrontend::GetOutputDevicePointer();
+        CudaRtDevices::Own(*event);
+    }
     return CudaRtFrontend::GetExitCode();
 }
 
@@ -39,19 +44,26 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaEventCreateWithFlags(cudaEvent_t *
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddVariableForArguments(flags);
     CudaRtFrontend::Execute("cudaEventCreateWithFlags");
-    if (CudaRtFrontend::Success()) *event = (cudaEvent_t)CudaRtFrontend::GetOutputDevicePointer();
+    if (CudaRtFrontend::Success()) {
+        *event = (cudaEvent_t)CudaRtFrontend::GetOutputDevicePointer();
+        CudaRtDevices::Own(*event);
+    }
     return CudaRtFrontend::GetExitCode();
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaEventDestroy(cudaEvent_t event) {
+    CudaRtNotifications::ForgetEvent(event);
+    CudaRtDevices::Route route(CudaRtDevices::Owner(event));
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddDevicePointerForArguments(event);
     CudaRtFrontend::Execute("cudaEventDestroy");
+    if (CudaRtFrontend::Success()) CudaRtDevices::Disown(event);
     return CudaRtFrontend::GetExitCode();
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaEventElapsedTime(float *ms, cudaEvent_t start,
                                                                cudaEvent_t end) {
+    CudaRtDevices::Route route(CudaRtDevices::Owner(start));
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddHostPointerForArguments(ms);
     CudaRtFrontend::AddDevicePointerForArguments(start);
@@ -62,6 +74,9 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaEventElapsedTime(float *ms, cudaEv
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaEventQuery(cudaEvent_t event) {
+    cudaError_t result;
+    if (CudaRtNotifications::QueryEvent(event, &result)) return result;
+    CudaRtDevices::Route route(CudaRtDevices::Owner(event));
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddDevicePointerForArguments(event);
     CudaRtFrontend::Execute("cudaEventQuery");
@@ -69,6 +84,10 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaEventQuery(cudaEvent_t event) {
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaEventRecord(cudaEvent_t event, cudaStream_t stream) {
+    cudaError_t result;
+    if (CudaRtNotifications::RecordEvent(event, stream, cudaEventRecordDefault, &result))
+        return result;
+    CudaRtDevices::Route route(CudaRtDevices::Owner(event));
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddDevicePointerForArguments(event);
     CudaRtFrontend::AddDevicePointerForArguments(stream);
@@ -77,6 +96,9 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaEventRecord(cudaEvent_t event, cud
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaEventRecordWithFlags(cudaEvent_t event, cudaStream_t stream, unsigned int flags) {
+    cudaError_t result;
+    if (CudaRtNotifications::RecordEvent(event, stream, flags, &result)) return result;
+    CudaRtDevices::Route route(CudaRtDevices::Owner(event));
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddDevicePointerForArguments(event);
     CudaRtFrontend::AddDevicePointerForArguments(stream);
@@ -86,6 +108,9 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaEventRecordWithFlags(cudaEvent_t e
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaEventSynchronize(cudaEvent_t event) {
+    cudaError_t result;
+    if (CudaRtNotifications::SynchronizeEvent(event, &result)) return result;
+    CudaRtDevices::Route route(CudaRtDevices::Owner(event));
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddDevicePointerForArguments(event);
     CudaRtFrontend::Execute("cudaEventSynchronize");
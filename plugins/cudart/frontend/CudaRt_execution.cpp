@@ -29,6 +29,7 @@
 #include <CudaRt_internal.h>
 
 #include "CudaRt.h"
+#include "CudaRtNotifications.h"
 
 using namespace std;
 
@@ -47,14 +48,7 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaConfigureCall(dim3 gridDim, dim3 b
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaFuncGetAttributes(struct cudaFuncAttributes *attr,
                                                                 const void *func) {
-    CudaRtFrontend::Prepare();
-    CudaRtFrontend::AddHostPointerForArguments(attr);
-    CudaRtFrontend::AddVariableForArguments((gvirtus::common::pointer_t)func);
-    CudaRtFrontend::Execute("cudaFuncGetAttributes");
-    if (CudaRtFrontend::Success())
-        memmove(attr, CudaRtFrontend::GetOutputHostPointer<cudaFuncAttributes>(),
-                sizeof(cudaFuncAttributes));
-    return CudaRtFrontend::GetExitCode();
+    return CudaRtFrontend::getFuncAttributes(func, attr);
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaFuncSetCacheConfig(const void *func,
@@ -63,6 +57,8 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaFuncSetCacheConfig(const void *fun
     CudaRtFrontend::AddVariableForArguments((gvirtus::common::pointer_t)func);
     CudaRtFrontend::AddVariableForArguments(cacheConfig);
     CudaRtFrontend::Execute("cudaFuncSetCacheConfig");
+    if (CudaRtFrontend::Success())
+        CudaRtFrontend::setCachePreference(func, cacheConfig != cudaFuncCachePreferNone);
 
     return CudaRtFrontend::GetExitCode();
 }
@@ -158,15 +154,12 @@ extern "C" __host__ cudaError_t cudaLaunchKernelExC(const cudaLaunchConfig_t *co
     return cudaError;
 }
 
-// TODO: needs testing
+// fn runs in the frontend, sent by the backend over the notification channel
 extern "C" __host__ cudaError_t cudaLaunchHostFunc(cudaStream_t stream, cudaHostFn_t fn,
                                                    void *userData) {
-    CudaRtFrontend::Prepare();
-    CudaRtFrontend::AddDevicePointerForArguments(stream);
-    CudaRtFrontend::AddVariableForArguments((gvirtus::common::pointer_t)fn);
-    CudaRtFrontend::AddHostPointerForArguments(userData);
-    CudaRtFrontend::Execute("cudaLaunchHostFunc");
-    return CudaRtFrontend::GetExitCode();
+    cudaError_t result;
+    if (CudaRtNotifications::LaunchHostFunc(stream, fn, userData, &result)) return result;
+    return cudaErrorNotSupported;
 }
 
 extern "C" __host__ cudaError_t cudaLaunchKernel(const void *func, dim3 gridDim, dim3 blockDim,
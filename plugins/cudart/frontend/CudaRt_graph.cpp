@@ -27,6 +27,7 @@
  */
 
 #include "CudaRt.h"
+#include "CudaRtNotifications.h"
 
 using namespace std;
 
@@ -104,6 +105,8 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaGraphLaunch(cudaGraphExec_t graphE
     CudaRtFrontend::AddDevicePointerForArguments(graphExec);
     CudaRtFrontend::AddDevicePointerForArguments(stream);
     CudaRtFrontend::Execute("cudaGraphLaunch");
+    // the graph may record events the frontend did not see recorded
+    CudaRtNotifications::Forget();
     // cout << "Graph Launch" << endl;                                                        
     return CudaRtFrontend::GetExitCode();
 }
@@ -133,6 +136,8 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaGraphUpload(cudaGraphExec_t graphE
     CudaRtFrontend::AddDevicePointerForArguments(graphExec);
     CudaRtFrontend::AddDevicePointerForArguments(stream);
     CudaRtFrontend::Execute("cudaGraphLaunch");
+    // the graph may record events the frontend did not see recorded
+    CudaRtNotifications::Forget();
     
     return CudaRtFrontend::GetExitCode();
 }
\ No newline at end of file
@@ -33,6 +33,7 @@
 #include <cstdio>
 
 #include "CudaRt.h"
+#include "CudaRtDevices.h"
 
 // Helper: allocate and copy section headers table
 Elf64_Shdr *copySectionHeaders(const Elf64_Ehdr *eh) {
@@ -238,7 +239,7 @@ extern "C" __host__ void **__cudaRegisterFatBinary(void *fatCubin) {
     input_buffer = CudaUtil::MarshalFatCudaBinary(bin, input_buffer);
 
     CudaRtFrontend::Prepare();
-    CudaRtFrontend::Execute("cudaRegisterFatBinary", input_buffer);
+    CudaRtDevices::Register("cudaRegisterFatBinary", input_buffer);
     if (CudaRtFrontend::Success()) return (void **)fatCubin;
 
     return nullptr;
@@ -254,7 +255,7 @@ extern "C" __host__ void **__cudaRegisterFatBinaryEnd(void *fatCubin) {
     input_buffer = CudaUtil::MarshalFatCudaBinary(bin, input_buffer);
 
     CudaRtFrontend::Prepare();
-    CudaRtFrontend::Execute("cudaRegisterFatBinaryEnd", input_buffer);
+    CudaRtDevices::Register("cudaRegisterFatBinaryEnd", input_buffer);
     if (CudaRtFrontend::Success()) return (void **)fatCubin;
     return NULL;
 }
@@ -262,7 +263,7 @@ extern "C" __host__ void **__cudaRegisterFatBinaryEnd(void *fatCubin) {
 extern "C" __host__ void __cudaUnregisterFatBinary(void **fatCubinHandle) {
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddStringForArguments(CudaUtil::MarshalHostPointer(fatCubinHandle));
-    CudaRtFrontend::Execute("cudaUnregisterFatBinary");
+    CudaRtDevices::Register("cudaUnregisterFatBinary");
 }
 
 extern "C" __host__ void __cudaRegisterFunction(void **fatCubinHandle, const char *hostFun,
@@ -282,7 +283,7 @@ extern "C" __host__ void __cudaRegisterFunction(void **fatCubinHandle, const cha
     CudaRtFrontend::AddHostPointerForArguments(gDim);
     CudaRtFrontend::AddHostPointerForArguments(wSize);
 
-    CudaRtFrontend::Execute("cudaRegisterFunction");
+    CudaRtDevices::Register("cudaRegisterFunction");
 
     deviceFun = CudaRtFrontend::GetOutputString();
     tid = CudaRtFrontend::GetOutputHostPointer<uint3>();
@@ -314,14 +315,14 @@ extern "C" __host__ void __cudaRegisterVar(void **fatCubinHandle, char *hostVar,
     //      << ", size: " << size
     //      << ", constant: " << constant
     //      << ", global: " << global << endl;
-    CudaRtFrontend::Execute("cudaRegisterVar");
+    CudaRtDevices::Register("cudaRegisterVar");
 }
 
 extern "C" __host__ void __cudaRegisterShared(void **fatCubinHandle, void **devicePtr) {
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddStringForArguments(CudaUtil::MarshalHostPointer(fatCubinHandle));
     CudaRtFrontend::AddStringForArguments((char *)devicePtr);
-    CudaRtFrontend::Execute("cudaRegisterShared");
+    CudaRtDevices::Register("cudaRegisterShared");
 }
 
 extern "C" __host__ void __cudaRegisterSharedVar(void **fatCubinHandle, void **devicePtr,
@@ -332,7 +333,7 @@ extern "C" __host__ void __cudaRegisterSharedVar(void **fatCubinHandle, void **d
     CudaRtFrontend::AddVariableForArguments(size);
     CudaRtFrontend::AddVariableForArguments(alignment);
     CudaRtFrontend::AddVariableForArguments(storage);
-    CudaRtFrontend::Execute("cudaRegisterSharedVar");
+    CudaRtDevices::Register("cudaRegisterSharedVar");
 }
 
 extern "C" __host__ int __cudaSynchronizeThreads(void **x, void *y) {
@@ -27,6 +27,8 @@
  */
 
 #include "CudaRt.h"
+#include "CudaRtDevices.h"
+#include "CudaRtPinned.h"
 
 using namespace std;
 using gvirtus::common::mappedPointer;
@@ -57,6 +59,18 @@ cudaMemcpyKind inferMemcpyKindToDevice(const void *src) {
     return cudaMemcpyHostToDevice;
 }
 
+/*
+ * Whether a copy between device memory cannot tell the backends of its ends,
+ * because several backends hold memory at one of them: it fails rather than
+ * copy within the wrong backend.
+ */
+static bool AmbiguousCopy(void *dst, const void *src) {
+    if (!CudaRtDevices::Ambiguous(dst) && !CudaRtDevices::Ambiguous(src)) return false;
+    cerr << "[GVIRTUS WARNING] Several backends hold memory at " << dst << " or " << src
+         << ": the copy between them fails" << endl;
+    return true;
+}
+
 extern "C" __host__ cudaError_t CUDARTAPI cudaMemGetInfo(size_t *free, size_t *total) {
     // cout << "cudaMemGetInfo called" << endl;
     CudaRtFrontend::Prepare();
@@ -82,9 +96,11 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaFree(void *devPtr) {
         devPtr = remotePointer.pointer;
     }
 
+    CudaRtDevices::Route route(CudaRtDevices::Owner(devPtr));
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddDevicePointerForArguments(devPtr);
     CudaRtFrontend::Execute("cudaFree");
+    if (CudaRtFrontend::Success()) CudaRtDevices::Disown(devPtr);
     return CudaRtFrontend::GetExitCode();
 }
 
@@ -96,6 +112,8 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaFreeArray(cudaArray *array) {
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaFreeHost(void *ptr) {
+    cudaError_t result;
+    if (CudaRtPinned::Free(ptr, &result)) return result;
     free(ptr);
     return cudaSuccess;
 }
@@ -124,8 +142,10 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaHostAlloc(void **ptr, size_t size,
 #ifdef DEBUG
     printf("Requesting cudaHostAlloc\n");
 #endif
-    // Achtung: we can't use host page-locked memory, so we use simple pageable
-    // memory here.
+    cudaError_t result;
+    if (CudaRtPinned::Alloc(ptr, size, flags, &result)) return result;
+    // Achtung: the backend cannot map memory of this process, so we use simple
+    // pageable memory here.
     if ((*ptr = malloc(size)) == NULL) return cudaErrorMemoryAllocation;
     return cudaSuccess;
 }
@@ -135,7 +155,9 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaHostGetDevicePointer(void **pDevic
 #ifdef DEBUG
     printf("Requesting cudaHostGetDevicePointer\n");
 #endif
-    // Achtung: we can't use mapped memory
+    cudaError_t result;
+    if (CudaRtPinned::GetDevicePointer(pDevice, pHost, flags, &result)) return result;
+    // Achtung: only the memory shared with the backend is mapped
     return cudaErrorMemoryAllocation;
 }
 
@@ -143,6 +165,7 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaHostGetFlags(unsigned int *pFlags,
 #ifdef DEBUG
     printf("Requesting cudaHostGetFlags\n");
 #endif
+    if (CudaRtPinned::GetFlags(pFlags, pHost)) return cudaSuccess;
     // Achtung: falling back to the simplest method because we can't map memory
     *pFlags = cudaHostAllocDefault;
     return cudaSuccess;
@@ -158,6 +181,7 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaMalloc(void **devPtr, size_t size)
         *devPtr = CudaRtFrontend::GetOutputDevicePointer();
         // cout << "cudaMalloc frontend devPtr: " << *devPtr << endl;
         CudaRtFrontend::addDevicePointer(*devPtr);
+        CudaRtDevices::Own(*devPtr, size);
     }
     return CudaRtFrontend::GetExitCode();
 }
@@ -201,8 +225,10 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaMallocArray(cudaArray **arrayPtr,
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaMallocHost(void **ptr, size_t size) {
-    // Achtung: we can't use host page-locked memory, so we use simple pageable
-    // memory here.
+    cudaError_t result;
+    if (CudaRtPinned::Alloc(ptr, size, cudaHostAllocDefault, &result)) return result;
+    // Achtung: the backend cannot map memory of this process, so we use simple
+    // pageable memory here.
     if ((*ptr = malloc(size)) == NULL) return cudaErrorMemoryAllocation;
     return cudaSuccess;
 }
@@ -219,6 +245,7 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaMallocPitch(void **devPtr, size_t
     if (CudaRtFrontend::Success()) {
         *devPtr = CudaRtFrontend::GetOutputDevicePointer();
         *pitch = CudaRtFrontend::GetOutputVariable<size_t>();
+        CudaRtDevices::Own(*devPtr, *pitch * height);
     }
     return CudaRtFrontend::GetExitCode();
 }
@@ -226,6 +253,18 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaMallocPitch(void **devPtr, size_t
 extern "C" __host__ cudaError_t CUDARTAPI cudaMemcpyPeerAsync(void *dst, int dstDevice,
                                                               const void *src, int srcDevice,
                                                               size_t count, cudaStream_t stream) {
+    size_t dstBackend, srcBackend;
+    if (!CudaRtDevices::Locate(dstDevice, &dstBackend, &dstDevice) ||
+        !CudaRtDevices::Locate(srcDevice, &srcBackend, &srcDevice))
+        return cudaErrorInvalidDevice;
+    if (dstBackend != srcBackend) {
+        // after the work queued before it, and done when it returns
+        cudaError_t result = cudaStreamSynchronize(stream);
+        if (result != cudaSuccess) return result;
+        return CudaRtDevices::Stage(dst, dstBackend, src, srcBackend, count);
+    }
+
+    CudaRtDevices::Route route(dstBackend);
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddDevicePointerForArguments(dst);
     CudaRtFrontend::AddVariableForArguments(dstDevice);
@@ -244,6 +283,26 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaMemcpyPeerAsync(void *dst, int dst
     return CudaRtFrontend::GetExitCode();
 }
 
+extern "C" __host__ cudaError_t CUDARTAPI cudaMemcpyPeer(void *dst, int dstDevice, const void *src,
+                                                         int srcDevice, size_t count) {
+    size_t dstBackend, srcBackend;
+    if (!CudaRtDevices::Locate(dstDevice, &dstBackend, &dstDevice) ||
+        !CudaRtDevices::Locate(srcDevice, &srcBackend, &srcDevice))
+        return cudaErrorInvalidDevice;
+    if (dstBackend != srcBackend)
+        return CudaRtDevices::Stage(dst, dstBackend, src, srcBackend, count);
+
+    CudaRtDevices::Route route(dstBackend);
+    CudaRtFrontend::Prepare();
+    CudaRtFrontend::AddDevicePointerForArguments(dst);
+    CudaRtFrontend::AddVariableForArguments(dstDevice);
+    CudaRtFrontend::AddDevicePointerForArguments(src);
+    CudaRtFrontend::AddVariableForArguments(srcDevice);
+    CudaRtFrontend::AddVariableForArguments(count);
+    CudaRtFrontend::Execute("cudaMemcpyPeer");
+    return CudaRtFrontend::GetExitCode();
+}
+
 extern "C" __host__ CUDARTAPI cudaError_t cudaMallocManaged(void **devPtr, size_t size,
                                                             unsigned flags) {
     *devPtr = malloc(size);
@@ -297,6 +356,17 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaMemcpy(void *dst, const void *src,
         kind = inferMemcpyKind(dst, src);
     }
 
+    // to the backend of the device memory, through the frontend between two
+    if (kind == cudaMemcpyDeviceToDevice && AmbiguousCopy(dst, src)) return cudaErrorInvalidValue;
+    size_t backend = CudaRtDevices::Owner(kind == cudaMemcpyDeviceToHost ? src : dst);
+    if (kind == cudaMemcpyDeviceToDevice && CudaRtDevices::Owner(src) != backend)
+        return CudaRtDevices::Stage(dst, backend, src, CudaRtDevices::Owner(src), count);
+    CudaRtDevices::Route route(backend);
+
+    // host memory shared with the backend: only the addresses are sent
+    cudaError_t result;
+    if (CudaRtPinned::Memcpy(dst, src, count, kind, backend, &result)) return result;
+
     CudaRtFrontend::Prepare();
 
     switch (kind) {
@@ -541,6 +611,21 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaMemcpyAsync(void *dst, const void
         kind = inferMemcpyKind(dst, src);
     }
 
+    if (kind == cudaMemcpyDeviceToDevice && AmbiguousCopy(dst, src)) return cudaErrorInvalidValue;
+    size_t backend = CudaRtDevices::Owner(kind == cudaMemcpyDeviceToHost ? src : dst);
+    if (kind == cudaMemcpyDeviceToDevice && CudaRtDevices::Owner(src) != backend) {
+        // after the work queued before it, and done when it returns
+        cudaError_t result = cudaStreamSynchronize(stream);
+        if (result != cudaSuccess) return result;
+        return CudaRtDevices::Stage(dst, backend, src, CudaRtDevices::Owner(src), count);
+    }
+    CudaRtDevices::Route route(backend);
+
+    // host memory shared with the backend: copied on the stream, into or from its mapping
+    cudaError_t result;
+    if (CudaRtPinned::MemcpyAsync(dst, src, count, kind, backend, stream, &result))
+        return result;
+
     CudaRtFrontend::Prepare();
     // cout << "cudaMemcpyAsync frontend: "
     //      << "dst: " << dst << ", src: " << src << ", count: " << count
@@ -833,6 +918,7 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaMemcpyToSymbolAsync(const void *sy
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaMemset(void *devPtr, int c, size_t count) {
+    CudaRtDevices::Route route(CudaRtDevices::Owner(devPtr));
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddDevicePointerForArguments(devPtr);
     CudaRtFrontend::AddVariableForArguments(c);
@@ -857,6 +943,7 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaMemset2DAsync(void *devPtr, size_t
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaMemsetAsync(void *devPtr, int c, size_t count,
                                                           cudaStream_t stream) {
+    CudaRtDevices::Route route(CudaRtDevices::Owner(devPtr));
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddDevicePointerForArguments(devPtr);
     CudaRtFrontend::AddVariableForArguments(c);
@@ -26,14 +26,41 @@
  *            School of Computer Science, University College Dublin
  */
 
+#include <cstdlib>
+#include <cstring>
+
 #include "CudaRt.h"
+#include "CudaRtOccupancy.h"
 using namespace std;
 
 using gvirtus::common::pointer_t;
 
+/*
+ * Runs the occupancy calculator in the frontend, on the properties of the
+ * device and the attributes of func it keeps. False when the backend must
+ * answer: the calculator does not cover the inputs, or
+ * GVIRTUS_CUDART_OCCUPANCY=remote asks for it (to compare the two).
+ */
+static bool LocalMaxActiveBlocks(int* numBlocks, const void* func, int blockSize,
+                                 size_t dynamicSMemSize, unsigned int flags) {
+    const char* mode = getenv("GVIRTUS_CUDART_OCCUPANCY");
+    if (mode != NULL && strcmp(mode, "remote") == 0) return false;
+    /* cudaOccupancyDisableCachingOverride only matters before Volta */
+    if ((flags & ~cudaOccupancyDisableCachingOverride) != 0) return false;
+    if (CudaRtFrontend::hasCachePreference(func)) return false;
+    cudaDeviceProp prop;
+    cudaFuncAttributes attr;
+    if (!CudaRtFrontend::getCurrentDeviceProperties(&prop)) return false;
+    if (CudaRtFrontend::getFuncAttributes(func, &attr) != cudaSuccess) return false;
+    return CudaRtOccupancy::MaxActiveBlocksPerMultiprocessor(prop, attr, blockSize,
+                                                             dynamicSMemSize, numBlocks);
+}
+
 /* cudaOccupancyMaxActiveBlocksPerMultiprocessor */
 extern "C" __host__ cudaError_t cudaOccupancyMaxActiveBlocksPerMultiprocessor(
     int* numBlocks, const void* func, int blockSize, size_t dynamicSMemSize) {
+    if (LocalMaxActiveBlocks(numBlocks, func, blockSize, dynamicSMemSize, cudaOccupancyDefault))
+        return cudaSuccess;
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddHostPointerForArguments(numBlocks);
     CudaRtFrontend::AddVariableForArguments((pointer_t)func);
@@ -48,6 +75,8 @@ extern "C" __host__ cudaError_t cudaOccupancyMaxActiveBlocksPerMultiprocessor(
 /* cudaOccupancyMaxActiveBlocksPerMultiprocessorWithFlags */
 extern "C" __host__ cudaError_t cudaOccupancyMaxActiveBlocksPerMultiprocessorWithFlags(
     int* numBlocks, const void* func, int blockSize, size_t dynamicSMemSize, unsigned int flags) {
+    if (LocalMaxActiveBlocks(numBlocks, func, blockSize, dynamicSMemSize, flags))
+        return cudaSuccess;
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddHostPointerForArguments(numBlocks);
     CudaRtFrontend::AddVariableForArguments((pointer_t)func);
@@ -27,14 +27,18 @@
  */
 
 #include "CudaRt.h"
+#include "CudaRtDevices.h"
+#include "CudaRtNotifications.h"
 
 using namespace std;
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaStreamCreate(cudaStream_t* pStream) {
     CudaRtFrontend::Prepare();
     CudaRtFrontend::Execute("cudaStreamCreate");
-    if (CudaRtFrontend::Success())
+    if (CudaRtFrontend::Success()) {
         *pStream = (cudaStream_t)CudaRtFrontend::GetOutputDevicePointer();
+        CudaRtDevices::Own(*pStream);
+    }
     return CudaRtFrontend::GetExitCode();
 }
 
@@ -43,15 +47,20 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaStreamCreateWithFlags(cudaStream_t
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddVariableForArguments(flags);
     CudaRtFrontend::Execute("cudaStreamCreateWithFlags");
-    if (CudaRtFrontend::Success())
+    if (CudaRtFrontend::Success()) {
         *pStream = (cudaStream_t)CudaRtFrontend::GetOutputDevicePointer();
+        CudaRtDevices::Own(*pStream);
+    }
     return CudaRtFrontend::GetExitCode();
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaStreamDestroy(cudaStream_t stream) {
+    CudaRtNotifications::ForgetStream(stream);
+    CudaRtDevices::Route route(CudaRtDevices::Owner(stream));
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddDevicePointerForArguments(stream);
     CudaRtFrontend::Execute("cudaStreamDestroy");
+    if (CudaRtFrontend::Success()) CudaRtDevices::Disown(stream);
     return CudaRtFrontend::GetExitCode();
 }
 
@@ -62,6 +71,7 @@ unsigned int 	flags
 extern "C" __host__ cudaError_t CUDARTAPI cudaStreamWaitEvent(cudaStream_t stream,
                                                               cudaEvent_t event,
                                                               unsigned int flags) {
+    CudaRtDevices::Route route(CudaRtDevices::Owner(stream));
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddDevicePointerForArguments(stream);
     CudaRtFrontend::AddDevicePointerForArguments(event);
@@ -71,6 +81,9 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaStreamWaitEvent(cudaStream_t strea
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaStreamQuery(cudaStream_t stream) {
+    cudaError_t result;
+    if (CudaRtNotifications::QueryStream(stream, &result)) return result;
+    CudaRtDevices::Route route(CudaRtDevices::Owner(stream));
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddDevicePointerForArguments(stream);
     CudaRtFrontend::Execute("cudaStreamQuery");
@@ -84,12 +97,15 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaStreamCreateWithPriority(cudaStrea
     CudaRtFrontend::AddVariableForArguments(flags);
     CudaRtFrontend::AddVariableForArguments(priority);
     CudaRtFrontend::Execute("cudaStreamCreateWithPriority");
-    if (CudaRtFrontend::Success())
+    if (CudaRtFrontend::Success()) {
         *pStream = (cudaStream_t)CudaRtFrontend::GetOutputDevicePointer();
+        CudaRtDevices::Own(*pStream);
+    }
     return CudaRtFrontend::GetExitCode();
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaStreamSynchronize(cudaStream_t stream) {
+    CudaRtDevices::Route route(CudaRtDevices::Owner(stream));
     CudaRtFrontend::Prepare();
     CudaRtFrontend::AddDevicePointerForArguments(stream);
     CudaRtFrontend::Execute("cudaStreamSynchronize");
@@ -196,20 +212,15 @@ extern "C" __host__ cudaError_t CUDARTAPI cudaStreamEndCapture(cudaStream_t stre
     return CudaRtFrontend::GetExitCode();
 }
 
-// TODO: needs fixing
+// callback runs in the frontend, sent by the backend over the notification channel
 extern "C" __host__ cudaError_t CUDARTAPI cudaStreamAddCallback(cudaStream_t stream,
                                                                 cudaStreamCallback_t callback,
                                                                 void* userData,
                                                                 unsigned int flags) {
-    // IMPORTANT: cudaStreamCallback_t is a function pointer type
-    // not sure how to handle it in the frontend
-    CudaRtFrontend::Prepare();
-    CudaRtFrontend::AddDevicePointerForArguments(stream);
-    // CudaRtFrontend::AddDevicePointerForArguments(callback);
-    CudaRtFrontend::AddDevicePointerForArguments(userData);
-    CudaRtFrontend::AddVariableForArguments(flags);
-    CudaRtFrontend::Execute("cudaStreamAddCallback");
-    return CudaRtFrontend::GetExitCode();
+    cudaError_t result;
+    if (CudaRtNotifications::AddCallback(stream, callback, userData, flags, &result))
+        return result;
+    return cudaErrorNotSupported;
 }
 
 // TODO: needs testing
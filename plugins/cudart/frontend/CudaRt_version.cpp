@@ -26,20 +26,34 @@
  *             Department of Computer Science, University College Dublin
  */
 
+#include <gvirtus/frontend/LocalTier.h>
+
 #include "CudaRt.h"
 
 using namespace std;
 
+using gvirtus::frontend::LocalCache;
+
+/* Asks the backend, once per process, for the version routine returns. */
+static cudaError_t RemoteVersion(const char* routine, int* version) {
+    static LocalCache<string, int> versions;
+    cudaError_t exit_code = cudaSuccess;
+    const int* cached = versions.Get(routine, [&](int* value) {
+        CudaRtFrontend::Prepare();
+        CudaRtFrontend::Execute(routine);
+        exit_code = CudaRtFrontend::GetExitCode();
+        if (!CudaRtFrontend::Success()) return false;
+        *value = CudaRtFrontend::GetOutputVariable<int>();
+        return true;
+    });
+    if (cached != nullptr) *version = *cached;
+    return exit_code;
+}
+
 extern "C" __host__ cudaError_t CUDARTAPI cudaDriverGetVersion(int *driverVersion) {
-    CudaRtFrontend::Prepare();
-    CudaRtFrontend::Execute("cudaDriverGetVersion");
-    if (CudaRtFrontend::Success()) *driverVersion = CudaRtFrontend::GetOutputVariable<int>();
-    return CudaRtFrontend::GetExitCode();
+    return RemoteVersion("cudaDriverGetVersion", driverVersion);
 }
 
 extern "C" __host__ cudaError_t CUDARTAPI cudaRuntimeGetVersion(int *runtimeVersion) {
-    CudaRtFrontend::Prepare();
-    CudaRtFrontend::Execute("cudaRuntimeGetVersion");
-    if (CudaRtFrontend::Success()) *runtimeVersion = CudaRtFrontend::GetOutputVariable<int>();
-    return CudaRtFrontend::GetExitCode();
+    return RemoteVersion("cudaRuntimeGetVersion", runtimeVersion);
 }
@@ -0,0 +1,57 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**
+ * @file   CudaRtNotification.h
+ *
+ * @brief  A completion the backend pushes to the frontend: an event or a
+ * stream reached the point where it was recorded or marked, or a callback
+ * the application added to a stream is due.
+ *
+ * The frontend receives them with a long poll (cudaNotificationsWait) from a
+ * thread of its own, which has its own connection, and answers
+ * cudaEventQuery, cudaEventSynchronize and cudaStreamQuery from them.
+ */
+
+#ifndef _CUDARTNOTIFICATION_H
+#define _CUDARTNOTIFICATION_H
+
+#include <cstdint>
+
+struct CudaRtNotification {
+    enum Kind : int32_t {
+        /* the record of event handle numbered seq completed */
+        EVENT = 0,
+        /* the marker numbered seq added to stream handle completed */
+        STREAM = 1,
+        /* the callback numbered seq is due; its stream waits for the ack */
+        CALLBACK = 2
+    };
+
+    int32_t kind;
+    /* the cudaError_t of the completion, or that the stream passed to the callback */
+    int32_t status;
+    uint64_t handle;
+    uint64_t seq;
+};
+
+#endif /* _CUDARTNOTIFICATION_H */
@@ -0,0 +1,217 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CudnnAlgorithmCache.h"
+
+#include <cuda_runtime.h>
+#include <fcntl.h>
+#include <log4cplus/loggingmacros.h>
+#include <stdint.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+using namespace std;
+using namespace log4cplus;
+
+static const char kMagic[8] = {'G', 'V', 'C', 'U', 'D', 'N', 'N', 'A'};
+
+/* Identifies the model of the current device, which is what the results depend on. */
+static string DeviceIdentity() {
+    static mutex identity_mutex;
+    static map<int, string> identities;
+
+    int device = 0;
+    if (cudaGetDevice(&device) != cudaSuccess) return "";
+    lock_guard<mutex> lock(identity_mutex);
+    auto it = identities.find(device);
+    if (it != identities.end()) return it->second;
+    cudaDeviceProp prop;
+    if (cudaGetDeviceProperties(&prop, device) != cudaSuccess) return "";
+    string identity(prop.name);
+    identity.push_back('\0');
+    identity.append(reinterpret_cast<const char *>(&prop.major), sizeof(prop.major));
+    identity.append(reinterpret_cast<const char *>(&prop.minor), sizeof(prop.minor));
+    identity.append(reinterpret_cast<const char *>(&prop.multiProcessorCount),
+                    sizeof(prop.multiProcessorCount));
+    identities[device] = identity;
+    return identity;
+}
+
+CudnnAlgorithmCache::Key::Key(const char *routine) : mBytes(routine), mValid(true) {
+    mBytes.push_back('\0');
+    Add<size_t>(CUDNN_VERSION);
+    Add<size_t>(cudnnGetVersion());
+    string identity = DeviceIdentity();
+    if (identity.empty()) mValid = false;
+    Add<size_t>(identity.size());
+    mBytes.append(identity);
+}
+
+void CudnnAlgorithmCache::Key::AddTensor(cudnnTensorDescriptor_t desc) {
+    cudnnDataType_t dataType;
+    int nbDims = 0;
+    int dims[CUDNN_DIM_MAX], strides[CUDNN_DIM_MAX];
+    if (cudnnGetTensorNdDescriptor(desc, CUDNN_DIM_MAX, &dataType, &nbDims, dims, strides) !=
+        CUDNN_STATUS_SUCCESS) {
+        mValid = false;
+        return;
+    }
+    Add(dataType);
+    Add(nbDims);
+    mBytes.append(reinterpret_cast<const char *>(dims), nbDims * sizeof(int));
+    mBytes.append(reinterpret_cast<const char *>(strides), nbDims * sizeof(int));
+}
+
+void CudnnAlgorithmCache::Key::AddFilter(cudnnFilterDescriptor_t desc) {
+    cudnnDataType_t dataType;
+    cudnnTensorFormat_t format;
+    int nbDims = 0;
+    int dims[CUDNN_DIM_MAX];
+    if (cudnnGetFilterNdDescriptor(desc, CUDNN_DIM_MAX, &dataType, &format, &nbDims, dims) !=
+        CUDNN_STATUS_SUCCESS) {
+        mValid = false;
+        return;
+    }
+    Add(dataType);
+    Add(format);
+    Add(nbDims);
+    mBytes.append(reinterpret_cast<const char *>(dims), nbDims * sizeof(int));
+}
+
+void CudnnAlgorithmCache::Key::AddConvolution(cudnnConvolutionDescriptor_t desc) {
+    int arrayLength = 0;
+    int pads[CUDNN_DIM_MAX], strides[CUDNN_DIM_MAX], dilations[CUDNN_DIM_MAX];
+    cudnnConvolutionMode_t mode = CUDNN_CROSS_CORRELATION;
+    cudnnDataType_t computeType = CUDNN_DATA_FLOAT;
+    cudnnMathType_t mathType = CUDNN_DEFAULT_MATH;
+    int groupCount = 1;
+    cudnnReorderType_t reorderType = CUDNN_DEFAULT_REORDER;
+    if (cudnnGetConvolutionNdDescriptor(desc, CUDNN_DIM_MAX, &arrayLength, pads, strides,
+                                        dilations, &mode, &computeType) != CUDNN_STATUS_SUCCESS ||
+        cudnnGetConvolutionMathType(desc, &mathType) != CUDNN_STATUS_SUCCESS ||
+        cudnnGetConvolutionGroupCount(desc, &groupCount) != CUDNN_STATUS_SUCCESS ||
+        cudnnGetConvolutionReorderType(desc, &reorderType) != CUDNN_STATUS_SUCCESS) {
+        mValid = false;
+        return;
+    }
+    Add(arrayLength);
+    mBytes.append(reinterpret_cast<const char *>(pads), arrayLength * sizeof(int));
+    mBytes.append(reinterpret_cast<const char *>(strides), arrayLength * sizeof(int));
+    mBytes.append(reinterpret_cast<const char *>(dilations), arrayLength * sizeof(int));
+    Add(mode);
+    Add(computeType);
+    Add(mathType);
+    Add(groupCount);
+    Add(reorderType);
+}
+
+CudnnAlgorithmCache &CudnnAlgorithmCache::GetInstance() {
+    static CudnnAlgorithmCache instance;
+    return instance;
+}
+
+CudnnAlgorithmCache::CudnnAlgorithmCache()
+    : logger(Logger::getInstance(LOG4CPLUS_TEXT("CudnnAlgorithmCache"))), mFd(-1) {
+    Load();
+}
+
+void CudnnAlgorithmCache::Load() {
+    const char *path = getenv("GVIRTUS_CUDNN_ALGO_CACHE");
+    if (path == NULL || *path == '\0') return;
+
+    mFd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (mFd < 0) {
+        LOG4CPLUS_WARN(logger, "Cannot open " << path << ": results are kept in memory");
+        return;
+    }
+    /* No other backend appends while the file is read and repaired. */
+    if (flock(mFd, LOCK_EX) != 0) {
+        LOG4CPLUS_WARN(logger, "Cannot lock " << path << ": results are kept in memory");
+        close(mFd);
+        mFd = -1;
+        return;
+    }
+
+    off_t size = lseek(mFd, 0, SEEK_END);
+    if (size == 0) {
+        if (write(mFd, kMagic, sizeof(kMagic)) != sizeof(kMagic)) {
+            close(mFd);
+            mFd = -1;
+            return;
+        }
+        flock(mFd, LOCK_UN);
+        return;
+    }
+
+    ifstream in(path, ios::binary);
+    char magic[sizeof(kMagic)];
+    if (!in.read(magic, sizeof(magic)) || memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        LOG4CPLUS_WARN(logger, "Ignoring " << path << ": not a cuDNN algorithm cache");
+        close(mFd);
+        mFd = -1;
+        return;
+    }
+    off_t end = sizeof(kMagic);
+    uint32_t sizes[2];
+    while (in.read(reinterpret_cast<char *>(sizes), sizeof(sizes))) {
+        if (sizes[0] + (off_t)sizes[1] > size - end - (off_t)sizeof(sizes)) break;
+        string key(sizes[0], '\0'), value(sizes[1], '\0');
+        if (!in.read(&key[0], key.size()) || !in.read(&value[0], value.size())) break;
+        mEntries[key] = value;
+        end += sizeof(sizes) + key.size() + value.size();
+    }
+    LOG4CPLUS_INFO(logger, "Loaded " << mEntries.size() << " cuDNN algorithm results from "
+                                     << path);
+
+    /*
+     * Under the lock every record is whole but one cut short by a crash while
+     * appending, which can only be the last: drop it, or the records appended
+     * after it could not be read back.
+     */
+    if (size > end && ftruncate(mFd, end) != 0)
+        LOG4CPLUS_WARN(logger, "Cannot drop the truncated record at the end of " << path);
+    flock(mFd, LOCK_UN);
+}
+
+void CudnnAlgorithmCache::Store(const string &key, const string &value) {
+    lock_guard<mutex> lock(mMutex);
+    if (!mEntries.emplace(key, value).second || mFd < 0) return;
+
+    /* One write per record, under the lock that the backends loading the file take. */
+    uint32_t sizes[2] = {(uint32_t)key.size(), (uint32_t)value.size()};
+    string record(reinterpret_cast<const char *>(sizes), sizeof(sizes));
+    record.append(key);
+    record.append(value);
+    if (flock(mFd, LOCK_EX) != 0) {
+        LOG4CPLUS_WARN(logger, "Cannot lock the cuDNN algorithm cache: " << strerror(errno));
+        return;
+    }
+    if (write(mFd, record.data(), record.size()) != (ssize_t)record.size())
+        LOG4CPLUS_WARN(logger, "Cannot append to the cuDNN algorithm cache: " << strerror(errno));
+    flock(mFd, LOCK_UN);
+}
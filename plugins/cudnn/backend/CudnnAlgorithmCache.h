@@ -0,0 +1,125 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CUDNNALGORITHMCACHE_H
+#define CUDNNALGORITHMCACHE_H
+
+#include <cudnn.h>
+#include <log4cplus/logger.h>
+
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/*
+ * CudnnAlgorithmCache memoizes the results of the cuDNN convolution algorithm
+ * searches (cudnnFind*Algorithm*, cudnnGet*Algorithm_v7) and workspace size
+ * queries, so that the clients of a backend asking for the same layer shapes
+ * on the same kind of GPU benchmark them only once.
+ *
+ * A result is keyed by the routine, the GPU model, the cuDNN version, the
+ * contents of the descriptors and the scalar arguments of the call. When
+ * GVIRTUS_CUDNN_ALGO_CACHE names a file, the cache is loaded from it at start
+ * and every new result is appended to it, so it survives restarts and can be
+ * shared by the backends of a fleet of identical GPUs. The backends sharing the
+ * file take an flock on it to load it and to append to it.
+ */
+class CudnnAlgorithmCache {
+   public:
+    class Key {
+       public:
+        explicit Key(const char *routine);
+
+        template <class T>
+        void Add(T value) {
+            mBytes.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        void AddTensor(cudnnTensorDescriptor_t desc);
+        void AddFilter(cudnnFilterDescriptor_t desc);
+        void AddConvolution(cudnnConvolutionDescriptor_t desc);
+
+        /* False when a descriptor could not be read back: the call is not cached. */
+        bool Valid() const { return mValid; }
+        const std::string &Bytes() const { return mBytes; }
+
+       private:
+        std::string mBytes;
+        bool mValid;
+    };
+
+    static CudnnAlgorithmCache &GetInstance();
+
+    /*
+     * Returns the cached results of key, or runs compute, which fills count
+     * and up to capacity results, and caches what it returned on success.
+     */
+    template <class T, class F>
+    cudnnStatus_t Memoize(const Key &key, int *count, T *results, int capacity, F compute) {
+        if (key.Valid() && Lookup(key, count, results, capacity)) return CUDNN_STATUS_SUCCESS;
+        cudnnStatus_t status = compute();
+        if (key.Valid() && status == CUDNN_STATUS_SUCCESS && *count >= 0 && *count <= capacity)
+            Insert(key, *count, results);
+        return status;
+    }
+
+    template <class T, class F>
+    cudnnStatus_t Memoize(const Key &key, T *result, F compute) {
+        int count = 1;
+        return Memoize(key, &count, result, 1, [&] {
+            cudnnStatus_t status = compute();
+            count = 1;
+            return status;
+        });
+    }
+
+   private:
+    CudnnAlgorithmCache();
+
+    template <class T>
+    bool Lookup(const Key &key, int *count, T *results, int capacity) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mEntries.find(key.Bytes());
+        if (it == mEntries.end()) return false;
+        int n = (int)(it->second.size() / sizeof(T));
+        if (it->second.size() % sizeof(T) != 0 || n > capacity) return false;
+        memcpy(results, it->second.data(), n * sizeof(T));
+        *count = n;
+        return true;
+    }
+
+    template <class T>
+    void Insert(const Key &key, int count, const T *results) {
+        Store(key.Bytes(), std::string(reinterpret_cast<const char *>(results), count * sizeof(T)));
+    }
+
+    void Store(const std::string &key, const std::string &value);
+    void Load();
+
+    log4cplus::Logger logger;
+    std::mutex mMutex;
+    std::unordered_map<std::string, std::string> mEntries;
+    int mFd;
+};
+
+#endif /* CUDNNALGORITHMCACHE_H */
@@ -28,6 +28,8 @@
 
 #include "CudnnHandler.h"
 
+#include "CudnnAlgorithmCache.h"
+
 using namespace std;
 using namespace log4cplus;
 
@@ -167,17 +169,20 @@ void CudnnHandler::Initialize() {
     /* CublasHandler Query Platform Info */
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(GetVersion));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(GetErrorString));
+    mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(GetCudartVersion));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(GetLastErrorString));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(Create));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(Destroy));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(SetStream));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(GetStream));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(GetProperty));
+    mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(ShadowFlush));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(CreateTensorDescriptor));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(SetTensor4dDescriptor));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(SetTensor4dDescriptorEx));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(GetTensor4dDescriptor));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(SetTensorNdDescriptor));
+    mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(SetTensorNdDescriptorEx));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(GetTensorNdDescriptor));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(GetTensorSizeInBytes));
     mspHandlers->insert(CUDNN_ROUTINE_HANDLER_PAIR(DestroyTensorDescriptor));
@@ -479,9 +484,19 @@ CUDNN_ROUTINE_HANDLER(FindConvolutionBackwardFilterAlgorithm) {
     cudnnConvolutionBwdFilterAlgoPerf_t *perfResults =
         in->Get<cudnnConvolutionBwdFilterAlgoPerf_t>(requestedAlgoCount);
 
-    cudnnStatus_t cs = cudnnFindConvolutionBackwardFilterAlgorithm(handle, xDesc, DyDesc, convDesc,
-                                                                   dwDesc, requestedAlgoCount,
-                                                                   &returnedAlgoCount, perfResults);
+    CudnnAlgorithmCache::Key key("cudnnFindConvolutionBackwardFilterAlgorithm");
+    key.AddTensor(xDesc);
+    key.AddTensor(DyDesc);
+    key.AddConvolution(convDesc);
+    key.AddFilter(dwDesc);
+    key.Add(requestedAlgoCount);
+
+    cudnnStatus_t cs = CudnnAlgorithmCache::GetInstance().Memoize(
+        key, &returnedAlgoCount, perfResults, requestedAlgoCount, [&] {
+            return cudnnFindConvolutionBackwardFilterAlgorithm(handle, xDesc, DyDesc, convDesc,
+                                                               dwDesc, requestedAlgoCount,
+                                                               &returnedAlgoCount, perfResults);
+        });
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cudnnFindConvolutionBackwardFilterAlgorithm Executed");
 
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
@@ -515,9 +530,9 @@ CUDNN_ROUTINE_HANDLER(GetConvolutionForwardAlgorithmMaxCount) {
 CUDNN_ROUTINE_HANDLER(SetConvolutionNdDescriptor) {
     cudnnConvolutionDescriptor_t convDesc = in->Get<cudnnConvolutionDescriptor_t>();
     int arrayLength = in->Get<int>();
-    int *padA = in->Assign<int>();
-    int *filterStrideA = in->Assign<int>();
-    int *dilationA = in->Assign<int>();
+    int *padA = in->Assign<int>(arrayLength);
+    int *filterStrideA = in->Assign<int>(arrayLength);
+    int *dilationA = in->Assign<int>(arrayLength);
     cudnnConvolutionMode_t mode = in->Get<cudnnConvolutionMode_t>();
     cudnnDataType_t computeType = in->Get<cudnnDataType_t>();
 
@@ -568,9 +583,20 @@ CUDNN_ROUTINE_HANDLER(FindConvolutionBackwardFilterAlgorithmEx) {
     void *workSpace = in->GetFromMarshal<void *>();                        // INPUT
     size_t workSpaceSizeInBytes = in->Get<size_t>();                       // INPUT
 
-    cudnnStatus_t cs = cudnnFindConvolutionBackwardFilterAlgorithmEx(
-        handle, xDesc, x, dyDesc, y, convDesc, dwDesc, dw, requestedAlgoCount, &returnedAlgoCount,
-        perfResults, workSpace, workSpaceSizeInBytes);
+    CudnnAlgorithmCache::Key key("cudnnFindConvolutionBackwardFilterAlgorithmEx");
+    key.AddTensor(xDesc);
+    key.AddTensor(dyDesc);
+    key.AddConvolution(convDesc);
+    key.AddFilter(dwDesc);
+    key.Add(requestedAlgoCount);
+    key.Add(workSpaceSizeInBytes);
+
+    cudnnStatus_t cs = CudnnAlgorithmCache::GetInstance().Memoize(
+        key, &returnedAlgoCount, perfResults, requestedAlgoCount, [&] {
+            return cudnnFindConvolutionBackwardFilterAlgorithmEx(
+                handle, xDesc, x, dyDesc, y, convDesc, dwDesc, dw, requestedAlgoCount,
+                &returnedAlgoCount, perfResults, workSpace, workSpaceSizeInBytes);
+        });
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cudnnFindConvolutionBackwardFilterAlgorithmEx Executed");
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     try {
@@ -636,9 +662,20 @@ CUDNN_ROUTINE_HANDLER(FindConvolutionForwardAlgorithmEx) {
     void *workSpace = in->GetFromMarshal<void *>();
     size_t workSpaceSizeInBytes = in->Get<size_t>();
 
-    cudnnStatus_t cs = cudnnFindConvolutionForwardAlgorithmEx(
-        handle, xDesc, x, wDesc, w, convDesc, yDesc, y, requestedAlgoCount, &returnedAlgoCount,
-        perfResults, workSpace, workSpaceSizeInBytes);
+    CudnnAlgorithmCache::Key key("cudnnFindConvolutionForwardAlgorithmEx");
+    key.AddTensor(xDesc);
+    key.AddFilter(wDesc);
+    key.AddConvolution(convDesc);
+    key.AddTensor(yDesc);
+    key.Add(requestedAlgoCount);
+    key.Add(workSpaceSizeInBytes);
+
+    cudnnStatus_t cs = CudnnAlgorithmCache::GetInstance().Memoize(
+        key, &returnedAlgoCount, perfResults, requestedAlgoCount, [&] {
+            return cudnnFindConvolutionForwardAlgorithmEx(
+                handle, xDesc, x, wDesc, w, convDesc, yDesc, y, requestedAlgoCount,
+                &returnedAlgoCount, perfResults, workSpace, workSpaceSizeInBytes);
+        });
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cudnnFindConvolutionForwardAlgorithmEx Executed");
 
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
@@ -723,8 +760,19 @@ CUDNN_ROUTINE_HANDLER(GetConvolutionForwardAlgorithm_v7) {
     cudnnConvolutionFwdAlgoPerf_t *perfResults =
         in->Get<cudnnConvolutionFwdAlgoPerf_t>(requestedAlgoCount);
 
-    cudnnStatus_t cs = cudnnGetConvolutionForwardAlgorithm_v7(
-        handle, xDesc, wDesc, convDesc, yDesc, requestedAlgoCount, &returnedAlgoCount, perfResults);
+    CudnnAlgorithmCache::Key key("cudnnGetConvolutionForwardAlgorithm_v7");
+    key.AddTensor(xDesc);
+    key.AddFilter(wDesc);
+    key.AddConvolution(convDesc);
+    key.AddTensor(yDesc);
+    key.Add(requestedAlgoCount);
+
+    cudnnStatus_t cs = CudnnAlgorithmCache::GetInstance().Memoize(
+        key, &returnedAlgoCount, perfResults, requestedAlgoCount, [&] {
+            return cudnnGetConvolutionForwardAlgorithm_v7(handle, xDesc, wDesc, convDesc, yDesc,
+                                                          requestedAlgoCount, &returnedAlgoCount,
+                                                          perfResults);
+        });
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cudnnGetConvolutionForwardAlgorithm_v7  Executed");
 
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
@@ -862,9 +910,19 @@ CUDNN_ROUTINE_HANDLER(GetConvolutionBackwardFilterAlgorithm_v7) {
     cudnnConvolutionBwdFilterAlgoPerf_t *perfResults =
         in->Get<cudnnConvolutionBwdFilterAlgoPerf_t>(requestedAlgoCount);
 
-    cudnnStatus_t cs = cudnnGetConvolutionBackwardFilterAlgorithm_v7(
-        handle, xDesc, dyDesc, convDesc, dwDesc, requestedAlgoCount, &returnedAlgoCount,
-        perfResults);
+    CudnnAlgorithmCache::Key key("cudnnGetConvolutionBackwardFilterAlgorithm_v7");
+    key.AddTensor(xDesc);
+    key.AddTensor(dyDesc);
+    key.AddConvolution(convDesc);
+    key.AddFilter(dwDesc);
+    key.Add(requestedAlgoCount);
+
+    cudnnStatus_t cs = CudnnAlgorithmCache::GetInstance().Memoize(
+        key, &returnedAlgoCount, perfResults, requestedAlgoCount, [&] {
+            return cudnnGetConvolutionBackwardFilterAlgorithm_v7(
+                handle, xDesc, dyDesc, convDesc, dwDesc, requestedAlgoCount, &returnedAlgoCount,
+                perfResults);
+        });
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "GetConvolutionBackwardFilterAlgorithm_v7  Executed");
 
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
@@ -887,16 +945,27 @@ CUDNN_ROUTINE_HANDLER(FindConvolutionForwardAlgorithm) {
     cudnnTensorDescriptor_t yDesc = in->Get<cudnnTensorDescriptor_t>();
     int requestedAlgoCount = in->Get<int>();
     int returnedAlgoCount;
-    cudnnConvolutionFwdAlgoPerf_t perfResults;
+    cudnnConvolutionFwdAlgoPerf_t *perfResults =
+        in->Get<cudnnConvolutionFwdAlgoPerf_t>(requestedAlgoCount);
 
-    cudnnStatus_t cs =
-        cudnnFindConvolutionForwardAlgorithm(handle, xDesc, wDesc, convDesc, yDesc,
-                                             requestedAlgoCount, &returnedAlgoCount, &perfResults);
+    CudnnAlgorithmCache::Key key("cudnnFindConvolutionForwardAlgorithm");
+    key.AddTensor(xDesc);
+    key.AddFilter(wDesc);
+    key.AddConvolution(convDesc);
+    key.AddTensor(yDesc);
+    key.Add(requestedAlgoCount);
+
+    cudnnStatus_t cs = CudnnAlgorithmCache::GetInstance().Memoize(
+        key, &returnedAlgoCount, perfResults, requestedAlgoCount, [&] {
+            return cudnnFindConvolutionForwardAlgorithm(handle, xDesc, wDesc, convDesc, yDesc,
+                                                        requestedAlgoCount, &returnedAlgoCount,
+                                                        perfResults);
+        });
 
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     try {
         out->Add<int>(returnedAlgoCount);
-        out->Add<cudnnConvolutionFwdAlgoPerf_t>(perfResults);
+        out->Add<cudnnConvolutionFwdAlgoPerf_t>(perfResults, returnedAlgoCount);
     } catch (const std::exception &e) {
         LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
         return std::make_shared<Result>(CUDNN_STATUS_EXECUTION_FAILED);
@@ -1058,8 +1127,17 @@ CUDNN_ROUTINE_HANDLER(GetConvolutionBackwardFilterWorkspaceSize) {
     cudnnConvolutionBwdFilterAlgo_t algo = in->Get<cudnnConvolutionBwdFilterAlgo_t>();
     size_t sizeInBytes;
 
-    cudnnStatus_t cs = cudnnGetConvolutionBackwardFilterWorkspaceSize(
-        handle, xDesc, dyDesc, convDesc, dwDesc, algo, &sizeInBytes);
+    CudnnAlgorithmCache::Key key("cudnnGetConvolutionBackwardFilterWorkspaceSize");
+    key.AddTensor(xDesc);
+    key.AddTensor(dyDesc);
+    key.AddConvolution(convDesc);
+    key.AddFilter(dwDesc);
+    key.Add(algo);
+
+    cudnnStatus_t cs = CudnnAlgorithmCache::GetInstance().Memoize(key, &sizeInBytes, [&] {
+        return cudnnGetConvolutionBackwardFilterWorkspaceSize(handle, xDesc, dyDesc, convDesc,
+                                                              dwDesc, algo, &sizeInBytes);
+    });
 
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     try {
@@ -1168,8 +1246,17 @@ CUDNN_ROUTINE_HANDLER(GetConvolutionForwardWorkspaceSize) {
     cudnnConvolutionFwdAlgo_t algo = in->Get<cudnnConvolutionFwdAlgo_t>();
     size_t sizeInBytes;
 
-    cudnnStatus_t cs = cudnnGetConvolutionForwardWorkspaceSize(handle, xDesc, wDesc, convDesc,
-                                                               yDesc, algo, &sizeInBytes);
+    CudnnAlgorithmCache::Key key("cudnnGetConvolutionForwardWorkspaceSize");
+    key.AddTensor(xDesc);
+    key.AddFilter(wDesc);
+    key.AddConvolution(convDesc);
+    key.AddTensor(yDesc);
+    key.Add(algo);
+
+    cudnnStatus_t cs = CudnnAlgorithmCache::GetInstance().Memoize(key, &sizeInBytes, [&] {
+        return cudnnGetConvolutionForwardWorkspaceSize(handle, xDesc, wDesc, convDesc, yDesc, algo,
+                                                       &sizeInBytes);
+    });
 
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     try {
@@ -1182,6 +1269,46 @@ CUDNN_ROUTINE_HANDLER(GetConvolutionForwardWorkspaceSize) {
     return std::make_shared<Result>(cs, out);
 }
 
+/*
+ * Runs the descriptor sets deferred by the frontend (see CudnnShadow), then
+ * the call that carried them. Every call comes as its routine name followed
+ * by its marshalled arguments.
+ *
+ * The carried call runs even if a set failed, so that a destroy is never
+ * lost. It answers with its own status and output, followed by the index of
+ * the first set that failed (-1 if none) and that set's status.
+ */
+CUDNN_ROUTINE_HANDLER(ShadowFlush) {
+    int deferred_status = CUDNN_STATUS_SUCCESS;
+    int deferred_index = -1;
+    size_t count = in->Get<size_t>();
+    for (size_t i = 0; i < count; i++) {
+        std::string routine(in->AssignString());
+        size_t size = in->Get<size_t>();
+        auto arguments = std::make_shared<Buffer>(in->Assign<char>(size), size);
+        auto result = pThis->Execute(routine, arguments);
+        int status = result == nullptr ? CUDNN_STATUS_INTERNAL_ERROR : result->GetExitCode();
+        if (status != CUDNN_STATUS_SUCCESS) {
+            LOG4CPLUS_DEBUG(pThis->GetLogger(),
+                            "deferred " << routine << " failed with " << status);
+            if (deferred_index < 0) {
+                deferred_index = (int)i;
+                deferred_status = status;
+            }
+        }
+    }
+    std::string routine(in->AssignString());
+    size_t size = in->Get<size_t>();
+    auto arguments = std::make_shared<Buffer>(in->Assign<char>(size), size);
+    auto result = pThis->Execute(routine, arguments);
+    int exit_code = result == nullptr ? CUDNN_STATUS_INTERNAL_ERROR : result->GetExitCode();
+    std::shared_ptr<Buffer> out = result == nullptr ? nullptr : result->GetOutputBuffer();
+    if (out == nullptr) out = std::make_shared<Buffer>();
+    out->Add(deferred_index);
+    out->Add(deferred_status);
+    return std::make_shared<Result>(exit_code, out);
+}
+
 CUDNN_ROUTINE_HANDLER(GetVersion) {
     size_t version = cudnnGetVersion();
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cudnnGetVersion Executed, version: " << version);
@@ -1202,6 +1329,14 @@ CUDNN_ROUTINE_HANDLER(GetErrorString) {
     return std::make_shared<Result>(CUDNN_STATUS_SUCCESS, out);
 }
 
+CUDNN_ROUTINE_HANDLER(GetCudartVersion) {
+    size_t version = cudnnGetCudartVersion();
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    out->Add(version);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "cudnnGetCudartVersion Executed, version: " << version);
+    return std::make_shared<Result>(CUDNN_STATUS_SUCCESS, out);
+}
+
 CUDNN_ROUTINE_HANDLER(GetLastErrorString) {
     size_t max_size = in->Get<size_t>();
     char s[max_size];
@@ -1382,11 +1517,11 @@ CUDNN_ROUTINE_HANDLER(SetTensorNdDescriptor) {
 }
 
 CUDNN_ROUTINE_HANDLER(SetTensorNdDescriptorEx) {
-    cudnnTensorDescriptor_t tensorDesc;
+    cudnnTensorDescriptor_t tensorDesc = in->Get<cudnnTensorDescriptor_t>();
     cudnnTensorFormat_t format = in->Get<cudnnTensorFormat_t>();
     cudnnDataType_t dataType = in->Get<cudnnDataType_t>();
     int nbDims = in->Get<int>();
-    int *dimA = in->Assign<int>();
+    int *dimA = in->Assign<int>(nbDims);
 
     cudnnStatus_t cs = cudnnSetTensorNdDescriptorEx(tensorDesc, format, dataType, nbDims, dimA);
 
@@ -2200,7 +2335,7 @@ CUDNN_ROUTINE_HANDLER(SetFilterNdDescriptor) {
     cudnnDataType_t dataType = in->Get<cudnnDataType_t>();
     cudnnTensorFormat_t format = in->Get<cudnnTensorFormat_t>();
     int nbDims = in->Get<int>();
-    const int *filterDimA = in->Assign<const int>();
+    const int *filterDimA = in->Assign<const int>(nbDims);
 
     cudnnStatus_t cs = cudnnSetFilterNdDescriptor(filterDesc, dataType, format, nbDims, filterDimA);
 
@@ -2424,9 +2559,19 @@ CUDNN_ROUTINE_HANDLER(FindConvolutionBackwardDataAlgorithm) {
     cudnnConvolutionBwdDataAlgoPerf_t *perfResults =
         in->Get<cudnnConvolutionBwdDataAlgoPerf_t>(requestedAlgoCount);
 
-    cudnnStatus_t cs = cudnnFindConvolutionBackwardDataAlgorithm(handle, wDesc, dyDesc, convDesc,
-                                                                 dxDesc, requestedAlgoCount,
-                                                                 &returnedAlgoCount, perfResults);
+    CudnnAlgorithmCache::Key key("cudnnFindConvolutionBackwardDataAlgorithm");
+    key.AddFilter(wDesc);
+    key.AddTensor(dyDesc);
+    key.AddConvolution(convDesc);
+    key.AddTensor(dxDesc);
+    key.Add(requestedAlgoCount);
+
+    cudnnStatus_t cs = CudnnAlgorithmCache::GetInstance().Memoize(
+        key, &returnedAlgoCount, perfResults, requestedAlgoCount, [&] {
+            return cudnnFindConvolutionBackwardDataAlgorithm(handle, wDesc, dyDesc, convDesc,
+                                                             dxDesc, requestedAlgoCount,
+                                                             &returnedAlgoCount, perfResults);
+        });
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cudnnFindConvolutionBackwardDataAlgorithm Executed");
 
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
@@ -2457,9 +2602,20 @@ CUDNN_ROUTINE_HANDLER(FindConvolutionBackwardDataAlgorithmEx) {
     void *workSpace = in->GetFromMarshal<void *>();                      // INPUT
     size_t workSpaceSizeInBytes = in->Get<size_t>();                     // INPUT
 
-    cudnnStatus_t cs = cudnnFindConvolutionBackwardDataAlgorithmEx(
-        handle, wDesc, w, dyDesc, dy, convDesc, dxDesc, dx, requestedAlgoCount, &returnedAlgoCount,
-        perfResults, workSpace, workSpaceSizeInBytes);
+    CudnnAlgorithmCache::Key key("cudnnFindConvolutionBackwardDataAlgorithmEx");
+    key.AddFilter(wDesc);
+    key.AddTensor(dyDesc);
+    key.AddConvolution(convDesc);
+    key.AddTensor(dxDesc);
+    key.Add(requestedAlgoCount);
+    key.Add(workSpaceSizeInBytes);
+
+    cudnnStatus_t cs = CudnnAlgorithmCache::GetInstance().Memoize(
+        key, &returnedAlgoCount, perfResults, requestedAlgoCount, [&] {
+            return cudnnFindConvolutionBackwardDataAlgorithmEx(
+                handle, wDesc, w, dyDesc, dy, convDesc, dxDesc, dx, requestedAlgoCount,
+                &returnedAlgoCount, perfResults, workSpace, workSpaceSizeInBytes);
+        });
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cudnnFindConvolutionBackwardDataAlgorithmEx Executed");
 
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
@@ -2513,9 +2669,19 @@ CUDNN_ROUTINE_HANDLER(GetConvolutionBackwardDataAlgorithm_v7) {
     cudnnConvolutionBwdDataAlgoPerf_t *perfResults =
         in->Get<cudnnConvolutionBwdDataAlgoPerf_t>(requestedAlgoCount);
 
-    cudnnStatus_t cs = cudnnGetConvolutionBackwardDataAlgorithm_v7(
-        handle, filterDesc, diffDesc, convDesc, gradDesc, requestedAlgoCount, &returnedAlgoCount,
-        perfResults);
+    CudnnAlgorithmCache::Key key("cudnnGetConvolutionBackwardDataAlgorithm_v7");
+    key.AddFilter(filterDesc);
+    key.AddTensor(diffDesc);
+    key.AddConvolution(convDesc);
+    key.AddTensor(gradDesc);
+    key.Add(requestedAlgoCount);
+
+    cudnnStatus_t cs = CudnnAlgorithmCache::GetInstance().Memoize(
+        key, &returnedAlgoCount, perfResults, requestedAlgoCount, [&] {
+            return cudnnGetConvolutionBackwardDataAlgorithm_v7(
+                handle, filterDesc, diffDesc, convDesc, gradDesc, requestedAlgoCount,
+                &returnedAlgoCount, perfResults);
+        });
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cudnnGetConvolutionBackwardDataAlgorithm_v7 Executed");
 
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
@@ -2540,8 +2706,17 @@ CUDNN_ROUTINE_HANDLER(GetConvolutionBackwardDataWorkspaceSize) {
     cudnnConvolutionBwdDataAlgo_t algo = in->Get<cudnnConvolutionBwdDataAlgo_t>();
     size_t sizeInBytes;
 
-    cudnnStatus_t cs = cudnnGetConvolutionBackwardDataWorkspaceSize(handle, wDesc, dyDesc, convDesc,
-                                                                    dxDesc, algo, &sizeInBytes);
+    CudnnAlgorithmCache::Key key("cudnnGetConvolutionBackwardDataWorkspaceSize");
+    key.AddFilter(wDesc);
+    key.AddTensor(dyDesc);
+    key.AddConvolution(convDesc);
+    key.AddTensor(dxDesc);
+    key.Add(algo);
+
+    cudnnStatus_t cs = CudnnAlgorithmCache::GetInstance().Memoize(key, &sizeInBytes, [&] {
+        return cudnnGetConvolutionBackwardDataWorkspaceSize(handle, wDesc, dyDesc, convDesc, dxDesc,
+                                                            algo, &sizeInBytes);
+    });
 
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     try {
@@ -73,12 +73,14 @@ class CudnnHandler : public gvirtus::backend::Handler {
 /* CudnnHandler.cpp */
 CUDNN_ROUTINE_HANDLER(GetVersion);
 CUDNN_ROUTINE_HANDLER(GetErrorString);
+CUDNN_ROUTINE_HANDLER(GetCudartVersion);
 CUDNN_ROUTINE_HANDLER(GetLastErrorString);
 CUDNN_ROUTINE_HANDLER(Create);
 CUDNN_ROUTINE_HANDLER(Destroy);
 CUDNN_ROUTINE_HANDLER(SetStream);
 CUDNN_ROUTINE_HANDLER(GetStream);
 CUDNN_ROUTINE_HANDLER(GetProperty);
+CUDNN_ROUTINE_HANDLER(ShadowFlush);
 CUDNN_ROUTINE_HANDLER(CreateTensorDescriptor);
 CUDNN_ROUTINE_HANDLER(SetTensor4dDescriptor);
 CUDNN_ROUTINE_HANDLER(SetTensor4dDescriptorEx);
@@ -26,13 +26,22 @@
  *             School of Computer Science, University College Dublin
  */
 
+#include <algorithm>
+#include <cstring>
 #include <mutex>
+#include <string>
 #include <unordered_map>
 
+#include <gvirtus/frontend/LocalTier.h>
+
 #include "CudnnFrontend.h"
+#include "CudnnStatusNames.h"
 
 using namespace std;
 
+using gvirtus::frontend::FindEnumName;
+using gvirtus::frontend::LocalCache;
+
 static std::mutex desc_type_mutex;
 static std::unordered_map<void *, bool> desc_is_float_map;
 
@@ -132,16 +141,32 @@ bool isFloatDescriptor(const void *desc) {
 }
 
 extern "C" size_t CUDNNWINAPI cudnnGetVersion() {
-    CudnnFrontend::Prepare();
-    CudnnFrontend::Execute("cudnnGetVersion");
-    return CudnnFrontend::GetExitCode();  // Instead of exit code, we return the version directly!
+    static LocalCache<int, size_t> versions;
+    const size_t *version = versions.Get(0, [](size_t *value) {
+        CudnnFrontend::Prepare();
+        CudnnFrontend::Execute("cudnnGetVersion");
+        // Instead of exit code, we return the version directly!
+        int exit_code = CudnnFrontend::GetExitCode();
+        if (exit_code <= 0) return false;
+        *value = exit_code;
+        return true;
+    });
+    return version != nullptr ? *version : 0;
 }
 
 extern "C" const char *CUDNNWINAPI cudnnGetErrorString(cudnnStatus_t status) {
-    CudnnFrontend::Prepare();
-    CudnnFrontend::AddVariableForArguments<cudnnStatus_t>(status);
-    CudnnFrontend::Execute("cudnnGetErrorString");
-    return CudnnFrontend::GetOutputString();
+    static LocalCache<int, string> strings;
+    const char *name = FindEnumName(CUDNN_STATUS_NAMES, status);
+    if (name != nullptr) return name;
+    const string *s = strings.Get(status, [status](string *value) {
+        CudnnFrontend::Prepare();
+        CudnnFrontend::AddVariableForArguments<cudnnStatus_t>(status);
+        CudnnFrontend::Execute("cudnnGetErrorString");
+        if (!CudnnFrontend::Success()) return false;
+        *value = CudnnFrontend::GetOutputString();
+        return true;
+    });
+    return s != nullptr ? s->c_str() : "CUDNN_STATUS_UNKNOWN";
 }
 
 extern "C" void CUDNNWINAPI cudnnGetLastErrorString(char *message, size_t max_size) {
@@ -180,9 +205,19 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnSetTensor4dDescriptor(cudnnTensorDescr
     CudnnFrontend::AddVariableForArguments<int>(h);
     CudnnFrontend::AddVariableForArguments<int>(w);
 
+    CudnnShadow::Tensor tensor = {dataType, 4, {n, c, h, w}};
+    if (CudnnShadow::Enabled() && CudnnShadow::IsShadowedFormat(format) &&
+        CudnnShadow::PackedStrides(format, 4, tensor.dims, tensor.strides) &&
+        CudnnShadow::IsValidTensor(tensor)) {
+        CudnnShadow::SetTensor(tensorDesc, tensor);
+        CudnnShadow::Defer(tensorDesc, CudnnShadow::Geometry, "cudnnSetTensor4dDescriptor");
+        registerDescriptorType(tensorDesc, dataType);
+        return CUDNN_STATUS_SUCCESS;
+    }
+    CudnnShadow::Forget(tensorDesc);
+
     CudnnFrontend::Execute("cudnnSetTensor4dDescriptor");
     if (CudnnFrontend::Success()) {
-        // tensorDesc = CudnnFrontend::GetOutputVariable<cudnnTensorDescriptor_t>();
         registerDescriptorType(tensorDesc, dataType);
     }
     return CudnnFrontend::GetExitCode();
@@ -205,6 +240,15 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnSetTensor4dDescriptorEx(
     CudnnFrontend::AddVariableForArguments<int>(hStride);
     CudnnFrontend::AddVariableForArguments<int>(wStride);
 
+    CudnnShadow::Tensor tensor = {dataType, 4, {n, c, h, w}, {nStride, cStride, hStride, wStride}};
+    if (CudnnShadow::Enabled() && CudnnShadow::IsValidTensor(tensor)) {
+        CudnnShadow::SetTensor(tensorDesc, tensor);
+        CudnnShadow::Defer(tensorDesc, CudnnShadow::Geometry, "cudnnSetTensor4dDescriptorEx");
+        registerDescriptorType(tensorDesc, dataType);
+        return CUDNN_STATUS_SUCCESS;
+    }
+    CudnnShadow::Forget(tensorDesc);
+
     CudnnFrontend::Execute("cudnnSetTensor4dDescriptorEx");
     if (CudnnFrontend::Success()) {
         registerDescriptorType(tensorDesc, dataType);
@@ -215,6 +259,20 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnSetTensor4dDescriptorEx(
 extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetTensor4dDescriptor(
     const cudnnTensorDescriptor_t tensorDesc, cudnnDataType_t *dataType, int *n, int *c, int *h,
     int *w, int *nStride, int *cStride, int *hStride, int *wStride) {
+    CudnnShadow::Tensor tensor;
+    if (CudnnShadow::GetTensor(tensorDesc, &tensor) && tensor.nbDims == 4) {
+        *dataType = tensor.dataType;
+        *n = tensor.dims[0];
+        *c = tensor.dims[1];
+        *h = tensor.dims[2];
+        *w = tensor.dims[3];
+        *nStride = tensor.strides[0];
+        *cStride = tensor.strides[1];
+        *hStride = tensor.strides[2];
+        *wStride = tensor.strides[3];
+        return CUDNN_STATUS_SUCCESS;
+    }
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(tensorDesc);
@@ -246,12 +304,23 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnSetTensorNdDescriptor(cudnnTensorDescr
     CudnnFrontend::AddHostPointerForArguments<const int>(dimA, nbDims);
     CudnnFrontend::AddHostPointerForArguments<const int>(strideA, nbDims);
 
+    CudnnShadow::Tensor tensor = {dataType, nbDims};
+    if (CudnnShadow::Enabled() && nbDims > 0 && nbDims <= CUDNN_DIM_MAX && dimA != NULL &&
+        strideA != NULL) {
+        std::memcpy(tensor.dims, dimA, nbDims * sizeof(int));
+        std::memcpy(tensor.strides, strideA, nbDims * sizeof(int));
+        if (CudnnShadow::IsValidTensor(tensor)) {
+            CudnnShadow::SetTensor(tensorDesc, tensor);
+            CudnnShadow::Defer(tensorDesc, CudnnShadow::Geometry, "cudnnSetTensorNdDescriptor");
+            registerDescriptorType(tensorDesc, dataType);
+            return CUDNN_STATUS_SUCCESS;
+        }
+    }
+    CudnnShadow::Forget(tensorDesc);
+
     CudnnFrontend::Execute("cudnnSetTensorNdDescriptor");
     if (CudnnFrontend::Success()) {
-        // cout << "Successfully set tensor descriptor " << tensorDesc << " with data type "
-        //      << dataType << endl;
         registerDescriptorType(tensorDesc, dataType);
-        // cout << "isFloatDescriptor: " << isFloatDescriptor(tensorDesc) << endl;
     }
     return CudnnFrontend::GetExitCode();
 }
@@ -261,11 +330,27 @@ cudnnSetTensorNdDescriptorEx(cudnnTensorDescriptor_t tensorDesc, cudnnTensorForm
                              cudnnDataType_t dataType, int nbDims, const int *dimA) {
     CudnnFrontend::Prepare();
 
+    CudnnFrontend::AddDevicePointerForArguments(tensorDesc);
     CudnnFrontend::AddVariableForArguments<cudnnTensorFormat_t>(format);
     CudnnFrontend::AddVariableForArguments<cudnnDataType_t>(dataType);
     CudnnFrontend::AddVariableForArguments<int>(nbDims);
-    CudnnFrontend::AddHostPointerForArguments<int>((int *)dimA);
+    CudnnFrontend::AddHostPointerForArguments<const int>(dimA, nbDims);
+
+    CudnnShadow::Tensor tensor = {dataType, nbDims};
+    if (CudnnShadow::Enabled() && CudnnShadow::IsShadowedFormat(format) && nbDims > 0 &&
+        nbDims <= CUDNN_DIM_MAX && dimA != NULL) {
+        std::memcpy(tensor.dims, dimA, nbDims * sizeof(int));
+        if (CudnnShadow::PackedStrides(format, nbDims, tensor.dims, tensor.strides) &&
+            CudnnShadow::IsValidTensor(tensor)) {
+            CudnnShadow::SetTensor(tensorDesc, tensor);
+            CudnnShadow::Defer(tensorDesc, CudnnShadow::Geometry, "cudnnSetTensorNdDescriptorEx");
+            registerDescriptorType(tensorDesc, dataType);
+            return CUDNN_STATUS_SUCCESS;
+        }
+    }
+    CudnnShadow::Forget(tensorDesc);
 
+    CudnnFrontend::Execute("cudnnSetTensorNdDescriptorEx");
     if (CudnnFrontend::Success()) {
         registerDescriptorType(tensorDesc, dataType);
     }
@@ -319,6 +404,17 @@ cudnnSetTensorNdDescriptorEx(cudnnTensorDescriptor_t tensorDesc, cudnnTensorForm
 extern "C" cudnnStatus_t CUDNNWINAPI
 cudnnGetTensorNdDescriptor(const cudnnTensorDescriptor_t tensorDesc, int nbDimsRequested,
                            cudnnDataType_t *dataType, int *nbDims, int dimA[], int strideA[]) {
+    CudnnShadow::Tensor tensor;
+    if (CudnnShadow::GetTensor(tensorDesc, &tensor)) {
+        *dataType = tensor.dataType;
+        *nbDims = tensor.nbDims;
+        for (int i = 0; i < std::min(nbDimsRequested, tensor.nbDims); i++) {
+            dimA[i] = tensor.dims[i];
+            strideA[i] = tensor.strides[i];
+        }
+        return CUDNN_STATUS_SUCCESS;
+    }
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(tensorDesc);
@@ -383,6 +479,8 @@ cudnnGetTensorSizeInBytes(const cudnnTensorDescriptor_t tensorDesc, size_t *size
 
 extern "C" cudnnStatus_t CUDNNWINAPI
 cudnnDestroyTensorDescriptor(cudnnTensorDescriptor_t tensorDesc) {
+    CudnnShadow::Destroy(tensorDesc);
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(tensorDesc);
@@ -393,6 +491,8 @@ cudnnDestroyTensorDescriptor(cudnnTensorDescriptor_t tensorDesc) {
 extern "C" cudnnStatus_t CUDNNWINAPI cudnnInitTransformDest(
     const cudnnTensorTransformDescriptor_t transformDesc, const cudnnTensorDescriptor_t srcDesc,
     cudnnTensorDescriptor_t destDesc, size_t *destSizeInBytes) {
+    CudnnShadow::Forget(destDesc);
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(transformDesc);
@@ -536,6 +636,11 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetFoldedConvBackwardDataDescriptors(
     cudnnTensorTransformDescriptor_t diffPadTransDesc,
     cudnnTensorTransformDescriptor_t gradFoldTransDesc,
     cudnnTensorTransformDescriptor_t gradUnfoldTransDesc) {
+    CudnnShadow::Forget(foldedFilterDesc);
+    CudnnShadow::Forget(paddedDiffDesc);
+    CudnnShadow::Forget(foldedConvDesc);
+    CudnnShadow::Forget(foldedGradDesc);
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(handle);
@@ -854,6 +959,15 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnSetFilter4dDescriptor(cudnnFilterDescr
     CudnnFrontend::AddVariableForArguments<int>(h);
     CudnnFrontend::AddVariableForArguments<int>(w);
 
+    CudnnShadow::Filter filter = {dataType, format, 4, {k, c, h, w}};
+    if (CudnnShadow::Enabled() && CudnnShadow::IsValidFilter(filter)) {
+        CudnnShadow::SetFilter(filterDesc, filter);
+        CudnnShadow::Defer(filterDesc, CudnnShadow::Geometry, "cudnnSetFilter4dDescriptor");
+        registerDescriptorType(filterDesc, dataType);
+        return CUDNN_STATUS_SUCCESS;
+    }
+    CudnnShadow::Forget(filterDesc);
+
     CudnnFrontend::Execute("cudnnSetFilter4dDescriptor");
     if (CudnnFrontend::Success()) {
         registerDescriptorType(filterDesc, dataType);
@@ -865,6 +979,17 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetFilter4dDescriptor(cudnnFilterDescr
                                                                 cudnnDataType_t *dataType,
                                                                 cudnnTensorFormat_t *format, int *k,
                                                                 int *c, int *h, int *w) {
+    CudnnShadow::Filter filter;
+    if (CudnnShadow::GetFilter(filterDesc, &filter) && filter.nbDims == 4) {
+        *dataType = filter.dataType;
+        *format = filter.format;
+        *k = filter.dims[0];
+        *c = filter.dims[1];
+        *h = filter.dims[2];
+        *w = filter.dims[3];
+        return CUDNN_STATUS_SUCCESS;
+    }
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(filterDesc);
@@ -886,6 +1011,8 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetFilter4dDescriptor(cudnnFilterDescr
 #if CUDNN_VERSION < 6000
 extern "C" cudnnStatus_t CUDNNWINAPI cudnnSetFilter4dDescriptor_v3(
     cudnnFilterDescriptor_t filterDesc, cudnnDataType_t dataType, int k, int c, int h, int w) {
+    CudnnShadow::Forget(filterDesc);
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(filterDesc);
@@ -922,6 +1049,8 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetFilter4dDescriptor_v3(
 extern "C" cudnnStatus_t CUDNNWINAPI
 cudnnSetFilter4dDescriptor_v4(cudnnFilterDescriptor_t filterDesc, cudnnDataType_t dataType,
                               cudnnTensorFormat_t format, int k, int c, int h, int w) {
+    CudnnShadow::Forget(filterDesc);
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(filterDesc);
@@ -973,7 +1102,19 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnSetFilterNdDescriptor(cudnnFilterDescr
     CudnnFrontend::AddVariableForArguments<cudnnTensorFormat_t>(format);
 
     CudnnFrontend::AddVariableForArguments<int>(nbDims);
-    CudnnFrontend::AddHostPointerForArguments<const int>(filterDimA);
+    CudnnFrontend::AddHostPointerForArguments<const int>(filterDimA, nbDims);
+
+    CudnnShadow::Filter filter = {dataType, format, nbDims};
+    if (CudnnShadow::Enabled() && nbDims > 0 && nbDims <= CUDNN_DIM_MAX && filterDimA != NULL) {
+        std::memcpy(filter.dims, filterDimA, nbDims * sizeof(int));
+        if (CudnnShadow::IsValidFilter(filter)) {
+            CudnnShadow::SetFilter(filterDesc, filter);
+            CudnnShadow::Defer(filterDesc, CudnnShadow::Geometry, "cudnnSetFilterNdDescriptor");
+            registerDescriptorType(filterDesc, dataType);
+            return CUDNN_STATUS_SUCCESS;
+        }
+    }
+    CudnnShadow::Forget(filterDesc);
 
     CudnnFrontend::Execute("cudnnSetFilterNdDescriptor");
     if (CudnnFrontend::Success()) registerDescriptorType(filterDesc, dataType);
@@ -985,6 +1126,16 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetFilterNdDescriptor(const cudnnFilte
                                                                 cudnnDataType_t *dataType,
                                                                 cudnnTensorFormat_t *format,
                                                                 int *nbDims, int *filterDimA) {
+    CudnnShadow::Filter filter;
+    if (CudnnShadow::GetFilter(wDesc, &filter)) {
+        *dataType = filter.dataType;
+        *format = filter.format;
+        *nbDims = filter.nbDims;
+        for (int i = 0; i < std::min(nbDimsRequested, filter.nbDims); i++)
+            filterDimA[i] = filter.dims[i];
+        return CUDNN_STATUS_SUCCESS;
+    }
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(wDesc);
@@ -1006,6 +1157,8 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetFilterNdDescriptor(const cudnnFilte
 extern "C" cudnnStatus_t CUDNNWINAPI
 cudnnSetFilterNdDescriptor_v3(cudnnFilterDescriptor_t filterDesc, cudnnDataType_t dataType,
                               int nbDims, const int *filterDimA) {
+    CudnnShadow::Forget(filterDesc);
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(filterDesc);
@@ -1039,6 +1192,8 @@ cudnnGetFilterNdDescriptor_v3(const cudnnFilterDescriptor_t wDesc, int nbDimsReq
 extern "C" cudnnStatus_t CUDNNWINAPI
 cudnnSetFilterNdDescriptor_v4(cudnnFilterDescriptor_t filterDesc, cudnnDataType_t dataType,
                               cudnnTensorFormat_t format, int nbDims, const int *filterDimA) {
+    CudnnShadow::Forget(filterDesc);
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(filterDesc);
@@ -1088,6 +1243,8 @@ cudnnGetFilterSizeInBytes(const cudnnFilterDescriptor_t filterDesc, size_t *size
 
 extern "C" cudnnStatus_t CUDNNWINAPI
 cudnnDestroyFilterDescriptor(cudnnFilterDescriptor_t filterDesc) {
+    CudnnShadow::Destroy(filterDesc);
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(filterDesc);
@@ -1156,6 +1313,13 @@ cudnnCreateConvolutionDescriptor(cudnnConvolutionDescriptor_t *convDesc) {
     CudnnFrontend::Execute("cudnnCreateConvolutionDescriptor");
     if (CudnnFrontend::Success()) {
         *convDesc = CudnnFrontend::GetOutputVariable<cudnnConvolutionDescriptor_t>();
+        if (CudnnShadow::Enabled()) {
+            CudnnShadow::Convolution convolution = {};
+            convolution.mathType = CUDNN_DEFAULT_MATH;
+            convolution.groupCount = 1;
+            convolution.reorderType = CUDNN_DEFAULT_REORDER;
+            CudnnShadow::SetConvolution(*convDesc, convolution);
+        }
     }
     return CudnnFrontend::GetExitCode();
 }
@@ -1167,6 +1331,17 @@ cudnnSetConvolutionMathType(cudnnConvolutionDescriptor_t convDesc, cudnnMathType
     CudnnFrontend::AddDevicePointerForArguments(convDesc);
     CudnnFrontend::AddVariableForArguments<cudnnMathType_t>(mathType);
 
+    CudnnShadow::Convolution convolution;
+    if ((mathType == CUDNN_DEFAULT_MATH || mathType == CUDNN_TENSOR_OP_MATH ||
+         mathType == CUDNN_TENSOR_OP_MATH_ALLOW_CONVERSION) &&
+        CudnnShadow::GetConvolution(convDesc, &convolution)) {
+        convolution.mathType = mathType;
+        CudnnShadow::SetConvolution(convDesc, convolution);
+        CudnnShadow::Defer(convDesc, CudnnShadow::MathType, "cudnnSetConvolutionMathType");
+        return CUDNN_STATUS_SUCCESS;
+    }
+    CudnnShadow::Forget(convDesc);
+
     CudnnFrontend::Execute("cudnnSetConvolutionMathType");
 
     return CudnnFrontend::GetExitCode();
@@ -1174,6 +1349,12 @@ cudnnSetConvolutionMathType(cudnnConvolutionDescriptor_t convDesc, cudnnMathType
 
 extern "C" cudnnStatus_t CUDNNWINAPI
 cudnnGetConvolutionMathType(cudnnConvolutionDescriptor_t convDesc, cudnnMathType_t *mathType) {
+    CudnnShadow::Convolution convolution;
+    if (CudnnShadow::GetConvolution(convDesc, &convolution)) {
+        *mathType = convolution.mathType;
+        return CUDNN_STATUS_SUCCESS;
+    }
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(convDesc);
@@ -1192,6 +1373,15 @@ cudnnSetConvolutionGroupCount(cudnnConvolutionDescriptor_t convDesc, int groupCo
     CudnnFrontend::AddDevicePointerForArguments(convDesc);
     CudnnFrontend::AddVariableForArguments<int>(groupCount);
 
+    CudnnShadow::Convolution convolution;
+    if (groupCount > 0 && CudnnShadow::GetConvolution(convDesc, &convolution)) {
+        convolution.groupCount = groupCount;
+        CudnnShadow::SetConvolution(convDesc, convolution);
+        CudnnShadow::Defer(convDesc, CudnnShadow::GroupCount, "cudnnSetConvolutionGroupCount");
+        return CUDNN_STATUS_SUCCESS;
+    }
+    CudnnShadow::Forget(convDesc);
+
     CudnnFrontend::Execute("cudnnSetConvolutionGroupCount");
 
     return CudnnFrontend::GetExitCode();
@@ -1199,6 +1389,12 @@ cudnnSetConvolutionGroupCount(cudnnConvolutionDescriptor_t convDesc, int groupCo
 
 extern "C" cudnnStatus_t CUDNNWINAPI
 cudnnGetConvolutionGroupCount(cudnnConvolutionDescriptor_t convDesc, int *groupCount) {
+    CudnnShadow::Convolution convolution;
+    if (CudnnShadow::GetConvolution(convDesc, &convolution)) {
+        *groupCount = convolution.groupCount;
+        return CUDNN_STATUS_SUCCESS;
+    }
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(convDesc);
@@ -1217,6 +1413,16 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnSetConvolutionReorderType(
     CudnnFrontend::AddDevicePointerForArguments(convDesc);
     CudnnFrontend::AddVariableForArguments<cudnnReorderType_t>(reorderType);
 
+    CudnnShadow::Convolution convolution;
+    if ((reorderType == CUDNN_DEFAULT_REORDER || reorderType == CUDNN_NO_REORDER) &&
+        CudnnShadow::GetConvolution(convDesc, &convolution)) {
+        convolution.reorderType = reorderType;
+        CudnnShadow::SetConvolution(convDesc, convolution);
+        CudnnShadow::Defer(convDesc, CudnnShadow::ReorderType, "cudnnSetConvolutionReorderType");
+        return CUDNN_STATUS_SUCCESS;
+    }
+    CudnnShadow::Forget(convDesc);
+
     CudnnFrontend::Execute("cudnnSetConvolutionReorderType");
 
     return CudnnFrontend::GetExitCode();
@@ -1224,6 +1430,12 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnSetConvolutionReorderType(
 
 extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetConvolutionReorderType(
     cudnnConvolutionDescriptor_t convDesc, cudnnReorderType_t *reorderType) {
+    CudnnShadow::Convolution convolution;
+    if (CudnnShadow::GetConvolution(convDesc, &convolution)) {
+        *reorderType = convolution.reorderType;
+        return CUDNN_STATUS_SUCCESS;
+    }
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(convDesc);
@@ -1250,6 +1462,26 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnSetConvolution2dDescriptor(
     CudnnFrontend::AddVariableForArguments<cudnnConvolutionMode_t>(mode);
     CudnnFrontend::AddVariableForArguments<cudnnDataType_t>(computeType);
 
+    CudnnShadow::Convolution convolution;
+    if (CudnnShadow::GetConvolution(convDesc, &convolution)) {
+        convolution.geometry = true;
+        convolution.arrayLength = 2;
+        convolution.pads[0] = pad_h;
+        convolution.pads[1] = pad_w;
+        convolution.strides[0] = u;
+        convolution.strides[1] = v;
+        convolution.dilations[0] = upscalex;
+        convolution.dilations[1] = upscaley;
+        convolution.mode = mode;
+        convolution.computeType = computeType;
+        if (CudnnShadow::IsValidConvolution(convolution)) {
+            CudnnShadow::SetConvolution(convDesc, convolution);
+            CudnnShadow::Defer(convDesc, CudnnShadow::Geometry, "cudnnSetConvolution2dDescriptor");
+            return CUDNN_STATUS_SUCCESS;
+        }
+    }
+    CudnnShadow::Forget(convDesc);
+
     CudnnFrontend::Execute("cudnnSetConvolution2dDescriptor");
     return CudnnFrontend::GetExitCode();
 }
@@ -1257,6 +1489,20 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnSetConvolution2dDescriptor(
 extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetConvolution2dDescriptor(
     const cudnnConvolutionDescriptor_t convDesc, int *pad_h, int *pad_w, int *u, int *v,
     int *upscalex, int *upscaley, cudnnConvolutionMode_t *mode, cudnnDataType_t *computeType) {
+    CudnnShadow::Convolution convolution;
+    if (CudnnShadow::GetConvolution(convDesc, &convolution) && convolution.geometry &&
+        convolution.arrayLength == 2) {
+        *pad_h = convolution.pads[0];
+        *pad_w = convolution.pads[1];
+        *u = convolution.strides[0];
+        *v = convolution.strides[1];
+        *upscalex = convolution.dilations[0];
+        *upscaley = convolution.dilations[1];
+        *mode = convolution.mode;
+        *computeType = convolution.computeType;
+        return CUDNN_STATUS_SUCCESS;
+    }
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(convDesc);
@@ -1278,6 +1524,21 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetConvolution2dDescriptor(
 extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetConvolution2dForwardOutputDim(
     const cudnnConvolutionDescriptor_t convDesc, const cudnnTensorDescriptor_t inputTensorDesc,
     const cudnnFilterDescriptor_t filterDesc, int *n, int *c, int *h, int *w) {
+    CudnnShadow::Convolution convolution;
+    CudnnShadow::Tensor input;
+    CudnnShadow::Filter filter;
+    int outputDims[4];
+    if (CudnnShadow::GetConvolution(convDesc, &convolution) && convolution.arrayLength == 2 &&
+        CudnnShadow::GetTensor(inputTensorDesc, &input) &&
+        CudnnShadow::GetFilter(filterDesc, &filter) &&
+        CudnnShadow::ForwardOutputDim(convolution, input, filter, outputDims)) {
+        *n = outputDims[0];
+        *c = outputDims[1];
+        *h = outputDims[2];
+        *w = outputDims[3];
+        return CUDNN_STATUS_SUCCESS;
+    }
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(convDesc);
@@ -1302,16 +1563,32 @@ cudnnSetConvolutionNdDescriptor(cudnnConvolutionDescriptor_t convDesc, int array
 
     CudnnFrontend::AddDevicePointerForArguments(convDesc);
     CudnnFrontend::AddVariableForArguments<int>(arrayLength);
-    CudnnFrontend::AddHostPointerForArguments<int>((int *)padA);
-    CudnnFrontend::AddHostPointerForArguments<int>((int *)filterStrideA);
-    CudnnFrontend::AddHostPointerForArguments<int>((int *)dilationA);
+    CudnnFrontend::AddHostPointerForArguments<const int>(padA, arrayLength);
+    CudnnFrontend::AddHostPointerForArguments<const int>(filterStrideA, arrayLength);
+    CudnnFrontend::AddHostPointerForArguments<const int>(dilationA, arrayLength);
     CudnnFrontend::AddVariableForArguments<cudnnConvolutionMode_t>(mode);
     CudnnFrontend::AddVariableForArguments<cudnnDataType_t>(computeType);
 
-    CudnnFrontend::Execute("cudnnSetConvolutionNdDescriptor");
-    if (CudnnFrontend::Success()) {
-        convDesc = CudnnFrontend::GetOutputVariable<cudnnConvolutionDescriptor_t>();
+    CudnnShadow::Convolution convolution;
+    if (CudnnShadow::GetConvolution(convDesc, &convolution) && arrayLength > 0 &&
+        arrayLength <= CUDNN_DIM_MAX - 2 && padA != NULL && filterStrideA != NULL &&
+        dilationA != NULL) {
+        convolution.geometry = true;
+        convolution.arrayLength = arrayLength;
+        std::memcpy(convolution.pads, padA, arrayLength * sizeof(int));
+        std::memcpy(convolution.strides, filterStrideA, arrayLength * sizeof(int));
+        std::memcpy(convolution.dilations, dilationA, arrayLength * sizeof(int));
+        convolution.mode = mode;
+        convolution.computeType = computeType;
+        if (CudnnShadow::IsValidConvolution(convolution)) {
+            CudnnShadow::SetConvolution(convDesc, convolution);
+            CudnnShadow::Defer(convDesc, CudnnShadow::Geometry, "cudnnSetConvolutionNdDescriptor");
+            return CUDNN_STATUS_SUCCESS;
+        }
     }
+    CudnnShadow::Forget(convDesc);
+
+    CudnnFrontend::Execute("cudnnSetConvolutionNdDescriptor");
     return CudnnFrontend::GetExitCode();
 }
 
@@ -1319,6 +1596,19 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetConvolutionNdDescriptor(
     const cudnnConvolutionDescriptor_t convDesc, int arrayLengthRequested, int *arrayLength,
     int *padA, int *strideA, int *dilationA, cudnnConvolutionMode_t *mode,
     cudnnDataType_t *computeType) {
+    CudnnShadow::Convolution convolution;
+    if (CudnnShadow::GetConvolution(convDesc, &convolution) && convolution.geometry) {
+        *arrayLength = convolution.arrayLength;
+        for (int i = 0; i < std::min(arrayLengthRequested, convolution.arrayLength); i++) {
+            padA[i] = convolution.pads[i];
+            strideA[i] = convolution.strides[i];
+            dilationA[i] = convolution.dilations[i];
+        }
+        *mode = convolution.mode;
+        *computeType = convolution.computeType;
+        return CUDNN_STATUS_SUCCESS;
+    }
+
     CudnnFrontend::Prepare();
     CudnnFrontend::AddDevicePointerForArguments(convDesc);
     CudnnFrontend::AddVariableForArguments<int>(arrayLengthRequested);
@@ -1338,6 +1628,18 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetConvolutionNdDescriptor(
 extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetConvolutionNdForwardOutputDim(
     const cudnnConvolutionDescriptor_t convDesc, const cudnnTensorDescriptor_t inputTensorDesc,
     const cudnnFilterDescriptor_t filterDesc, int nbDims, int *tensorOuputDimA) {
+    CudnnShadow::Convolution convolution;
+    CudnnShadow::Tensor input;
+    CudnnShadow::Filter filter;
+    int outputDims[CUDNN_DIM_MAX];
+    if (CudnnShadow::GetConvolution(convDesc, &convolution) &&
+        nbDims == convolution.arrayLength + 2 && CudnnShadow::GetTensor(inputTensorDesc, &input) &&
+        CudnnShadow::GetFilter(filterDesc, &filter) &&
+        CudnnShadow::ForwardOutputDim(convolution, input, filter, outputDims)) {
+        std::memcpy(tensorOuputDimA, outputDims, nbDims * sizeof(int));
+        return CUDNN_STATUS_SUCCESS;
+    }
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(convDesc);
@@ -1355,6 +1657,8 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnGetConvolutionNdForwardOutputDim(
 
 extern "C" cudnnStatus_t CUDNNWINAPI
 cudnnDestroyConvolutionDescriptor(cudnnConvolutionDescriptor_t convDesc) {
+    CudnnShadow::Destroy(convDesc);
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(convDesc);
@@ -1390,11 +1694,16 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnFindConvolutionForwardAlgorithm(
     CudnnFrontend::AddDevicePointerForArguments(convDesc);
     CudnnFrontend::AddDevicePointerForArguments(yDesc);
     CudnnFrontend::AddVariableForArguments<int>(requestedAlgoCount);
+    CudnnFrontend::AddHostPointerForArguments<cudnnConvolutionFwdAlgoPerf_t>(perfResults,
+                                                                            requestedAlgoCount);
 
     CudnnFrontend::Execute("cudnnFindConvolutionForwardAlgorithm");
     if (CudnnFrontend::Success()) {
         *returnedAlgoCount = CudnnFrontend::GetOutputVariable<int>();
-        *perfResults = CudnnFrontend::GetOutputVariable<cudnnConvolutionFwdAlgoPerf_t>();
+        cudnnConvolutionFwdAlgoPerf_t *perfResults_backend =
+            CudnnFrontend::GetOutputHostPointer<cudnnConvolutionFwdAlgoPerf_t>(*returnedAlgoCount);
+        std::memcpy(perfResults, perfResults_backend,
+                    sizeof(cudnnConvolutionFwdAlgoPerf_t) * (*returnedAlgoCount));
     }
     return CudnnFrontend::GetExitCode();
 }
@@ -2547,6 +2856,8 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnDivisiveNormalizationBackward(
 extern "C" cudnnStatus_t CUDNNWINAPI
 cudnnDeriveBNTensorDescriptor(cudnnTensorDescriptor_t derivedBnDesc,
                               const cudnnTensorDescriptor_t xDesc, cudnnBatchNormMode_t mode) {
+    CudnnShadow::Forget(derivedBnDesc);
+
     CudnnFrontend::Prepare();
 
     CudnnFrontend::AddDevicePointerForArguments(xDesc);
@@ -5127,12 +5438,15 @@ cudnnGetRNNDescriptor_v6(cudnnHandle_t handle, cudnnRNNDescriptor_t rnnDesc, int
 
 // TODO:
 extern "C" size_t CUDNNWINAPI cudnnGetCudartVersion() {
-    CudnnFrontend::Prepare();
-    CudnnFrontend::Execute("cudnnGetCudartVersion");
-    if (CudnnFrontend::Success()) {
-        return CudnnFrontend::GetOutputVariable<cudnnStatus_t>();
-    }
-    return CudnnFrontend::GetExitCode();
+    static LocalCache<int, size_t> versions;
+    const size_t *version = versions.Get(0, [](size_t *value) {
+        CudnnFrontend::Prepare();
+        CudnnFrontend::Execute("cudnnGetCudartVersion");
+        if (!CudnnFrontend::Success()) return false;
+        *value = CudnnFrontend::GetOutputVariable<size_t>();
+        return true;
+    });
+    return version != nullptr ? *version : 0;
 }
 
 extern "C" cudnnStatus_t CUDNNWINAPI cudnnBackendCreateDescriptor(
@@ -5160,9 +5474,14 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnBackendSetAttribute(
     int64_t byteCount = elementCount * getCudnnTypeSize(attributeType);
     CudnnFrontend::AddHostPointerForArguments<char>((char *)arrayOfElements, byteCount);
 
-    if (attributeName == CUDNN_ATTR_VARIANT_PACK_WORKSPACE &&
-        attributeType == CUDNN_TYPE_VOID_PTR) {
-        // cout << "SETTING WORKSPACE POINTER TO" << endl;
+    // The attributes ride with the next call, at the latest with
+    // cudnnBackendFinalize or cudnnBackendExecute, which report the first
+    // failure among them.
+    if (CudnnShadow::Enabled() && descriptor != nullptr && elementCount >= 0 &&
+        (elementCount == 0 || arrayOfElements != nullptr)) {
+        CudnnShadow::Defer(descriptor, CudnnShadow::Attribute, "cudnnBackendSetAttribute",
+                           attributeName);
+        return CUDNN_STATUS_SUCCESS;
     }
 
     // cout << "cudnnBackendSetAttribute called with:" << endl;
@@ -5228,18 +5547,23 @@ extern "C" cudnnStatus_t CUDNNWINAPI cudnnBackendExecute(cudnnHandle_t handle,
     CudnnFrontend::AddDevicePointerForArguments(handle);
     CudnnFrontend::AddDevicePointerForArguments(executionPlan);
     CudnnFrontend::AddDevicePointerForArguments(variantPack);
-    CudnnFrontend::Execute("cudnnBackendExecute");
+    // carries the pending attribute sets, and reports the first that failed
+    CudnnShadow::Execute("cudnnBackendExecute", NULL);
+    if (CudnnFrontend::Success()) return CudnnShadow::DeferredStatus();
     return CudnnFrontend::GetExitCode();
 }
 
 extern "C" cudnnStatus_t CUDNNWINAPI cudnnBackendFinalize(cudnnBackendDescriptor_t descriptor) {
     CudnnFrontend::Prepare();
     CudnnFrontend::AddDevicePointerForArguments(descriptor);
-    CudnnFrontend::Execute("cudnnBackendFinalize");
+    // carries the pending attribute sets, and reports the first that failed
+    CudnnShadow::Execute("cudnnBackendFinalize", NULL);
+    if (CudnnFrontend::Success()) return CudnnShadow::DeferredStatus();
     return CudnnFrontend::GetExitCode();
 }
 
 extern "C" cudnnStatus_t CUDNNWINAPI cudnnBackendDestroyDescriptor(cudnnBackendDescriptor_t desc) {
+    CudnnShadow::Destroy(desc);
     CudnnFrontend::Prepare();
     CudnnFrontend::AddDevicePointerForArguments(desc);
     CudnnFrontend::Execute("cudnnBackendDestroyDescriptor");
@@ -34,6 +34,8 @@
 
 #include <iostream>
 
+#include "CudnnShadow.h"
+
 using gvirtus::communicators::Buffer;
 using gvirtus::frontend::Frontend;
 
@@ -45,6 +47,10 @@ typedef struct __configureFunction {
 class CudnnFrontend {
    public:
     static inline void Execute(const char *routine, const Buffer *input_buffer = NULL) {
+        if (CudnnShadow::HasDeferred()) {
+            CudnnShadow::Execute(routine, input_buffer);
+            return;
+        }
         Frontend::GetFrontend()->Execute(routine, input_buffer);
     }
 
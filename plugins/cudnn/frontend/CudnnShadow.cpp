@@ -0,0 +1,333 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CudnnShadow.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CudnnFrontend.h"
+
+using gvirtus::communicators::Buffer;
+
+namespace {
+
+struct DeferredCall {
+    size_t backend;
+    const void *descriptor;
+    CudnnShadow::Slot slot;
+    int index;
+    std::string routine;
+    std::vector<char> arguments;
+};
+
+std::mutex shadow_mutex;
+std::unordered_map<const void *, CudnnShadow::Tensor> tensors;
+std::unordered_map<const void *, CudnnShadow::Filter> filters;
+std::unordered_map<const void *, CudnnShadow::Convolution> convolutions;
+
+// One queue for the whole process: a descriptor may be set by one thread and
+// used by another. While a thread flushes, the others wait for the backend to
+// have run the flushed calls before sending theirs.
+std::mutex deferred_mutex;
+std::condition_variable flushed;
+std::vector<DeferredCall> deferred;
+bool flushing = false;
+// deferred.size() + flushing, read without the lock on every call.
+std::atomic<size_t> pending{0};
+
+void UpdatePending() { pending = deferred.size() + (flushing ? 1 : 0); }
+
+// The status of the first deferred call that failed in the last flush of the
+// thread.
+thread_local cudnnStatus_t deferred_status = CUDNN_STATUS_SUCCESS;
+
+// Takes the calls deferred for the backend of frontend, once no flush is in
+// flight. Flushed() must follow if any is returned.
+std::vector<DeferredCall> TakeDeferred(Frontend *frontend) {
+    std::vector<DeferredCall> calls;
+    std::unique_lock<std::mutex> lock(deferred_mutex);
+    flushed.wait(lock, [] { return !flushing; });
+    auto others = std::stable_partition(
+        deferred.begin(), deferred.end(),
+        [&](const DeferredCall &call) { return call.backend != frontend->GetBackend(); });
+    calls.assign(std::make_move_iterator(others), std::make_move_iterator(deferred.end()));
+    deferred.erase(others, deferred.end());
+    flushing = !calls.empty();
+    UpdatePending();
+    return calls;
+}
+
+void Flushed() {
+    std::lock_guard<std::mutex> lock(deferred_mutex);
+    flushing = false;
+    UpdatePending();
+    flushed.notify_all();
+}
+
+// Every call, the deferred ones and the one carrying them, travels as its
+// routine name followed by its marshalled arguments. The answer is the one of
+// the carrying call, followed by the index and the status of the first
+// deferred call that failed.
+void Flush(Frontend *frontend, const std::vector<DeferredCall> &calls, const char *routine,
+           const char *arguments, size_t size) {
+    Buffer flush;
+    flush.Add<size_t>(calls.size());
+    for (auto &call : calls) {
+        flush.AddString(call.routine.c_str());
+        flush.Add<size_t>(call.arguments.size());
+        flush.Add(call.arguments.data(), call.arguments.size());
+    }
+    flush.AddString(routine);
+    flush.Add<size_t>(size);
+    // a routine without arguments still sends its block, empty
+    flush.Add(arguments, size);
+
+    try {
+        frontend->Execute("cudnnShadowFlush", &flush);
+    } catch (...) {
+        Flushed();
+        throw;
+    }
+    Flushed();
+
+    Buffer *out = frontend->GetOutputBuffer();
+    deferred_status = (cudnnStatus_t)out->BackGet<int>();
+    int index = out->BackGet<int>();
+    if (index >= 0 && (size_t)index < calls.size())
+        std::cerr << "[GVIRTUS WARNING] The deferred " << calls[index].routine
+                  << " failed with status " << deferred_status << ", reported before "
+                  << routine << "\n";
+}
+
+}  // namespace
+
+bool CudnnShadow::Enabled() {
+    static const bool enabled = [] {
+        const char *env = getenv("GVIRTUS_CUDNN_SHADOW");
+        return env == nullptr || strcmp(env, "0") != 0;
+    }();
+    return enabled;
+}
+
+void CudnnShadow::Defer(const void *descriptor, Slot slot, const char *routine, int index) {
+    auto frontend = Frontend::GetFrontend();
+    Buffer *input = frontend->GetInputBuffer();
+    std::lock_guard<std::mutex> lock(deferred_mutex);
+    deferred.erase(std::remove_if(deferred.begin(), deferred.end(),
+                                  [&](const DeferredCall &call) {
+                                      return call.descriptor == descriptor &&
+                                             call.slot == slot && call.index == index;
+                                  }),
+                   deferred.end());
+    deferred.push_back({frontend->GetBackend(), descriptor, slot, index, routine,
+                        std::vector<char>(input->GetBuffer(),
+                                          input->GetBuffer() + input->GetBufferSize())});
+    UpdatePending();
+}
+
+bool CudnnShadow::HasDeferred() { return pending != 0; }
+
+void CudnnShadow::Execute(const char *routine, const Buffer *input_buffer) {
+    auto frontend = Frontend::GetFrontend();
+    if (input_buffer == nullptr) input_buffer = frontend->GetInputBuffer();
+
+    auto calls = TakeDeferred(frontend);
+    deferred_status = CUDNN_STATUS_SUCCESS;
+    if (calls.empty()) {
+        frontend->Execute(routine, input_buffer);
+        return;
+    }
+    ::Flush(frontend, calls, routine, input_buffer->GetBuffer(), input_buffer->GetBufferSize());
+}
+
+cudnnStatus_t CudnnShadow::DeferredStatus() { return deferred_status; }
+
+void CudnnShadow::Forget(const void *descriptor) {
+    std::lock_guard<std::mutex> lock(shadow_mutex);
+    tensors.erase(descriptor);
+    filters.erase(descriptor);
+    convolutions.erase(descriptor);
+}
+
+void CudnnShadow::Destroy(const void *descriptor) {
+    {
+        std::lock_guard<std::mutex> lock(deferred_mutex);
+        deferred.erase(std::remove_if(deferred.begin(), deferred.end(),
+                                      [&](const DeferredCall &call) {
+                                          return call.descriptor == descriptor;
+                                      }),
+                       deferred.end());
+        UpdatePending();
+    }
+    Forget(descriptor);
+}
+
+void CudnnShadow::SetTensor(const void *descriptor, const Tensor &tensor) {
+    std::lock_guard<std::mutex> lock(shadow_mutex);
+    tensors[descriptor] = tensor;
+}
+
+bool CudnnShadow::GetTensor(const void *descriptor, Tensor *tensor) {
+    if (!Enabled()) return false;
+    std::lock_guard<std::mutex> lock(shadow_mutex);
+    auto it = tensors.find(descriptor);
+    if (it == tensors.end()) return false;
+    *tensor = it->second;
+    return true;
+}
+
+void CudnnShadow::SetFilter(const void *descriptor, const Filter &filter) {
+    std::lock_guard<std::mutex> lock(shadow_mutex);
+    filters[descriptor] = filter;
+}
+
+bool CudnnShadow::GetFilter(const void *descriptor, Filter *filter) {
+    if (!Enabled()) return false;
+    std::lock_guard<std::mutex> lock(shadow_mutex);
+    auto it = filters.find(descriptor);
+    if (it == filters.end()) return false;
+    *filter = it->second;
+    return true;
+}
+
+void CudnnShadow::SetConvolution(const void *descriptor, const Convolution &convolution) {
+    std::lock_guard<std::mutex> lock(shadow_mutex);
+    convolutions[descriptor] = convolution;
+}
+
+bool CudnnShadow::GetConvolution(const void *descriptor, Convolution *convolution) {
+    if (!Enabled()) return false;
+    std::lock_guard<std::mutex> lock(shadow_mutex);
+    auto it = convolutions.find(descriptor);
+    if (it == convolutions.end()) return false;
+    *convolution = it->second;
+    return true;
+}
+
+bool CudnnShadow::IsShadowedType(cudnnDataType_t dataType) {
+    switch (dataType) {
+        case CUDNN_DATA_FLOAT:
+        case CUDNN_DATA_DOUBLE:
+        case CUDNN_DATA_HALF:
+#if CUDNN_VERSION >= 8100
+        case CUDNN_DATA_BFLOAT16:
+#endif
+            return true;
+        default:
+            // The other types come with layout rules of their own: the
+            // backend validates them.
+            return false;
+    }
+}
+
+bool CudnnShadow::IsShadowedFormat(cudnnTensorFormat_t format) {
+    return format == CUDNN_TENSOR_NCHW || format == CUDNN_TENSOR_NHWC;
+}
+
+bool CudnnShadow::IsValidTensor(const Tensor &tensor) {
+    if (!IsShadowedType(tensor.dataType) || tensor.nbDims < 3 || tensor.nbDims > CUDNN_DIM_MAX)
+        return false;
+    long long span = 1;
+    for (int i = 0; i < tensor.nbDims; i++) {
+        if (tensor.dims[i] <= 0 || tensor.strides[i] <= 0) return false;
+        span += (long long)(tensor.dims[i] - 1) * tensor.strides[i];
+    }
+    return span <= INT_MAX;
+}
+
+bool CudnnShadow::IsValidFilter(const Filter &filter) {
+    if (!IsShadowedType(filter.dataType) || !IsShadowedFormat(filter.format) ||
+        filter.nbDims < 3 || filter.nbDims > CUDNN_DIM_MAX)
+        return false;
+    long long size = 1;
+    for (int i = 0; i < filter.nbDims; i++) {
+        if (filter.dims[i] <= 0) return false;
+        size *= filter.dims[i];
+        if (size > INT_MAX) return false;
+    }
+    return true;
+}
+
+bool CudnnShadow::IsValidConvolution(const Convolution &convolution) {
+    if (convolution.arrayLength < 1 || convolution.arrayLength > CUDNN_DIM_MAX - 2 ||
+        !IsShadowedType(convolution.computeType) ||
+        (convolution.mode != CUDNN_CONVOLUTION && convolution.mode != CUDNN_CROSS_CORRELATION))
+        return false;
+    for (int i = 0; i < convolution.arrayLength; i++) {
+        if (convolution.pads[i] < 0 || convolution.strides[i] <= 0 ||
+            convolution.dilations[i] <= 0)
+            return false;
+    }
+    return true;
+}
+
+bool CudnnShadow::PackedStrides(cudnnTensorFormat_t format, int nbDims, const int *dims,
+                                int *strides) {
+    if (nbDims < 3 || nbDims > CUDNN_DIM_MAX) return false;
+    for (int i = 0; i < nbDims; i++)
+        if (dims[i] <= 0) return false;
+
+    // Innermost dimension first: C for NHWC, the last one for NCHW.
+    int order[CUDNN_DIM_MAX];
+    int n = 0;
+    if (format == CUDNN_TENSOR_NHWC) {
+        order[n++] = 1;
+        for (int i = nbDims - 1; i >= 2; i--) order[n++] = i;
+        order[n++] = 0;
+    } else {
+        for (int i = nbDims - 1; i >= 0; i--) order[n++] = i;
+    }
+    long long stride = 1;
+    for (int i = 0; i < nbDims; i++) {
+        if (stride > INT_MAX) return false;
+        strides[order[i]] = (int)stride;
+        stride *= dims[order[i]];
+    }
+    return true;
+}
+
+bool CudnnShadow::ForwardOutputDim(const Convolution &convolution, const Tensor &input,
+                                   const Filter &filter, int *outputDims) {
+    int nbDims = convolution.arrayLength + 2;
+    if (!convolution.geometry || input.nbDims != nbDims || filter.nbDims != nbDims ||
+        input.dims[1] != filter.dims[1] * convolution.groupCount)
+        return false;
+    outputDims[0] = input.dims[0];
+    outputDims[1] = filter.dims[0];
+    for (int i = 0; i < convolution.arrayLength; i++) {
+        int extent = (filter.dims[i + 2] - 1) * convolution.dilations[i] + 1;
+        int span = input.dims[i + 2] + 2 * convolution.pads[i] - extent;
+        if (span < 0) return false;
+        outputDims[i + 2] = 1 + span / convolution.strides[i];
+    }
+    return true;
+}
@@ -0,0 +1,140 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CUDNNSHADOW_H
+#define CUDNNSHADOW_H
+
+#include <cudnn.h>
+#include <gvirtus/communicators/Buffer.h>
+
+/*
+ * CudnnShadow keeps a frontend copy of the tensor, filter and convolution
+ * descriptors.
+ *
+ * Setting one of those descriptors only stores a few integers on the backend,
+ * so the cudnnSet* call is not sent on its own: the marshalled call is queued
+ * and shipped inline with the next call to the same backend, of any thread,
+ * which the backend unpacks with cudnnShadowFlush before running it. The calls
+ * of the other threads wait for such a flush to complete, so that none of them
+ * reaches the backend ahead of a set it may depend on. A later set of the same part
+ * of a descriptor replaces the queued one. The cudnnGet* queries on those
+ * descriptors are answered from the copy.
+ *
+ * cudnnBackendSetAttribute is deferred the same way, one slot per attribute,
+ * so that building a backend graph costs a flush per cudnnBackendFinalize
+ * rather than one round trip per attribute. Finalize and cudnnBackendExecute
+ * always carry the pending sets, and return the status of the first that
+ * failed when they succeed themselves.
+ *
+ * GVIRTUS_CUDNN_SHADOW=0 disables the whole mechanism.
+ */
+class CudnnShadow {
+   public:
+    /* The part of a descriptor replaced by a deferred call. */
+    enum Slot { Geometry, MathType, GroupCount, ReorderType, Attribute };
+
+    struct Tensor {
+        cudnnDataType_t dataType;
+        int nbDims;
+        int dims[CUDNN_DIM_MAX];
+        int strides[CUDNN_DIM_MAX];
+    };
+
+    struct Filter {
+        cudnnDataType_t dataType;
+        cudnnTensorFormat_t format;
+        int nbDims;
+        int dims[CUDNN_DIM_MAX];
+    };
+
+    struct Convolution {
+        bool geometry; /* set by cudnnSetConvolution{2d,Nd}Descriptor */
+        int arrayLength;
+        int pads[CUDNN_DIM_MAX];
+        int strides[CUDNN_DIM_MAX];
+        int dilations[CUDNN_DIM_MAX];
+        cudnnConvolutionMode_t mode;
+        cudnnDataType_t computeType;
+        cudnnMathType_t mathType;
+        int groupCount;
+        cudnnReorderType_t reorderType;
+    };
+
+    static bool Enabled();
+
+    /*
+     * Queues the call prepared in the input buffer of the frontend, in place
+     * of executing it. index tells apart the attributes of the Attribute slot.
+     */
+    static void Defer(const void *descriptor, Slot slot, const char *routine, int index = 0);
+
+    /* Whether calls are queued or being flushed: Execute must then be used. */
+    static bool HasDeferred();
+
+    /*
+     * Executes routine on the backend of the calling thread, preceded by the
+     * calls deferred for that backend by any thread.
+     */
+    static void Execute(const char *routine, const gvirtus::communicators::Buffer *input_buffer);
+
+    /*
+     * The status of the first deferred call that failed in the last Execute
+     * of the calling thread. The carrying call keeps its own status.
+     */
+    static cudnnStatus_t DeferredStatus();
+
+    /* Drops the copy of a descriptor changed by a call that is not shadowed. */
+    static void Forget(const void *descriptor);
+
+    /* Drops the copy of a destroyed descriptor and the calls deferred on it. */
+    static void Destroy(const void *descriptor);
+
+    static void SetTensor(const void *descriptor, const Tensor &tensor);
+    static bool GetTensor(const void *descriptor, Tensor *tensor);
+    static void SetFilter(const void *descriptor, const Filter &filter);
+    static bool GetFilter(const void *descriptor, Filter *filter);
+    static void SetConvolution(const void *descriptor, const Convolution &convolution);
+    static bool GetConvolution(const void *descriptor, Convolution *convolution);
+
+    /* Validation of the arguments of the shadowed cudnnSet* calls. */
+    static bool IsShadowedType(cudnnDataType_t dataType);
+    static bool IsShadowedFormat(cudnnTensorFormat_t format);
+    static bool IsValidTensor(const Tensor &tensor);
+    static bool IsValidFilter(const Filter &filter);
+    static bool IsValidConvolution(const Convolution &convolution);
+
+    /*
+     * Fully packed strides of dims laid out in format, false if the tensor
+     * does not fit the 32 bit strides of cuDNN.
+     */
+    static bool PackedStrides(cudnnTensorFormat_t format, int nbDims, const int *dims,
+                              int *strides);
+
+    /*
+     * Output dims of a forward convolution, as computed by
+     * cudnnGetConvolutionNdForwardOutputDim, false if any is not positive.
+     */
+    static bool ForwardOutputDim(const Convolution &convolution, const Tensor &input,
+                                 const Filter &filter, int *outputDims);
+};
+
+#endif /* CUDNNSHADOW_H */
@@ -30,6 +30,8 @@
 
 #include "CufftHandler.h"
 
+#include "CufftPlanCache.h"
+
 using namespace std;
 using namespace log4cplus;
 
@@ -78,11 +80,16 @@ CUFFT_ROUTINE_HANDLER(Plan1d) {
     cufftType type = in->Get<cufftType>();
     int batch = in->Get<int>();
 
-    cufftResult exit_code = cufftPlan1d(plan_adv, nx, type, batch);
+    size_t workSize = 0;
+    CufftPlanCache::Key key(type, 1, &nx, batch);
+    cufftResult exit_code = CufftPlanCache::GetInstance().Acquire(
+        key, plan_adv, &workSize,
+        [&](cufftHandle* plan) { return cufftPlan1d(plan, nx, type, batch); });
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
 
     try {
         out->Add(plan_adv);
+        out->Add(workSize);
     } catch (const std::exception& e) {
         LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
         return std::make_shared<Result>(cudaErrorMemoryAllocation);  //???
@@ -102,10 +109,15 @@ CUFFT_ROUTINE_HANDLER(Plan2d) {
     int ny = in->Get<int>();
     cufftType type = in->Get<cufftType>();
 
-    cufftResult exit_code = cufftPlan2d(&plan, nx, ny, type);
+    size_t workSize = 0;
+    int n[2] = {nx, ny};
+    CufftPlanCache::Key key(type, 2, n, 1);
+    cufftResult exit_code = CufftPlanCache::GetInstance().Acquire(
+        key, &plan, &workSize, [&](cufftHandle* p) { return cufftPlan2d(p, nx, ny, type); });
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     try {
         out->Add(&plan);
+        out->Add(workSize);
     } catch (const std::exception& e) {
         LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
         return std::make_shared<Result>(cudaErrorMemoryAllocation);  //???
@@ -127,9 +139,15 @@ CUFFT_ROUTINE_HANDLER(Plan3d) {
         int ny = in->Get<int>();
         int nz = in->Get<int>();
         cufftType type = in->Get<cufftType>();
-        cufftResult ec = cufftPlan3d(plan, nx, ny, nz, type);
+        size_t workSize = 0;
+        int n[3] = {nx, ny, nz};
+        CufftPlanCache::Key key(type, 3, n, 1);
+        cufftResult ec = CufftPlanCache::GetInstance().Acquire(
+            key, plan, &workSize,
+            [&](cufftHandle* p) { return cufftPlan3d(p, nx, ny, nz, type); });
         std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
         out->Add(plan);
+        out->Add(workSize);
         return std::make_shared<Result>(ec, out);
     } catch (const std::exception& e) {
         LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
@@ -145,12 +163,12 @@ CUFFT_ROUTINE_HANDLER(Plan3d) {
 CUFFT_ROUTINE_HANDLER(PlanMany) {
     cufftHandle* plan = in->Assign<cufftHandle>();
     int rank = in->Get<int>();
-    int* n = in->Assign<int>();
-    int* inembed = in->Assign<int>();
+    int* n = in->AssignAll<int>();
+    int* inembed = in->AssignAll<int>();
     int istride = in->Get<int>();
     int idist = in->Get<int>();
 
-    int* onembed = in->Assign<int>();
+    int* onembed = in->AssignAll<int>();
     int ostride = in->Get<int>();
     int odist = in->Get<int>();
 
@@ -161,12 +179,19 @@ CUFFT_ROUTINE_HANDLER(PlanMany) {
                                                  << " type:" << type << " batch: " << batch
                                                  << endl);
     try {
-        cufftResult exit_code = cufftPlanMany(plan, rank, n, inembed, istride, idist, onembed,
-                                              ostride, odist, type, batch);
+        size_t workSize = 0;
+        CufftPlanCache::Key key(type, rank, n, batch);
+        key.AddLayout(inembed, istride, idist, onembed, ostride, odist);
+        cufftResult exit_code = CufftPlanCache::GetInstance().Acquire(
+            key, plan, &workSize, [&](cufftHandle* p) {
+                return cufftPlanMany(p, rank, n, inembed, istride, idist, onembed, ostride, odist,
+                                     type, batch);
+            });
         LOG4CPLUS_DEBUG(pThis->GetLogger(), "cufftPlanMany Executed");
         LOG4CPLUS_DEBUG(pThis->GetLogger(), "Plan: " << *plan);
         std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
         out->Add<cufftHandle>(plan);
+        out->Add(workSize);
         return std::make_shared<Result>(exit_code, out);
     } catch (const std::exception& e) {
         LOG4CPLUS_DEBUG(pThis->GetLogger(), LOG4CPLUS_TEXT("Exception: ") << e.what());
@@ -223,7 +248,7 @@ CUFFT_ROUTINE_HANDLER(Create) {
  */
 CUFFT_ROUTINE_HANDLER(Destroy) {
     cufftHandle plan = in->Get<cufftHandle>();
-    cufftResult exit_code = cufftDestroy(plan);
+    cufftResult exit_code = CufftPlanCache::GetInstance().Release(plan);
 
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cufftDestroy Executed");
     return std::make_shared<Result>(exit_code);
@@ -233,6 +258,7 @@ CUFFT_ROUTINE_HANDLER(SetWorkArea) {
     cufftHandle plan = in->Get<cufftHandle>();
     void* workArea = in->GetFromMarshal<void*>();
     cufftResult exit_code = cufftSetWorkArea(plan, workArea);
+    if (exit_code == CUFFT_SUCCESS) CufftPlanCache::GetInstance().Detach(plan);
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cufftSetWorkArea Executed");
     return std::make_shared<Result>(exit_code);
 }
@@ -241,6 +267,7 @@ CUFFT_ROUTINE_HANDLER(SetAutoAllocation) {
     cufftHandle plan = in->Get<cufftHandle>();
     int autoAllocate = in->Get<int>();
     cufftResult exit_code = cufftSetAutoAllocation(plan, autoAllocate);
+    if (exit_code == CUFFT_SUCCESS) CufftPlanCache::GetInstance().Detach(plan);
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cufftSetAutoAllocation Executed");
     return std::make_shared<Result>(exit_code);
 }
@@ -248,13 +275,13 @@ CUFFT_ROUTINE_HANDLER(SetAutoAllocation) {
 CUFFT_ROUTINE_HANDLER(XtMakePlanMany) {
     cufftHandle plan = in->Get<cufftHandle>();
     int rank = in->Get<int>();
-    long long int* n = in->Assign<long long int>();
-    long long int* inembed = in->Assign<long long int>();
+    long long int* n = in->AssignAll<long long int>();
+    long long int* inembed = in->AssignAll<long long int>();
     long long int istride = in->Get<long long int>();
     long long int idist = in->Get<long long int>();
     cudaDataType inputtype = in->Get<cudaDataType>();
 
-    long long int* onembed = in->Assign<long long int>();
+    long long int* onembed = in->AssignAll<long long int>();
     long long int ostride = in->Get<long long int>();
     long long int odist = in->Get<long long int>();
     cudaDataType outputtype = in->Get<cudaDataType>();
@@ -437,6 +464,7 @@ CUFFT_ROUTINE_HANDLER(XtSetGPUs) {
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "XtSetGPUs: whichGPUs: " << *whichGPUs);
 
     cufftResult exit_code = cufftXtSetGPUs(plan, nGPUs, whichGPUs);
+    if (exit_code == CUFFT_SUCCESS) CufftPlanCache::GetInstance().Detach(plan);
 
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cufftXtSetGPUs Executed");
 
@@ -500,12 +528,12 @@ CUFFT_ROUTINE_HANDLER(Estimate3d) {
 
 CUFFT_ROUTINE_HANDLER(EstimateMany) {
     int rank = in->Get<int>();
-    int* n = in->Assign<int>();
-    int* inembed = in->Assign<int>();
+    int* n = in->AssignAll<int>();
+    int* inembed = in->AssignAll<int>();
     int istride = in->Get<int>();
     int idist = in->Get<int>();
 
-    int* onembed = in->Assign<int>();
+    int* onembed = in->AssignAll<int>();
     int ostride = in->Get<int>();
     int odist = in->Get<int>();
 
@@ -600,12 +628,12 @@ CUFFT_ROUTINE_HANDLER(MakePlan3d) {
 CUFFT_ROUTINE_HANDLER(MakePlanMany) {
     cufftHandle plan = in->Get<cufftHandle>();
     int rank = in->Get<int>();
-    int* n = in->Assign<int>();
-    int* inembed = in->Assign<int>();
+    int* n = in->AssignAll<int>();
+    int* inembed = in->AssignAll<int>();
     int istride = in->Get<int>();
     int idist = in->Get<int>();
 
-    int* onembed = in->Assign<int>();
+    int* onembed = in->AssignAll<int>();
     int ostride = in->Get<int>();
     int odist = in->Get<int>();
 
@@ -629,12 +657,12 @@ CUFFT_ROUTINE_HANDLER(MakePlanMany) {
 CUFFT_ROUTINE_HANDLER(MakePlanMany64) {
     cufftHandle plan = in->Get<cufftHandle>();
     int rank = in->Get<int>();
-    long long int* n = in->Assign<long long int>();
-    long long int* inembed = in->Assign<long long int>();
+    long long int* n = in->AssignAll<long long int>();
+    long long int* inembed = in->AssignAll<long long int>();
     long long int istride = in->Get<long long int>();
     long long int idist = in->Get<long long int>();
 
-    long long int* onembed = in->Assign<long long int>();
+    long long int* onembed = in->AssignAll<long long int>();
     long long int ostride = in->Get<long long int>();
     long long int odist = in->Get<long long int>();
 
@@ -716,12 +744,12 @@ CUFFT_ROUTINE_HANDLER(GetSize3d) {
 CUFFT_ROUTINE_HANDLER(GetSizeMany) {
     cufftHandle handle = in->Get<cufftHandle>();
     int rank = in->Get<int>();
-    int* n = in->Assign<int>();
-    int* inembed = in->Assign<int>();
+    int* n = in->AssignAll<int>();
+    int* inembed = in->AssignAll<int>();
     int istride = in->Get<int>();
     int idist = in->Get<int>();
 
-    int* onembed = in->Assign<int>();
+    int* onembed = in->AssignAll<int>();
     int ostride = in->Get<int>();
     int odist = in->Get<int>();
 
@@ -745,12 +773,12 @@ CUFFT_ROUTINE_HANDLER(GetSizeMany) {
 CUFFT_ROUTINE_HANDLER(GetSizeMany64) {
     cufftHandle plan = in->Get<cufftHandle>();
     int rank = in->Get<int>();
-    long long int* n = in->Assign<long long int>();
-    long long int* inembed = in->Assign<long long int>();
+    long long int* n = in->AssignAll<long long int>();
+    long long int* inembed = in->AssignAll<long long int>();
     long long int istride = in->Get<long long int>();
     long long int idist = in->Get<long long int>();
 
-    long long int* onembed = in->Assign<long long int>();
+    long long int* onembed = in->AssignAll<long long int>();
     long long int ostride = in->Get<long long int>();
     long long int odist = in->Get<long long int>();
 
@@ -791,6 +819,7 @@ CUFFT_ROUTINE_HANDLER(SetStream) {
     cudaStream_t stream = in->GetFromMarshal<cudaStream_t>();
 
     cufftResult exit_code = cufftSetStream(plan, stream);
+    if (exit_code == CUFFT_SUCCESS) CufftPlanCache::GetInstance().SetStream(plan, stream);
 
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "cufftSetStream executed with plan");
     return std::make_shared<Result>(exit_code);
@@ -0,0 +1,161 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2011  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CufftPlanCache.h"
+
+#include <cuda_runtime_api.h>
+#include <log4cplus/loggingmacros.h>
+
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+using namespace log4cplus;
+
+CufftPlanCache::Key::Key(cufftType type, int rank, const int *n, int batch)
+    : mRank(rank), mValid(true) {
+    int device = 0;
+    if (cudaGetDevice(&device) != cudaSuccess || rank < 1 || rank > 3 || n == NULL) mValid = false;
+    Add(device);
+    Add(type);
+    Add(rank);
+    for (int i = 0; mValid && i < rank; i++) Add(n[i]);
+    Add(batch);
+}
+
+void CufftPlanCache::Key::AddLayout(const int *inembed, int istride, int idist,
+                                    const int *onembed, int ostride, int odist) {
+    if (!mValid) return;
+    /* Without inembed or onembed cuFFT uses the basic layout: the same plan as Plan1d/2d/3d. */
+    if (inembed == NULL || onembed == NULL) return;
+    Add('L');
+    for (int i = 0; i < mRank; i++) Add(inembed[i]);
+    Add(istride);
+    Add(idist);
+    for (int i = 0; i < mRank; i++) Add(onembed[i]);
+    Add(ostride);
+    Add(odist);
+}
+
+CufftPlanCache &CufftPlanCache::GetInstance() {
+    static CufftPlanCache instance;
+    return instance;
+}
+
+CufftPlanCache::CufftPlanCache()
+    : logger(Logger::getInstance(LOG4CPLUS_TEXT("CufftPlanCache"))), mCapacity(32) {
+    const char *env = getenv("GVIRTUS_CUFFT_PLAN_CACHE");
+    if (env != NULL && *env != '\0') mCapacity = strtoul(env, NULL, 10);
+}
+
+bool CufftPlanCache::Reuse(const Key &key, cufftHandle *plan, size_t *workSize) {
+    lock_guard<mutex> lock(mMutex);
+    /* The most recently released plan has the best chance of being warm. */
+    for (auto it = mIdle.rbegin(); it != mIdle.rend(); ++it) {
+        if (it->second.key != key.Bytes()) continue;
+        *plan = it->first;
+        *workSize = it->second.workSize;
+        mHeld.emplace(it->first, it->second);
+        mReferences[key.Bytes()]++;
+        mIdle.erase(next(it).base());
+        LOG4CPLUS_DEBUG(logger, "Reusing plan " << *plan);
+        return true;
+    }
+    return false;
+}
+
+void CufftPlanCache::Track(const Key &key, cufftHandle plan, size_t workSize) {
+    lock_guard<mutex> lock(mMutex);
+    mHeld[plan] = Plan{key.Bytes(), workSize, true, NULL};
+    mReferences[key.Bytes()]++;
+}
+
+cufftResult CufftPlanCache::Release(cufftHandle plan) {
+    cudaStream_t stream = NULL;
+    bool keep;
+    {
+        lock_guard<mutex> lock(mMutex);
+        auto held = mHeld.find(plan);
+        if (held == mHeld.end()) {
+            for (auto &idle : mIdle)
+                if (idle.first == plan) return CUFFT_INVALID_PLAN;
+            /* Not made by Acquire: cufftCreate and cufftMakePlan*. */
+            return cufftDestroy(plan);
+        }
+        stream = held->second.stream;
+        keep = held->second.reusable && mCapacity > 0;
+    }
+    /* The work still queued on the stream of the plan uses its work area. */
+    if (keep && cudaStreamSynchronize(stream) != cudaSuccess) keep = false;
+
+    vector<cufftHandle> evicted;
+    {
+        lock_guard<mutex> lock(mMutex);
+        auto held = mHeld.find(plan);
+        if (held == mHeld.end()) return CUFFT_INVALID_PLAN;
+        Plan released = held->second;
+        mHeld.erase(held);
+        auto references = mReferences.find(released.key);
+        if (--references->second == 0) mReferences.erase(references);
+
+        /* The next holder starts on the default stream, as a new plan would. */
+        if (!keep || cufftSetStream(plan, NULL) != CUFFT_SUCCESS) return cufftDestroy(plan);
+        released.stream = NULL;
+        mIdle.emplace_back(plan, released);
+        while (mIdle.size() > mCapacity) {
+            /* Keep the shapes other clients are running: they are the likeliest to come back. */
+            auto victim = mIdle.begin();
+            for (auto it = mIdle.begin(); it != mIdle.end(); ++it)
+                if (mReferences.count(it->second.key) == 0) {
+                    victim = it;
+                    break;
+                }
+            evicted.push_back(victim->first);
+            mIdle.erase(victim);
+        }
+    }
+    for (cufftHandle victim : evicted) cufftDestroy(victim);
+    return CUFFT_SUCCESS;
+}
+
+void CufftPlanCache::SetStream(cufftHandle plan, cudaStream_t stream) {
+    lock_guard<mutex> lock(mMutex);
+    auto held = mHeld.find(plan);
+    if (held != mHeld.end()) held->second.stream = stream;
+}
+
+void CufftPlanCache::Detach(cufftHandle plan) {
+    lock_guard<mutex> lock(mMutex);
+    auto held = mHeld.find(plan);
+    if (held != mHeld.end()) held->second.reusable = false;
+}
+
+size_t CufftPlanCache::Purge() {
+    list<pair<cufftHandle, Plan>> idle;
+    {
+        lock_guard<mutex> lock(mMutex);
+        idle.swap(mIdle);
+    }
+    for (auto &victim : idle) cufftDestroy(victim.first);
+    if (!idle.empty()) LOG4CPLUS_INFO(logger, "Destroyed " << idle.size() << " idle plans");
+    return idle.size();
+}
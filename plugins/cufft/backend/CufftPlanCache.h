@@ -0,0 +1,129 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2011  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CUFFTPLANCACHE_H
+#define CUFFTPLANCACHE_H
+
+#include <cuda_runtime_api.h>
+#include <cufft.h>
+#include <log4cplus/logger.h>
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/*
+ * CufftPlanCache keeps the plans made by cufftPlan1d/2d/3d/Many after their
+ * clients destroy them, so that a client, or another client of the backend,
+ * asking again for the same transform gets a ready plan instead of paying for
+ * plan generation and workspace allocation again.
+ *
+ * A plan is keyed by its type, dimensions, batch, data layout and device. A
+ * cuFFT plan owns its work area and stream, so two clients cannot run it at
+ * the same time: each plan has one holder, and the cache counts the
+ * references of every key, the plans of that key held by clients. Released
+ * plans stay idle up to GVIRTUS_CUFFT_PLAN_CACHE plans (default 32, 0
+ * disables the cache). Past that the least recently released plan of a key
+ * no client holds is destroyed first.
+ */
+class CufftPlanCache {
+   public:
+    class Key {
+       public:
+        Key(cufftType type, int rank, const int *n, int batch);
+
+        /* The advanced layout of cufftPlanMany; strides are ignored without embeddings. */
+        void AddLayout(const int *inembed, int istride, int idist, const int *onembed, int ostride,
+                       int odist);
+
+        /* False when the current device is unknown: the plan is not cached. */
+        bool Valid() const { return mValid; }
+        const std::string &Bytes() const { return mBytes; }
+
+       private:
+        template <class T>
+        void Add(T value) {
+            mBytes.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        std::string mBytes;
+        int mRank;
+        bool mValid;
+    };
+
+    static CufftPlanCache &GetInstance();
+
+    /*
+     * Returns in plan an idle plan of key, or one made by create, and in
+     * workSize the size of its work area.
+     */
+    template <class F>
+    cufftResult Acquire(const Key &key, cufftHandle *plan, size_t *workSize, F create) {
+        if (plan == NULL) return create(plan);
+        if (key.Valid() && Reuse(key, plan, workSize)) return CUFFT_SUCCESS;
+        cufftResult result = create(plan);
+        /* Idle plans hold device memory: give it back and try again. */
+        if (result == CUFFT_ALLOC_FAILED && Purge() > 0) result = create(plan);
+        if (result != CUFFT_SUCCESS) return result;
+        if (cufftGetSize(*plan, workSize) != CUFFT_SUCCESS) *workSize = 0;
+        if (key.Valid()) Track(key, *plan, *workSize);
+        return result;
+    }
+
+    /*
+     * Takes plan back from its holder: it stays idle once the work queued on
+     * its stream is done, or is destroyed if it cannot be reused.
+     */
+    cufftResult Release(cufftHandle plan);
+
+    /* The holder set the stream of plan. */
+    void SetStream(cufftHandle plan, cudaStream_t stream);
+
+    /* The holder changed plan beyond its stream (work area, GPUs): it will not be reused. */
+    void Detach(cufftHandle plan);
+
+   private:
+    CufftPlanCache();
+
+    struct Plan {
+        std::string key;
+        size_t workSize;
+        bool reusable;
+        cudaStream_t stream;
+    };
+
+    bool Reuse(const Key &key, cufftHandle *plan, size_t *workSize);
+    void Track(const Key &key, cufftHandle plan, size_t workSize);
+    size_t Purge();
+
+    log4cplus::Logger logger;
+    std::mutex mMutex;
+    size_t mCapacity;
+    std::unordered_map<cufftHandle, Plan> mHeld;
+    std::unordered_map<std::string, int> mReferences;
+    /* Idle plans, the least recently released first. */
+    std::list<std::pair<cufftHandle, Plan>> mIdle;
+};
+
+#endif /* CUFFTPLANCACHE_H */
@@ -31,10 +31,14 @@
 #include <cufft.h>
 #include <cufftXt.h>
 
+#include <gvirtus/frontend/LocalTier.h>
+
 #include "CufftFrontend.h"
 
 using namespace std;
 
+using gvirtus::frontend::LocalCache;
+
 extern "C" cufftResult cufftPlan1d(cufftHandle *plan, int nx, cufftType type, int batch) {
     CufftFrontend::Prepare();
     CufftFrontend::AddHostPointerForArguments<cufftHandle>(plan);
@@ -43,7 +47,10 @@ extern "C" cufftResult cufftPlan1d(cufftHandle *plan, int nx, cufftType type, in
     CufftFrontend::AddVariableForArguments(batch);
 
     CufftFrontend::Execute("cufftPlan1d");
-    if (CufftFrontend::Success()) *plan = *(CufftFrontend::GetOutputHostPointer<cufftHandle>());
+    if (CufftFrontend::Success()) {
+        *plan = *(CufftFrontend::GetOutputHostPointer<cufftHandle>());
+        CufftFrontend::SetPlanWorkSize(*plan, CufftFrontend::GetOutputVariable<size_t>());
+    }
     return CufftFrontend::GetExitCode();
 }
 
@@ -54,7 +61,10 @@ extern "C" cufftResult cufftPlan2d(cufftHandle *plan, int nx, int ny, cufftType
     CufftFrontend::AddVariableForArguments(type);
 
     CufftFrontend::Execute("cufftPlan2d");
-    if (CufftFrontend::Success()) *plan = *(CufftFrontend::GetOutputHostPointer<cufftHandle>());
+    if (CufftFrontend::Success()) {
+        *plan = *(CufftFrontend::GetOutputHostPointer<cufftHandle>());
+        CufftFrontend::SetPlanWorkSize(*plan, CufftFrontend::GetOutputVariable<size_t>());
+    }
     return CufftFrontend::GetExitCode();
 }
 
@@ -66,11 +76,18 @@ extern "C" cufftResult cufftPlan3d(cufftHandle *plan, int nx, int ny, int nz, cu
     CufftFrontend::AddVariableForArguments(nz);
     CufftFrontend::AddVariableForArguments(type);
     CufftFrontend::Execute("cufftPlan3d");
-    if (CufftFrontend::Success()) *plan = *(CufftFrontend::GetOutputHostPointer<cufftHandle>());
+    if (CufftFrontend::Success()) {
+        *plan = *(CufftFrontend::GetOutputHostPointer<cufftHandle>());
+        CufftFrontend::SetPlanWorkSize(*plan, CufftFrontend::GetOutputVariable<size_t>());
+    }
     return CufftFrontend::GetExitCode();
 }
 
 extern "C" cufftResult cufftEstimate1d(int nx, cufftType type, int batch, size_t *workSize) {
+    CufftSizeKey key("cufftEstimate1d");
+    key.Add(nx).Add(type).Add(batch);
+    if (CufftFrontend::LookupWorkSize(key, workSize)) return CUFFT_SUCCESS;
+
     CufftFrontend::Prepare();
 
     CufftFrontend::AddVariableForArguments<int>(nx);
@@ -78,11 +95,18 @@ extern "C" cufftResult cufftEstimate1d(int nx, cufftType type, int batch, size_t
     CufftFrontend::AddVariableForArguments<int>(batch);
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
     CufftFrontend::Execute("cufftEstimate1d");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        CufftFrontend::StoreWorkSize(key, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
 extern "C" cufftResult cufftEstimate2d(int nx, int ny, cufftType type, size_t *workSize) {
+    CufftSizeKey key("cufftEstimate2d");
+    key.Add(nx).Add(ny).Add(type);
+    if (CufftFrontend::LookupWorkSize(key, workSize)) return CUFFT_SUCCESS;
+
     CufftFrontend::Prepare();
 
     CufftFrontend::AddVariableForArguments<int>(nx);
@@ -90,11 +114,18 @@ extern "C" cufftResult cufftEstimate2d(int nx, int ny, cufftType type, size_t *w
     CufftFrontend::AddVariableForArguments<cufftType>(type);
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
     CufftFrontend::Execute("cufftEstimate2d");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        CufftFrontend::StoreWorkSize(key, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
 extern "C" cufftResult cufftEstimate3d(int nx, int ny, int nz, cufftType type, size_t *workSize) {
+    CufftSizeKey key("cufftEstimate3d");
+    key.Add(nx).Add(ny).Add(nz).Add(type);
+    if (CufftFrontend::LookupWorkSize(key, workSize)) return CUFFT_SUCCESS;
+
     CufftFrontend::Prepare();
 
     CufftFrontend::AddVariableForArguments<int>(nx);
@@ -103,28 +134,39 @@ extern "C" cufftResult cufftEstimate3d(int nx, int ny, int nz, cufftType type, s
     CufftFrontend::AddVariableForArguments<cufftType>(type);
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
     CufftFrontend::Execute("cufftEstimate3d");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        CufftFrontend::StoreWorkSize(key, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
 extern "C" cufftResult cufftEstimateMany(int rank, int *n, int *inembed, int istride, int idist,
                                          int *onembed, int ostride, int odist, cufftType type,
                                          int batch, size_t *workSize) {
+    CufftSizeKey key("cufftEstimateMany");
+    key.Add(rank).Add(n, rank).Add(inembed, inembed ? rank : 0).Add(istride).Add(idist);
+    key.Add(onembed, onembed ? rank : 0).Add(ostride).Add(odist).Add(type).Add(batch);
+    if (CufftFrontend::LookupWorkSize(key, workSize)) return CUFFT_SUCCESS;
+
     CufftFrontend::Prepare();
 
     CufftFrontend::AddVariableForArguments<int>(rank);
-    CufftFrontend::AddHostPointerForArguments<int>(n);
-    CufftFrontend::AddHostPointerForArguments<int>(inembed);
+    CufftFrontend::AddHostPointerForArguments<int>(n, rank);
+    CufftFrontend::AddHostPointerForArguments<int>(inembed, rank);
     CufftFrontend::AddVariableForArguments<int>(istride);
     CufftFrontend::AddVariableForArguments<int>(idist);
-    CufftFrontend::AddHostPointerForArguments<int>(onembed);
+    CufftFrontend::AddHostPointerForArguments<int>(onembed, rank);
     CufftFrontend::AddVariableForArguments<int>(ostride);
     CufftFrontend::AddVariableForArguments<int>(odist);
     CufftFrontend::AddVariableForArguments<cufftType>(type);
     CufftFrontend::AddVariableForArguments<int>(batch);
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
     CufftFrontend::Execute("cufftEstimateMany");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        CufftFrontend::StoreWorkSize(key, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
@@ -139,7 +181,10 @@ extern "C" cufftResult cufftMakePlan1d(cufftHandle plan, int nx, cufftType type,
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
 
     CufftFrontend::Execute("cufftMakePlan1d");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        CufftFrontend::SetPlanWorkSize(plan, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
@@ -154,7 +199,10 @@ extern "C" cufftResult cufftMakePlan2d(cufftHandle plan, int nx, int ny, cufftTy
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
 
     CufftFrontend::Execute("cufftMakePlan2d");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        CufftFrontend::SetPlanWorkSize(plan, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
@@ -170,7 +218,10 @@ extern "C" cufftResult cufftMakePlan3d(cufftHandle plan, int nx, int ny, int nz,
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
 
     CufftFrontend::Execute("cufftMakePlan3d");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        CufftFrontend::SetPlanWorkSize(plan, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
@@ -181,11 +232,11 @@ extern "C" cufftResult cufftMakePlanMany(cufftHandle plan, int rank, int *n, int
     // Passing arguments
     CufftFrontend::AddVariableForArguments<cufftHandle>(plan);
     CufftFrontend::AddVariableForArguments<int>(rank);
-    CufftFrontend::AddHostPointerForArguments<int>(n);
-    CufftFrontend::AddHostPointerForArguments<int>(inembed);
+    CufftFrontend::AddHostPointerForArguments<int>(n, rank);
+    CufftFrontend::AddHostPointerForArguments<int>(inembed, rank);
     CufftFrontend::AddVariableForArguments<int>(istride);
     CufftFrontend::AddVariableForArguments<int>(idist);
-    CufftFrontend::AddHostPointerForArguments<int>(onembed);
+    CufftFrontend::AddHostPointerForArguments<int>(onembed, rank);
     CufftFrontend::AddVariableForArguments<int>(ostride);
     CufftFrontend::AddVariableForArguments<int>(odist);
     CufftFrontend::AddVariableForArguments<cufftType>(type);
@@ -193,7 +244,10 @@ extern "C" cufftResult cufftMakePlanMany(cufftHandle plan, int rank, int *n, int
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
 
     CufftFrontend::Execute("cufftMakePlanMany");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        CufftFrontend::SetPlanWorkSize(plan, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
@@ -206,11 +260,11 @@ extern "C" cufftResult cufftMakePlanMany64(cufftHandle plan, int rank, long long
     // Passing arguments
     CufftFrontend::AddVariableForArguments<cufftHandle>(plan);
     CufftFrontend::AddVariableForArguments<int>(rank);
-    CufftFrontend::AddHostPointerForArguments<long long int>(n);
-    CufftFrontend::AddHostPointerForArguments<long long int>(inembed);
+    CufftFrontend::AddHostPointerForArguments<long long int>(n, rank);
+    CufftFrontend::AddHostPointerForArguments<long long int>(inembed, rank);
     CufftFrontend::AddVariableForArguments<long long int>(istride);
     CufftFrontend::AddVariableForArguments<long long int>(idist);
-    CufftFrontend::AddHostPointerForArguments<long long int>(onembed);
+    CufftFrontend::AddHostPointerForArguments<long long int>(onembed, rank);
     CufftFrontend::AddVariableForArguments<long long int>(ostride);
     CufftFrontend::AddVariableForArguments<long long int>(odist);
     CufftFrontend::AddVariableForArguments<cufftType>(type);
@@ -218,12 +272,20 @@ extern "C" cufftResult cufftMakePlanMany64(cufftHandle plan, int rank, long long
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
 
     CufftFrontend::Execute("cufftMakePlanMany64");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        CufftFrontend::SetPlanWorkSize(plan, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
 extern "C" cufftResult cufftGetSize1d(cufftHandle handle, int nx, cufftType type, int batch,
                                       size_t *workSize) {
+    CufftSizeKey key("cufftGetSize1d");
+    key.Add(nx).Add(type).Add(batch);
+    bool local = CufftFrontend::IsPlanSingleGpu(handle);
+    if (local && CufftFrontend::LookupWorkSize(key, workSize)) return CUFFT_SUCCESS;
+
     CufftFrontend::Prepare();
 
     CufftFrontend::AddVariableForArguments<cufftHandle>(handle);
@@ -233,12 +295,20 @@ extern "C" cufftResult cufftGetSize1d(cufftHandle handle, int nx, cufftType type
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
 
     CufftFrontend::Execute("cufftGetSize1d");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        if (local) CufftFrontend::StoreWorkSize(key, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
 extern "C" cufftResult cufftGetSize2d(cufftHandle handle, int nx, int ny, cufftType type,
                                       size_t *workSize) {
+    CufftSizeKey key("cufftGetSize2d");
+    key.Add(nx).Add(ny).Add(type);
+    bool local = CufftFrontend::IsPlanSingleGpu(handle);
+    if (local && CufftFrontend::LookupWorkSize(key, workSize)) return CUFFT_SUCCESS;
+
     CufftFrontend::Prepare();
 
     CufftFrontend::AddVariableForArguments<cufftHandle>(handle);
@@ -248,12 +318,20 @@ extern "C" cufftResult cufftGetSize2d(cufftHandle handle, int nx, int ny, cufftT
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
 
     CufftFrontend::Execute("cufftGetSize2d");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        if (local) CufftFrontend::StoreWorkSize(key, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
 extern "C" cufftResult cufftGetSize3d(cufftHandle handle, int nx, int ny, int nz, cufftType type,
                                       size_t *workSize) {
+    CufftSizeKey key("cufftGetSize3d");
+    key.Add(nx).Add(ny).Add(nz).Add(type);
+    bool local = CufftFrontend::IsPlanSingleGpu(handle);
+    if (local && CufftFrontend::LookupWorkSize(key, workSize)) return CUFFT_SUCCESS;
+
     CufftFrontend::Prepare();
 
     CufftFrontend::AddVariableForArguments<cufftHandle>(handle);
@@ -264,22 +342,31 @@ extern "C" cufftResult cufftGetSize3d(cufftHandle handle, int nx, int ny, int nz
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
 
     CufftFrontend::Execute("cufftGetSize3d");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        if (local) CufftFrontend::StoreWorkSize(key, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
 extern "C" cufftResult cufftGetSizeMany(cufftHandle handle, int rank, int *n, int *inembed,
                                         int istride, int idist, int *onembed, int ostride,
                                         int odist, cufftType type, int batch, size_t *workSize) {
+    CufftSizeKey key("cufftGetSizeMany");
+    key.Add(rank).Add(n, rank).Add(inembed, inembed ? rank : 0).Add(istride).Add(idist);
+    key.Add(onembed, onembed ? rank : 0).Add(ostride).Add(odist).Add(type).Add(batch);
+    bool local = CufftFrontend::IsPlanSingleGpu(handle);
+    if (local && CufftFrontend::LookupWorkSize(key, workSize)) return CUFFT_SUCCESS;
+
     CufftFrontend::Prepare();
 
     CufftFrontend::AddVariableForArguments<cufftHandle>(handle);
     CufftFrontend::AddVariableForArguments<int>(rank);
-    CufftFrontend::AddHostPointerForArguments<int>(n);
-    CufftFrontend::AddHostPointerForArguments<int>(inembed);
+    CufftFrontend::AddHostPointerForArguments<int>(n, rank);
+    CufftFrontend::AddHostPointerForArguments<int>(inembed, rank);
     CufftFrontend::AddVariableForArguments<int>(istride);
     CufftFrontend::AddVariableForArguments<int>(idist);
-    CufftFrontend::AddHostPointerForArguments<int>(onembed);
+    CufftFrontend::AddHostPointerForArguments<int>(onembed, rank);
     CufftFrontend::AddVariableForArguments<int>(ostride);
     CufftFrontend::AddVariableForArguments<int>(odist);
 
@@ -288,7 +375,10 @@ extern "C" cufftResult cufftGetSizeMany(cufftHandle handle, int rank, int *n, in
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
 
     CufftFrontend::Execute("cufftGetSizeMany");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        if (local) CufftFrontend::StoreWorkSize(key, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
@@ -297,25 +387,35 @@ extern "C" cufftResult cufftGetSizeMany64(cufftHandle plan, int rank, long long
                                           long long int idist, long long int *onembed,
                                           long long int ostride, long long int odist,
                                           cufftType type, long long int batch, size_t *workSize) {
+    CufftSizeKey key("cufftGetSizeMany64");
+    key.Add(rank).Add(n, rank).Add(inembed, inembed ? rank : 0).Add(istride).Add(idist);
+    key.Add(onembed, onembed ? rank : 0).Add(ostride).Add(odist).Add(type).Add(batch);
+    bool local = CufftFrontend::IsPlanSingleGpu(plan);
+    if (local && CufftFrontend::LookupWorkSize(key, workSize)) return CUFFT_SUCCESS;
+
     CufftFrontend::Prepare();
     CufftFrontend::AddVariableForArguments<cufftHandle>(plan);
     CufftFrontend::AddVariableForArguments<int>(rank);
-    CufftFrontend::AddHostPointerForArguments<long long int>(n);
-    CufftFrontend::AddHostPointerForArguments<long long int>(inembed);
+    CufftFrontend::AddHostPointerForArguments<long long int>(n, rank);
+    CufftFrontend::AddHostPointerForArguments<long long int>(inembed, rank);
     CufftFrontend::AddVariableForArguments<long long int>(istride);
     CufftFrontend::AddVariableForArguments<long long int>(idist);
-    CufftFrontend::AddHostPointerForArguments<long long int>(onembed);
+    CufftFrontend::AddHostPointerForArguments<long long int>(onembed, rank);
     CufftFrontend::AddVariableForArguments<long long int>(ostride);
     CufftFrontend::AddVariableForArguments<long long int>(odist);
     CufftFrontend::AddVariableForArguments<cufftType>(type);
     CufftFrontend::AddVariableForArguments<long long int>(batch);
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
     CufftFrontend::Execute("cufftGetSizeMany64");
-    if (CufftFrontend::Success()) *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+    if (CufftFrontend::Success()) {
+        *workSize = *CufftFrontend::GetOutputHostPointer<size_t>();
+        if (local) CufftFrontend::StoreWorkSize(key, *workSize);
+    }
     return CufftFrontend::GetExitCode();
 }
 
 extern "C" cufftResult cufftGetSize(cufftHandle handle, size_t *workSize) {
+    if (CufftFrontend::GetPlanWorkSize(handle, workSize)) return CUFFT_SUCCESS;
     CufftFrontend::Prepare();
     CufftFrontend::AddVariableForArguments<cufftHandle>(handle);
     CufftFrontend::AddHostPointerForArguments<size_t>(workSize);
@@ -331,11 +431,11 @@ extern "C" cufftResult cufftPlanMany(cufftHandle *plan, int rank, int *n, int *i
     // Passing arguments
     CufftFrontend::AddHostPointerForArguments<cufftHandle>(plan);
     CufftFrontend::AddVariableForArguments<int>(rank);
-    CufftFrontend::AddHostPointerForArguments<int>(n);
-    CufftFrontend::AddHostPointerForArguments<int>(inembed);
+    CufftFrontend::AddHostPointerForArguments<int>(n, rank);
+    CufftFrontend::AddHostPointerForArguments<int>(inembed, rank);
     CufftFrontend::AddVariableForArguments<int>(istride);
     CufftFrontend::AddVariableForArguments<int>(idist);
-    CufftFrontend::AddHostPointerForArguments<int>(onembed);
+    CufftFrontend::AddHostPointerForArguments<int>(onembed, rank);
     CufftFrontend::AddVariableForArguments<int>(ostride);
     CufftFrontend::AddVariableForArguments<int>(odist);
 
@@ -343,7 +443,10 @@ extern "C" cufftResult cufftPlanMany(cufftHandle *plan, int rank, int *n, int *i
     CufftFrontend::AddVariableForArguments<int>(batch);
     CufftFrontend::Execute("cufftPlanMany");
 
-    if (CufftFrontend::Success()) *plan = *CufftFrontend::GetOutputHostPointer<cufftHandle>();
+    if (CufftFrontend::Success()) {
+        *plan = *CufftFrontend::GetOutputHostPointer<cufftHandle>();
+        CufftFrontend::SetPlanWorkSize(*plan, CufftFrontend::GetOutputVariable<size_t>());
+    }
 
     return CufftFrontend::GetExitCode();
 }
@@ -351,7 +454,10 @@ extern "C" cufftResult cufftPlanMany(cufftHandle *plan, int rank, int *n, int *i
 extern "C" cufftResult cufftCreate(cufftHandle *plan) {
     CufftFrontend::Prepare();
     CufftFrontend::Execute("cufftCreate");
-    if (CufftFrontend::Success()) *plan = *(CufftFrontend::GetOutputHostPointer<cufftHandle>());
+    if (CufftFrontend::Success()) {
+        *plan = *(CufftFrontend::GetOutputHostPointer<cufftHandle>());
+        CufftFrontend::AddPlan(*plan);
+    }
     return CufftFrontend::GetExitCode();
 }
 
@@ -359,6 +465,7 @@ extern "C" cufftResult cufftDestroy(cufftHandle plan) {
     CufftFrontend::Prepare();
     CufftFrontend::AddVariableForArguments<cufftHandle>(plan);
     CufftFrontend::Execute("cufftDestroy");
+    if (CufftFrontend::Success()) CufftFrontend::ForgetPlan(plan);
     return CufftFrontend::GetExitCode();
 }
 
@@ -469,14 +576,14 @@ extern "C" cufftResult cufftXtMakePlanMany(cufftHandle plan, int rank, long long
     // Passing Arguments
     CufftFrontend::AddVariableForArguments<cufftHandle>(plan);
     CufftFrontend::AddVariableForArguments<int>(rank);
-    CufftFrontend::AddHostPointerForArguments<long long int>(n);
+    CufftFrontend::AddHostPointerForArguments<long long int>(n, rank);
 
-    CufftFrontend::AddHostPointerForArguments<long long int>(inembed);
+    CufftFrontend::AddHostPointerForArguments<long long int>(inembed, rank);
     CufftFrontend::AddVariableForArguments<long long int>(istride);
     CufftFrontend::AddVariableForArguments<long long int>(idist);
     CufftFrontend::AddVariableForArguments<cudaDataType>(inputtype);
 
-    CufftFrontend::AddHostPointerForArguments<long long int>(onembed);
+    CufftFrontend::AddHostPointerForArguments<long long int>(onembed, rank);
     CufftFrontend::AddVariableForArguments<long long int>(ostride);
     CufftFrontend::AddVariableForArguments<long long int>(odist);
     CufftFrontend::AddVariableForArguments<cudaDataType>(outputtype);
@@ -488,6 +595,7 @@ extern "C" cufftResult cufftXtMakePlanMany(cufftHandle plan, int rank, long long
     CufftFrontend::Execute("cufftXtMakePlanMany");
     if (CufftFrontend::Success()) {
         *workSize = *(CufftFrontend::GetOutputHostPointer<size_t>());
+        CufftFrontend::SetPlanWorkSize(plan, *workSize);
     }
     return CufftFrontend::GetExitCode();
 }
@@ -515,6 +623,7 @@ extern "C" cufftResult cufftXtSetGPUs(cufftHandle plan, int nGPUs, int *whichGPU
     CufftFrontend::AddHostPointerForArguments<int>(whichGPUs, nGPUs);
 
     CufftFrontend::Execute("cufftXtSetGPUs");
+    if (CufftFrontend::Success()) CufftFrontend::SetPlanMultiGpu(plan);
     return CufftFrontend::GetExitCode();
 }
 
@@ -598,10 +707,19 @@ extern "C" cufftResult cufftXtSetCallback(cufftHandle plan, void **callbackRouti
 }
 
 extern "C" cufftResult cufftGetVersion(int *version) {
-    CufftFrontend::Prepare();
-    CufftFrontend::Execute("cufftGetVersion");
-    if (CufftFrontend::Success()) *version = CufftFrontend::GetOutputVariable<int>();
-    return CufftFrontend::GetExitCode();
+    // asked once per process
+    static LocalCache<int, int> versions;
+    cufftResult exit_code = CUFFT_SUCCESS;
+    const int *cached = versions.Get(0, [&](int *value) {
+        CufftFrontend::Prepare();
+        CufftFrontend::Execute("cufftGetVersion");
+        exit_code = CufftFrontend::GetExitCode();
+        if (!CufftFrontend::Success()) return false;
+        *value = CufftFrontend::GetOutputVariable<int>();
+        return true;
+    });
+    if (cached != nullptr) *version = *cached;
+    return exit_code;
 }
 
 extern "C" cufftResult CUFFTAPI cufftXtExec(cufftHandle plan, void *input, void *output,
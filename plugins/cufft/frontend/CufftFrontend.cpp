@@ -8,6 +8,9 @@
 
 #include "CufftFrontend.h"
 
+#include <mutex>
+#include <unordered_map>
+
 using namespace std;
 
 using gvirtus::common::mappedPointer;
@@ -27,3 +30,64 @@ CufftFrontend::CufftFrontend() {
 }
 
 CufftFrontend::~CufftFrontend() {}
+
+/* What the frontend knows of the plans it made. */
+struct CufftPlanInfo {
+    size_t workSize = 0;
+    bool made = false;
+    bool multiGpu = false;
+};
+
+static mutex plans_mutex;
+static unordered_map<cufftHandle, CufftPlanInfo> plans;
+static unordered_map<string, size_t> work_sizes;
+
+void CufftFrontend::SetPlanWorkSize(cufftHandle plan, size_t workSize) {
+    lock_guard<mutex> lock(plans_mutex);
+    CufftPlanInfo& info = plans[plan];
+    info.workSize = workSize;
+    info.made = true;
+}
+
+bool CufftFrontend::GetPlanWorkSize(cufftHandle plan, size_t* workSize) {
+    lock_guard<mutex> lock(plans_mutex);
+    auto it = plans.find(plan);
+    if (workSize == NULL || it == plans.end() || !it->second.made || it->second.multiGpu)
+        return false;
+    *workSize = it->second.workSize;
+    return true;
+}
+
+void CufftFrontend::SetPlanMultiGpu(cufftHandle plan) {
+    lock_guard<mutex> lock(plans_mutex);
+    plans[plan].multiGpu = true;
+}
+
+bool CufftFrontend::IsPlanSingleGpu(cufftHandle plan) {
+    lock_guard<mutex> lock(plans_mutex);
+    auto it = plans.find(plan);
+    return it != plans.end() && !it->second.multiGpu;
+}
+
+void CufftFrontend::AddPlan(cufftHandle plan) {
+    lock_guard<mutex> lock(plans_mutex);
+    plans[plan] = CufftPlanInfo();
+}
+
+void CufftFrontend::ForgetPlan(cufftHandle plan) {
+    lock_guard<mutex> lock(plans_mutex);
+    plans.erase(plan);
+}
+
+bool CufftFrontend::LookupWorkSize(const CufftSizeKey& key, size_t* workSize) {
+    lock_guard<mutex> lock(plans_mutex);
+    auto it = work_sizes.find(key.Bytes());
+    if (workSize == NULL || it == work_sizes.end()) return false;
+    *workSize = it->second;
+    return true;
+}
+
+void CufftFrontend::StoreWorkSize(const CufftSizeKey& key, size_t workSize) {
+    lock_guard<mutex> lock(plans_mutex);
+    work_sizes[key.Bytes()] = workSize;
+}
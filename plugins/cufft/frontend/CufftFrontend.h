@@ -19,11 +19,46 @@
 #include <map>
 #include <set>
 #include <stack>
+#include <string>
 
 #include "Cufft.h"
 
 using namespace std;
 
+/*
+ * The arguments of a cufftEstimate* or cufftGetSize* call, and the backend and
+ * device it runs on, which the work size it returned depends on. The frontend
+ * answers a call it has seen before without a round trip.
+ */
+class CufftSizeKey {
+   public:
+    explicit CufftSizeKey(const char* routine) : mBytes(routine) {
+        mBytes.push_back('\0');
+        gvirtus::frontend::Frontend* frontend = gvirtus::frontend::Frontend::GetFrontend();
+        Add(frontend->GetBackend()).Add(frontend->GetDevice());
+    }
+
+    template <class T>
+    CufftSizeKey& Add(T value) {
+        mBytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        return *this;
+    }
+
+    /* An array of n elements, or NULL. */
+    template <class T>
+    CufftSizeKey& Add(const T* array, int n) {
+        Add<int>(array == NULL ? -1 : n);
+        if (array != NULL && n > 0)
+            mBytes.append(reinterpret_cast<const char*>(array), n * sizeof(T));
+        return *this;
+    }
+
+    const std::string& Bytes() const { return mBytes; }
+
+   private:
+    std::string mBytes;
+};
+
 typedef struct __configureFunction {
     gvirtus::common::funcs __f;
     gvirtus::communicators::Buffer* buffer;
@@ -242,6 +277,26 @@ class CufftFrontend {
 
     static inline void addConfigureElement() {}
 
+    /*
+     * The work size of a plan, as the backend reported it when the plan was
+     * made, so that cufftGetSize needs no round trip. A multi-GPU plan has one
+     * work area per GPU and is always asked to the backend.
+     */
+    static void SetPlanWorkSize(cufftHandle plan, size_t workSize);
+    static bool GetPlanWorkSize(cufftHandle plan, size_t* workSize);
+    static void SetPlanMultiGpu(cufftHandle plan);
+    /*
+     * Whether plan was returned by cufftCreate or cufftPlan* and has one GPU,
+     * so that its cufftGetSize* calls may be answered by arguments.
+     */
+    static bool IsPlanSingleGpu(cufftHandle plan);
+    static void AddPlan(cufftHandle plan);
+    static void ForgetPlan(cufftHandle plan);
+
+    /* The work sizes returned by cufftEstimate* and cufftGetSize*, by arguments. */
+    static bool LookupWorkSize(const CufftSizeKey& key, size_t* workSize);
+    static void StoreWorkSize(const CufftSizeKey& key, size_t workSize);
+
     CufftFrontend();
     virtual ~CufftFrontend();
 
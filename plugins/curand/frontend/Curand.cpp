@@ -30,6 +30,7 @@
 #include <unordered_map>
 
 #include "CurandFrontend.h"
+#include "CurandHost.h"
 
 using namespace std;
 
@@ -49,6 +50,36 @@ bool isHostGenerator(curandGenerator_t generator) {
     return false;
 }
 
+/*
+ * Points generator to the backend generator that carries on a local host
+ * generator (see CurandHost), creating it with the seed and offset reached.
+ */
+static curandStatus_t OnBackend(curandGenerator_t* generator) {
+    CurandHost* host = CurandHost::Get(*generator);
+    if (host == nullptr) return CURAND_STATUS_SUCCESS;
+    if (host->Backend() == nullptr) {
+        CurandFrontend::Prepare();
+        CurandFrontend::AddVariableForArguments<curandRngType_t>(host->Type());
+        CurandFrontend::Execute("curandCreateGeneratorHost");
+        if (!CurandFrontend::Success()) return CurandFrontend::GetExitCode();
+        curandGenerator_t backend = CurandFrontend::GetOutputVariable<curandGenerator_t>();
+        {
+            std::lock_guard<std::mutex> lock(generator_type_mutex);
+            generator_is_host_map[backend] = true;  // host generator
+        }
+        curandStatus_t status = curandSetPseudoRandomGeneratorSeed(backend, host->Seed());
+        if (status == CURAND_STATUS_SUCCESS)
+            status = curandSetGeneratorOffset(backend, host->Offset());
+        if (status != CURAND_STATUS_SUCCESS) {
+            curandDestroyGenerator(backend);
+            return status;
+        }
+        host->MoveToBackend(backend);
+    }
+    *generator = host->Backend();
+    return CURAND_STATUS_SUCCESS;
+}
+
 /* HOST API */
 
 extern "C" curandStatus_t CURANDAPI curandCreateGenerator(curandGenerator_t* generator,
@@ -66,6 +97,10 @@ extern "C" curandStatus_t CURANDAPI curandCreateGenerator(curandGenerator_t* gen
 
 extern "C" curandStatus_t CURANDAPI curandCreateGeneratorHost(curandGenerator_t* generator,
                                                               curandRngType_t rng_type) {
+    if (CurandHost::Enabled() && CurandHost::Supports(rng_type)) {
+        *generator = CurandHost::Create(rng_type);
+        return CURAND_STATUS_SUCCESS;
+    }
     CurandFrontend::Prepare();
     CurandFrontend::AddVariableForArguments<curandRngType_t>(rng_type);
     CurandFrontend::Execute("curandCreateGeneratorHost");
@@ -79,6 +114,11 @@ extern "C" curandStatus_t CURANDAPI curandCreateGeneratorHost(curandGenerator_t*
 
 extern "C" curandStatus_t curandSetPseudoRandomGeneratorSeed(curandGenerator_t generator,
                                                              unsigned long long seed) {
+    if (CurandHost* host = CurandHost::Local(generator)) {
+        host->SetSeed(seed);
+        return CURAND_STATUS_SUCCESS;
+    }
+    generator = CurandHost::Remote(generator);
     CurandFrontend::Prepare();
     CurandFrontend::AddDevicePointerForArguments(generator);
     CurandFrontend::AddVariableForArguments<unsigned long long>(seed);
@@ -88,6 +128,11 @@ extern "C" curandStatus_t curandSetPseudoRandomGeneratorSeed(curandGenerator_t g
 
 extern "C" curandStatus_t curandSetGeneratorOffset(curandGenerator_t generator,
                                                    unsigned long long offset) {
+    if (CurandHost* host = CurandHost::Local(generator)) {
+        host->SetOffset(offset);
+        return CURAND_STATUS_SUCCESS;
+    }
+    generator = CurandHost::Remote(generator);
     CurandFrontend::Prepare();
     CurandFrontend::AddDevicePointerForArguments(generator);
     CurandFrontend::AddVariableForArguments<unsigned long long>(offset);
@@ -97,6 +142,7 @@ extern "C" curandStatus_t curandSetGeneratorOffset(curandGenerator_t generator,
 
 extern "C" curandStatus_t curandSetQuasiRandomGeneratorDimensions(curandGenerator_t generator,
                                                                   unsigned int num_dimensions) {
+    if (CurandHost::Get(generator) != nullptr) return CURAND_STATUS_TYPE_ERROR;
     CurandFrontend::Prepare();
     CurandFrontend::AddDevicePointerForArguments(generator);
     CurandFrontend::AddVariableForArguments<unsigned int>(num_dimensions);
@@ -106,6 +152,8 @@ extern "C" curandStatus_t curandSetQuasiRandomGeneratorDimensions(curandGenerato
 
 extern "C" curandStatus_t curandGenerate(curandGenerator_t generator, unsigned int* outputPtr,
                                          size_t num) {
+    if (CurandHost* host = CurandHost::Local(generator)) return host->Generate(outputPtr, num);
+    generator = CurandHost::Remote(generator);
     CurandFrontend::Prepare();
     CurandFrontend::AddDevicePointerForArguments(generator);
     CurandFrontend::AddVariableForArguments<size_t>(num);
@@ -121,6 +169,7 @@ extern "C" curandStatus_t curandGenerate(curandGenerator_t generator, unsigned i
 
 extern "C" curandStatus_t curandGenerateLongLong(curandGenerator_t generator,
                                                  unsigned long long* outputPtr, size_t num) {
+    if (CurandHost::Get(generator) != nullptr) return CURAND_STATUS_TYPE_ERROR;
     CurandFrontend::Prepare();
     CurandFrontend::AddDevicePointerForArguments(generator);
     CurandFrontend::AddVariableForArguments<size_t>(num);
@@ -137,6 +186,9 @@ extern "C" curandStatus_t curandGenerateLongLong(curandGenerator_t generator,
 
 extern "C" curandStatus_t curandGenerateUniform(curandGenerator_t generator, float* outputPtr,
                                                 size_t num) {
+    if (CurandHost* host = CurandHost::Local(generator))
+        return host->GenerateUniform(outputPtr, num);
+    generator = CurandHost::Remote(generator);
     CurandFrontend::Prepare();
     CurandFrontend::AddDevicePointerForArguments(generator);
     CurandFrontend::AddVariableForArguments<size_t>(num);
@@ -152,6 +204,9 @@ extern "C" curandStatus_t curandGenerateUniform(curandGenerator_t generator, flo
 
 extern "C" curandStatus_t curandGenerateNormal(curandGenerator_t generator, float* outputPtr,
                                                size_t num, float mean, float stddev) {
+    // Not bit-exact on the host: the generator moves to the backend.
+    curandStatus_t status = OnBackend(&generator);
+    if (status != CURAND_STATUS_SUCCESS) return status;
     CurandFrontend::Prepare();
     CurandFrontend::AddDevicePointerForArguments(generator);
     CurandFrontend::AddVariableForArguments<size_t>(num);
@@ -194,6 +249,9 @@ extern "C" curandStatus_t curandGenerateNormal(curandGenerator_t generator, floa
 
 extern "C" curandStatus_t curandGenerateLogNormal(curandGenerator_t generator, float* outputPtr,
                                                   size_t num, float mean, float stddev) {
+    // Not bit-exact on the host: the generator moves to the backend.
+    curandStatus_t status = OnBackend(&generator);
+    if (status != CURAND_STATUS_SUCCESS) return status;
     CurandFrontend::Prepare();
     CurandFrontend::AddDevicePointerForArguments(generator);
     CurandFrontend::AddVariableForArguments<size_t>(num);
@@ -212,6 +270,9 @@ extern "C" curandStatus_t curandGenerateLogNormal(curandGenerator_t generator, f
 extern "C" curandStatus_t curandGeneratePoisson(curandGenerator_t generator,
                                                 unsigned int* outputPtr, size_t num,
                                                 double lambda) {
+    // Not bit-exact on the host: the generator moves to the backend.
+    curandStatus_t status = OnBackend(&generator);
+    if (status != CURAND_STATUS_SUCCESS) return status;
     CurandFrontend::Prepare();
     CurandFrontend::AddDevicePointerForArguments(generator);
     CurandFrontend::AddVariableForArguments<size_t>(num);
@@ -228,6 +289,9 @@ extern "C" curandStatus_t curandGeneratePoisson(curandGenerator_t generator,
 
 extern "C" curandStatus_t curandGenerateUniformDouble(curandGenerator_t generator,
                                                       double* outputPtr, size_t num) {
+    if (CurandHost* host = CurandHost::Local(generator))
+        return host->GenerateUniformDouble(outputPtr, num);
+    generator = CurandHost::Remote(generator);
     CurandFrontend::Prepare();
     CurandFrontend::AddDevicePointerForArguments(generator);
     CurandFrontend::AddVariableForArguments<size_t>(num);
@@ -243,6 +307,9 @@ extern "C" curandStatus_t curandGenerateUniformDouble(curandGenerator_t generato
 
 extern "C" curandStatus_t curandGenerateNormalDouble(curandGenerator_t generator, double* outputPtr,
                                                      size_t n, double mean, double stddev) {
+    // Not bit-exact on the host: the generator moves to the backend.
+    curandStatus_t status = OnBackend(&generator);
+    if (status != CURAND_STATUS_SUCCESS) return status;
     CurandFrontend::Prepare();
     CurandFrontend::AddDevicePointerForArguments(generator);
     CurandFrontend::AddVariableForArguments<size_t>(n);
@@ -261,6 +328,9 @@ extern "C" curandStatus_t curandGenerateNormalDouble(curandGenerator_t generator
 extern "C" curandStatus_t curandGenerateLogNormalDouble(curandGenerator_t generator,
                                                         double* outputPtr, size_t n, double mean,
                                                         double stddev) {
+    // Not bit-exact on the host: the generator moves to the backend.
+    curandStatus_t status = OnBackend(&generator);
+    if (status != CURAND_STATUS_SUCCESS) return status;
     CurandFrontend::Prepare();
     CurandFrontend::AddDevicePointerForArguments(generator);
     CurandFrontend::AddVariableForArguments<size_t>(n);
@@ -277,6 +347,12 @@ extern "C" curandStatus_t curandGenerateLogNormalDouble(curandGenerator_t genera
 }
 
 extern "C" curandStatus_t CURANDAPI curandDestroyGenerator(curandGenerator_t generator) {
+    if (CurandHost* host = CurandHost::Get(generator)) {
+        curandGenerator_t backend = host->Backend();
+        CurandHost::Destroy(generator);
+        if (backend == nullptr) return CURAND_STATUS_SUCCESS;
+        generator = backend;
+    }
     CurandFrontend::Prepare();
     CurandFrontend::AddDevicePointerForArguments(generator);
     CurandFrontend::Execute("curandDestroyGenerator");
@@ -0,0 +1,498 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include "CurandHost.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+// Constants of curand_kernel.h and curand_mrg32k3a.h.
+const float k2Pow32Inv = 2.3283064e-10f;
+const double k2Pow53Inv = 1.1102230246251565e-16;
+const double kMrgNorm = 2.3283065498378288e-10;
+const double kMrgBitsNorm = 1.000000048662;
+const uint64_t kMrgM1 = 4294967087ull;
+const uint64_t kMrgM2 = 4294944443ull;
+
+// Requests smaller than this are generated by the calling thread alone.
+const size_t kParallelItems = 1 << 20;
+
+/*
+ * The distributions of the generators returning 32 bit integers (XORWOW and
+ * Philox), as the device code computes them, fused multiply-adds included.
+ */
+struct IntegerDistributions {
+    static const int kUniformDoubleDraws = 2;
+
+    static unsigned int Bits(const uint32_t *r) { return r[0]; }
+
+    static float Uniform(const uint32_t *r) {
+        return fmaf((float)r[0], k2Pow32Inv, k2Pow32Inv / 2.0f);
+    }
+
+    static double UniformDouble(const uint32_t *r) {
+        uint64_t z = (uint64_t)r[0] ^ ((uint64_t)r[1] << (53 - 32));
+        return z * k2Pow53Inv + k2Pow53Inv / 2.0;
+    }
+};
+
+/*
+ * XORWOW: the state is five xorshift words, linear over GF(2), plus a Weyl
+ * counter. Jumps multiply the words by precomputed powers of the step matrix.
+ */
+struct XorwowMatrix {
+    uint32_t col[160][5];
+};
+
+void XorwowApply(const XorwowMatrix &m, uint32_t *v) {
+    uint32_t r[5] = {0, 0, 0, 0, 0};
+    for (int i = 0; i < 160; i++) {
+        if ((v[i / 32] >> (i % 32)) & 1) {
+            for (int k = 0; k < 5; k++) r[k] ^= m.col[i][k];
+        }
+    }
+    memcpy(v, r, sizeof(r));
+}
+
+/* Powers 2^0 ... 2^67 of the step matrix; 2^67 is the subsequence distance. */
+const std::vector<XorwowMatrix> &XorwowPowers() {
+    static std::vector<XorwowMatrix> powers;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        powers.resize(68);
+        for (int i = 0; i < 160; i++) {
+            uint32_t v[5] = {0, 0, 0, 0, 0};
+            v[i / 32] = 1u << (i % 32);
+            uint32_t t = v[0] ^ (v[0] >> 2);
+            uint32_t *c = powers[0].col[i];
+            c[0] = v[1];
+            c[1] = v[2];
+            c[2] = v[3];
+            c[3] = v[4];
+            c[4] = (v[4] ^ (v[4] << 4)) ^ (t ^ (t << 1));
+        }
+        for (int p = 1; p < 68; p++) {
+            powers[p] = powers[p - 1];
+            for (int i = 0; i < 160; i++) XorwowApply(powers[p - 1], powers[p].col[i]);
+        }
+    });
+    return powers;
+}
+
+struct Xorwow : IntegerDistributions {
+    static const size_t kStreams = 4096;
+
+    std::vector<uint32_t> mBase;  // the 5 words of every subsequence at its start
+    uint32_t mBaseD;
+    std::vector<uint32_t> mV[5];
+    std::vector<uint32_t> mD;
+
+    void Seed(unsigned long long seed) {
+        const auto &powers = XorwowPowers();
+        uint32_t s0 = (uint32_t)seed ^ 0xaad26b49u;
+        uint32_t s1 = (uint32_t)(seed >> 32) ^ 0xf7dcefddu;
+        uint32_t t0 = 1099087573u * s0;
+        uint32_t t1 = 2591861531u * s1;
+        uint32_t v[5] = {123456789u + t0, 362436069u ^ t0, 521288629u + t1, 88675123u ^ t1,
+                         5783321u + t0};
+        mBaseD = 6615241u + t1 + t0;
+        mBase.resize(5 * kStreams);
+        for (size_t lane = 0; lane < kStreams; lane++) {
+            memcpy(&mBase[5 * lane], v, sizeof(v));
+            XorwowApply(powers[67], v);
+        }
+        for (auto &words : mV) words.resize(kStreams);
+        mD.resize(kStreams);
+    }
+
+    void Reset(size_t lane, uint64_t skip) {
+        const auto &powers = XorwowPowers();
+        uint32_t v[5];
+        memcpy(v, &mBase[5 * lane], sizeof(v));
+        for (int i = 0; i < 64 && (skip >> i) != 0; i++) {
+            if ((skip >> i) & 1) XorwowApply(powers[i], v);
+        }
+        for (int k = 0; k < 5; k++) mV[k][lane] = v[k];
+        mD[lane] = mBaseD + 362437u * (uint32_t)skip;
+    }
+
+    /* One output of each lane in [lo, hi), to dst[0], dst[stride], ... */
+    void Draw(size_t lo, size_t hi, uint32_t *dst, size_t stride) {
+        uint32_t *v0 = mV[0].data(), *v1 = mV[1].data(), *v2 = mV[2].data();
+        uint32_t *v3 = mV[3].data(), *v4 = mV[4].data(), *d = mD.data();
+        for (size_t s = lo; s < hi; s++) {
+            uint32_t t = v0[s] ^ (v0[s] >> 2);
+            v0[s] = v1[s];
+            v1[s] = v2[s];
+            v2[s] = v3[s];
+            v3[s] = v4[s];
+            v4[s] = (v4[s] ^ (v4[s] << 4)) ^ (t ^ (t << 1));
+            d[s] += 362437u;
+            dst[(s - lo) * stride] = v4[s] + d[s];
+        }
+    }
+};
+
+/* Philox4x32-10: counter based, subsequence in the third counter word. */
+void Philox4x32_10(const uint32_t *ctr, const uint32_t *key, uint32_t *out) {
+    uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; round++) {
+        if (round > 0) {
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        uint64_t p0 = (uint64_t)0xD2511F53u * c0;
+        uint64_t p1 = (uint64_t)0xCD9E8D57u * c2;
+        c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        c1 = (uint32_t)p1;
+        c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c3 = (uint32_t)p0;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+struct Philox : IntegerDistributions {
+    static const size_t kStreams = 65536;
+
+    uint32_t mKey[2];
+    std::vector<uint64_t> mBlock;  // counter of the current block of four outputs
+    std::vector<uint32_t> mOutput;
+    std::vector<uint8_t> mIndex;  // next output in the block
+
+    void Seed(unsigned long long seed) {
+        mKey[0] = (uint32_t)seed;
+        mKey[1] = (uint32_t)(seed >> 32);
+        mBlock.resize(kStreams);
+        mOutput.resize(4 * kStreams);
+        mIndex.resize(kStreams);
+    }
+
+    void Fill(size_t lane) {
+        uint32_t ctr[4] = {(uint32_t)mBlock[lane], (uint32_t)(mBlock[lane] >> 32), (uint32_t)lane,
+                           0};
+        Philox4x32_10(ctr, mKey, &mOutput[4 * lane]);
+    }
+
+    void Reset(size_t lane, uint64_t skip) {
+        mBlock[lane] = skip / 4;
+        mIndex[lane] = skip % 4;
+        Fill(lane);
+    }
+
+    uint32_t Next(size_t lane) {
+        uint32_t r = mOutput[4 * lane + mIndex[lane]];
+        if (++mIndex[lane] == 4) {
+            mIndex[lane] = 0;
+            mBlock[lane]++;
+            Fill(lane);
+        }
+        return r;
+    }
+
+    void Draw(size_t lo, size_t hi, uint32_t *dst, size_t stride) {
+        for (size_t s = lo; s < hi; s++) dst[(s - lo) * stride] = Next(s);
+    }
+};
+
+/*
+ * MRG32k3a: two third order recurrences modulo m1 and m2. Jumps multiply each
+ * by a power of its 3x3 companion matrix. The lanes hold the raw result, an
+ * integer in [1, m1], which the distributions scale as the device code does.
+ */
+struct MrgMatrix {
+    uint64_t a[3][3];
+};
+
+MrgMatrix MrgMultiply(const MrgMatrix &x, const MrgMatrix &y, uint64_t m) {
+    MrgMatrix r;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            uint64_t sum = 0;
+            for (int k = 0; k < 3; k++) sum += x.a[i][k] * y.a[k][j] % m;
+            r.a[i][j] = sum % m;
+        }
+    }
+    return r;
+}
+
+void MrgApply(const MrgMatrix &x, uint32_t *s, uint64_t m) {
+    uint64_t r[3];
+    for (int i = 0; i < 3; i++) {
+        uint64_t sum = 0;
+        for (int k = 0; k < 3; k++) sum += x.a[i][k] * s[k] % m;
+        r[i] = sum % m;
+    }
+    for (int i = 0; i < 3; i++) s[i] = (uint32_t)r[i];
+}
+
+/* Powers 2^0 ... 2^76 of both matrices; 2^76 is the subsequence distance. */
+struct MrgPowers {
+    std::vector<MrgMatrix> a1, a2;
+};
+
+const MrgPowers &MrgPowersTable() {
+    static MrgPowers powers;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        powers.a1.push_back({{{0, 1, 0}, {0, 0, 1}, {kMrgM1 - 810728, 1403580, 0}}});
+        powers.a2.push_back({{{0, 1, 0}, {0, 0, 1}, {kMrgM2 - 1370589, 0, 527612}}});
+        for (int p = 1; p <= 76; p++) {
+            powers.a1.push_back(MrgMultiply(powers.a1.back(), powers.a1.back(), kMrgM1));
+            powers.a2.push_back(MrgMultiply(powers.a2.back(), powers.a2.back(), kMrgM2));
+        }
+    });
+    return powers;
+}
+
+struct Mrg32k3a {
+    static const size_t kStreams = 81920;
+    static const int kUniformDoubleDraws = 1;
+
+    std::vector<uint32_t> mBase;  // the 6 words of every subsequence at its start
+    std::vector<uint32_t> mS[6];
+
+    void Seed(unsigned long long seed) {
+        const auto &powers = MrgPowersTable();
+        uint32_t s1[3] = {12345u, 12345u, 12345u};
+        uint32_t s2[3] = {12345u, 12345u, 12345u};
+        if (seed != 0ull) {
+            uint64_t x1 = (uint32_t)seed ^ 0x55555555u;
+            uint64_t x2 = (uint32_t)((seed >> 32) ^ 0xAAAAAAAAull);
+            s1[0] = (uint32_t)(x1 * s1[0] % kMrgM1);
+            s1[1] = (uint32_t)(x2 * s1[1] % kMrgM1);
+            s1[2] = (uint32_t)(x1 * s1[2] % kMrgM1);
+            s2[0] = (uint32_t)(x2 * s2[0] % kMrgM2);
+            s2[1] = (uint32_t)(x1 * s2[1] % kMrgM2);
+            s2[2] = (uint32_t)(x2 * s2[2] % kMrgM2);
+        }
+        mBase.resize(6 * kStreams);
+        for (size_t lane = 0; lane < kStreams; lane++) {
+            memcpy(&mBase[6 * lane], s1, sizeof(s1));
+            memcpy(&mBase[6 * lane + 3], s2, sizeof(s2));
+            MrgApply(powers.a1[76], s1, kMrgM1);
+            MrgApply(powers.a2[76], s2, kMrgM2);
+        }
+        for (auto &words : mS) words.resize(kStreams);
+    }
+
+    void Reset(size_t lane, uint64_t skip) {
+        const auto &powers = MrgPowersTable();
+        uint32_t s[6];
+        memcpy(s, &mBase[6 * lane], sizeof(s));
+        for (int i = 0; i < 64 && (skip >> i) != 0; i++) {
+            if ((skip >> i) & 1) {
+                MrgApply(powers.a1[i], s, kMrgM1);
+                MrgApply(powers.a2[i], s + 3, kMrgM2);
+            }
+        }
+        for (int k = 0; k < 6; k++) mS[k][lane] = s[k];
+    }
+
+    void Draw(size_t lo, size_t hi, uint32_t *dst, size_t stride) {
+        uint32_t *s10 = mS[0].data(), *s11 = mS[1].data(), *s12 = mS[2].data();
+        uint32_t *s20 = mS[3].data(), *s21 = mS[4].data(), *s22 = mS[5].data();
+        for (size_t s = lo; s < hi; s++) {
+            int64_t p1 = (1403580ll * s11[s] - 810728ll * s10[s]) % (int64_t)kMrgM1;
+            if (p1 < 0) p1 += kMrgM1;
+            s10[s] = s11[s];
+            s11[s] = s12[s];
+            s12[s] = (uint32_t)p1;
+            int64_t p2 = (527612ll * s22[s] - 1370589ll * s20[s]) % (int64_t)kMrgM2;
+            if (p2 < 0) p2 += kMrgM2;
+            s20[s] = s21[s];
+            s21[s] = s22[s];
+            s22[s] = (uint32_t)p2;
+            dst[(s - lo) * stride] = (uint32_t)(p1 <= p2 ? p1 - p2 + kMrgM1 : p1 - p2);
+        }
+    }
+
+    static unsigned int Bits(const uint32_t *r) { return (unsigned int)(r[0] * kMrgBitsNorm); }
+
+    static float Uniform(const uint32_t *r) { return (float)(r[0] * kMrgNorm); }
+
+    static double UniformDouble(const uint32_t *r) { return r[0] * kMrgNorm; }
+};
+
+/*
+ * Output i of a generator is drawn from lane i mod kStreams, each lane being
+ * one subsequence of the engine. Output rows are generated lane-parallel, which
+ * the compiler vectorizes, and large requests split the lanes among threads.
+ */
+template <class Engine>
+class Generator : public CurandHost {
+   public:
+    explicit Generator(curandRngType_t rng_type)
+        : CurandHost(rng_type), mSeed(0), mItem(0), mPositioned(false) {
+        mEngine.Seed(0);
+    }
+
+    void SetSeed(unsigned long long seed) override {
+        mEngine.Seed(seed);
+        mSeed = seed;
+        mPositioned = false;
+    }
+
+    unsigned long long Seed() const override { return mSeed; }
+    unsigned long long Offset() const override { return mItem; }
+
+    void SetOffset(unsigned long long offset) override {
+        mItem = offset;
+        mPositioned = false;
+    }
+
+    curandStatus_t Generate(unsigned int *output, size_t num) override {
+        Run(num, 1, [&](uint64_t i, const uint32_t *r) { output[i] = Engine::Bits(r); });
+        return CURAND_STATUS_SUCCESS;
+    }
+
+    curandStatus_t GenerateUniform(float *output, size_t num) override {
+        Run(num, 1, [&](uint64_t i, const uint32_t *r) { output[i] = Engine::Uniform(r); });
+        return CURAND_STATUS_SUCCESS;
+    }
+
+    curandStatus_t GenerateUniformDouble(double *output, size_t num) override {
+        Run(num, Engine::kUniformDoubleDraws,
+            [&](uint64_t i, const uint32_t *r) { output[i] = Engine::UniformDouble(r); });
+        return CURAND_STATUS_SUCCESS;
+    }
+
+   private:
+    /* Moves every lane to the first output it owns at or after mItem. */
+    void Position() {
+        if (mPositioned) return;
+        const size_t T = Engine::kStreams;
+        for (size_t lane = 0; lane < T; lane++)
+            mEngine.Reset(lane, mItem > lane ? (mItem - lane + T - 1) / T : 0);
+        mPositioned = true;
+    }
+
+    template <class Work>
+    void ForLanes(size_t items, Work work) {
+        const size_t T = Engine::kStreams;
+        size_t workers = items >= kParallelItems ? std::thread::hardware_concurrency() : 1;
+        workers = std::min<size_t>(workers, 16);
+        if (workers <= 1) {
+            work(0, T);
+            return;
+        }
+        size_t chunk = (T + workers - 1) / workers;
+        std::vector<std::thread> threads;
+        for (size_t w = 1; w < workers; w++)
+            threads.emplace_back(work, w * chunk, std::min(T, (w + 1) * chunk));
+        work(0, chunk);
+        for (auto &thread : threads) thread.join();
+    }
+
+    /* Generates items outputs of draws raw values each. */
+    template <class Emit>
+    void Run(size_t items, int draws, Emit emit) {
+        const size_t T = Engine::kStreams;
+        Position();
+        const uint64_t begin = mItem, end = mItem + items;
+        ForLanes(items, [&](size_t lane_lo, size_t lane_hi) {
+            std::vector<uint32_t> r(draws * (lane_hi - lane_lo));
+            for (uint64_t row = begin / T * T; row < end; row += T) {
+                size_t lo = std::max<uint64_t>(lane_lo, row < begin ? begin - row : 0);
+                size_t hi = std::min<uint64_t>(lane_hi, end - row);
+                if (lo >= hi) continue;
+                for (int k = 0; k < draws; k++) mEngine.Draw(lo, hi, r.data() + k, draws);
+                for (size_t s = lo; s < hi; s++) emit(row + s - begin, &r[(s - lo) * draws]);
+            }
+        });
+        mItem = end;
+    }
+
+    Engine mEngine;
+    unsigned long long mSeed;
+    uint64_t mItem;  // index of the next output
+    bool mPositioned;
+};
+
+std::mutex generators_mutex;
+std::unordered_set<CurandHost *> generators;
+
+}  // namespace
+
+bool CurandHost::Enabled() {
+    static const bool enabled = [] {
+        const char *env = getenv("GVIRTUS_CURAND_LOCAL_HOST");
+        return env == nullptr || strcmp(env, "0") != 0;
+    }();
+    return enabled;
+}
+
+bool CurandHost::Supports(curandRngType_t rng_type) {
+    return rng_type == CURAND_RNG_PSEUDO_DEFAULT || rng_type == CURAND_RNG_PSEUDO_XORWOW ||
+           rng_type == CURAND_RNG_PSEUDO_MRG32K3A || rng_type == CURAND_RNG_PSEUDO_PHILOX4_32_10;
+}
+
+curandGenerator_t CurandHost::Create(curandRngType_t rng_type) {
+    CurandHost *host;
+    if (rng_type == CURAND_RNG_PSEUDO_MRG32K3A)
+        host = new Generator<Mrg32k3a>(rng_type);
+    else if (rng_type == CURAND_RNG_PSEUDO_PHILOX4_32_10)
+        host = new Generator<Philox>(rng_type);
+    else
+        host = new Generator<Xorwow>(rng_type);
+    std::lock_guard<std::mutex> lock(generators_mutex);
+    generators.insert(host);
+    return reinterpret_cast<curandGenerator_t>(host);
+}
+
+CurandHost *CurandHost::Get(curandGenerator_t generator) {
+    auto host = reinterpret_cast<CurandHost *>(generator);
+    std::lock_guard<std::mutex> lock(generators_mutex);
+    return generators.count(host) != 0 ? host : nullptr;
+}
+
+CurandHost *CurandHost::Local(curandGenerator_t generator) {
+    CurandHost *host = Get(generator);
+    return host != nullptr && host->Backend() == nullptr ? host : nullptr;
+}
+
+curandGenerator_t CurandHost::Remote(curandGenerator_t generator) {
+    CurandHost *host = Get(generator);
+    return host != nullptr && host->Backend() != nullptr ? host->Backend() : generator;
+}
+
+void CurandHost::Destroy(curandGenerator_t generator) {
+    auto host = reinterpret_cast<CurandHost *>(generator);
+    {
+        std::lock_guard<std::mutex> lock(generators_mutex);
+        if (generators.erase(host) == 0) return;
+    }
+    delete host;
+}
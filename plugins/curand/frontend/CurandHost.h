@@ -0,0 +1,90 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef CURANDHOST_H
+#define CURANDHOST_H
+
+#include <curand.h>
+
+#include <cstddef>
+
+/*
+ * CurandHost runs the generators created by curandCreateGeneratorHost in the
+ * frontend, so that generating on the host costs no round trip and no copy of
+ * the results over the network.
+ *
+ * XORWOW, MRG32k3a and Philox4_32_10 are implemented as in curand_kernel.h:
+ * output n comes from subsequence n mod T of the generator (T = 4096, 81920 and
+ * 65536 respectively), each subsequence continuing where the previous call left
+ * it, which is the CURAND_ORDERING_PSEUDO_DEFAULT layout of cuRAND. Only the 32
+ * bit outputs and the uniform distributions, which are exact, are generated
+ * locally. The first normal, log-normal or Poisson request moves the generator
+ * to the backend for good: a backend generator of the same type, seed and
+ * offset takes over, so that every distribution comes out as cuRAND computes it.
+ *
+ * The other generator types still run on the backend. GVIRTUS_CURAND_LOCAL_HOST=0
+ * sends every host generator to the backend.
+ */
+class CurandHost {
+   public:
+    static bool Enabled();
+    static bool Supports(curandRngType_t rng_type);
+
+    static curandGenerator_t Create(curandRngType_t rng_type);
+
+    /* The local generator behind generator, nullptr if it lives on the backend. */
+    static CurandHost *Get(curandGenerator_t generator);
+
+    /* Get(), unless the generator has moved to the backend. */
+    static CurandHost *Local(curandGenerator_t generator);
+
+    /* The backend generator that took over generator, or generator itself. */
+    static curandGenerator_t Remote(curandGenerator_t generator);
+
+    static void Destroy(curandGenerator_t generator);
+
+    explicit CurandHost(curandRngType_t rng_type) : mType(rng_type), mBackend(nullptr) {}
+    virtual ~CurandHost() {}
+
+    curandRngType_t Type() const { return mType; }
+    virtual unsigned long long Seed() const = 0;
+    /* The index of the next output. */
+    virtual unsigned long long Offset() const = 0;
+
+    /* The generator that took over on the backend, nullptr while it runs locally. */
+    curandGenerator_t Backend() const { return mBackend; }
+    void MoveToBackend(curandGenerator_t backend) { mBackend = backend; }
+
+    virtual void SetSeed(unsigned long long seed) = 0;
+    virtual void SetOffset(unsigned long long offset) = 0;
+
+    virtual curandStatus_t Generate(unsigned int *output, size_t num) = 0;
+    virtual curandStatus_t GenerateUniform(float *output, size_t num) = 0;
+    virtual curandStatus_t GenerateUniformDouble(double *output, size_t num) = 0;
+
+   private:
+    curandRngType_t mType;
+    curandGenerator_t mBackend;
+};
+
+#endif /* CURANDHOST_H */
@@ -26,21 +26,43 @@
  *            School of Computer Science, University College Dublin
  */
 
+#include <gvirtus/frontend/LocalTier.h>
+
+#include <string>
+
 #include "CusparseFrontend.h"
 
 using namespace std;
 
+using gvirtus::frontend::LocalCache;
+
 extern "C" cusparseStatus_t cusparseGetVersion(cusparseHandle_t handle, int* version) {
-    CusparseFrontend::Prepare();
-    CusparseFrontend::AddDevicePointerForArguments(handle);
-    CusparseFrontend::Execute("cusparseGetVersion");
-    if (CusparseFrontend::Success()) *version = CusparseFrontend::GetOutputVariable<int>();
-    return CusparseFrontend::GetExitCode();
+    // the version is the same for every handle: the backend is asked once per process
+    static LocalCache<int, int> versions;
+    if (handle == nullptr) return CUSPARSE_STATUS_NOT_INITIALIZED;
+    cusparseStatus_t exit_code = CUSPARSE_STATUS_SUCCESS;
+    const int* cached = versions.Get(0, [&](int* value) {
+        CusparseFrontend::Prepare();
+        CusparseFrontend::AddDevicePointerForArguments(handle);
+        CusparseFrontend::Execute("cusparseGetVersion");
+        exit_code = CusparseFrontend::GetExitCode();
+        if (!CusparseFrontend::Success()) return false;
+        *value = CusparseFrontend::GetOutputVariable<int>();
+        return true;
+    });
+    if (cached != nullptr) *version = *cached;
+    return exit_code;
 }
 
 extern "C" const char* cusparseGetErrorString(cusparseStatus_t status) {
-    CusparseFrontend::Prepare();
-    CusparseFrontend::AddVariableForArguments<cusparseStatus_t>(status);
-    CusparseFrontend::Execute("cusparseGetErrorString");
-    return CusparseFrontend::GetOutputString();
+    static LocalCache<int, string> strings;
+    const string* s = strings.Get(status, [status](string* value) {
+        CusparseFrontend::Prepare();
+        CusparseFrontend::AddVariableForArguments<cusparseStatus_t>(status);
+        CusparseFrontend::Execute("cusparseGetErrorString");
+        if (!CusparseFrontend::Success()) return false;
+        *value = CusparseFrontend::GetOutputString();
+        return true;
+    });
+    return s != nullptr ? s->c_str() : "unknown error";
 }
\ No newline at end of file
@@ -27,10 +27,13 @@
 
 #include "NvmlHandler.h"
 
+#include "NvmlSampler.h"
+
 using namespace std;
 using namespace log4cplus;
 
 using gvirtus::communicators::Buffer;
+using gvirtus::communicators::LoadReport;
 using gvirtus::communicators::Result;
 
 std::map<string, NvmlHandler::NvmlRoutineHandler>* NvmlHandler::mspHandlers = NULL;
@@ -64,6 +67,12 @@ std::shared_ptr<Result> NvmlHandler::Execute(std::string routine,
     return NULL;
 }
 
+void NvmlHandler::Load(LoadReport* report) {
+    /* a second old at most, as the frontends choose a backend once per process */
+    NvmlSampler::GetInstance().Memory(std::chrono::seconds(1), &report->memoryFree,
+                                      &report->memoryTotal);
+}
+
 void NvmlHandler::Initialize() {
     if (mspHandlers != NULL) return;
     mspHandlers = new map<string, NvmlHandler::NvmlRoutineHandler>();
@@ -100,6 +109,7 @@ void NvmlHandler::Initialize() {
     mspHandlers->insert(NVML_ROUTINE_HANDLER_PAIR(DeviceGetMaxMigDeviceCount));
     mspHandlers->insert(NVML_ROUTINE_HANDLER_PAIR(DeviceIsMigDeviceHandle));
     mspHandlers->insert(NVML_ROUTINE_HANDLER_PAIR(DeviceValidateInforom));
+    mspHandlers->insert(NVML_ROUTINE_HANDLER_PAIR(GetTelemetry));
 
     // Event handling
     mspHandlers->insert(NVML_ROUTINE_HANDLER_PAIR(EventSetCreate));
@@ -50,6 +50,7 @@ class NvmlHandler : public gvirtus::backend::Handler {
     bool CanExecute(std::string routine);
     std::shared_ptr<gvirtus::communicators::Result> Execute(
         std::string routine, std::shared_ptr<gvirtus::communicators::Buffer> input_buffer);
+    void Load(gvirtus::communicators::LoadReport *report);
     log4cplus::Logger &GetLogger() { return logger; }
 
    private:
@@ -97,6 +98,8 @@ NVML_ROUTINE_HANDLER(DeviceGetMigMode);
 NVML_ROUTINE_HANDLER(DeviceGetMaxMigDeviceCount);
 NVML_ROUTINE_HANDLER(DeviceIsMigDeviceHandle);
 NVML_ROUTINE_HANDLER(DeviceValidateInforom);
+// Telemetry record of all devices (NvmlTelemetry.h)
+NVML_ROUTINE_HANDLER(GetTelemetry);
 
 // Event handling
 NVML_ROUTINE_HANDLER(EventSetCreate);
@@ -28,6 +28,8 @@
 
 #include "NvmlHandler.h"
 
+#include "NvmlSampler.h"
+
 using namespace std;
 using namespace log4cplus;
 
@@ -237,4 +239,13 @@ NVML_ROUTINE_HANDLER(DeviceValidateInforom) {
     std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
     LOG4CPLUS_DEBUG(pThis->GetLogger(), "nvmlDeviceValidateInforom executed");
     return std::make_shared<Result>(result, out);
-}
\ No newline at end of file
+}
+
+NVML_ROUTINE_HANDLER(GetTelemetry) {
+    bool withStatic = in->Get<bool>();
+    uint64_t maxAgeUs = in->Get<uint64_t>();
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    NvmlSampler::GetInstance().Snapshot(std::chrono::microseconds(maxAgeUs), withStatic, out.get());
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "nvmlGetTelemetry executed");
+    return std::make_shared<Result>(NVML_SUCCESS, out);
+}
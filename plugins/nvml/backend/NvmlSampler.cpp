@@ -0,0 +1,168 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "NvmlSampler.h"
+
+#include <log4cplus/loggingmacros.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+using namespace std::chrono;
+using namespace log4cplus;
+
+using gvirtus::communicators::Buffer;
+
+NvmlSampler &NvmlSampler::GetInstance() {
+    static NvmlSampler instance;
+    return instance;
+}
+
+NvmlSampler::NvmlSampler()
+    : logger(Logger::getInstance(LOG4CPLUS_TEXT("NvmlSampler"))),
+      mStarted(false),
+      mStop(false),
+      mInterval(100),
+      mVersion(0),
+      mCountResult(NVML_ERROR_UNINITIALIZED) {
+    const char *env = getenv("GVIRTUS_NVML_SAMPLE_INTERVAL_MS");
+    if (env != NULL && *env != '\0') mInterval = milliseconds(max(1L, strtol(env, NULL, 10)));
+}
+
+NvmlSampler::~NvmlSampler() {
+    {
+        lock_guard<mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+    if (mThread.joinable()) mThread.join();
+}
+
+void NvmlSampler::Start() {
+    /* The sampler holds its own reference: clients may shut theirs down. */
+    mCountResult = nvmlInit();
+    if (mCountResult != NVML_SUCCESS) return;
+
+    unsigned int count = 0;
+    mCountResult = nvmlDeviceGetCount(&count);
+    if (mCountResult != NVML_SUCCESS) count = 0;
+    mStatic.resize(count);
+    for (unsigned int i = 0; i < count; i++) {
+        NvmlDeviceStatic &device = mStatic[i];
+        device.handle.result = nvmlDeviceGetHandleByIndex(i, &device.handle.value);
+        device.name.result = device.pci.result = device.handle.result;
+        if (device.handle.result != NVML_SUCCESS) continue;
+        device.name.result =
+            nvmlDeviceGetName(device.handle.value, device.name.value, NVML_TELEMETRY_NAME_SIZE);
+        device.pci.result = nvmlDeviceGetPciInfo_v3(device.handle.value, &device.pci.value);
+    }
+    mStarted = true;
+    mThread = thread(&NvmlSampler::Run, this);
+    LOG4CPLUS_INFO(logger, "Sampling " << count << " devices every " << mInterval.count()
+                                       << " ms");
+}
+
+vector<NvmlDeviceDynamic> NvmlSampler::Sample() {
+    vector<NvmlDeviceDynamic> dynamic(mStatic.size());
+    for (size_t i = 0; i < mStatic.size(); i++) {
+        NvmlDeviceDynamic &sample = dynamic[i];
+        nvmlDevice_t device = mStatic[i].handle.value;
+        if (mStatic[i].handle.result != NVML_SUCCESS) {
+            sample.utilization.result = sample.memory.result = sample.temperature.result =
+                sample.fanSpeed.result = sample.powerUsage.result =
+                    sample.performanceState.result = mStatic[i].handle.result;
+            continue;
+        }
+        sample.utilization.result =
+            nvmlDeviceGetUtilizationRates(device, &sample.utilization.value);
+        sample.memory.result = nvmlDeviceGetMemoryInfo(device, &sample.memory.value);
+        sample.temperature.result =
+            nvmlDeviceGetTemperature(device, NVML_TEMPERATURE_GPU, &sample.temperature.value);
+        sample.fanSpeed.result = nvmlDeviceGetFanSpeed(device, &sample.fanSpeed.value);
+        sample.powerUsage.result = nvmlDeviceGetPowerUsage(device, &sample.powerUsage.value);
+        sample.performanceState.result =
+            nvmlDeviceGetPerformanceState(device, &sample.performanceState.value);
+    }
+    return dynamic;
+}
+
+void NvmlSampler::Publish(vector<NvmlDeviceDynamic> &&dynamic) {
+    mDynamic = std::move(dynamic);
+    mSampled = steady_clock::now();
+    mVersion++;
+}
+
+bool NvmlSampler::Idle() const {
+    steady_clock::duration silence = max<steady_clock::duration>(seconds(1), 2 * mInterval);
+    return steady_clock::now() - mRequested > silence;
+}
+
+void NvmlSampler::Run() {
+    unique_lock<mutex> lock(mMutex);
+    while (!mStop) {
+        if (Idle()) {
+            mWake.wait(lock, [this] { return mStop || !Idle(); });
+            continue;
+        }
+        if (steady_clock::now() - mSampled >= mInterval) {
+            /* mStatic does not change once started: sample without blocking the clients. */
+            lock.unlock();
+            vector<NvmlDeviceDynamic> dynamic = Sample();
+            lock.lock();
+            Publish(std::move(dynamic));
+        }
+        mWake.wait_until(lock, mSampled + mInterval, [this] { return mStop; });
+    }
+}
+
+void NvmlSampler::Refresh(microseconds maxAge) {
+    if (!mStarted) Start();
+    bool idle = Idle();
+    mRequested = steady_clock::now();
+    if (mStarted && (mVersion == 0 || mRequested - mSampled > maxAge)) Publish(Sample());
+    if (idle) mWake.notify_all();
+}
+
+void NvmlSampler::Snapshot(microseconds maxAge, bool withStatic, Buffer *out) {
+    unique_lock<mutex> lock(mMutex);
+    Refresh(maxAge);
+
+    unsigned int count = mStatic.size();
+    out->Add<uint64_t>(mVersion);
+    out->Add<uint64_t>(duration_cast<microseconds>(steady_clock::now() - mSampled).count());
+    out->Add(mCountResult);
+    out->Add(count);
+    if (withStatic) out->Add(mStatic.data(), count);
+    out->Add(mDynamic.data(), mDynamic.size());
+}
+
+void NvmlSampler::Memory(microseconds maxAge, uint64_t *free, uint64_t *total) {
+    unique_lock<mutex> lock(mMutex);
+    Refresh(maxAge);
+    *free = *total = 0;
+    for (auto &device : mDynamic) {
+        if (device.memory.result != NVML_SUCCESS) continue;
+        *free += device.memory.value.free;
+        *total += device.memory.value.total;
+    }
+}
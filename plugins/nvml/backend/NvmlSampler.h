@@ -0,0 +1,81 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef NVMLSAMPLER_H
+#define NVMLSAMPLER_H
+
+#include <gvirtus/communicators/Buffer.h>
+#include <log4cplus/logger.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "NvmlTelemetry.h"
+
+/*
+ * NvmlSampler keeps the telemetry record of all the devices of the backend
+ * (see NvmlTelemetry.h). The static part is read once. A thread refreshes the
+ * dynamic part every GVIRTUS_NVML_SAMPLE_INTERVAL_MS milliseconds (default
+ * 100) while clients ask for it, and sleeps after a second of silence.
+ */
+class NvmlSampler {
+   public:
+    static NvmlSampler &GetInstance();
+
+    /* Adds to out the record, sampled again first if it is older than maxAge. */
+    void Snapshot(std::chrono::microseconds maxAge, bool withStatic,
+                  gvirtus::communicators::Buffer *out);
+
+    /* The device memory free and in all over the devices, as Snapshot samples it. */
+    void Memory(std::chrono::microseconds maxAge, uint64_t *free, uint64_t *total);
+
+   private:
+    NvmlSampler();
+    ~NvmlSampler();
+
+    void Start();
+    /* Samples again if the record is older than maxAge; mMutex is held. */
+    void Refresh(std::chrono::microseconds maxAge);
+    void Run();
+    std::vector<NvmlDeviceDynamic> Sample();
+    void Publish(std::vector<NvmlDeviceDynamic> &&dynamic);
+    bool Idle() const;
+
+    log4cplus::Logger logger;
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::thread mThread;
+    bool mStarted;
+    bool mStop;
+    std::chrono::milliseconds mInterval;
+    std::chrono::steady_clock::time_point mSampled;
+    std::chrono::steady_clock::time_point mRequested;
+    uint64_t mVersion;
+    nvmlReturn_t mCountResult;
+    std::vector<NvmlDeviceStatic> mStatic;
+    std::vector<NvmlDeviceDynamic> mDynamic;
+};
+
+#endif /* NVMLSAMPLER_H */
@@ -27,8 +27,65 @@
 
 #include "NvmlFrontend.h"
 
+#include <atomic>
+#include <cstdlib>
+
+using namespace std;
+
 NvmlFrontend msInstance __attribute_used__;
 
 void* NvmlFrontend::handler = NULL;
+mutex NvmlFrontend::telemetryMutex;
+
+static atomic<int> init_references(0);
+static bool telemetry_unsupported = false;
+static NvmlTelemetryRecord telemetry;
 
 NvmlFrontend::NvmlFrontend() { Frontend::GetFrontend(); }
+
+static chrono::microseconds MaxAge() {
+    static const chrono::microseconds max_age = [] {
+        const char* env = getenv("GVIRTUS_NVML_MAX_AGE_MS");
+        long ms = (env != NULL && *env != '\0') ? strtol(env, NULL, 10) : 100;
+        return chrono::microseconds(max(0L, ms) * 1000);
+    }();
+    return max_age;
+}
+
+void NvmlFrontend::AddInitReference(int delta) { init_references += delta; }
+
+const NvmlTelemetryRecord* NvmlFrontend::GetTelemetry(bool dynamic) {
+    if (init_references <= 0 || telemetry_unsupported || MaxAge().count() == 0) return NULL;
+    bool withStatic = telemetry.version == 0;
+    auto now = chrono::steady_clock::now();
+    if (!withStatic && (!dynamic || now - telemetry.sampled <= MaxAge())) return &telemetry;
+
+    Prepare();
+    AddVariableForArguments<bool>(withStatic);
+    AddVariableForArguments<uint64_t>(MaxAge().count());
+    Execute("nvmlGetTelemetry");
+    if (!Success()) {
+        /* A backend without the sampler: every getter asks it directly. Other failures may pass. */
+        if (GetExitCode() == NVML_ERROR_NOT_SUPPORTED) telemetry_unsupported = true;
+        return NULL;
+    }
+    uint64_t version = GetOutputVariable<uint64_t>();
+    uint64_t ageUs = GetOutputVariable<uint64_t>();
+    nvmlReturn_t countResult = GetOutputVariable<nvmlReturn_t>();
+    unsigned int count = GetOutputVariable<unsigned int>();
+    if (withStatic) {
+        NvmlDeviceStatic* devices = GetOutputHostPointer<NvmlDeviceStatic>(count);
+        telemetry.devices.assign(devices, devices + (devices != NULL ? count : 0));
+    }
+    NvmlDeviceDynamic* dynamicPart = GetOutputHostPointer<NvmlDeviceDynamic>(count);
+    telemetry.dynamic.assign(dynamicPart, dynamicPart + (dynamicPart != NULL ? count : 0));
+    if (telemetry.dynamic.size() != telemetry.devices.size()) {
+        telemetry.version = 0;
+        return NULL;
+    }
+    telemetry.version = version;
+    telemetry.countResult = countResult;
+    /* Measured from the request: the record may look older than it is, never younger. */
+    telemetry.sampled = now - chrono::microseconds(ageUs);
+    return &telemetry;
+}
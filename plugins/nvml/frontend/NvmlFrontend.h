@@ -31,6 +31,12 @@
 #include <gvirtus/frontend/Frontend.h>
 #include <nvml.h>
 
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "NvmlTelemetry.h"
+
 using gvirtus::communicators::Buffer;
 using gvirtus::frontend::Frontend;
 
@@ -39,6 +45,23 @@ typedef struct __configureFunction {
     gvirtus::communicators::Buffer *buffer;
 } configureFunction;
 
+/* The last telemetry record fetched from the backend (see NvmlTelemetry.h). */
+struct NvmlTelemetryRecord {
+    uint64_t version = 0;
+    std::chrono::steady_clock::time_point sampled;
+    nvmlReturn_t countResult = NVML_ERROR_UNINITIALIZED;
+    std::vector<NvmlDeviceStatic> devices;
+    std::vector<NvmlDeviceDynamic> dynamic;
+
+    /* The index of device, -1 if it is not a device of the record (a MIG device...). */
+    int Find(nvmlDevice_t device) const {
+        for (size_t i = 0; i < devices.size(); i++)
+            if (devices[i].handle.result == NVML_SUCCESS && devices[i].handle.value == device)
+                return i;
+        return -1;
+    }
+};
+
 class NvmlFrontend {
    public:
     static inline void Execute(const char *routine, const Buffer *input_buffer = NULL) {
@@ -154,7 +177,34 @@ class NvmlFrontend {
     static inline char *GetOutputString() {
         return Frontend::GetFrontend()->GetOutputBuffer()->AssignString();
     }
+
+    /**
+     * Runs read on the telemetry record of the backend, fetched again first
+     * when the dynamic part is needed and older than GVIRTUS_NVML_MAX_AGE_MS
+     * milliseconds (default 100). The static part is fetched once.
+     *
+     * @param dynamic whether read uses the dynamic part of the record.
+     * @param read returns false when the record cannot answer.
+     *
+     * @return false if the record is not used (NVML not initialized, the
+     * cache disabled with GVIRTUS_NVML_MAX_AGE_MS=0, read returned false):
+     * the caller asks the backend directly.
+     */
+    template <class F>
+    static bool FromTelemetry(bool dynamic, F read) {
+        std::lock_guard<std::mutex> lock(telemetryMutex);
+        const NvmlTelemetryRecord *record = GetTelemetry(dynamic);
+        return record != NULL && read(*record);
+    }
+
+    /* Counts the nvmlInit and nvmlShutdown of the application. */
+    static void AddInitReference(int delta);
+
     NvmlFrontend();
     static void *handler;
+
+   private:
+    static const NvmlTelemetryRecord *GetTelemetry(bool dynamic);
+    static std::mutex telemetryMutex;
 };
 #endif /* NVMLFRONTEND_H */
@@ -27,9 +27,42 @@
 
 #include "NvmlFrontend.h"
 
+#include <type_traits>
+
 using namespace std;
 
+/*
+ * Answers a getter of device with field of the telemetry record, the result
+ * included. False when the record cannot: the getter asks the backend.
+ */
+template <class D, class T>
+static bool FromTelemetry(nvmlDevice_t device, NvmlSample<T> D::*field, T *value,
+                          nvmlReturn_t *result) {
+    constexpr bool dynamic = is_same_v<D, NvmlDeviceDynamic>;
+    if (value == NULL) return false;
+    return NvmlFrontend::FromTelemetry(dynamic, [&](const NvmlTelemetryRecord &record) {
+        int i = record.Find(device);
+        if (i < 0) return false;
+        const NvmlSample<T> *sample;
+        if constexpr (dynamic)
+            sample = &(record.dynamic[i].*field);
+        else
+            sample = &(record.devices[i].*field);
+        *result = sample->result;
+        if (sample->result == NVML_SUCCESS) *value = sample->value;
+        return true;
+    });
+}
+
 extern "C" nvmlReturn_t nvmlDeviceGetCount(unsigned int *deviceCount) {
+    nvmlReturn_t result;
+    if (deviceCount != NULL &&
+        NvmlFrontend::FromTelemetry(false, [&](const NvmlTelemetryRecord &record) {
+            result = record.countResult;
+            if (result == NVML_SUCCESS) *deviceCount = record.devices.size();
+            return true;
+        }))
+        return result;
     NvmlFrontend::Prepare();
     NvmlFrontend::Execute("nvmlDeviceGetCount");
     if (NvmlFrontend::Success()) *deviceCount = NvmlFrontend::GetOutputVariable<unsigned int>();
@@ -37,6 +70,19 @@ extern "C" nvmlReturn_t nvmlDeviceGetCount(unsigned int *deviceCount) {
 }
 
 extern "C" nvmlReturn_t nvmlDeviceGetHandleByIndex(unsigned int index, nvmlDevice_t *device) {
+    nvmlReturn_t result;
+    if (device != NULL &&
+        NvmlFrontend::FromTelemetry(false, [&](const NvmlTelemetryRecord &record) {
+            if (record.countResult != NVML_SUCCESS) return false;
+            if (index >= record.devices.size()) {
+                result = NVML_ERROR_INVALID_ARGUMENT;
+                return true;
+            }
+            result = record.devices[index].handle.result;
+            if (result == NVML_SUCCESS) *device = record.devices[index].handle.value;
+            return true;
+        }))
+        return result;
     NvmlFrontend::Prepare();
     NvmlFrontend::AddVariableForArguments(index);
     NvmlFrontend::AddDevicePointerForArguments(device);
@@ -50,6 +96,10 @@ extern "C" nvmlReturn_t nvmlDeviceGetHandleByIndex(unsigned int index, nvmlDevic
 extern "C" nvmlReturn_t nvmlDeviceGetTemperature(nvmlDevice_t device,
                                                  nvmlTemperatureSensors_t sensorType,
                                                  unsigned int *temp) {
+    nvmlReturn_t result;
+    if (sensorType == NVML_TEMPERATURE_GPU &&
+        FromTelemetry(device, &NvmlDeviceDynamic::temperature, temp, &result))
+        return result;
     NvmlFrontend::Prepare();
     NvmlFrontend::AddHostPointerForArguments(&device);
     NvmlFrontend::AddVariableForArguments(sensorType);
@@ -59,6 +109,12 @@ extern "C" nvmlReturn_t nvmlDeviceGetTemperature(nvmlDevice_t device,
 }
 
 extern "C" nvmlReturn_t nvmlDeviceGetIndex(nvmlDevice_t device, unsigned int *index) {
+    if (index != NULL && NvmlFrontend::FromTelemetry(false, [&](const NvmlTelemetryRecord &record) {
+            int i = record.Find(device);
+            if (i >= 0) *index = i;
+            return i >= 0;
+        }))
+        return NVML_SUCCESS;
     NvmlFrontend::Prepare();
     NvmlFrontend::AddHostPointerForArguments(&device);
     NvmlFrontend::AddHostPointerForArguments(index);
@@ -71,6 +127,21 @@ extern "C" nvmlReturn_t nvmlDeviceGetIndex(nvmlDevice_t device, unsigned int *in
 }
 
 extern "C" nvmlReturn_t nvmlDeviceGetName(nvmlDevice_t device, char *name, unsigned int length) {
+    nvmlReturn_t result;
+    if (name != NULL && NvmlFrontend::FromTelemetry(false, [&](const NvmlTelemetryRecord &record) {
+            int i = record.Find(device);
+            if (i < 0) return false;
+            result = record.devices[i].name.result;
+            if (result != NVML_SUCCESS) return true;
+            const char *cached = record.devices[i].name.value;
+            size_t size = strnlen(cached, NVML_TELEMETRY_NAME_SIZE - 1) + 1;
+            if (length < size)
+                result = NVML_ERROR_INSUFFICIENT_SIZE;
+            else
+                memcpy(name, cached, size);
+            return true;
+        }))
+        return result;
     NvmlFrontend::Prepare();
     NvmlFrontend::AddHostPointerForArguments(&device);
     NvmlFrontend::AddVariableForArguments(length);
@@ -83,6 +154,8 @@ extern "C" nvmlReturn_t nvmlDeviceGetName(nvmlDevice_t device, char *name, unsig
 }
 
 extern "C" nvmlReturn_t nvmlDeviceGetPciInfo_v3(nvmlDevice_t device, nvmlPciInfo_t *pci) {
+    nvmlReturn_t result;
+    if (FromTelemetry(device, &NvmlDeviceStatic::pci, pci, &result)) return result;
     NvmlFrontend::Prepare();
     NvmlFrontend::AddHostPointerForArguments(&device);
     NvmlFrontend::Execute("nvmlDeviceGetPciInfo_v3");
@@ -132,6 +205,8 @@ extern "C" nvmlReturn_t nvmlDeviceGetEccMode(nvmlDevice_t device, nvmlEnableStat
 }
 
 extern "C" nvmlReturn_t nvmlDeviceGetFanSpeed(nvmlDevice_t device, unsigned int *speed) {
+    nvmlReturn_t result;
+    if (FromTelemetry(device, &NvmlDeviceDynamic::fanSpeed, speed, &result)) return result;
     NvmlFrontend::Prepare();
     NvmlFrontend::AddHostPointerForArguments(&device);
     NvmlFrontend::Execute("nvmlDeviceGetFanSpeed");
@@ -140,6 +215,8 @@ extern "C" nvmlReturn_t nvmlDeviceGetFanSpeed(nvmlDevice_t device, unsigned int
 }
 
 extern "C" nvmlReturn_t nvmlDeviceGetPerformanceState(nvmlDevice_t device, nvmlPstates_t *pState) {
+    nvmlReturn_t result;
+    if (FromTelemetry(device, &NvmlDeviceDynamic::performanceState, pState, &result)) return result;
     NvmlFrontend::Prepare();
     NvmlFrontend::AddHostPointerForArguments(&device);
     NvmlFrontend::Execute("nvmlDeviceGetPerformanceState");
@@ -148,6 +225,8 @@ extern "C" nvmlReturn_t nvmlDeviceGetPerformanceState(nvmlDevice_t device, nvmlP
 }
 
 extern "C" nvmlReturn_t nvmlDeviceGetPowerUsage(nvmlDevice_t device, unsigned int *power) {
+    nvmlReturn_t result;
+    if (FromTelemetry(device, &NvmlDeviceDynamic::powerUsage, power, &result)) return result;
     NvmlFrontend::Prepare();
     NvmlFrontend::AddHostPointerForArguments(&device);
     NvmlFrontend::Execute("nvmlDeviceGetPowerUsage");
@@ -165,6 +244,8 @@ extern "C" nvmlReturn_t nvmlDeviceGetEnforcedPowerLimit(nvmlDevice_t device, uns
 
 // TODO: check issues with nvmlDeviceGetMemoryInfo
 extern "C" nvmlReturn_t nvmlDeviceGetMemoryInfo(nvmlDevice_t device, nvmlMemory_t *memory) {
+    nvmlReturn_t result;
+    if (FromTelemetry(device, &NvmlDeviceDynamic::memory, memory, &result)) return result;
     NvmlFrontend::Prepare();
     NvmlFrontend::AddHostPointerForArguments(&device);
     NvmlFrontend::Execute("nvmlDeviceGetMemoryInfo");
@@ -177,6 +258,8 @@ extern "C" nvmlReturn_t nvmlDeviceGetMemoryInfo(nvmlDevice_t device, nvmlMemory_
 
 extern "C" nvmlReturn_t nvmlDeviceGetUtilizationRates(nvmlDevice_t device,
                                                       nvmlUtilization_t *utilization) {
+    nvmlReturn_t result;
+    if (FromTelemetry(device, &NvmlDeviceDynamic::utilization, utilization, &result)) return result;
     NvmlFrontend::Prepare();
     NvmlFrontend::AddHostPointerForArguments(&device);
     NvmlFrontend::Execute("nvmlDeviceGetUtilizationRates");
@@ -25,13 +25,25 @@
  *             angzam78 <angzam78@gmail.com>
  */
 
+#include <gvirtus/frontend/LocalTier.h>
+
+#include <string>
+
 #include "NvmlFrontend.h"
 
 using namespace std;
 
+using gvirtus::frontend::LocalCache;
+
 extern "C" const char* nvmlErrorString(nvmlReturn_t status) {
-    NvmlFrontend::Prepare();
-    NvmlFrontend::AddVariableForArguments<nvmlReturn_t>(status);
-    NvmlFrontend::Execute("nvmlErrorString");
-    return NvmlFrontend::GetOutputString();
+    static LocalCache<int, string> strings;
+    const string* s = strings.Get(status, [status](string* value) {
+        NvmlFrontend::Prepare();
+        NvmlFrontend::AddVariableForArguments<nvmlReturn_t>(status);
+        NvmlFrontend::Execute("nvmlErrorString");
+        if (!NvmlFrontend::Success()) return false;
+        *value = NvmlFrontend::GetOutputString();
+        return true;
+    });
+    return s != nullptr ? s->c_str() : "Unknown Error";
 }
\ No newline at end of file
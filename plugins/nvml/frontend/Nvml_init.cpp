@@ -33,17 +33,20 @@ extern "C" nvmlReturn_t nvmlInitWithFlags(unsigned int flags) {
     NvmlFrontend::Prepare();
     NvmlFrontend::AddVariableForArguments(flags);
     NvmlFrontend::Execute("nvmlInitWithFlags");
+    if (NvmlFrontend::Success()) NvmlFrontend::AddInitReference(1);
     return NvmlFrontend::GetExitCode();
 }
 
 extern "C" nvmlReturn_t nvmlInit(void) {
     NvmlFrontend::Prepare();
     NvmlFrontend::Execute("nvmlInit");
+    if (NvmlFrontend::Success()) NvmlFrontend::AddInitReference(1);
     return NvmlFrontend::GetExitCode();
 }
 
 extern "C" nvmlReturn_t nvmlShutdown(void) {
     NvmlFrontend::Prepare();
     NvmlFrontend::Execute("nvmlShutdown");
+    if (NvmlFrontend::Success()) NvmlFrontend::AddInitReference(-1);
     return NvmlFrontend::GetExitCode();
 }
\ No newline at end of file
@@ -25,27 +25,51 @@
  *             angzam78 <angzam78@gmail.com>
  */
 
+#include <gvirtus/frontend/LocalTier.h>
+
+#include <cstring>
+#include <string>
+
 #include "NvmlFrontend.h"
 
 using namespace std;
 
+using gvirtus::frontend::LocalCache;
+
+/* The versions of the backend's driver do not change: they are asked once per process. */
+
 extern "C" nvmlReturn_t nvmlSystemGetCudaDriverVersion_v2(int* cudaDriverVersion) {
-    NvmlFrontend::Prepare();
-    NvmlFrontend::Execute("nvmlSystemGetCudaDriverVersion_v2");
-    if (NvmlFrontend::Success()) {
-        int* cudaDriverVersion_backend = NvmlFrontend::GetOutputHostPointer<int>();
-        std::memcpy(cudaDriverVersion, cudaDriverVersion_backend, sizeof(int));
-    }
-    return NvmlFrontend::GetExitCode();
+    static LocalCache<int, int> versions;
+    nvmlReturn_t result = NVML_SUCCESS;
+    const int* cached = versions.Get(0, [&](int* value) {
+        NvmlFrontend::Prepare();
+        NvmlFrontend::Execute("nvmlSystemGetCudaDriverVersion_v2");
+        result = NvmlFrontend::GetExitCode();
+        if (!NvmlFrontend::Success()) return false;
+        *value = *NvmlFrontend::GetOutputHostPointer<int>();
+        return true;
+    });
+    if (cached != nullptr) *cudaDriverVersion = *cached;
+    return result;
 }
 
 extern "C" nvmlReturn_t nvmlSystemGetDriverVersion(char* version, unsigned int length) {
-    NvmlFrontend::Prepare();
-    NvmlFrontend::AddVariableForArguments(length);
-    NvmlFrontend::Execute("nvmlSystemGetDriverVersion");
-    if (NvmlFrontend::Success()) {
-        char* version_backend = NvmlFrontend::GetOutputHostPointer<char>();
-        std::memcpy(version, version_backend, length);
-    }
-    return NvmlFrontend::GetExitCode();
+    static LocalCache<int, string> versions;
+    nvmlReturn_t result = NVML_SUCCESS;
+    const string* cached = versions.Get(0, [&](string* value) {
+        unsigned int size = NVML_SYSTEM_DRIVER_VERSION_BUFFER_SIZE;
+        NvmlFrontend::Prepare();
+        NvmlFrontend::AddVariableForArguments(size);
+        NvmlFrontend::Execute("nvmlSystemGetDriverVersion");
+        result = NvmlFrontend::GetExitCode();
+        if (!NvmlFrontend::Success()) return false;
+        char* version_backend = NvmlFrontend::GetOutputHostPointer<char>(size);
+        value->assign(version_backend, strnlen(version_backend, size));
+        return true;
+    });
+    if (cached == nullptr) return result;
+    if (version == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    if (length <= cached->size()) return NVML_ERROR_INSUFFICIENT_SIZE;
+    memcpy(version, cached->c_str(), cached->size() + 1);
+    return NVML_SUCCESS;
 }
\ No newline at end of file
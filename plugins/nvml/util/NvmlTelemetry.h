@@ -0,0 +1,69 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef NVMLTELEMETRY_H
+#define NVMLTELEMETRY_H
+
+#include <nvml.h>
+#include <stdint.h>
+
+/*
+ * The telemetry of the devices of a backend, sampled together by its NVML
+ * sampler and fetched by the frontends with a single nvmlGetTelemetry call:
+ *
+ *   in:  bool withStatic, uint64_t maxAgeUs
+ *   out: uint64_t version, uint64_t ageUs, nvmlReturn_t countResult,
+ *        unsigned int count, [NvmlDeviceStatic[count]], NvmlDeviceDynamic[count]
+ *
+ * The record is at most maxAgeUs old, ageUs old when it is sent. Devices are
+ * in index order. Every value carries the result of the query that read it.
+ */
+
+#ifdef NVML_DEVICE_NAME_V2_BUFFER_SIZE
+#define NVML_TELEMETRY_NAME_SIZE NVML_DEVICE_NAME_V2_BUFFER_SIZE
+#else
+#define NVML_TELEMETRY_NAME_SIZE NVML_DEVICE_NAME_BUFFER_SIZE
+#endif
+
+template <class T>
+struct NvmlSample {
+    nvmlReturn_t result;
+    T value;
+};
+
+/* What does not change while the backend runs. */
+struct NvmlDeviceStatic {
+    NvmlSample<nvmlDevice_t> handle;
+    NvmlSample<char[NVML_TELEMETRY_NAME_SIZE]> name;
+    NvmlSample<nvmlPciInfo_t> pci;
+};
+
+struct NvmlDeviceDynamic {
+    NvmlSample<nvmlUtilization_t> utilization;
+    NvmlSample<nvmlMemory_t> memory;
+    NvmlSample<unsigned int> temperature; /* NVML_TEMPERATURE_GPU */
+    NvmlSample<unsigned int> fanSpeed;
+    NvmlSample<unsigned int> powerUsage;
+    NvmlSample<nvmlPstates_t> performanceState;
+};
+
+#endif /* NVMLTELEMETRY_H */
@@ -0,0 +1,400 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2011  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "NvrtcCompileCache.h"
+
+#include <log4cplus/loggingmacros.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+using namespace std;
+using namespace log4cplus;
+
+namespace fs = std::filesystem;
+
+static const char MAGIC[8] = {'G', 'V', 'N', 'R', 'T', 'C', '1', '\0'};
+
+template <class T>
+static void Put(string &out, T value) {
+    out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+static void Put(string &out, const string &value) {
+    Put<uint64_t>(out, value.size());
+    out.append(value);
+}
+
+/* Reads what Put wrote, failing instead of reading past the end. */
+class Reader {
+   public:
+    Reader(const string &in) : mIn(in), mOffset(0) {}
+
+    template <class T>
+    bool Get(T &value) {
+        if (mIn.size() - mOffset < sizeof(T)) return false;
+        memcpy(&value, mIn.data() + mOffset, sizeof(T));
+        mOffset += sizeof(T);
+        return true;
+    }
+
+    bool Get(string &value) {
+        uint64_t size;
+        if (!Get(size) || mIn.size() - mOffset < size) return false;
+        value.assign(mIn, mOffset, size);
+        mOffset += size;
+        return true;
+    }
+
+   private:
+    const string &mIn;
+    size_t mOffset;
+};
+
+static size_t SizeOf(const string &key, const NvrtcCompileCache::Entry &entry) {
+    size_t size = key.size() + entry.log.size();
+    for (auto &artifact : entry.artifacts) size += artifact.second.size();
+    for (auto &lowered : entry.loweredNames)
+        size += lowered.first.size() + lowered.second.second.size();
+    return size;
+}
+
+NvrtcCompileCache &NvrtcCompileCache::GetInstance() {
+    static NvrtcCompileCache instance;
+    return instance;
+}
+
+NvrtcCompileCache::NvrtcCompileCache()
+    : logger(Logger::getInstance(LOG4CPLUS_TEXT("NvrtcCompileCache"))),
+      mCapacity(128 << 20),
+      mVersion{0, 0},
+      mDiskBytes(0),
+      mBytes(0) {
+    const char *env = getenv("GVIRTUS_NVRTC_CACHE_SIZE_MB");
+    if (env != NULL && *env != '\0') mCapacity = strtoul(env, NULL, 10) << 20;
+    nvrtcVersion(&mVersion[0], &mVersion[1]);
+
+    if ((env = getenv("GVIRTUS_NVRTC_CACHE_DIR")) != NULL)
+        mDirectory = env;
+    else if ((env = getenv("XDG_CACHE_HOME")) != NULL && *env != '\0')
+        mDirectory = fs::path(env) / "gvirtus" / "nvrtc";
+    else if ((env = getenv("HOME")) != NULL && *env != '\0')
+        mDirectory = fs::path(env) / ".cache" / "gvirtus" / "nvrtc";
+    if (mCapacity == 0 || mDirectory.empty()) {
+        mDirectory.clear();
+        return;
+    }
+
+    error_code ec;
+    fs::create_directories(mDirectory, ec);
+    if (ec) {
+        LOG4CPLUS_WARN(logger, "Keeping compilations in memory, " << mDirectory << ": "
+                                                                   << ec.message());
+        mDirectory.clear();
+        return;
+    }
+    for (auto &file : fs::directory_iterator(mDirectory, ec))
+        if (file.path().extension() == ".nvrtc") mDiskBytes += file.file_size(ec);
+    TrimDisk();
+}
+
+nvrtcProgram NvrtcCompileCache::Create(Program &&program) {
+    auto created = make_shared<Program>(std::move(program));
+    nvrtcProgram prog = reinterpret_cast<nvrtcProgram>(created.get());
+    lock_guard<mutex> lock(mMutex);
+    mPrograms.emplace(prog, created);
+    return prog;
+}
+
+shared_ptr<NvrtcCompileCache::Program> NvrtcCompileCache::Find(nvrtcProgram prog) {
+    lock_guard<mutex> lock(mMutex);
+    auto it = mPrograms.find(prog);
+    return it != mPrograms.end() ? it->second : NULL;
+}
+
+nvrtcResult NvrtcCompileCache::Destroy(nvrtcProgram prog) {
+    lock_guard<mutex> lock(mMutex);
+    return mPrograms.erase(prog) > 0 ? NVRTC_SUCCESS : NVRTC_ERROR_INVALID_PROGRAM;
+}
+
+string NvrtcCompileCache::Key(const Program &program, const vector<string> &options) const {
+    string key;
+    Put(key, mVersion[0]);
+    Put(key, mVersion[1]);
+    Put(key, program.source);
+    Put(key, program.named);
+    Put(key, program.name);
+    Put<uint64_t>(key, program.headers.size());
+    for (auto &header : program.headers) {
+        Put(key, header.first);
+        Put(key, header.second);
+    }
+    Put<uint64_t>(key, options.size());
+    for (auto &option : options) Put(key, option);
+    Put<uint64_t>(key, program.expressions.size());
+    for (auto &expression : program.expressions) Put(key, expression);
+    return key;
+}
+
+nvrtcResult NvrtcCompileCache::Compile(Program &program, const vector<string> &options) {
+    string key = Key(program, options);
+    shared_ptr<const Entry> entry;
+    shared_future<shared_ptr<const Entry>> running;
+    promise<shared_ptr<const Entry>> compilation;
+    {
+        lock_guard<mutex> lock(mMutex);
+        entry = Lookup(key);
+        if (entry == NULL) {
+            auto it = mRunning.find(key);
+            if (it != mRunning.end())
+                running = it->second;
+            else
+                mRunning.emplace(key, compilation.get_future().share());
+        }
+    }
+
+    if (running.valid()) {
+        LOG4CPLUS_DEBUG(logger, "Waiting for the same compilation of another client");
+        entry = running.get();
+    } else if (entry == NULL) {
+        bool loaded = false;
+        try {
+            if (!mDirectory.empty()) loaded = (entry = Load(key)) != NULL;
+            if (!loaded) entry = Run(program, options);
+        } catch (...) {
+            {
+                lock_guard<mutex> lock(mMutex);
+                mRunning.erase(key);
+            }
+            compilation.set_exception(current_exception());
+            throw;
+        }
+        /* A failure of NVRTC itself, out of memory..., may not happen again. */
+        bool cacheable = mCapacity > 0 && (entry->result == NVRTC_SUCCESS ||
+                                           entry->result == NVRTC_ERROR_COMPILATION);
+        {
+            lock_guard<mutex> lock(mMutex);
+            if (cacheable) Store(key, entry);
+            mRunning.erase(key);
+        }
+        compilation.set_value(entry);
+        if (cacheable && !loaded && !mDirectory.empty()) Save(key, *entry);
+    }
+    program.compiled = entry;
+    return entry->result;
+}
+
+shared_ptr<const NvrtcCompileCache::Entry> NvrtcCompileCache::Lookup(const string &key) {
+    auto it = mIndex.find(key);
+    if (it == mIndex.end()) return NULL;
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return it->second->second;
+}
+
+void NvrtcCompileCache::Store(const string &key, const shared_ptr<const Entry> &entry) {
+    size_t size = SizeOf(key, *entry);
+    if (size > mCapacity || mIndex.count(key) > 0) return;
+    mEntries.emplace_front(key, entry);
+    mIndex[key] = mEntries.begin();
+    mBytes += size;
+    while (mBytes > mCapacity) {
+        auto &victim = mEntries.back();
+        mBytes -= SizeOf(victim.first, *victim.second);
+        mIndex.erase(victim.first);
+        mEntries.pop_back();
+    }
+}
+
+shared_ptr<const NvrtcCompileCache::Entry> NvrtcCompileCache::Run(
+    const Program &program, const vector<string> &options) const {
+    static const struct {
+        nvrtcResult (*size)(nvrtcProgram, size_t *);
+        nvrtcResult (*get)(nvrtcProgram, char *);
+    } getters[ARTIFACTS] = {{nvrtcGetPTXSize, nvrtcGetPTX},
+                            {nvrtcGetCUBINSize, nvrtcGetCUBIN},
+                            {nvrtcGetLTOIRSize, nvrtcGetLTOIR},
+                            {nvrtcGetOptiXIRSize, nvrtcGetOptiXIR}};
+
+    auto entry = make_shared<Entry>();
+    vector<const char *> headers, includeNames, arguments;
+    for (auto &header : program.headers) {
+        headers.push_back(header.first.c_str());
+        includeNames.push_back(header.second.c_str());
+    }
+    for (auto &option : options) arguments.push_back(option.c_str());
+
+    nvrtcProgram prog;
+    const char *name = program.named ? program.name.c_str() : NULL;
+    entry->result = nvrtcCreateProgram(&prog, program.source.c_str(), name, headers.size(),
+                                       headers.data(), includeNames.data());
+    if (entry->result != NVRTC_SUCCESS) {
+        for (auto &artifact : entry->artifacts) artifact.first = entry->result;
+        return entry;
+    }
+    for (auto &expression : program.expressions)
+        if (entry->result == NVRTC_SUCCESS)
+            entry->result = nvrtcAddNameExpression(prog, expression.c_str());
+    if (entry->result == NVRTC_SUCCESS)
+        entry->result = nvrtcCompileProgram(prog, arguments.size(), arguments.data());
+    LOG4CPLUS_DEBUG(logger, "Compiled " << (program.named ? program.name : "a program") << ": "
+                                        << nvrtcGetErrorString(entry->result));
+
+    size_t size;
+    if (nvrtcGetProgramLogSize(prog, &size) == NVRTC_SUCCESS) {
+        entry->log.resize(size);
+        if (nvrtcGetProgramLog(prog, entry->log.data()) != NVRTC_SUCCESS) entry->log.clear();
+    }
+    for (int i = 0; i < ARTIFACTS; i++) {
+        auto &artifact = entry->artifacts[i];
+        artifact.first = getters[i].size(prog, &size);
+        if (artifact.first != NVRTC_SUCCESS) continue;
+        artifact.second.resize(size);
+        artifact.first = getters[i].get(prog, artifact.second.data());
+        if (artifact.first != NVRTC_SUCCESS) artifact.second.clear();
+    }
+    for (auto &expression : program.expressions) {
+        const char *lowered = NULL;
+        nvrtcResult result = nvrtcGetLoweredName(prog, expression.c_str(), &lowered);
+        entry->loweredNames.emplace_back(
+            expression, make_pair(result, result == NVRTC_SUCCESS && lowered ? lowered : ""));
+    }
+    nvrtcDestroyProgram(&prog);
+    return entry;
+}
+
+fs::path NvrtcCompileCache::PathOf(const string &key) const {
+    /* FNV-1a: the file holds the whole key, a collision is only a miss. */
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : key) hash = (hash ^ c) * 0x100000001b3ULL;
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.nvrtc", (unsigned long long)hash);
+    return mDirectory / name;
+}
+
+shared_ptr<const NvrtcCompileCache::Entry> NvrtcCompileCache::Load(const string &key) {
+    fs::path path = PathOf(key);
+    ifstream file(path, ios::binary);
+    if (!file) return NULL;
+    string in((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+    auto entry = make_shared<Entry>();
+    Reader reader(in);
+    char magic[sizeof(MAGIC)];
+    string stored;
+    uint64_t count = 0;
+    bool valid = reader.Get(magic) && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 reader.Get(stored) && stored == key;
+    if (!valid) return NULL;
+    valid = reader.Get(entry->result) && reader.Get(entry->log);
+    for (auto &artifact : entry->artifacts)
+        valid = valid && reader.Get(artifact.first) && reader.Get(artifact.second);
+    valid = valid && reader.Get(count);
+    for (uint64_t i = 0; valid && i < count; i++) {
+        pair<string, pair<nvrtcResult, string>> lowered;
+        valid = reader.Get(lowered.first) && reader.Get(lowered.second.first) &&
+                reader.Get(lowered.second.second);
+        entry->loweredNames.push_back(std::move(lowered));
+    }
+    error_code ec;
+    if (!valid) {
+        LOG4CPLUS_WARN(logger, "Removing the truncated entry " << path);
+        fs::remove(path, ec);
+        return NULL;
+    }
+    /* The modification time orders the entries for eviction. */
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    LOG4CPLUS_DEBUG(logger, "Loaded " << path);
+    return entry;
+}
+
+void NvrtcCompileCache::Save(const string &key, const Entry &entry) {
+    string out(MAGIC, sizeof(MAGIC));
+    Put(out, key);
+    Put(out, entry.result);
+    Put(out, entry.log);
+    for (auto &artifact : entry.artifacts) {
+        Put(out, artifact.first);
+        Put(out, artifact.second);
+    }
+    Put<uint64_t>(out, entry.loweredNames.size());
+    for (auto &lowered : entry.loweredNames) {
+        Put(out, lowered.first);
+        Put(out, lowered.second.first);
+        Put(out, lowered.second.second);
+    }
+    if (out.size() > mCapacity) return;
+
+    fs::path path = PathOf(key);
+    ostringstream suffix;
+    suffix << ".tmp." << getpid() << "." << this_thread::get_id();
+    fs::path temporary = path;
+    temporary += suffix.str();
+    lock_guard<mutex> lock(mDiskMutex);
+    error_code ec;
+    {
+        ofstream file(temporary, ios::binary | ios::trunc);
+        file.write(out.data(), out.size());
+        file.close();
+        if (!file) {
+            LOG4CPLUS_WARN(logger, "Cannot write " << temporary);
+            fs::remove(temporary, ec);
+            return;
+        }
+    }
+    /* Other backends only ever see whole entries. */
+    fs::rename(temporary, path, ec);
+    if (ec) {
+        LOG4CPLUS_WARN(logger, "Cannot save " << path << ": " << ec.message());
+        fs::remove(temporary, ec);
+        return;
+    }
+    mDiskBytes += out.size();
+    if (mDiskBytes > mCapacity) TrimDisk();
+}
+
+void NvrtcCompileCache::TrimDisk() {
+    if (mDiskBytes <= mCapacity) return;
+    /* Count again: other backends share the directory. */
+    vector<tuple<fs::file_time_type, size_t, fs::path>> files;
+    error_code ec;
+    mDiskBytes = 0;
+    for (auto &file : fs::directory_iterator(mDirectory, ec)) {
+        if (file.path().extension() != ".nvrtc") continue;
+        size_t size = file.file_size(ec);
+        if (ec) continue;
+        files.emplace_back(file.last_write_time(ec), size, file.path());
+        mDiskBytes += size;
+    }
+    sort(files.begin(), files.end());
+    for (auto &file : files) {
+        if (mDiskBytes <= mCapacity) break;
+        if (fs::remove(get<2>(file), ec)) mDiskBytes -= get<1>(file);
+    }
+    LOG4CPLUS_DEBUG(logger, "Trimmed " << mDirectory << " to " << mDiskBytes << " bytes");
+}
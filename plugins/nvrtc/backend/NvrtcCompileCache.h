@@ -0,0 +1,118 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2011  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef NVRTCCOMPILECACHE_H
+#define NVRTCCOMPILECACHE_H
+
+#include <log4cplus/logger.h>
+#include <nvrtc.h>
+
+#include <filesystem>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+ * NvrtcCompileCache holds the programs of the clients and the results of
+ * their compilations. A program is only compiled by NVRTC on a miss: the
+ * result, log, code and lowered names of a compilation are kept under the
+ * hash of everything it depends on (NVRTC version, source, name, headers and
+ * their include names, options, name expressions), and nvrtcGetPTX & co. are
+ * answered from there. The target architecture is one of the options. Files
+ * found through include paths on the backend are assumed not to change.
+ *
+ * Entries are evicted least recently used first beyond
+ * GVIRTUS_NVRTC_CACHE_SIZE_MB megabytes (default 128, 0 disables the cache),
+ * both in memory and in GVIRTUS_NVRTC_CACHE_DIR (default
+ * $XDG_CACHE_HOME/gvirtus/nvrtc or ~/.cache/gvirtus/nvrtc, empty to stay in
+ * memory), which backends share and which outlives them. Compilations of the
+ * same key running at the same time are done once.
+ */
+class NvrtcCompileCache {
+   public:
+    /* What nvrtcGetPTX and the like returned after the compilation. */
+    enum Artifact { PTX, CUBIN, LTOIR, OPTIXIR, ARTIFACTS };
+
+    struct Entry {
+        nvrtcResult result;
+        std::string log;
+        std::pair<nvrtcResult, std::string> artifacts[ARTIFACTS];
+        /* Name expression, result and lowered name. */
+        std::vector<std::pair<std::string, std::pair<nvrtcResult, std::string>>> loweredNames;
+    };
+
+    struct Program {
+        std::string source;
+        bool named;
+        std::string name;
+        std::vector<std::pair<std::string, std::string>> headers;
+        std::vector<std::string> expressions;
+        /* NULL before nvrtcCompileProgram. */
+        std::shared_ptr<const Entry> compiled;
+    };
+
+    static NvrtcCompileCache &GetInstance();
+
+    nvrtcProgram Create(Program &&program);
+    /* NULL if prog is not a live program. */
+    std::shared_ptr<Program> Find(nvrtcProgram prog);
+    nvrtcResult Destroy(nvrtcProgram prog);
+
+    /* Compiles program with options, or finds the result of a compilation alike. */
+    nvrtcResult Compile(Program &program, const std::vector<std::string> &options);
+
+   private:
+    NvrtcCompileCache();
+
+    std::string Key(const Program &program, const std::vector<std::string> &options) const;
+    std::shared_ptr<const Entry> Lookup(const std::string &key);
+    void Store(const std::string &key, const std::shared_ptr<const Entry> &entry);
+    std::shared_ptr<const Entry> Run(const Program &program,
+                                     const std::vector<std::string> &options) const;
+
+    std::filesystem::path PathOf(const std::string &key) const;
+    std::shared_ptr<const Entry> Load(const std::string &key);
+    void Save(const std::string &key, const Entry &entry);
+    void TrimDisk();
+
+    log4cplus::Logger logger;
+    std::mutex mMutex;
+    size_t mCapacity;
+    int mVersion[2];
+    std::filesystem::path mDirectory;
+    /* Guards the files of mDirectory written by this backend and mDiskBytes. */
+    std::mutex mDiskMutex;
+    size_t mDiskBytes;
+    std::unordered_map<nvrtcProgram, std::shared_ptr<Program>> mPrograms;
+    std::unordered_map<std::string, std::shared_future<std::shared_ptr<const Entry>>> mRunning;
+    /* In memory, the most recently used first. */
+    std::list<std::pair<std::string, std::shared_ptr<const Entry>>> mEntries;
+    std::unordered_map<std::string, decltype(mEntries)::iterator> mIndex;
+    size_t mBytes;
+};
+
+#endif /* NVRTCCOMPILECACHE_H */
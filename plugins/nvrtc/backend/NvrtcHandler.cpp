@@ -68,4 +68,17 @@ void NvrtcHandler::Initialize() {
     mspHandlers = new map<string, NvrtcHandler::NvrtcRoutineHandler>();
 
     mspHandlers->insert(NVRTC_ROUTINE_HANDLER_PAIR(GetErrorString));
+    mspHandlers->insert(NVRTC_ROUTINE_HANDLER_PAIR(Version));
+
+    mspHandlers->insert(NVRTC_ROUTINE_HANDLER_PAIR(CreateProgram));
+    mspHandlers->insert(NVRTC_ROUTINE_HANDLER_PAIR(DestroyProgram));
+    mspHandlers->insert(NVRTC_ROUTINE_HANDLER_PAIR(AddNameExpression));
+    mspHandlers->insert(NVRTC_ROUTINE_HANDLER_PAIR(CompileProgram));
+    mspHandlers->insert(NVRTC_ROUTINE_HANDLER_PAIR(GetPTX));
+    mspHandlers->insert(NVRTC_ROUTINE_HANDLER_PAIR(GetCUBIN));
+    mspHandlers->insert(NVRTC_ROUTINE_HANDLER_PAIR(GetLTOIR));
+    mspHandlers->insert(NVRTC_ROUTINE_HANDLER_PAIR(GetNVVM));
+    mspHandlers->insert(NVRTC_ROUTINE_HANDLER_PAIR(GetOptiXIR));
+    mspHandlers->insert(NVRTC_ROUTINE_HANDLER_PAIR(GetProgramLog));
+    mspHandlers->insert(NVRTC_ROUTINE_HANDLER_PAIR(GetLoweredName));
 }
\ No newline at end of file
@@ -63,5 +63,18 @@ class NvrtcHandler : public gvirtus::backend::Handler {
 #define NVRTC_ROUTINE_HANDLER_PAIR(name) make_pair("nvrtc" #name, handle##name)
 
 NVRTC_ROUTINE_HANDLER(GetErrorString);
+NVRTC_ROUTINE_HANDLER(Version);
+
+NVRTC_ROUTINE_HANDLER(CreateProgram);
+NVRTC_ROUTINE_HANDLER(DestroyProgram);
+NVRTC_ROUTINE_HANDLER(AddNameExpression);
+NVRTC_ROUTINE_HANDLER(CompileProgram);
+NVRTC_ROUTINE_HANDLER(GetPTX);
+NVRTC_ROUTINE_HANDLER(GetCUBIN);
+NVRTC_ROUTINE_HANDLER(GetLTOIR);
+NVRTC_ROUTINE_HANDLER(GetNVVM);
+NVRTC_ROUTINE_HANDLER(GetOptiXIR);
+NVRTC_ROUTINE_HANDLER(GetProgramLog);
+NVRTC_ROUTINE_HANDLER(GetLoweredName);
 
 #endif /* NVRTCHANDLER_H */
@@ -24,6 +24,9 @@
  *
  */
 
+#include <algorithm>
+
+#include "NvrtcCompileCache.h"
 #include "NvrtcHandler.h"
 
 using namespace std;
@@ -31,3 +34,106 @@ using namespace log4cplus;
 
 using gvirtus::communicators::Buffer;
 using gvirtus::communicators::Result;
+
+/* Strings are sent as host pointers: NULL stays NULL. */
+static bool GetString(std::shared_ptr<Buffer> in, std::string *s) {
+    const char *sent = in->AssignAll<char>();
+    if (sent != NULL) s->assign(sent);
+    return sent != NULL;
+}
+
+static std::shared_ptr<Result> GetArtifact(std::shared_ptr<Buffer> in,
+                                           NvrtcCompileCache::Artifact artifact) {
+    auto program = NvrtcCompileCache::GetInstance().Find((nvrtcProgram)in->Get<uint64_t>());
+    if (program == NULL) return std::make_shared<Result>(NVRTC_ERROR_INVALID_PROGRAM);
+    if (program->compiled == NULL) return std::make_shared<Result>(NVRTC_ERROR_INVALID_PROGRAM);
+    auto &code = program->compiled->artifacts[artifact];
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    out->Add<size_t>(code.second.size());
+    out->Add(code.second.data(), code.second.size());
+    return std::make_shared<Result>(code.first, out);
+}
+
+NVRTC_ROUTINE_HANDLER(CreateProgram) {
+    NvrtcCompileCache::Program program;
+    bool valid = GetString(in, &program.source);
+    program.named = GetString(in, &program.name);
+    int numHeaders = in->Get<int>();
+    valid = valid && numHeaders >= 0;
+    for (int i = 0; valid && i < numHeaders; i++) {
+        std::pair<std::string, std::string> header;
+        valid = GetString(in, &header.first) && GetString(in, &header.second);
+        program.headers.push_back(std::move(header));
+    }
+    if (!valid) return std::make_shared<Result>(NVRTC_ERROR_INVALID_INPUT);
+    nvrtcProgram prog = NvrtcCompileCache::GetInstance().Create(std::move(program));
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    out->Add<uint64_t>((uint64_t)prog);
+    return std::make_shared<Result>(NVRTC_SUCCESS, out);
+}
+
+NVRTC_ROUTINE_HANDLER(DestroyProgram) {
+    return std::make_shared<Result>(
+        NvrtcCompileCache::GetInstance().Destroy((nvrtcProgram)in->Get<uint64_t>()));
+}
+
+NVRTC_ROUTINE_HANDLER(AddNameExpression) {
+    auto program = NvrtcCompileCache::GetInstance().Find((nvrtcProgram)in->Get<uint64_t>());
+    if (program == NULL) return std::make_shared<Result>(NVRTC_ERROR_INVALID_PROGRAM);
+    if (program->compiled != NULL)
+        return std::make_shared<Result>(NVRTC_ERROR_NO_NAME_EXPRESSIONS_AFTER_COMPILATION);
+    std::string expression;
+    if (!GetString(in, &expression)) return std::make_shared<Result>(NVRTC_ERROR_INVALID_INPUT);
+    program->expressions.push_back(expression);
+    return std::make_shared<Result>(NVRTC_SUCCESS);
+}
+
+NVRTC_ROUTINE_HANDLER(CompileProgram) {
+    auto program = NvrtcCompileCache::GetInstance().Find((nvrtcProgram)in->Get<uint64_t>());
+    if (program == NULL) return std::make_shared<Result>(NVRTC_ERROR_INVALID_PROGRAM);
+    int numOptions = in->Get<int>();
+    std::vector<std::string> options(std::max(numOptions, 0));
+    for (auto &option : options)
+        if (!GetString(in, &option)) return std::make_shared<Result>(NVRTC_ERROR_INVALID_INPUT);
+    nvrtcResult result = NvrtcCompileCache::GetInstance().Compile(*program, options);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(), "nvrtcCompileProgram Executed");
+    return std::make_shared<Result>(result);
+}
+
+NVRTC_ROUTINE_HANDLER(GetPTX) { return GetArtifact(in, NvrtcCompileCache::PTX); }
+
+NVRTC_ROUTINE_HANDLER(GetCUBIN) { return GetArtifact(in, NvrtcCompileCache::CUBIN); }
+
+NVRTC_ROUTINE_HANDLER(GetLTOIR) { return GetArtifact(in, NvrtcCompileCache::LTOIR); }
+
+/* NVVM is the LTO IR since CUDA 12. */
+NVRTC_ROUTINE_HANDLER(GetNVVM) { return GetArtifact(in, NvrtcCompileCache::LTOIR); }
+
+NVRTC_ROUTINE_HANDLER(GetOptiXIR) { return GetArtifact(in, NvrtcCompileCache::OPTIXIR); }
+
+NVRTC_ROUTINE_HANDLER(GetProgramLog) {
+    auto program = NvrtcCompileCache::GetInstance().Find((nvrtcProgram)in->Get<uint64_t>());
+    if (program == NULL) return std::make_shared<Result>(NVRTC_ERROR_INVALID_PROGRAM);
+    /* Nothing compiled yet: an empty log. */
+    std::string log = program->compiled != NULL ? program->compiled->log : std::string(1, '\0');
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    out->Add<size_t>(log.size());
+    out->Add(log.data(), log.size());
+    return std::make_shared<Result>(NVRTC_SUCCESS, out);
+}
+
+NVRTC_ROUTINE_HANDLER(GetLoweredName) {
+    auto program = NvrtcCompileCache::GetInstance().Find((nvrtcProgram)in->Get<uint64_t>());
+    if (program == NULL) return std::make_shared<Result>(NVRTC_ERROR_INVALID_PROGRAM);
+    if (program->compiled == NULL)
+        return std::make_shared<Result>(NVRTC_ERROR_NO_LOWERED_NAMES_BEFORE_COMPILATION);
+    std::string expression;
+    if (!GetString(in, &expression)) return std::make_shared<Result>(NVRTC_ERROR_INVALID_INPUT);
+    for (auto &lowered : program->compiled->loweredNames) {
+        if (lowered.first != expression) continue;
+        std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+        out->AddString(lowered.second.second.c_str());
+        return std::make_shared<Result>(lowered.second.first, out);
+    }
+    return std::make_shared<Result>(NVRTC_ERROR_NAME_EXPRESSION_NOT_VALID);
+}
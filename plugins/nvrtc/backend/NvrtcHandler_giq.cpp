@@ -31,3 +31,14 @@ using namespace log4cplus;
 
 using gvirtus::communicators::Buffer;
 using gvirtus::communicators::Result;
+
+NVRTC_ROUTINE_HANDLER(Version) {
+    int major = 0, minor = 0;
+    nvrtcResult exit_code = nvrtcVersion(&major, &minor);
+    std::shared_ptr<Buffer> out = std::make_shared<Buffer>();
+    out->Add(major);
+    out->Add(minor);
+    LOG4CPLUS_DEBUG(pThis->GetLogger(),
+                    "nvrtcVersion Executed, version: " << major << "." << minor);
+    return std::make_shared<Result>(exit_code, out);
+}
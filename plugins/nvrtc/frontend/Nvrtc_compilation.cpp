@@ -24,6 +24,9 @@
  *
  */
 
+#include <cstring>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 
 #include "NvrtcFrontend.h"
@@ -40,26 +43,79 @@ typedef struct CallbackEntry {
 // The map: prog -> callback + payload
 static std::unordered_map<nvrtcProgram, CallbackEntry> callbackRegistry;
 
-extern "C" nvrtcResult nvrtcResultnvrtcAddNameExpression(nvrtcProgram prog,
-                                                         const char *const name_expression) {
-    cout << "nvrtcAddNameExpression called with prog: " << prog
-         << ", name_expression: " << (name_expression ? name_expression : "NULL") << endl;
+/*
+ * What the backend answered about a compiled program: nvrtcGet*Size and
+ * nvrtcGet* are served by a single call, and lowered names must outlive it.
+ */
+struct ProgramOutputs {
+    unordered_map<string, string> outputs;
+    unordered_map<string, string> loweredNames;
+};
+
+static mutex outputs_mutex;
+static unordered_map<nvrtcProgram, ProgramOutputs> program_outputs;
+
+static void ForgetOutputs(nvrtcProgram prog) {
+    lock_guard<mutex> lock(outputs_mutex);
+    program_outputs.erase(prog);
+}
+
+static void AddNullableString(const char *s) {
+    NvrtcFrontend::AddHostPointerForArguments(s, s != NULL ? strlen(s) + 1 : 0);
+}
+
+/* Runs routine, one of nvrtcGetPTX & co., once per compilation of prog. */
+static nvrtcResult GetOutput(nvrtcProgram prog, const char *routine, const string **output) {
+    lock_guard<mutex> lock(outputs_mutex);
+    auto &outputs = program_outputs[prog].outputs;
+    auto it = outputs.find(routine);
+    if (it == outputs.end()) {
+        NvrtcFrontend::Prepare();
+        NvrtcFrontend::AddDevicePointerForArguments(prog);
+        NvrtcFrontend::Execute(routine);
+        if (!NvrtcFrontend::Success()) return NvrtcFrontend::GetExitCode();
+        size_t size = NvrtcFrontend::GetOutputVariable<size_t>();
+        char *bytes = NvrtcFrontend::GetOutputHostPointer<char>(size);
+        it = outputs.emplace(routine, string(bytes != NULL ? bytes : "", size)).first;
+    }
+    *output = &it->second;
+    return NVRTC_SUCCESS;
+}
+
+static nvrtcResult GetOutputSize(nvrtcProgram prog, const char *routine, size_t *sizeRet) {
+    if (sizeRet == NULL) return NVRTC_ERROR_INVALID_INPUT;
+    const string *output;
+    nvrtcResult result = GetOutput(prog, routine, &output);
+    if (result == NVRTC_SUCCESS) *sizeRet = output->size();
+    return result;
+}
+
+static nvrtcResult CopyOutput(nvrtcProgram prog, const char *routine, char *buffer) {
+    if (buffer == NULL) return NVRTC_ERROR_INVALID_INPUT;
+    const string *output;
+    nvrtcResult result = GetOutput(prog, routine, &output);
+    if (result == NVRTC_SUCCESS) memcpy(buffer, output->data(), output->size());
+    return result;
+}
+
+extern "C" nvrtcResult nvrtcAddNameExpression(nvrtcProgram prog,
+                                              const char *const name_expression) {
     NvrtcFrontend::Prepare();
     NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddStringForArguments(name_expression);
+    AddNullableString(name_expression);
     NvrtcFrontend::Execute("nvrtcAddNameExpression");
     return NvrtcFrontend::GetExitCode();
 }
 
 extern "C" nvrtcResult nvrtcCompileProgram(nvrtcProgram prog, int numOptions,
                                            const char *const *options) {
-    cout << "nvrtcCompileProgram called with prog: " << prog << ", numOptions: " << numOptions
-         << ", options: " << (options ? "provided" : "NULL") << endl;
+    if (numOptions < 0 || (numOptions > 0 && options == NULL)) return NVRTC_ERROR_INVALID_INPUT;
+    ForgetOutputs(prog);
     NvrtcFrontend::Prepare();
     NvrtcFrontend::AddDevicePointerForArguments(prog);
     NvrtcFrontend::AddVariableForArguments(numOptions);
     for (int i = 0; i < numOptions; ++i) {
-        NvrtcFrontend::AddStringForArguments(options[i]);
+        AddNullableString(options[i]);
     }
     NvrtcFrontend::Execute("nvrtcCompileProgram");
     return NvrtcFrontend::GetExitCode();
@@ -68,170 +124,107 @@ extern "C" nvrtcResult nvrtcCompileProgram(nvrtcProgram prog, int numOptions,
 extern "C" nvrtcResult nvrtcCreateProgram(nvrtcProgram *prog, const char *src, const char *name,
                                           int numHeaders, const char *const *headers,
                                           const char *const *includeNames) {
-    cout << "nvrtcCreateProgram called with prog: " << (prog ? *prog : nullptr)
-         << ", src: " << (src ? src : "NULL") << ", name: " << (name ? name : "NULL")
-         << ", numHeaders: " << numHeaders << ", headers: " << (headers ? "provided" : "NULL")
-         << ", includeNames: " << (includeNames ? "provided" : "NULL") << endl;
+    if (prog == NULL || numHeaders < 0 ||
+        (numHeaders > 0 && (headers == NULL || includeNames == NULL)))
+        return NVRTC_ERROR_INVALID_INPUT;
     NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddStringForArguments(src);
-    NvrtcFrontend::AddStringForArguments(name);
+    AddNullableString(src);
+    AddNullableString(name);
     NvrtcFrontend::AddVariableForArguments(numHeaders);
     for (int i = 0; i < numHeaders; ++i) {
-        NvrtcFrontend::AddStringForArguments(headers[i]);
-        NvrtcFrontend::AddStringForArguments(includeNames[i]);
+        AddNullableString(headers[i]);
+        AddNullableString(includeNames[i]);
     }
     NvrtcFrontend::Execute("nvrtcCreateProgram");
+    if (NvrtcFrontend::Success()) {
+        *prog = (nvrtcProgram)NvrtcFrontend::GetOutputDevicePointer();
+        ForgetOutputs(*prog);
+    }
     return NvrtcFrontend::GetExitCode();
 }
 
 extern "C" nvrtcResult nvrtcDestroyProgram(nvrtcProgram *prog) {
-    cout << "nvrtcDestroyProgram called with prog: " << (prog ? *prog : nullptr) << endl;
+    if (prog == NULL) return NVRTC_ERROR_INVALID_INPUT;
     NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
+    NvrtcFrontend::AddDevicePointerForArguments(*prog);
     NvrtcFrontend::Execute("nvrtcDestroyProgram");
+    if (NvrtcFrontend::Success()) {
+        ForgetOutputs(*prog);
+        callbackRegistry.erase(*prog);
+        *prog = NULL;
+    }
     return NvrtcFrontend::GetExitCode();
 }
 
 extern "C" nvrtcResult nvrtcGetCUBIN(nvrtcProgram prog, char *cubin) {
-    cout << "nvrtcGetCUBIN called with prog: " << prog
-         << ", cubin: " << (cubin ? "provided" : "NULL") << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddHostPointerForArguments(cubin);
-    NvrtcFrontend::Execute("nvrtcGetCUBIN");
-    return NvrtcFrontend::GetExitCode();
+    return CopyOutput(prog, "nvrtcGetCUBIN", cubin);
 }
 
 extern "C" nvrtcResult nvrtcGetCUBINSize(nvrtcProgram prog, size_t *cubinSizeRet) {
-    cout << "nvrtcGetCUBINSize called with prog: " << prog
-         << ", cubinSizeRet: " << (cubinSizeRet ? "provided" : "NULL") << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddHostPointerForArguments(cubinSizeRet);
-    NvrtcFrontend::Execute("nvrtcGetCUBINSize");
-    return NvrtcFrontend::GetExitCode();
+    return GetOutputSize(prog, "nvrtcGetCUBIN", cubinSizeRet);
 }
 
 extern "C" nvrtcResult nvrtcGetLTOIR(nvrtcProgram prog, char *LTOIR) {
-    cout << "nvrtcGetLTOIR called with prog: " << prog
-         << ", LTOIR: " << (LTOIR ? "provided" : "NULL") << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddHostPointerForArguments(LTOIR);
-    NvrtcFrontend::Execute("nvrtcGetLTOIR");
-    return NvrtcFrontend::GetExitCode();
+    return CopyOutput(prog, "nvrtcGetLTOIR", LTOIR);
 }
 
 extern "C" nvrtcResult nvrtcGetLTOIRSize(nvrtcProgram prog, size_t *LTOIRSizeRet) {
-    cout << "nvrtcGetLTOIRSize called with prog: " << prog
-         << ", LTOIRSizeRet: " << (LTOIRSizeRet ? "provided" : "NULL") << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddHostPointerForArguments(LTOIRSizeRet);
-    NvrtcFrontend::Execute("nvrtcGetLTOIRSize");
-    return NvrtcFrontend::GetExitCode();
+    return GetOutputSize(prog, "nvrtcGetLTOIR", LTOIRSizeRet);
 }
 
 extern "C" nvrtcResult nvrtcGetLoweredName(nvrtcProgram prog, const char *const name_expression,
                                            const char **lowered_name) {
-    cout << "nvrtcGetLoweredName called with prog: " << prog
-         << ", name_expression: " << (name_expression ? name_expression : "NULL")
-         << ", lowered_name: " << (lowered_name ? "provided" : "NULL") << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddStringForArguments(name_expression);
-    NvrtcFrontend::AddHostPointerForArguments(lowered_name);
-    NvrtcFrontend::Execute("nvrtcGetLoweredName");
-    return NvrtcFrontend::GetExitCode();
+    if (name_expression == NULL || lowered_name == NULL) return NVRTC_ERROR_INVALID_INPUT;
+    lock_guard<mutex> lock(outputs_mutex);
+    auto &loweredNames = program_outputs[prog].loweredNames;
+    auto it = loweredNames.find(name_expression);
+    if (it == loweredNames.end()) {
+        NvrtcFrontend::Prepare();
+        NvrtcFrontend::AddDevicePointerForArguments(prog);
+        AddNullableString(name_expression);
+        NvrtcFrontend::Execute("nvrtcGetLoweredName");
+        if (!NvrtcFrontend::Success()) return NvrtcFrontend::GetExitCode();
+        it = loweredNames.emplace(name_expression, NvrtcFrontend::GetOutputString()).first;
+    }
+    /* Valid until the program is destroyed, as with NVRTC. */
+    *lowered_name = it->second.c_str();
+    return NVRTC_SUCCESS;
 }
 
 extern "C" nvrtcResult nvrtcGetNVVM(nvrtcProgram prog, char *nvvm) {
-    cout << "nvrtcGetNVVM called with prog: " << prog << ", nvvm: " << (nvvm ? "provided" : "NULL")
-         << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddHostPointerForArguments(nvvm);
-    NvrtcFrontend::Execute("nvrtcGetNVVM");
-    return NvrtcFrontend::GetExitCode();
+    return CopyOutput(prog, "nvrtcGetNVVM", nvvm);
 }
 
 extern "C" nvrtcResult nvrtcGetNVVMSize(nvrtcProgram prog, size_t *nvvmSizeRet) {
-    cout << "nvrtcGetNVVMSize called with prog: " << prog
-         << ", nvvmSizeRet: " << (nvvmSizeRet ? "provided" : "NULL") << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddHostPointerForArguments(nvvmSizeRet);
-    NvrtcFrontend::Execute("nvrtcGetNVVMSize");
-    return NvrtcFrontend::GetExitCode();
+    return GetOutputSize(prog, "nvrtcGetNVVM", nvvmSizeRet);
 }
 
 extern "C" nvrtcResult nvrtcGetOptiXIR(nvrtcProgram prog, char *optixir) {
-    cout << "nvrtcGetOptiXIR called with prog: " << prog
-         << ", optixir: " << (optixir ? "provided" : "NULL") << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddHostPointerForArguments(optixir);
-    NvrtcFrontend::Execute("nvrtcGetOptiXIR");
-    return NvrtcFrontend::GetExitCode();
+    return CopyOutput(prog, "nvrtcGetOptiXIR", optixir);
 }
 
 extern "C" nvrtcResult nvrtcGetOptiXIRSize(nvrtcProgram prog, size_t *optixirSizeRet) {
-    cout << "nvrtcGetOptiXIRSize called with prog: " << prog
-         << ", optixirSizeRet: " << (optixirSizeRet ? "provided" : "NULL") << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddHostPointerForArguments(optixirSizeRet);
-    NvrtcFrontend::Execute("nvrtcGetOptiXIRSize");
-    return NvrtcFrontend::GetExitCode();
+    return GetOutputSize(prog, "nvrtcGetOptiXIR", optixirSizeRet);
 }
 
 extern "C" nvrtcResult nvrtcGetPTX(nvrtcProgram prog, char *ptx) {
-    cout << "nvrtcGetPTX called with prog: " << prog << ", ptx: " << (ptx ? "provided" : "NULL")
-         << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddHostPointerForArguments(ptx);
-    NvrtcFrontend::Execute("nvrtcGetPTX");
-    return NvrtcFrontend::GetExitCode();
+    return CopyOutput(prog, "nvrtcGetPTX", ptx);
 }
 
 extern "C" nvrtcResult nvrtcGetPTXSize(nvrtcProgram prog, size_t *ptxSizeRet) {
-    cout << "nvrtcGetPTXSize called with prog: " << prog
-         << ", ptxSizeRet: " << (ptxSizeRet ? "provided" : "NULL") << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddHostPointerForArguments(ptxSizeRet);
-    NvrtcFrontend::Execute("nvrtcGetPTXSize");
-    return NvrtcFrontend::GetExitCode();
+    return GetOutputSize(prog, "nvrtcGetPTX", ptxSizeRet);
 }
 
 extern "C" nvrtcResult nvrtcGetProgramLog(nvrtcProgram prog, char *log) {
-    cout << "nvrtcGetProgramLog called with prog: " << prog
-         << ", log: " << (log ? "provided" : "NULL") << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddHostPointerForArguments(log);
-    NvrtcFrontend::Execute("nvrtcGetProgramLog");
-    return NvrtcFrontend::GetExitCode();
+    return CopyOutput(prog, "nvrtcGetProgramLog", log);
 }
 
 extern "C" nvrtcResult nvrtcGetProgramLogSize(nvrtcProgram prog, size_t *logSizeRet) {
-    cout << "nvrtcGetProgramLogSize called with prog: " << prog
-         << ", logSizeRet: " << (logSizeRet ? "provided" : "NULL") << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddDevicePointerForArguments(prog);
-    NvrtcFrontend::AddHostPointerForArguments(logSizeRet);
-    NvrtcFrontend::Execute("nvrtcGetProgramLogSize");
-    return NvrtcFrontend::GetExitCode();
+    return GetOutputSize(prog, "nvrtcGetProgramLog", logSizeRet);
 }
 
 extern "C" nvrtcResult nvrtcSetFlowCallback(nvrtcProgram prog, int (*callback)(void *, void *),
                                             void *payload) {
-    cout << "nvrtcSetFlowCallback called with prog: " << prog
-         << ", callback: " << (callback ? "provided" : "NULL")
-         << ", payload: " << (payload ? "provided" : "NULL") << endl;
-
     callbackRegistry[prog] = {callback, payload};
     return NVRTC_SUCCESS;
-}
\ No newline at end of file
+}
@@ -48,14 +48,29 @@
  *
  */
 
+#include <gvirtus/frontend/LocalTier.h>
+
+#include <string>
+
 #include "NvrtcFrontend.h"
+#include "NvrtcResultNames.h"
 
 using namespace std;
 
+using gvirtus::frontend::FindEnumName;
+using gvirtus::frontend::LocalCache;
+
 extern "C" const char* nvrtcGetErrorString(nvrtcResult status) {
-    cout << "nvrtcGetErrorString called with status: " << status << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddVariableForArguments<nvrtcResult>(status);
-    NvrtcFrontend::Execute("nvrtcGetErrorString");
-    return NvrtcFrontend::GetOutputString();
+    static LocalCache<int, string> strings;
+    const char* name = FindEnumName(NVRTC_RESULT_NAMES, status);
+    if (name != nullptr) return name;
+    const string* s = strings.Get(status, [status](string* value) {
+        NvrtcFrontend::Prepare();
+        NvrtcFrontend::AddVariableForArguments<nvrtcResult>(status);
+        NvrtcFrontend::Execute("nvrtcGetErrorString");
+        if (!NvrtcFrontend::Success()) return false;
+        *value = NvrtcFrontend::GetOutputString();
+        return true;
+    });
+    return s != nullptr ? s->c_str() : "NVRTC_ERROR unknown";
 }
\ No newline at end of file
@@ -24,10 +24,16 @@
  *
  */
 
+#include <gvirtus/frontend/LocalTier.h>
+
+#include <utility>
+
 #include "NvrtcFrontend.h"
 
 using namespace std;
 
+using gvirtus::frontend::LocalCache;
+
 extern "C" nvrtcResult nvrtcGetNumSupportedArchs(int *numArchs) {
     // cerr << "nvrtcGetNumSupportedArchs called with numArchs: " << (numArchs ? *numArchs : 0) <<
     // endl;
@@ -47,11 +53,20 @@ extern "C" nvrtcResult nvrtcGetSupportedArchs(int *supportedArchs) {
 }
 
 extern "C" nvrtcResult nvrtcVersion(int *major, int *minor) {
-    // cerr << "nvrtcVersion called with major: " << (major ? *major : 0)
-    //      << ", minor: " << (minor ? *minor : 0) << endl;
-    NvrtcFrontend::Prepare();
-    NvrtcFrontend::AddHostPointerForArguments(major);
-    NvrtcFrontend::AddHostPointerForArguments(minor);
-    NvrtcFrontend::Execute("nvrtcVersion");
-    return NvrtcFrontend::GetExitCode();
+    // the version of the backend's NVRTC, asked once per process
+    static LocalCache<int, pair<int, int>> versions;
+    nvrtcResult exit_code = NVRTC_SUCCESS;
+    const pair<int, int> *version = versions.Get(0, [&](pair<int, int> *value) {
+        NvrtcFrontend::Prepare();
+        NvrtcFrontend::Execute("nvrtcVersion");
+        exit_code = NvrtcFrontend::GetExitCode();
+        if (!NvrtcFrontend::Success()) return false;
+        value->first = NvrtcFrontend::GetOutputVariable<int>();
+        value->second = NvrtcFrontend::GetOutputVariable<int>();
+        return true;
+    });
+    if (version == nullptr) return exit_code;
+    *major = version->first;
+    *minor = version->second;
+    return NVRTC_SUCCESS;
 }
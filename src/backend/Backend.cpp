@@ -68,7 +68,8 @@ Backend::Backend(const fs::path &path) {
             _children.push_back(std::make_unique<Process>(
                 communicators::CommunicatorFactory::get_communicator(
                     communicators::EndpointFactory::get_endpoint(path), _properties.secure()),
-                _properties.plugins().at(i)));
+                _properties.plugins().at(i), _properties.scheduler(), _properties.shards(),
+                _properties.placement()));
         }
         /*
         for (int i = 0; i < _properties.endpoints(); i++) {
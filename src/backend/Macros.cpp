@@ -0,0 +1,111 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gvirtus/backend/Macros.h>
+#include <gvirtus/communicators/MacroDelta.h>
+
+#include "log4cplus/loggingmacros.h"
+
+using gvirtus::backend::Macros;
+using gvirtus::communicators::Buffer;
+using gvirtus::communicators::MacroDelta;
+using gvirtus::communicators::Result;
+
+Macros::Macros() { logger = log4cplus::Logger::getInstance(LOG4CPLUS_TEXT("Macros")); }
+
+bool Macros::Handles(const std::string &routine) { return routine.rfind("gvirtusMacro", 0) == 0; }
+
+std::shared_ptr<Result> Macros::Execute(const std::string &routine,
+                                        std::shared_ptr<Buffer> input_buffer,
+                                        const Dispatch &dispatch) {
+    try {
+        if (routine == "gvirtusMacroDefine") return Define(input_buffer.get());
+        if (routine == "gvirtusMacroReplay") return Replay(input_buffer.get(), dispatch);
+        if (routine == "gvirtusMacroForget") {
+            mMacros.erase(input_buffer->Get<uint64_t>());
+            return std::make_shared<Result>(0);
+        }
+    } catch (const std::exception &e) {
+        LOG4CPLUS_ERROR(logger, routine << ": " << e.what());
+    }
+    return std::make_shared<Result>(-1);
+}
+
+std::shared_ptr<Result> Macros::Define(Buffer *in) {
+    uint64_t id = in->Get<uint64_t>();
+    size_t count = in->Get<size_t>();
+    std::vector<Call> calls(count);
+    for (auto &call : calls) {
+        call.routine = in->AssignString();
+        size_t size = in->Get<size_t>();
+        char *input = in->Assign<char>(size);
+        if (input != NULL) call.input.assign(input, input + size);
+    }
+    LOG4CPLUS_DEBUG(logger, "Defined macro " << id << " of " << count << " call(s)");
+    mMacros[id] = std::move(calls);
+    return std::make_shared<Result>(0);
+}
+
+std::shared_ptr<Result> Macros::Replay(Buffer *in, const Dispatch &dispatch) {
+    uint64_t id = in->Get<uint64_t>();
+    uint32_t first = in->Get<uint32_t>();
+    uint32_t count = in->Get<uint32_t>();
+    uint32_t changed = in->Get<uint32_t>();
+    auto it = mMacros.find(id);
+    if (it == mMacros.end() || (size_t)first + count > it->second.size()) {
+        LOG4CPLUS_ERROR(logger, "Replay of unknown macro " << id << " or past its end");
+        return std::make_shared<Result>(-1);
+    }
+    auto &calls = it->second;
+
+    /* the size of the deltas, which follow sorted by call and are read as the calls run */
+    in->Get<size_t>();
+    uint32_t next_changed = changed > 0 ? in->Get<uint32_t>() : UINT32_MAX;
+    auto out = std::make_shared<Buffer>();
+    for (uint32_t i = first; i < first + count; i++) {
+        /* a copy: handlers may write into their input */
+        std::vector<char> input = calls[i].input;
+        if (i == next_changed) {
+            MacroDelta::Apply(in, &input);
+            next_changed = --changed > 0 ? in->Get<uint32_t>() : UINT32_MAX;
+        }
+        auto input_buffer = std::make_shared<Buffer>(input.data(), input.size());
+        std::shared_ptr<Result> result;
+        try {
+            result = dispatch(calls[i].routine, input_buffer);
+        } catch (const std::exception &e) {
+            LOG4CPLUS_ERROR(logger, calls[i].routine << " in macro " << id << ": " << e.what());
+            result = std::make_shared<Result>(-1);
+        }
+        /* a handler that threw answers NULL */
+        if (result == nullptr) {
+            LOG4CPLUS_ERROR(logger, calls[i].routine << " in macro " << id << " failed");
+            result = std::make_shared<Result>(-1);
+        }
+        if (result->GetExitCode() != 0) {
+            out->Add(i);
+            return std::make_shared<Result>(result->GetExitCode(), out);
+        }
+    }
+    out->Add(first + count);
+    return std::make_shared<Result>(0, out);
+}
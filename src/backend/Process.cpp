@@ -28,14 +28,17 @@
  *            Department of Computer Science, University College Dublin
  */
 
+#include <gvirtus/backend/Macros.h>
 #include <gvirtus/backend/Process.h>
 #include <gvirtus/common/JSON.h>
+#include <gvirtus/common/Placement.h>
 #include <gvirtus/common/SignalException.h>
 #include <gvirtus/common/SignalState.h>
 #include <pthread.h>
 #include <signal.h>
 #include <unistd.h>
 
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <thread>
@@ -44,19 +47,24 @@
 
 #define DEBUG
 
+using gvirtus::backend::Macros;
 using gvirtus::backend::Process;
+using gvirtus::backend::Scheduler;
+using gvirtus::backend::Shards;
 using gvirtus::common::LD_Lib;
 using gvirtus::communicators::Buffer;
 using gvirtus::communicators::Communicator;
 using gvirtus::communicators::Endpoint;
+using gvirtus::communicators::LoadReport;
 
 using std::chrono::steady_clock;
 
 using namespace std;
 
 Process::Process(std::shared_ptr<LD_Lib<Communicator, std::shared_ptr<Endpoint>>> communicator,
-                 vector<string> &plugins)
-    : Observable() {
+                 vector<string> &plugins, const nlohmann::json &scheduler,
+                 const nlohmann::json &shards, const nlohmann::json &placement)
+    : Observable(), mScheduler(scheduler), mShards(shards), mPlacement(placement) {
     logger = log4cplus::Logger::getInstance(LOG4CPLUS_TEXT("Process"));
 
     signal(SIGCHLD, SIG_IGN);
@@ -111,7 +119,8 @@ bool getstring(Communicator *c, string &s) {
             cerr << e.what() << endl;
         }
         return false;
-    } else if (c->to_string() == "hybridcommunicator") {
+    } else if (c->to_string() == "hybridcommunicator" || c->to_string() == "afunixcommunicator" ||
+               c->to_string() == "shmcommunicator") {
         s.clear();
         char ch = 0;
         // same as tcp/ip, and stop until read /0
@@ -137,6 +146,27 @@ std::string getGVirtuSHome() {
 void Process::Start() {
     LOG4CPLUS_DEBUG(logger, "[Process " << getpid() << "] Process::Start() called.");
 
+    bool worker = false;
+    if (mShards.Enabled()) {
+        std::string type = _communicator->obj_ptr()->to_string();
+        if (type != "tcpcommunicator" && type != "afunixcommunicator") {
+            LOG4CPLUS_ERROR(logger, "[Process " << getpid() << "]: A " << type
+                                                << " cannot hand its connections over to"
+                                                << " workers, serving them here.");
+        } else if (mShards.Fork() < 0) {
+            Accept();
+            return;
+        } else {
+            worker = true;
+        }
+    }
+
+    try {
+        common::Placement::Configure(mPlacement);
+    } catch (const std::exception &e) {
+        LOG4CPLUS_ERROR(logger, "[Process " << getpid() << "]: " << e.what());
+    }
+
     for_each(mPlugins.begin(), mPlugins.end(), [this](const std::string &plug) {
         std::string gvirtus_home = getGVirtuSHome();
 
@@ -162,7 +192,43 @@ void Process::Start() {
 
         string routine;
         std::shared_ptr<Buffer> input_buffer = std::make_shared<Buffer>();
+        // the macros of the frontend are kept for as long as its connection
+        Macros macros;
+        Scheduler::Session session;
+        Macros::Dispatch dispatch = [this, &session](const string &routine,
+                                                     std::shared_ptr<Buffer> input_buffer) {
+            std::shared_ptr<Handler> h = nullptr;
+            for (auto &ptr_el : _handlers) {
+                if (ptr_el->obj_ptr()->CanExecute(routine)) {
+                    h = ptr_el->obj_ptr();
+                    break;
+                }
+            }
 
+            std::shared_ptr<communicators::Result> result;
+            if (h == nullptr) {
+                LOG4CPLUS_ERROR(logger, "[Process " << getpid() << "]: Requested unknown routine '"
+                                                    << routine << "'.");
+                result = std::make_shared<communicators::Result>(-1, std::make_shared<Buffer>());
+            } else {
+                Scheduler::Turn turn(&mScheduler, &session, routine);
+                auto start = steady_clock::now();
+                mRunning++;
+                result = h->Execute(routine, input_buffer);
+                mRunning--;
+                // NULL when the handler threw, which a macro replay stops at
+                if (result != nullptr)
+                    result->TimeTaken(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                          steady_clock::now() - start)
+                                          .count() /
+                                      1000.0);
+            }
+            return result;
+        };
+
+        int node = common::Placement::Bound();
+        mScheduler.Open(&session);
+        mSessions++;
         while (getstring(client_comm, routine)) {
             LOG4CPLUS_DEBUG(logger, "Received routine " << routine);
 
@@ -191,26 +257,28 @@ void Process::Start() {
             // now reading buffer：8B from TCP, payload will transfer by the selected protocol
             input_buffer->Reset(client_comm);
 
-            std::shared_ptr<Handler> h = nullptr;
-            for (auto &ptr_el : _handlers) {
-                if (ptr_el->obj_ptr()->CanExecute(routine)) {
-                    h = ptr_el->obj_ptr();
-                    break;
-                }
-            }
-
             std::shared_ptr<communicators::Result> result;
-            if (h == nullptr) {
-                LOG4CPLUS_ERROR(logger, "[Process " << getpid() << "]: Requested unknown routine '"
-                                                    << routine << "'.");
-                result = std::make_shared<communicators::Result>(-1, std::make_shared<Buffer>());
-            } else {
+            if (routine == "gvirtusLoad") {
+                result = Load();
+            } else if (routine == "gvirtusSessionProcess") {
+                // read by the acceptor of a sharded endpoint (see Shards.h)
+                result = std::make_shared<communicators::Result>(0, std::make_shared<Buffer>());
+            } else if (routine == "gvirtusSessionClass") {
+                result = SessionClass(&session, input_buffer);
+            } else if (routine == "gvirtusSchedulerStats") {
+                auto out = std::make_shared<Buffer>();
+                mScheduler.Stats(out.get());
+                result = std::make_shared<communicators::Result>(mScheduler.Enabled() ? 0 : -1,
+                                                                 out);
+            } else if (Macros::Handles(routine)) {
                 auto start = steady_clock::now();
-                result = h->Execute(routine, input_buffer);
+                result = macros.Execute(routine, input_buffer, dispatch);
                 result->TimeTaken(std::chrono::duration_cast<std::chrono::milliseconds>(
                                       steady_clock::now() - start)
                                       .count() /
                                   1000.0);
+            } else {
+                result = dispatch(routine, input_buffer);
             }
 
             // return info：control the head transfer by TCP，then payload RDMA
@@ -221,13 +289,40 @@ void Process::Start() {
                 hybrid->end_call();
             }
 
+            // the buffer of the next calls is allocated where the session now runs
+            if (common::Placement::Bound() != node) {
+                node = common::Placement::Bound();
+                input_buffer = std::make_shared<Buffer>();
+            }
+
             LOG4CPLUS_DEBUG(logger, "[Process " << getpid() << "]: Routine '" << routine
                                                 << "' returned " << result->GetExitCode() << ".");
         }
+        mSessions--;
+        mScheduler.Close(&session);
 
         Notify("process-ended");
     };
 
+    if (worker) {
+        uint64_t client;
+        int fd;
+        while ((fd = mShards.Receive(&client)) >= 0) {
+            auto *comm = const_cast<Communicator *>(_communicator->obj_ptr()->Adopt(fd));
+            if (comm == nullptr) {
+                close(fd);
+                mShards.Ended(client);
+                continue;
+            }
+            std::thread([this, execute, comm, client]() {
+                execute(comm);
+                mShards.Ended(client);
+            }).detach();
+        }
+        LOG4CPLUS_DEBUG(logger, "[Process " << getpid() << "]: the acceptor has ended.");
+        return;
+    }
+
     /*
     common::SignalState sig_hand;
     sig_hand.setup_signal_state(SIGINT);
@@ -267,6 +362,48 @@ void Process::Start() {
     // exit(EXIT_SUCCESS);
 }
 
+void Process::Accept() {
+    try {
+        _communicator->obj_ptr()->Serve();
+        while (true) {
+            int fd = _communicator->obj_ptr()->AcceptSocket();
+            if (fd < 0) {
+                LOG4CPLUS_ERROR(logger, "[Process " << getpid() << "]: Cannot accept: "
+                                                    << strerror(errno));
+                break;
+            }
+            std::thread(&Shards::Route, &mShards, fd).detach();
+        }
+    } catch (const std::exception &exc) {
+        LOG4CPLUS_ERROR(logger, "[Process " << getpid() << "]: " << exc.what());
+    }
+}
+
+std::shared_ptr<gvirtus::communicators::Result> Process::Load() {
+    LoadReport report = {};
+    report.sessions = mSessions - 1;
+    report.running = mRunning;
+    report.waiting = mScheduler.Waiting();
+    for (auto &handler : _handlers) handler->obj_ptr()->Load(&report);
+
+    auto out = std::make_shared<Buffer>();
+    out->Add(report);
+    return std::make_shared<gvirtus::communicators::Result>(0, out);
+}
+
+std::shared_ptr<gvirtus::communicators::Result> Process::SessionClass(
+    Scheduler::Session *session, std::shared_ptr<Buffer> in) {
+    std::string name = in->AssignString();
+    const Scheduler::Class *cls = mScheduler.Classify(session, name);
+    if (cls == nullptr) {
+        LOG4CPLUS_WARN(logger, "[Process " << getpid() << "]: No scheduler class '" << name
+                                           << "', the session stays in its class.");
+        return std::make_shared<gvirtus::communicators::Result>(-1, std::make_shared<Buffer>());
+    }
+    for (auto &handler : _handlers) handler->obj_ptr()->StreamPriority(cls->streamPriority);
+    return std::make_shared<gvirtus::communicators::Result>(0, std::make_shared<Buffer>());
+}
+
 Process::~Process() {
     _communicator.reset();
     _handlers.clear();
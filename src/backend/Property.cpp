@@ -38,3 +38,18 @@ Property &Property::secure(bool secure) {
     _secure = secure;
     return *this;
 }
+
+Property &Property::scheduler(const nlohmann::json &scheduler) {
+    _scheduler = scheduler;
+    return *this;
+}
+
+Property &Property::shards(const nlohmann::json &shards) {
+    _shards = shards;
+    return *this;
+}
+
+Property &Property::placement(const nlohmann::json &placement) {
+    _placement = placement;
+    return *this;
+}
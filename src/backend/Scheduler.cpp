@@ -0,0 +1,195 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gvirtus/backend/Scheduler.h>
+
+#include <algorithm>
+
+#include "log4cplus/loggingmacros.h"
+
+using std::chrono::duration;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+using gvirtus::backend::Scheduler;
+using gvirtus::communicators::Buffer;
+
+Scheduler::Scheduler(const nlohmann::json &config) {
+    logger = log4cplus::Logger::getInstance(LOG4CPLUS_TEXT("Scheduler"));
+    if (!config.is_object()) return;
+
+    mSlots = std::max(1u, config.value("slots", 1u));
+    mIdle = microseconds(config.value("idle_us", 2000));
+    for (auto &entry : config.value("classes", nlohmann::json::array())) {
+        auto cls = std::make_unique<Class>();
+        cls->name = entry.at("name").get<std::string>();
+        cls->weight = entry.value("weight", 1.0);
+        cls->priority = entry.value("priority", 0);
+        std::string stream = entry.value("stream_priority", "");
+        cls->streamPriority = stream == "high" ? 1 : stream == "low" ? -1 : 0;
+        if (cls->weight <= 0)
+            throw std::runtime_error("The weight of class " + cls->name + " is not positive.");
+        mClasses.push_back(std::move(cls));
+    }
+    if (mClasses.empty()) {
+        mClasses.push_back(std::make_unique<Class>());
+        mClasses.back()->name = "default";
+    }
+
+    mpDefault = mClasses.front().get();
+    std::string name = config.value("default_class", mpDefault->name);
+    for (auto &cls : mClasses)
+        if (cls->name == name) mpDefault = cls.get();
+    if (mpDefault->name != name)
+        throw std::runtime_error("No scheduler class " + name + " for default_class.");
+
+    mEnabled = true;
+    LOG4CPLUS_INFO(logger, "Scheduling " << mClasses.size() << " class(es) on " << mSlots
+                                         << " slot(s)");
+}
+
+void Scheduler::Open(Session *session) {
+    if (!mEnabled) return;
+    std::lock_guard<std::mutex> lock(mMutex);
+    session->cls = mpDefault;
+    session->finish = mVirtual;
+    mSessions.push_back(session);
+}
+
+void Scheduler::Close(Session *session) {
+    if (!mEnabled) return;
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSessions.remove(session);
+}
+
+const Scheduler::Class *Scheduler::Classify(Session *session, const std::string &name) {
+    if (!mEnabled) return nullptr;
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto &cls : mClasses) {
+        if (cls->name != name) continue;
+        session->cls = cls.get();
+        return cls.get();
+    }
+    return nullptr;
+}
+
+bool Scheduler::Waits(const std::string &routine) {
+    static const std::string suffix = "Synchronize";
+    return routine == "cudaNotificationsWait" ||
+           (routine.size() >= suffix.size() &&
+            routine.compare(routine.size() - suffix.size(), suffix.size(), suffix) == 0);
+}
+
+void Scheduler::Acquire(Session *session) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    session->enqueued = steady_clock::now();
+    session->start = Start(session, session->enqueued);
+    session->waiting = true;
+    Grant();
+    session->granting.wait(lock, [session] { return session->granted; });
+    session->granted = false;
+
+    uint64_t waited =
+        duration_cast<microseconds>(steady_clock::now() - session->enqueued).count();
+    Class *cls = session->cls;
+    cls->calls++;
+    cls->waitUs += waited;
+    cls->maxWaitUs = std::max(cls->maxWaitUs, waited);
+}
+
+double Scheduler::Start(const Session *session, steady_clock::time_point now) const {
+    return now - session->ended > mIdle ? std::max(session->finish, mVirtual) : session->finish;
+}
+
+void Scheduler::Release(Session *session, double seconds, bool slot) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto now = steady_clock::now();
+    // a call without a turn starts when it comes
+    if (!slot)
+        session->start = Start(
+            session, now - duration_cast<steady_clock::duration>(duration<double>(seconds)));
+    session->finish = session->start + seconds / session->cls->weight;
+    session->ended = now;
+    if (slot) {
+        mRunning--;
+        Grant();
+    }
+}
+
+void Scheduler::Grant() {
+    while (mRunning < mSlots) {
+        Session *next = nullptr;
+        for (Session *session : mSessions) {
+            if (!session->waiting) continue;
+            if (next == nullptr || session->cls->priority > next->cls->priority ||
+                (session->cls->priority == next->cls->priority &&
+                 (session->start < next->start ||
+                  (session->start == next->start && session->enqueued < next->enqueued))))
+                next = session;
+        }
+        if (next == nullptr) return;
+        next->waiting = false;
+        next->granted = true;
+        mRunning++;
+        mVirtual = std::max(mVirtual, next->start);
+        next->granting.notify_one();
+    }
+}
+
+uint32_t Scheduler::Waiting() {
+    if (!mEnabled) return 0;
+    std::lock_guard<std::mutex> lock(mMutex);
+    return std::count_if(mSessions.begin(), mSessions.end(),
+                         [](const Session *session) { return session->waiting; });
+}
+
+void Scheduler::Stats(Buffer *out) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    out->Add<uint32_t>(mClasses.size());
+    for (auto &cls : mClasses) {
+        uint32_t waiting =
+            std::count_if(mSessions.begin(), mSessions.end(), [&cls](const Session *session) {
+                return session->waiting && session->cls == cls.get();
+            });
+        out->AddString(cls->name.c_str());
+        out->Add(cls->calls);
+        out->Add(cls->waitUs);
+        out->Add(cls->maxWaitUs);
+        out->Add(waiting);
+    }
+}
+
+Scheduler::Turn::Turn(Scheduler *scheduler, Session *session, const std::string &routine)
+    : mpScheduler(scheduler), mpSession(session), mSlot(false) {
+    if (scheduler->mEnabled && !Waits(routine)) {
+        scheduler->Acquire(session);
+        mSlot = true;
+    }
+    mStart = steady_clock::now();
+}
+
+Scheduler::Turn::~Turn() {
+    if (!mpScheduler->mEnabled) return;
+    mpScheduler->Release(mpSession, duration<double>(steady_clock::now() - mStart).count(),
+                         mSlot);
+}
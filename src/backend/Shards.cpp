@@ -0,0 +1,326 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gvirtus/backend/Shards.h>
+#include <gvirtus/common/Topology.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include "log4cplus/loggingmacros.h"
+
+using gvirtus::backend::Shards;
+using gvirtus::common::Topology;
+
+namespace {
+/* the first call of every connection of a frontend, with the key of its process */
+const char kSessionProcess[] = "gvirtusSessionProcess";
+/* how long the acceptor waits for it, in milliseconds */
+const int kSessionProcessTimeout = 1000;
+}  // namespace
+
+Shards::Shards(const nlohmann::json &config) {
+    logger = log4cplus::Logger::getInstance(LOG4CPLUS_TEXT("Shards"));
+    if (!config.is_object()) return;
+
+    Topology topology;
+    if (config.contains("workers")) {
+        for (auto &entry : config["workers"]) {
+            Worker worker;
+            if (entry.contains("devices"))
+                worker.devices = entry["devices"].is_string()
+                                     ? entry["devices"].get<std::string>()
+                                     : std::to_string(entry["devices"].get<int>());
+            if (entry.contains("cpus"))
+                worker.cpus = Topology::ParseCpus(entry["cpus"].get<std::string>());
+            else if (entry.contains("numa"))
+                worker.cpus = topology.Cpus(entry["numa"].get<int>());
+            mWorkers.push_back(worker);
+        }
+    } else {
+        std::string per = config.value("per", "gpu");
+        const std::vector<std::string> &gpus = topology.Gpus();
+        if (per == "gpu") {
+            for (size_t i = 0; i < gpus.size(); i++) {
+                Worker worker;
+                worker.devices = std::to_string(i);
+                worker.cpus = topology.Cpus(topology.Node(gpus[i]));
+                mWorkers.push_back(worker);
+            }
+        } else if (per == "numa") {
+            for (int node : topology.Nodes()) {
+                Worker worker;
+                for (size_t i = 0; i < gpus.size(); i++) {
+                    if (topology.Node(gpus[i]) != node) continue;
+                    if (!worker.devices.empty()) worker.devices += ",";
+                    worker.devices += std::to_string(i);
+                }
+                // a node without GPUs only gets a worker on a machine without any
+                if (worker.devices.empty() && !gpus.empty()) continue;
+                worker.cpus = topology.Cpus(node);
+                mWorkers.push_back(worker);
+            }
+        } else {
+            throw std::runtime_error("Unknown shards \"per\": " + per + ".");
+        }
+        if (mWorkers.empty())
+            LOG4CPLUS_WARN(logger, "No " << per << " found, the connections are not sharded.");
+    }
+}
+
+Shards::~Shards() {
+    for (auto &worker : mWorkers)
+        if (worker.fd >= 0) close(worker.fd);
+    if (mFd >= 0) close(mFd);
+}
+
+int Shards::Fork() {
+    for (size_t i = 0; i < mWorkers.size(); i++) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) != 0)
+            throw std::runtime_error(std::string("socketpair: ") + strerror(errno));
+
+        pid_t pid = fork();
+        if (pid < 0) throw std::runtime_error(std::string("fork: ") + strerror(errno));
+        if (pid == 0) {
+            for (size_t j = 0; j < i; j++) {
+                close(mWorkers[j].fd);
+                mWorkers[j].fd = -1;
+            }
+            close(fds[0]);
+            mFd = fds[1];
+            // a worker does not outlive its acceptor
+            prctl(PR_SET_PDEATHSIG, SIGTERM);
+            Pin(mWorkers[i]);
+            return i;
+        }
+        close(fds[1]);
+        mWorkers[i].fd = fds[0];
+        mWorkers[i].pid = pid;
+        LOG4CPLUS_INFO(logger, "Worker " << i << " (pid " << pid << ") on devices '"
+                                         << mWorkers[i].devices << "', "
+                                         << mWorkers[i].cpus.size() << " CPU(s)");
+    }
+    std::thread(&Shards::Watch, this).detach();
+    return -1;
+}
+
+void Shards::Pin(const Worker &worker) {
+    if (!worker.devices.empty()) {
+        setenv("CUDA_DEVICE_ORDER", "PCI_BUS_ID", 1);
+        setenv("CUDA_VISIBLE_DEVICES", worker.devices.c_str(), 1);
+    }
+    if (worker.cpus.empty()) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : worker.cpus)
+        if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0)
+        LOG4CPLUS_WARN(logger, "Cannot pin worker " << getpid() << ": " << strerror(errno));
+}
+
+bool Shards::Announced(int fd, uint64_t *key) {
+    // the routine, the size of the arguments and the key, as Frontend::Send() writes them
+    char expected[sizeof(kSessionProcess) + sizeof(size_t)];
+    size_t size = sizeof(*key);
+    memcpy(expected, kSessionProcess, sizeof(kSessionProcess));
+    memcpy(expected + sizeof(kSessionProcess), &size, sizeof(size));
+    char message[sizeof(expected) + sizeof(*key)];
+
+    pollfd polled = {fd, POLLIN, 0};
+    if (poll(&polled, 1, kSessionProcessTimeout) <= 0) return false;
+    ssize_t n = recv(fd, message, sizeof(message), MSG_PEEK | MSG_DONTWAIT);
+    if (n <= 0 || memcmp(message, expected, std::min((size_t)n, sizeof(expected))) != 0)
+        return false;
+    if ((size_t)n < sizeof(message)) {
+        // the rest of the call is on its way
+        timeval timeout = {kSessionProcessTimeout / 1000, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        n = recv(fd, message, sizeof(message), MSG_PEEK | MSG_WAITALL);
+        timeout = {0, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        if (n != (ssize_t)sizeof(message)) return false;
+    }
+    memcpy(key, message + sizeof(expected), sizeof(*key));
+    return true;
+}
+
+uint64_t Shards::Client(int fd) {
+    sockaddr_storage address;
+    socklen_t size = sizeof(address);
+    if (getsockname(fd, (sockaddr *)&address, &size) != 0) return 0;
+
+    // FNV-1a of the identity of the client
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void *data, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            hash ^= ((const unsigned char *)data)[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    uint64_t key;
+    if (Announced(fd, &key)) {
+        mix(kSessionProcess, sizeof(kSessionProcess));
+        mix(&key, sizeof(key));
+        return hash;
+    }
+
+    // a frontend that does not announce its process: the peer process or host
+    mix(&address.ss_family, sizeof(address.ss_family));
+    if (address.ss_family == AF_UNIX) {
+        struct ucred credentials;
+        socklen_t length = sizeof(credentials);
+        if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) == 0)
+            mix(&credentials.pid, sizeof(credentials.pid));
+    } else {
+        size = sizeof(address);
+        if (getpeername(fd, (sockaddr *)&address, &size) == 0) {
+            if (address.ss_family == AF_INET)
+                mix(&((sockaddr_in *)&address)->sin_addr, sizeof(in_addr));
+            else if (address.ss_family == AF_INET6)
+                mix(&((sockaddr_in6 *)&address)->sin6_addr, sizeof(in6_addr));
+        }
+    }
+    return hash;
+}
+
+void Shards::Route(int fd) {
+    uint64_t client = Client(fd);
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto found = mClients.find(client);
+    size_t index;
+    if (found != mClients.end()) {
+        index = found->second.first;
+        found->second.second++;
+    } else {
+        index = mWorkers.size();
+        for (size_t i = 0; i < mWorkers.size(); i++)
+            if (mWorkers[i].fd >= 0 &&
+                (index == mWorkers.size() || mWorkers[i].clients < mWorkers[index].clients))
+                index = i;
+        if (index == mWorkers.size()) {
+            LOG4CPLUS_ERROR(logger, "No worker is left, closing the connection.");
+            close(fd);
+            return;
+        }
+        mClients[client] = {index, 1};
+        mWorkers[index].clients++;
+    }
+
+    struct iovec iov = {&client, sizeof(client)};
+    char control[CMSG_SPACE(sizeof(int))] = {};
+    struct msghdr message = {};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    if (sendmsg(mWorkers[index].fd, &message, MSG_NOSIGNAL) < 0) {
+        LOG4CPLUS_ERROR(logger, "Cannot hand a connection over to worker "
+                                    << index << ": " << strerror(errno));
+        // the worker never sees it, so it never reports its end
+        auto found = mClients.find(client);
+        if (found != mClients.end() && --found->second.second == 0) {
+            mWorkers[index].clients--;
+            mClients.erase(found);
+        }
+    }
+    // the worker has its own copy of the socket
+    close(fd);
+}
+
+int Shards::Receive(uint64_t *client) {
+    struct iovec iov = {client, sizeof(*client)};
+    char control[CMSG_SPACE(sizeof(int))] = {};
+    struct msghdr message = {};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t n;
+    do {
+        n = recvmsg(mFd, &message, 0);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) return -1;
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+    if (cmsg == nullptr || cmsg->cmsg_type != SCM_RIGHTS) return -1;
+    int fd;
+    memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+    return fd;
+}
+
+void Shards::Ended(uint64_t client) { send(mFd, &client, sizeof(client), MSG_NOSIGNAL); }
+
+void Shards::Watch() {
+    while (true) {
+        std::vector<pollfd> fds;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (auto &worker : mWorkers)
+                if (worker.fd >= 0) fds.push_back({worker.fd, POLLIN, 0});
+        }
+        if (fds.empty()) return;
+        if (poll(fds.data(), fds.size(), -1) < 0 && errno != EINTR) return;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto &polled : fds) {
+            if (polled.revents == 0) continue;
+            size_t index = 0;
+            while (mWorkers[index].fd != polled.fd) index++;
+
+            uint64_t client;
+            if (recv(polled.fd, &client, sizeof(client), MSG_DONTWAIT) == sizeof(client)) {
+                auto found = mClients.find(client);
+                if (found != mClients.end() && --found->second.second == 0) {
+                    mWorkers[found->second.first].clients--;
+                    mClients.erase(found);
+                }
+                continue;
+            }
+            if (!(polled.revents & (POLLHUP | POLLERR))) continue;
+
+            LOG4CPLUS_ERROR(logger, "Worker " << index << " (pid " << mWorkers[index].pid
+                                              << ") has ended, its clients are lost.");
+            close(mWorkers[index].fd);
+            mWorkers[index].fd = -1;
+            for (auto client = mClients.begin(); client != mClients.end();)
+                client = client->second.first == index ? mClients.erase(client) : std::next(client);
+        }
+    }
+}
@@ -0,0 +1,265 @@
+/**
+ * @file   Base64.cpp
+ *
+ * @brief  Base64 (RFC 4648). The vector kernels follow W. Muła and
+ * D. Lemire, "Faster Base64 Encoding and Decoding Using AVX2 Instructions":
+ * bytes are spread to 6-bit indices with multiplies and turned into
+ * characters with a pshufb lookup; characters are validated and turned back
+ * with nibble lookups and packed with multiply-adds.
+ */
+
+#include "gvirtus/common/Base64.h"
+
+#include <array>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BASE64_X86
+#endif
+
+using gvirtus::common::Base64;
+
+static const char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static const std::array<int8_t, 256> VALUES = [] {
+    std::array<int8_t, 256> values;
+    values.fill(-1);
+    for (int i = 0; i < 64; i++) values[(uint8_t)ALPHABET[i]] = i;
+    return values;
+}();
+
+/* Encodes size bytes, the last group padded. */
+static void EncodeScalar(const uint8_t *in, size_t size, char *out) {
+    for (; size >= 3; size -= 3, in += 3, out += 4) {
+        uint32_t v = in[0] << 16 | in[1] << 8 | in[2];
+        out[0] = ALPHABET[v >> 18];
+        out[1] = ALPHABET[v >> 12 & 63];
+        out[2] = ALPHABET[v >> 6 & 63];
+        out[3] = ALPHABET[v & 63];
+    }
+    if (size == 0) return;
+    uint32_t v = in[0] << 16 | (size == 2 ? in[1] << 8 : 0);
+    out[0] = ALPHABET[v >> 18];
+    out[1] = ALPHABET[v >> 12 & 63];
+    out[2] = size == 2 ? ALPHABET[v >> 6 & 63] : '=';
+    out[3] = '=';
+}
+
+/* Decodes size characters without padding; -1 if one is not base64. */
+static ptrdiff_t DecodeScalar(const char *in, size_t size, uint8_t *out) {
+    uint8_t *start = out;
+    for (; size >= 4; size -= 4, in += 4, out += 3) {
+        int a = VALUES[(uint8_t)in[0]], b = VALUES[(uint8_t)in[1]];
+        int c = VALUES[(uint8_t)in[2]], d = VALUES[(uint8_t)in[3]];
+        if ((a | b | c | d) < 0) return -1;
+        uint32_t v = a << 18 | b << 12 | c << 6 | d;
+        out[0] = v >> 16;
+        out[1] = v >> 8;
+        out[2] = v;
+    }
+    if (size == 1) return -1;
+    if (size > 1) {
+        int a = VALUES[(uint8_t)in[0]], b = VALUES[(uint8_t)in[1]];
+        int c = size == 3 ? VALUES[(uint8_t)in[2]] : 0;
+        if ((a | b | c) < 0) return -1;
+        uint32_t v = a << 18 | b << 12 | c << 6;
+        *out++ = v >> 16;
+        if (size == 3) *out++ = v >> 8;
+    }
+    return out - start;
+}
+
+#ifdef BASE64_X86
+
+/* The characters of 16 6-bit indices. */
+__attribute__((target("sse4.1"))) static inline __m128i Lookup(__m128i indices) {
+    const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    reduced = _mm_or_si128(reduced, _mm_and_si128(less, _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(shift, reduced), indices);
+}
+
+/* Encodes 12 bytes at a time while 16 can be read; returns the bytes encoded. */
+__attribute__((target("sse4.1"))) static size_t EncodeSse41(const uint8_t *in, size_t size,
+                                                             char *out) {
+    const __m128i spread = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    size_t done = 0;
+    for (; done + 16 <= size; done += 12, out += 16) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + done)), spread);
+        __m128i high = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)),
+                                       _mm_set1_epi32(0x04000040));
+        __m128i low = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)),
+                                      _mm_set1_epi32(0x01000010));
+        _mm_storeu_si128((__m128i *)out, Lookup(_mm_or_si128(high, low)));
+    }
+    return done;
+}
+
+/*
+ * Decodes 16 characters at a time, writing 16 bytes for 12, while 24 are
+ * left; stops before a block that is not base64. Returns the characters
+ * decoded.
+ */
+__attribute__((target("sse4.1"))) static size_t DecodeSse41(const char *in, size_t size,
+                                                             uint8_t *out) {
+    const __m128i lutLow = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                         0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i lutHigh = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10,
+                                          0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    size_t done = 0;
+    for (; done + 24 <= size; done += 16, out += 12) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + done));
+        __m128i high = _mm_and_si128(_mm_srli_epi32(v, 4), nibble);
+        __m128i low = _mm_and_si128(v, nibble);
+        if (!_mm_testz_si128(_mm_shuffle_epi8(lutLow, low), _mm_shuffle_epi8(lutHigh, high)))
+            break;
+        __m128i slash = _mm_cmpeq_epi8(v, _mm_set1_epi8('/'));
+        v = _mm_add_epi8(v, _mm_shuffle_epi8(lutRoll, _mm_add_epi8(slash, high)));
+        v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+        v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128((__m128i *)out, _mm_shuffle_epi8(v, pack));
+    }
+    return done;
+}
+
+__attribute__((target("avx2"))) static inline __m256i Lookup(__m256i indices) {
+    const __m256i shift = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0, 'a' - 26, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63,
+        'A', 0, 0);
+    __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    reduced = _mm256_or_si256(reduced, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    return _mm256_add_epi8(_mm256_shuffle_epi8(shift, reduced), indices);
+}
+
+/* Encodes 24 bytes at a time while 28 can be read; returns the bytes encoded. */
+__attribute__((target("avx2"))) static size_t EncodeAvx2(const uint8_t *in, size_t size,
+                                                          char *out) {
+    const __m256i spread =
+        _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4,
+                         7, 6, 8, 7, 10, 9, 11, 10);
+    size_t done = 0;
+    for (; done + 28 <= size; done += 24, out += 32) {
+        __m256i v = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(in + done))),
+            _mm_loadu_si128((const __m128i *)(in + done + 12)), 1);
+        v = _mm256_shuffle_epi8(v, spread);
+        __m256i high = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)),
+                                          _mm256_set1_epi32(0x04000040));
+        __m256i low = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)),
+                                         _mm256_set1_epi32(0x01000010));
+        _mm256_storeu_si256((__m256i *)out, Lookup(_mm256_or_si256(high, low)));
+    }
+    return done;
+}
+
+/* As DecodeSse41, 32 characters at a time while 48 are left, writing 32 bytes for 24. */
+__attribute__((target("avx2"))) static size_t DecodeAvx2(const char *in, size_t size,
+                                                          uint8_t *out) {
+    const __m256i lutLow = _mm256_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b,
+        0x1a, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b,
+        0x1b, 0x1a);
+    const __m256i lutHigh = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10);
+    const __m256i lutRoll =
+        _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4,
+                         -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack =
+        _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4,
+                         10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    size_t done = 0;
+    for (; done + 48 <= size; done += 32, out += 24) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(in + done));
+        __m256i high = _mm256_and_si256(_mm256_srli_epi32(v, 4), nibble);
+        __m256i low = _mm256_and_si256(v, nibble);
+        if (!_mm256_testz_si256(_mm256_shuffle_epi8(lutLow, low),
+                                _mm256_shuffle_epi8(lutHigh, high)))
+            break;
+        __m256i slash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/'));
+        v = _mm256_add_epi8(v, _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(slash, high)));
+        v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+        v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+        v = _mm256_shuffle_epi8(v, pack);
+        v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+        _mm256_storeu_si256((__m256i *)out, v);
+    }
+    return done;
+}
+
+#endif
+
+Base64::Implementation Base64::Best() {
+    static const Implementation best = Supported(AVX2)    ? AVX2
+                                       : Supported(SSE41) ? SSE41
+                                                          : SCALAR;
+    return best;
+}
+
+bool Base64::Supported(Implementation implementation) {
+#ifdef BASE64_X86
+    if (implementation == AVX2) return __builtin_cpu_supports("avx2");
+    if (implementation == SSE41) return __builtin_cpu_supports("sse4.1");
+#endif
+    return implementation == SCALAR;
+}
+
+const char *Base64::Name(Implementation implementation) {
+    switch (implementation) {
+        case AVX2:
+            return "avx2";
+        case SSE41:
+            return "sse4.1";
+        default:
+            return "scalar";
+    }
+}
+
+void Base64::Encode(const void *data, size_t size, char *out, Implementation implementation) {
+    auto in = (const uint8_t *)data;
+    size_t done = 0;
+#ifdef BASE64_X86
+    if (implementation == AVX2) done = EncodeAvx2(in, size, out);
+    if (implementation >= SSE41) done += EncodeSse41(in + done, size - done, out + done / 3 * 4);
+#endif
+    EncodeScalar(in + done, size - done, out + done / 3 * 4);
+}
+
+std::string Base64::Encode(const void *data, size_t size) {
+    std::string text(EncodedSize(size), '\0');
+    Encode(data, size, text.data());
+    return text;
+}
+
+ptrdiff_t Base64::Decode(const char *text, size_t size, void *out, Implementation implementation) {
+    if (size % 4 == 0 && size > 0 && text[size - 1] == '=') size -= text[size - 2] == '=' ? 2 : 1;
+    auto bytes = (uint8_t *)out;
+    size_t done = 0;
+#ifdef BASE64_X86
+    if (implementation == AVX2) done = DecodeAvx2(text, size, bytes);
+    if (implementation >= SSE41)
+        done += DecodeSse41(text + done, size - done, bytes + done / 4 * 3);
+#endif
+    ptrdiff_t tail = DecodeScalar(text + done, size - done, bytes + done / 4 * 3);
+    return tail < 0 ? -1 : (ptrdiff_t)(done / 4 * 3) + tail;
+}
+
+bool Base64::Decode(const std::string &text, std::string *out) {
+    out->resize(DecodedSize(text.size()));
+    ptrdiff_t size = Decode(text.data(), text.size(), out->data());
+    if (size < 0) return false;
+    out->resize(size);
+    return true;
+}
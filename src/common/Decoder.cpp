@@ -11,11 +11,17 @@
 
 #include <gvirtus/common/Decoder.h>
 
+#include <algorithm>
+#include <cctype>
 #include <cstdio>
 #include <iostream>
+#include <vector>
+
+#include "gvirtus/common/Base64.h"
 
 using namespace std;
 using namespace log4cplus;
+using gvirtus::common::Base64;
 using gvirtus::common::Decoder;
 
 Decoder::Decoder() {
@@ -37,24 +43,32 @@ int Decoder::Decode(const char *code_in, const int length_in, char *plaintext_ou
 }
 
 void Decoder::Decode(std::istream &istream_in, std::ostream &ostream_in) {
-    const int N = _buffersize;
-    char *code = new char[N];
-    char *plaintext = new char[N];
-    int codelength;
-    int plainlength;
+    const size_t N = _buffersize;
+    /* The characters left over from the previous read, fewer than four. */
+    vector<char> code(N + 3);
+    vector<char> plaintext(Base64::DecodedSize(N + 3));
+    size_t pending = 0;
 
     do {
-        istream_in.read((char *)code, N);
-        codelength = istream_in.gcount();
-        plainlength = Decode(code, codelength, plaintext);
-        ostream_in.write((const char *)plaintext, plainlength);
-    } while (istream_in.good() && codelength > 0);
+        istream_in.read(code.data() + pending, N);
+        size_t codelength = pending + istream_in.gcount();
+        /* Line breaks, padding and anything else but base64 are skipped. */
+        size_t kept = 0;
+        for (size_t i = 0; i < codelength; i++) {
+            char c = code[i];
+            if (isalnum((unsigned char)c) || c == '+' || c == '/') code[kept++] = c;
+        }
+        size_t whole = istream_in.good() ? kept - kept % 4 : kept;
+        ptrdiff_t plainlength = Base64::Decode(code.data(), whole, plaintext.data());
+        /* A last single character decodes to nothing. */
+        if (plainlength < 0) plainlength = Base64::Decode(code.data(), whole - 1, plaintext.data());
+        ostream_in.write(plaintext.data(), plainlength);
+        pending = kept - whole;
+        copy(code.begin() + whole, code.begin() + kept, code.begin());
+    } while (istream_in.good());
 
     this->step = step_a;
     this->plainchar = 0;
-
-    delete[] code;
-    delete[] plaintext;
 }
 
 int Decoder::Value(char value_in) {
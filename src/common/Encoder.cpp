@@ -11,10 +11,15 @@
 
 #include "gvirtus/common/Encoder.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <iostream>
+#include <vector>
+
+#include "gvirtus/common/Base64.h"
 
 using namespace std;
+using gvirtus::common::Base64;
 using gvirtus::common::Encoder;
 
 Encoder::Encoder() {
@@ -119,31 +124,22 @@ int Encoder::BlockEnd(char *code_out) {
 }
 
 void Encoder::Encode(std::istream &istream_in, std::ostream &ostream_in) {
-    step = step_A;
-    result = 0;
-    stepcount = 0;
-    //
-    const int N = _buffersize;
-    char *plaintext = new char[N];
-    char *code = new char[2 * N];
-    int plainlength;
-    int codelength;
+    /* Lines of CHARS_PER_LINE characters, a thousand of them per read. */
+    const size_t line = CHARS_PER_LINE / 4 * 3;
+    const size_t N = line * 1024;
+    vector<char> plaintext(N);
+    vector<char> code(N / 3 * 4 + N / line);
 
     do {
-        istream_in.read(plaintext, N);
-        plainlength = istream_in.gcount();
-        //
-        codelength = Encode(plaintext, plainlength, code);
-        ostream_in.write(code, codelength);
-    } while (istream_in.good() && plainlength > 0);
-
-    codelength = EncodeEnd(code);
-    ostream_in.write(code, codelength);
-    //
-    step = step_A;
-    result = 0;
-    stepcount = 0;
-
-    delete[] code;
-    delete[] plaintext;
+        istream_in.read(plaintext.data(), N);
+        size_t plainlength = istream_in.gcount();
+        char *codechar = code.data();
+        for (size_t offset = 0; offset < plainlength; offset += line) {
+            size_t n = min(line, plainlength - offset);
+            Base64::Encode(plaintext.data() + offset, n, codechar);
+            codechar += Base64::EncodedSize(n);
+            *codechar++ = '\n';
+        }
+        ostream_in.write(code.data(), codechar - code.data());
+    } while (istream_in.good());
 }
@@ -0,0 +1,124 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "gvirtus/common/Placement.h"
+
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include "log4cplus/loggingmacros.h"
+
+using gvirtus::common::Placement;
+using gvirtus::common::Topology;
+
+static thread_local int tsNode = -1;
+
+static std::unique_ptr<Placement> gpPlacement;
+
+static std::string Lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return tolower(c); });
+    return s;
+}
+
+Placement::Placement(const nlohmann::json &config, const Topology &topology)
+    : mTopology(topology) {
+    logger = log4cplus::Logger::getInstance(LOG4CPLUS_TEXT("Placement"));
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            if (CPU_ISSET(cpu, &set)) mAllowed.push_back(cpu);
+
+    std::string policy = config.is_object() ? config.value("policy", "device") : "device";
+    if (policy == "none") return;
+    if (policy != "device") throw std::runtime_error("Unknown placement policy " + policy + ".");
+    if (config.is_object() && config.contains("devices"))
+        for (auto &device : config["devices"].items())
+            mOverrides[Lower(device.key())] = device.value().get<int>();
+
+    // one node leaves nothing to choose
+    mEnabled = mTopology.Nodes().size() > 1;
+}
+
+Placement &Placement::GetInstance() {
+    if (gpPlacement == nullptr)
+        gpPlacement = std::make_unique<Placement>(nlohmann::json({{"policy", "none"}}), Topology());
+    return *gpPlacement;
+}
+
+void Placement::Configure(const nlohmann::json &config) {
+    gpPlacement = std::make_unique<Placement>(config, Topology());
+}
+
+int Placement::Node(const std::string &bus) const {
+    if (!mEnabled) return -1;
+    auto found = mOverrides.find(Lower(bus));
+    if (found != mOverrides.end()) return found->second;
+    return mTopology.Node(bus);
+}
+
+std::vector<int> Placement::Cpus(int node) const {
+    std::vector<int> cpus;
+    for (int cpu : mTopology.Cpus(node))
+        if (std::binary_search(mAllowed.begin(), mAllowed.end(), cpu)) cpus.push_back(cpu);
+    return cpus;
+}
+
+void Placement::Bind(const std::string &bus) {
+    int node = Node(bus);
+    if (node < 0 || node == tsNode) return;
+
+    std::vector<int> cpus = Cpus(node);
+    if (!cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus)
+            if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0)
+            LOG4CPLUS_WARN(logger, "Cannot run on the CPUs of node " << node << ": "
+                                                                     << strerror(errno));
+    }
+
+    // preferred rather than bound: a full node falls back to the others
+    unsigned long mask[16] = {};
+    if (node < (int)(sizeof(mask) * 8)) {
+        mask[node / (sizeof(long) * 8)] = 1ul << (node % (sizeof(long) * 8));
+        if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask, sizeof(mask) * 8) != 0)
+            LOG4CPLUS_WARN(logger, "Cannot allocate from node " << node << ": "
+                                                                << strerror(errno));
+    }
+
+    LOG4CPLUS_DEBUG(logger, "Thread " << syscall(SYS_gettid) << " runs near GPU " << bus
+                                      << ", on node " << node);
+    tsNode = node;
+}
+
+int Placement::Bound() { return tsNode; }
@@ -0,0 +1,101 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "gvirtus/common/Topology.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+using gvirtus::common::Topology;
+
+namespace fs = std::filesystem;
+
+static std::string ReadLine(const fs::path &path) {
+    std::string line;
+    std::ifstream in(path);
+    std::getline(in, line);
+    return line;
+}
+
+static std::string Lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return tolower(c); });
+    return s;
+}
+
+Topology::Topology(const fs::path &sysfs) {
+    std::error_code ec;
+    for (auto &entry : fs::directory_iterator(sysfs / "devices/system/node", ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.size() <= 4 || name.rfind("node", 0) != 0 || !isdigit(name[4])) continue;
+        mCpus[std::stoi(name.substr(4))] = ParseCpus(ReadLine(entry.path() / "cpulist"));
+    }
+
+    for (auto &entry : fs::directory_iterator(sysfs / "bus/pci/devices", ec)) {
+        // display controllers of NVIDIA: VGA (0x0300) and 3D (0x0302)
+        std::string cls = ReadLine(entry.path() / "class");
+        if (ReadLine(entry.path() / "vendor") != "0x10de" ||
+            (cls.rfind("0x0300", 0) != 0 && cls.rfind("0x0302", 0) != 0))
+            continue;
+        std::string bus = Lower(entry.path().filename().string());
+        std::string node = ReadLine(entry.path() / "numa_node");
+        mGpus.push_back(bus);
+        mGpuNodes[bus] = node.empty() ? -1 : std::stoi(node);
+    }
+    std::sort(mGpus.begin(), mGpus.end());
+}
+
+std::vector<int> Topology::Nodes() const {
+    std::vector<int> nodes;
+    for (auto &node : mCpus) nodes.push_back(node.first);
+    return nodes;
+}
+
+const std::vector<int> &Topology::Cpus(int node) const {
+    static const std::vector<int> none;
+    auto found = mCpus.find(node);
+    return found != mCpus.end() ? found->second : none;
+}
+
+int Topology::Node(const std::string &bus) const {
+    auto found = mGpuNodes.find(Lower(bus));
+    if (found != mGpuNodes.end()) return found->second;
+    return -1;
+}
+
+std::vector<int> Topology::ParseCpus(const std::string &list) {
+    std::vector<int> cpus;
+    size_t start = 0;
+    while (start < list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) end = list.size();
+        std::string range = list.substr(start, end - start);
+        size_t dash = range.find('-');
+        if (!range.empty() && isdigit((unsigned char)range[0])) {
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; cpu++) cpus.push_back(cpu);
+        }
+        start = end + 1;
+    }
+    return cpus;
+}
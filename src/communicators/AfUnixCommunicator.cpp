@@ -35,8 +35,9 @@
 
 #ifndef _WIN32
 
-#include "AfUnixCommunicator.h"
+#include "gvirtus/communicators/AfUnixCommunicator.h"
 
+#include <gvirtus/communicators/Endpoint_AfUnix.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -45,11 +46,14 @@
 #include <sys/un.h>
 #include <unistd.h>
 
+#include <cerrno>
 #include <csignal>
+#include <cstring>
+#include <stdexcept>
 
 using namespace std;
 
-namespace gvirtus {
+namespace gvirtus::communicators {
 
 AfUnixCommunicator::AfUnixCommunicator(const std::string &communicator) {
     const char *valueptr = strstr(communicator.c_str(), "://") + 3;
@@ -82,7 +86,8 @@ AfUnixCommunicator::AfUnixCommunicator(const char *path, mode_t mode) {
 }
 
 AfUnixCommunicator::~AfUnixCommunicator() {
-    // TODO Auto-generated destructor stub
+    /* Close() only shuts the socket down */
+    if (mSocketFd != -1) close(mSocketFd);
 }
 
 void AfUnixCommunicator::Serve() {
@@ -91,48 +96,62 @@ void AfUnixCommunicator::Serve() {
     unlink(mPath.c_str());
 
     if ((mSocketFd = socket(AF_UNIX, SOCK_STREAM, 0)) == 0)
-        throw "AfUnixCommunicator: Can't create socket.";
+        throw runtime_error("AfUnixCommunicator: Can't create socket.");
 
     socket_addr.sun_family = AF_UNIX;
     strcpy(socket_addr.sun_path, mPath.c_str());
 
     if (bind(mSocketFd, (struct sockaddr *)&socket_addr, sizeof(struct sockaddr_un)) != 0)
-        throw "AfUnixCommunicator: Can't bind socket.";
+        throw runtime_error("AfUnixCommunicator: Can't bind socket.");
 
-    if (listen(mSocketFd, 5) != 0) throw "AfUnixCommunicator: Can't listen from socket.";
+    if (listen(mSocketFd, 5) != 0)
+        throw runtime_error("AfUnixCommunicator: Can't listen from socket.");
 
     chmod(mPath.c_str(), mMode);
 }
 
 const Communicator *const AfUnixCommunicator::Accept() const {
-    unsigned client_socket_fd;
     struct sockaddr_un client_socket_addr;
-    unsigned client_socket_addr_size;
+    socklen_t client_socket_addr_size = sizeof(struct sockaddr_un);
 
-    client_socket_addr_size = sizeof(struct sockaddr_un);
-    if ((client_socket_fd =
-             accept(mSocketFd, (sockaddr *)&client_socket_addr, &client_socket_addr_size)) == 0)
-        throw "AfUnixCommunicator: Error while accepting connection.";
+    int client_socket_fd =
+        accept(mSocketFd, (sockaddr *)&client_socket_addr, &client_socket_addr_size);
+    if (client_socket_fd < 0) return nullptr;
 
     return new AfUnixCommunicator(client_socket_fd);
 }
 
+int AfUnixCommunicator::AcceptSocket() const {
+    int client_socket_fd;
+    do {
+        client_socket_fd = accept(mSocketFd, nullptr, nullptr);
+    } while (client_socket_fd < 0 && errno == EINTR);
+    return client_socket_fd;
+}
+
+const Communicator *const AfUnixCommunicator::Adopt(int fd) const {
+    return new AfUnixCommunicator(fd);
+}
+
 void AfUnixCommunicator::Connect() {
     int len;
     struct sockaddr_un remote;
 
     if ((mSocketFd = socket(AF_UNIX, SOCK_STREAM, 0)) == 0)
-        throw "AfUnixCommunicator: Can't create socket.";
+        throw runtime_error("AfUnixCommunicator: Can't create socket.");
 
     remote.sun_family = AF_UNIX;
     strcpy(remote.sun_path, mPath.c_str());
     len = offsetof(struct sockaddr_un, sun_path) + strlen(remote.sun_path);
     if (connect(mSocketFd, (struct sockaddr *)&remote, len) != 0)
-        throw "AfUnixCommunicator: Can't connect to socket.";
+        throw runtime_error("AfUnixCommunicator: Can't connect to socket.");
     InitializeStream();
 }
 
-void AfUnixCommunicator::Close() {}
+void AfUnixCommunicator::Close() {
+    /* the peer reads the end of the stream and ends its session */
+    shutdown(mSocketFd, SHUT_RDWR);
+}
 
 size_t AfUnixCommunicator::Read(char *buffer, size_t size) {
     mpInput->read(buffer, size);
@@ -155,5 +174,12 @@ void AfUnixCommunicator::InitializeStream() {
     /* FIXME: handle SIGPIPE instead of just ignoring it */
     signal(SIGPIPE, SIG_IGN);
 }
-}  // namespace gvirtus
+}  // namespace gvirtus::communicators
+
+extern "C" std::shared_ptr<gvirtus::communicators::AfUnixCommunicator> create_communicator(
+    std::shared_ptr<gvirtus::communicators::Endpoint> end) {
+    auto unix_end = std::dynamic_pointer_cast<gvirtus::communicators::Endpoint_AfUnix>(end);
+    return std::make_shared<gvirtus::communicators::AfUnixCommunicator>(unix_end->path().c_str(),
+                                                                         unix_end->mode());
+}
 #endif
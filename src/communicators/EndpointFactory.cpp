@@ -1,3 +1,4 @@
 #include "gvirtus/communicators/EndpointFactory.h"
 
 int gvirtus::communicators::EndpointFactory::ind_endpoint = 0;
+std::mutex gvirtus::communicators::EndpointFactory::mutex;
@@ -0,0 +1,44 @@
+#include "gvirtus/communicators/Endpoint_AfUnix.h"
+
+#include "gvirtus/communicators/EndpointFactory.h"
+
+using gvirtus::communicators::Endpoint;
+using gvirtus::communicators::Endpoint_AfUnix;
+using gvirtus::communicators::EndpointFactory;
+
+Endpoint_AfUnix::Endpoint_AfUnix(const std::string &endp_suite, const std::string &endp_protocol,
+                                 const std::string &endp_path, const std::string &endp_mode) {
+    suite(endp_suite);
+    protocol(endp_protocol);
+    path(endp_path);
+    mode(endp_mode);
+}
+
+Endpoint &Endpoint_AfUnix::suite(const std::string &suite) {
+    _suite = suite;
+    return *this;
+}
+
+Endpoint &Endpoint_AfUnix::protocol(const std::string &protocol) {
+    _protocol = protocol;
+    return *this;
+}
+
+Endpoint_AfUnix &Endpoint_AfUnix::path(const std::string &path) {
+    _path = path;
+    return *this;
+}
+
+Endpoint_AfUnix &Endpoint_AfUnix::mode(const std::string &mode) {
+    _mode = static_cast<mode_t>(std::stoul(mode, nullptr, 8));
+    return *this;
+}
+
+void gvirtus::communicators::from_json(const nlohmann::json &j, Endpoint_AfUnix &end) {
+    auto el = j["communicator"][EndpointFactory::index()]["endpoint"];
+
+    end.suite(el.at("suite"));
+    end.protocol(el.at("protocol"));
+    end.path(el.at("path"));
+    end.mode(el.value("mode", std::string("0660")));
+}
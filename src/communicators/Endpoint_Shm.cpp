@@ -0,0 +1,44 @@
+#include "gvirtus/communicators/Endpoint_Shm.h"
+
+#include "gvirtus/communicators/EndpointFactory.h"
+
+using gvirtus::communicators::Endpoint;
+using gvirtus::communicators::Endpoint_Shm;
+using gvirtus::communicators::EndpointFactory;
+
+Endpoint_Shm::Endpoint_Shm(const std::string &endp_suite, const std::string &endp_protocol,
+                           const std::string &endp_address, const std::string &endp_port) {
+    suite(endp_suite);
+    protocol(endp_protocol);
+    address(endp_address);
+    port(endp_port);
+}
+
+Endpoint &Endpoint_Shm::suite(const std::string &suite) {
+    _suite = suite;
+    return *this;
+}
+
+Endpoint &Endpoint_Shm::protocol(const std::string &protocol) {
+    _protocol = protocol;
+    return *this;
+}
+
+Endpoint_Shm &Endpoint_Shm::address(const std::string &address) {
+    _address = address;
+    return *this;
+}
+
+Endpoint_Shm &Endpoint_Shm::port(const std::string &port) {
+    _port = static_cast<uint16_t>(std::stoi(port));
+    return *this;
+}
+
+void gvirtus::communicators::from_json(const nlohmann::json &j, Endpoint_Shm &end) {
+    auto el = j["communicator"][EndpointFactory::index()]["endpoint"];
+
+    end.suite(el.at("suite"));
+    end.protocol(el.at("protocol"));
+    end.address(el.value("server_address", std::string("127.0.0.1")));
+    end.port(el.value("port", std::string("6666")));
+}
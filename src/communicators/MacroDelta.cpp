@@ -0,0 +1,81 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "gvirtus/communicators/MacroDelta.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using gvirtus::communicators::Buffer;
+using gvirtus::communicators::MacroDelta;
+
+/*
+ * A delta is the size of the new input and its runs of changed bytes, each
+ * an offset, a length and the bytes, all as uint32_t: an input that does not
+ * fit is never recorded.
+ */
+void MacroDelta::Encode(const std::vector<char> &recorded, const char *current, size_t size,
+                        Buffer *out) {
+    size_t common = std::min(recorded.size(), size);
+    std::vector<std::pair<size_t, size_t>> runs;
+    size_t i = 0;
+    while (i < common) {
+        if (recorded[i] == current[i]) {
+            i++;
+            continue;
+        }
+        size_t start = i;
+        while (i < common && recorded[i] != current[i]) i++;
+        if (!runs.empty() && start - runs.back().second <= MERGE_GAP)
+            runs.back().second = i;
+        else
+            runs.emplace_back(start, i);
+    }
+    /* bytes past the recorded input are all new */
+    if (size > common) {
+        if (!runs.empty() && common - runs.back().second <= MERGE_GAP)
+            runs.back().second = size;
+        else
+            runs.emplace_back(common, size);
+    }
+
+    out->Add((uint32_t)size);
+    out->Add((uint32_t)runs.size());
+    for (auto &run : runs) {
+        out->Add((uint32_t)run.first);
+        out->Add((uint32_t)(run.second - run.first));
+        out->Add(current + run.first, run.second - run.first);
+    }
+}
+
+void MacroDelta::Apply(Buffer *in, std::vector<char> *input) {
+    input->resize(in->Get<uint32_t>());
+    uint32_t runs = in->Get<uint32_t>();
+    for (uint32_t i = 0; i < runs; i++) {
+        size_t offset = in->Get<uint32_t>();
+        size_t length = in->Get<uint32_t>();
+        if (offset + length > input->size())
+            throw std::runtime_error("MacroDelta::Apply(): run past the end of the input");
+        memcpy(input->data() + offset, in->Assign<char>(length), length);
+    }
+}
@@ -1,5 +1,6 @@
 #include "gvirtus/communicators/Result.h"
 
+using gvirtus::communicators::Buffer;
 using gvirtus::communicators::Result;
 
 Result::Result(int exit_code) {
@@ -14,6 +15,8 @@ Result::Result(int exit_code, const std::shared_ptr<Buffer> output_buffer) {
 
 int Result::GetExitCode() { return mExitCode; }
 
+std::shared_ptr<Buffer> Result::GetOutputBuffer() const { return mpOutputBuffer; }
+
 void Result::Dump(Communicator *c) {
     c->Write((char *)&mExitCode, sizeof(int));
     c->Write(reinterpret_cast<const char *>(&mTimeTaken), sizeof(mTimeTaken));
@@ -35,10 +35,11 @@
 
 #ifndef _WIN32
 
-#include "ShmCommunicator.h"
+#include "gvirtus/communicators/ShmCommunicator.h"
 
 #include <arpa/inet.h>
 #include <errno.h>
+#include <gvirtus/communicators/Endpoint_Shm.h>
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <sys/mman.h>
@@ -51,15 +52,21 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <stdexcept>
 
 using namespace std;
 
-namespace gvirtus {
+namespace gvirtus::communicators {
 
 ShmCommunicator::ShmCommunicator(const std::string &communicator) {}
 
 ShmCommunicator::ShmCommunicator() {}
 
+ShmCommunicator::ShmCommunicator(const std::string &address, uint16_t port) {
+    mAddress = address;
+    mPort = port;
+}
+
 ShmCommunicator::ShmCommunicator(const char *name) {
     shm_unlink(name);
 
@@ -119,7 +126,7 @@ void ShmCommunicator::Serve() {
         throw runtime_error("ShmCommunicator: Socket creation error");
     memset((void *)&addr, 0, sizeof(addr));   /* clear server address */
     addr.sin_family = AF_INET;                /* address type is INET */
-    addr.sin_port = htons(6666);              /* daytime port is 13 */
+    addr.sin_port = htons(mPort);
     addr.sin_addr.s_addr = htonl(INADDR_ANY); /* connect from anywhere */
     /* bind socket */
     if (bind(mSocketFd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
@@ -145,9 +152,9 @@ void ShmCommunicator::Connect() {
     if ((mSocketFd = socket(AF_INET, SOCK_DGRAM, 0)) < 0)
         throw runtime_error("ShmCommunicator: Socket creation error");
     memset((void *)&addr, 0, sizeof(addr)); /* clear server address */
-    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
-    addr.sin_family = AF_INET;   /* address type is INET */
-    addr.sin_port = htons(6666); /* daytime port is 13 */
+    addr.sin_addr.s_addr = inet_addr(mAddress.c_str());
+    addr.sin_family = AF_INET; /* address type is INET */
+    addr.sin_port = htons(mPort);
     /* build address using inet_pton */
     memset(name, 0, 1024);
     sendto(mSocketFd, name, 1024, 0, (struct sockaddr *)&addr, sizeof(addr));
@@ -163,6 +170,9 @@ void ShmCommunicator::Connect() {
         mmap(NULL, 2 * 1024 * 1024, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0));
     if (mpShm == MAP_FAILED) throw runtime_error("ShmCommunicator: cannot map shared memory");
 
+    /* both peers are attached now, drop the name so it doesn't outlive them */
+    shm_unlink(name);
+
     size_t offset = 0;
     /* semaphores */
     mpOutEmpty = reinterpret_cast<sem_t *>(mpShm + offset);
@@ -288,5 +298,12 @@ void ShmCommunicator::Close() {
     sem_post(mpOutFull);
 }
 
-}  // namespace gvirtus
+}  // namespace gvirtus::communicators
+
+extern "C" std::shared_ptr<gvirtus::communicators::ShmCommunicator> create_communicator(
+    std::shared_ptr<gvirtus::communicators::Endpoint> end) {
+    auto shm_end = std::dynamic_pointer_cast<gvirtus::communicators::Endpoint_Shm>(end);
+    return std::make_shared<gvirtus::communicators::ShmCommunicator>(shm_end->address(),
+                                                                      shm_end->port());
+}
 #endif
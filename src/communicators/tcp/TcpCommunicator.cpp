@@ -130,7 +130,7 @@ void TcpCommunicator::Serve() {
     socket_addr.sin_port = htons(mPort);
     socket_addr.sin_addr.s_addr = INADDR_ANY;
 
-    char on = 1;
+    int on = 1;
     setsockopt(mSocketFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
 
     int bindResult = bind(mSocketFd, (struct sockaddr *)&socket_addr, sizeof(struct sockaddr_in));
@@ -173,6 +173,26 @@ const gvirtus::communicators::Communicator *const TcpCommunicator::Accept() cons
     return new TcpCommunicator(client_socket_fd, inet_ntoa(client_socket_addr.sin_addr));
 }
 
+int TcpCommunicator::AcceptSocket() const {
+    int client_socket_fd;
+    do {
+        client_socket_fd = accept(mSocketFd, nullptr, nullptr);
+    } while (client_socket_fd < 0 && errno == EINTR);
+    return client_socket_fd;
+}
+
+const gvirtus::communicators::Communicator *const TcpCommunicator::Adopt(int fd) const {
+    struct sockaddr_in client_socket_addr;
+#ifndef _WIN32
+    socklen_t client_socket_addr_size = sizeof(struct sockaddr_in);
+#else
+    int client_socket_addr_size = sizeof(struct sockaddr_in);
+#endif
+    if (getpeername(fd, (sockaddr *)&client_socket_addr, &client_socket_addr_size) != 0)
+        return nullptr;
+    return new TcpCommunicator(fd, inet_ntoa(client_socket_addr.sin_addr));
+}
+
 void TcpCommunicator::Connect() {
 #ifdef DEBUG
     cout << "TcpCommunicator::Connect() called " < < < < endl;
@@ -199,7 +219,14 @@ void TcpCommunicator::Connect() {
 #endif
 }
 
-void TcpCommunicator::Close() {}
+void TcpCommunicator::Close() {
+    /* the peer reads the end of the stream and ends its session */
+#ifdef _WIN32
+    shutdown(mSocketFd, SD_BOTH);
+#else
+    shutdown(mSocketFd, SHUT_RDWR);
+#endif
+}
 
 size_t TcpCommunicator::Read(char *buffer, size_t size) {
 #ifdef DEBUG
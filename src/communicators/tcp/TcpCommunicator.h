@@ -56,6 +56,8 @@ class TcpCommunicator : public Communicator {
     virtual ~TcpCommunicator();
     void Serve();
     const Communicator *const Accept() const;
+    int AcceptSocket() const override;
+    const Communicator *const Adopt(int fd) const override;
     void Connect();
     size_t Read(char *buffer, size_t size);
     size_t Write(const char *buffer, size_t size);
@@ -0,0 +1,225 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gvirtus/communicators/Buffer.h>
+#include <gvirtus/communicators/CommunicatorFactory.h>
+#include <gvirtus/communicators/EndpointFactory.h>
+#include <gvirtus/frontend/EndpointGroup.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+#include "communicators/hybrid/HybridCommunicator.h"
+#include "log4cplus/loggingmacros.h"
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+using gvirtus::communicators::Buffer;
+using gvirtus::communicators::Communicator;
+using gvirtus::communicators::CommunicatorFactory;
+using gvirtus::communicators::EndpointFactory;
+using gvirtus::communicators::LoadReport;
+using gvirtus::frontend::EndpointGroup;
+
+EndpointGroup *EndpointGroup::GetInstance(const std::string &path) {
+    static std::mutex mutex;
+    static std::unique_ptr<EndpointGroup> group;
+    static bool read = false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (read) return group.get();
+    read = true;
+
+    std::ifstream ifs(path);
+    if (!ifs.is_open()) return nullptr;
+    nlohmann::json j;
+    ifs >> j;
+    if (!j.contains("group")) return nullptr;
+
+    std::string policy = j["group"].value("policy", "least-loaded");
+    if (policy == "least-loaded")
+        group.reset(new EndpointGroup(path, Policy::LeastLoaded));
+    else if (policy == "hash")
+        group.reset(new EndpointGroup(path, Policy::Hash));
+    else
+        throw std::runtime_error("Unknown group policy '" + policy + "' in the configuration.");
+    return group.get();
+}
+
+EndpointGroup::EndpointGroup(const std::string &path, Policy policy) : mPolicy(policy) {
+    logger = log4cplus::Logger::getInstance(LOG4CPLUS_TEXT("EndpointGroup"));
+    size_t backends = EndpointFactory::count(path);
+    for (size_t i = 0; i < backends; i++)
+        mEndpoints.push_back(EndpointFactory::get_endpoint(path, i));
+}
+
+EndpointGroup::Connection EndpointGroup::Connect(
+    std::shared_ptr<communicators::Endpoint> *endpoint) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mConnected) {
+        /* the sessions of the process hold state there that another backend lacks */
+        size_t backend = mRanking[mCurrent];
+        try {
+            auto connection = CommunicatorFactory::get_communicator(mEndpoints[backend]);
+            connection->obj_ptr()->Connect();
+            *endpoint = mEndpoints[backend];
+            return connection;
+        } catch (const std::exception &e) {
+            throw std::runtime_error("Backend " + std::to_string(backend) +
+                                     " of the process cannot be reached (" + e.what() +
+                                     "); its state cannot move to another backend of the group.");
+        }
+    }
+
+    if (mRanking.empty()) Rank();
+    for (; mCurrent < mRanking.size(); mCurrent++) {
+        size_t backend = mRanking[mCurrent];
+        try {
+            auto connection = CommunicatorFactory::get_communicator(mEndpoints[backend]);
+            connection->obj_ptr()->Connect();
+            *endpoint = mEndpoints[backend];
+            mConnected = true;
+            return connection;
+        } catch (const std::exception &e) {
+            LOG4CPLUS_WARN(logger, "Backend " << backend << " cannot be reached (" << e.what()
+                                              << "), trying the next one");
+        }
+    }
+
+    /* the next thread ranks the backends again, as no session exists yet */
+    mRanking.clear();
+    mCurrent = 0;
+    throw std::runtime_error("No backend of the group can be reached.");
+}
+
+static uint64_t Mix(uint64_t x) {
+    /* the finalizer of splitmix64 */
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static uint64_t Hash(const std::string &key, const std::string &endpoint) {
+    /* FNV-1a, stable across processes and builds */
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : key + '\0' + endpoint) hash = (hash ^ c) * 0x100000001b3ULL;
+    return Mix(hash);
+}
+
+void EndpointGroup::Rank() {
+    mRanking.resize(mEndpoints.size());
+    for (size_t i = 0; i < mRanking.size(); i++) mRanking[i] = i;
+
+    if (mPolicy == Policy::Hash) {
+        const char *env = getenv("GVIRTUS_AFFINITY");
+        std::string key;
+        if (env != nullptr && *env != '\0') {
+            key = env;
+        } else {
+            char host[256] = {};
+            gethostname(host, sizeof(host) - 1);
+            key = host;
+        }
+        std::vector<uint64_t> weights(mEndpoints.size());
+        for (size_t i = 0; i < weights.size(); i++)
+            weights[i] = Hash(key, mEndpoints[i]->to_string());
+        std::stable_sort(mRanking.begin(), mRanking.end(),
+                         [&](size_t a, size_t b) { return weights[a] > weights[b]; });
+        LOG4CPLUS_INFO(logger, "Affinity " << key << " selects backend " << mRanking[0]);
+        return;
+    }
+
+    struct Candidate {
+        /* 0 reported its load, 1 did not, 2 cannot be reached */
+        int state = 2;
+        LoadReport load = {};
+        double rtt = 0;
+    };
+    std::vector<Candidate> candidates(mEndpoints.size());
+    for (size_t i = 0; i < candidates.size(); i++) {
+        Candidate &candidate = candidates[i];
+        bool reported = false;
+        if (Probe(i, &candidate.load, &reported, &candidate.rtt))
+            candidate.state = reported ? 0 : 1;
+        LOG4CPLUS_DEBUG(logger, "Backend " << i << ": state " << candidate.state << ", "
+                                           << candidate.load.sessions << " session(s), "
+                                           << candidate.load.running << " running, "
+                                           << candidate.load.waiting << " waiting, "
+                                           << candidate.load.memoryFree << " bytes free, rtt "
+                                           << candidate.rtt * 1e3 << " ms");
+    }
+    std::stable_sort(mRanking.begin(), mRanking.end(), [&](size_t a, size_t b) {
+        const Candidate &x = candidates[a], &y = candidates[b];
+        if (x.state != y.state) return x.state < y.state;
+        uint64_t xBusy = (uint64_t)x.load.sessions + x.load.running + x.load.waiting;
+        uint64_t yBusy = (uint64_t)y.load.sessions + y.load.running + y.load.waiting;
+        if (xBusy != yBusy) return xBusy < yBusy;
+        if (x.load.memoryFree != y.load.memoryFree) return x.load.memoryFree > y.load.memoryFree;
+        return x.rtt < y.rtt;
+    });
+    LOG4CPLUS_INFO(logger, "Least loaded backend: " << mRanking[0] << " ("
+                                                    << candidates[mRanking[0]].load.sessions
+                                                    << " session(s))");
+}
+
+bool EndpointGroup::Probe(size_t backend, LoadReport *load, bool *reported, double *rtt) {
+    try {
+        auto connection = CommunicatorFactory::get_communicator(mEndpoints[backend]);
+        Communicator *communicator = connection->obj_ptr().get();
+        communicator->Connect();
+
+        /* a call as Frontend::Send() makes it, on a connection of its own */
+        auto start = steady_clock::now();
+        const char routine[] = "gvirtusLoad";
+        auto *hybrid = dynamic_cast<gvirtus::communicators::HybridCommunicator *>(communicator);
+        communicator->Write(routine, sizeof(routine));
+        if (hybrid != nullptr)
+            hybrid->begin_call(routine, gvirtus::communicators::Transport::TCP, 0);
+        Buffer().Dump(communicator);
+        communicator->Sync();
+
+        int exit_code = -1;
+        double server_time = 0;
+        size_t size = 0;
+        communicator->Read((char *)&exit_code, sizeof(int));
+        communicator->Read((char *)&server_time, sizeof(server_time));
+        communicator->Read((char *)&size, sizeof(size_t));
+        Buffer out;
+        if (size > 0) out.Read<char>(communicator, size);
+        *rtt = duration<double>(steady_clock::now() - start).count();
+        if (hybrid != nullptr) hybrid->end_call();
+        communicator->Close();
+
+        /* a backend without gvirtusLoad is ranked after those that report */
+        *reported = exit_code == 0 && size >= sizeof(LoadReport);
+        if (*reported) *load = out.Get<LoadReport>();
+        return true;
+    } catch (const std::exception &e) {
+        LOG4CPLUS_WARN(logger, "Backend " << backend << " cannot be reached: " << e.what());
+        return false;
+    }
+}
@@ -35,7 +35,10 @@
 
 #include <gvirtus/communicators/CommunicatorFactory.h>
 #include <gvirtus/communicators/EndpointFactory.h>
+#include <gvirtus/frontend/EndpointGroup.h>
 #include <gvirtus/frontend/Frontend.h>
+#include <gvirtus/frontend/Macros.h>
+#include <gvirtus/frontend/Trace.h>
 #include <pthread.h>
 #include <stdlib.h> /* getenv */
 #include <sys/syscall.h>
@@ -46,6 +49,7 @@
 #include <filesystem>
 #include <iostream>
 #include <mutex>
+#include <random>
 
 #include "communicators/hybrid/HybridCommunicator.h"
 #include "log4cplus/configurator.h"
@@ -63,13 +67,37 @@ using gvirtus::communicators::Buffer;
 using gvirtus::communicators::Communicator;
 using gvirtus::communicators::CommunicatorFactory;
 using gvirtus::communicators::EndpointFactory;
+using gvirtus::frontend::EndpointGroup;
 using gvirtus::frontend::Frontend;
+using gvirtus::frontend::Macros;
+using gvirtus::frontend::TraceWriter;
 
 static Frontend msFrontend;
 std::mutex gFrontendMutex;
 map<pthread_t, Frontend *> *Frontend::mpFrontends = NULL;
 static bool initialized = false;
 
+namespace gvirtus::frontend {
+/*
+ * The Frontend of a thread and the thread's tid, so that the marshalling
+ * calls reach them without a syscall or a lock. mpFrontends is only touched
+ * when a thread connects and when it exits.
+ */
+struct ThreadContext {
+    Frontend *frontend = nullptr;
+    pid_t tid = 0;
+
+    ~ThreadContext();
+};
+}  // namespace gvirtus::frontend
+
+using gvirtus::frontend::ThreadContext;
+
+static thread_local ThreadContext tsContext;
+
+static std::mutex gConnectHooksMutex;
+static std::vector<void (*)(size_t)> gConnectHooks;
+
 Logger logger;
 
 std::string getEnvVar(std::string const &key) {
@@ -100,8 +128,6 @@ void Frontend::Init(Communicator *c) {
 
     logger = Logger::getInstance(LOG4CPLUS_TEXT("Frontend"));
 
-    pid_t tid = syscall(SYS_gettid);
-
     // Get the GVIRTUS_CONFIG environment varibale
     std::string config_path = getEnvVar("GVIRTUS_CONFIG");
 
@@ -115,25 +141,27 @@ void Frontend::Init(Communicator *c) {
         }
     }
 
-    std::unique_ptr<char> default_endpoint;
-
-    // no frontend found
-    {
-        std::lock_guard<std::mutex> lock(gFrontendMutex);
-        if (mpFrontends->find(tid) == mpFrontends->end()) {
-            Frontend *f = new Frontend();
-            mpFrontends->insert(make_pair(tid, f));
-        }
-    }
-
     LOG4CPLUS_INFO(logger, "Using properties file: " + config_path);
 
     try {
-        auto endpoint = EndpointFactory::get_endpoint(config_path);
-
-        mpFrontends->find(tid)->second->_communicator =
-            CommunicatorFactory::get_communicator(endpoint);
-        mpFrontends->find(tid)->second->_communicator->obj_ptr()->Connect();
+        EndpointGroup *group = EndpointGroup::GetInstance(config_path);
+        if (group != nullptr) {
+            // Replicas: the threads of the process use the one the group picked.
+            mEndpoints.resize(1);
+            _communicator = group->Connect(&mEndpoints[0]);
+            mCommunicators.push_back(_communicator);
+        } else {
+            // Every backend of the configuration; the thread connects to the
+            // first one now and to the others when it first selects them.
+            size_t backends = EndpointFactory::count(config_path);
+            for (size_t i = 0; i < backends; i++)
+                mEndpoints.push_back(EndpointFactory::get_endpoint(config_path, i));
+            mCommunicators.resize(backends);
+
+            _communicator = CommunicatorFactory::get_communicator(mEndpoints[0]);
+            _communicator->obj_ptr()->Connect();
+            mCommunicators[0] = _communicator;
+        }
     } catch (const std::exception &e) {
         LOG4CPLUS_FATAL(logger, fs::path(__FILE__).filename()
                                     << ":" << __LINE__ << ":"
@@ -141,88 +169,193 @@ void Frontend::Init(Communicator *c) {
         exit(EXIT_FAILURE);
     }
 
-    mpFrontends->find(tid)->second->mpInputBuffer = std::make_shared<Buffer>();
-    mpFrontends->find(tid)->second->mpOutputBuffer = std::make_shared<Buffer>();
-    mpFrontends->find(tid)->second->mpLaunchBuffer = std::make_shared<Buffer>();
-    mpFrontends->find(tid)->second->mExitCode = -1;
-    mpFrontends->find(tid)->second->mpInitialized = true;
+    // GetFrontend() registers this instance for the calling thread once Init()
+    // returns, so everything is set up on this object rather than on a
+    // second one looked up by tid.
+    mpInputBuffer = std::make_shared<Buffer>();
+    mpOutputBuffer = std::make_shared<Buffer>();
+    mpLaunchBuffer = std::make_shared<Buffer>();
+    mExitCode = -1;
+    mpInitialized = true;
 }
 
-Frontend::~Frontend() {
-    static bool destroying = false;
-    if (destroying || mpFrontends == nullptr) return;
-    destroying = true;
-
-    std::lock_guard<std::mutex> lock(gFrontendMutex);
-    {
-        pid_t tid = syscall(SYS_gettid);
-
-        auto env = getenv("GVIRTUS_DUMP_STATS");
-        bool dump_stats = env && (strcasecmp(env, "on") == 0 || strcasecmp(env, "true") == 0 ||
-                                  strcmp(env, "1") == 0);
-
-        // Safe iteration while erasing entries
-        for (auto it = mpFrontends->begin(); it != mpFrontends->end(); /* no increment here */) {
-            if (it->second == this) {
-                it = mpFrontends->erase(it);
-                continue;
-            }
+static bool DumpStats() {
+    auto env = getenv("GVIRTUS_DUMP_STATS");
+    return env &&
+           (strcasecmp(env, "on") == 0 || strcasecmp(env, "true") == 0 || strcmp(env, "1") == 0);
+}
 
-            if (dump_stats) {
-                std::cerr << "[GVIRTUS_STATS] Executed " << it->second->mRoutinesExecuted
-                          << " routine(s) in " << it->second->mRoutineExecutionTime
-                          << " second(s)\n"
-                          << "[GVIRTUS_STATS] Sent " << it->second->mDataSent / (1024 * 1024.0)
-                          << " Mb(s) in " << it->second->mSendingTime << " second(s)\n"
-                          << "[GVIRTUS_STATS] Received "
-                          << it->second->mDataReceived / (1024 * 1024.0) << " Mb(s) in "
-                          << it->second->mReceivingTime << " second(s)\n";
-            }
+ThreadContext::~ThreadContext() {
+    // The frontend of the main thread is still needed by the exit handlers of
+    // the plugins; ~Frontend() of msFrontend releases it.
+    if (frontend == nullptr || tid == getpid()) return;
 
-            delete it->second;
-            it = mpFrontends->erase(it);
+    Frontend *released = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(gFrontendMutex);
+        if (Frontend::mpFrontends == nullptr) return;
+        auto it = Frontend::mpFrontends->find(tid);
+        if (it != Frontend::mpFrontends->end() && it->second == frontend) {
+            Frontend::mpFrontends->erase(it);
+            released = frontend;
         }
+    }
+    frontend = nullptr;
+    delete released;
+}
 
-        // Delete the map itself and set pointer to nullptr
-        delete mpFrontends;
-        mpFrontends = nullptr;
+Frontend::~Frontend() {
+    if (this != &msFrontend) {
+        // ends the sessions of the thread, which the backends count as load
+        for (auto &communicator : mCommunicators)
+            if (communicator != nullptr) communicator->obj_ptr()->Close();
+        if (mpInitialized && DumpStats()) {
+            std::cerr << "[GVIRTUS_STATS] Executed " << mRoutinesExecuted << " routine(s) in "
+                      << mRoutineExecutionTime << " second(s)\n"
+                      << "[GVIRTUS_STATS] Sent " << mDataSent / (1024 * 1024.0) << " Mb(s) in "
+                      << mSendingTime << " second(s)\n"
+                      << "[GVIRTUS_STATS] Received " << mDataReceived / (1024 * 1024.0)
+                      << " Mb(s) in " << mReceivingTime << " second(s)\n";
+        }
+        return;
     }
+
+    // Releases the frontends of the threads still running at exit.
+    std::lock_guard<std::mutex> lock(gFrontendMutex);
+    if (mpFrontends == nullptr) return;
+    for (auto &it : *mpFrontends) delete it.second;
+    delete mpFrontends;
+    mpFrontends = nullptr;
 }
 
 Frontend *Frontend::GetFrontend(Communicator *c) {
-    {
-        std::lock_guard<std::mutex> lock(gFrontendMutex);
-        if (mpFrontends == nullptr) mpFrontends = new map<pthread_t, Frontend *>();
-    }
+    if (tsContext.frontend != nullptr) return tsContext.frontend;
 
     pid_t tid = syscall(SYS_gettid);  // getting frontend's tid
 
-    {
-        std::lock_guard<std::mutex> lock(gFrontendMutex);
-        auto it = mpFrontends->find(tid);
-        if (it != mpFrontends->end()) return it->second;
-    }
-
     Frontend *f = new Frontend();
     try {
         f->Init(c);
-        {
-            std::lock_guard<std::mutex> lock(gFrontendMutex);
-            mpFrontends->insert(make_pair(tid, f));
-        }
     } catch (const std::exception &e) {
         LOG4CPLUS_ERROR(logger, "Error initializing Frontend: " << e.what());
         delete f;  // Clean up on failure
         return nullptr;
     }
 
+    Frontend *stale = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(gFrontendMutex);
+        if (mpFrontends == nullptr) mpFrontends = new map<pthread_t, Frontend *>();
+        // A thread that died without running its thread_local destructors
+        // leaves its frontend behind under a tid that is now reused.
+        Frontend *&registered = (*mpFrontends)[tid];
+        stale = registered;
+        registered = f;
+    }
+    delete stale;
+
+    tsContext.frontend = f;
+    tsContext.tid = tid;
+    f->Connected();
     return f;
 }
 
 void Frontend::Execute(const char *routine, const Buffer *input_buffer) {
     if (input_buffer == nullptr) input_buffer = mpInputBuffer.get();
 
-    pid_t tid = syscall(SYS_gettid);
+    // ===== a call of a replayed macro returns at once =====
+    Frontend *frontend = tsContext.frontend;
+    Macros *macros = frontend != nullptr ? frontend->mpMacros.get() : nullptr;
+    if (macros != nullptr && macros->Defer(routine, input_buffer)) {
+        frontend->mExitCode = 0;
+        frontend->mpOutputBuffer->Reset();
+        return;
+    }
+
+    Send(routine, input_buffer);
+
+    if (macros != nullptr) {
+        macros->Executed(routine, input_buffer, frontend->mExitCode,
+                         frontend->mpOutputBuffer->GetBufferSize());
+    }
+}
+
+bool Frontend::SetBackend(size_t backend) {
+    if (backend == mBackend) return true;
+    if (backend >= mCommunicators.size()) return false;
+    // the deferred calls go to the backend they were recorded on
+    if (mpMacros != nullptr) mpMacros->Switching();
+    return SelectBackend(backend);
+}
+
+bool Frontend::SelectBackend(size_t backend) {
+    if (backend == mBackend) return true;
+    bool connecting = mCommunicators[backend] == nullptr;
+    if (connecting) {
+        try {
+            auto communicator = CommunicatorFactory::get_communicator(mEndpoints[backend]);
+            communicator->obj_ptr()->Connect();
+            mCommunicators[backend] = communicator;
+        } catch (const std::exception &e) {
+            LOG4CPLUS_ERROR(logger, "Cannot connect to backend " << backend << ": " << e.what());
+            return false;
+        }
+    }
+    _communicator = mCommunicators[backend];
+    mBackend = backend;
+    if (connecting) Connected();
+    return true;
+}
+
+void Frontend::Connected() {
+    SendSessionProcess();
+    SendSessionClass();
+    std::vector<void (*)(size_t)> hooks;
+    {
+        std::lock_guard<std::mutex> lock(gConnectHooksMutex);
+        hooks = gConnectHooks;
+    }
+    for (auto hook : hooks) hook(mBackend);
+}
+
+void Frontend::AddConnectHook(void (*hook)(size_t backend)) {
+    std::lock_guard<std::mutex> lock(gConnectHooksMutex);
+    gConnectHooks.push_back(hook);
+}
+
+void Frontend::SendSessionProcess() {
+    // random, as the processes of other hosts reach the backend too; the pid
+    // tells a forked child from its parent
+    static const uint64_t seed = ((uint64_t)std::random_device()() << 32) | std::random_device()();
+    Buffer in;
+    in.Add(seed ^ ((uint64_t)getpid() * 0x9e3779b97f4a7c15ull));
+    Send("gvirtusSessionProcess", &in);
+}
+
+void Frontend::SendSessionClass() {
+    const char *name = getenv("GVIRTUS_SCHEDULER_CLASS");
+    if (name == nullptr || *name == '\0') return;
+    Buffer in;
+    in.AddString(name);
+    Send("gvirtusSessionClass", &in);
+    if (mExitCode != 0)
+        LOG4CPLUS_WARN(logger, "Backend " << mBackend << " has no scheduler class " << name
+                                          << ", the session keeps the default one.");
+}
+
+int Frontend::BeginMacro(const char *name) {
+    if (mpMacros == nullptr) mpMacros = std::make_unique<Macros>(this);
+    return mpMacros->Begin(name);
+}
+
+int Frontend::EndMacro() { return mpMacros != nullptr ? mpMacros->End() : -1; }
+
+uint64_t Frontend::MacroCallsDeferred() const {
+    return mpMacros != nullptr ? mpMacros->Deferred() : 0;
+}
+
+void Frontend::Send(const char *routine, const Buffer *input_buffer) {
+    pid_t tid = tsContext.tid;
     pid_t pid = getpid();
     size_t in_size = input_buffer->GetBufferSize();
     int exit_code = 0;
@@ -230,15 +363,10 @@ void Frontend::Execute(const char *routine, const Buffer *input_buffer) {
     double send_sec = 0.0;
     double recv_sec = 0.0;
 
-    Frontend *frontend = nullptr;
-    {
-        std::lock_guard<std::mutex> lock(gFrontendMutex);
-        auto it = mpFrontends->find(tid);
-        if (it == mpFrontends->end()) {
-            LOG4CPLUS_ERROR(logger, "Cannot send any job request");
-            return;
-        }
-        frontend = it->second;
+    Frontend *frontend = tsContext.frontend;
+    if (frontend == nullptr) {
+        LOG4CPLUS_ERROR(logger, "Cannot send any job request");
+        return;
     }
 
     LOG4CPLUS_DEBUG(logger, "DEBUG - Received routine " << routine << " [pid=" << pid
@@ -246,6 +374,9 @@ void Frontend::Execute(const char *routine, const Buffer *input_buffer) {
 
     frontend->mRoutinesExecuted++;
 
+    TraceWriter *trace = TraceWriter::GetInstance();
+    uint64_t trace_start = trace != nullptr ? trace->Now() : 0;
+
     // ===== send routine info first（under TCP）=====
     auto start_send = steady_clock::now();
     frontend->_communicator->obj_ptr()->Write(routine, strlen(routine) + 1);
@@ -299,6 +430,12 @@ void Frontend::Execute(const char *routine, const Buffer *input_buffer) {
     }
     recv_sec = duration_cast<milliseconds>(steady_clock::now() - start_recv).count() / 1000.0;
 
+    if (trace != nullptr) {
+        trace->Call(routine, tid, trace_start, trace->Now() - trace_start,
+                    input_buffer->GetBuffer(), in_size, exit_code,
+                    frontend->mpOutputBuffer->GetBuffer(), out_buffer_size);
+    }
+
     // ===== update info =====
     frontend->mRoutineExecutionTime += server_exec_sec;
     frontend->mSendingTime += send_sec;
@@ -326,9 +463,5 @@ void Frontend::Execute(const char *routine, const Buffer *input_buffer) {
 }
 
 void Frontend::Prepare() {
-    pid_t tid = syscall(SYS_gettid);
-    {
-        if (this->mpFrontends->find(tid) != mpFrontends->end())
-            mpFrontends->find(tid)->second->mpInputBuffer->Reset();
-    }
+    if (tsContext.frontend != nullptr) tsContext.frontend->mpInputBuffer->Reset();
 }
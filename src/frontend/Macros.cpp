@@ -0,0 +1,236 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gvirtus/communicators/MacroDelta.h>
+#include <gvirtus/frontend/Frontend.h>
+#include <gvirtus/frontend/Macros.h>
+
+#include <cstring>
+#include <mutex>
+#include <set>
+
+#include "log4cplus/logger.h"
+#include "log4cplus/loggingmacros.h"
+
+using gvirtus::communicators::Buffer;
+using gvirtus::communicators::MacroDelta;
+using gvirtus::frontend::Frontend;
+using gvirtus::frontend::Macros;
+
+namespace {
+std::mutex gDeferrableMutex;
+
+std::set<std::string> &Deferrable() {
+    static std::set<std::string> routines;
+    return routines;
+}
+}  // namespace
+
+bool Macros::AllowDeferring(std::initializer_list<const char *> routines) {
+    std::lock_guard<std::mutex> lock(gDeferrableMutex);
+    for (auto routine : routines) Deferrable().insert(routine);
+    return true;
+}
+
+Macros::Macros(Frontend *frontend) : mpFrontend(frontend) {
+    logger = log4cplus::Logger::getInstance(LOG4CPLUS_TEXT("Macros"));
+}
+
+int Macros::Begin(const std::string &name) {
+    if (mMode != Mode::Idle || mDisabled) return -1;
+    mName = name;
+    mError = 0;
+    auto it = mMacros.find(name);
+    if (it != mMacros.end() && it->second.backend != mpFrontend->GetBackend()) {
+        /* recorded while the thread used another device */
+        mpMacro = &it->second;
+        Forget();
+        it = mMacros.end();
+    }
+    if (it == mMacros.end()) {
+        mpMacro = &mMacros[name];
+        mpMacro->id = mNextId++;
+        mpMacro->backend = mpFrontend->GetBackend();
+        mMode = Mode::Recording;
+        return 0;
+    }
+    mpMacro = &it->second;
+    mPosition = mFirst = 0;
+    mDeltas.Reset();
+    mChanged = 0;
+    mMode = Mode::Replaying;
+    return 0;
+}
+
+int Macros::End() {
+    switch (mMode) {
+        case Mode::Idle:
+            return -1;
+        case Mode::Recording:
+            Define();
+            break;
+        case Mode::Replaying:
+            Flush();
+            break;
+        case Mode::Diverged:
+            break;
+    }
+    /* a region that differed from its macro is recorded again the next time */
+    if (mMode == Mode::Diverged) Forget();
+    mMode = Mode::Idle;
+    return mError;
+}
+
+bool Macros::Defer(const char *routine, const Buffer *input_buffer) {
+    if (mMode != Mode::Replaying) return false;
+    auto &calls = mpMacro->calls;
+    if (mPosition >= calls.size() || calls[mPosition].routine != routine) {
+        LOG4CPLUS_DEBUG(logger, "Macro " << mName << " diverged at call " << mPosition
+                                                 << ", " << routine);
+        Flush();
+        mMode = Mode::Diverged;
+        return false;
+    }
+
+    Call &call = calls[mPosition];
+    const char *input = input_buffer->GetBuffer();
+    size_t size = input_buffer->GetBufferSize();
+    if (!call.deferrable || size > UINT32_MAX) {
+        /* the calls before it run first, then it runs as usual */
+        Flush();
+        if (mMode == Mode::Replaying) mFirst = ++mPosition;
+        return false;
+    }
+    if (size != call.input.size() || memcmp(input, call.input.data(), size) != 0) {
+        mDeltas.Add((uint32_t)mPosition);
+        MacroDelta::Encode(call.input, input, size, &mDeltas);
+        mChanged++;
+    }
+    mPosition++;
+    mDeferred++;
+    return true;
+}
+
+void Macros::Executed(const char *routine, const Buffer *input_buffer, int exit_code,
+                      size_t output_size) {
+    if (mMode != Mode::Recording) return;
+    Call call;
+    call.routine = routine;
+    {
+        std::lock_guard<std::mutex> lock(gDeferrableMutex);
+        call.deferrable = Deferrable().count(routine) > 0;
+    }
+    call.deferrable = call.deferrable && exit_code == 0 && output_size == 0 &&
+                      input_buffer->GetBufferSize() <= UINT32_MAX;
+    /* only the inputs of deferrable calls are replayed */
+    if (call.deferrable)
+        call.input.assign(input_buffer->GetBuffer(),
+                          input_buffer->GetBuffer() + input_buffer->GetBufferSize());
+    mpMacro->calls.push_back(std::move(call));
+}
+
+void Macros::Switching() {
+    if (mMode == Mode::Replaying) Flush();
+    if (mMode != Mode::Idle) mMode = Mode::Diverged;
+}
+
+void Macros::Define() {
+    auto &calls = mpMacro->calls;
+    if (calls.empty()) {
+        mMacros.erase(mName);
+        return;
+    }
+    Buffer request;
+    request.Add(mpMacro->id);
+    request.Add(calls.size());
+    for (auto &call : calls) {
+        request.AddString(call.routine.c_str());
+        request.Add(call.input.size());
+        request.AddConst(call.input.data(), call.input.size());
+    }
+    mpFrontend->Send("gvirtusMacroDefine", &request);
+    if (mpFrontend->GetExitCode() != 0) {
+        /* a backend without macros: the regions run as usual from now on */
+        LOG4CPLUS_WARN(logger, "The backend cannot define macros");
+        mMacros.clear();
+        mDisabled = true;
+        return;
+    }
+    LOG4CPLUS_DEBUG(logger,
+                    "Defined macro " << mName << " of " << calls.size() << " call(s)");
+}
+
+void Macros::Flush() {
+    if (mPosition == mFirst) return;
+    Buffer request;
+    request.Add(mpMacro->id);
+    request.Add((uint32_t)mFirst);
+    request.Add((uint32_t)(mPosition - mFirst));
+    request.Add(mChanged);
+    request.AddConst(mDeltas.GetBuffer(), mDeltas.GetBufferSize());
+    mpFrontend->Send("gvirtusMacroReplay", &request);
+
+    int exit_code = mpFrontend->GetExitCode();
+    if (exit_code != 0) {
+        uint32_t failed = mPosition;
+        if (mpFrontend->GetOutputBuffer()->GetBufferSize() >= sizeof(uint32_t))
+            failed = mpFrontend->GetOutputBuffer()->Get<uint32_t>();
+        LOG4CPLUS_DEBUG(logger, "Call " << failed << " of macro " << mName
+                                                << " returned " << exit_code);
+        if (mError == 0) mError = exit_code;
+        /*
+         * the calls deferred after the failed one are dropped, as launches
+         * after an asynchronous error; the rest of the region runs as usual
+         */
+        mMode = Mode::Diverged;
+    }
+    mFirst = mPosition;
+    mDeltas.Reset();
+    mChanged = 0;
+}
+
+void Macros::Forget() {
+    size_t backend = mpFrontend->GetBackend();
+    Buffer request;
+    request.Add(mpMacro->id);
+    if (mpFrontend->SelectBackend(mpMacro->backend)) {
+        mpFrontend->Send("gvirtusMacroForget", &request);
+        mpFrontend->SelectBackend(backend);
+    }
+    mMacros.erase(mName);
+    mpMacro = nullptr;
+}
+
+extern "C" int gvirtusMacroBegin(const char *name) {
+    Frontend *frontend = Frontend::GetFrontend();
+    return frontend != nullptr && name != nullptr ? frontend->BeginMacro(name) : -1;
+}
+
+extern "C" int gvirtusMacroEnd(void) {
+    Frontend *frontend = Frontend::GetFrontend();
+    return frontend != nullptr ? frontend->EndMacro() : -1;
+}
+
+extern "C" uint64_t gvirtusMacroDeferred(void) {
+    Frontend *frontend = Frontend::GetFrontend();
+    return frontend != nullptr ? frontend->MacroCallsDeferred() : 0;
+}
@@ -0,0 +1,226 @@
+/*
+ * gVirtuS -- A GPGPU transparent virtualization component.
+ *
+ * Copyright (C) 2009-2010  The University of Napoli Parthenope at Naples.
+ *
+ * This file is part of gVirtuS.
+ *
+ * gVirtuS is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * gVirtuS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with gVirtuS; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "gvirtus/frontend/Trace.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+using gvirtus::frontend::TraceCall;
+using gvirtus::frontend::TracedCall;
+using gvirtus::frontend::TraceHeader;
+using gvirtus::frontend::TraceReader;
+using gvirtus::frontend::TraceRecordHeader;
+using gvirtus::frontend::TraceRecordType;
+using gvirtus::frontend::TraceRoutineName;
+using gvirtus::frontend::TraceWriter;
+
+static inline size_t Align8(size_t size) { return (size + 7) & ~static_cast<size_t>(7); }
+
+TraceWriter::TraceWriter(const std::string &path, size_t initial_capacity) {
+    if ((mFd = open(path.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644)) < 0)
+        throw std::runtime_error("TraceWriter: can't open " + path + ": " + strerror(errno));
+    mpMap = nullptr;
+    mCapacity = 0;
+    mLength = 0;
+    Remap(Align8(std::max(initial_capacity, sizeof(TraceHeader) + sizeof(TraceRecordHeader))));
+
+    TraceHeader header = {};
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    memcpy(Reserve(sizeof(header)), &header, sizeof(header));
+    mOrigin = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now().time_since_epoch())
+                  .count();
+}
+
+TraceWriter::~TraceWriter() {
+    Close();
+    close(mFd);
+}
+
+TraceWriter *TraceWriter::GetInstance() {
+    static TraceWriter *instance = []() -> TraceWriter * {
+        const char *path = getenv("GVIRTUS_TRACE");
+        if (path == nullptr || *path == 0) return nullptr;
+        try {
+            return new TraceWriter(path);
+        } catch (const std::exception &e) {
+            std::cerr << "[GVIRTUS WARNING] Not tracing: " << e.what() << std::endl;
+            return nullptr;
+        }
+    }();
+    static bool registered = instance != nullptr && atexit([]() { GetInstance()->Close(); }) == 0;
+    (void)registered;
+    return instance;
+}
+
+void TraceWriter::Close() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mpMap == nullptr) return;
+    munmap(mpMap, mCapacity);
+    mpMap = nullptr;
+    // Drop the unused tail of the last mapping.
+    if (ftruncate(mFd, mLength) != 0) perror("TraceWriter: ftruncate");
+}
+
+uint64_t TraceWriter::Now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+               .count() -
+           mOrigin;
+}
+
+void TraceWriter::Remap(size_t capacity) {
+    if (ftruncate(mFd, capacity) != 0)
+        throw std::runtime_error(std::string("TraceWriter: can't grow trace: ") + strerror(errno));
+    void *map = mpMap == nullptr
+                    ? mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0)
+                    : mremap(mpMap, mCapacity, capacity, MREMAP_MAYMOVE);
+    if (map == MAP_FAILED)
+        throw std::runtime_error(std::string("TraceWriter: can't map trace: ") + strerror(errno));
+    mpMap = static_cast<char *>(map);
+    mCapacity = capacity;
+}
+
+char *TraceWriter::Reserve(size_t size) {
+    // Always keep room for the zero sized record that terminates the trace:
+    // ftruncate() zero fills the file, so it is written implicitly.
+    size_t required = mLength + size + sizeof(TraceRecordHeader);
+    if (required > mCapacity) {
+        size_t capacity = mCapacity;
+        while (capacity < required) capacity *= 2;
+        Remap(capacity);
+    }
+    char *dst = mpMap + mLength;
+    mLength += size;
+    return dst;
+}
+
+void TraceWriter::Call(const char *routine, uint32_t tid, uint64_t start_ns,
+                       uint64_t duration_ns, const char *input, uint64_t input_size,
+                       int32_t exit_code, const char *output, uint64_t output_size) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mpMap == nullptr) return;
+
+    // a trace that cannot grow ends there, without failing the call
+    try {
+        Record(routine, tid, start_ns, duration_ns, input, input_size, exit_code, output,
+               output_size);
+    } catch (const std::exception &e) {
+        std::cerr << "[GVIRTUS WARNING] Tracing stopped: " << e.what() << std::endl;
+        munmap(mpMap, mCapacity);
+        mpMap = nullptr;
+        if (ftruncate(mFd, mLength) != 0) perror("TraceWriter: ftruncate");
+    }
+}
+
+void TraceWriter::Record(const char *routine, uint32_t tid, uint64_t start_ns,
+                         uint64_t duration_ns, const char *input, uint64_t input_size,
+                         int32_t exit_code, const char *output, uint64_t output_size) {
+    auto it = mRoutines.find(routine);
+    if (it == mRoutines.end()) {
+        TraceRoutineName name = {static_cast<uint32_t>(mRoutines.size()),
+                                 static_cast<uint32_t>(strlen(routine))};
+        size_t size = Align8(sizeof(TraceRecordHeader) + sizeof(name) + name.name_length);
+        char *dst = Reserve(size);
+        TraceRecordHeader header = {size, TraceRecordType::RoutineName, 0};
+        memcpy(dst, &header, sizeof(header));
+        memcpy(dst + sizeof(header), &name, sizeof(name));
+        memcpy(dst + sizeof(header) + sizeof(name), routine, name.name_length);
+        it = mRoutines.emplace(routine, name.id).first;
+    }
+
+    TraceCall call = {it->second, tid,       start_ns,  duration_ns,
+                      input_size, output_size, exit_code, 0};
+    size_t size = Align8(sizeof(TraceRecordHeader) + sizeof(call) + input_size + output_size);
+    char *dst = Reserve(size);
+    TraceRecordHeader header = {size, TraceRecordType::Call, 0};
+    memcpy(dst, &header, sizeof(header));
+    dst += sizeof(header);
+    memcpy(dst, &call, sizeof(call));
+    dst += sizeof(call);
+    if (input_size > 0) memcpy(dst, input, input_size);
+    dst += input_size;
+    if (output_size > 0) memcpy(dst, output, output_size);
+}
+
+TraceReader::TraceReader(const std::string &path) {
+    if ((mFd = open(path.c_str(), O_RDONLY)) < 0)
+        throw std::runtime_error("TraceReader: can't open " + path + ": " + strerror(errno));
+    struct stat st;
+    if (fstat(mFd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(TraceHeader)) {
+        close(mFd);
+        throw std::runtime_error("TraceReader: " + path + " is not a trace");
+    }
+    mLength = st.st_size;
+    void *map = mmap(nullptr, mLength, PROT_READ, MAP_PRIVATE, mFd, 0);
+    if (map == MAP_FAILED) {
+        close(mFd);
+        throw std::runtime_error("TraceReader: can't map " + path + ": " + strerror(errno));
+    }
+    mpMap = static_cast<char *>(map);
+
+    auto header = reinterpret_cast<const TraceHeader *>(mpMap);
+    if (memcmp(header->magic, TRACE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != TRACE_VERSION) {
+        munmap(mpMap, mLength);
+        close(mFd);
+        throw std::runtime_error("TraceReader: " + path + " is not a version " +
+                                 std::to_string(TRACE_VERSION) + " trace");
+    }
+
+    size_t offset = sizeof(TraceHeader);
+    while (offset + sizeof(TraceRecordHeader) <= mLength) {
+        auto record = reinterpret_cast<const TraceRecordHeader *>(mpMap + offset);
+        if (record->size == 0 || offset + record->size > mLength) break;
+        const char *payload = mpMap + offset + sizeof(TraceRecordHeader);
+        if (record->type == TraceRecordType::RoutineName) {
+            auto name = reinterpret_cast<const TraceRoutineName *>(payload);
+            mRoutines[name->id] = std::string(payload + sizeof(*name), name->name_length);
+        } else if (record->type == TraceRecordType::Call) {
+            auto call = reinterpret_cast<const TraceCall *>(payload);
+            auto routine = mRoutines.find(call->routine_id);
+            if (routine == mRoutines.end())
+                throw std::runtime_error("TraceReader: call to an undeclared routine");
+            const char *input = payload + sizeof(*call);
+            mCalls.push_back({&routine->second, call->tid, call->start_ns, call->duration_ns,
+                              input, call->input_size, call->exit_code, input + call->input_size,
+                              call->output_size});
+        }
+        offset += record->size;
+    }
+}
+
+TraceReader::~TraceReader() {
+    munmap(mpMap, mLength);
+    close(mFd);
+}
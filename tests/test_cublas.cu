@@ -433,6 +433,173 @@ TEST(cuBLAS, SetWorkspace) {
     CUBLAS_CHECK(cublasDestroy(handle));
 }
 
+TEST(cuBLAS, SetGetMatrixSubmatrix) {
+    // A 3x2 block of a 5x4 host matrix goes into a 4x2 device matrix
+    const int rows = 3, cols = 2, lda = 5, ldb = 4;
+    float h_A[lda * 4];
+    for (int i = 0; i < lda * 4; ++i) h_A[i] = (float)i;
+
+    float* d_B;
+    CUDA_CHECK(cudaMalloc(&d_B, ldb * cols * sizeof(float)));
+    CUDA_CHECK(cudaMemset(d_B, 0, ldb * cols * sizeof(float)));
+    CUBLAS_CHECK(cublasSetMatrix(rows, cols, sizeof(float), h_A, lda, d_B, ldb));
+
+    float h_B[ldb * cols];
+    CUDA_CHECK(cudaMemcpy(h_B, d_B, sizeof(h_B), cudaMemcpyDeviceToHost));
+    for (int j = 0; j < cols; ++j) {
+        for (int i = 0; i < ldb; ++i) {
+            ASSERT_FLOAT_EQ(h_B[j * ldb + i], i < rows ? h_A[j * lda + i] : 0.0f);
+        }
+    }
+
+    // And back into a host matrix of leading dimension 6, leaving its padding alone
+    const int ldc = 6;
+    float h_C[ldc * cols];
+    for (int i = 0; i < ldc * cols; ++i) h_C[i] = -1.0f;
+    CUBLAS_CHECK(cublasGetMatrix(rows, cols, sizeof(float), d_B, ldb, h_C, ldc));
+    for (int j = 0; j < cols; ++j) {
+        for (int i = 0; i < ldc; ++i) {
+            ASSERT_FLOAT_EQ(h_C[j * ldc + i], i < rows ? h_A[j * lda + i] : -1.0f);
+        }
+    }
+
+    // A leading dimension shorter than a column is rejected on either side
+    ASSERT_EQ(cublasSetMatrix(rows, cols, sizeof(float), h_A, rows - 1, d_B, ldb),
+              CUBLAS_STATUS_INVALID_VALUE);
+    ASSERT_EQ(cublasGetMatrix(rows, cols, sizeof(float), d_B, ldb, h_C, rows - 1),
+              CUBLAS_STATUS_INVALID_VALUE);
+
+    CUDA_CHECK(cudaFree(d_B));
+}
+
+TEST(cuBLAS, SetGetVectorStrided) {
+    const int n = 4;
+    double h_x[3 * n];
+    for (int i = 0; i < 3 * n; ++i) h_x[i] = (double)i;
+
+    double* d_y;
+    CUDA_CHECK(cudaMalloc(&d_y, 2 * n * sizeof(double)));
+    CUDA_CHECK(cudaMemset(d_y, 0, 2 * n * sizeof(double)));
+    CUBLAS_CHECK(cublasSetVector(n, sizeof(double), h_x, 3, d_y, 2));
+
+    double h_y[2 * n];
+    CUDA_CHECK(cudaMemcpy(h_y, d_y, sizeof(h_y), cudaMemcpyDeviceToHost));
+    for (int i = 0; i < 2 * n; ++i) {
+        ASSERT_DOUBLE_EQ(h_y[i], i % 2 == 0 ? h_x[3 * (i / 2)] : 0.0);
+    }
+
+    double h_z[n];
+    CUBLAS_CHECK(cublasGetVector(n, sizeof(double), d_y, 2, h_z, 1));
+    for (int i = 0; i < n; ++i) {
+        ASSERT_DOUBLE_EQ(h_z[i], h_x[3 * i]);
+    }
+
+    CUDA_CHECK(cudaFree(d_y));
+}
+
+TEST(cuBLAS, DevicePointerMode) {
+    cublasHandle_t handle;
+    CUBLAS_CHECK(cublasCreate(&handle));
+
+    cublasPointerMode_t mode;
+    CUBLAS_CHECK(cublasGetPointerMode(handle, &mode));
+    ASSERT_EQ(mode, CUBLAS_POINTER_MODE_HOST);
+    CUBLAS_CHECK(cublasSetPointerMode(handle, CUBLAS_POINTER_MODE_DEVICE));
+    CUBLAS_CHECK(cublasSetPointerMode(handle, CUBLAS_POINTER_MODE_DEVICE));
+    CUBLAS_CHECK(cublasGetPointerMode(handle, &mode));
+    ASSERT_EQ(mode, CUBLAS_POINTER_MODE_DEVICE);
+
+    const int n = 4;
+    float h_x[n] = {1, 2, 3, 4};
+    float h_y[n] = {1, 1, 1, 1};
+    float h_alpha = 2.0f;
+    float *d_x, *d_y, *d_alpha, *d_dot;
+    CUDA_CHECK(cudaMalloc(&d_x, sizeof(h_x)));
+    CUDA_CHECK(cudaMalloc(&d_y, sizeof(h_y)));
+    CUDA_CHECK(cudaMalloc(&d_alpha, sizeof(float)));
+    CUDA_CHECK(cudaMalloc(&d_dot, sizeof(float)));
+    CUDA_CHECK(cudaMemcpy(d_x, h_x, sizeof(h_x), cudaMemcpyHostToDevice));
+    CUDA_CHECK(cudaMemcpy(d_y, h_y, sizeof(h_y), cudaMemcpyHostToDevice));
+    CUDA_CHECK(cudaMemcpy(d_alpha, &h_alpha, sizeof(float), cudaMemcpyHostToDevice));
+
+    // y = 2 * x + y, then dot(x, y) = 2 * 30 + 10, both with scalars on the device
+    CUBLAS_CHECK(cublasSaxpy(handle, n, d_alpha, d_x, 1, d_y, 1));
+    CUBLAS_CHECK(cublasSdot(handle, n, d_x, 1, d_y, 1, d_dot));
+
+    float h_dot = 0.0f;
+    CUDA_CHECK(cudaMemcpy(&h_dot, d_dot, sizeof(float), cudaMemcpyDeviceToHost));
+    ASSERT_FLOAT_EQ(h_dot, 70.0f);
+
+    // Back in host mode the result comes back to the host
+    CUBLAS_CHECK(cublasSetPointerMode(handle, CUBLAS_POINTER_MODE_HOST));
+    CUBLAS_CHECK(cublasSdot(handle, n, d_x, 1, d_y, 1, &h_dot));
+    ASSERT_FLOAT_EQ(h_dot, 70.0f);
+
+    CUDA_CHECK(cudaFree(d_x));
+    CUDA_CHECK(cudaFree(d_y));
+    CUDA_CHECK(cudaFree(d_alpha));
+    CUDA_CHECK(cudaFree(d_dot));
+    CUBLAS_CHECK(cublasDestroy(handle));
+}
+
+TEST(cuBLAS, SrotmInBothPointerModes) {
+    cublasHandle_t handle;
+    CUBLAS_CHECK(cublasCreate(&handle));
+
+    const int n = 4;
+    float h_x[n] = {1, 2, 3, 4};
+    float h_y[n] = {1, 1, 1, 1};
+    // flag -1: the full H, here x = 2 * x and y = 3 * y
+    float h_param[5] = {-1.0f, 2.0f, 0.0f, 0.0f, 3.0f};
+    float *d_x, *d_y, *d_param;
+    CUDA_CHECK(cudaMalloc(&d_x, sizeof(h_x)));
+    CUDA_CHECK(cudaMalloc(&d_y, sizeof(h_y)));
+    CUDA_CHECK(cudaMalloc(&d_param, sizeof(h_param)));
+    CUDA_CHECK(cudaMemcpy(d_x, h_x, sizeof(h_x), cudaMemcpyHostToDevice));
+    CUDA_CHECK(cudaMemcpy(d_y, h_y, sizeof(h_y), cudaMemcpyHostToDevice));
+    CUDA_CHECK(cudaMemcpy(d_param, h_param, sizeof(h_param), cudaMemcpyHostToDevice));
+
+    CUBLAS_CHECK(cublasSrotm(handle, n, d_x, 1, d_y, 1, h_param));
+    CUBLAS_CHECK(cublasSetPointerMode(handle, CUBLAS_POINTER_MODE_DEVICE));
+    CUBLAS_CHECK(cublasSrotm(handle, n, d_x, 1, d_y, 1, d_param));
+
+    CUDA_CHECK(cudaMemcpy(h_x, d_x, sizeof(h_x), cudaMemcpyDeviceToHost));
+    CUDA_CHECK(cudaMemcpy(h_y, d_y, sizeof(h_y), cudaMemcpyDeviceToHost));
+    for (int i = 0; i < n; i++) {
+        ASSERT_FLOAT_EQ(h_x[i], 4.0f * (i + 1));
+        ASSERT_FLOAT_EQ(h_y[i], 9.0f);
+    }
+
+    CUDA_CHECK(cudaFree(d_x));
+    CUDA_CHECK(cudaFree(d_y));
+    CUDA_CHECK(cudaFree(d_param));
+    CUBLAS_CHECK(cublasDestroy(handle));
+}
+
+TEST(cuBLAS, CachedHandleState) {
+    cublasHandle_t handle;
+    cudaStream_t stream;
+    CUBLAS_CHECK(cublasCreate(&handle));
+    CUDA_CHECK(cudaStreamCreate(&stream));
+
+    cudaStream_t current;
+    CUBLAS_CHECK(cublasSetStream(handle, stream));
+    CUBLAS_CHECK(cublasSetStream(handle, stream));
+    CUBLAS_CHECK(cublasGetStream(handle, &current));
+    ASSERT_EQ(current, stream);
+
+    cublasMath_t math;
+    CUBLAS_CHECK(cublasSetMathMode(handle, CUBLAS_TENSOR_OP_MATH));
+    CUBLAS_CHECK(cublasGetMathMode(handle, &math));
+    ASSERT_EQ(math, CUBLAS_TENSOR_OP_MATH);
+
+    CUDA_CHECK(cudaStreamDestroy(stream));
+    CUBLAS_CHECK(cublasDestroy(handle));
+
+    // A destroyed handle has no state left to answer from
+    ASSERT_EQ(cublasGetMathMode(handle, &math), CUBLAS_STATUS_NOT_INITIALIZED);
+}
+
 TEST(cuBLASLt, MatmulDescCreateDestroy) {
     cublasLtMatmulDesc_t matmulDesc;
     CUBLAS_CHECK(cublasLtMatmulDescCreate(&matmulDesc, CUBLAS_COMPUTE_32F, CUDA_R_32F));
@@ -23,4 +23,82 @@ TEST(cudaDR, getProcAddress) {
     CUdriverProcAddressQueryResult status;
     
     CUDA_CHECK(cuGetProcAddress(symbol, &pfn, version, flags, &status));
-}
\ No newline at end of file
+}
+
+TEST(cudaDR, moduleLoadDataTwice) {
+    const char* ptx =
+        ".version 6.0\n"
+        ".target sm_50\n"
+        ".address_size 64\n"
+        ".visible .entry empty()\n"
+        "{\n"
+        "    ret;\n"
+        "}\n";
+    CUdevice device;
+    CUcontext context;
+    CUmodule first, second;
+    CUfunction function;
+    CUDA_CHECK(cuInit(0));
+    CUDA_CHECK(cuDeviceGet(&device, 0));
+    CUDA_CHECK(cuCtxCreate(&context, 0, device));
+    CUDA_CHECK(cuModuleLoadData(&first, ptx));
+    CUDA_CHECK(cuModuleLoadData(&second, ptx));
+    CUDA_CHECK(cuModuleGetFunction(&function, second, "empty"));
+    CUDA_CHECK(cuModuleUnload(first));
+    /* The function of the second load still launches after the first is unloaded. */
+    CUDA_CHECK(cuLaunchKernel(function, 1, 1, 1, 1, 1, 1, 0, nullptr, nullptr, nullptr));
+    CUDA_CHECK(cuCtxSynchronize());
+    CUDA_CHECK(cuModuleUnload(second));
+    CUDA_CHECK(cuCtxDestroy(context));
+}
+
+TEST(cudaDR, launchKernelParamsAndExtra) {
+    const char* ptx =
+        ".version 6.0\n"
+        ".target sm_50\n"
+        ".address_size 64\n"
+        ".visible .entry store(.param .u64 out, .param .u32 value)\n"
+        "{\n"
+        "    .reg .b32 %r<2>;\n"
+        "    .reg .b64 %rd<3>;\n"
+        "    ld.param.u64 %rd1, [out];\n"
+        "    ld.param.u32 %r1, [value];\n"
+        "    cvta.to.global.u64 %rd2, %rd1;\n"
+        "    st.global.u32 [%rd2], %r1;\n"
+        "    ret;\n"
+        "}\n";
+    CUdevice device;
+    CUcontext context;
+    CUmodule module;
+    CUfunction function;
+    CUdeviceptr out;
+    unsigned int value = 42, result = 0;
+    CUDA_CHECK(cuInit(0));
+    CUDA_CHECK(cuDeviceGet(&device, 0));
+    CUDA_CHECK(cuCtxCreate(&context, 0, device));
+    CUDA_CHECK(cuModuleLoadData(&module, ptx));
+    CUDA_CHECK(cuModuleGetFunction(&function, module, "store"));
+    CUDA_CHECK(cuMemAlloc(&out, sizeof(unsigned int)));
+
+    void* params[] = {&out, &value};
+    CUDA_CHECK(cuLaunchKernel(function, 1, 1, 1, 1, 1, 1, 0, NULL, params, NULL));
+    CUDA_CHECK(cuCtxSynchronize());
+    CUDA_CHECK(cuMemcpyDtoH(&result, out, sizeof(result)));
+    ASSERT_EQ(result, 42u);
+
+    struct {
+        CUdeviceptr out;
+        unsigned int value;
+    } arguments = {out, 7};
+    size_t size = sizeof(arguments);
+    void* extra[] = {CU_LAUNCH_PARAM_BUFFER_POINTER, &arguments, CU_LAUNCH_PARAM_BUFFER_SIZE,
+                     &size, CU_LAUNCH_PARAM_END};
+    CUDA_CHECK(cuLaunchKernel(function, 1, 1, 1, 1, 1, 1, 0, NULL, NULL, extra));
+    CUDA_CHECK(cuCtxSynchronize());
+    CUDA_CHECK(cuMemcpyDtoH(&result, out, sizeof(result)));
+    ASSERT_EQ(result, 7u);
+
+    CUDA_CHECK(cuMemFree(out));
+    CUDA_CHECK(cuModuleUnload(module));
+    CUDA_CHECK(cuCtxDestroy(context));
+}
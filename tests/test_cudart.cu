@@ -5,8 +5,13 @@
 
 #include <cuda.h> /* cuuint64_t */
 #include <cuda_runtime.h>
+#include <dlfcn.h>
 #include <gtest/gtest.h>
 
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
 #define CUDA_CHECK(err) ASSERT_EQ((err), cudaSuccess)
 
 __device__ int intDeviceVariable = 0;
@@ -263,3 +268,253 @@ TEST(cudaRT, EventCreateRecordSynchronizeElapsedTimeDestroy) {
     CUDA_CHECK(cudaEventDestroy(start));
     CUDA_CHECK(cudaEventDestroy(stop));
 }
+
+TEST(cudaRT, ErrorNamesAndStringsAreStable) {
+    ASSERT_STREQ(cudaGetErrorName(cudaErrorInvalidValue), "cudaErrorInvalidValue");
+    const char* str = cudaGetErrorString(cudaErrorInvalidValue);
+    ASSERT_NE(str, nullptr);
+    // served from the frontend's cache: the same pointer, no leak per call
+    ASSERT_EQ(cudaGetErrorString(cudaErrorInvalidValue), str);
+
+    int first = 0, second = 0;
+    CUDA_CHECK(cudaRuntimeGetVersion(&first));
+    CUDA_CHECK(cudaRuntimeGetVersion(&second));
+    ASSERT_GT(first, 0);
+    ASSERT_EQ(first, second);
+}
+
+__global__ void occupancySharedKernel(float* out) {
+    __shared__ float tile[4096];
+    tile[threadIdx.x] = threadIdx.x;
+    __syncthreads();
+    out[blockIdx.x * blockDim.x + threadIdx.x] = tile[(threadIdx.x + 1) % blockDim.x];
+}
+
+TEST(cudaRT, OccupancyMatchesBackend) {
+    // the frontend computes occupancy locally; GVIRTUS_CUDART_OCCUPANCY=remote asks the backend
+    const void* kernels[] = {(const void*)simpleKernel, (const void*)occupancySharedKernel};
+    for (const void* kernel : kernels) {
+        cudaFuncAttributes attr;
+        CUDA_CHECK(cudaFuncGetAttributes(&attr, kernel));
+        for (int blockSize = 32; blockSize <= attr.maxThreadsPerBlock; blockSize += 32) {
+            for (size_t dynamicSMem : {size_t(0), size_t(1024), size_t(12000)}) {
+                int local = -1, remote = -1;
+                unsetenv("GVIRTUS_CUDART_OCCUPANCY");
+                CUDA_CHECK(cudaOccupancyMaxActiveBlocksPerMultiprocessor(&local, kernel, blockSize,
+                                                                         dynamicSMem));
+                setenv("GVIRTUS_CUDART_OCCUPANCY", "remote", 1);
+                CUDA_CHECK(cudaOccupancyMaxActiveBlocksPerMultiprocessor(&remote, kernel,
+                                                                         blockSize, dynamicSMem));
+                ASSERT_EQ(local, remote) << "block " << blockSize << ", smem " << dynamicSMem;
+            }
+        }
+    }
+    unsetenv("GVIRTUS_CUDART_OCCUPANCY");
+}
+
+__global__ void spinKernel(long long cycles) {
+    long long start = clock64();
+    while (clock64() - start < cycles) {
+    }
+}
+
+static void CUDART_CB countHostFunc(void* count) { ++*static_cast<int*>(count); }
+
+static void CUDART_CB countStreamCallback(cudaStream_t, cudaError_t status, void* count) {
+    if (status == cudaSuccess) ++*static_cast<int*>(count);
+}
+
+TEST(cudaRT, CompletionNotificationsAndCallbacks) {
+    cudaStream_t stream;
+    cudaEvent_t event;
+    CUDA_CHECK(cudaStreamCreate(&stream));
+    CUDA_CHECK(cudaEventCreate(&event));
+
+    int host_funcs = 0, callbacks = 0;
+    spinKernel<<<1, 1, 0, stream>>>(100000000);
+    CUDA_CHECK(cudaLaunchHostFunc(stream, countHostFunc, &host_funcs));
+    CUDA_CHECK(cudaStreamAddCallback(stream, countStreamCallback, &callbacks, 0));
+    CUDA_CHECK(cudaEventRecord(event, stream));
+
+    // answered by the frontend once the backend pushed the completion
+    cudaError_t status;
+    while ((status = cudaEventQuery(event)) == cudaErrorNotReady) {
+    }
+    CUDA_CHECK(status);
+    // the callbacks ran in this process, before the work after them
+    ASSERT_EQ(host_funcs, 1);
+    ASSERT_EQ(callbacks, 1);
+    CUDA_CHECK(cudaEventSynchronize(event));
+
+    spinKernel<<<1, 1, 0, stream>>>(100000000);
+    while ((status = cudaStreamQuery(stream)) == cudaErrorNotReady) {
+    }
+    CUDA_CHECK(status);
+
+    CUDA_CHECK(cudaEventDestroy(event));
+    CUDA_CHECK(cudaStreamDestroy(stream));
+}
+
+TEST(cudaRT, MacroReplaysAnIteration) {
+    // exported by the frontend library, which the test is not linked against
+    auto begin = (int (*)(const char *))dlsym(RTLD_DEFAULT, "gvirtusMacroBegin");
+    auto end = (int (*)(void))dlsym(RTLD_DEFAULT, "gvirtusMacroEnd");
+    auto deferred = (uint64_t (*)(void))dlsym(RTLD_DEFAULT, "gvirtusMacroDeferred");
+    if (begin == nullptr || end == nullptr || deferred == nullptr)
+        GTEST_SKIP() << "not running on gVirtuS";
+
+    cudaStream_t stream;
+    int *d_value;
+    CUDA_CHECK(cudaStreamCreate(&stream));
+    CUDA_CHECK(cudaMalloc(&d_value, sizeof(int)));
+
+    // recorded the first time, then replayed with the value of the memset changed
+    for (int i = 0; i < 4; i++) {
+        uint64_t was = deferred();
+        ASSERT_EQ(begin("iteration"), 0);
+        CUDA_CHECK(cudaMemsetAsync(d_value, i, sizeof(int), stream));
+        simpleKernel<<<1, 1, 0, stream>>>(d_value);
+        CUDA_CHECK(cudaMemsetAsync(d_value, i + 1, 1, stream));
+        ASSERT_EQ(end(), 0);
+
+        int value = 0;
+        CUDA_CHECK(cudaMemcpy(&value, d_value, sizeof(int), cudaMemcpyDeviceToHost));
+        ASSERT_EQ(value, (123 & ~0xff) | (i + 1));
+        // the first iteration is recorded, and the later ones replayed
+        if (i == 0)
+            ASSERT_EQ(deferred(), was);
+        else
+            ASSERT_GT(deferred(), was);
+    }
+
+    CUDA_CHECK(cudaFree(d_value));
+    CUDA_CHECK(cudaStreamDestroy(stream));
+}
+
+TEST(cudaRT, MemcpyPeer) {
+    int count = 0;
+    CUDA_CHECK(cudaGetDeviceCount(&count));
+    if (count < 2) GTEST_SKIP() << "needs two devices";
+
+    // the last device may belong to another backend, where the copy is staged
+    const size_t n = 1 << 20;
+    std::vector<int> h_src(n), h_dst(n, 0);
+    for (size_t i = 0; i < n; i++) h_src[i] = (int)i;
+    int *d_src, *d_dst;
+    CUDA_CHECK(cudaSetDevice(0));
+    CUDA_CHECK(cudaMalloc(&d_src, n * sizeof(int)));
+    CUDA_CHECK(cudaMemcpy(d_src, h_src.data(), n * sizeof(int), cudaMemcpyHostToDevice));
+    CUDA_CHECK(cudaSetDevice(count - 1));
+    CUDA_CHECK(cudaMalloc(&d_dst, n * sizeof(int)));
+
+    CUDA_CHECK(cudaMemcpyPeer(d_dst, count - 1, d_src, 0, n * sizeof(int)));
+    CUDA_CHECK(cudaMemcpy(h_dst.data(), d_dst, n * sizeof(int), cudaMemcpyDeviceToHost));
+    ASSERT_EQ(h_dst, h_src);
+
+    int device = -1;
+    CUDA_CHECK(cudaGetDevice(&device));
+    ASSERT_EQ(device, count - 1);
+    CUDA_CHECK(cudaFree(d_dst));
+    CUDA_CHECK(cudaSetDevice(0));
+    CUDA_CHECK(cudaFree(d_src));
+}
+
+TEST(cudaRT, LaunchKernelOnLastDevice) {
+    int count = 0;
+    CUDA_CHECK(cudaGetDeviceCount(&count));
+
+    // the last device may belong to a backend reached after the kernels were registered
+    CUDA_CHECK(cudaSetDevice(count - 1));
+    int* d_output;
+    int h_output = 0;
+    CUDA_CHECK(cudaMalloc(&d_output, sizeof(int)));
+    simpleKernel<<<1, 1>>>(d_output);
+    CUDA_CHECK(cudaGetLastError());
+    CUDA_CHECK(cudaMemcpy(&h_output, d_output, sizeof(int), cudaMemcpyDeviceToHost));
+    ASSERT_EQ(h_output, 123);
+    CUDA_CHECK(cudaFree(d_output));
+    CUDA_CHECK(cudaSetDevice(0));
+}
+
+__global__ void incrementKernel(int* values, int n) {
+    int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i < n) values[i]++;
+}
+
+TEST(cudaRT, HostAllocAsyncCopies) {
+    const int n = 1 << 20;
+    int *h_values, *d_values;
+    cudaStream_t stream;
+    CUDA_CHECK(cudaMallocHost(&h_values, n * sizeof(int)));
+    CUDA_CHECK(cudaMalloc(&d_values, n * sizeof(int)));
+    CUDA_CHECK(cudaStreamCreate(&stream));
+    for (int i = 0; i < n; i++) h_values[i] = i;
+
+    // with a backend on this host, only the addresses of the copies are sent
+    CUDA_CHECK(
+        cudaMemcpyAsync(d_values, h_values, n * sizeof(int), cudaMemcpyHostToDevice, stream));
+    incrementKernel<<<(n + 255) / 256, 256, 0, stream>>>(d_values, n);
+    CUDA_CHECK(
+        cudaMemcpyAsync(h_values, d_values, n * sizeof(int), cudaMemcpyDeviceToHost, stream));
+    CUDA_CHECK(cudaStreamSynchronize(stream));
+    for (int i = 0; i < n; i++) ASSERT_EQ(h_values[i], i + 1);
+
+    // copies of part of the memory, and synchronous ones
+    CUDA_CHECK(cudaMemcpy(h_values + 10, d_values + n - 10, 10 * sizeof(int),
+                          cudaMemcpyDeviceToHost));
+    ASSERT_EQ(h_values[10], n - 9);
+
+    CUDA_CHECK(cudaStreamDestroy(stream));
+    CUDA_CHECK(cudaFree(d_values));
+    CUDA_CHECK(cudaFreeHost(h_values));
+}
+
+TEST(cudaRT, HostAllocMapped) {
+    const int n = 4096;
+    int *h_values, *mapped;
+    CUDA_CHECK(cudaHostAlloc(&h_values, n * sizeof(int), cudaHostAllocMapped));
+    for (int i = 0; i < n; i++) h_values[i] = i;
+
+    // only the memory a backend shares with this process is mapped
+    if (cudaHostGetDevicePointer((void**)&mapped, h_values, 0) != cudaSuccess) {
+        CUDA_CHECK(cudaFreeHost(h_values));
+        GTEST_SKIP() << "the backend runs on another host";
+    }
+    unsigned int flags = 0;
+    CUDA_CHECK(cudaHostGetFlags(&flags, h_values));
+    ASSERT_TRUE(flags & cudaHostAllocMapped);
+
+    incrementKernel<<<n / 256, 256>>>(mapped, n);
+    CUDA_CHECK(cudaDeviceSynchronize());
+    for (int i = 0; i < n; i++) ASSERT_EQ(h_values[i], i + 1);
+
+    CUDA_CHECK(cudaFreeHost(h_values));
+}
+
+TEST(cudaRT, HostAllocFromJoinedThread) {
+    const int n = 4096;
+    int *h_values = nullptr, *d_values;
+    cudaError_t allocated;
+    // the memory outlives the connection of the thread that allocated it
+    std::thread([&] {
+        allocated = cudaHostAlloc(&h_values, n * sizeof(int), cudaHostAllocMapped);
+    }).join();
+    CUDA_CHECK(allocated);
+    for (int i = 0; i < n; i++) h_values[i] = i;
+
+    CUDA_CHECK(cudaMalloc(&d_values, n * sizeof(int)));
+    CUDA_CHECK(cudaMemcpy(d_values, h_values, n * sizeof(int), cudaMemcpyHostToDevice));
+    incrementKernel<<<n / 256, 256>>>(d_values, n);
+    CUDA_CHECK(cudaMemcpy(h_values, d_values, n * sizeof(int), cudaMemcpyDeviceToHost));
+    for (int i = 0; i < n; i++) ASSERT_EQ(h_values[i], i + 1);
+
+    int *mapped;
+    if (cudaHostGetDevicePointer((void**)&mapped, h_values, 0) == cudaSuccess) {
+        incrementKernel<<<n / 256, 256>>>(mapped, n);
+        CUDA_CHECK(cudaDeviceSynchronize());
+        ASSERT_EQ(h_values[n - 1], n + 1);
+    }
+
+    CUDA_CHECK(cudaFree(d_values));
+    CUDA_CHECK(cudaFreeHost(h_values));
+}
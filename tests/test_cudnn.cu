@@ -823,6 +823,100 @@ TEST(cuDNN, GetConvolution2dForwardOutputDim) {
     CUDNN_CHECK(cudnnDestroy(cudnn));
 }
 
+TEST(cuDNN, FilterAndConvolutionDescriptorSetGet) {
+    cudnnTensorDescriptor_t tensor_desc;
+    cudnnFilterDescriptor_t filter_desc;
+    cudnnConvolutionDescriptor_t conv_desc;
+    CUDNN_CHECK(cudnnCreateTensorDescriptor(&tensor_desc));
+    CUDNN_CHECK(cudnnCreateFilterDescriptor(&filter_desc));
+    CUDNN_CHECK(cudnnCreateConvolutionDescriptor(&conv_desc));
+
+    CUDNN_CHECK(
+        cudnnSetTensor4dDescriptor(tensor_desc, CUDNN_TENSOR_NHWC, CUDNN_DATA_FLOAT, 2, 3, 5, 7));
+    CUDNN_CHECK(
+        cudnnSetFilter4dDescriptor(filter_desc, CUDNN_DATA_FLOAT, CUDNN_TENSOR_NCHW, 8, 3, 3, 3));
+    CUDNN_CHECK(cudnnSetConvolution2dDescriptor(conv_desc, 1, 2, 1, 2, 1, 1,
+                                                CUDNN_CROSS_CORRELATION, CUDNN_DATA_FLOAT));
+    CUDNN_CHECK(cudnnSetConvolutionMathType(conv_desc, CUDNN_TENSOR_OP_MATH));
+    CUDNN_CHECK(cudnnSetConvolutionGroupCount(conv_desc, 1));
+
+    cudnnDataType_t dataType;
+    int n, c, h, w, nStride, cStride, hStride, wStride;
+    CUDNN_CHECK(cudnnGetTensor4dDescriptor(tensor_desc, &dataType, &n, &c, &h, &w, &nStride,
+                                           &cStride, &hStride, &wStride));
+    ASSERT_EQ(nStride, 105);
+    ASSERT_EQ(cStride, 1);
+    ASSERT_EQ(hStride, 21);
+    ASSERT_EQ(wStride, 3);
+
+    cudnnTensorFormat_t format;
+    int k;
+    CUDNN_CHECK(cudnnGetFilter4dDescriptor(filter_desc, &dataType, &format, &k, &c, &h, &w));
+    ASSERT_EQ(dataType, CUDNN_DATA_FLOAT);
+    ASSERT_EQ(format, CUDNN_TENSOR_NCHW);
+    ASSERT_EQ(k, 8);
+    ASSERT_EQ(h, 3);
+
+    int pad_h, pad_w, u, v, dilation_h, dilation_w;
+    cudnnConvolutionMode_t mode;
+    cudnnDataType_t computeType;
+    CUDNN_CHECK(cudnnGetConvolution2dDescriptor(conv_desc, &pad_h, &pad_w, &u, &v, &dilation_h,
+                                                &dilation_w, &mode, &computeType));
+    ASSERT_EQ(pad_w, 2);
+    ASSERT_EQ(v, 2);
+    ASSERT_EQ(mode, CUDNN_CROSS_CORRELATION);
+
+    cudnnMathType_t mathType;
+    CUDNN_CHECK(cudnnGetConvolutionMathType(conv_desc, &mathType));
+    ASSERT_EQ(mathType, CUDNN_TENSOR_OP_MATH);
+
+    // The output shape must match the one of the backend, which also
+    // applies every set above.
+    CUDNN_CHECK(cudnnGetConvolution2dForwardOutputDim(conv_desc, tensor_desc, filter_desc, &n, &c,
+                                                      &h, &w));
+    size_t size;
+    CUDNN_CHECK(cudnnGetTensorSizeInBytes(tensor_desc, &size));
+    ASSERT_EQ(n, 2);
+    ASSERT_EQ(c, 8);
+    ASSERT_EQ(h, 5);
+    ASSERT_EQ(w, 5);
+    ASSERT_EQ(size, 2 * 3 * 5 * 7 * sizeof(float));
+
+    CUDNN_CHECK(cudnnDestroyTensorDescriptor(tensor_desc));
+    CUDNN_CHECK(cudnnDestroyFilterDescriptor(filter_desc));
+    CUDNN_CHECK(cudnnDestroyConvolutionDescriptor(conv_desc));
+}
+
+TEST(cuDNN, CreateDescriptorsAfterDeferredSet) {
+    cudnnTensorDescriptor_t tensor_desc;
+    CUDNN_CHECK(cudnnCreateTensorDescriptor(&tensor_desc));
+    CUDNN_CHECK(
+        cudnnSetTensor4dDescriptor(tensor_desc, CUDNN_TENSOR_NCHW, CUDNN_DATA_FLOAT, 1, 2, 3, 4));
+
+    // each create carries the sets deferred before it, without arguments of its own
+    cudnnTensorDescriptor_t other_desc;
+    CUDNN_CHECK(cudnnCreateTensorDescriptor(&other_desc));
+    CUDNN_CHECK(
+        cudnnSetTensor4dDescriptor(other_desc, CUDNN_TENSOR_NCHW, CUDNN_DATA_FLOAT, 4, 3, 2, 1));
+    cudnnFilterDescriptor_t filter_desc;
+    CUDNN_CHECK(cudnnCreateFilterDescriptor(&filter_desc));
+    CUDNN_CHECK(
+        cudnnSetFilter4dDescriptor(filter_desc, CUDNN_DATA_FLOAT, CUDNN_TENSOR_NCHW, 8, 2, 3, 3));
+    cudnnConvolutionDescriptor_t conv_desc;
+    CUDNN_CHECK(cudnnCreateConvolutionDescriptor(&conv_desc));
+
+    size_t size;
+    CUDNN_CHECK(cudnnGetTensorSizeInBytes(tensor_desc, &size));
+    ASSERT_EQ(size, 1 * 2 * 3 * 4 * sizeof(float));
+    CUDNN_CHECK(cudnnGetTensorSizeInBytes(other_desc, &size));
+    ASSERT_EQ(size, 4 * 3 * 2 * 1 * sizeof(float));
+
+    CUDNN_CHECK(cudnnDestroyTensorDescriptor(tensor_desc));
+    CUDNN_CHECK(cudnnDestroyTensorDescriptor(other_desc));
+    CUDNN_CHECK(cudnnDestroyFilterDescriptor(filter_desc));
+    CUDNN_CHECK(cudnnDestroyConvolutionDescriptor(conv_desc));
+}
+
 TEST(cuDNN, GetConvolutionForwardAlgorithm_v7) {
     cudnnHandle_t cudnn;
     CUDNN_CHECK(cudnnCreate(&cudnn));
@@ -874,6 +968,63 @@ TEST(cuDNN, GetConvolutionForwardAlgorithm_v7) {
     CUDNN_CHECK(cudnnDestroy(cudnn));
 }
 
+TEST(cuDNN, FindConvolutionForwardAlgorithmRepeated) {
+    cudnnHandle_t cudnn;
+    CUDNN_CHECK(cudnnCreate(&cudnn));
+
+    cudnnTensorDescriptor_t input_desc, output_desc;
+    cudnnFilterDescriptor_t filter_desc;
+    cudnnConvolutionDescriptor_t conv_desc;
+
+    CUDNN_CHECK(cudnnCreateTensorDescriptor(&input_desc));
+    CUDNN_CHECK(cudnnCreateTensorDescriptor(&output_desc));
+    CUDNN_CHECK(cudnnCreateFilterDescriptor(&filter_desc));
+    CUDNN_CHECK(cudnnCreateConvolutionDescriptor(&conv_desc));
+
+    CUDNN_CHECK(
+        cudnnSetTensor4dDescriptor(input_desc, CUDNN_TENSOR_NCHW, CUDNN_DATA_FLOAT, 1, 3, 8, 8));
+    CUDNN_CHECK(
+        cudnnSetFilter4dDescriptor(filter_desc, CUDNN_DATA_FLOAT, CUDNN_TENSOR_NCHW, 4, 3, 3, 3));
+    CUDNN_CHECK(cudnnSetConvolution2dDescriptor(conv_desc, 1, 1, 1, 1, 1, 1,
+                                                CUDNN_CROSS_CORRELATION, CUDNN_DATA_FLOAT));
+    CUDNN_CHECK(
+        cudnnSetTensor4dDescriptor(output_desc, CUDNN_TENSOR_NCHW, CUDNN_DATA_FLOAT, 1, 4, 8, 8));
+
+    // The second search is answered by the backend's algorithm cache.
+    const int requested = 4;
+    cudnnConvolutionFwdAlgoPerf_t first[requested], second[requested];
+    int first_count = 0, second_count = 0;
+    CUDNN_CHECK(cudnnFindConvolutionForwardAlgorithm(cudnn, input_desc, filter_desc, conv_desc,
+                                                     output_desc, requested, &first_count, first));
+    CUDNN_CHECK(cudnnFindConvolutionForwardAlgorithm(cudnn, input_desc, filter_desc, conv_desc,
+                                                     output_desc, requested, &second_count,
+                                                     second));
+
+    ASSERT_GE(first_count, 1);
+    ASSERT_LE(first_count, requested);
+    ASSERT_EQ(first_count, second_count);
+    for (int i = 0; i < first_count; i++) {
+        EXPECT_EQ(first[i].algo, second[i].algo);
+        EXPECT_EQ(first[i].memory, second[i].memory);
+        // Only a cache hit gives back the very timings: a second benchmark
+        // would not measure them to the bit.
+        EXPECT_EQ(first[i].time, second[i].time);
+    }
+
+    size_t first_size = 0, second_size = 0;
+    CUDNN_CHECK(cudnnGetConvolutionForwardWorkspaceSize(cudnn, input_desc, filter_desc, conv_desc,
+                                                        output_desc, first[0].algo, &first_size));
+    CUDNN_CHECK(cudnnGetConvolutionForwardWorkspaceSize(cudnn, input_desc, filter_desc, conv_desc,
+                                                        output_desc, first[0].algo, &second_size));
+    EXPECT_EQ(first_size, second_size);
+
+    CUDNN_CHECK(cudnnDestroyTensorDescriptor(input_desc));
+    CUDNN_CHECK(cudnnDestroyTensorDescriptor(output_desc));
+    CUDNN_CHECK(cudnnDestroyFilterDescriptor(filter_desc));
+    CUDNN_CHECK(cudnnDestroyConvolutionDescriptor(conv_desc));
+    CUDNN_CHECK(cudnnDestroy(cudnn));
+}
+
 TEST(cuDNN, AddTensorFloat) {
     cudnnHandle_t cudnn;
     CUDNN_CHECK(cudnnCreate(&cudnn));
@@ -1630,6 +1781,64 @@ TEST(cuDNN, BackendCreateAndDestroyDescriptor) {
     CUDNN_CHECK(cudnnBackendDestroyDescriptor(desc));
 }
 
+TEST(cuDNN, BackendTensorSetFinalizeGet) {
+    cudnnBackendDescriptor_t desc;
+    CUDNN_CHECK(cudnnBackendCreateDescriptor(CUDNN_BACKEND_TENSOR_DESCRIPTOR, &desc));
+
+    // The attribute sets are shipped together with cudnnBackendFinalize.
+    cudnnDataType_t dataType = CUDNN_DATA_FLOAT;
+    int64_t dims[4] = {2, 3, 4, 5};
+    int64_t strides[4] = {60, 20, 5, 1};
+    int64_t uid = 42, alignment = 16;
+    CUDNN_CHECK(cudnnBackendSetAttribute(desc, CUDNN_ATTR_TENSOR_DATA_TYPE, CUDNN_TYPE_DATA_TYPE, 1,
+                                         &dataType));
+    CUDNN_CHECK(
+        cudnnBackendSetAttribute(desc, CUDNN_ATTR_TENSOR_DIMENSIONS, CUDNN_TYPE_INT64, 4, dims));
+    CUDNN_CHECK(
+        cudnnBackendSetAttribute(desc, CUDNN_ATTR_TENSOR_STRIDES, CUDNN_TYPE_INT64, 4, strides));
+    CUDNN_CHECK(
+        cudnnBackendSetAttribute(desc, CUDNN_ATTR_TENSOR_UNIQUE_ID, CUDNN_TYPE_INT64, 1, &uid));
+    uid = 7;  // a later set of the same attribute wins
+    CUDNN_CHECK(
+        cudnnBackendSetAttribute(desc, CUDNN_ATTR_TENSOR_UNIQUE_ID, CUDNN_TYPE_INT64, 1, &uid));
+    CUDNN_CHECK(cudnnBackendSetAttribute(desc, CUDNN_ATTR_TENSOR_BYTE_ALIGNMENT, CUDNN_TYPE_INT64,
+                                         1, &alignment));
+    CUDNN_CHECK(cudnnBackendFinalize(desc));
+
+    int64_t count = 0, got_dims[4] = {0}, got_uid = 0;
+    CUDNN_CHECK(cudnnBackendGetAttribute(desc, CUDNN_ATTR_TENSOR_DIMENSIONS, CUDNN_TYPE_INT64, 4,
+                                         &count, got_dims));
+    ASSERT_EQ(count, 4);
+    for (int i = 0; i < 4; i++) EXPECT_EQ(got_dims[i], dims[i]);
+    CUDNN_CHECK(cudnnBackendGetAttribute(desc, CUDNN_ATTR_TENSOR_UNIQUE_ID, CUDNN_TYPE_INT64, 1,
+                                         &count, &got_uid));
+    EXPECT_EQ(got_uid, 7);
+
+    CUDNN_CHECK(cudnnBackendDestroyDescriptor(desc));
+}
+
+TEST(cuDNN, CreateDescriptorAfterFailedDeferredSet) {
+    cudnnBackendDescriptor_t desc;
+    CUDNN_CHECK(cudnnBackendCreateDescriptor(CUDNN_BACKEND_TENSOR_DESCRIPTOR, &desc));
+    // deferred: the wrong type only fails on the backend, with the next call
+    float wrong[4] = {1, 2, 3, 4};
+    CUDNN_CHECK(
+        cudnnBackendSetAttribute(desc, CUDNN_ATTR_TENSOR_DIMENSIONS, CUDNN_TYPE_FLOAT, 4, wrong));
+
+    // the call carrying the failed set keeps its own status and output
+    cudnnTensorDescriptor_t tensor_desc;
+    CUDNN_CHECK(cudnnCreateTensorDescriptor(&tensor_desc));
+    ASSERT_NE(tensor_desc, nullptr);
+    CUDNN_CHECK(
+        cudnnSetTensor4dDescriptor(tensor_desc, CUDNN_TENSOR_NCHW, CUDNN_DATA_FLOAT, 1, 2, 3, 4));
+    size_t size;
+    CUDNN_CHECK(cudnnGetTensorSizeInBytes(tensor_desc, &size));
+    ASSERT_EQ(size, 1 * 2 * 3 * 4 * sizeof(float));
+
+    CUDNN_CHECK(cudnnDestroyTensorDescriptor(tensor_desc));
+    CUDNN_CHECK(cudnnBackendDestroyDescriptor(desc));
+}
+
 // TEST(CudnnBackendEngineHeurTest, SetGetAttributes) {
 //     cudnnHandle_t handle;
 //     CUDNN_CHECK(cudnnCreate(&handle));
@@ -125,6 +125,49 @@ TEST(cuFFT, Plan1DAndExecC2C) {
     CUDA_CHECK(cudaFree(d_input));
 }
 
+TEST(cuFFT, RecreatedPlanManyExecC2C) {
+    // The backend hands the destroyed plan back: every iteration must still
+    // transform a rank 2 impulse into a flat spectrum.
+    const int NX = 4, NY = 8, N = NX * NY;
+    int n[] = {NX, NY};
+    std::vector<cufftComplex> data(N);
+
+    cufftComplex *d_data;
+    CUDA_CHECK(cudaMalloc(&d_data, sizeof(cufftComplex) * N));
+
+    size_t firstWorkSize = 0;
+    for (int iteration = 0; iteration < 3; ++iteration) {
+        cufftHandle plan;
+        CUFFT_CHECK(cufftPlanMany(&plan, 2, n, nullptr, 1, 0, nullptr, 1, 0, CUFFT_C2C, 1));
+
+        size_t workSize = 0;
+        CUFFT_CHECK(cufftGetSize(plan, &workSize));
+        if (iteration == 0) firstWorkSize = workSize;
+        ASSERT_EQ(workSize, firstWorkSize);
+
+        for (int i = 0; i < N; ++i) data[i].x = data[i].y = 0.0f;
+        data[0].x = 1.0f;
+        CUDA_CHECK(
+            cudaMemcpy(d_data, data.data(), sizeof(cufftComplex) * N, cudaMemcpyHostToDevice));
+        CUFFT_CHECK(cufftExecC2C(plan, d_data, d_data, CUFFT_FORWARD));
+        CUDA_CHECK(
+            cudaMemcpy(data.data(), d_data, sizeof(cufftComplex) * N, cudaMemcpyDeviceToHost));
+        for (int i = 0; i < N; ++i) {
+            ASSERT_NEAR(data[i].x, 1.0f, 1e-5f);
+            ASSERT_NEAR(data[i].y, 0.0f, 1e-5f);
+        }
+
+        CUFFT_CHECK(cufftDestroy(plan));
+    }
+
+    size_t estimate = 0, again = 0;
+    CUFFT_CHECK(cufftEstimateMany(2, n, nullptr, 1, 0, nullptr, 1, 0, CUFFT_C2C, 1, &estimate));
+    CUFFT_CHECK(cufftEstimateMany(2, n, nullptr, 1, 0, nullptr, 1, 0, CUFFT_C2C, 1, &again));
+    ASSERT_EQ(estimate, again);
+
+    CUDA_CHECK(cudaFree(d_data));
+}
+
 TEST(cuFFT, CreateMakePlan1dAndExecC2C) {
     const int N = 8;  // FFT size
 
@@ -7,6 +7,7 @@
 #include <gtest/gtest.h>
 
 #include <iostream>
+#include <vector>
 
 #define CUDA_CHECK(err) ASSERT_EQ((err), cudaSuccess) << "CUDA error: " << cudaGetErrorString(err)
 #define CURAND_CHECK(err) ASSERT_EQ((err), CURAND_STATUS_SUCCESS)
@@ -496,4 +497,68 @@ TEST(cuRAND, GenerateLogNormalDoubleHost) {
 
     CURAND_CHECK(curandDestroyGenerator(generator));
     free(output);
-}
\ No newline at end of file
+}
+
+TEST(cuRAND, HostGeneratorMatchesDevice) {
+    const curandRngType_t types[] = {CURAND_RNG_PSEUDO_XORWOW, CURAND_RNG_PSEUDO_MRG32K3A,
+                                     CURAND_RNG_PSEUDO_PHILOX4_32_10};
+    const size_t n = 100000;
+    for (curandRngType_t type : types) {
+        curandGenerator_t device_generator, host_generator;
+        CURAND_CHECK(curandCreateGenerator(&device_generator, type));
+        CURAND_CHECK(curandCreateGeneratorHost(&host_generator, type));
+        CURAND_CHECK(curandSetPseudoRandomGeneratorSeed(device_generator, 2024ULL));
+        CURAND_CHECK(curandSetPseudoRandomGeneratorSeed(host_generator, 2024ULL));
+
+        unsigned int *d_bits, *d_poisson;
+        float *d_uniform, *d_normal;
+        double* d_uniform_double;
+        CUDA_CHECK(cudaMalloc(&d_bits, n * sizeof(unsigned int)));
+        CUDA_CHECK(cudaMalloc(&d_poisson, n * sizeof(unsigned int)));
+        CUDA_CHECK(cudaMalloc(&d_uniform, n * sizeof(float)));
+        CUDA_CHECK(cudaMalloc(&d_normal, n * sizeof(float)));
+        CUDA_CHECK(cudaMalloc(&d_uniform_double, n * sizeof(double)));
+        std::vector<unsigned int> device_bits(n), host_bits(n);
+        std::vector<unsigned int> device_poisson(n), host_poisson(n);
+        std::vector<float> device_uniform(n), host_uniform(n);
+        std::vector<float> device_normal(n), host_normal(n);
+        std::vector<double> device_uniform_double(n), host_uniform_double(n);
+
+        // Several calls, so that each one continues every subsequence; the
+        // normal and Poisson ones move the host generator to the backend.
+        CURAND_CHECK(curandGenerate(device_generator, d_bits, n));
+        CURAND_CHECK(curandGenerateUniform(device_generator, d_uniform, n));
+        CURAND_CHECK(curandGenerateUniformDouble(device_generator, d_uniform_double, n));
+        CURAND_CHECK(curandGenerateNormal(device_generator, d_normal, n, 1.0f, 2.0f));
+        CURAND_CHECK(curandGeneratePoisson(device_generator, d_poisson, n, 4.0));
+        CURAND_CHECK(curandGenerate(host_generator, host_bits.data(), n));
+        CURAND_CHECK(curandGenerateUniform(host_generator, host_uniform.data(), n));
+        CURAND_CHECK(curandGenerateUniformDouble(host_generator, host_uniform_double.data(), n));
+        CURAND_CHECK(curandGenerateNormal(host_generator, host_normal.data(), n, 1.0f, 2.0f));
+        CURAND_CHECK(curandGeneratePoisson(host_generator, host_poisson.data(), n, 4.0));
+        CUDA_CHECK(cudaMemcpy(device_bits.data(), d_bits, n * sizeof(unsigned int),
+                              cudaMemcpyDeviceToHost));
+        CUDA_CHECK(cudaMemcpy(device_uniform.data(), d_uniform, n * sizeof(float),
+                              cudaMemcpyDeviceToHost));
+        CUDA_CHECK(cudaMemcpy(device_uniform_double.data(), d_uniform_double,
+                              n * sizeof(double), cudaMemcpyDeviceToHost));
+        CUDA_CHECK(cudaMemcpy(device_normal.data(), d_normal, n * sizeof(float),
+                              cudaMemcpyDeviceToHost));
+        CUDA_CHECK(cudaMemcpy(device_poisson.data(), d_poisson, n * sizeof(unsigned int),
+                              cudaMemcpyDeviceToHost));
+
+        ASSERT_EQ(device_bits, host_bits) << "rng type " << type;
+        ASSERT_EQ(device_uniform, host_uniform) << "rng type " << type;
+        ASSERT_EQ(device_uniform_double, host_uniform_double) << "rng type " << type;
+        ASSERT_EQ(device_normal, host_normal) << "rng type " << type;
+        ASSERT_EQ(device_poisson, host_poisson) << "rng type " << type;
+
+        CUDA_CHECK(cudaFree(d_bits));
+        CUDA_CHECK(cudaFree(d_poisson));
+        CUDA_CHECK(cudaFree(d_uniform));
+        CUDA_CHECK(cudaFree(d_normal));
+        CUDA_CHECK(cudaFree(d_uniform_double));
+        CURAND_CHECK(curandDestroyGenerator(device_generator));
+        CURAND_CHECK(curandDestroyGenerator(host_generator));
+    }
+}
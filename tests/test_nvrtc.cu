@@ -6,6 +6,9 @@
 #include <gtest/gtest.h>
 #include <nvrtc.h>
 
+#include <cstring>
+#include <string>
+
 #define NVRTC_CHECK(err) ASSERT_EQ((err), NVRTC_SUCCESS)
 
 TEST(nvrtc, versionCheck) {
@@ -14,3 +17,52 @@ TEST(nvrtc, versionCheck) {
     ASSERT_EQ(major, 0);  // I have not implemented this, so it should be 0
     ASSERT_EQ(minor, 0);  // I have not implemented this, so it should be 0
 }
+
+static const char *scale_source =
+    "template <int N>\n"
+    "__global__ void scale(float *x) { x[threadIdx.x] *= N; }\n";
+
+static std::string CompileToPTX(const char *source, const char **lowered = NULL) {
+    nvrtcProgram prog;
+    const char *options[] = {"--gpu-architecture=compute_70"};
+    EXPECT_EQ(nvrtcCreateProgram(&prog, source, "scale.cu", 0, NULL, NULL), NVRTC_SUCCESS);
+    EXPECT_EQ(nvrtcAddNameExpression(prog, "scale<3>"), NVRTC_SUCCESS);
+    EXPECT_EQ(nvrtcCompileProgram(prog, 1, options), NVRTC_SUCCESS);
+    size_t size = 0;
+    EXPECT_EQ(nvrtcGetPTXSize(prog, &size), NVRTC_SUCCESS);
+    std::string ptx(size, '\0');
+    EXPECT_EQ(nvrtcGetPTX(prog, &ptx[0]), NVRTC_SUCCESS);
+    if (lowered != NULL) {
+        const char *name = NULL;
+        EXPECT_EQ(nvrtcGetLoweredName(prog, "scale<3>", &name), NVRTC_SUCCESS);
+        *lowered = name != NULL ? strdup(name) : NULL;
+    }
+    EXPECT_EQ(nvrtcDestroyProgram(&prog), NVRTC_SUCCESS);
+    EXPECT_EQ(prog, nullptr);
+    return ptx;
+}
+
+TEST(nvrtc, RecompiledProgramSamePTX) {
+    const char *lowered = NULL;
+    std::string first = CompileToPTX(scale_source, &lowered);
+    std::string second = CompileToPTX(scale_source);
+    ASSERT_GT(first.size(), 1u);
+    ASSERT_EQ(first, second);
+    ASSERT_NE(lowered, nullptr);
+    ASSERT_NE(first.find(lowered), std::string::npos);
+    free((void *)lowered);
+}
+
+TEST(nvrtc, CompilationErrorLog) {
+    nvrtcProgram prog;
+    NVRTC_CHECK(nvrtcCreateProgram(&prog, "__global__ void k() { undeclared(); }", "bad.cu", 0,
+                                   NULL, NULL));
+    ASSERT_EQ(nvrtcCompileProgram(prog, 0, NULL), NVRTC_ERROR_COMPILATION);
+    size_t size = 0;
+    NVRTC_CHECK(nvrtcGetProgramLogSize(prog, &size));
+    ASSERT_GT(size, 1u);
+    std::string log(size, '\0');
+    NVRTC_CHECK(nvrtcGetProgramLog(prog, &log[0]));
+    ASSERT_NE(log.find("undeclared"), std::string::npos);
+    NVRTC_CHECK(nvrtcDestroyProgram(&prog));
+}
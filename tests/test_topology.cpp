@@ -0,0 +1,132 @@
+/*
+ * Tests of the topology and the placement policy of the backend, against
+ * machines described by a synthetic sysfs tree. They need no GPU.
+ */
+
+#include <gtest/gtest.h>
+#include <gvirtus/common/Placement.h>
+#include <gvirtus/common/Topology.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using gvirtus::common::Placement;
+using gvirtus::common::Topology;
+
+namespace fs = std::filesystem;
+
+class SyntheticSysfs : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        root = fs::temp_directory_path() / ("gvirtus-sysfs-" + std::to_string(getpid()));
+        fs::remove_all(root);
+    }
+
+    void TearDown() override { fs::remove_all(root); }
+
+    void Write(const fs::path &path, const std::string &value) {
+        fs::create_directories((root / path).parent_path());
+        std::ofstream(root / path) << value << "\n";
+    }
+
+    void Node(int node, const std::string &cpus) {
+        Write("devices/system/node/node" + std::to_string(node) + "/cpulist", cpus);
+    }
+
+    void Pci(const std::string &bus, const std::string &vendor, const std::string &cls,
+             int node) {
+        fs::path device = "bus/pci/devices/" + bus;
+        Write(device / "vendor", vendor);
+        Write(device / "class", cls);
+        Write(device / "numa_node", std::to_string(node));
+    }
+
+    /* Two sockets, a GPU on each, and devices that are not GPUs. */
+    void DualSocket() {
+        Node(0, "0-3,8-11");
+        Node(1, "4-7,12-15");
+        Pci("0000:d8:00.0", "0x10de", "0x030200", 1);
+        Pci("0000:3b:00.0", "0x10de", "0x030000", 0);
+        Pci("0000:3b:00.1", "0x10de", "0x040300", 0);  // the audio of a GPU
+        Pci("0000:5e:00.0", "0x8086", "0x030000", 0);  // another vendor
+    }
+
+    fs::path root;
+};
+
+TEST(Topology, ParseCpus) {
+    EXPECT_EQ(Topology::ParseCpus("0-3,8,10-11"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(Topology::ParseCpus("5"), (std::vector<int>{5}));
+    EXPECT_TRUE(Topology::ParseCpus("").empty());
+}
+
+TEST_F(SyntheticSysfs, FindsNodesAndGpus) {
+    DualSocket();
+    Topology topology(root);
+
+    EXPECT_EQ(topology.Nodes(), (std::vector<int>{0, 1}));
+    EXPECT_EQ(topology.Cpus(1), (std::vector<int>{4, 5, 6, 7, 12, 13, 14, 15}));
+    EXPECT_TRUE(topology.Cpus(2).empty());
+    EXPECT_EQ(topology.Gpus(), (std::vector<std::string>{"0000:3b:00.0", "0000:d8:00.0"}));
+    EXPECT_EQ(topology.Node("0000:D8:00.0"), 1);
+    EXPECT_EQ(topology.Node("0000:3b:00.1"), -1);
+}
+
+TEST_F(SyntheticSysfs, WithoutSysfs) {
+    Topology topology(root);
+    EXPECT_TRUE(topology.Nodes().empty());
+    EXPECT_TRUE(topology.Gpus().empty());
+}
+
+TEST_F(SyntheticSysfs, PlacesNearTheGpu) {
+    DualSocket();
+    Placement placement(nullptr, Topology(root));
+
+    ASSERT_TRUE(placement.Enabled());
+    EXPECT_EQ(placement.Node("0000:3B:00.0"), 0);
+    EXPECT_EQ(placement.Node("0000:d8:00.0"), 1);
+    EXPECT_EQ(placement.Node("0000:af:00.0"), -1);
+}
+
+TEST_F(SyntheticSysfs, ConfigurationOverridesSysfs) {
+    DualSocket();
+    Placement placement(nlohmann::json::parse(R"({ "devices": { "0000:D8:00.0": 0 } })"),
+                        Topology(root));
+
+    EXPECT_EQ(placement.Node("0000:d8:00.0"), 0);
+    EXPECT_EQ(placement.Node("0000:3b:00.0"), 0);
+}
+
+TEST_F(SyntheticSysfs, PolicyNone) {
+    DualSocket();
+    Placement placement(nlohmann::json::parse(R"({ "policy": "none" })"), Topology(root));
+
+    EXPECT_FALSE(placement.Enabled());
+    EXPECT_EQ(placement.Node("0000:d8:00.0"), -1);
+}
+
+TEST_F(SyntheticSysfs, OneNodeLeavesThreadsAlone) {
+    Node(0, "0-7");
+    Pci("0000:3b:00.0", "0x10de", "0x030200", 0);
+    Placement placement(nullptr, Topology(root));
+
+    EXPECT_FALSE(placement.Enabled());
+}
+
+TEST_F(SyntheticSysfs, PinsOnlyToAllowedCpus) {
+    DualSocket();
+    Placement placement(nullptr, Topology(root));
+
+    cpu_set_t allowed;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    for (int node : {0, 1})
+        for (int cpu : placement.Cpus(node)) EXPECT_TRUE(CPU_ISSET(cpu, &allowed)) << cpu;
+}
+
+TEST_F(SyntheticSysfs, UnknownPolicy) {
+    EXPECT_THROW(Placement(nlohmann::json::parse(R"({ "policy": "closest" })"), Topology(root)),
+                 std::runtime_error);
+}